@@ -34,6 +34,14 @@ namespace CKE {
 
 		bool RemoveFile(const char* pPath);
 		bool RemoveFile(Path const& path);
+
+		// Directories
+		//-----------------------------------------------------------------------------
+
+		bool Exists(Path const& path) const;
+
+		// Returns the paths of all the files with the given extension (".ckadef") inside the directory and its subdirectories
+		Vector<Path> ListFilesRecursive(Path const& directory, const char* pExtension) const;
 	};
 
 	// Global File System Instance
@@ -68,4 +68,20 @@ namespace CKE {
 	Blob FileSystem::ReadBinaryFile(Path const& path) const {
 		return ReadBinaryFile(path.c_str());
 	}
+
+	bool FileSystem::Exists(Path const& path) const {
+		return std::filesystem::exists(path);
+	}
+
+	Vector<Path> FileSystem::ListFilesRecursive(Path const& directory, const char* pExtension) const {
+		Vector<Path> files{};
+		if (!std::filesystem::is_directory(directory)) { return files; }
+
+		for (auto const& entry : std::filesystem::recursive_directory_iterator(directory)) {
+			if (entry.is_regular_file() && entry.path().extension() == pExtension) {
+				files.push_back(entry.path().generic_string());
+			}
+		}
+		return files;
+	}
 }
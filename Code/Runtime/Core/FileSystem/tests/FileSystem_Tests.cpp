@@ -4,6 +4,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <filesystem>
+
 using namespace CKE;
 
 TEST(FileSystem, WriteRead_TextFile)
@@ -32,3 +35,23 @@ TEST(FileSystem, WriteRead_BinaryFile)
 
 	g_FileSystem.RemoveFile(filePath);
 }
+
+TEST(FileSystem, ListFilesRecursive)
+{
+	String const root{ "FileSystem_TestDir" };
+	std::filesystem::create_directories(root + "/Sub");
+	g_FileSystem.WriteTextFile(root + "/A.ckadef", String{ "{}" });
+	g_FileSystem.WriteTextFile(root + "/Sub/B.ckadef", String{ "{}" });
+	g_FileSystem.WriteTextFile(root + "/Sub/C.txt", String{ "" });
+
+	EXPECT_TRUE(g_FileSystem.Exists(root + "/A.ckadef"));
+	EXPECT_FALSE(g_FileSystem.Exists(root + "/Missing.ckadef"));
+
+	Vector<Path> files = g_FileSystem.ListFilesRecursive(root, ".ckadef");
+	std::sort(files.begin(), files.end());
+	ASSERT_EQ(files.size(), 2);
+	EXPECT_EQ(files[0], root + "/A.ckadef");
+	EXPECT_EQ(files[1], root + "/Sub/B.ckadef");
+
+	std::filesystem::remove_all(root);
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Containers/String.h"
+
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+// Binary capture of log arguments, the message is formatted later from the copy on the sink thread.
+// Strings are copied as their characters and read back as string views, trivially copyable types as their bytes.
+
+namespace CKE::LogCapture {
+	template <typename T>
+	concept StringLike = std::is_convertible_v<T const&, std::string_view>;
+
+	template <typename T>
+	concept Capturable = StringLike<T> || std::is_trivially_copyable_v<T>;
+
+	// Type the argument is read back as
+	template <typename T>
+	using CapturedType = std::conditional_t<StringLike<T>, std::string_view, T>;
+
+	// Bytes needed to capture the argument
+	template <typename T>
+	inline u64 GetCapturedSize(T const& value) {
+		if constexpr (StringLike<T>) { return sizeof(u32) + std::string_view{value}.size(); }
+		else { return sizeof(T); }
+	}
+
+	template <typename T>
+	inline void Capture(u8*& pData, T const& value) {
+		if constexpr (StringLike<T>) {
+			std::string_view const text{value};
+			u32 const              length = static_cast<u32>(text.size());
+			memcpy(pData, &length, sizeof(u32));
+			memcpy(pData + sizeof(u32), text.data(), length);
+			pData += sizeof(u32) + length;
+		}
+		else {
+			memcpy(pData, &value, sizeof(T));
+			pData += sizeof(T);
+		}
+	}
+
+	template <typename T>
+	inline CapturedType<T> Restore(u8 const*& pData) {
+		if constexpr (StringLike<T>) {
+			u32 length;
+			memcpy(&length, pData, sizeof(u32));
+			std::string_view const text{reinterpret_cast<char const*>(pData + sizeof(u32)), length};
+			pData += sizeof(u32) + length;
+			return text;
+		}
+		else {
+			T value;
+			memcpy(&value, pData, sizeof(T));
+			pData += sizeof(T);
+			return value;
+		}
+	}
+
+	// Formats the arguments captured in order by Capture, instantiated for each combination of argument types
+	template <typename... Args>
+	void FormatCaptured(std::string_view format, u8 const* pData, String& output) {
+		// Braced initialization evaluates the arguments in order
+		std::tuple<CapturedType<Args>...> values{Restore<Args>(pData)...};
+		std::apply([&](auto&... restored) {
+			std::vformat_to(std::back_inserter(output), format, std::make_format_args(restored...));
+		}, values);
+	}
+}
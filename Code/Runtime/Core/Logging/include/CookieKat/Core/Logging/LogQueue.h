@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CookieKat/Core/Platform/PrimitiveTypes.h"
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <atomic>
+
+namespace CKE {
+	// Bounded queue of fixed size elements for many producers and a single consumer (D. Vyukov's bounded queue).
+	// Producers claim a cell with a CAS on the enqueue position and publish it through the cell sequence,
+	// the consumer owns the dequeue position. Neither side takes a lock.
+	template <typename T>
+	class MPSCQueue
+	{
+	public:
+		MPSCQueue() = default;
+		~MPSCQueue() { Shutdown(); }
+
+		MPSCQueue(MPSCQueue const&) = delete;
+		MPSCQueue& operator=(MPSCQueue const&) = delete;
+
+		// The capacity must be a power of two
+		void Initialize(u64 capacity);
+		void Shutdown();
+
+		// Claims a cell and calls writeElement(T&) to fill it, returns false if the queue is full
+		template <typename Writer>
+		bool TryPush(Writer&& writeElement);
+
+		// Calls readElement(T&) with the oldest published element, returns false if there is none.
+		// Only one thread can pop
+		template <typename Reader>
+		bool TryPop(Reader&& readElement);
+
+		// Number of elements that have been claimed by producers since initialization, published or not
+		inline u64 GetNumPushed() const { return m_EnqueuePosition.load(std::memory_order_acquire); }
+
+	private:
+		struct Cell
+		{
+			std::atomic<u64> m_Sequence;
+			T                m_Element;
+		};
+
+		static constexpr u64 CACHE_LINE_SIZE = 64;
+
+		Cell* m_pCells = nullptr;
+		u64   m_Mask = 0;
+
+		// Producers and the consumer write to different cache lines
+		alignas(CACHE_LINE_SIZE) std::atomic<u64> m_EnqueuePosition{0};
+		alignas(CACHE_LINE_SIZE) u64 m_DequeuePosition = 0;
+	};
+}
+
+//-----------------------------------------------------------------------------
+
+namespace CKE {
+	template <typename T>
+	void MPSCQueue<T>::Initialize(u64 capacity) {
+		CKE_ASSERT(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+		CKE_ASSERT(m_pCells == nullptr);
+
+		m_pCells = new Cell[capacity];
+		m_Mask = capacity - 1;
+		for (u64 i = 0; i < capacity; ++i) {
+			m_pCells[i].m_Sequence.store(i, std::memory_order_relaxed);
+		}
+		m_EnqueuePosition.store(0, std::memory_order_relaxed);
+		m_DequeuePosition = 0;
+	}
+
+	template <typename T>
+	void MPSCQueue<T>::Shutdown() {
+		delete[] m_pCells;
+		m_pCells = nullptr;
+		m_Mask = 0;
+	}
+
+	template <typename T>
+	template <typename Writer>
+	bool MPSCQueue<T>::TryPush(Writer&& writeElement) {
+		u64   position = m_EnqueuePosition.load(std::memory_order_relaxed);
+		Cell* pCell;
+		while (true) {
+			pCell = &m_pCells[position & m_Mask];
+			u64 const sequence = pCell->m_Sequence.load(std::memory_order_acquire);
+			i64 const difference = static_cast<i64>(sequence) - static_cast<i64>(position);
+			if (difference == 0) {
+				if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+			}
+			// The cell still holds the element of the previous lap
+			else if (difference < 0) { return false; }
+			else { position = m_EnqueuePosition.load(std::memory_order_relaxed); }
+		}
+
+		writeElement(pCell->m_Element);
+		pCell->m_Sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template <typename T>
+	template <typename Reader>
+	bool MPSCQueue<T>::TryPop(Reader&& readElement) {
+		Cell&     cell = m_pCells[m_DequeuePosition & m_Mask];
+		u64 const sequence = cell.m_Sequence.load(std::memory_order_acquire);
+		if (sequence != m_DequeuePosition + 1) { return false; }
+
+		readElement(cell.m_Element);
+		cell.m_Sequence.store(m_DequeuePosition + m_Mask + 1, std::memory_order_release);
+		++m_DequeuePosition;
+		return true;
+	}
+}
@@ -2,19 +2,27 @@
 
 #include "CookieKat/Core/Containers/Containers.h"
 #include "CookieKat/Core/Containers/String.h"
+#include "CookieKat/Core/Logging/LogQueue.h"
+#include "CookieKat/Core/Logging/LogCapture.h"
+
 #include <format>
-#include <iostream>
 #include <chrono>
+#include <atomic>
+#include <cstdarg>
+#include <fstream>
+#include <mutex>
+#include <thread>
 
 namespace CKE {
 	// Macros to easily define logging levels and channels and their required metadata
 	//-----------------------------------------------------------------------------
 
+	// Ordered by severity
 #define CKE_LOGGING_DEF_LEVELS(DEF) \
+	DEF(Debug) \
 	DEF(Info) \
 	DEF(Warning) \
 	DEF(Error) \
-	DEF(Debug) \
 	DEF(Fatal)
 
 	// All of the available log channels
@@ -37,51 +45,97 @@ namespace CKE {
 
 #undef CKE_DEFINE_LOG_ENUM
 
+#define CKE_COUNT_LOG_ENUM(d) + 1
+
+	constexpr u32 NUM_LOG_LEVELS = 0 CKE_LOGGING_DEF_LEVELS(CKE_COUNT_LOG_ENUM);
+	constexpr u32 NUM_LOG_CHANNELS = 0 CKE_LOGGING_DEF_CHANNEL(CKE_COUNT_LOG_ENUM);
+
+#undef CKE_COUNT_LOG_ENUM
+
+	static_assert(NUM_LOG_LEVELS * NUM_LOG_CHANNELS <= 64, "The runtime filters use a bit for each level and channel");
+
+	// Levels below it are compiled out of the CKE_LOG macro and ignored by LoggingSystem::Log
+#ifndef CKE_LOG_MIN_LEVEL
+#define CKE_LOG_MIN_LEVEL Debug
+#endif
+
+	constexpr LogLevel LOG_COMPILE_TIME_MIN_LEVEL = LogLevel::CKE_LOG_MIN_LEVEL;
+
 	//-----------------------------------------------------------------------------
 
+	using LogTimeStamp = std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds>;
+
 	// Standard logging entry data
 	struct LogEntry
 	{
-		LogLevel                                                                                                  m_Level;
-		LogChannel                                                                                                m_Channel;
-		String                                                                                                    m_Message;
-		std::chrono::time_point<std::chrono::system_clock, std::chrono::duration<long long, std::ratio<1, 1000>>> m_TimeStamp; // Pls
+		LogLevel     m_Level;
+		LogChannel   m_Channel;
+		u32          m_ThreadIndex; // Index given to the logging thread the first time it logs
+		String       m_Message;
+		LogTimeStamp m_TimeStamp;
 	};
 
-	// General purpose logging system of the engine
+	// General purpose logging system of the engine.
+	// Callers copy the format arguments into a lock-free queue, a sink thread formats the messages and
+	// writes them to the console and the log file in batches.
+	// Before Initialize and after Shutdown messages are formatted and written directly by the calling thread.
 	class LoggingSystem
 	{
 	public:
+		// Number of entries kept in the history, older ones are dropped
+		static constexpr u64 MAX_LOG_HISTORY = 1024;
+
 		// Lifetime
 		//-----------------------------------------------------------------------------
 
-		void Initialize();
+		// Starts the sink thread, messages are also appended to the log file if a path is given.
+		// Nothing should be logged while the system is being shut down
+		void Initialize(char const* logFilePath = nullptr);
 		void Shutdown();
 
+		// Blocks until every message logged before the call has been written
+		void Flush();
+
+		// Copy of the last MAX_LOG_HISTORY entries, oldest first.
+		// Messages that haven't been written by the sink yet aren't included, call Flush before if needed
+		Vector<LogEntry> GetLogHistory() const;
+
+		// Runtime Filters
+		//-----------------------------------------------------------------------------
+
+		// Messages of the channel below minLevel are rejected before any work is done, all levels pass by default.
+		// Filters can be read from any thread while logging but should be changed from a single one
+		void SetChannelMinLevel(LogChannel channel, LogLevel minLevel);
+		void SetLevelEnabled(LogLevel level, bool enabled);
+
+		inline bool IsEnabled(LogLevel level, LogChannel channel) const;
+
 		// Templated API
 		//-----------------------------------------------------------------------------
 
+		// The format string is checked at compile time like in std::format. Strings and trivially copyable
+		// arguments are copied and formatted on the sink thread, other types are formatted by the caller.
+
 		// Logs a message directly without appending any extra information and without any tracking.
-		// Utilizes std::vformat to format the supplied message.
 		//
 		// Example:
 		//   Simple("Number {}", 42);
 		//
 		// Which outputs:
-		//   Number 42 
+		//   Number 42
 		template <typename... Args>
-		void Simple(char const* format, Args&&... args);
+		void Simple(std::format_string<Args...> format, Args&&... args);
 
 		// Logs a message using the standard format alongside the provided one.
-		// Utilizes std::vformat to format the supplied message.
+		// Fatal messages are flushed before stopping, even if they are filtered.
 		//
 		// Example:
 		//   Log(LogLevel::Info, LogChannel::Assets, "Number {}", 42);
 		//
 		// Which outputs:
-		//   24:60:60.000 | Info | Assets | Number 42 
+		//   24:60:60.000 | T0 | Info | Assets | Number 42
 		template <typename... Args>
-		void Log(LogLevel level, LogChannel channel, char const* format, Args&&... args);
+		void Log(LogLevel level, LogChannel channel, std::format_string<Args...> format, Args&&... args);
 
 		// C Based API
 		//-----------------------------------------------------------------------------
@@ -94,11 +148,81 @@ namespace CKE {
 		void FormatVA(char* pBuffer, u32 bufferSize, char const* format, va_list vaList);
 
 	private:
-		// Outputs a log entry to the console using its standard format
-		void OutputLogEntry(LogEntry const& entry);
+		using FormatFunction = void (*)(std::string_view format, u8 const* pData, String& output);
+
+		struct LogMessageHeader
+		{
+			LogTimeStamp m_TimeStamp;
+			u32          m_ThreadIndex;
+			u32          m_DataSize;
+			LogLevel     m_Level;
+			LogChannel   m_Channel;
+			bool         m_IsSimple; // Written as is, without the standard format or tracking
+		};
+
+		// Message in flight between a logging thread and the sink, data that doesn't fit inline is heap allocated
+		struct LogMessage
+		{
+			static constexpr u64 INLINE_DATA_SIZE = 184;
+
+			LogMessageHeader m_Header;
+			FormatFunction   m_pFormat; // Formats the captured arguments, nullptr if the data is the final text
+			std::string_view m_Format;
+			u8*              m_pLongData;
+			u8               m_Data[INLINE_DATA_SIZE];
+		};
+
+		static constexpr u64 QUEUE_CAPACITY = 8192;
+
+		// Per thread buffer the messages are formatted into, keeps its memory between calls
+		static String& GetThreadFormatBuffer();
+
+		static LogMessageHeader MakeHeader(LogLevel level, LogChannel channel, bool isSimple, u64 dataSize);
+
+		// Captures the arguments if possible, otherwise formats them and pushes the text
+		template <typename... Args>
+		void PushFormatted(LogLevel level, LogChannel channel, bool isSimple, std::string_view format, Args const&... args);
+
+		// Pushes formatted text to the sink thread or writes it directly if it isn't running
+		void PushText(LogLevel level, LogChannel channel, bool isSimple, std::string_view text);
+
+		// Claims a message in the queue and fills its data with writeData(u8*)
+		template <typename DataWriter>
+		void PushMessage(LogMessageHeader const& header, FormatFunction pFormat, std::string_view format,
+		                 DataWriter&& writeData);
+
+		void WriteDirectly(LogMessageHeader const& header, std::string_view text);
+
+		void UpdateEnabledMask();
+
+		void SinkThreadMain();
+
+		// Appends a message to the batches that will be written to the console and the file
+		void AppendMessage(LogMessageHeader const& header, std::string_view text, String& consoleBatch, String& fileBatch);
+		void WriteBatches(String& consoleBatch, String& fileBatch);
+
+		void AddToHistory(LogMessageHeader const& header, std::string_view text);
 
 	private:
-		Vector<LogEntry> m_LogEntries{}; // All log messages in the current execution
+		// One bit for each channel and level pair, set if its messages are logged
+		std::atomic<u64>                  m_EnabledMask{~0ull};
+		Array<LogLevel, NUM_LOG_CHANNELS> m_ChannelMinLevels{};
+		u32                               m_DisabledLevels = 0;
+
+		MPSCQueue<LogMessage> m_Queue;
+		std::thread           m_SinkThread;
+		std::atomic<bool>     m_IsRunning{false};
+		std::atomic<u64>      m_NumWritten{0}; // Messages popped and written by the sink
+
+		std::ofstream m_LogFile;
+
+		// Used when there is no sink thread
+		std::mutex m_DirectOutputMutex;
+
+		// Ring buffer of the last entries, only shared between the sink and GetLogHistory
+		mutable std::mutex m_HistoryMutex;
+		Vector<LogEntry>   m_History{};
+		u64                m_HistoryStart = 0;
 
 #define CKE_LOG_DEFINE_STR(x) #x,
 		constexpr static char const* const s_LogLevelLabels[] = {
@@ -114,30 +238,76 @@ namespace CKE {
 	inline LoggingSystem g_LoggingSystem{};
 }
 
+// Logs through the global logging system using the unqualified level and channel names.
+// Levels below CKE_LOG_MIN_LEVEL are removed at compile time along with the evaluation of the arguments.
+//
+// Example:
+//   CKE_LOG(Info, Assets, "Number {}", 42);
+#define CKE_LOG(level, channel, ...) \
+	do { \
+		if constexpr (CKE::LogLevel::level >= CKE::LOG_COMPILE_TIME_MIN_LEVEL) { \
+			CKE::g_LoggingSystem.Log(CKE::LogLevel::level, CKE::LogChannel::channel, __VA_ARGS__); \
+		} \
+	} while (false)
+
 // Template Implementation
 //-----------------------------------------------------------------------------
 
 namespace CKE {
+	inline bool LoggingSystem::IsEnabled(LogLevel level, LogChannel channel) const {
+		u32 const bit = static_cast<u32>(channel) * NUM_LOG_LEVELS + static_cast<u32>(level);
+		return (m_EnabledMask.load(std::memory_order_relaxed) >> bit) & 1;
+	}
+
 	template <typename... Args>
-	void LoggingSystem::Simple(char const* format, Args&&... args) {
-		std::cout << std::vformat(format, std::make_format_args(args...));
+	void LoggingSystem::Simple(std::format_string<Args...> format, Args&&... args) {
+		PushFormatted(LogLevel::Info, LogChannel::Core, true, format.get(), args...);
 	}
 
 	template <typename... Args>
-	void LoggingSystem::Log(LogLevel  level, LogChannel channel, char const* format,
-	                        Args&&... args) {
-		LogEntry entry{};
-		entry.m_TimeStamp = std::chrono::floor<std::chrono::milliseconds>(
-			std::chrono::system_clock::now());
-		entry.m_Channel = channel;
-		entry.m_Level = level;
-		entry.m_Message = std::vformat(format, std::make_format_args(args...));
-		m_LogEntries.emplace_back(entry);
-
-		OutputLogEntry(entry);
+	void LoggingSystem::Log(LogLevel level, LogChannel channel, std::format_string<Args...> format, Args&&... args) {
+		if (level >= LOG_COMPILE_TIME_MIN_LEVEL && IsEnabled(level, channel)) {
+			PushFormatted(level, channel, false, format.get(), args...);
+		}
 
 		if (level == LogLevel::Fatal) {
+			Flush();
 			CKE_UNREACHABLE_CODE();
 		}
 	}
+
+	template <typename... Args>
+	void LoggingSystem::PushFormatted(LogLevel  level, LogChannel channel, bool isSimple, std::string_view format,
+	                                  Args const&... args) {
+		constexpr bool canCapture = (LogCapture::Capturable<std::remove_cvref_t<Args>> && ...);
+		if constexpr (canCapture) {
+			if (m_IsRunning.load(std::memory_order_acquire)) {
+				u64 const dataSize = (u64{0} + ... + LogCapture::GetCapturedSize(args));
+				PushMessage(MakeHeader(level, channel, isSimple, dataSize),
+				            &LogCapture::FormatCaptured<std::remove_cvref_t<Args>...>, format,
+				            [&](u8* pData) { (LogCapture::Capture(pData, args), ...); });
+				return;
+			}
+		}
+
+		String& buffer = GetThreadFormatBuffer();
+		buffer.clear();
+		std::vformat_to(std::back_inserter(buffer), format, std::make_format_args(args...));
+		PushText(level, channel, isSimple, buffer);
+	}
+
+	template <typename DataWriter>
+	void LoggingSystem::PushMessage(LogMessageHeader const& header, FormatFunction pFormat, std::string_view format,
+	                                DataWriter&& writeData) {
+		auto writeMessage = [&](LogMessage& message) {
+			message.m_Header = header;
+			message.m_pFormat = pFormat;
+			message.m_Format = format;
+			message.m_pLongData = header.m_DataSize > LogMessage::INLINE_DATA_SIZE ? new u8[header.m_DataSize] : nullptr;
+			writeData(message.m_pLongData != nullptr ? message.m_pLongData : message.m_Data);
+		};
+
+		// A full queue means the sink is behind, wait for it rather than losing messages
+		while (!m_Queue.TryPush(writeMessage)) { std::this_thread::yield(); }
+	}
 }
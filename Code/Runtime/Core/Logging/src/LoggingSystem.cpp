@@ -2,37 +2,273 @@
 
 #include <cstdarg>
 #include <format>
+#include <iostream>
 
-#ifndef NOMINMAX
-#define NOMINMAX
+#ifdef _WIN32
+#include "CookieKat/Core/Platform/Platform_Win32.h"
 #endif
-#ifndef WIN32_LEAN_AND_MEAN
-#define WIN32_LEAN_AND_MEAN
-#endif
-#include <Windows.h>
 
 namespace CKE {
+	namespace {
+		// Max messages written in a single batch, bounds the time Flush callers wait for the sink
+		constexpr u64 MAX_BATCH_MESSAGES = 512;
+
+		constexpr char const* ANSI_RESET = "\x1b[0m";
+		constexpr char const* ANSI_GREY = "\x1b[90m";
+		constexpr char const* ANSI_CYAN = "\x1b[36m";
+
+		constexpr char const* s_LogLevelColors[] = {
+			"\x1b[90m", // Debug
+			"\x1b[32m", // Info
+			"\x1b[33m", // Warning
+			"\x1b[31m", // Error
+			"\x1b[1;31m", // Fatal
+		};
+
+		std::atomic<u32> s_NextThreadIndex{0};
+
+		u32 GetThreadIndex() {
+			thread_local u32 const t_ThreadIndex = s_NextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+			return t_ThreadIndex;
+		}
+
+		// Windows consoles only interpret ANSI escape sequences once they are enabled
+		void EnableConsoleColors() {
+#ifdef _WIN32
+			HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+			DWORD  mode = 0;
+			if (GetConsoleMode(hConsole, &mode)) {
+				SetConsoleMode(hConsole, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+			}
+#endif
+		}
+
+		// Time of the day in UTC as hh:mm:ss.mmm
+		void AppendTimeStamp(String& output, LogTimeStamp timeStamp) {
+			i64 const millisecondsInDay = 24 * 60 * 60 * 1000;
+			i64 const milliseconds = (timeStamp.time_since_epoch().count() % millisecondsInDay + millisecondsInDay) %
+					millisecondsInDay;
+			std::format_to(std::back_inserter(output), "{:02}:{:02}:{:02}.{:03}",
+			               milliseconds / 3'600'000, milliseconds / 60'000 % 60, milliseconds / 1000 % 60,
+			               milliseconds % 1000);
+		}
 
-	void LoggingSystem::Initialize() {
-		m_LogEntries.reserve(1000);
+		// Messages get their line break from the sink, one at the end of the text would leave empty lines
+		std::string_view TrimLineBreak(std::string_view text) {
+			if (!text.empty() && text.back() == '\n') { text.remove_suffix(1); }
+			return text;
+		}
+	}
+
+	void LoggingSystem::Initialize(char const* logFilePath) {
+		CKE_ASSERT(!m_IsRunning.load());
+
+		EnableConsoleColors();
+		if (logFilePath != nullptr) { m_LogFile.open(logFilePath, std::ios::binary | std::ios::trunc); }
+
+		m_History.clear();
+		m_History.reserve(MAX_LOG_HISTORY);
+		m_HistoryStart = 0;
+
+		m_Queue.Initialize(QUEUE_CAPACITY);
+		m_NumWritten.store(0);
+		m_IsRunning.store(true, std::memory_order_release);
+		m_SinkThread = std::thread{[this] { SinkThreadMain(); }};
 	}
 
 	void LoggingSystem::Shutdown() {
-		m_LogEntries.clear();
+		if (!m_IsRunning.load()) { return; }
+
+		// The sink writes everything that is left in the queue before exiting
+		m_IsRunning.store(false, std::memory_order_release);
+		m_SinkThread.join();
+		m_Queue.Shutdown();
+
+		if (m_LogFile.is_open()) { m_LogFile.close(); }
+
+		std::lock_guard lock{m_HistoryMutex};
+		m_History.clear();
+		m_HistoryStart = 0;
 	}
 
-	void LoggingSystem::AddLogEntryVA(LogLevel level, LogChannel channel, char const* format, va_list vaList) {
-		constexpr u32 MAX_MSG_SIZE = 4096;
-		static char   s_LogBuffer[MAX_MSG_SIZE];
-		FormatVA(s_LogBuffer, MAX_MSG_SIZE, format, vaList);
+	void LoggingSystem::Flush() {
+		if (!m_IsRunning.load(std::memory_order_acquire)) { return; }
+
+		u64 const numPushed = m_Queue.GetNumPushed();
+		u64       numWritten = m_NumWritten.load(std::memory_order_acquire);
+		while (numWritten < numPushed) {
+			m_NumWritten.wait(numWritten, std::memory_order_acquire);
+			numWritten = m_NumWritten.load(std::memory_order_acquire);
+		}
+	}
+
+	Vector<LogEntry> LoggingSystem::GetLogHistory() const {
+		std::lock_guard  lock{m_HistoryMutex};
+		Vector<LogEntry> history{};
+		history.reserve(m_History.size());
+		for (u64 i = 0; i < m_History.size(); ++i) {
+			history.push_back(m_History[(m_HistoryStart + i) % m_History.size()]);
+		}
+		return history;
+	}
+
+	String& LoggingSystem::GetThreadFormatBuffer() {
+		thread_local String t_FormatBuffer{};
+		return t_FormatBuffer;
+	}
 
-		printf("%s", s_LogBuffer);
+	LoggingSystem::LogMessageHeader LoggingSystem::MakeHeader(LogLevel level, LogChannel channel, bool isSimple,
+	                                                          u64      dataSize) {
+		LogMessageHeader header;
+		header.m_TimeStamp = std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::now());
+		header.m_ThreadIndex = GetThreadIndex();
+		header.m_DataSize = static_cast<u32>(dataSize);
+		header.m_Level = level;
+		header.m_Channel = channel;
+		header.m_IsSimple = isSimple;
+		return header;
+	}
+
+	void LoggingSystem::PushText(LogLevel level, LogChannel channel, bool isSimple, std::string_view text) {
+		LogMessageHeader const header = MakeHeader(level, channel, isSimple, text.size());
+		if (!m_IsRunning.load(std::memory_order_acquire)) {
+			WriteDirectly(header, text);
+			return;
+		}
+
+		PushMessage(header, nullptr, {}, [&](u8* pData) { memcpy(pData, text.data(), text.size()); });
+	}
+
+	void LoggingSystem::WriteDirectly(LogMessageHeader const& header, std::string_view text) {
+		String output{};
+		String fileOutput{};
+		AppendMessage(header, text, output, fileOutput);
+
+		std::lock_guard lock{m_DirectOutputMutex};
+		std::cout.write(output.data(), output.size());
+	}
 
+	void LoggingSystem::SetChannelMinLevel(LogChannel channel, LogLevel minLevel) {
+		m_ChannelMinLevels[static_cast<u32>(channel)] = minLevel;
+		UpdateEnabledMask();
+	}
+
+	void LoggingSystem::SetLevelEnabled(LogLevel level, bool enabled) {
+		u32 const levelBit = 1u << static_cast<u32>(level);
+		m_DisabledLevels = enabled ? m_DisabledLevels & ~levelBit : m_DisabledLevels | levelBit;
+		UpdateEnabledMask();
+	}
+
+	void LoggingSystem::UpdateEnabledMask() {
+		u64 mask = 0;
+		for (u32 channel = 0; channel < NUM_LOG_CHANNELS; ++channel) {
+			for (u32 level = static_cast<u32>(m_ChannelMinLevels[channel]); level < NUM_LOG_LEVELS; ++level) {
+				if ((m_DisabledLevels & (1u << level)) == 0) { mask |= 1ull << (channel * NUM_LOG_LEVELS + level); }
+			}
+		}
+		m_EnabledMask.store(mask, std::memory_order_relaxed);
+	}
+
+	void LoggingSystem::SinkThreadMain() {
+		String consoleBatch{};
+		String fileBatch{};
+		String formatBuffer{};
+
+		while (true) {
+			// Read before draining, messages pushed before Shutdown are always written
+			bool const stopRequested = !m_IsRunning.load(std::memory_order_acquire);
+
+			u64 numMessages = 0;
+			while (numMessages < MAX_BATCH_MESSAGES && m_Queue.TryPop([&](LogMessage& message) {
+				u8 const*        pData = message.m_pLongData != nullptr ? message.m_pLongData : message.m_Data;
+				std::string_view text{reinterpret_cast<char const*>(pData), message.m_Header.m_DataSize};
+				if (message.m_pFormat != nullptr) {
+					formatBuffer.clear();
+					message.m_pFormat(message.m_Format, pData, formatBuffer);
+					text = formatBuffer;
+				}
+
+				AppendMessage(message.m_Header, text, consoleBatch, fileBatch);
+				if (!message.m_Header.m_IsSimple) { AddToHistory(message.m_Header, text); }
+				delete[] message.m_pLongData;
+			})) {
+				++numMessages;
+			}
+
+			if (numMessages > 0) {
+				WriteBatches(consoleBatch, fileBatch);
+				m_NumWritten.fetch_add(numMessages, std::memory_order_release);
+				m_NumWritten.notify_all();
+				continue;
+			}
+
+			if (stopRequested) { break; }
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	void LoggingSystem::AppendMessage(LogMessageHeader const& header, std::string_view text,
+	                                  String&                 consoleBatch, String& fileBatch) {
+		if (header.m_IsSimple) {
+			consoleBatch.append(text);
+			fileBatch.append(text);
+			return;
+		}
+
+		String timeStamp{};
+		AppendTimeStamp(timeStamp, header.m_TimeStamp);
+		char const* const level = s_LogLevelLabels[static_cast<i32>(header.m_Level)];
+		char const* const channel = s_LogChannelsLabels[static_cast<i32>(header.m_Channel)];
+		text = TrimLineBreak(text);
+
+		std::format_to(std::back_inserter(consoleBatch), "{}{}{} | T{} | {}{}{} | {}{}{} | {}\n",
+		               ANSI_GREY, timeStamp, ANSI_RESET, header.m_ThreadIndex,
+		               s_LogLevelColors[static_cast<i32>(header.m_Level)], level, ANSI_RESET,
+		               ANSI_CYAN, channel, ANSI_RESET, text);
+
+		// The file gets the same line without the colors
+		std::format_to(std::back_inserter(fileBatch), "{} | T{} | {} | {} | {}\n",
+		               timeStamp, header.m_ThreadIndex, level, channel, text);
+	}
+
+	void LoggingSystem::WriteBatches(String& consoleBatch, String& fileBatch) {
+		std::cout.write(consoleBatch.data(), consoleBatch.size());
+		std::cout.flush();
+		consoleBatch.clear();
+
+		if (m_LogFile.is_open()) {
+			m_LogFile.write(fileBatch.data(), fileBatch.size());
+			m_LogFile.flush();
+		}
+		fileBatch.clear();
+	}
+
+	void LoggingSystem::AddToHistory(LogMessageHeader const& header, std::string_view text) {
 		LogEntry entry{};
-		entry.m_Channel = channel;
-		entry.m_Level = level;
-		entry.m_Message = String{s_LogBuffer};
-		m_LogEntries.emplace_back(entry);
+		entry.m_Level = header.m_Level;
+		entry.m_Channel = header.m_Channel;
+		entry.m_ThreadIndex = header.m_ThreadIndex;
+		entry.m_Message = String{TrimLineBreak(text)};
+		entry.m_TimeStamp = header.m_TimeStamp;
+
+		std::lock_guard lock{m_HistoryMutex};
+		if (m_History.size() < MAX_LOG_HISTORY) { m_History.push_back(std::move(entry)); }
+		else {
+			m_History[m_HistoryStart] = std::move(entry);
+			m_HistoryStart = (m_HistoryStart + 1) % MAX_LOG_HISTORY;
+		}
+	}
+
+	// C Based API
+	//-----------------------------------------------------------------------------
+
+	void LoggingSystem::AddLogEntryVA(LogLevel level, LogChannel channel, char const* format, va_list vaList) {
+		if (level < LOG_COMPILE_TIME_MIN_LEVEL || !IsEnabled(level, channel)) { return; }
+
+		constexpr u32 MAX_MSG_SIZE = 4096;
+		char          buffer[MAX_MSG_SIZE];
+		FormatVA(buffer, MAX_MSG_SIZE, format, vaList);
+		PushText(level, channel, false, buffer);
 	}
 
 	void LoggingSystem::Format(char* pBuffer, u32 bufferSize, char const* format, ...) {
@@ -46,24 +282,6 @@ namespace CKE {
 		vsnprintf(pBuffer, bufferSize, format, vaList);
 	}
 
-	void LoggingSystem::OutputLogEntry(LogEntry const& entry) {
-		HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-		// Get data about current time
-		SetConsoleTextAttribute(hConsole, 8);
-		std::cout << entry.m_TimeStamp;
-		SetConsoleTextAttribute(hConsole, 7);
-		std::cout << " | ";
-		SetConsoleTextAttribute(hConsole, 2);
-		std::cout << s_LogLevelLabels[static_cast<i32>(entry.m_Level)];
-		SetConsoleTextAttribute(hConsole, 7);
-		std::cout << " | ";
-		SetConsoleTextAttribute(hConsole, 3);
-		std::cout << s_LogChannelsLabels[static_cast<i32>(entry.m_Channel)];
-		SetConsoleTextAttribute(hConsole, 7);
-		std::cout << " | ";
-		std::cout << entry.m_Message;
-	}
-
 	void LoggingSystem::AddLogEntry(LogLevel level, LogChannel channel, char const* format, ...) {
 		va_list vaList;
 		va_start(vaList, format);
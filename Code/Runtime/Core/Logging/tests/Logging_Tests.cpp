@@ -1,21 +1,28 @@
 #include "CookieKat/Core/Logging/LoggingSystem.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
 using namespace CKE;
 
 class LoggingSystemTest : public testing::Test
 {
 protected:
 	void SetUp() override {
-		g_LoggingSystem.Initialize();
 		// To be able to test the console output, we redirect it to our own temporary buffer
 		m_OriginalConsoleBuffer = std::cout.rdbuf();
 		std::cout.rdbuf(m_ConsoleBuffer.rdbuf());
+		g_LoggingSystem.Initialize();
 	}
 
 	void TearDown() override {
-		std::cout.rdbuf(m_OriginalConsoleBuffer);
 		g_LoggingSystem.Shutdown();
+		std::cout.rdbuf(m_OriginalConsoleBuffer);
 	}
 
 	std::stringstream m_ConsoleBuffer;
@@ -26,6 +33,7 @@ private:
 
 TEST_F(LoggingSystemTest, Log) {
 	g_LoggingSystem.Log(LogLevel::Warning, LogChannel::Assets, "Number: {}, Str: {}", 42, "Pepe");
+	g_LoggingSystem.Flush();
 	String consoleOutput = m_ConsoleBuffer.str();
 	ASSERT_NE(consoleOutput.find("Number: 42, Str: Pepe"), String::npos);
 	ASSERT_NE(consoleOutput.find("Warning"), String::npos);
@@ -34,6 +42,224 @@ TEST_F(LoggingSystemTest, Log) {
 
 TEST_F(LoggingSystemTest, Simple) {
 	g_LoggingSystem.Simple("Number: {}, Str: {}", 42, "Pepe");
+	g_LoggingSystem.Flush();
 	String consoleOutput = m_ConsoleBuffer.str();
 	ASSERT_NE(consoleOutput.find("Number: 42, Str: Pepe"), String::npos);
 }
+
+TEST_F(LoggingSystemTest, Macro) {
+	CKE_LOG(Error, Rendering, "Code {}", 7);
+	g_LoggingSystem.Flush();
+	ASSERT_NE(m_ConsoleBuffer.str().find("Code 7"), String::npos);
+}
+
+TEST_F(LoggingSystemTest, LongMessage) {
+	String const longText(1000, 'x');
+	g_LoggingSystem.Log(LogLevel::Info, LogChannel::Core, "{}|end", longText);
+	g_LoggingSystem.Flush();
+	ASSERT_NE(m_ConsoleBuffer.str().find(longText + "|end"), String::npos);
+}
+
+TEST_F(LoggingSystemTest, HistoryIsBounded) {
+	u64 const numMessages = LoggingSystem::MAX_LOG_HISTORY + 10;
+	for (u64 i = 0; i < numMessages; ++i) {
+		g_LoggingSystem.Log(LogLevel::Info, LogChannel::Core, "{}\n", i);
+	}
+	g_LoggingSystem.Flush();
+
+	Vector<LogEntry> history = g_LoggingSystem.GetLogHistory();
+	ASSERT_EQ(history.size(), LoggingSystem::MAX_LOG_HISTORY);
+	EXPECT_EQ(history.front().m_Message, "10");
+	EXPECT_EQ(history.back().m_Message, std::to_string(numMessages - 1));
+	EXPECT_EQ(history.back().m_Channel, LogChannel::Core);
+}
+
+TEST_F(LoggingSystemTest, MultipleThreads) {
+	constexpr u32 NUM_THREADS = 4;
+	constexpr u32 NUM_MESSAGES = 5000;
+
+	Vector<std::thread> threads{};
+	for (u32 t = 0; t < NUM_THREADS; ++t) {
+		threads.emplace_back([t] {
+			for (u32 i = 0; i < NUM_MESSAGES; ++i) {
+				g_LoggingSystem.Log(LogLevel::Info, LogChannel::Game, "Thread {} Message {}", t, i);
+			}
+		});
+	}
+	for (std::thread& thread : threads) { thread.join(); }
+	g_LoggingSystem.Flush();
+
+	// Every message is written once and the messages of a thread keep their order
+	String const consoleOutput = m_ConsoleBuffer.str();
+	EXPECT_EQ(static_cast<u64>(std::count(consoleOutput.begin(), consoleOutput.end(), '\n')),
+	          NUM_THREADS * NUM_MESSAGES);
+	for (u32 t = 0; t < NUM_THREADS; ++t) {
+		u64 previousPosition = 0;
+		for (u32 i = 0; i < NUM_MESSAGES; i += 499) {
+			u64 const position = consoleOutput.find(std::format("Thread {} Message {}\n", t, i));
+			ASSERT_NE(position, String::npos);
+			EXPECT_GE(position, previousPosition);
+			previousPosition = position;
+		}
+	}
+}
+
+TEST_F(LoggingSystemTest, ArgumentsAreCopied) {
+	String    path = "Textures/Albedo.png";
+	char      name[] = "Albedo";
+	f32 const scale = 0.5f;
+	g_LoggingSystem.Log(LogLevel::Info, LogChannel::Assets, "{} {} {:.2f} {} {}", path, name, scale, true, 'c');
+
+	// The message is formatted later from the copies
+	path = "Changed";
+	name[0] = 'X';
+	g_LoggingSystem.Flush();
+	ASSERT_NE(m_ConsoleBuffer.str().find("Textures/Albedo.png Albedo 0.50 true c"), String::npos);
+}
+
+struct NamedValue
+{
+	String m_Name;
+	i32    m_Value;
+};
+
+template <>
+struct std::formatter<NamedValue> : std::formatter<std::string_view>
+{
+	auto format(NamedValue const& namedValue, std::format_context& context) const {
+		return std::format_to(context.out(), "{}={}", namedValue.m_Name, namedValue.m_Value);
+	}
+};
+
+TEST_F(LoggingSystemTest, NonTrivialArgumentsAreFormattedByTheCaller) {
+	g_LoggingSystem.Log(LogLevel::Info, LogChannel::Game, "Value {} {}", NamedValue{"Health", 100}, 3);
+	g_LoggingSystem.Flush();
+	ASSERT_NE(m_ConsoleBuffer.str().find("Value Health=100 3"), String::npos);
+}
+
+TEST_F(LoggingSystemTest, RuntimeFilters) {
+	g_LoggingSystem.SetChannelMinLevel(LogChannel::Rendering, LogLevel::Warning);
+	g_LoggingSystem.SetLevelEnabled(LogLevel::Debug, false);
+	EXPECT_FALSE(g_LoggingSystem.IsEnabled(LogLevel::Info, LogChannel::Rendering));
+	EXPECT_TRUE(g_LoggingSystem.IsEnabled(LogLevel::Error, LogChannel::Rendering));
+	EXPECT_TRUE(g_LoggingSystem.IsEnabled(LogLevel::Info, LogChannel::Game));
+	EXPECT_FALSE(g_LoggingSystem.IsEnabled(LogLevel::Debug, LogChannel::Game));
+
+	g_LoggingSystem.Log(LogLevel::Info, LogChannel::Rendering, "Filtered channel");
+	g_LoggingSystem.Log(LogLevel::Debug, LogChannel::Game, "Filtered level");
+	g_LoggingSystem.Log(LogLevel::Warning, LogChannel::Rendering, "Passes");
+	g_LoggingSystem.Flush();
+
+	String const consoleOutput = m_ConsoleBuffer.str();
+	EXPECT_EQ(consoleOutput.find("Filtered"), String::npos);
+	EXPECT_NE(consoleOutput.find("Passes"), String::npos);
+
+	g_LoggingSystem.SetChannelMinLevel(LogChannel::Rendering, LogLevel::Debug);
+	g_LoggingSystem.SetLevelEnabled(LogLevel::Debug, true);
+	EXPECT_TRUE(g_LoggingSystem.IsEnabled(LogLevel::Debug, LogChannel::Rendering));
+}
+
+TEST_F(LoggingSystemTest, LogFile) {
+	g_LoggingSystem.Shutdown();
+	g_LoggingSystem.Initialize("test_log.txt");
+	g_LoggingSystem.Log(LogLevel::Error, LogChannel::Resources, "Missing {}", "file.png");
+	g_LoggingSystem.Shutdown();
+
+	std::ifstream     file{"test_log.txt"};
+	std::stringstream fileContents;
+	fileContents << file.rdbuf();
+	String const text = fileContents.str();
+	EXPECT_NE(text.find("| Error | Resources | Missing file.png\n"), String::npos);
+	EXPECT_EQ(text.find('\x1b'), String::npos);
+
+	g_LoggingSystem.Initialize();
+}
+
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, they only print timings. Run them with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+
+// Time a logging call takes on the calling thread, with the sink thread and writing directly.
+// Messages are logged in bursts that fit in the queue, a full queue makes the callers wait for the sink
+TEST_F(LoggingSystemTest, DISABLED_Benchmark_LogLatency) {
+	constexpr u32 NUM_BURSTS = 20;
+	constexpr u32 BURST_SIZE = 1000;
+
+	auto logFromThreads = [&](u32 numThreads) {
+		f64 totalNs = 0.0;
+		for (u32 burst = 0; burst < NUM_BURSTS; ++burst) {
+			Vector<f64>         threadNs(numThreads);
+			Vector<std::thread> threads{};
+			for (u32 t = 0; t < numThreads; ++t) {
+				threads.emplace_back([&, t] {
+					auto const start = std::chrono::high_resolution_clock::now();
+					for (u32 i = 0; i < BURST_SIZE; ++i) {
+						g_LoggingSystem.Log(LogLevel::Info, LogChannel::Resources, "Request Loaded: {} {}",
+						                    "Textures/Albedo.png", i);
+					}
+					auto const end = std::chrono::high_resolution_clock::now();
+					threadNs[t] = std::chrono::duration<f64, std::nano>(end - start).count();
+				});
+			}
+			for (std::thread& thread : threads) { thread.join(); }
+			g_LoggingSystem.Flush();
+			m_ConsoleBuffer.str("");
+			for (f64 ns : threadNs) { totalNs += ns; }
+		}
+		return totalNs / (NUM_BURSTS * BURST_SIZE * numThreads);
+	};
+
+	f64 const asyncNs = logFromThreads(1);
+	f64 const asyncThreadsNs = logFromThreads(4);
+
+	g_LoggingSystem.Shutdown();
+	f64 const directNs = logFromThreads(1);
+	f64 const directThreadsNs = logFromThreads(4);
+	g_LoggingSystem.Initialize();
+
+	// std::cout is redirected by the fixture
+	printf("[Benchmark] Log call latency, 1 thread: async %.1f ns, direct %.1f ns\n", asyncNs, directNs);
+	printf("[Benchmark] Log call latency, 4 threads: async %.1f ns, direct %.1f ns\n", asyncThreadsNs, directThreadsNs);
+}
+
+// Time spent by the caller in a log call that is rejected by a runtime filter and in one that is logged,
+// compared with formatting the same message on the calling thread
+TEST_F(LoggingSystemTest, DISABLED_Benchmark_LogCallCost) {
+	constexpr u32 NUM_BURSTS = 20;
+	constexpr u32 BURST_SIZE = 4000;
+
+	String const path = "Textures/Albedo.png";
+	auto         nsPerCall = [&](auto&& logMessage) {
+		f64 bestNs = std::numeric_limits<f64>::max();
+		for (u32 burst = 0; burst < NUM_BURSTS; ++burst) {
+			auto const start = std::chrono::high_resolution_clock::now();
+			for (u32 i = 0; i < BURST_SIZE; ++i) { logMessage(i); }
+			auto const end = std::chrono::high_resolution_clock::now();
+			bestNs = std::min(bestNs, std::chrono::duration<f64, std::nano>(end - start).count() / BURST_SIZE);
+
+			g_LoggingSystem.Flush();
+			m_ConsoleBuffer.str("");
+		}
+		return bestNs;
+	};
+
+	g_LoggingSystem.SetChannelMinLevel(LogChannel::Rendering, LogLevel::Error);
+	f64 const filteredNs = nsPerCall([&](u32 i) {
+		g_LoggingSystem.Log(LogLevel::Info, LogChannel::Rendering, "Loaded {} in {} ms", path, i);
+	});
+	g_LoggingSystem.SetChannelMinLevel(LogChannel::Rendering, LogLevel::Debug);
+
+	f64 const loggedNs = nsPerCall([&](u32 i) {
+		g_LoggingSystem.Log(LogLevel::Info, LogChannel::Resources, "Loaded {} in {} ms", path, i);
+	});
+
+	String    formatted{};
+	f64 const formatNs = nsPerCall([&](u32 i) {
+		formatted.clear();
+		std::format_to(std::back_inserter(formatted), "Loaded {} in {} ms", path, i);
+	});
+
+	printf("[Benchmark] Log call: filtered %.1f ns, logged %.1f ns, formatting on the caller alone %.1f ns\n",
+	       filteredNs, loggedNs, formatNs);
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CookieKat/Core/Math/Math.h"
+
+#include <limits>
+
+namespace CKE {
+	// Axis aligned bounding box
+	struct AABB
+	{
+		Vec3 m_Min{std::numeric_limits<f32>::max()};
+		Vec3 m_Max{std::numeric_limits<f32>::lowest()};
+
+		inline bool IsValid() const { return m_Min.x <= m_Max.x && m_Min.y <= m_Max.y && m_Min.z <= m_Max.z; }
+		inline Vec3 GetCenter() const { return (m_Min + m_Max) * 0.5f; }
+		inline Vec3 GetExtents() const { return (m_Max - m_Min) * 0.5f; }
+
+		inline f32 GetSurfaceArea() const {
+			Vec3 const size = m_Max - m_Min;
+			return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		inline void Expand(Vec3 point) {
+			m_Min = glm::min(m_Min, point);
+			m_Max = glm::max(m_Max, point);
+		}
+
+		inline void Expand(AABB const& other) {
+			m_Min = glm::min(m_Min, other.m_Min);
+			m_Max = glm::max(m_Max, other.m_Max);
+		}
+
+		// Box that contains this one after transforming it, the extents are projected on the transformed axes
+		inline AABB Transform(Mat4 const& transform) const {
+			Vec3 const center = Vec3{transform * Vec4{GetCenter(), 1.0f}};
+			Vec3 const extents = GetExtents();
+			Vec3 const worldExtents = glm::abs(Vec3{transform[0]}) * extents.x
+					+ glm::abs(Vec3{transform[1]}) * extents.y
+					+ glm::abs(Vec3{transform[2]}) * extents.z;
+			return AABB{center - worldExtents, center + worldExtents};
+		}
+	};
+
+	enum class FrustumTest : u8
+	{
+		Outside,
+		Intersecting,
+		Inside,
+	};
+
+	// View frustum as 6 planes pointing inwards, xyz is the normal and w the distance
+	struct Frustum
+	{
+		Vec4 m_Planes[6];
+
+		// Planes of a view-projection matrix with a [0, 1] depth range
+		inline static Frustum FromViewProjection(Mat4 const& viewProj) {
+			Mat4 const m = glm::transpose(viewProj);
+
+			Frustum frustum{};
+			frustum.m_Planes[0] = m[3] + m[0]; // Left
+			frustum.m_Planes[1] = m[3] - m[0]; // Right
+			frustum.m_Planes[2] = m[3] + m[1]; // Bottom
+			frustum.m_Planes[3] = m[3] - m[1]; // Top
+			frustum.m_Planes[4] = m[2];        // Near
+			frustum.m_Planes[5] = m[3] - m[2]; // Far
+			for (Vec4& plane : frustum.m_Planes) { plane /= glm::length(Vec3{plane}); }
+			return frustum;
+		}
+
+		// Conservative test, boxes close to the frustum corners can be reported as intersecting
+		inline FrustumTest Test(AABB const& box) const {
+			Vec3 const  center = box.GetCenter();
+			Vec3 const  extents = box.GetExtents();
+			FrustumTest result = FrustumTest::Inside;
+			for (Vec4 const& plane : m_Planes) {
+				f32 const distance = glm::dot(Vec3{plane}, center) + plane.w;
+				f32 const radius = glm::dot(glm::abs(Vec3{plane}), extents);
+				if (distance < -radius) { return FrustumTest::Outside; }
+				if (distance < radius) { result = FrustumTest::Intersecting; }
+			}
+			return result;
+		}
+
+		inline bool IsVisible(AABB const& box) const { return Test(box) != FrustumTest::Outside; }
+	};
+}
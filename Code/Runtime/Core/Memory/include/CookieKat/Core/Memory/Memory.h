@@ -146,6 +146,9 @@ namespace CKE::Memory {
 
 		u64 GetTotalReleasedMemory() const { return m_TotalReleased; }
 
+		// Number of blocks allocated with Alloc since the last reset
+		u64 GetNumAllocations() const { return m_NumAllocations; }
+
 		MemoryAllocationInfo GetAllocationInfo(void* pAddress) const { return m_ActiveAllocations.at((MemoryAddress)pAddress); }
 
 		// Manipulators
@@ -154,6 +157,7 @@ namespace CKE::Memory {
 		inline void Reset() {
 			m_TotalAllocated = 0;
 			m_TotalReleased = 0;
+			m_NumAllocations = 0;
 			m_OperationsHistory.clear();
 			m_ActiveAllocations.clear();
 		}
@@ -165,6 +169,7 @@ namespace CKE::Memory {
 	private:
 		u64 m_TotalAllocated = 0;
 		u64 m_TotalReleased = 0;
+		u64 m_NumAllocations = 0;
 
 		Vector<MemoryOperationInfo>              m_OperationsHistory;
 		Map<MemoryAddress, MemoryAllocationInfo> m_ActiveAllocations;
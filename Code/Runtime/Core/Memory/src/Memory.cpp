@@ -4,6 +4,9 @@ namespace CKE::Memory {
 	void MemoryTrackingManager::RecordOperation(MemoryOperationInfo operationInfo) {
 		m_OperationsHistory.push_back(operationInfo);
 
+		// New and NewArray blocks are also recorded as an Alloc
+		if (operationInfo.m_Operation == MemoryOp::Alloc) { ++m_NumAllocations; }
+
 		if (operationInfo.m_Operation == MemoryOp::Alloc ||
 			operationInfo.m_Operation == MemoryOp::New ||
 			operationInfo.m_Operation == MemoryOp::NewArray) {
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "CookieKat/Core/Platform/PrimitiveTypes.h"
+
+#include <atomic>
+#include <chrono>
+
+namespace CKE {
+	enum class MetricType : u8
+	{
+		Counter,
+		Gauge,
+		Histogram,
+	};
+
+	// Monotonic count of events, e.g. allocations
+	class MetricCounter
+	{
+	public:
+		inline void Add(u64 amount = 1) { m_Value.fetch_add(amount, std::memory_order_relaxed); }
+		inline u64  GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<u64> m_Value{0};
+	};
+
+	// Last value of a quantity, e.g. the number of entities
+	class MetricGauge
+	{
+	public:
+		inline void Set(f64 value) { m_Value.store(value, std::memory_order_relaxed); }
+		inline f64  GetValue() const { return m_Value.load(std::memory_order_relaxed); }
+
+	private:
+		std::atomic<f64> m_Value{0.0};
+	};
+
+	// Distribution of values with log-linear buckets (HDR histogram style).
+	// Each power of two is split in SUB_BUCKET_COUNT buckets, percentiles are within 1/64 of the recorded values.
+	// Values above MAX_VALUE are clamped, in nanoseconds that is around 18 minutes.
+	// Recording can happen from any thread.
+	class MetricHistogram
+	{
+	public:
+		static constexpr u32 SUB_BUCKET_BITS = 6;
+		static constexpr u64 SUB_BUCKET_COUNT = 1ull << SUB_BUCKET_BITS;
+		static constexpr u32 MAX_VALUE_BITS = 40;
+		static constexpr u64 MAX_VALUE = (1ull << MAX_VALUE_BITS) - 1;
+		static constexpr u64 NUM_BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+		void Record(u64 value);
+
+		u64 GetCount() const { return m_Count.load(std::memory_order_relaxed); }
+		u64 GetMax() const { return m_Max.load(std::memory_order_relaxed); }
+		f64 GetMean() const;
+
+		// Value below which the given fraction of the recorded values are, percentile in [0, 1]
+		u64 GetPercentile(f64 percentile) const;
+
+		void Reset();
+
+		static u64 GetBucketIndex(u64 value);
+
+		// Middle of the range of values that fall in the bucket
+		static u64 GetBucketValue(u64 bucketIndex);
+
+	private:
+		std::atomic<u64> m_Buckets[NUM_BUCKETS]{};
+		std::atomic<u64> m_Count{0};
+		std::atomic<u64> m_Sum{0};
+		std::atomic<u64> m_Max{0};
+	};
+
+	// Records the time from construction to destruction in nanoseconds
+	class ScopedMetricTimer
+	{
+	public:
+		explicit ScopedMetricTimer(MetricHistogram& histogram)
+			: m_Histogram{histogram}, m_Start{std::chrono::steady_clock::now()} {}
+
+		~ScopedMetricTimer() {
+			auto const end = std::chrono::steady_clock::now();
+			m_Histogram.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - m_Start).count());
+		}
+
+		ScopedMetricTimer(ScopedMetricTimer const&) = delete;
+		ScopedMetricTimer& operator=(ScopedMetricTimer const&) = delete;
+
+	private:
+		MetricHistogram&                      m_Histogram;
+		std::chrono::steady_clock::time_point m_Start;
+	};
+}
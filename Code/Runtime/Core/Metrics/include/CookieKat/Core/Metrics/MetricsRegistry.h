@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Containers/String.h"
+#include "CookieKat/Core/Metrics/Metrics.h"
+
+#include <fstream>
+#include <mutex>
+#include <string_view>
+
+namespace CKE {
+	struct MetricsSettings
+	{
+		// Frames aggregated in each window, percentiles are computed over the last complete window
+		u32 m_WindowFrames = 300;
+
+		// Files every window is appended to, none if null.
+		// The CSV has a row per metric and window, the JSON file an object per window and line
+		char const* m_pCsvFilePath = nullptr;
+		char const* m_pJsonFilePath = nullptr;
+	};
+
+	// Values of a metric over a window
+	struct MetricSample
+	{
+		String     m_Name;
+		MetricType m_Type;
+		f64        m_Value; // Counter total, gauge value or histogram mean
+		u64        m_Count; // Counter increase or histogram values recorded in the window
+		u64        m_P50;
+		u64        m_P95;
+		u64        m_P99;
+		u64        m_Max;
+	};
+
+	// Named counters, gauges and histograms that are aggregated in windows of frames and dumped to disk,
+	// meant for long runs that have no profiler attached.
+	// Metrics are created on first use and the references stay valid until Shutdown. Creating them takes
+	// a lock, callers keep the reference instead of looking the name up every frame.
+	class MetricsRegistry
+	{
+	public:
+		MetricsRegistry() = default;
+		~MetricsRegistry() { Shutdown(); }
+
+		MetricsRegistry(MetricsRegistry const&) = delete;
+		MetricsRegistry& operator=(MetricsRegistry const&) = delete;
+
+		// Lifetime
+		//-----------------------------------------------------------------------------
+
+		void Initialize(MetricsSettings const& settings = {});
+
+		// Closes the window in progress and releases the metrics
+		void Shutdown();
+
+		// Metrics
+		//-----------------------------------------------------------------------------
+
+		MetricCounter&   GetCounter(std::string_view name);
+		MetricGauge&     GetGauge(std::string_view name);
+		MetricHistogram& GetHistogram(std::string_view name);
+
+		// Windows
+		//-----------------------------------------------------------------------------
+
+		// Called once at the end of every frame from the main thread
+		void EndFrame();
+
+		// Samples the metrics, writes them to the files and starts a new window
+		void CloseWindow();
+
+		// Samples of the last complete window, sorted by name
+		Vector<MetricSample> const& GetLastWindow() const { return m_LastWindow; }
+
+		u64 GetNumFrames() const { return m_NumFrames; }
+		u64 GetNumWindows() const { return m_NumWindows; }
+
+	private:
+		struct MetricRecord
+		{
+			String     m_Name;
+			MetricType m_Type;
+			void*      m_pMetric;
+			u64        m_WindowStartValue; // Counter value when the window started
+		};
+
+		void* GetOrCreateMetric(std::string_view name, MetricType type);
+
+		void WriteCsv(Vector<MetricSample> const& samples);
+		void WriteJson(Vector<MetricSample> const& samples);
+
+	private:
+		MetricsSettings m_Settings{};
+		bool            m_IsInitialized = false;
+
+		std::mutex           m_MetricsMutex;
+		Map<String, u64>     m_NameToRecord;
+		Vector<MetricRecord> m_Records;
+
+		u64                  m_NumFrames = 0;
+		u64                  m_WindowStartFrame = 0;
+		u64                  m_NumWindows = 0;
+		Vector<MetricSample> m_LastWindow{};
+
+		std::ofstream m_CsvFile;
+		std::ofstream m_JsonFile;
+	};
+}
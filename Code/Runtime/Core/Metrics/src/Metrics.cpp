@@ -0,0 +1,61 @@
+#include "Metrics.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace CKE {
+	void MetricHistogram::Record(u64 value) {
+		value = value > MAX_VALUE ? MAX_VALUE : value;
+
+		m_Buckets[GetBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+		m_Count.fetch_add(1, std::memory_order_relaxed);
+		m_Sum.fetch_add(value, std::memory_order_relaxed);
+
+		u64 max = m_Max.load(std::memory_order_relaxed);
+		while (value > max && !m_Max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {}
+	}
+
+	f64 MetricHistogram::GetMean() const {
+		u64 const count = GetCount();
+		return count > 0 ? static_cast<f64>(m_Sum.load(std::memory_order_relaxed)) / static_cast<f64>(count) : 0.0;
+	}
+
+	u64 MetricHistogram::GetPercentile(f64 percentile) const {
+		u64 const count = GetCount();
+		if (count == 0) { return 0; }
+
+		// Rank of the value, the smallest one counts as rank 1
+		u64 const rank = std::max<u64>(1, static_cast<u64>(percentile * static_cast<f64>(count) + 0.999999));
+		u64       accumulated = 0;
+		for (u64 i = 0; i < NUM_BUCKETS; ++i) {
+			accumulated += m_Buckets[i].load(std::memory_order_relaxed);
+			if (accumulated >= rank) { return std::min(GetBucketValue(i), GetMax()); }
+		}
+		return GetMax();
+	}
+
+	void MetricHistogram::Reset() {
+		for (std::atomic<u64>& bucket : m_Buckets) { bucket.store(0, std::memory_order_relaxed); }
+		m_Count.store(0, std::memory_order_relaxed);
+		m_Sum.store(0, std::memory_order_relaxed);
+		m_Max.store(0, std::memory_order_relaxed);
+	}
+
+	// Values below 2 * SUB_BUCKET_COUNT get a bucket each, above that the buckets of a power of two
+	// are shifted versions of the ones of the previous power
+	u64 MetricHistogram::GetBucketIndex(u64 value) {
+		u32 const magnitude = static_cast<u32>(std::bit_width(value));
+		if (magnitude <= SUB_BUCKET_BITS + 1) { return value; }
+
+		u32 const shift = magnitude - SUB_BUCKET_BITS - 1;
+		return shift * SUB_BUCKET_COUNT + (value >> shift);
+	}
+
+	u64 MetricHistogram::GetBucketValue(u64 bucketIndex) {
+		if (bucketIndex < 2 * SUB_BUCKET_COUNT) { return bucketIndex; }
+
+		u64 const shift = bucketIndex / SUB_BUCKET_COUNT - 1;
+		u64 const lowest = (bucketIndex - shift * SUB_BUCKET_COUNT) << shift;
+		return lowest + ((1ull << shift) - 1) / 2;
+	}
+}
@@ -0,0 +1,204 @@
+#include "MetricsRegistry.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <algorithm>
+#include <format>
+
+namespace CKE {
+	namespace {
+		constexpr char const* s_MetricTypeLabels[] = {"counter", "gauge", "histogram"};
+
+		void AppendJsonString(String& output, std::string_view text) {
+			output.push_back('"');
+			for (char const c : text) {
+				if (c == '"' || c == '\\') { output.push_back('\\'); }
+				output.push_back(c);
+			}
+			output.push_back('"');
+		}
+
+		void AppendCsvString(String& output, std::string_view text) {
+			output.push_back('"');
+			for (char const c : text) {
+				if (c == '"') { output.push_back('"'); }
+				output.push_back(c);
+			}
+			output.push_back('"');
+		}
+	}
+
+	void MetricsRegistry::Initialize(MetricsSettings const& settings) {
+		CKE_ASSERT(!m_IsInitialized);
+		CKE_ASSERT(settings.m_WindowFrames > 0);
+
+		m_Settings = settings;
+		m_NumFrames = 0;
+		m_WindowStartFrame = 0;
+		m_NumWindows = 0;
+		m_LastWindow.clear();
+
+		if (m_Settings.m_pCsvFilePath != nullptr) {
+			m_CsvFile.open(m_Settings.m_pCsvFilePath, std::ios::binary | std::ios::trunc);
+			m_CsvFile << "window,frame,name,type,value,count,p50,p95,p99,max\n";
+		}
+		if (m_Settings.m_pJsonFilePath != nullptr) {
+			m_JsonFile.open(m_Settings.m_pJsonFilePath, std::ios::binary | std::ios::trunc);
+		}
+		m_IsInitialized = true;
+	}
+
+	void MetricsRegistry::Shutdown() {
+		// The frames of the last partial window are not lost
+		if (m_IsInitialized && m_NumFrames > m_WindowStartFrame) { CloseWindow(); }
+
+		if (m_CsvFile.is_open()) { m_CsvFile.close(); }
+		if (m_JsonFile.is_open()) { m_JsonFile.close(); }
+
+		std::lock_guard lock{m_MetricsMutex};
+		for (MetricRecord const& record : m_Records) {
+			switch (record.m_Type) {
+			case MetricType::Counter: delete static_cast<MetricCounter*>(record.m_pMetric);
+				break;
+			case MetricType::Gauge: delete static_cast<MetricGauge*>(record.m_pMetric);
+				break;
+			case MetricType::Histogram: delete static_cast<MetricHistogram*>(record.m_pMetric);
+				break;
+			}
+		}
+		m_Records.clear();
+		m_NameToRecord.clear();
+		m_IsInitialized = false;
+	}
+
+	// Metrics
+	//-----------------------------------------------------------------------------
+
+	MetricCounter& MetricsRegistry::GetCounter(std::string_view name) {
+		return *static_cast<MetricCounter*>(GetOrCreateMetric(name, MetricType::Counter));
+	}
+
+	MetricGauge& MetricsRegistry::GetGauge(std::string_view name) {
+		return *static_cast<MetricGauge*>(GetOrCreateMetric(name, MetricType::Gauge));
+	}
+
+	MetricHistogram& MetricsRegistry::GetHistogram(std::string_view name) {
+		return *static_cast<MetricHistogram*>(GetOrCreateMetric(name, MetricType::Histogram));
+	}
+
+	void* MetricsRegistry::GetOrCreateMetric(std::string_view name, MetricType type) {
+		std::lock_guard lock{m_MetricsMutex};
+
+		String     nameString{name};
+		auto const it = m_NameToRecord.find(nameString);
+		if (it != m_NameToRecord.end()) {
+			// The same name can't be used for metrics of different types
+			CKE_ASSERT(m_Records[it->second].m_Type == type);
+			return m_Records[it->second].m_pMetric;
+		}
+
+		MetricRecord record{};
+		record.m_Name = nameString;
+		record.m_Type = type;
+		switch (type) {
+		case MetricType::Counter: record.m_pMetric = new MetricCounter{};
+			break;
+		case MetricType::Gauge: record.m_pMetric = new MetricGauge{};
+			break;
+		case MetricType::Histogram: record.m_pMetric = new MetricHistogram{};
+			break;
+		}
+
+		m_NameToRecord.insert({std::move(nameString), m_Records.size()});
+		m_Records.push_back(std::move(record));
+		return m_Records.back().m_pMetric;
+	}
+
+	// Windows
+	//-----------------------------------------------------------------------------
+
+	void MetricsRegistry::EndFrame() {
+		++m_NumFrames;
+		if (m_NumFrames - m_WindowStartFrame >= m_Settings.m_WindowFrames) { CloseWindow(); }
+	}
+
+	void MetricsRegistry::CloseWindow() {
+		Vector<MetricSample> samples{};
+		{
+			std::lock_guard lock{m_MetricsMutex};
+			samples.reserve(m_Records.size());
+			for (MetricRecord& record : m_Records) {
+				MetricSample sample{};
+				sample.m_Name = record.m_Name;
+				sample.m_Type = record.m_Type;
+
+				if (record.m_Type == MetricType::Counter) {
+					u64 const value = static_cast<MetricCounter*>(record.m_pMetric)->GetValue();
+					sample.m_Value = static_cast<f64>(value);
+					sample.m_Count = value - record.m_WindowStartValue;
+					record.m_WindowStartValue = value;
+				}
+				else if (record.m_Type == MetricType::Gauge) {
+					sample.m_Value = static_cast<MetricGauge*>(record.m_pMetric)->GetValue();
+				}
+				else {
+					MetricHistogram* pHistogram = static_cast<MetricHistogram*>(record.m_pMetric);
+					sample.m_Value = pHistogram->GetMean();
+					sample.m_Count = pHistogram->GetCount();
+					sample.m_P50 = pHistogram->GetPercentile(0.50);
+					sample.m_P95 = pHistogram->GetPercentile(0.95);
+					sample.m_P99 = pHistogram->GetPercentile(0.99);
+					sample.m_Max = pHistogram->GetMax();
+					pHistogram->Reset();
+				}
+				samples.push_back(std::move(sample));
+			}
+		}
+
+		std::sort(samples.begin(), samples.end(), [](MetricSample const& a, MetricSample const& b) {
+			return a.m_Name < b.m_Name;
+		});
+
+		if (m_CsvFile.is_open()) { WriteCsv(samples); }
+		if (m_JsonFile.is_open()) { WriteJson(samples); }
+
+		m_LastWindow = std::move(samples);
+		m_WindowStartFrame = m_NumFrames;
+		++m_NumWindows;
+	}
+
+	void MetricsRegistry::WriteCsv(Vector<MetricSample> const& samples) {
+		String output{};
+		for (MetricSample const& sample : samples) {
+			std::format_to(std::back_inserter(output), "{},{},", m_NumWindows, m_NumFrames);
+			AppendCsvString(output, sample.m_Name);
+			std::format_to(std::back_inserter(output), ",{},{},{},{},{},{},{}\n",
+			               s_MetricTypeLabels[static_cast<u8>(sample.m_Type)], sample.m_Value, sample.m_Count,
+			               sample.m_P50, sample.m_P95, sample.m_P99, sample.m_Max);
+		}
+		m_CsvFile.write(output.data(), output.size());
+		m_CsvFile.flush();
+	}
+
+	void MetricsRegistry::WriteJson(Vector<MetricSample> const& samples) {
+		String output{};
+		std::format_to(std::back_inserter(output), "{{\"window\":{},\"frame\":{},\"metrics\":{{", m_NumWindows,
+		               m_NumFrames);
+		for (u64 i = 0; i < samples.size(); ++i) {
+			MetricSample const& sample = samples[i];
+			if (i > 0) { output.push_back(','); }
+			AppendJsonString(output, sample.m_Name);
+			std::format_to(std::back_inserter(output), ":{{\"type\":\"{}\",\"value\":{}",
+			               s_MetricTypeLabels[static_cast<u8>(sample.m_Type)], sample.m_Value);
+			if (sample.m_Type != MetricType::Gauge) { std::format_to(std::back_inserter(output), ",\"count\":{}", sample.m_Count); }
+			if (sample.m_Type == MetricType::Histogram) {
+				std::format_to(std::back_inserter(output), ",\"p50\":{},\"p95\":{},\"p99\":{},\"max\":{}",
+				               sample.m_P50, sample.m_P95, sample.m_P99, sample.m_Max);
+			}
+			output.push_back('}');
+		}
+		output.append("}}\n");
+		m_JsonFile.write(output.data(), output.size());
+		m_JsonFile.flush();
+	}
+}
@@ -0,0 +1,164 @@
+#include "CookieKat/Core/Metrics/MetricsRegistry.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
+
+using namespace CKE;
+
+//-----------------------------------------------------------------------------
+
+TEST(MetricHistogram, Buckets_Are_Contiguous) {
+	u64 previousIndex = 0;
+	for (u64 value = 1; value < 1 << 20; ++value) {
+		u64 const index = MetricHistogram::GetBucketIndex(value);
+		ASSERT_TRUE(index == previousIndex || index == previousIndex + 1);
+		previousIndex = index;
+	}
+	EXPECT_EQ(MetricHistogram::GetBucketIndex(MetricHistogram::MAX_VALUE), MetricHistogram::NUM_BUCKETS - 1);
+}
+
+TEST(MetricHistogram, Bucket_Value_Precision) {
+	for (u64 value = 1; value < MetricHistogram::MAX_VALUE; value = value * 3 + 1) {
+		u64 const bucketValue = MetricHistogram::GetBucketValue(MetricHistogram::GetBucketIndex(value));
+		f64 const error = std::abs(static_cast<f64>(bucketValue) - static_cast<f64>(value)) / static_cast<f64>(value);
+		EXPECT_LT(error, 1.0 / MetricHistogram::SUB_BUCKET_COUNT) << value;
+	}
+}
+
+TEST(MetricHistogram, Percentiles) {
+	MetricHistogram histogram{};
+	Vector<u64>     values{};
+	std::mt19937_64 random{42};
+	for (u32 i = 0; i < 10'000; ++i) {
+		// Frame times between 1 and 50 ms
+		values.push_back(1'000'000 + random() % 49'000'000);
+		histogram.Record(values.back());
+	}
+	std::sort(values.begin(), values.end());
+
+	EXPECT_EQ(histogram.GetCount(), values.size());
+	EXPECT_EQ(histogram.GetMax(), values.back());
+	for (f64 percentile : {0.5, 0.95, 0.99}) {
+		f64 const expected = static_cast<f64>(values[static_cast<u64>(percentile * values.size()) - 1]);
+		EXPECT_NEAR(static_cast<f64>(histogram.GetPercentile(percentile)), expected, expected / 64.0);
+	}
+
+	histogram.Reset();
+	EXPECT_EQ(histogram.GetCount(), 0);
+	EXPECT_EQ(histogram.GetPercentile(0.5), 0);
+}
+
+TEST(MetricHistogram, Values_Above_Max_Are_Clamped) {
+	MetricHistogram histogram{};
+	histogram.Record(~0ull);
+	EXPECT_EQ(histogram.GetMax(), MetricHistogram::MAX_VALUE);
+	EXPECT_NEAR(static_cast<f64>(histogram.GetPercentile(1.0)), static_cast<f64>(MetricHistogram::MAX_VALUE),
+	            MetricHistogram::MAX_VALUE / 64.0);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(MetricsRegistry, Windows) {
+	MetricsRegistry registry{};
+	MetricsSettings settings{};
+	settings.m_WindowFrames = 10;
+	registry.Initialize(settings);
+
+	MetricCounter&   allocations = registry.GetCounter("Memory.Allocations");
+	MetricGauge&     entities = registry.GetGauge("Entities.Count");
+	MetricHistogram& frameTime = registry.GetHistogram("Engine.FrameNs");
+	EXPECT_EQ(&registry.GetCounter("Memory.Allocations"), &allocations);
+
+	for (u64 frame = 0; frame < 25; ++frame) {
+		allocations.Add(2);
+		entities.Set(static_cast<f64>(frame));
+		frameTime.Record(frame < 10 ? 1000 : 2000);
+		registry.EndFrame();
+
+		if (frame == 9) {
+			Vector<MetricSample> const& window = registry.GetLastWindow();
+			ASSERT_EQ(window.size(), 3);
+			EXPECT_EQ(window[0].m_Name, "Engine.FrameNs");
+			EXPECT_EQ(window[0].m_Count, 10);
+			EXPECT_EQ(window[0].m_P99, 1000);
+			EXPECT_EQ(window[1].m_Name, "Entities.Count");
+			EXPECT_EQ(window[1].m_Value, 9.0);
+			EXPECT_EQ(window[2].m_Name, "Memory.Allocations");
+			EXPECT_EQ(window[2].m_Count, 20);
+		}
+	}
+	EXPECT_EQ(registry.GetNumWindows(), 2);
+
+	// The second window only saw the slower frames
+	Vector<MetricSample> const& window = registry.GetLastWindow();
+	EXPECT_EQ(window[0].m_P50, 2000);
+	EXPECT_EQ(window[2].m_Value, 40.0);
+	EXPECT_EQ(window[2].m_Count, 20);
+
+	// The partial window is closed at shutdown
+	registry.Shutdown();
+	EXPECT_EQ(registry.GetNumWindows(), 3);
+}
+
+TEST(MetricsRegistry, Recording_From_Threads) {
+	MetricsRegistry registry{};
+	registry.Initialize();
+
+	Vector<std::thread> threads{};
+	for (u32 t = 0; t < 4; ++t) {
+		threads.emplace_back([&registry] {
+			MetricCounter&   counter = registry.GetCounter("Jobs");
+			MetricHistogram& histogram = registry.GetHistogram("JobNs");
+			for (u32 i = 0; i < 10'000; ++i) {
+				counter.Add();
+				histogram.Record(i);
+			}
+		});
+	}
+	for (std::thread& thread : threads) { thread.join(); }
+
+	registry.CloseWindow();
+	Vector<MetricSample> const& window = registry.GetLastWindow();
+	ASSERT_EQ(window.size(), 2);
+	EXPECT_EQ(window[0].m_Count, 40'000);
+	EXPECT_EQ(window[0].m_Max, 9'999);
+	EXPECT_EQ(window[1].m_Count, 40'000);
+}
+
+TEST(MetricsRegistry, Csv_And_Json_Dumps) {
+	{
+		MetricsRegistry registry{};
+		MetricsSettings settings{};
+		settings.m_WindowFrames = 2;
+		settings.m_pCsvFilePath = "test_metrics.csv";
+		settings.m_pJsonFilePath = "test_metrics.json";
+		registry.Initialize(settings);
+
+		registry.GetGauge("Resources.Resident").Set(12.0);
+		registry.GetHistogram("Engine.FrameNs").Record(500);
+		registry.EndFrame();
+		registry.EndFrame();
+		registry.Shutdown();
+	}
+
+	auto readFile = [](char const* pPath) {
+		std::ifstream     file{pPath};
+		std::stringstream contents;
+		contents << file.rdbuf();
+		return contents.str();
+	};
+
+	String const csv = readFile("test_metrics.csv");
+	EXPECT_EQ(csv, "window,frame,name,type,value,count,p50,p95,p99,max\n"
+	          "0,2,\"Engine.FrameNs\",histogram,500,1,500,500,500,500\n"
+	          "0,2,\"Resources.Resident\",gauge,12,0,0,0,0,0\n");
+
+	String const json = readFile("test_metrics.json");
+	EXPECT_EQ(json, "{\"window\":0,\"frame\":2,\"metrics\":{"
+	          "\"Engine.FrameNs\":{\"type\":\"histogram\",\"value\":500,\"count\":1,\"p50\":500,\"p95\":500,\"p99\":500,\"max\":500},"
+	          "\"Resources.Resident\":{\"type\":\"gauge\",\"value\":12}}}\n");
+}
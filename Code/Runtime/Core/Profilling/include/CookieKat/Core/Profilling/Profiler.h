@@ -0,0 +1,193 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Containers/String.h"
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string_view>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define CKE_PROFILER_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define CKE_PROFILER_RDTSC
+#endif
+
+namespace CKE {
+	// Static description of a profiled scope, one per CKE_PROFILE_EVENT call site.
+	// The name must outlive the profiler, string literals and typeid names do
+	struct ProfileZone
+	{
+		char const* m_pName;
+		char const* m_pFile;
+		u32         m_Line;
+	};
+
+	// Optional zone name given to CKE_PROFILE_EVENT, the function name is used when it is empty
+	struct ProfileZoneName
+	{
+		char const* m_pName = nullptr;
+
+		constexpr char const* Or(char const* pDefault) const { return m_pName != nullptr ? m_pName : pDefault; }
+	};
+
+	struct ProfilerSettings
+	{
+		// Chrome/Perfetto trace written at shutdown, none if null
+		char const* m_pTraceFilePath = nullptr;
+
+		// Prints the statistics of every zone at shutdown, with no trace this is the headless mode
+		bool m_PrintZoneStats = false;
+
+		// Events past this are dropped and counted, each event takes 24 bytes
+		u64 m_MaxEventsPerThread = 1 << 20;
+	};
+
+	// Timings of every recorded scope that shares a name
+	struct ProfileZoneStats
+	{
+		String m_Name;
+		u64    m_Count;
+		f64    m_MeanNs;
+		f64    m_P95Ns;
+		f64    m_MaxNs;
+		f64    m_TotalNs;
+	};
+
+	// Built-in CPU profiler behind the CKE_PROFILE macros.
+	// Each thread appends complete zones to its own event buffer without locking, the buffers are
+	// read when exporting a trace or computing statistics.
+	// Timestamps are TSC ticks where available, converted to time with the rate measured against the steady clock.
+	//
+	// Measured cost of a zone with the disabled ProfilerTest.DISABLED_Benchmark_ZoneOverhead (g++ -O2, x86-64
+	// Linux VM where rdtsc alone takes 20 ns): about 65 ns recording, first touch of the event memory included,
+	// and under 1 ns with the profiler stopped.
+	class Profiler
+	{
+	public:
+		// Lifetime
+		//-----------------------------------------------------------------------------
+
+		void Initialize(ProfilerSettings const& settings = {});
+
+		// Writes the trace and statistics requested in the settings and releases the event buffers.
+		// No other thread can be recording zones
+		void Shutdown();
+
+		inline bool IsRunning() const { return m_IsRunning.load(std::memory_order_relaxed); }
+
+		// Recording
+		//-----------------------------------------------------------------------------
+
+		static inline u64 GetTimeStamp();
+
+		void RecordZone(ProfileZone const* pZone, u64 startTicks, u64 endTicks);
+
+		// Ends the frame started by the previous call, frames are recorded as zones of the calling thread
+		void BeginFrame(char const* pThreadName);
+
+		// Name shown for the calling thread in the trace, the string is copied
+		void SetThreadName(char const* pName);
+
+		// Exporting
+		//-----------------------------------------------------------------------------
+
+		// Writes every recorded zone as a Chrome trace event file, loads in chrome://tracing and Perfetto
+		bool WriteChromeTrace(char const* pFilePath) const;
+
+		// Sorted by total time
+		Vector<ProfileZoneStats> GetZoneStats() const;
+		String                   FormatZoneStats() const;
+
+		u64 GetNumFrames() const { return m_NumFrames; }
+		u64 GetNumDroppedEvents() const;
+
+	private:
+		struct ProfileEvent
+		{
+			ProfileZone const* m_pZone;
+			u64                m_StartTicks;
+			u64                m_EndTicks;
+		};
+
+		// Event storage of a thread, only the owner thread appends and it publishes the events through m_NumEvents.
+		// Chunks are never moved so readers can go through the published events while the owner records
+		struct ThreadEventBuffer
+		{
+			static constexpr u64 CHUNK_SIZE = 1 << 14;
+
+			ProfileEvent** m_pChunks = nullptr;
+			u64            m_Capacity = 0;
+			u32            m_ThreadIndex = 0;
+			String         m_Name{}; // Protected by m_BuffersMutex
+
+			std::atomic<u64> m_NumEvents{0};
+			std::atomic<u64> m_NumDropped{0};
+		};
+
+		ThreadEventBuffer* GetThreadBuffer();
+		ThreadEventBuffer* RegisterThread();
+		void               AllocateChunk(ThreadEventBuffer* pBuffer, u64 chunkIndex);
+
+		// Calls function(ThreadEventBuffer const&, ProfileEvent const&) for every published event
+		template <typename Function>
+		void ForEachEvent(Function&& function) const;
+
+		f64 GetTicksPerNs() const;
+
+	private:
+		ProfilerSettings  m_Settings{};
+		std::atomic<bool> m_IsRunning{false};
+
+		// Buffers of a previous initialization are left behind by the threads
+		std::atomic<u32> m_Generation{0};
+
+		mutable std::mutex         m_BuffersMutex;
+		Vector<ThreadEventBuffer*> m_Buffers{};
+
+		u64 m_StartTicks = 0;
+		std::chrono::steady_clock::time_point m_StartTime{};
+
+		u64 m_FrameStartTicks = 0;
+		u64 m_NumFrames = 0;
+	};
+
+	extern Profiler g_Profiler;
+
+	// Records the zone from construction to destruction
+	class ProfileScope
+	{
+	public:
+		// Zones are not timed while the profiler is stopped
+		explicit ProfileScope(ProfileZone const* pZone)
+			: m_pZone{pZone}, m_StartTicks{g_Profiler.IsRunning() ? Profiler::GetTimeStamp() : 0} {}
+
+		~ProfileScope() {
+			if (m_StartTicks != 0) { g_Profiler.RecordZone(m_pZone, m_StartTicks, Profiler::GetTimeStamp()); }
+		}
+
+		ProfileScope(ProfileScope const&) = delete;
+		ProfileScope& operator=(ProfileScope const&) = delete;
+
+	private:
+		ProfileZone const* m_pZone;
+		u64                m_StartTicks;
+	};
+}
+
+//-----------------------------------------------------------------------------
+
+namespace CKE {
+	inline u64 Profiler::GetTimeStamp() {
+#ifdef CKE_PROFILER_RDTSC
+		return __rdtsc();
+#else
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+	}
+}
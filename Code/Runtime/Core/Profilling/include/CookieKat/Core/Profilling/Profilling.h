@@ -1,5 +1,9 @@
 #pragma once
 
+// The CKE_PROFILE macros record into the built-in profiler, defining CKE_PROFILER_OPTICK routes them to Optick
+
+#ifdef CKE_PROFILER_OPTICK
+
 #include <optick.h>
 
 // Use at the start of the application loop in the main thread
@@ -7,5 +11,33 @@
 
 #define CKE_PROFILE_EVENT(...) OPTICK_EVENT(__VA_ARGS__)
 #define CKE_PROFILE_THREAD(...) OPTICK_THREAD(__VA_ARGS__)
+#define CKE_PROFILE_THREAD_START(NAME) OPTICK_START_THREAD(NAME)
+#define CKE_PROFILE_THREAD_STOP() OPTICK_STOP_THREAD()
 #define CKE_PROFILE_CATEGORY(...) OPTICK_CATEGORY(__VA_ARGS__)
-#define CKE_PROFILE_TAG(...) OPTICK_TAG(__VA_ARGS__)
\ No newline at end of file
+#define CKE_PROFILE_TAG(...) OPTICK_TAG(__VA_ARGS__)
+
+#else
+
+#include "CookieKat/Core/Profilling/Profiler.h"
+
+#define CKE_PROFILE_CONCAT_IMPL(A, B) A##B
+#define CKE_PROFILE_CONCAT(A, B) CKE_PROFILE_CONCAT_IMPL(A, B)
+
+// Use at the start of the application loop in the main thread
+#define CKE_PROFILE_FRAME(X) ::CKE::g_Profiler.BeginFrame(X);
+
+// Profiles the rest of the scope, named after the function if no name is given
+#define CKE_PROFILE_EVENT(...) \
+	static ::CKE::ProfileZone const CKE_PROFILE_CONCAT(s_ProfileZone_, __LINE__){ \
+		::CKE::ProfileZoneName{__VA_ARGS__}.Or(__FUNCTION__), __FILE__, __LINE__}; \
+	::CKE::ProfileScope CKE_PROFILE_CONCAT(profileScope_, __LINE__){&CKE_PROFILE_CONCAT(s_ProfileZone_, __LINE__)};
+
+#define CKE_PROFILE_THREAD(NAME) ::CKE::g_Profiler.SetThreadName(NAME);
+#define CKE_PROFILE_THREAD_START(NAME) ::CKE::g_Profiler.SetThreadName(NAME);
+#define CKE_PROFILE_THREAD_STOP()
+
+// Categories and tags are Optick only
+#define CKE_PROFILE_CATEGORY(NAME, CATEGORY) CKE_PROFILE_EVENT(NAME)
+#define CKE_PROFILE_TAG(...)
+
+#endif
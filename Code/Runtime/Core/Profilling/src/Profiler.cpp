@@ -0,0 +1,253 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+namespace CKE {
+	Profiler g_Profiler{};
+
+	namespace {
+		constexpr ProfileZone s_FrameZone{"Frame", __FILE__, __LINE__};
+
+		// Trace files are written in pieces of about this size
+		constexpr u64 TRACE_WRITE_SIZE = 1 << 20;
+
+		void AppendJsonString(String& output, std::string_view text) {
+			output.push_back('"');
+			for (char const c : text) {
+				if (c == '"' || c == '\\') {
+					output.push_back('\\');
+					output.push_back(c);
+				}
+				else if (static_cast<u8>(c) < 0x20) { std::format_to(std::back_inserter(output), "\\u{:04x}", static_cast<u32>(c)); }
+				else { output.push_back(c); }
+			}
+			output.push_back('"');
+		}
+	}
+
+	void Profiler::Initialize(ProfilerSettings const& settings) {
+		CKE_ASSERT(!m_IsRunning.load());
+		CKE_ASSERT(settings.m_MaxEventsPerThread > 0);
+
+		m_Settings = settings;
+		m_Generation.fetch_add(1, std::memory_order_relaxed);
+		m_StartTicks = GetTimeStamp();
+		m_StartTime = std::chrono::steady_clock::now();
+		m_FrameStartTicks = 0;
+		m_NumFrames = 0;
+		m_IsRunning.store(true, std::memory_order_release);
+	}
+
+	void Profiler::Shutdown() {
+		if (!m_IsRunning.load()) { return; }
+		m_IsRunning.store(false, std::memory_order_release);
+
+		if (m_Settings.m_pTraceFilePath != nullptr) { WriteChromeTrace(m_Settings.m_pTraceFilePath); }
+		if (m_Settings.m_PrintZoneStats) {
+			String const stats = FormatZoneStats();
+			std::cout.write(stats.data(), stats.size());
+			std::cout.flush();
+		}
+
+		std::lock_guard lock{m_BuffersMutex};
+		for (ThreadEventBuffer* pBuffer : m_Buffers) {
+			for (u64 i = 0; i * ThreadEventBuffer::CHUNK_SIZE < pBuffer->m_Capacity; ++i) {
+				delete[] pBuffer->m_pChunks[i];
+			}
+			delete[] pBuffer->m_pChunks;
+			delete pBuffer;
+		}
+		m_Buffers.clear();
+	}
+
+	// Recording
+	//-----------------------------------------------------------------------------
+
+	void Profiler::RecordZone(ProfileZone const* pZone, u64 startTicks, u64 endTicks) {
+		if (!IsRunning()) { return; }
+
+		ThreadEventBuffer* pBuffer = GetThreadBuffer();
+		u64 const          index = pBuffer->m_NumEvents.load(std::memory_order_relaxed);
+		if (index >= pBuffer->m_Capacity) {
+			pBuffer->m_NumDropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		u64 const chunkIndex = index / ThreadEventBuffer::CHUNK_SIZE;
+		if (pBuffer->m_pChunks[chunkIndex] == nullptr) { AllocateChunk(pBuffer, chunkIndex); }
+		pBuffer->m_pChunks[chunkIndex][index % ThreadEventBuffer::CHUNK_SIZE] = {pZone, startTicks, endTicks};
+		pBuffer->m_NumEvents.store(index + 1, std::memory_order_release);
+	}
+
+	void Profiler::BeginFrame(char const* pThreadName) {
+		if (!IsRunning()) { return; }
+
+		u64 const now = GetTimeStamp();
+		if (m_NumFrames == 0) {
+			ThreadEventBuffer* pBuffer = GetThreadBuffer();
+			std::lock_guard    lock{m_BuffersMutex};
+			if (pBuffer->m_Name.empty()) { pBuffer->m_Name = pThreadName; }
+		}
+		else { RecordZone(&s_FrameZone, m_FrameStartTicks, now); }
+
+		m_FrameStartTicks = now;
+		++m_NumFrames;
+	}
+
+	void Profiler::SetThreadName(char const* pName) {
+		if (!IsRunning()) { return; }
+
+		ThreadEventBuffer* pBuffer = GetThreadBuffer();
+		std::lock_guard    lock{m_BuffersMutex};
+		pBuffer->m_Name = pName;
+	}
+
+	Profiler::ThreadEventBuffer* Profiler::GetThreadBuffer() {
+		thread_local ThreadEventBuffer* t_pBuffer = nullptr;
+		thread_local u32                t_Generation = 0;
+
+		u32 const generation = m_Generation.load(std::memory_order_relaxed);
+		if (t_Generation != generation) {
+			t_pBuffer = RegisterThread();
+			t_Generation = generation;
+		}
+		return t_pBuffer;
+	}
+
+	Profiler::ThreadEventBuffer* Profiler::RegisterThread() {
+		ThreadEventBuffer* pBuffer = new ThreadEventBuffer{};
+		u64 const          numChunks = (m_Settings.m_MaxEventsPerThread + ThreadEventBuffer::CHUNK_SIZE - 1) /
+				ThreadEventBuffer::CHUNK_SIZE;
+		pBuffer->m_pChunks = new ProfileEvent*[numChunks]{};
+		pBuffer->m_Capacity = m_Settings.m_MaxEventsPerThread;
+
+		std::lock_guard lock{m_BuffersMutex};
+		pBuffer->m_ThreadIndex = static_cast<u32>(m_Buffers.size());
+		m_Buffers.push_back(pBuffer);
+		return pBuffer;
+	}
+
+	void Profiler::AllocateChunk(ThreadEventBuffer* pBuffer, u64 chunkIndex) {
+		// Published to readers by the release store of the event count
+		pBuffer->m_pChunks[chunkIndex] = new ProfileEvent[ThreadEventBuffer::CHUNK_SIZE];
+	}
+
+	// Exporting
+	//-----------------------------------------------------------------------------
+
+	template <typename Function>
+	void Profiler::ForEachEvent(Function&& function) const {
+		std::lock_guard lock{m_BuffersMutex};
+		for (ThreadEventBuffer const* pBuffer : m_Buffers) {
+			u64 const numEvents = pBuffer->m_NumEvents.load(std::memory_order_acquire);
+			for (u64 i = 0; i < numEvents; ++i) {
+				function(*pBuffer, pBuffer->m_pChunks[i / ThreadEventBuffer::CHUNK_SIZE][i % ThreadEventBuffer::CHUNK_SIZE]);
+			}
+		}
+	}
+
+	f64 Profiler::GetTicksPerNs() const {
+		f64 const elapsedNs = std::chrono::duration<f64, std::nano>(std::chrono::steady_clock::now() - m_StartTime).count();
+		f64 const elapsedTicks = static_cast<f64>(GetTimeStamp() - m_StartTicks);
+		return elapsedNs > 0.0 && elapsedTicks > 0.0 ? elapsedTicks / elapsedNs : 1.0;
+	}
+
+	bool Profiler::WriteChromeTrace(char const* pFilePath) const {
+		std::ofstream file{pFilePath, std::ios::binary | std::ios::trunc};
+		if (!file.is_open()) { return false; }
+
+		f64 const usPerTick = 1.0 / (GetTicksPerNs() * 1000.0);
+		String    output = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+				"{\"ph\":\"M\",\"name\":\"process_name\",\"pid\":0,\"args\":{\"name\":\"CookieKat\"}}";
+
+		{
+			std::lock_guard lock{m_BuffersMutex};
+			for (ThreadEventBuffer const* pBuffer : m_Buffers) {
+				std::format_to(std::back_inserter(output),
+				               ",\n{{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":0,\"tid\":{},\"args\":{{\"name\":",
+				               pBuffer->m_ThreadIndex);
+				AppendJsonString(output, pBuffer->m_Name.empty()
+					                         ? std::format("Thread {}", pBuffer->m_ThreadIndex)
+					                         : pBuffer->m_Name);
+				output.append("}}");
+			}
+		}
+
+		ForEachEvent([&](ThreadEventBuffer const& buffer, ProfileEvent const& event) {
+			// Zones can start before the profiler is initialized
+			f64 const startUs = static_cast<f64>(static_cast<i64>(event.m_StartTicks - m_StartTicks)) * usPerTick;
+			f64 const durationUs = static_cast<f64>(event.m_EndTicks - event.m_StartTicks) * usPerTick;
+			output.append(",\n{\"ph\":\"X\",\"name\":");
+			AppendJsonString(output, event.m_pZone->m_pName);
+			std::format_to(std::back_inserter(output), ",\"pid\":0,\"tid\":{},\"ts\":{:.3f},\"dur\":{:.3f}}}",
+			               buffer.m_ThreadIndex, startUs, durationUs);
+
+			if (output.size() >= TRACE_WRITE_SIZE) {
+				file.write(output.data(), output.size());
+				output.clear();
+			}
+		});
+
+		output.append("\n]}\n");
+		file.write(output.data(), output.size());
+		return file.good();
+	}
+
+	Vector<ProfileZoneStats> Profiler::GetZoneStats() const {
+		Map<std::string_view, Vector<u64>> zoneDurations{};
+		ForEachEvent([&](ThreadEventBuffer const&, ProfileEvent const& event) {
+			zoneDurations[event.m_pZone->m_pName].push_back(event.m_EndTicks - event.m_StartTicks);
+		});
+
+		f64 const                nsPerTick = 1.0 / GetTicksPerNs();
+		Vector<ProfileZoneStats> zoneStats{};
+		zoneStats.reserve(zoneDurations.size());
+		for (auto& [name, durations] : zoneDurations) {
+			std::sort(durations.begin(), durations.end());
+
+			u64 totalTicks = 0;
+			for (u64 const duration : durations) { totalTicks += duration; }
+
+			u64 const        count = durations.size();
+			ProfileZoneStats stats{};
+			stats.m_Name = String{name};
+			stats.m_Count = count;
+			stats.m_TotalNs = static_cast<f64>(totalTicks) * nsPerTick;
+			stats.m_MeanNs = stats.m_TotalNs / static_cast<f64>(count);
+			stats.m_P95Ns = static_cast<f64>(durations[(count * 95 + 99) / 100 - 1]) * nsPerTick;
+			stats.m_MaxNs = static_cast<f64>(durations.back()) * nsPerTick;
+			zoneStats.push_back(std::move(stats));
+		}
+
+		std::sort(zoneStats.begin(), zoneStats.end(), [](ProfileZoneStats const& a, ProfileZoneStats const& b) {
+			return a.m_TotalNs > b.m_TotalNs;
+		});
+		return zoneStats;
+	}
+
+	String Profiler::FormatZoneStats() const {
+		String output{};
+		std::format_to(std::back_inserter(output), "Profiler zones, {} frames, {} dropped events\n",
+		               m_NumFrames, GetNumDroppedEvents());
+		std::format_to(std::back_inserter(output), "{:<48} {:>10} {:>12} {:>12} {:>12} {:>12}\n",
+		               "Zone", "Count", "Mean (us)", "p95 (us)", "Max (us)", "Total (ms)");
+		for (ProfileZoneStats const& stats : GetZoneStats()) {
+			std::format_to(std::back_inserter(output), "{:<48} {:>10} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f}\n",
+			               stats.m_Name, stats.m_Count, stats.m_MeanNs / 1000.0, stats.m_P95Ns / 1000.0,
+			               stats.m_MaxNs / 1000.0, stats.m_TotalNs / 1'000'000.0);
+		}
+		return output;
+	}
+
+	u64 Profiler::GetNumDroppedEvents() const {
+		std::lock_guard lock{m_BuffersMutex};
+		u64             numDropped = 0;
+		for (ThreadEventBuffer const* pBuffer : m_Buffers) {
+			numDropped += pBuffer->m_NumDropped.load(std::memory_order_relaxed);
+		}
+		return numDropped;
+	}
+}
@@ -0,0 +1,181 @@
+#include "CookieKat/Core/Profilling/Profilling.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+using namespace CKE;
+
+class ProfilerTest : public testing::Test
+{
+protected:
+	void SetUp() override { g_Profiler.Initialize(); }
+	void TearDown() override { g_Profiler.Shutdown(); }
+
+	static ProfileZoneStats const* FindZone(Vector<ProfileZoneStats> const& stats, std::string_view name) {
+		auto it = std::find_if(stats.begin(), stats.end(), [&](ProfileZoneStats const& zone) {
+			return zone.m_Name == name;
+		});
+		return it != stats.end() ? &*it : nullptr;
+	}
+};
+
+static void ProfiledFunction() {
+	CKE_PROFILE_EVENT();
+	CKE_PROFILE_EVENT("Inner")
+}
+
+TEST_F(ProfilerTest, ZoneStats) {
+	for (u32 i = 0; i < 100; ++i) { ProfiledFunction(); }
+
+	Vector<ProfileZoneStats> const stats = g_Profiler.GetZoneStats();
+	ProfileZoneStats const*        pFunction = FindZone(stats, "ProfiledFunction");
+	ProfileZoneStats const*        pInner = FindZone(stats, "Inner");
+	ASSERT_NE(pFunction, nullptr);
+	ASSERT_NE(pInner, nullptr);
+	EXPECT_EQ(pFunction->m_Count, 100);
+	EXPECT_EQ(pInner->m_Count, 100);
+	EXPECT_LE(pFunction->m_MeanNs, pFunction->m_MaxNs);
+	EXPECT_LE(pFunction->m_P95Ns, pFunction->m_MaxNs);
+	EXPECT_NEAR(pFunction->m_TotalNs, pFunction->m_MeanNs * 100, 1.0);
+}
+
+TEST_F(ProfilerTest, ZoneDuration) {
+	{
+		CKE_PROFILE_EVENT("Sleep");
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	}
+
+	Vector<ProfileZoneStats> const stats = g_Profiler.GetZoneStats();
+	ProfileZoneStats const*        pSleep = FindZone(stats, "Sleep");
+	ASSERT_NE(pSleep, nullptr);
+	EXPECT_GE(pSleep->m_MaxNs, 19'000'000.0);
+	EXPECT_LT(pSleep->m_MaxNs, 200'000'000.0);
+}
+
+TEST_F(ProfilerTest, Frames) {
+	for (u32 i = 0; i < 4; ++i) { CKE_PROFILE_FRAME("MainThread"); }
+
+	EXPECT_EQ(g_Profiler.GetNumFrames(), 4);
+	ProfileZoneStats const* pFrame = FindZone(g_Profiler.GetZoneStats(), "Frame");
+	ASSERT_NE(pFrame, nullptr);
+	EXPECT_EQ(pFrame->m_Count, 3);
+}
+
+TEST_F(ProfilerTest, MultipleThreads) {
+	constexpr u32 NUM_THREADS = 4;
+	constexpr u32 NUM_ZONES = 50'000;
+
+	Vector<std::thread> threads{};
+	for (u32 t = 0; t < NUM_THREADS; ++t) {
+		threads.emplace_back([] {
+			for (u32 i = 0; i < NUM_ZONES; ++i) { CKE_PROFILE_EVENT("Worker Zone"); }
+		});
+	}
+
+	// Statistics can be read while the threads record
+	u64 countWhileRecording = 0;
+	if (ProfileZoneStats const* pZone = FindZone(g_Profiler.GetZoneStats(), "Worker Zone")) {
+		countWhileRecording = pZone->m_Count;
+	}
+	for (std::thread& thread : threads) { thread.join(); }
+
+	ProfileZoneStats const* pZone = FindZone(g_Profiler.GetZoneStats(), "Worker Zone");
+	ASSERT_NE(pZone, nullptr);
+	EXPECT_EQ(pZone->m_Count, NUM_THREADS * NUM_ZONES);
+	EXPECT_LE(countWhileRecording, pZone->m_Count);
+}
+
+TEST_F(ProfilerTest, DroppedEvents) {
+	g_Profiler.Shutdown();
+	ProfilerSettings settings{};
+	settings.m_MaxEventsPerThread = 10;
+	g_Profiler.Initialize(settings);
+
+	for (u32 i = 0; i < 15; ++i) { CKE_PROFILE_EVENT("Bounded"); }
+	EXPECT_EQ(FindZone(g_Profiler.GetZoneStats(), "Bounded")->m_Count, 10);
+	EXPECT_EQ(g_Profiler.GetNumDroppedEvents(), 5);
+}
+
+TEST_F(ProfilerTest, ChromeTrace) {
+	std::thread worker{[] {
+		CKE_PROFILE_THREAD_START("Worker \"0\"");
+		CKE_PROFILE_EVENT("Worker Zone");
+	}};
+	worker.join();
+	{ CKE_PROFILE_EVENT("Main Zone"); }
+
+	ASSERT_TRUE(g_Profiler.WriteChromeTrace("test_trace.json"));
+
+	std::ifstream     file{"test_trace.json"};
+	std::stringstream fileContents;
+	fileContents << file.rdbuf();
+	String const trace = fileContents.str();
+	EXPECT_EQ(trace.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0);
+	EXPECT_NE(trace.find("\"name\":\"thread_name\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"Worker \\\"0\\\"\"}"),
+	          String::npos);
+	EXPECT_NE(trace.find("{\"ph\":\"X\",\"name\":\"Worker Zone\",\"pid\":0,\"tid\":0,\"ts\":"), String::npos);
+	EXPECT_NE(trace.find("{\"ph\":\"X\",\"name\":\"Main Zone\",\"pid\":0,\"tid\":1,\"ts\":"), String::npos);
+	EXPECT_EQ(trace.substr(trace.size() - 4), "\n]}\n");
+}
+
+TEST_F(ProfilerTest, HeadlessStatsAtShutdown) {
+	g_Profiler.Shutdown();
+	ProfilerSettings settings{};
+	settings.m_PrintZoneStats = true;
+	g_Profiler.Initialize(settings);
+
+	for (u32 i = 0; i < 3; ++i) { ProfiledFunction(); }
+
+	testing::internal::CaptureStdout();
+	g_Profiler.Shutdown();
+	String const output = testing::internal::GetCapturedStdout();
+	EXPECT_NE(output.find("Mean (us)"), String::npos);
+	EXPECT_NE(output.find("ProfiledFunction"), String::npos);
+
+	g_Profiler.Initialize();
+}
+
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, it only prints timings. Run it with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+
+// Cost of a zone on the recording thread, an empty loop is subtracted.
+// All of the runs fit in the default event buffer so no zone is dropped
+TEST_F(ProfilerTest, DISABLED_Benchmark_ZoneOverhead) {
+	constexpr u32 NUM_RUNS = 5;
+	constexpr u32 NUM_ZONES = 200'000;
+
+	auto bestNsPerIteration = [&](auto&& iteration) {
+		f64 bestNs = std::numeric_limits<f64>::max();
+		for (u32 run = 0; run < NUM_RUNS; ++run) {
+			auto const start = std::chrono::high_resolution_clock::now();
+			for (u32 i = 0; i < NUM_ZONES; ++i) { iteration(i); }
+			auto const end = std::chrono::high_resolution_clock::now();
+			bestNs = std::min(bestNs, std::chrono::duration<f64, std::nano>(end - start).count() / NUM_ZONES);
+		}
+		return bestNs;
+	};
+
+	volatile u32 sink = 0;
+	f64 const    baseNs = bestNsPerIteration([&](u32 i) { sink = i; });
+	f64 const    zoneNs = bestNsPerIteration([&](u32 i) {
+		CKE_PROFILE_EVENT("Benchmark Zone");
+		sink = i;
+	});
+
+	g_Profiler.Shutdown();
+	f64 const stoppedNs = bestNsPerIteration([&](u32 i) {
+		CKE_PROFILE_EVENT("Benchmark Zone");
+		sink = i;
+	});
+
+	std::cout << std::format("[Benchmark] Profiler zone overhead: recording {:.1f} ns, profiler stopped {:.1f} ns\n",
+	                         zoneNs - baseNs, stoppedNs - baseNs);
+}
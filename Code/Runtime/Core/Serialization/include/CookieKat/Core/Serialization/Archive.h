@@ -5,14 +5,17 @@
 
 #include "CookieKat/Core/Containers/Containers.h"
 #include "CookieKat/Core/Containers/String.h"
+#include "CookieKat/Core/Math/Math.h"
 
+#include <algorithm>
+#include <fstream>
+#include <string_view>
 #include <type_traits>
 
 //-----------------------------------------------------------------------------
 
 // Backends
 //	MPack
-//	Json
 // Tests
 // Data validation checks
 
@@ -22,6 +25,93 @@ namespace CKE {
 	template <typename Serializer>
 	concept IsSerializer = std::is_base_of_v<CKE::IWriter, Serializer> || std::is_base_of_v<CKE::IReader, Serializer>;
 
+	// Bulk Serialization
+	//-----------------------------------------------------------------------------
+
+	// Types serialized as their raw memory representation, containers of them are serialized as a single blob.
+	// Primitives, enums and math types are serialized as bytes by default, other types opt in with CKE_SERIALIZE_AS_BYTES
+	template <typename T>
+	struct SerializeAsBytes
+	{
+		static constexpr bool value = [] {
+			if constexpr (requires { T::s_SerializeAsBytes; }) { return T::s_SerializeAsBytes; }
+			else { return std::is_arithmetic_v<T> || std::is_enum_v<T>; }
+		}();
+	};
+
+	template <glm::length_t L, typename T, glm::qualifier Q>
+	struct SerializeAsBytes<glm::vec<L, T, Q>> : std::true_type {};
+
+	template <glm::length_t C, glm::length_t R, typename T, glm::qualifier Q>
+	struct SerializeAsBytes<glm::mat<C, R, T, Q>> : std::true_type {};
+
+	template <typename T, glm::qualifier Q>
+	struct SerializeAsBytes<glm::qua<T, Q>> : std::true_type {};
+
+	template <typename T>
+	concept IsBulkSerializable = SerializeAsBytes<T>::value && std::is_trivially_copyable_v<T>;
+
+	// Least amount of bytes an element takes in a binary archive, bounds the element counts read from the data
+	template <typename T>
+	constexpr u64 GetMinSerializedSize() {
+		if constexpr (IsBulkSerializable<T>) { return sizeof(T); }
+		else if constexpr (std::is_same_v<T, String>) { return sizeof(u64); }
+		else { return 1; }
+	}
+
+	// Versioned Serialization
+	//-----------------------------------------------------------------------------
+
+	// Number of members in the comma separated list of member names of a serialization macro
+	constexpr u32 CountSerializedFields(std::string_view fieldNames) {
+		u32 count = fieldNames.empty() ? 0 : 1;
+		for (char c : fieldNames) { if (c == ',') { ++count; } }
+		return count;
+	}
+
+	// Names of the members in the comma separated list of member names of a serialization macro
+	template <u32 FieldCount>
+	constexpr Array<std::string_view, FieldCount> MakeSerializedFieldNames(std::string_view fieldNames) {
+		constexpr std::string_view whitespace = " \t\n\r";
+
+		Array<std::string_view, FieldCount> names{};
+		for (u32 field = 0; field < FieldCount; ++field) {
+			u64 const        separator = fieldNames.find(',');
+			std::string_view name = fieldNames.substr(0, separator);
+			name.remove_prefix(std::min(name.find_first_not_of(whitespace), name.size()));
+			name.remove_suffix(name.size() - (name.find_last_not_of(whitespace) + 1));
+			names[field] = name;
+			fieldNames.remove_prefix(separator == std::string_view::npos ? fieldNames.size() : separator + 1);
+		}
+		return names;
+	}
+
+	// Tags of the members of a versioned type, the FNV-1a hash of each member name
+	template <usize FieldCount>
+	constexpr Array<u32, FieldCount> MakeSerializedFieldTags(Array<std::string_view, FieldCount> const& fieldNames) {
+		Array<u32, FieldCount> tags{};
+		for (u32 field = 0; field < FieldCount; ++field) {
+			u32 hash = 2166136261u;
+			for (char c : fieldNames[field]) { hash = (hash ^ static_cast<u8>(c)) * 16777619u; }
+			tags[field] = hash;
+		}
+		return tags;
+	}
+
+	// Structured Serialization
+	//-----------------------------------------------------------------------------
+
+	// Serializers of text formats that keep the structure of the data, like JSON.
+	// Types are written as objects keyed by member name and containers as arrays instead of a flat stream of values
+	template <typename Serializer>
+	concept IsStructuredSerializer = requires(Serializer serializer) { serializer.BeginObject(); };
+
+	// Key of a member in structured formats, its name without the member prefix
+	constexpr std::string_view GetSerializedFieldKey(std::string_view fieldName) {
+		if (fieldName.starts_with("m_")) { fieldName.remove_prefix(2); }
+		return fieldName;
+	}
+
 	// Base Archive Logic
 	//-----------------------------------------------------------------------------
 
@@ -61,6 +151,44 @@ namespace CKE {
 		template <typename... Values>
 		Archive& Serialize(Values&&... values);
 
+		// Serializes sizeInBytes raw bytes, the size isn't stored so the reader has to know it
+		Archive& SerializeBlob(void* pData, u64 sizeInBytes);
+
+		// Serializes the values as the members of a type, see CKE_SERIALIZE.
+		// Structured archives use the names as keys, the rest serialize the values like Serialize()
+		template <usize FieldCount, typename... Values>
+		Archive& SerializeFields(Array<std::string_view, FieldCount> const& fieldNames, Values&... values);
+
+		// Serializes the values as the tagged fields of a type with the given version, see CKE_SERIALIZE_VERSIONED.
+		// Only binary archives store the tags, structured archives are already tolerant to changes as they are keyed
+		// by name and other archives serialize the values like Serialize()
+		template <usize FieldCount, typename... Values>
+		Archive& SerializeVersioned(u32 version, Array<std::string_view, FieldCount> const& fieldNames,
+		                            Array<u32, FieldCount> const& fieldTags, Values&... values);
+
+	private:
+		// Serializes the first numElements elements of an indexable container as an array of a structured format
+		template <typename T>
+		void SerializeArray(T& container, u64 numElements);
+
+		// Location of a field of a versioned type in the data being read
+		struct StoredField
+		{
+			u32 m_Tag = 0;
+			u64 m_Offset = 0;
+			u64 m_SizeInBytes = 0;
+		};
+
+		template <typename T>
+		void WriteField(u32 fieldTag, T& value);
+
+		// Returns false if the next stored field isn't the expected one or it has a different size
+		template <typename T>
+		bool ReadFieldInOrder(u32 fieldTag, T& value);
+
+		template <typename T>
+		void ReadFieldAt(u32 fieldTag, Vector<StoredField> const& storedFields, T& value);
+
 	protected:
 		Serializer m_Serializer;
 	};
@@ -71,9 +199,44 @@ namespace CKE {
 	class BinaryOutputArchive : public Archive<BinaryWriter>
 	{
 	public:
+		// Preallocates the in memory buffer, avoids reallocations when the final size is known
+		inline void Reserve(u64 sizeInBytes) { m_Serializer.Reserve(sizeInBytes); }
+
 		void WriteToFile(char const* path);
 	};
 
+	// Output archive that writes to its destination while it's being filled, only a block is kept in memory.
+	// Meant for big resources that would otherwise be held twice, once in the resource and once in the archive.
+	class BinaryStreamOutputArchive : public Archive<BinaryWriter>
+	{
+	public:
+		static constexpr u64 DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+
+		~BinaryStreamOutputArchive();
+
+		// Returns false if the file can't be opened
+		bool Open(char const* path, u64 blockSize = DEFAULT_BLOCK_SIZE);
+
+		// Streams to an already open output, a pipe or any other std::ostream
+		void Open(std::ostream& output, u64 blockSize = DEFAULT_BLOCK_SIZE);
+
+		// Writes the remaining data and closes the file, returns false if any write failed
+		bool Close();
+
+		inline u64 GetSizeInBytes() const { return m_Serializer.GetTotalSizeInBytes(); }
+
+	private:
+		std::ofstream m_File;
+		std::ostream* m_pOutput = nullptr;
+	};
+
+	// Measures the size of the data without writing it
+	class BinarySizeArchive : public Archive<BinarySizeCounter>
+	{
+	public:
+		inline u64 GetSizeInBytes() const { return m_Serializer.GetSizeInBytes(); }
+	};
+
 	class BinaryInputArchive : public Archive<BinaryReader>
 	{
 	public:
@@ -82,6 +245,12 @@ namespace CKE {
 		void ReadFromFile(char const* path);
 		void ReadFromBlob(Blob const& blob);
 
+		// True if the data ended before everything that was requested could be read
+		inline bool HasReadPastEnd() const { return m_Serializer.HasReadPastEnd(); }
+
+		// Bytes that haven't been read yet, used to validate sizes stored in the data before allocating
+		inline u64 GetRemainingBytes() const { return m_Serializer.GetRemainingBytes(); }
+
 	private:
 		char* m_pData = nullptr;
 	};
@@ -96,9 +265,38 @@ namespace CKE {
 		requires  IsSerializer<Serializer> \
 	friend class CKE::Archive; \
 		\
+	static constexpr auto s_SerializedFieldNames = \
+		CKE::MakeSerializedFieldNames<CKE::CountSerializedFields(#__VA_ARGS__)>(#__VA_ARGS__); \
+		\
+		template <typename Serializer> \
+		requires  IsSerializer<Serializer> \
+	void Serialize(CKE::Archive<Serializer>&archive) { archive.SerializeFields(s_SerializedFieldNames, __VA_ARGS__); }
+
+	// Same as CKE_SERIALIZE but each member is stored as a tagged field along with the version of the type.
+	// Data written by other versions can still be read, unknown members are skipped and members that are
+	// missing or changed their type keep their default value. Tags are computed from the member names,
+	// renaming a member is equivalent to removing it and adding a new one.
+#define CKE_SERIALIZE_VERSIONED(Version, ...) \
+	template <typename Serializer> \
+		requires  IsSerializer<Serializer> \
+	friend class CKE::Archive; \
+		\
+	static constexpr auto s_SerializedFieldNames = \
+		CKE::MakeSerializedFieldNames<CKE::CountSerializedFields(#__VA_ARGS__)>(#__VA_ARGS__); \
+	static constexpr auto s_SerializedFieldTags = CKE::MakeSerializedFieldTags(s_SerializedFieldNames); \
+		\
 		template <typename Serializer> \
 		requires  IsSerializer<Serializer> \
-	void Serialize(CKE::Archive<Serializer>&archive) { archive.Serialize(__VA_ARGS__); }
+	void Serialize(CKE::Archive<Serializer>&archive) { \
+		archive.SerializeVersioned(Version, s_SerializedFieldNames, s_SerializedFieldTags, __VA_ARGS__); \
+	}
+
+	// Macro to serialize a trivially copyable class/struct as its raw bytes, vectors of it become a single blob.
+	// Padding is written as is and the layout must match between writer and reader, use it for POD data like vertices
+#define CKE_SERIALIZE_AS_BYTES() \
+	template <typename T> \
+	friend struct CKE::SerializeAsBytes; \
+	static constexpr bool s_SerializeAsBytes = true
 }
 
 
@@ -108,13 +306,23 @@ namespace CKE {
 namespace CKE {
 	template <typename T>
 	concept IsNotSerializablePrimitive = std::is_class_v<T> &&
-			!std::is_same_v<T, CKE::String>;
+			!std::is_same_v<std::remove_cv_t<T>, CKE::String>;
 
 	template <typename Serializer> requires IsSerializer<Serializer>
 	template <typename T>
 	Archive<Serializer>& Archive<Serializer>::operator<<(T& value) {
+		// Math types are arrays of their components (or columns) in structured formats
+		if constexpr (IsStructuredSerializer<Serializer> && IsNotSerializablePrimitive<T> &&
+		              requires { T::length(); }) {
+			SerializeArray(value, static_cast<u64>(T::length()));
+		}
+		// Trivially copyable types that opted in are copied as they are in memory
+		else if constexpr (IsNotSerializablePrimitive<T> && IsBulkSerializable<T>) {
+			if constexpr (std::is_base_of_v<IWriter, Serializer>) { m_Serializer.WriteBlob(&value, sizeof(T)); }
+			else { m_Serializer.ReadBlob(&value, sizeof(T)); }
+		}
 		// If T is not a primitive type, call the serialization function of T
-		if constexpr (IsNotSerializablePrimitive<T>) { value.Serialize(*this); }
+		else if constexpr (IsNotSerializablePrimitive<T>) { value.Serialize(*this); }
 		else if constexpr (std::is_enum_v<T>) {
 			if constexpr (std::is_base_of_v<IWriter, Serializer>) {
 				auto enumValue = static_cast<std::underlying_type_t<T>>(value);
@@ -137,6 +345,11 @@ namespace CKE {
 	template <typename Serializer> requires IsSerializer<Serializer>
 	template <typename T>
 	Archive<Serializer>& Archive<Serializer>::operator<<(Vector<T>& vector) {
+		if constexpr (IsStructuredSerializer<Serializer>) {
+			SerializeArray(vector, vector.size());
+			return *this;
+		}
+
 		u64 numElements = 0;
 
 		// Read/Write vector size
@@ -146,10 +359,16 @@ namespace CKE {
 		}
 		else {
 			m_Serializer.Read(numElements);
+			if constexpr (std::is_same_v<Serializer, BinaryReader>) {
+				if (!m_Serializer.CanReadElements(numElements, GetMinSerializedSize<T>())) {
+					vector.clear();
+					return *this;
+				}
+			}
 			vector.resize(numElements);
 		}
 
-		if constexpr (std::is_integral_v<T> || std::is_floating_point_v<T>) {
+		if constexpr (IsBulkSerializable<T>) {
 			if constexpr (std::is_base_of_v<IWriter, Serializer>) {
 				m_Serializer.WriteBlob(vector.data(), numElements * sizeof(T));
 			}
@@ -168,6 +387,11 @@ namespace CKE {
 	template <typename Serializer> requires IsSerializer<Serializer>
 	template <typename T, usize Size>
 	Archive<Serializer>& Archive<Serializer>::operator<<(Array<T, Size>& array) {
+		if constexpr (IsStructuredSerializer<Serializer>) {
+			SerializeArray(array, Size);
+			return *this;
+		}
+
 		u64 numElements = array.size(); // Cast to u64
 
 		if constexpr (std::is_base_of_v<IWriter, Serializer>) { m_Serializer.Write(numElements); }
@@ -176,8 +400,14 @@ namespace CKE {
 			if (numElements != Size) { CKE_UNREACHABLE_CODE(); } // Reading an array of different size
 		}
 
-		// Forward the rest of the elements to be written to/read from
-		for (u64 i = 0; i < Size; ++i) { *this << array[i]; }
+		if constexpr (IsBulkSerializable<T>) {
+			if constexpr (std::is_base_of_v<IWriter, Serializer>) { m_Serializer.WriteBlob(array.data(), Size * sizeof(T)); }
+			else { m_Serializer.ReadBlob(array.data(), Size * sizeof(T)); }
+		}
+		else {
+			// Forward the rest of the elements to be written to/read from
+			for (u64 i = 0; i < Size; ++i) { *this << array[i]; }
+		}
 
 		return *this;
 	}
@@ -186,7 +416,30 @@ namespace CKE {
 	template <typename K, typename V>
 	Archive<Serializer>& Archive<Serializer>::operator<<(Map<K, V>& map) {
 		u64 numElements = map.size();
-		if constexpr (std::is_base_of_v<IWriter, Serializer>) {
+
+		// Keys aren't always strings, structured formats store the map as an array of [key, value] pairs
+		if constexpr (IsStructuredSerializer<Serializer> && std::is_base_of_v<IWriter, Serializer>) {
+			m_Serializer.BeginArray();
+			for (auto const& [key, value] : map) {
+				m_Serializer.BeginArray();
+				*this << key << value;
+				m_Serializer.EndArray();
+			}
+			m_Serializer.EndArray();
+		}
+		else if constexpr (IsStructuredSerializer<Serializer>) {
+			map.clear();
+			if (!m_Serializer.BeginArray(numElements)) { return *this; }
+			map.reserve(numElements);
+
+			for (u64 i = 0; i < numElements; ++i) {
+				Pair<K, V> pair{};
+				*this << pair;
+				map.insert(std::move(pair));
+			}
+			m_Serializer.EndArray();
+		}
+		else if constexpr (std::is_base_of_v<IWriter, Serializer>) {
 			m_Serializer.Write(numElements);
 			for (auto const& [key, value] : map) {
 				*this << key << value;
@@ -194,6 +447,10 @@ namespace CKE {
 		}
 		else {
 			m_Serializer.Read(numElements);
+			if (!m_Serializer.CanReadElements(numElements, GetMinSerializedSize<K>() + GetMinSerializedSize<V>())) {
+				map.clear();
+				return *this;
+			}
 			map.reserve(numElements);
 
 			K key;
@@ -212,12 +469,33 @@ namespace CKE {
 	template <typename T>
 	Archive<Serializer>& Archive<Serializer>::operator<<(Set<T>& set) {
 		u64 numElements = set.size();
-		if constexpr (std::is_base_of_v<IWriter, Serializer>) {
+		if constexpr (IsStructuredSerializer<Serializer> && std::is_base_of_v<IWriter, Serializer>) {
+			m_Serializer.BeginArray();
+			for (auto const& value : set) { *this << value; }
+			m_Serializer.EndArray();
+		}
+		else if constexpr (IsStructuredSerializer<Serializer>) {
+			set.clear();
+			if (!m_Serializer.BeginArray(numElements)) { return *this; }
+			set.reserve(numElements);
+
+			T element;
+			for (u64 i = 0; i < numElements; ++i) {
+				*this << element;
+				set.insert(element);
+			}
+			m_Serializer.EndArray();
+		}
+		else if constexpr (std::is_base_of_v<IWriter, Serializer>) {
 			m_Serializer.Write(numElements);
 			for (auto const& value : set) { *this << value; }
 		}
 		else {
 			m_Serializer.Read(numElements);
+			if (!m_Serializer.CanReadElements(numElements, GetMinSerializedSize<T>())) {
+				set.clear();
+				return *this;
+			}
 			set.reserve(numElements);
 			T element;
 			for (u64 i = 0; i < numElements; ++i) {
@@ -232,7 +510,20 @@ namespace CKE {
 	template <typename Serializer> requires IsSerializer<Serializer>
 	template <typename T, typename K>
 	Archive<Serializer>& Archive<Serializer>::operator<<(Pair<T, K>& pair) {
-		*this << pair.first << pair.second;
+		if constexpr (IsStructuredSerializer<Serializer> && std::is_base_of_v<IWriter, Serializer>) {
+			m_Serializer.BeginArray();
+			*this << pair.first << pair.second;
+			m_Serializer.EndArray();
+		}
+		else if constexpr (IsStructuredSerializer<Serializer>) {
+			u64 numElements = 0;
+			if (!m_Serializer.BeginArray(numElements)) { return *this; }
+			if (numElements > 0) { *this << pair.first; }
+			if (numElements > 1) { *this << pair.second; }
+			for (u64 i = 2; i < numElements; ++i) { m_Serializer.SkipValue(); }
+			m_Serializer.EndArray();
+		}
+		else { *this << pair.first << pair.second; }
 		return *this;
 	}
 
@@ -242,4 +533,160 @@ namespace CKE {
 		((*this) << ... << values);
 		return *this;
 	}
+
+	template <typename Serializer> requires IsSerializer<Serializer>
+	Archive<Serializer>& Archive<Serializer>::SerializeBlob(void* pData, u64 sizeInBytes) {
+		if constexpr (std::is_base_of_v<IWriter, Serializer>) { m_Serializer.WriteBlob(pData, sizeInBytes); }
+		else { m_Serializer.ReadBlob(pData, sizeInBytes); }
+		return *this;
+	}
+
+	template <typename Serializer> requires IsSerializer<Serializer>
+	template <usize FieldCount, typename... Values>
+	Archive<Serializer>& Archive<Serializer>::SerializeFields(Array<std::string_view, FieldCount> const& fieldNames,
+	                                                          Values&... values) {
+		static_assert(FieldCount == sizeof...(Values));
+
+		if constexpr (IsStructuredSerializer<Serializer> && std::is_base_of_v<IWriter, Serializer>) {
+			m_Serializer.BeginObject();
+			u32 field = 0;
+			((m_Serializer.Key(GetSerializedFieldKey(fieldNames[field++])), *this << values), ...);
+			m_Serializer.EndObject();
+		}
+		else if constexpr (IsStructuredSerializer<Serializer>) {
+			// Members can be in any order, unknown ones are skipped and missing ones keep their value
+			if (!m_Serializer.BeginObject()) { return *this; }
+
+			std::string_view key{};
+			while (m_Serializer.NextKey(key)) {
+				u32        field = 0;
+				bool const found = ((GetSerializedFieldKey(fieldNames[field++]) == key && (*this << values, true)) || ...);
+				if (!found) { m_Serializer.SkipValue(); }
+			}
+		}
+		else { Serialize(values...); }
+
+		return *this;
+	}
+
+	template <typename Serializer> requires IsSerializer<Serializer>
+	template <usize FieldCount, typename... Values>
+	Archive<Serializer>& Archive<Serializer>::SerializeVersioned(u32 version,
+	                                                             Array<std::string_view, FieldCount> const& fieldNames,
+	                                                             Array<u32, FieldCount> const& fieldTags,
+	                                                             Values&... values) {
+		static_assert(FieldCount == sizeof...(Values));
+
+		// Format: version, field count and every field as its tag, size in bytes and data
+		if constexpr (std::is_same_v<Serializer, BinaryWriter> || std::is_same_v<Serializer, BinarySizeCounter>) {
+			u32 fieldCount = FieldCount;
+			m_Serializer.Write(version);
+			m_Serializer.Write(fieldCount);
+
+			u32 field = 0;
+			(WriteField(fieldTags[field++], values), ...);
+		}
+		else if constexpr (std::is_same_v<Serializer, BinaryReader>) {
+			u32 storedVersion = 0;
+			u32 storedFieldCount = 0;
+			m_Serializer.Read(storedVersion);
+			m_Serializer.Read(storedFieldCount);
+			u64 const fieldsOffset = m_Serializer.GetOffset();
+
+			// Fast path, written with the current layout so the fields are read in order
+			if (storedVersion == version && storedFieldCount == FieldCount) {
+				u32 field = 0;
+				if ((ReadFieldInOrder(fieldTags[field++], values) && ...)) { return *this; }
+				m_Serializer.SetOffset(fieldsOffset);
+			}
+
+			// Locate the stored fields, then read the ones that are known. Each one takes at least its tag and size.
+			if (!m_Serializer.CanReadElements(storedFieldCount, sizeof(u32) + sizeof(u64))) { return *this; }
+			Vector<StoredField> storedFields(storedFieldCount);
+			for (StoredField& storedField : storedFields) {
+				m_Serializer.Read(storedField.m_Tag);
+				m_Serializer.Read(storedField.m_SizeInBytes);
+				storedField.m_Offset = m_Serializer.GetOffset();
+				if (!m_Serializer.Skip(storedField.m_SizeInBytes)) { return *this; }
+			}
+			u64 const endOffset = m_Serializer.GetOffset();
+
+			u32 field = 0;
+			(ReadFieldAt(fieldTags[field++], storedFields, values), ...);
+			m_Serializer.SetOffset(endOffset);
+		}
+		else { SerializeFields(fieldNames, values...); }
+
+		return *this;
+	}
+
+	template <typename Serializer> requires IsSerializer<Serializer>
+	template <typename T>
+	void Archive<Serializer>::SerializeArray(T& container, u64 numElements) {
+		if constexpr (std::is_base_of_v<IWriter, Serializer>) {
+			m_Serializer.BeginArray();
+			for (u64 i = 0; i < numElements; ++i) { *this << container[i]; }
+			m_Serializer.EndArray();
+		}
+		else {
+			u64 numStoredElements = 0;
+			if (!m_Serializer.BeginArray(numStoredElements)) { return; }
+
+			// Vectors take the stored size, fixed size containers ignore the extra elements
+			if constexpr (requires { container.resize(numStoredElements); }) {
+				container.resize(numStoredElements);
+				numElements = numStoredElements;
+			}
+			for (u64 i = 0; i < numStoredElements; ++i) {
+				if (i < numElements) { *this << container[i]; }
+				else { m_Serializer.SkipValue(); }
+			}
+			m_Serializer.EndArray();
+		}
+	}
+
+	template <typename Serializer> requires IsSerializer<Serializer>
+	template <typename T>
+	void Archive<Serializer>::WriteField(u32 fieldTag, T& value) {
+		// Sizes aren't needed when measuring, counting a placeholder avoids measuring nested types again
+		u64 sizeInBytes = 0;
+		if constexpr (std::is_same_v<Serializer, BinaryWriter>) {
+			BinarySizeArchive sizeArchive{};
+			sizeArchive << value;
+			sizeInBytes = sizeArchive.GetSizeInBytes();
+		}
+
+		m_Serializer.Write(fieldTag);
+		m_Serializer.Write(sizeInBytes);
+		*this << value;
+	}
+
+	template <typename Serializer> requires IsSerializer<Serializer>
+	template <typename T>
+	bool Archive<Serializer>::ReadFieldInOrder(u32 fieldTag, T& value) {
+		u32 storedTag = 0;
+		u64 storedSize = 0;
+		m_Serializer.Read(storedTag);
+		m_Serializer.Read(storedSize);
+		if (storedTag != fieldTag) { return false; }
+
+		u64 const fieldOffset = m_Serializer.GetOffset();
+		*this << value;
+		return m_Serializer.GetOffset() == fieldOffset + storedSize;
+	}
+
+	template <typename Serializer> requires IsSerializer<Serializer>
+	template <typename T>
+	void Archive<Serializer>::ReadFieldAt(u32 fieldTag, Vector<StoredField> const& storedFields, T& value) {
+		for (StoredField const& storedField : storedFields) {
+			if (storedField.m_Tag != fieldTag) { continue; }
+
+			m_Serializer.SetOffset(storedField.m_Offset);
+			*this << value;
+
+			// The type of the field changed, what has been read is meaningless
+			if (m_Serializer.GetOffset() != storedField.m_Offset + storedField.m_SizeInBytes) { value = T{}; }
+			return;
+		}
+	}
 }
@@ -11,29 +11,48 @@
 
 namespace CKE
 {
-	class BinaryWriter : public IWriter
+	// The archives hold the writer/reader by value, being final and defining the primitive
+	// functions inline lets the compiler resolve and inline every per element call
+	class BinaryWriter final : public IWriter
 	{
 	public:
 		BinaryWriter() = default;
+		~BinaryWriter() override;
 
-		// Returns a pointer to the in memory buffer that is being written to
-		inline char const* GetData() const { return m_pData.data(); }
+		BinaryWriter(BinaryWriter const&) = delete;
+		BinaryWriter& operator=(BinaryWriter const&) = delete;
+
+		// Returns a pointer to the in memory buffer that is being written to.
+		// When streaming it only holds the data that hasn't been flushed yet.
+		inline char const* GetData() const { return m_pData; }
 		inline u64         GetSizeInBytes() const { return m_SizeInBytes; }
+		inline u64         GetCapacity() const { return m_Capacity; }
+
+		// Size of everything written so far, flushed or not
+		inline u64 GetTotalSizeInBytes() const { return m_FlushedBytes + m_SizeInBytes; }
+
+		// Grows the buffer so that at least capacity bytes can be written without reallocating
+		void Reserve(u64 capacity);
+
+		// From now on the data is written to the output in blocks of blockSize bytes
+		// instead of being kept in memory, the output must outlive the writer or the next Flush()
+		void BeginStreaming(std::ostream* pOutput, u64 blockSize);
 
-		inline Vector<char> const& GetDataVec() { return m_pData; }
+		// Writes the buffered data to the streaming output
+		void Flush();
 
-		void Write(i8 value) override;
-		void Write(i16 value) override;
-		void Write(i32 value) override;
-		void Write(i64 value) override;
+		inline void Write(i8 value) override { WritePrimitiveType(value); }
+		inline void Write(i16 value) override { WritePrimitiveType(value); }
+		inline void Write(i32 value) override { WritePrimitiveType(value); }
+		inline void Write(i64 value) override { WritePrimitiveType(value); }
 
-		void Write(u8 value) override;
-		void Write(u16 value) override;
-		void Write(u32 value) override;
-		void Write(u64 value) override;
+		inline void Write(u8 value) override { WritePrimitiveType(value); }
+		inline void Write(u16 value) override { WritePrimitiveType(value); }
+		inline void Write(u32 value) override { WritePrimitiveType(value); }
+		inline void Write(u64 value) override { WritePrimitiveType(value); }
 
-		void Write(f32 value) override;
-		void Write(f64 value) override;
+		inline void Write(f32 value) override { WritePrimitiveType(value); }
+		inline void Write(f64 value) override { WritePrimitiveType(value); }
 
 		void Write(String const& value) override;
 
@@ -43,45 +62,105 @@ namespace CKE
 		template <typename T>
 		inline void WritePrimitiveType(T& value);
 
+		// Returns where the next sizeInBytes bytes have to be written, the bytes are left uninitialized
+		inline char* Append(u64 sizeInBytes);
+
+		// Flushes the buffer when streaming or grows it geometrically otherwise
+		void MakeRoom(u64 sizeInBytes);
+
 	private:
-		Vector<char> m_pData;
-		u64          m_SizeInBytes = 0;
+		char* m_pData = nullptr;
+		u64   m_SizeInBytes = 0;
+		u64   m_Capacity = 0;
+
+		std::ostream* m_pOutput = nullptr;
+		u64           m_BlockSize = 0;
+		u64           m_FlushedBytes = 0;
 	};
 
 	//-----------------------------------------------------------------------------
 
-	class BinaryReader : public IReader
+	// Writer that only counts the bytes a BinaryWriter would write
+	class BinarySizeCounter final : public IWriter
+	{
+	public:
+		inline u64 GetSizeInBytes() const { return m_SizeInBytes; }
+
+		inline void Write(i8 value) override { m_SizeInBytes += sizeof(value); }
+		inline void Write(i16 value) override { m_SizeInBytes += sizeof(value); }
+		inline void Write(i32 value) override { m_SizeInBytes += sizeof(value); }
+		inline void Write(i64 value) override { m_SizeInBytes += sizeof(value); }
+
+		inline void Write(u8 value) override { m_SizeInBytes += sizeof(value); }
+		inline void Write(u16 value) override { m_SizeInBytes += sizeof(value); }
+		inline void Write(u32 value) override { m_SizeInBytes += sizeof(value); }
+		inline void Write(u64 value) override { m_SizeInBytes += sizeof(value); }
+
+		inline void Write(f32 value) override { m_SizeInBytes += sizeof(value); }
+		inline void Write(f64 value) override { m_SizeInBytes += sizeof(value); }
+
+		inline void Write(String const& value) override { m_SizeInBytes += sizeof(u64) + value.size() * sizeof(char); }
+
+		inline void WriteBlob(void*, u64 sizeInBytes) { m_SizeInBytes += sizeInBytes; }
+
+	private:
+		u64 m_SizeInBytes = 0;
+	};
+
+	//-----------------------------------------------------------------------------
+
+	// Reads past the end of the data (truncated or corrupted files) are not performed,
+	// the values are zeroed instead and the reader is flagged
+	class BinaryReader final : public IReader
 	{
 	public:
 		BinaryReader() = default;
 
 		void BeginReading(const char* pData, u64 sizeInBytes);
 
-		void Read(i8& value) override;
-		void Read(i16& value) override;
-		void Read(i32& value) override;
-		void Read(i64& value) override;
+		inline void Read(i8& value) override { ReadPrimitiveType(value); }
+		inline void Read(i16& value) override { ReadPrimitiveType(value); }
+		inline void Read(i32& value) override { ReadPrimitiveType(value); }
+		inline void Read(i64& value) override { ReadPrimitiveType(value); }
 
-		void Read(u8& value) override;
-		void Read(u16& value) override;
-		void Read(u32& value) override;
-		void Read(u64& value) override;
+		inline void Read(u8& value) override { ReadPrimitiveType(value); }
+		inline void Read(u16& value) override { ReadPrimitiveType(value); }
+		inline void Read(u32& value) override { ReadPrimitiveType(value); }
+		inline void Read(u64& value) override { ReadPrimitiveType(value); }
 
-		void Read(f32& value) override;
-		void Read(f64& value) override;
+		inline void Read(f32& value) override { ReadPrimitiveType(value); }
+		inline void Read(f64& value) override { ReadPrimitiveType(value); }
 
 		void Read(String& value) override;
 
 		void ReadBlob(void* pData, u64 sizeInBytes);
 
+		inline u64  GetRemainingBytes() const { return m_SizeInBytes - m_CurrByteOffset; }
+		inline bool HasReadPastEnd() const { return m_ReadPastEnd; }
+
+		// Returns false and flags the reader if the remaining data can't hold numElements of minElementSize bytes.
+		// Element counts stored in the data are checked with it before allocating for them.
+		bool CanReadElements(u64 numElements, u64 minElementSize);
+
+		// Position of the next read, used to skip and revisit data
+		inline u64 GetOffset() const { return m_CurrByteOffset; }
+		void       SetOffset(u64 byteOffset);
+
+		// Moves past sizeInBytes bytes, returns false and flags the reader if there are less left
+		bool Skip(u64 sizeInBytes);
+
 	private:
 		template <typename T>
 		inline void ReadPrimitiveType(T& value);
 
+		// Returns false and flags the reader if there are less than sizeInBytes left
+		inline bool CanRead(u64 sizeInBytes);
+
 	private:
 		const char* m_pData{nullptr};
 		u64         m_SizeInBytes{0};
 		u64         m_CurrByteOffset{0};
+		bool        m_ReadPastEnd{false};
 	};
 }
 
@@ -94,16 +173,33 @@ namespace CKE
 	template <typename T>
 	void BinaryWriter::WritePrimitiveType(T& value)
 	{
-		m_pData.resize(m_pData.size() + sizeof(T));
-		memcpy(m_pData.data() + m_SizeInBytes, &value, sizeof(T));
-		m_SizeInBytes += sizeof(T);
+		memcpy(Append(sizeof(T)), &value, sizeof(T));
+	}
+
+	char* BinaryWriter::Append(u64 sizeInBytes)
+	{
+		if (m_SizeInBytes + sizeInBytes > m_Capacity) { MakeRoom(sizeInBytes); }
+		char* pDestination = m_pData + m_SizeInBytes;
+		m_SizeInBytes += sizeInBytes;
+		return pDestination;
 	}
 
 	template <typename T>
 	void BinaryReader::ReadPrimitiveType(T& value)
 	{
 		CKE_ASSERT(m_pData != nullptr);
+		if (!CanRead(sizeof(T))) {
+			value = T{};
+			return;
+		}
 		memcpy(&value, m_pData + m_CurrByteOffset, sizeof(T));
 		m_CurrByteOffset += sizeof(T);
 	}
+
+	bool BinaryReader::CanRead(u64 sizeInBytes)
+	{
+		if (sizeInBytes <= m_SizeInBytes - m_CurrByteOffset) { return true; }
+		m_ReadPastEnd = true;
+		return false;
+	}
 }
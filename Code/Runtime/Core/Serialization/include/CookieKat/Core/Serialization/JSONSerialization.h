@@ -1,32 +1,261 @@
 #pragma once
 
 #include "IWriterReader.h"
+#include "Archive.h"
+
+#include "CookieKat/Core/Containers/Containers.h"
 
 #include <rapidjson/rapidjson.h>
-#include <rapidjson/document.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include <charconv>
+#include <cmath>
+#include <string_view>
 
 //-----------------------------------------------------------------------------
 
+// JSON backend of the archives, meant for data that has to be inspected or edited by hand.
+// Types are objects keyed by member name, containers are arrays and blobs are base64 strings.
+// Both sides work on rapidjson's SAX interface, no DOM is built when writing or reading.
+
 namespace CKE
 {
-	class JSONWriter : IWriter
+	// Writes the values as they come into a text buffer.
+	// Values written at the root level become consecutive JSON documents separated by new lines.
+	class JSONWriter final : public IWriter
 	{
 	public:
 		JSONWriter();
 
-		void Write(i8 value) override;
-		void Write(i16 value) override;
-		void Write(i32 value) override;
-		void Write(i64 value) override;
-		void Write(u8 value) override;
-		void Write(u16 value) override;
-		void Write(u32 value) override;
-		void Write(u64 value) override;
-		void Write(f32 value) override;
-		void Write(f64 value) override;
+		JSONWriter(JSONWriter const&) = delete;
+		JSONWriter& operator=(JSONWriter const&) = delete;
+
+		inline char const* GetData() const { return m_Buffer.GetString(); }
+		inline u64         GetSizeInBytes() const { return m_Buffer.GetSize(); }
+
+		inline void Write(i8 value) override {
+			BeginValue();
+			m_Writer.Int(value);
+		}
+		inline void Write(i16 value) override {
+			BeginValue();
+			m_Writer.Int(value);
+		}
+		inline void Write(i32 value) override {
+			BeginValue();
+			m_Writer.Int(value);
+		}
+		inline void Write(i64 value) override {
+			BeginValue();
+			m_Writer.Int64(value);
+		}
+
+		inline void Write(u8 value) override {
+			BeginValue();
+			m_Writer.Uint(value);
+		}
+		inline void Write(u16 value) override {
+			BeginValue();
+			m_Writer.Uint(value);
+		}
+		inline void Write(u32 value) override {
+			BeginValue();
+			m_Writer.Uint(value);
+		}
+		inline void Write(u64 value) override {
+			BeginValue();
+			m_Writer.Uint64(value);
+		}
+
+		inline void Write(f32 value) override { WriteDouble(value); }
+		inline void Write(f64 value) override { WriteDouble(value); }
+
 		void Write(String const& value) override;
 
+		// Written as a base64 string
+		void WriteBlob(void const* pData, u64 sizeInBytes);
+
+		// Structure
+		inline void BeginObject() {
+			BeginValue();
+			m_Writer.StartObject();
+		}
+		inline void EndObject() { m_Writer.EndObject(); }
+		inline void Key(std::string_view key) { m_Writer.Key(key.data(), static_cast<rapidjson::SizeType>(key.size())); }
+		inline void BeginArray() {
+			BeginValue();
+			m_Writer.StartArray();
+		}
+		inline void EndArray() { m_Writer.EndArray(); }
+
+	private:
+		// Starts a new document if the previous one is complete
+		inline void BeginValue();
+
+		inline void WriteDouble(f64 value);
+
+		// NaN and infinities aren't valid JSON, they are written with the names the reader accepts
+		void WriteNonFinite(f64 value);
+
+	private:
+		rapidjson::StringBuffer                          m_Buffer;
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> m_Writer;
+	};
+
+	//-----------------------------------------------------------------------------
+
+	// Parses the whole text in place with the SAX reader into a flat list of tokens that point into the text,
+	// values are then read from it in order. Strings aren't copied until they are read into a String.
+	// Values of an unexpected type are skipped and flag an error, the destination keeps its previous value.
+	class JSONReader final : public IReader
+	{
+	public:
+		JSONReader() = default;
+
+		JSONReader(JSONReader const&) = delete;
+		JSONReader& operator=(JSONReader const&) = delete;
+
+		// The text is modified and must be null terminated, tokens point into it so it must outlive the reader.
+		// Texts of up to 4 GB are supported. Returns false if it isn't valid JSON
+		bool BeginReading(char* pText);
+
+		// True if the text isn't valid JSON or a value didn't have the expected type
+		inline bool HasError() const { return m_HasError; }
+
+		inline void Read(i8& value) override { ReadNumber(value); }
+		inline void Read(i16& value) override { ReadNumber(value); }
+		inline void Read(i32& value) override { ReadNumber(value); }
+		inline void Read(i64& value) override { ReadNumber(value); }
+
+		inline void Read(u8& value) override { ReadNumber(value); }
+		inline void Read(u16& value) override { ReadNumber(value); }
+		inline void Read(u32& value) override { ReadNumber(value); }
+		inline void Read(u64& value) override { ReadNumber(value); }
+
+		inline void Read(f32& value) override { ReadNumber(value); }
+		inline void Read(f64& value) override { ReadNumber(value); }
+
+		void Read(String& value) override;
+
+		// Reads a base64 string of exactly sizeInBytes bytes
+		void ReadBlob(void* pData, u64 sizeInBytes);
+
+		// Structure, Begin functions return false and skip the value if it's of a different type
+
+		bool BeginObject();
+		// Returns false once the end of the object is reached, the value of the key has to be read or skipped
+		bool NextKey(std::string_view& outKey);
+		bool BeginArray(u64& outNumElements);
+		void EndArray();
+
+		// Skips the next value, including everything nested in it
+		void SkipValue();
+
+	private:
+		enum class TokenType : u8
+		{
+			Null,
+			False,
+			True,
+			Number,
+			String,
+			Key,
+			StartObject,
+			EndObject,
+			StartArray,
+			EndArray,
+		};
+
+		// Numbers and strings are the offset and length of their text, numbers are only parsed when read.
+		// The start of objects and arrays stores the index of the token after their end to skip them quickly,
+		// the end stores their number of members/elements
+		struct Token
+		{
+			u32       m_Value;
+			u32       m_Length;
+			TokenType m_Type;
+		};
+
+		class TokenHandler;
+
+		// Returns the next token if it's of the given type, otherwise skips the value and returns nullptr
+		Token const* ConsumeToken(TokenType type);
+
+		// Any number is converted to T
+		template <typename T>
+		inline void ReadNumber(T& value);
+
 	private:
-		rapidjson::Document doc;
+		char const*   m_pText = nullptr;
+		Vector<Token> m_Tokens;
+		u64           m_CurrentToken = 0;
+		bool          m_HasError = false;
+	};
+
+	// JSON InputOutput Archives
+	//-----------------------------------------------------------------------------
+
+	class JSONOutputArchive : public Archive<JSONWriter>
+	{
+	public:
+		inline std::string_view GetString() const { return {m_Serializer.GetData(), m_Serializer.GetSizeInBytes()}; }
+
+		// Returns false if the file can't be written
+		bool WriteToFile(char const* path);
 	};
+
+	class JSONInputArchive : public Archive<JSONReader>
+	{
+	public:
+		// Returns false if the file can't be opened or isn't valid JSON
+		bool ReadFromFile(char const* path);
+
+		// Parses a copy of the text, returns false if it isn't valid JSON
+		bool ReadFromString(std::string_view text);
+
+		// True if the text isn't valid JSON or a value didn't have the expected type
+		inline bool HasError() const { return m_Serializer.HasError(); }
+
+	private:
+		Vector<char> m_Text;
+	};
+}
+
+//-----------------------------------------------------------------------------
+
+namespace CKE
+{
+	inline void JSONWriter::BeginValue() {
+		if (m_Writer.IsComplete()) {
+			m_Buffer.Put('\n');
+			m_Writer.Reset(m_Buffer);
+		}
+	}
+
+	inline void JSONWriter::WriteDouble(f64 value) {
+		if (!std::isfinite(value)) {
+			WriteNonFinite(value);
+			return;
+		}
+		BeginValue();
+		m_Writer.Double(value);
+	}
+
+	template <typename T>
+	void JSONReader::ReadNumber(T& value) {
+		Token const* pToken = ConsumeToken(TokenType::Number);
+		if (pToken == nullptr) { return; }
+
+		char const* pFirst = m_pText + pToken->m_Value;
+		char const* pLast = pFirst + pToken->m_Length;
+		auto const [pEnd, error] = std::from_chars(pFirst, pLast, value);
+		if (error == std::errc{} && pEnd == pLast) { return; }
+
+		// Integers written with a fraction or an exponent
+		f64 number = 0.0;
+		auto const [pNumberEnd, numberError] = std::from_chars(pFirst, pLast, number);
+		if (numberError == std::errc{} && pNumberEnd == pLast) { value = static_cast<T>(number); }
+		else { m_HasError = true; }
+	}
 }
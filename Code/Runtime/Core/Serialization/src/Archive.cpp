@@ -9,6 +9,33 @@ namespace CKE {
 		of.write(m_Serializer.GetData(), m_Serializer.GetSizeInBytes());
 	}
 
+	BinaryStreamOutputArchive::~BinaryStreamOutputArchive() {
+		if (m_pOutput != nullptr) { Close(); }
+	}
+
+	bool BinaryStreamOutputArchive::Open(char const* path, u64 blockSize) {
+		m_File.open(path, std::ios::binary);
+		if (!m_File) { return false; }
+		Open(m_File, blockSize);
+		return true;
+	}
+
+	void BinaryStreamOutputArchive::Open(std::ostream& output, u64 blockSize) {
+		CKE_ASSERT(m_pOutput == nullptr);
+		m_pOutput = &output;
+		m_Serializer.BeginStreaming(m_pOutput, blockSize);
+	}
+
+	bool BinaryStreamOutputArchive::Close() {
+		CKE_ASSERT(m_pOutput != nullptr);
+		m_Serializer.Flush();
+		m_pOutput->flush();
+		bool const succeeded = m_pOutput->good();
+		if (m_File.is_open()) { m_File.close(); }
+		m_pOutput = nullptr;
+		return succeeded;
+	}
+
 	BinaryInputArchive::~BinaryInputArchive() {
 		if (m_pData != nullptr) {
 			Memory::DeleteArray<char>(m_pData);
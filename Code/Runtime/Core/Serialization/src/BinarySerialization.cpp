@@ -1,37 +1,80 @@
 #include "CookieKat/Core/Serialization/BinarySerialization.h"
+#include "CookieKat/Core/Memory/Memory.h"
+
+#include <algorithm>
 
 namespace CKE
 {
 	// Binary Writer
 	//-----------------------------------------------------------------------------
 
-	void BinaryWriter::Write(i8 value) { WritePrimitiveType(value); }
-	void BinaryWriter::Write(i16 value) { WritePrimitiveType(value); }
-	void BinaryWriter::Write(i32 value) { WritePrimitiveType(value); }
-	void BinaryWriter::Write(i64 value) { WritePrimitiveType(value); }
+	BinaryWriter::~BinaryWriter()
+	{
+		if (m_pData != nullptr) { Memory::Free(m_pData); }
+	}
 
-	void BinaryWriter::Write(u8 value) { WritePrimitiveType(value); }
-	void BinaryWriter::Write(u16 value) { WritePrimitiveType(value); }
-	void BinaryWriter::Write(u32 value) { WritePrimitiveType(value); }
-	void BinaryWriter::Write(u64 value) { WritePrimitiveType(value); }
+	void BinaryWriter::Reserve(u64 capacity)
+	{
+		if (capacity <= m_Capacity) { return; }
+
+		char* pNewData = static_cast<char*>(Memory::Alloc(capacity));
+		if (m_pData != nullptr) {
+			memcpy(pNewData, m_pData, m_SizeInBytes);
+			Memory::Free(m_pData);
+		}
+		m_pData = pNewData;
+		m_Capacity = capacity;
+	}
 
-	void BinaryWriter::Write(f32 value) { WritePrimitiveType(value); }
-	void BinaryWriter::Write(f64 value) { WritePrimitiveType(value); }
+	void BinaryWriter::BeginStreaming(std::ostream* pOutput, u64 blockSize)
+	{
+		CKE_ASSERT(pOutput != nullptr);
+		CKE_ASSERT(blockSize > 0);
+
+		m_pOutput = pOutput;
+		m_BlockSize = blockSize;
+		Reserve(blockSize);
+	}
+
+	void BinaryWriter::Flush()
+	{
+		if (m_pOutput == nullptr || m_SizeInBytes == 0) { return; }
+
+		m_pOutput->write(m_pData, m_SizeInBytes);
+		m_FlushedBytes += m_SizeInBytes;
+		m_SizeInBytes = 0;
+	}
+
+	void BinaryWriter::MakeRoom(u64 sizeInBytes)
+	{
+		if (m_pOutput != nullptr) {
+			Flush();
+			if (sizeInBytes <= m_Capacity) { return; }
+		}
+
+		// Doubling keeps the cost of appending constant on average
+		constexpr u64 minCapacity = 256;
+		Reserve(std::max({m_Capacity * 2, m_SizeInBytes + sizeInBytes, minCapacity}));
+	}
 
 	void BinaryWriter::Write(String const& value)
 	{
 		u64 strSize = value.size();
 		Write(strSize);
-		m_pData.resize(m_pData.size() + strSize * sizeof(char));
-		memcpy(m_pData.data() + m_SizeInBytes, value.c_str(), strSize * sizeof(char));
-		m_SizeInBytes += strSize * sizeof(char);
+		WriteBlob(const_cast<char*>(value.data()), strSize * sizeof(char));
 	}
 
 	void BinaryWriter::WriteBlob(void* pData, u64 sizeInBytes)
 	{
-		m_pData.resize(m_pData.size() + sizeInBytes);
-		memcpy(m_pData.data() + m_SizeInBytes, pData, sizeInBytes);
-		m_SizeInBytes += sizeInBytes;
+		// Blobs bigger than a block skip the buffer when streaming
+		if (m_pOutput != nullptr && sizeInBytes >= m_BlockSize) {
+			Flush();
+			m_pOutput->write(static_cast<char const*>(pData), sizeInBytes);
+			m_FlushedBytes += sizeInBytes;
+			return;
+		}
+
+		memcpy(Append(sizeInBytes), pData, sizeInBytes);
 	}
 
 	// Binary Reader
@@ -44,20 +87,39 @@ namespace CKE
 		m_pData = pData;
 		m_SizeInBytes = sizeInBytes;
 		m_CurrByteOffset = 0;
+		m_ReadPastEnd = false;
+	}
+
+	void BinaryReader::SetOffset(u64 byteOffset)
+	{
+		if (byteOffset > m_SizeInBytes) {
+			m_ReadPastEnd = true;
+			m_CurrByteOffset = m_SizeInBytes;
+			return;
+		}
+		m_CurrByteOffset = byteOffset;
 	}
 
-	void BinaryReader::Read(i8& value) { ReadPrimitiveType(value); }
-	void BinaryReader::Read(i16& value) { ReadPrimitiveType(value); }
-	void BinaryReader::Read(i32& value) { ReadPrimitiveType(value); }
-	void BinaryReader::Read(i64& value) { ReadPrimitiveType(value); }
+	bool BinaryReader::Skip(u64 sizeInBytes)
+	{
+		if (!CanRead(sizeInBytes)) {
+			m_CurrByteOffset = m_SizeInBytes;
+			return false;
+		}
+		m_CurrByteOffset += sizeInBytes;
+		return true;
+	}
 
-	void BinaryReader::Read(u8& value) { ReadPrimitiveType(value); }
-	void BinaryReader::Read(u16& value) { ReadPrimitiveType(value); }
-	void BinaryReader::Read(u32& value) { ReadPrimitiveType(value); }
-	void BinaryReader::Read(u64& value) { ReadPrimitiveType(value); }
+	bool BinaryReader::CanReadElements(u64 numElements, u64 minElementSize)
+	{
+		CKE_ASSERT(minElementSize > 0);
+		if (numElements <= GetRemainingBytes() / minElementSize) { return true; }
 
-	void BinaryReader::Read(f32& value) { ReadPrimitiveType(value); }
-	void BinaryReader::Read(f64& value) { ReadPrimitiveType(value); }
+		// The rest of the data can't be trusted either, any following read fails
+		m_ReadPastEnd = true;
+		m_CurrByteOffset = m_SizeInBytes;
+		return false;
+	}
 
 	void BinaryReader::Read(String& value)
 	{
@@ -67,20 +129,22 @@ namespace CKE
 		u64 strSize = 0;
 		Read(strSize);
 
-		// Generate temp string buffer
-		char* tempBuffer = new char[strSize + 1];
-
-		memcpy(tempBuffer, m_pData + m_CurrByteOffset, strSize * sizeof(char));
+		// Read the characters straight into the string
+		if (!CanRead(strSize * sizeof(char))) {
+			value.clear();
+			return;
+		}
+		value.assign(m_pData + m_CurrByteOffset, strSize);
 		m_CurrByteOffset += strSize * sizeof(char);
-
-		tempBuffer[strSize] = '\0';
-		value = tempBuffer;
-		delete[] tempBuffer;
 	}
 
 	void BinaryReader::ReadBlob(void* pData, u64 sizeInBytes)
 	{
 		CKE_ASSERT(m_pData != nullptr);
+		if (!CanRead(sizeInBytes)) {
+			memset(pData, 0, sizeInBytes);
+			return;
+		}
 
 		memcpy(pData, m_pData + m_CurrByteOffset, sizeInBytes);
 		m_CurrByteOffset += sizeInBytes;
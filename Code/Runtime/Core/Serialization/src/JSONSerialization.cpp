@@ -1,52 +1,279 @@
 #include "CookieKat/Core/Serialization/JSONSerialization.h"
 
+#include <rapidjson/reader.h>
+
+#include <fstream>
+
 namespace CKE
 {
-	JSONWriter::JSONWriter()
+	namespace
 	{
+		constexpr char BASE64_CHARS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+		void EncodeBase64(u8 const* pData, u64 sizeInBytes, String& outText) {
+			outText.resize((sizeInBytes + 2) / 3 * 4);
+			char* pOut = outText.data();
+			u64   i = 0;
+			for (; i + 3 <= sizeInBytes; i += 3) {
+				u32 const bits = (pData[i] << 16) | (pData[i + 1] << 8) | pData[i + 2];
+				*pOut++ = BASE64_CHARS[(bits >> 18) & 63];
+				*pOut++ = BASE64_CHARS[(bits >> 12) & 63];
+				*pOut++ = BASE64_CHARS[(bits >> 6) & 63];
+				*pOut++ = BASE64_CHARS[bits & 63];
+			}
+			if (i < sizeInBytes) {
+				bool const twoBytes = i + 1 < sizeInBytes;
+				u32 const  bits = (pData[i] << 16) | (twoBytes ? pData[i + 1] << 8 : 0);
+				*pOut++ = BASE64_CHARS[(bits >> 18) & 63];
+				*pOut++ = BASE64_CHARS[(bits >> 12) & 63];
+				*pOut++ = twoBytes ? BASE64_CHARS[(bits >> 6) & 63] : '=';
+				*pOut++ = '=';
+			}
+		}
+
+		i32 DecodeBase64Char(char c) {
+			if (c >= 'A' && c <= 'Z') { return c - 'A'; }
+			if (c >= 'a' && c <= 'z') { return c - 'a' + 26; }
+			if (c >= '0' && c <= '9') { return c - '0' + 52; }
+			if (c == '+') { return 62; }
+			if (c == '/') { return 63; }
+			return -1;
+		}
+
+		// Returns false if the text isn't base64 or doesn't decode to exactly sizeInBytes bytes
+		bool DecodeBase64(char const* pText, u64 length, u8* pOut, u64 sizeInBytes) {
+			while (length > 0 && pText[length - 1] == '=') { --length; }
+			if (length * 6 / 8 != sizeInBytes) { return false; }
+
+			u32 bits = 0;
+			u32 numBits = 0;
+			for (u64 i = 0; i < length; ++i) {
+				i32 const value = DecodeBase64Char(pText[i]);
+				if (value < 0) { return false; }
+
+				bits = (bits << 6) | static_cast<u32>(value);
+				numBits += 6;
+				if (numBits >= 8) {
+					numBits -= 8;
+					*pOut++ = static_cast<u8>(bits >> numBits);
+				}
+			}
+			return true;
+		}
 	}
 
-	void JSONWriter::Write(i8 value)
-	{
+	//-----------------------------------------------------------------------------
+
+	JSONWriter::JSONWriter() : m_Writer{m_Buffer} {
+		m_Writer.SetIndent('\t', 1);
 	}
 
-	void JSONWriter::Write(i16 value)
-	{
+	void JSONWriter::Write(String const& value) {
+		BeginValue();
+		m_Writer.String(value.data(), static_cast<rapidjson::SizeType>(value.size()));
 	}
 
-	void JSONWriter::Write(i32 value)
-	{
+	void JSONWriter::WriteNonFinite(f64 value) {
+		BeginValue();
+		std::string_view const text = std::isnan(value) ? "NaN" : value > 0.0 ? "Infinity" : "-Infinity";
+		m_Writer.RawValue(text.data(), text.size(), rapidjson::kNumberType);
 	}
 
-	void JSONWriter::Write(i64 value)
-	{
+	void JSONWriter::WriteBlob(void const* pData, u64 sizeInBytes) {
+		String text{};
+		EncodeBase64(static_cast<u8 const*>(pData), sizeInBytes, text);
+		Write(text);
 	}
 
-	void JSONWriter::Write(u8 value)
+	//-----------------------------------------------------------------------------
+
+	// Appends a token for each SAX event, the start of a container is patched with its end when it's closed
+	class JSONReader::TokenHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, TokenHandler>
 	{
+	public:
+		TokenHandler(char const* pText, Vector<Token>& tokens) : m_pText{pText}, m_Tokens{tokens} {}
+
+		bool Null() { return AddToken(TokenType::Null); }
+		bool Bool(bool value) { return AddToken(value ? TokenType::True : TokenType::False); }
+
+		bool RawNumber(char const* pString, rapidjson::SizeType length, bool) {
+			return AddToken(TokenType::Number, pString, length);
+		}
+
+		bool String(char const* pString, rapidjson::SizeType length, bool) {
+			return AddToken(TokenType::String, pString, length);
+		}
+
+		bool Key(char const* pString, rapidjson::SizeType length, bool) {
+			return AddToken(TokenType::Key, pString, length);
+		}
+
+		bool StartObject() { return BeginContainer(TokenType::StartObject); }
+		bool EndObject(rapidjson::SizeType memberCount) { return EndContainer(TokenType::EndObject, memberCount); }
+		bool StartArray() { return BeginContainer(TokenType::StartArray); }
+		bool EndArray(rapidjson::SizeType elementCount) { return EndContainer(TokenType::EndArray, elementCount); }
+
+	private:
+		bool AddToken(TokenType type, char const* pString = nullptr, u32 length = 0) {
+			u32 const offset = pString != nullptr ? static_cast<u32>(pString - m_pText) : 0;
+			m_Tokens.push_back(Token{offset, length, type});
+			return true;
+		}
+
+		bool BeginContainer(TokenType type) {
+			m_OpenContainers.push_back(m_Tokens.size());
+			return AddToken(type);
+		}
+
+		bool EndContainer(TokenType type, rapidjson::SizeType count) {
+			m_Tokens.push_back(Token{count, 0, type});
+			m_Tokens[m_OpenContainers.back()].m_Value = static_cast<u32>(m_Tokens.size());
+			m_OpenContainers.pop_back();
+			return true;
+		}
+
+	private:
+		char const*    m_pText;
+		Vector<Token>& m_Tokens;
+		Vector<u64>    m_OpenContainers;
+	};
+
+	bool JSONReader::BeginReading(char* pText) {
+		m_pText = pText;
+		m_Tokens.clear();
+		m_CurrentToken = 0;
+		m_HasError = false;
+
+		// Numbers are kept as text, parsing them is delayed until they are read
+		constexpr u32 parseFlags = rapidjson::kParseInsituFlag | rapidjson::kParseStopWhenDoneFlag |
+				rapidjson::kParseNumbersAsStringsFlag | rapidjson::kParseNanAndInfFlag;
+
+		TokenHandler                  handler{pText, m_Tokens};
+		rapidjson::Reader             reader{};
+		rapidjson::InsituStringStream stream{pText};
+
+		// The text can hold several consecutive documents, one for each value written at the root
+		while (true) {
+			rapidjson::SkipWhitespace(stream);
+			if (stream.Peek() == '\0') { break; }
+
+			if (reader.Parse<parseFlags>(stream, handler).IsError()) {
+				m_Tokens.clear();
+				m_HasError = true;
+				return false;
+			}
+		}
+		return true;
 	}
 
-	void JSONWriter::Write(u16 value)
-	{
+	void JSONReader::Read(String& value) {
+		if (Token const* pToken = ConsumeToken(TokenType::String)) {
+			value.assign(m_pText + pToken->m_Value, pToken->m_Length);
+		}
 	}
 
-	void JSONWriter::Write(u32 value)
-	{
+	void JSONReader::ReadBlob(void* pData, u64 sizeInBytes) {
+		Token const* pToken = ConsumeToken(TokenType::String);
+		if (pToken == nullptr) { return; }
+
+		if (!DecodeBase64(m_pText + pToken->m_Value, pToken->m_Length, static_cast<u8*>(pData), sizeInBytes)) {
+			m_HasError = true;
+		}
 	}
 
-	void JSONWriter::Write(u64 value)
-	{
+	bool JSONReader::BeginObject() {
+		return ConsumeToken(TokenType::StartObject) != nullptr;
 	}
 
-	void JSONWriter::Write(f32 value)
-	{
+	bool JSONReader::NextKey(std::string_view& outKey) {
+		if (m_CurrentToken >= m_Tokens.size()) {
+			m_HasError = true;
+			return false;
+		}
+
+		Token const& token = m_Tokens[m_CurrentToken++];
+		if (token.m_Type == TokenType::Key) {
+			outKey = std::string_view{m_pText + token.m_Value, token.m_Length};
+			return true;
+		}
+		CKE_ASSERT(token.m_Type == TokenType::EndObject);
+		return false;
 	}
 
-	void JSONWriter::Write(f64 value)
-	{
+	bool JSONReader::BeginArray(u64& outNumElements) {
+		Token const* pToken = ConsumeToken(TokenType::StartArray);
+		if (pToken == nullptr) { return false; }
+
+		outNumElements = m_Tokens[pToken->m_Value - 1].m_Value;
+		return true;
 	}
 
-	void JSONWriter::Write(String const& value)
-	{
+	void JSONReader::EndArray() {
+		// Elements that weren't read
+		while (m_CurrentToken < m_Tokens.size() && m_Tokens[m_CurrentToken].m_Type != TokenType::EndArray) {
+			m_HasError = true;
+			SkipValue();
+		}
+		++m_CurrentToken;
+	}
+
+	void JSONReader::SkipValue() {
+		if (m_CurrentToken >= m_Tokens.size()) { return; }
+
+		Token const& token = m_Tokens[m_CurrentToken];
+		if (token.m_Type == TokenType::StartObject || token.m_Type == TokenType::StartArray) {
+			m_CurrentToken = token.m_Value;
+		}
+		else if (token.m_Type != TokenType::EndObject && token.m_Type != TokenType::EndArray) { ++m_CurrentToken; }
+	}
+
+	JSONReader::Token const* JSONReader::ConsumeToken(TokenType type) {
+		if (m_CurrentToken >= m_Tokens.size()) {
+			m_HasError = true;
+			return nullptr;
+		}
+
+		Token const& token = m_Tokens[m_CurrentToken];
+		if (token.m_Type == type) {
+			++m_CurrentToken;
+			return &token;
+		}
+
+		// The end of a container belongs to whoever is reading it, only values are skipped
+		m_HasError = true;
+		SkipValue();
+		return nullptr;
+	}
+
+	// JSON InputOutput Archives
+	//-----------------------------------------------------------------------------
+
+	bool JSONOutputArchive::WriteToFile(char const* path) {
+		std::ofstream of(path, std::ios::binary);
+		if (!of) { return false; }
+
+		of.write(m_Serializer.GetData(), m_Serializer.GetSizeInBytes());
+		return of.good();
+	}
+
+	bool JSONInputArchive::ReadFromFile(char const* path) {
+		std::ifstream ifs(path, std::ios::binary);
+		if (!ifs) { return false; }
+
+		ifs.seekg(0, ifs.end);
+		i64 const fileSize = ifs.tellg();
+		ifs.seekg(0, ifs.beg);
+
+		// The reader works in place on a null terminated copy of the file
+		m_Text.resize(fileSize + 1);
+		ifs.read(m_Text.data(), fileSize);
+		m_Text[fileSize] = '\0';
+		return m_Serializer.BeginReading(m_Text.data());
+	}
+
+	bool JSONInputArchive::ReadFromString(std::string_view text) {
+		m_Text.assign(text.begin(), text.end());
+		m_Text.push_back('\0');
+		return m_Serializer.BeginReading(m_Text.data());
 	}
 }
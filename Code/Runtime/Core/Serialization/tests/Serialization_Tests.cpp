@@ -1,10 +1,18 @@
 #include "CookieKat/Core/Serialization/IWriterReader.h"
 #include "CookieKat/Core/Serialization/BinarySerialization.h"
 #include "CookieKat/Core/Serialization/Archive.h"
+#include "CookieKat/Core/Serialization/JSONSerialization.h"
 #include "CookieKat/Core/Containers/Containers.h"
 
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+
+#include <rapidjson/document.h>
+
 //-----------------------------------------------------------------------------
 
 using namespace CKE;
@@ -194,3 +202,740 @@ TEST(BinaryArchive, Enums) {
 	};
 	BinaryArchive_ReadWrite(enumClass, fileName);
 }
+
+// Bulk Serialization
+//-----------------------------------------------------------------------------
+
+struct BulkVertex
+{
+	CKE_SERIALIZE_AS_BYTES();
+
+	Vec3 m_Position;
+	Vec3 m_Normal;
+	Vec2 m_TexCoord;
+
+	friend bool operator==(const BulkVertex& lhs, const BulkVertex& rhs) {
+		return lhs.m_Position == rhs.m_Position
+				&& lhs.m_Normal == rhs.m_Normal
+				&& lhs.m_TexCoord == rhs.m_TexCoord;
+	}
+};
+
+// Same layout as BulkVertex serialized member by member
+struct FieldVertex
+{
+	CKE_SERIALIZE(m_Position, m_Normal, m_TexCoord);
+
+	Array<f32, 3> m_Position;
+	Array<f32, 3> m_Normal;
+	Array<f32, 2> m_TexCoord;
+};
+
+static_assert(IsBulkSerializable<BulkVertex>);
+static_assert(IsBulkSerializable<Vec3>);
+static_assert(IsBulkSerializable<Mat4>);
+static_assert(IsBulkSerializable<EnumType>);
+static_assert(!IsBulkSerializable<InnerClass>);
+static_assert(!IsBulkSerializable<FieldVertex>);
+
+TEST(BinaryArchive, BulkVector) {
+	const char*        fileName = "test_bulk_vector.hehe";
+	Vector<BulkVertex> writeVec{};
+	for (u32 i = 0; i < 100; ++i) {
+		f32 const v = static_cast<f32>(i);
+		writeVec.push_back(BulkVertex{Vec3{v, v + 1, v + 2}, Vec3{0, 1, 0}, Vec2{v * 0.5f, v * 0.25f}});
+	}
+	BinaryArchive_ReadWrite(writeVec, fileName);
+}
+
+TEST(BinaryArchive, MathTypes) {
+	const char*    fileName = "test_math.hehe";
+	Vector<Mat4>   writeMats{Mat4{1.0f}, Mat4{2.0f}};
+	Array<Vec3, 2> writeVecs{Vec3{1, 2, 3}, Vec3{4, 5, 6}};
+	Quaternion     writeQuat{0.5f, 0.5f, 0.5f, 0.5f};
+	{
+		BinaryOutputArchive writeArchive{};
+		writeArchive.Serialize(writeMats, writeVecs, writeQuat);
+		writeArchive.WriteToFile(fileName);
+	}
+
+	Vector<Mat4>   readMats{};
+	Array<Vec3, 2> readVecs{};
+	Quaternion     readQuat{};
+	{
+		BinaryInputArchive readArchive{};
+		readArchive.ReadFromFile(fileName);
+		readArchive.Serialize(readMats, readVecs, readQuat);
+		EXPECT_FALSE(readArchive.HasReadPastEnd());
+	}
+
+	EXPECT_EQ(writeMats, readMats);
+	EXPECT_EQ(writeVecs, readVecs);
+	EXPECT_EQ(writeQuat, readQuat);
+}
+
+TEST(BinaryArchive, TruncatedData) {
+	Vector<i32>         writeVec{0, 1, 2, 3, 4, 5};
+	String              writeStr = "Truncated";
+	BinaryOutputArchive writeArchive{};
+	writeArchive << writeVec << writeStr;
+	writeArchive.WriteToFile("test_truncated.hehe");
+
+	Blob data = g_FileSystem.ReadBinaryFile("test_truncated.hehe");
+	data.resize(data.size() - 4);
+
+	Vector<i32>        readVec{};
+	String             readStr{};
+	BinaryInputArchive readArchive{};
+	readArchive.ReadFromBlob(data);
+	readArchive << readVec;
+	EXPECT_FALSE(readArchive.HasReadPastEnd());
+	EXPECT_EQ(readVec, writeVec);
+
+	readArchive << readStr;
+	EXPECT_TRUE(readArchive.HasReadPastEnd());
+	EXPECT_TRUE(readStr.empty());
+}
+
+TEST(BinaryArchive, CorruptedElementCount) {
+	// Element counts far bigger than the data, reading them must not allocate for them
+	u64                 hugeCount = 1ull << 61;
+	u32                 padding = 7;
+	BinaryOutputArchive writeArchive{};
+	writeArchive << hugeCount << padding;
+	writeArchive.WriteToFile("test_corrupted_count.hehe");
+	Blob const data = g_FileSystem.ReadBinaryFile("test_corrupted_count.hehe");
+
+	{
+		Vector<u64>        readVec{1, 2, 3};
+		BinaryInputArchive readArchive{};
+		readArchive.ReadFromBlob(data);
+		readArchive << readVec;
+		EXPECT_TRUE(readArchive.HasReadPastEnd());
+		EXPECT_TRUE(readVec.empty());
+	}
+	{
+		Vector<String>     readStrings{};
+		BinaryInputArchive readArchive{};
+		readArchive.ReadFromBlob(data);
+		readArchive << readStrings;
+		EXPECT_TRUE(readArchive.HasReadPastEnd());
+		EXPECT_TRUE(readStrings.empty());
+	}
+	{
+		Map<u32, String>   readMap{{1, "One"}};
+		BinaryInputArchive readArchive{};
+		readArchive.ReadFromBlob(data);
+		readArchive << readMap;
+		EXPECT_TRUE(readArchive.HasReadPastEnd());
+		EXPECT_TRUE(readMap.empty());
+	}
+	{
+		Set<u64>           readSet{};
+		BinaryInputArchive readArchive{};
+		readArchive.ReadFromBlob(data);
+		readArchive << readSet;
+		EXPECT_TRUE(readArchive.HasReadPastEnd());
+		EXPECT_TRUE(readSet.empty());
+	}
+}
+
+// Writer Buffering
+//-----------------------------------------------------------------------------
+
+TEST(BinaryArchive, Reserve) {
+	BinaryWriter writer{};
+	writer.Reserve(1024);
+	EXPECT_GE(writer.GetCapacity(), 1024);
+
+	char const* pData = writer.GetData();
+	for (u64 i = 0; i < 1024 / sizeof(u64); ++i) { writer.Write(i); }
+	EXPECT_EQ(writer.GetData(), pData);
+	EXPECT_EQ(writer.GetSizeInBytes(), 1024);
+}
+
+TEST(BinaryArchive, Stream_SameAsInMemory) {
+	const char* memoryFileName = "test_stream_memory.hehe";
+	const char* streamFileName = "test_stream.hehe";
+
+	SerializableClass wData{};
+	wData.m_str = "Streamed";
+	wData.m_strVec = {"Firsto", "Sekondo", "Thirderino"};
+	wData.m_InnerClass.m_str = "InnerClass";
+	Vector<u8> bigBlob(10'000);
+	for (u64 i = 0; i < bigBlob.size(); ++i) { bigBlob[i] = static_cast<u8>(i); }
+
+	BinaryOutputArchive memoryArchive{};
+	memoryArchive << wData << bigBlob << wData;
+	memoryArchive.WriteToFile(memoryFileName);
+
+	// Blocks smaller than the data so both buffered and direct blob writes are flushed
+	BinaryStreamOutputArchive streamArchive{};
+	ASSERT_TRUE(streamArchive.Open(streamFileName, 64));
+	streamArchive << wData << bigBlob << wData;
+	EXPECT_TRUE(streamArchive.Close());
+
+	Blob const memoryData = g_FileSystem.ReadBinaryFile(memoryFileName);
+	Blob const streamData = g_FileSystem.ReadBinaryFile(streamFileName);
+	EXPECT_EQ(memoryData, streamData);
+
+	SerializableClass  rData{};
+	Vector<u8>         rBlob{};
+	BinaryInputArchive readArchive{};
+	readArchive.ReadFromFile(streamFileName);
+	readArchive << rData << rBlob;
+	EXPECT_EQ(rData, wData);
+	EXPECT_EQ(rBlob, bigBlob);
+}
+
+// Versioned Types
+//-----------------------------------------------------------------------------
+
+// The same type in three versions of the code, a member is added and a member is removed
+struct VersionedV1
+{
+	CKE_SERIALIZE_VERSIONED(1, m_Name, m_Count, m_Removed);
+
+	String m_Name;
+	u32    m_Count = 0;
+	f32    m_Removed = 0.0f;
+};
+
+struct VersionedV2
+{
+	CKE_SERIALIZE_VERSIONED(2, m_Name, m_Values, m_Count);
+
+	String      m_Name;
+	Vector<i32> m_Values{1, 2, 3};
+	u32         m_Count = 0;
+};
+
+// m_Count changed its type
+struct VersionedV3
+{
+	CKE_SERIALIZE_VERSIONED(3, m_Name, m_Count);
+
+	String m_Name;
+	u64    m_Count = 99;
+};
+
+struct VersionedOuter
+{
+	CKE_SERIALIZE_VERSIONED(1, m_Inner, m_Trailing);
+
+	VersionedV2 m_Inner;
+	u32         m_Trailing = 0;
+};
+
+template <typename Read, typename Write>
+Read ReadAs(Write& writeData, u32 trailingValue, u32& outTrailingValue) {
+	BinaryOutputArchive writeArchive{};
+	writeArchive << writeData << trailingValue;
+	writeArchive.WriteToFile("test_versioned.hehe");
+
+	Read               readData{};
+	BinaryInputArchive readArchive{};
+	readArchive.ReadFromFile("test_versioned.hehe");
+	readArchive << readData << outTrailingValue;
+	EXPECT_FALSE(readArchive.HasReadPastEnd());
+	return readData;
+}
+
+TEST(BinaryArchive, Versioned_SameVersion) {
+	VersionedOuter writeData{};
+	writeData.m_Inner = VersionedV2{"Same", {4, 5}, 7};
+	writeData.m_Trailing = 11;
+
+	u32                  trailing = 0;
+	VersionedOuter const readData = ReadAs<VersionedOuter>(writeData, 42, trailing);
+	EXPECT_EQ(readData.m_Inner.m_Name, "Same");
+	EXPECT_EQ(readData.m_Inner.m_Values, (Vector<i32>{4, 5}));
+	EXPECT_EQ(readData.m_Inner.m_Count, 7);
+	EXPECT_EQ(readData.m_Trailing, 11);
+	EXPECT_EQ(trailing, 42);
+}
+
+TEST(BinaryArchive, Versioned_AddedAndRemovedFields) {
+	VersionedV1 writeData{"Old", 5, 3.0f};
+
+	u32               trailing = 0;
+	VersionedV2 const readData = ReadAs<VersionedV2>(writeData, 42, trailing);
+	EXPECT_EQ(readData.m_Name, "Old");
+	EXPECT_EQ(readData.m_Count, 5);
+	EXPECT_EQ(readData.m_Values, (Vector<i32>{1, 2, 3})); // Missing, keeps its default
+	EXPECT_EQ(trailing, 42);                               // m_Removed was skipped
+}
+
+TEST(BinaryArchive, Versioned_ChangedFieldType) {
+	VersionedV2 writeData{"Changed", {}, 5};
+
+	u32               trailing = 0;
+	VersionedV3 const readData = ReadAs<VersionedV3>(writeData, 42, trailing);
+	EXPECT_EQ(readData.m_Name, "Changed");
+	EXPECT_EQ(readData.m_Count, 0); // Reset to a default constructed value
+	EXPECT_EQ(trailing, 42);
+}
+
+TEST(BinaryArchive, Versioned_CorruptedFields) {
+	auto readCorrupted = [](u32 storedFieldCount, u64 storedFieldSize) {
+		u32                 version = 5;
+		u32                 tag = 1;
+		BinaryOutputArchive writeArchive{};
+		writeArchive << version << storedFieldCount << tag << storedFieldSize;
+		writeArchive.WriteToFile("test_versioned_corrupted.hehe");
+
+		VersionedV2        readData{};
+		BinaryInputArchive readArchive{};
+		readArchive.ReadFromFile("test_versioned_corrupted.hehe");
+		readArchive << readData;
+		EXPECT_TRUE(readArchive.HasReadPastEnd());
+		EXPECT_EQ(readData.m_Values, (Vector<i32>{1, 2, 3}));
+	};
+
+	readCorrupted(0xFFFFFFFF, 0);                     // More fields than the data can hold
+	readCorrupted(1, std::numeric_limits<u64>::max()); // Field bigger than the data, its end wraps around
+}
+
+TEST(BinaryArchive, Versioned_SizeArchive) {
+	VersionedOuter data{};
+	data.m_Inner.m_Name = "Measured";
+
+	BinaryOutputArchive writeArchive{};
+	writeArchive << data;
+	writeArchive.WriteToFile("test_versioned_size.hehe");
+
+	BinarySizeArchive sizeArchive{};
+	sizeArchive << data;
+	EXPECT_EQ(sizeArchive.GetSizeInBytes(), g_FileSystem.ReadBinaryFile("test_versioned_size.hehe").size());
+}
+
+// JSON Archive
+//-----------------------------------------------------------------------------
+
+template <typename T>
+void JSONArchive_ReadWrite(T& writeData) {
+	JSONOutputArchive writeArchive{};
+	writeArchive << writeData;
+
+	T                readData{};
+	JSONInputArchive readArchive{};
+	EXPECT_TRUE(readArchive.ReadFromString(writeArchive.GetString()));
+	readArchive << readData;
+	EXPECT_FALSE(readArchive.HasError());
+	EXPECT_EQ(readData, writeData);
+}
+
+TEST(JSONArchive, ComplexClass) {
+	SerializableClass wData{};
+	wData.m_i32 = -25;
+	wData.m_u32 = 25;
+	wData.m_f32 = 3.1415f;
+	wData.m_f64 = 6.282;
+	wData.m_str = "This is \"Sirialised\"\n";
+	wData.m_i32Vec = {42, 24, 55, 69, 77};
+	wData.m_strVec = {"Firsto", "Sekondo", "Thirderino"};
+	wData.m_InnerClass.m_str = "InnerClass";
+	wData.m_InnerClass.m_u32 = 33;
+	wData.m_EnumA = EnumType::ValueC;
+	JSONArchive_ReadWrite(wData);
+}
+
+TEST(JSONArchive, Containers) {
+	Array<i32, 6> writeArray{0, 1, 2, 3, 4, 5};
+	JSONArchive_ReadWrite(writeArray);
+
+	Map<String, f64> writeMap{{"A", 2.22}, {"B", 3.33}};
+	JSONArchive_ReadWrite(writeMap);
+
+	Set<i32> writeSet{0, 1, 2, 3, 4, 5};
+	JSONArchive_ReadWrite(writeSet);
+
+	Pair<i32, String> writePair{9, "Nine"};
+	JSONArchive_ReadWrite(writePair);
+
+	Vector<BulkVertex> writeVertices{BulkVertex{Vec3{1, 2, 3}, Vec3{0, 1, 0}, Vec2{0.5f, 0.25f}}};
+	JSONArchive_ReadWrite(writeVertices);
+}
+
+TEST(JSONArchive, MathTypes) {
+	Mat4       writeMat{2.0f};
+	Vec3       writeVec{1, 2, 3};
+	Quaternion writeQuat{0.5f, 0.5f, 0.5f, 0.5f};
+	JSONArchive_ReadWrite(writeMat);
+	JSONArchive_ReadWrite(writeVec);
+	JSONArchive_ReadWrite(writeQuat);
+
+	// Components are plain arrays that can be edited by hand
+	JSONOutputArchive writeArchive{};
+	writeArchive << writeVec;
+	EXPECT_EQ(writeArchive.GetString(), "[\n\t1.0,\n\t2.0,\n\t3.0\n]");
+}
+
+TEST(JSONArchive, MultipleValues) {
+	i32    a = 2;
+	f32    b = 2.22f;
+	String c = "Four";
+
+	JSONOutputArchive writeArchive{};
+	writeArchive.Serialize(a, b, c);
+	EXPECT_TRUE(writeArchive.WriteToFile("test_multiple.json"));
+
+	i32              ar = 0;
+	f32              br = 0.0f;
+	String           cr{};
+	JSONInputArchive readArchive{};
+	EXPECT_TRUE(readArchive.ReadFromFile("test_multiple.json"));
+	readArchive.Serialize(ar, br, cr);
+	EXPECT_FALSE(readArchive.HasError());
+	EXPECT_EQ(a, ar);
+	EXPECT_EQ(b, br);
+	EXPECT_EQ(c, cr);
+	if (!KEEP_BINARY_FILES_AFTER_TESTS) { std::remove("test_multiple.json"); }
+}
+
+TEST(JSONArchive, HandEditedText) {
+	// Members out of order, an unknown member and a missing one
+	const char* text = R"({
+		"strVec": ["B", "A"],
+		"Unknown": {"Nested": [1, 2, {"Deep": null}]},
+		"i32": -7,
+		"InnerClass": {"u32": 4, "str": "Inner"},
+		"f64": 1e3
+	})";
+
+	SerializableClass readData{};
+	readData.m_u32 = 99;
+	JSONInputArchive readArchive{};
+	EXPECT_TRUE(readArchive.ReadFromString(text));
+	readArchive << readData;
+	EXPECT_FALSE(readArchive.HasError());
+	EXPECT_EQ(readData.m_i32, -7);
+	EXPECT_EQ(readData.m_u32, 99);
+	EXPECT_EQ(readData.m_f64, 1000.0);
+	EXPECT_EQ(readData.m_strVec, (Vector<String>{"B", "A"}));
+	EXPECT_EQ(readData.m_InnerClass, (InnerClass{"Inner", 4}));
+}
+
+TEST(JSONArchive, Versioned) {
+	// Keyed by name, so versioned types tolerate the same changes as in binary
+	VersionedV1 writeData{"Old", 5, 3.0f};
+	u32         trailing = 42;
+
+	JSONOutputArchive writeArchive{};
+	writeArchive << writeData << trailing;
+
+	VersionedV2      readData{};
+	u32              readTrailing = 0;
+	JSONInputArchive readArchive{};
+	EXPECT_TRUE(readArchive.ReadFromString(writeArchive.GetString()));
+	readArchive << readData << readTrailing;
+	EXPECT_FALSE(readArchive.HasError());
+	EXPECT_EQ(readData.m_Name, "Old");
+	EXPECT_EQ(readData.m_Count, 5);
+	EXPECT_EQ(readData.m_Values, (Vector<i32>{1, 2, 3}));
+	EXPECT_EQ(readTrailing, 42);
+}
+
+TEST(JSONArchive, InvalidData) {
+	JSONInputArchive invalidArchive{};
+	EXPECT_FALSE(invalidArchive.ReadFromString(R"({"i32": 1,})"));
+	EXPECT_TRUE(invalidArchive.HasError());
+
+	// A value of another type is skipped, the rest is still read
+	InnerClass       readData{"Default", 1};
+	JSONInputArchive readArchive{};
+	EXPECT_TRUE(readArchive.ReadFromString(R"({"str": [1, 2], "u32": 8})"));
+	readArchive << readData;
+	EXPECT_TRUE(readArchive.HasError());
+	EXPECT_EQ(readData, (InnerClass{"Default", 8}));
+}
+
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, they only print timings. Run them with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+
+// Prints the throughput of element wise and bulk serialization of a vertex buffer
+TEST(BinaryArchive, DISABLED_Benchmark_Throughput) {
+	constexpr u32 vertexCount = 1'000'000;
+	constexpr f64 sizeMB = vertexCount * sizeof(BulkVertex) / (1024.0 * 1024.0);
+
+	Vector<BulkVertex>  bulkVertices(vertexCount, BulkVertex{Vec3{1, 2, 3}, Vec3{0, 1, 0}, Vec2{0.5f, 0.5f}});
+	Vector<FieldVertex> fieldVertices(vertexCount, FieldVertex{{1, 2, 3}, {0, 1, 0}, {0.5f, 0.5f}});
+
+	auto benchmark = [&](const char* name, auto& writeData, const char* fileName) {
+		auto const writeStart = std::chrono::high_resolution_clock::now();
+		BinaryOutputArchive writeArchive{};
+		writeArchive << writeData;
+		auto const writeEnd = std::chrono::high_resolution_clock::now();
+		writeArchive.WriteToFile(fileName);
+
+		std::remove_reference_t<decltype(writeData)> readData{};
+		BinaryInputArchive                           readArchive{};
+		readArchive.ReadFromFile(fileName);
+		auto const readStart = std::chrono::high_resolution_clock::now();
+		readArchive << readData;
+		auto const readEnd = std::chrono::high_resolution_clock::now();
+
+		f64 const writeMs = std::chrono::duration<f64, std::milli>(writeEnd - writeStart).count();
+		f64 const readMs = std::chrono::duration<f64, std::milli>(readEnd - readStart).count();
+		std::cout << "[Benchmark] " << name << " " << vertexCount << " vertices: write " << writeMs << " ms ("
+			<< sizeMB / (writeMs / 1000.0) << " MB/s), read " << readMs << " ms ("
+			<< sizeMB / (readMs / 1000.0) << " MB/s)" << std::endl;
+		std::remove(fileName);
+	};
+
+	benchmark("Element wise", fieldVertices, "bench_fields.hehe");
+	benchmark("Bulk", bulkVertices, "bench_bulk.hehe");
+}
+
+// Prints the cost of building archives of increasing size out of 8 byte values, up to 1 GB.
+// Compares growing the buffer, preallocating it and streaming it to a file in blocks.
+TEST(BinaryArchive, DISABLED_Benchmark_WriteThroughput) {
+	for (u64 sizeInBytes : {1ull << 10, 1ull << 20, 1ull << 26, 1ull << 30}) {
+		u64 const valueCount = sizeInBytes / sizeof(u64);
+
+		auto measure = [&](auto&& setup, auto&& finish) {
+			auto const start = std::chrono::high_resolution_clock::now();
+			BinaryWriter writer{};
+			setup(writer);
+			for (u64 i = 0; i < valueCount; ++i) { writer.Write(i); }
+			finish(writer);
+			auto const end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<f64, std::milli>(end - start).count();
+		};
+
+		f64 const growMs = measure([](BinaryWriter&) {}, [](BinaryWriter&) {});
+		f64 const reservedMs = measure([&](BinaryWriter& writer) { writer.Reserve(sizeInBytes); },
+		                               [](BinaryWriter&) {});
+
+		std::ofstream file{"bench_stream.hehe", std::ios::binary};
+		f64 const     streamMs = measure(
+			[&](BinaryWriter& writer) { writer.BeginStreaming(&file, BinaryStreamOutputArchive::DEFAULT_BLOCK_SIZE); },
+			[](BinaryWriter& writer) { writer.Flush(); });
+		file.close();
+
+		f64 const sizeMB = sizeInBytes / (1024.0 * 1024.0);
+		std::cout << "[Benchmark] " << sizeInBytes << " bytes: grow " << growMs << " ms (" << sizeMB / (growMs / 1000.0)
+			<< " MB/s), reserved " << reservedMs << " ms (" << sizeMB / (reservedMs / 1000.0)
+			<< " MB/s), streamed to file " << streamMs << " ms (" << sizeMB / (streamMs / 1000.0) << " MB/s)"
+			<< std::endl;
+	}
+	std::remove("bench_stream.hehe");
+}
+
+struct RawResource
+{
+	CKE_SERIALIZE(m_Type, m_Path, m_Width, m_Height, m_Data);
+
+	u32        m_Type = 0;
+	String     m_Path;
+	u32        m_Width = 0;
+	u32        m_Height = 0;
+	Vector<u8> m_Data;
+};
+
+struct VersionedResource
+{
+	CKE_SERIALIZE_VERSIONED(1, m_Type, m_Path, m_Width, m_Height, m_Data);
+
+	u32        m_Type = 0;
+	String     m_Path;
+	u32        m_Width = 0;
+	u32        m_Height = 0;
+	Vector<u8> m_Data;
+};
+
+struct VersionedResourceV2
+{
+	CKE_SERIALIZE_VERSIONED(2, m_Type, m_Path, m_Width, m_Height, m_Data, m_Added);
+
+	u32        m_Type = 0;
+	String     m_Path;
+	u32        m_Width = 0;
+	u32        m_Height = 0;
+	Vector<u8> m_Data;
+	u32        m_Added = 0;
+};
+
+// Prints the load cost of the versioned format against the raw one.
+// Resources with a big payload and many small objects, read with the same version and with a newer version.
+TEST(BinaryArchive, DISABLED_Benchmark_Versioned) {
+	auto benchmark = [](const char* name, u32 objectCount, u64 payloadSize) {
+		auto measure = [&]<typename Write, typename Read>(Write, Read) {
+			Vector<Write> writeData(objectCount);
+			for (Write& object : writeData) {
+				object.m_Path = "Resources/Textures/Bricks.tex";
+				object.m_Data.resize(payloadSize, 7);
+			}
+			BinaryOutputArchive writeArchive{};
+			writeArchive << writeData;
+			writeArchive.WriteToFile("bench_versioned.hehe");
+
+			// Best of a few runs, the first ones are dominated by page faults
+			f64 bestMs = std::numeric_limits<f64>::max();
+			for (u32 run = 0; run < 5; ++run) {
+				Vector<Read>       readData{};
+				BinaryInputArchive readArchive{};
+				readArchive.ReadFromFile("bench_versioned.hehe");
+				auto const start = std::chrono::high_resolution_clock::now();
+				readArchive << readData;
+				auto const end = std::chrono::high_resolution_clock::now();
+				bestMs = std::min(bestMs, std::chrono::duration<f64, std::milli>(end - start).count());
+			}
+			return bestMs;
+		};
+
+		f64 const rawMs = measure(RawResource{}, RawResource{});
+		f64 const versionedMs = measure(VersionedResource{}, VersionedResource{});
+		f64 const newerMs = measure(VersionedResource{}, VersionedResourceV2{});
+		std::cout << "[Benchmark] " << name << ": raw " << rawMs << " ms, versioned " << versionedMs << " ms ("
+			<< (versionedMs / rawMs - 1.0) * 100.0 << "%), newer version " << newerMs << " ms ("
+			<< (newerMs / rawMs - 1.0) * 100.0 << "%)" << std::endl;
+	};
+
+	benchmark("16 resources of 4 MB", 16, 4 * 1024 * 1024);
+	benchmark("100000 objects of 16 bytes", 100'000, 16);
+	std::remove("bench_versioned.hehe");
+}
+
+struct SceneEntity
+{
+	CKE_SERIALIZE(m_Name, m_Position, m_Rotation, m_Scale, m_Parent, m_Components);
+
+	String         m_Name;
+	Vec3           m_Position{};
+	Quaternion     m_Rotation{};
+	Vec3           m_Scale{1.0f};
+	u64            m_Parent = 0;
+	Vector<String> m_Components;
+};
+
+struct Scene
+{
+	CKE_SERIALIZE(m_Name, m_Entities);
+
+	String              m_Name;
+	Vector<SceneEntity> m_Entities;
+};
+
+rapidjson::Value ToDOM(Vec3 const& vec, rapidjson::Document::AllocatorType& allocator) {
+	rapidjson::Value value{rapidjson::kArrayType};
+	for (i32 i = 0; i < 3; ++i) { value.PushBack(vec[i], allocator); }
+	return value;
+}
+
+Vec3 FromDOM(rapidjson::Value const& value) {
+	return Vec3{value[0].GetFloat(), value[1].GetFloat(), value[2].GetFloat()};
+}
+
+// Prints the cost of writing and reading a generated scene with the SAX based archives against building
+// and walking a rapidjson DOM. The DOM is parsed from a copy of the file like the ResourceCompiler does
+TEST(JSONArchive, DISABLED_Benchmark_Scene) {
+	// Best of a few runs, the first ones are dominated by page faults
+	auto bestOf = [](auto&& function) {
+		f64 bestMs = std::numeric_limits<f64>::max();
+		for (u32 run = 0; run < 5; ++run) {
+			auto const start = std::chrono::high_resolution_clock::now();
+			function();
+			auto const end = std::chrono::high_resolution_clock::now();
+			bestMs = std::min(bestMs, std::chrono::duration<f64, std::milli>(end - start).count());
+		}
+		return bestMs;
+	};
+
+	Scene scene{};
+	scene.m_Name = "Generated";
+	scene.m_Entities.resize(100'000);
+	for (u64 i = 0; i < scene.m_Entities.size(); ++i) {
+		SceneEntity& entity = scene.m_Entities[i];
+		f32 const    v = static_cast<f32>(i);
+		entity.m_Name = "Entity_" + std::to_string(i);
+		entity.m_Position = Vec3{v, v * 0.5f, -v};
+		entity.m_Rotation = Quaternion{1.0f, 0.0f, v * 0.001f, 0.0f};
+		entity.m_Parent = i / 8;
+		entity.m_Components = {"Transform", "MeshRenderer", i % 3 == 0 ? "Light" : "Collider"};
+	}
+
+	// SAX archives
+	String    text{};
+	f64 const archiveWriteMs = bestOf([&] {
+		JSONOutputArchive writeArchive{};
+		writeArchive << scene;
+		text = writeArchive.GetString();
+	});
+
+	{
+		std::ofstream file{"bench_scene.json", std::ios::binary};
+		file.write(text.data(), text.size());
+	}
+
+	Scene     archiveScene{};
+	f64 const archiveReadMs = bestOf([&] {
+		archiveScene = Scene{};
+		JSONInputArchive readArchive{};
+		readArchive.ReadFromFile("bench_scene.json");
+		readArchive << archiveScene;
+		EXPECT_FALSE(readArchive.HasError());
+	});
+	EXPECT_EQ(archiveScene.m_Entities.size(), scene.m_Entities.size());
+	EXPECT_EQ(archiveScene.m_Entities.back().m_Name, scene.m_Entities.back().m_Name);
+
+	// DOM built and walked by hand
+	f64 const domWriteMs = bestOf([&] {
+		rapidjson::Document doc{};
+		auto&               allocator = doc.GetAllocator();
+		doc.SetObject();
+		doc.AddMember("Name", rapidjson::Value{scene.m_Name.c_str(), allocator}, allocator);
+		rapidjson::Value entities{rapidjson::kArrayType};
+		for (SceneEntity const& entity : scene.m_Entities) {
+			rapidjson::Value value{rapidjson::kObjectType};
+			value.AddMember("Name", rapidjson::Value{entity.m_Name.c_str(), allocator}, allocator);
+			value.AddMember("Position", ToDOM(entity.m_Position, allocator), allocator);
+			rapidjson::Value rotation{rapidjson::kArrayType};
+			for (i32 i = 0; i < 4; ++i) { rotation.PushBack(entity.m_Rotation[i], allocator); }
+			value.AddMember("Rotation", rotation, allocator);
+			value.AddMember("Scale", ToDOM(entity.m_Scale, allocator), allocator);
+			value.AddMember("Parent", entity.m_Parent, allocator);
+			rapidjson::Value components{rapidjson::kArrayType};
+			for (String const& component : entity.m_Components) {
+				components.PushBack(rapidjson::Value{component.c_str(), allocator}, allocator);
+			}
+			value.AddMember("Components", components, allocator);
+			entities.PushBack(value, allocator);
+		}
+		doc.AddMember("Entities", entities, allocator);
+
+		rapidjson::StringBuffer                          buffer{};
+		rapidjson::PrettyWriter<rapidjson::StringBuffer> writer{buffer};
+		writer.SetIndent('\t', 1);
+		doc.Accept(writer);
+	});
+
+	Scene     domScene{};
+	f64 const domReadMs = bestOf([&] {
+		domScene = Scene{};
+		Blob const          blob = g_FileSystem.ReadBinaryFile("bench_scene.json");
+		String const        json{blob.begin(), blob.end()};
+		rapidjson::Document doc{};
+		doc.Parse<rapidjson::kParseFullPrecisionFlag>(json.c_str());
+		domScene.m_Name = doc["Name"].GetString();
+		for (rapidjson::Value const& value : doc["Entities"].GetArray()) {
+			SceneEntity& entity = domScene.m_Entities.emplace_back();
+			entity.m_Name = value["Name"].GetString();
+			entity.m_Position = FromDOM(value["Position"]);
+			for (i32 i = 0; i < 4; ++i) { entity.m_Rotation[i] = value["Rotation"][i].GetFloat(); }
+			entity.m_Scale = FromDOM(value["Scale"]);
+			entity.m_Parent = value["Parent"].GetUint64();
+			for (rapidjson::Value const& component : value["Components"].GetArray()) {
+				entity.m_Components.emplace_back(component.GetString());
+			}
+		}
+	});
+	EXPECT_EQ(domScene.m_Entities.size(), scene.m_Entities.size());
+
+	std::cout << "[Benchmark] Scene of " << scene.m_Entities.size() << " entities, " << text.size() / (1024 * 1024)
+		<< " MB: write archive " << archiveWriteMs << " ms, DOM " << domWriteMs << " ms, read archive "
+		<< archiveReadMs << " ms, DOM " << domReadMs << " ms" << std::endl;
+	std::remove("bench_scene.json");
+}
@@ -3,10 +3,23 @@
 #include "CookieKat/Systems/EngineSystem/EngineSystemUpdateContext.h"
 
 #include "CookieKat/Core/Profilling/Profilling.h"
+#include "CookieKat/Core/Logging/LoggingSystem.h"
+#include "CookieKat/Core/Memory/Memory.h"
 
 namespace CKE {
 	void Engine::InitializeCore() {
 		Threading::InitializeMainThread();
+		g_LoggingSystem.Initialize("CookieKat.log");
+		g_Profiler.Initialize(m_ProfilerSettings);
+
+		m_MetricsRegistry.Initialize(m_MetricsSettings);
+		m_pFrameTimeMetric = &m_MetricsRegistry.GetHistogram("Engine.FrameNs");
+		m_pStreamingTimeMetric = &m_MetricsRegistry.GetHistogram("Engine.UpdateStreamingNs");
+		m_pEntitiesTimeMetric = &m_MetricsRegistry.GetHistogram("Engine.EntitiesUpdateNs");
+		m_pRenderingTimeMetric = &m_MetricsRegistry.GetHistogram("Engine.RenderFrameCpuNs");
+		m_pAllocationsMetric = &m_MetricsRegistry.GetHistogram("Memory.AllocationsPerFrame");
+		m_LastNumAllocations = Memory::g_MemoryTracking.GetNumAllocations();
+
 		m_EngineTime.Initialize();
 
 		m_TaskSystem.Initialize();
@@ -22,14 +35,16 @@ namespace CKE {
 
 		// We need the device to create staging buffers in loaders
 		m_RenderingSystem.InitializeDevice();
-		m_TextureLoader.Initialize(&m_RenderingSystem.GetRenderDevice());
+		m_TextureLoader.Initialize(&m_RenderingSystem.GetRenderDevice(), m_RenderingSystem.GetTextureUploadQueue());
 		m_PipelineLoader.Initialize(&m_RenderingSystem.GetRenderDevice());
 		m_MeshLoader.Initialize(&m_RenderingSystem.GetRenderDevice());
-		m_CubeMapLoader.Initialize(&m_RenderingSystem.GetRenderDevice());
+		m_CompiledMeshLoader.Initialize(&m_RenderingSystem.GetRenderDevice());
+		m_CubeMapLoader.Initialize(&m_RenderingSystem.GetRenderDevice(), m_RenderingSystem.GetTextureUploadQueue());
 
 		m_ResourceSystem.RegisterLoader(&m_TextureLoader);
 		m_ResourceSystem.RegisterLoader(&m_PipelineLoader);
 		m_ResourceSystem.RegisterLoader(&m_MeshLoader);
+		m_ResourceSystem.RegisterLoader(&m_CompiledMeshLoader);
 		m_ResourceSystem.RegisterLoader(&m_MaterialLoader);
 		m_ResourceSystem.RegisterLoader(&m_CubeMapLoader);
 
@@ -56,6 +71,7 @@ namespace CKE {
 
 	void Engine::Update() {
 		CKE_PROFILE_FRAME("MainThread");
+		auto const frameStart = std::chrono::steady_clock::now();
 
 		EngineSystemUpdateContext updateCtx;
 		updateCtx.m_pSystemsRegistry = &m_SystemsRegistry;
@@ -64,16 +80,41 @@ namespace CKE {
 		// Tick Time
 		m_EngineTime.Update();
 
-		m_ResourceSystem.UpdateStreaming();
+		{
+			ScopedMetricTimer timer{*m_pStreamingTimeMetric};
+			m_ResourceSystem.UpdateStreaming();
+		}
 
 		// Update Entity World
-		m_EntitySystem.Update(updateCtx);
+		{
+			ScopedMetricTimer timer{*m_pEntitiesTimeMetric};
+			m_EntitySystem.Update(updateCtx);
+		}
 
 		// Render Everything
-		m_RenderingSystem.RenderFrame();
+		{
+			ScopedMetricTimer timer{*m_pRenderingTimeMetric};
+			m_RenderingSystem.RenderFrame();
+		}
 
 		// Cleanup necessary input state
 		m_InputSystem.EndOfFrameUpdate();
+
+		RecordFrameMetrics(frameStart);
+	}
+
+	void Engine::RecordFrameMetrics(std::chrono::steady_clock::time_point frameStart) {
+		auto const frameEnd = std::chrono::steady_clock::now();
+		m_pFrameTimeMetric->Record(std::chrono::duration_cast<std::chrono::nanoseconds>(frameEnd - frameStart).count());
+
+		u64 const numAllocations = Memory::g_MemoryTracking.GetNumAllocations();
+		m_pAllocationsMetric->Record(numAllocations - m_LastNumAllocations);
+		m_LastNumAllocations = numAllocations;
+
+		for (auto& [id, pSystem] : m_SystemsRegistry.m_EngineSystems) {
+			pSystem->RecordMetrics(m_MetricsRegistry);
+		}
+		m_MetricsRegistry.EndFrame();
 	}
 
 	void Engine::Shutdown() {
@@ -81,6 +122,9 @@ namespace CKE {
 		m_RenderingSystem.Shutdown();
 
 		m_TaskSystem.Shutdown();
+		m_MetricsRegistry.Shutdown();
+		g_Profiler.Shutdown();
+		g_LoggingSystem.Shutdown();
 		Threading::Shutdown();
 	}
 } // namespace CKE
@@ -3,6 +3,8 @@
 #include "CookieKat/Systems/EngineSystem/SystemsRegistry.h"
 
 #include "CookieKat/Core/Time/EngineTime.h"
+#include "CookieKat/Core/Profilling/Profiler.h"
+#include "CookieKat/Core/Metrics/MetricsRegistry.h"
 #include "CookieKat/Systems/Input/InputSystem.h"
 #include "CookieKat/Systems/TaskSystem/TaskSystem.h"
 
@@ -55,7 +57,29 @@ namespace CKE {
 		ResourceSystem*  GetResourceSystem() { return &m_ResourceSystem; }
 		InputSystem*     GetInputSystem() { return &m_InputSystem; }
 
+		MetricsRegistry* GetMetricsRegistry() { return &m_MetricsRegistry; }
+
+		// Must be configured before InitializeCore, clearing the trace path and printing the stats runs headless
+		ProfilerSettings& GetProfilerSettings() { return m_ProfilerSettings; }
+		MetricsSettings&  GetMetricsSettings() { return m_MetricsSettings; }
+
 	private:
+		// Times the engine frame and its parts, then lets every system record its metrics
+		void RecordFrameMetrics(std::chrono::steady_clock::time_point frameStart);
+
+	private:
+		ProfilerSettings m_ProfilerSettings{"CookieKat.trace.json"};
+		MetricsSettings  m_MetricsSettings{300, "CookieKat.metrics.csv"};
+
+		// Metrics
+		MetricsRegistry  m_MetricsRegistry{};
+		MetricHistogram* m_pFrameTimeMetric = nullptr;
+		MetricHistogram* m_pStreamingTimeMetric = nullptr;
+		MetricHistogram* m_pEntitiesTimeMetric = nullptr;
+		MetricHistogram* m_pRenderingTimeMetric = nullptr;
+		MetricHistogram* m_pAllocationsMetric = nullptr;
+		u64              m_LastNumAllocations = 0;
+
 		SystemsRegistry m_SystemsRegistry{};
 		TaskSystem      m_TaskSystem{};
 		EngineTime      m_EngineTime{};
@@ -67,10 +91,11 @@ namespace CKE {
 		EntitySystem    m_EntitySystem{};
 
 		// Resource Loaders
-		TextureLoader  m_TextureLoader{};
-		PipelineLoader m_PipelineLoader{};
-		MeshLoader     m_MeshLoader{};
-		MaterialLoader m_MaterialLoader{};
-		CubeMapLoader  m_CubeMapLoader{};
+		TextureLoader      m_TextureLoader{};
+		PipelineLoader     m_PipelineLoader{};
+		MeshLoader         m_MeshLoader{};
+		CompiledMeshLoader m_CompiledMeshLoader{};
+		MaterialLoader     m_MaterialLoader{};
+		CubeMapLoader      m_CubeMapLoader{};
 	};
 } // namespace CKE
@@ -13,6 +13,7 @@ namespace CKE
 	struct CKE_API LocalToWorldComponent
 	{
 		Mat4 m_LocalToWorld;
+		bool m_Changed = true; // Set by the systems that write the transform, cleared once the renderer copies it
 	};
 
 	inline Mat4 GetTransformL2W(Vec3 pos, Vec3 eulerRot, Vec3 scale) {
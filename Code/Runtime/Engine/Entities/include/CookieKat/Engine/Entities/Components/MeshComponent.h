@@ -24,6 +24,8 @@ namespace CKE {
 		TResourceID<RenderMaterialResource> m_MaterialID;
 		PBRTextureModifiers                 m_MaterialModifiers;
 		u64                                 m_ObjectIdx = 0;
+		u32                                 m_LODIndex = 0; // Selected each frame by the RenderSceneManager
+		bool                                m_Changed = true; // Set when the material modifiers are written, cleared once the renderer copies them
 
 		MeshComponent() = default;
 
@@ -27,6 +27,8 @@ namespace CKE
 		void Update(EngineSystemUpdateContext& context);
 		void Shutdown();
 
+		void RecordMetrics(MetricsRegistry& metrics) override;
+
 		//-----------------------------------------------------------------------------
 
 		inline EntityDatabase* GetEntityDatabase() { return &m_EntityDatabase; }
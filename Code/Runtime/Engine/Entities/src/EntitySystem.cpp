@@ -2,6 +2,7 @@
 
 #include "CookieKat/Core/Profilling/Profilling.h"
 #include "CookieKat/Core/Time/EngineTime.h"
+#include "CookieKat/Core/Metrics/MetricsRegistry.h"
 
 #include "CookieKat/Systems/Resources/ResourceSystem.h"
 #include "CookieKat/Systems/ECS/Systems/ECSBaseSystem.h"
@@ -49,6 +50,12 @@ namespace CKE {
 		m_Systems.clear();
 	}
 
+	void EntitySystem::RecordMetrics(MetricsRegistry& metrics) {
+		EntityDatabaseStateSnapshot const state = m_EntityDatabase.GetDebugger().GetStateSnapshot();
+		metrics.GetGauge("Entities.Count").Set(static_cast<f64>(state.m_NumEntities));
+		metrics.GetGauge("Entities.Archetypes").Set(static_cast<f64>(state.m_NumArchetypes));
+	}
+
 	void EntitySystem::SetWorldDefinition(IWorldDefinition* definition) {
 		m_pWorldDefinition = definition;
 	}
@@ -10,20 +10,23 @@ namespace CKE {
 }
 
 namespace CKE {
-	class DepthPrePass : public FGGraphicsRenderPass
+	class DepthPrePass : public FGParallelGraphicsRenderPass
 	{
 	public:
-		DepthPrePass() : FGGraphicsRenderPass{FGRenderPassID{"DepthPrePass"}} {}
+		DepthPrePass() : FGParallelGraphicsRenderPass{FGRenderPassID{"DepthPrePass"}} {}
 
 		void Initialize(RenderPassInitCtx* pInitCtx);
 		void Setup(FrameGraphSetupContext& setup) override;
-		void Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) override;
+		u32  BeginParallelExecute(ExecuteResourcesCtx& ctx, RenderDevice& rd, RenderingInfo& renderingInfo) override;
+		void ExecuteRange(CommandList& cmdList, RenderDevice& rd, FGRecordRange const& range) override;
 
 	private:
-		EntityDatabase*          m_pEntityDb = nullptr;
-		ResourceSystem*          m_pResources = nullptr;
-		RenderingSettings const* m_pRenderingSettings = nullptr;
+		EntityDatabase*           m_pEntityDb = nullptr;
+		ResourceSystem*           m_pResources = nullptr;
+		RenderingSettings const*  m_pRenderingSettings = nullptr;
+		RenderSceneManager const* m_pRenderScene = nullptr;
 
-		PipelineHandle m_Pipeline;
+		PipelineHandle      m_Pipeline;
+		DescriptorSetHandle m_GlobalDescriptor; // Recreated each frame, shared by all the ranges
 	};
 }
@@ -8,22 +8,26 @@
 #include "CookieKat/Engine/Entities/EntitySystem.h"
 
 namespace CKE {
-	class GBufferPass : public FGGraphicsRenderPass
+	class GBufferPass : public FGParallelGraphicsRenderPass
 	{
 	public:
-		GBufferPass() : FGGraphicsRenderPass{"GBufferPass"} {}
+		GBufferPass() : FGParallelGraphicsRenderPass{"GBufferPass"} {}
 
 		void Initialize(RenderPassInitCtx* pCtx);
 		void Setup(FrameGraphSetupContext& setup) override;
-		void Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) override;
+		u32  BeginParallelExecute(ExecuteResourcesCtx& ctx, RenderDevice& rd, RenderingInfo& renderingInfo) override;
+		void ExecuteRange(CommandList& cmdList, RenderDevice& rd, FGRecordRange const& range) override;
 
 	private:
-		RenderDevice*            m_pDevice = nullptr;
-		TextureSamplersCache*    m_pSamplerCache = nullptr;
-		EntityDatabase*          m_pEntityDB = nullptr;
-		ResourceSystem*          m_pResources = nullptr;
-		RenderingSettings const* m_pRenderingSettings = nullptr;
+		RenderDevice*             m_pDevice = nullptr;
+		TextureSamplersCache*     m_pSamplerCache = nullptr;
+		EntityDatabase*           m_pEntityDB = nullptr;
+		ResourceSystem*           m_pResources = nullptr;
+		RenderingSettings const*  m_pRenderingSettings = nullptr;
+		RenderSceneManager const* m_pRenderScene = nullptr;
 
-		PipelineHandle m_Pipeline;
+		PipelineHandle      m_Pipeline;
+		DescriptorSetHandle m_GlobalDescriptor; // Recreated each frame, shared by all the ranges
+		SamplerHandle       m_MaterialSampler;  // The sampler cache can only be used from the main thread
 	};
 }
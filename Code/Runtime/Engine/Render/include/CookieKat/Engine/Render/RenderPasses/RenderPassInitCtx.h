@@ -9,6 +9,7 @@
 
 namespace CKE {
 	struct RenderingSettings;
+	class RenderSceneManager;
 }
 
 namespace CKE {
@@ -16,14 +17,16 @@ namespace CKE {
 	{
 	public:
 		RenderPassInitCtx(RenderDevice*   pDevice, TextureSamplersCache* pSamplersCache, ResourceSystem* pResources,
-		                  EntityDatabase* pEntityDB, RenderingSettings*  pView, PipelineManager* pPipelineManager) :
+		                  EntityDatabase* pEntityDB, RenderingSettings*  pView, PipelineManager* pPipelineManager,
+		                  RenderSceneManager* pRenderScene) :
 			m_pDevice{pDevice}, m_pSamplerCache{pSamplersCache}, m_pResources{pResources}, m_pEntityDB{pEntityDB},
-			m_pView{pView}, m_pPipelineManager{pPipelineManager} {}
+			m_pView{pView}, m_pPipelineManager{pPipelineManager}, m_pRenderScene{pRenderScene} {}
 
 		RenderDevice*            GetDevice() const { return m_pDevice; }
 		TextureSamplersCache*    GetSamplerCache() const { return m_pSamplerCache; }
 		PipelineManager*         GetPipelineManager() const { return m_pPipelineManager; }
 		RenderingSettings const* GetRenderingSettings() const { return m_pView; }
+		RenderSceneManager*      GetRenderScene() const { return m_pRenderScene; }
 
 		ResourceSystem* GetResourceSystem() const { return m_pResources; }
 		EntityDatabase* GetEntityDatabase() const { return m_pEntityDB; }
@@ -36,5 +39,6 @@ namespace CKE {
 		TextureSamplersCache* m_pSamplerCache{nullptr};
 		PipelineManager*      m_pPipelineManager{nullptr};
 		RenderingSettings*    m_pView{nullptr};
+		RenderSceneManager*   m_pRenderScene{nullptr};
 	};
 }
\ No newline at end of file
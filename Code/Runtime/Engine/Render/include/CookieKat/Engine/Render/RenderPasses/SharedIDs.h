@@ -6,8 +6,10 @@ namespace CKE {
 	struct SceneGlobal
 	{
 		inline static const String View{ "ViewUBO" };
-		inline static const String Lights{ "LightsUBO" };
+		inline static const String Lights{ "Lights" };
+		inline static const String LightClusters{ "LightClusters" };
 		inline static const String ObjectData{ "ObjectData" };
+		inline static const String InstanceData{ "InstanceData" };
 		inline static const String EnviorementData{ "EnviorementData" };
 	};
 
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Bounds.h"
+
+namespace CKE {
+	// Bounding volume hierarchy of the world space bounds of the scene objects, used to cull them against the view.
+	// Objects are identified by their index in the object data buffer.
+	// Moving objects only refit the node bounds, the tree is rebuilt when objects are added or removed
+	// or when the refits made the nodes too loose.
+	class CullingBVH
+	{
+	public:
+		static constexpr u32 MAX_LEAF_OBJECTS = 4;
+
+		// Objects
+		//-----------------------------------------------------------------------------
+
+		// Adds the object or updates its bounds, the tree is updated on the next Update()
+		void SetObjectBounds(u32 objectIdx, AABB const& bounds);
+		void RemoveObject(u32 objectIdx);
+		void Clear();
+
+		inline bool HasObject(u32 objectIdx) const {
+			return objectIdx < m_IsObjectPresent.size() && m_IsObjectPresent[objectIdx];
+		}
+
+		inline AABB const& GetObjectBounds(u32 objectIdx) const { return m_ObjectBounds[objectIdx]; }
+
+		// Tree
+		//-----------------------------------------------------------------------------
+
+		// Rebuilds or refits the tree to the changes made to the objects since the last update
+		void Update();
+
+		// Appends the objects with bounds inside or intersecting the frustum
+		void Cull(Frustum const& frustum, Vector<u32>& visibleObjects) const;
+
+		inline u32 GetNumObjects() const { return m_NumObjects; }
+		inline u32 GetNumNodes() const { return static_cast<u32>(m_Nodes.size()); }
+		inline u64 GetNumRebuilds() const { return m_NumRebuilds; }
+
+	private:
+		// Nodes are stored depth first, the left child follows its parent and the objects of a subtree
+		// are a contiguous range of m_NodeObjects
+		struct Node
+		{
+			AABB m_Bounds;
+			u32  m_FirstObject;
+			u32  m_NumObjects;
+			u32  m_RightChild; // 0 for leaves
+		};
+
+		struct BuildObject
+		{
+			AABB m_Bounds;
+			Vec3 m_Centroid;
+			u32  m_ObjectIdx;
+		};
+
+		void Build();
+		u32  BuildNode(Vector<BuildObject>& objects, u32 begin, u32 end, u32 depth);
+		void Refit();
+
+	private:
+		Vector<AABB> m_ObjectBounds;
+		Vector<u8>   m_IsObjectPresent;
+		u32          m_NumObjects = 0;
+
+		Vector<Node> m_Nodes;
+		Vector<u32>  m_NodeObjects;
+
+		bool m_NeedsRebuild = false;
+		bool m_NeedsRefit = false;
+		f32  m_BuildSurfaceArea = 0.0f; // Sum of the node areas when built, to detect degraded refits
+		u64  m_NumRebuilds = 0;
+	};
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Math.h"
+#include "CookieKat/Systems/Resources/ResourceID.h"
+
+#include <bit>
+
+namespace CKE {
+	class CullingBVH;
+	class MeshResource;
+	class RenderMaterialResource;
+	struct RenderObjectData;
+}
+
+namespace CKE {
+	// Pipelines the scene objects can be drawn with, in the order they are drawn
+	enum class DrawPipeline : u8
+	{
+		Opaque,
+	};
+
+	// 64 bit key the draw packets are sorted by, from the most to the least significant bits:
+	// pipeline (4) | material slot (16) | mesh slot (16) | LOD (4) | depth (24)
+	// Packets that only differ in depth are instances of the same draw, drawn front to back.
+	namespace DrawSortKey
+	{
+		constexpr u32 DEPTH_BITS = 24;
+		constexpr u32 LOD_BITS = 4;
+		constexpr u32 MESH_BITS = 16;
+		constexpr u32 MATERIAL_BITS = 16;
+		constexpr u32 PIPELINE_BITS = 4;
+
+		constexpr u32 LOD_SHIFT = DEPTH_BITS;
+		constexpr u32 MESH_SHIFT = LOD_SHIFT + LOD_BITS;
+		constexpr u32 MATERIAL_SHIFT = MESH_SHIFT + MESH_BITS;
+		constexpr u32 PIPELINE_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+
+		// Positive floats keep their order when compared as integers, the top bits of the
+		// squared distance are enough to order the objects front to back
+		inline u64 QuantizeDepth(f32 distanceSquared) {
+			return distanceSquared > 0.0f ? std::bit_cast<u32>(distanceSquared) >> (32 - DEPTH_BITS) : 0;
+		}
+
+		inline u64 Make(DrawPipeline pipeline, u16 materialSlot, u16 meshSlot, u32 lodIndex, f32 distanceSquared) {
+			return static_cast<u64>(pipeline) << PIPELINE_SHIFT
+					| static_cast<u64>(materialSlot) << MATERIAL_SHIFT
+					| static_cast<u64>(meshSlot) << MESH_SHIFT
+					| static_cast<u64>(lodIndex & ((1u << LOD_BITS) - 1)) << LOD_SHIFT
+					| QuantizeDepth(distanceSquared);
+		}
+
+		// Part of the key shared by all the instances of a draw
+		inline u64 GetBatchBits(u64 key) { return key >> DEPTH_BITS; }
+
+		inline DrawPipeline GetPipeline(u64 key) { return static_cast<DrawPipeline>(key >> PIPELINE_SHIFT); }
+		inline u16          GetMaterialSlot(u64 key) { return static_cast<u16>(key >> MATERIAL_SHIFT); }
+		inline u16          GetMeshSlot(u64 key) { return static_cast<u16>(key >> MESH_SHIFT); }
+		inline u32          GetLODIndex(u64 key) { return static_cast<u32>(key >> LOD_SHIFT) & ((1u << LOD_BITS) - 1); }
+	}
+
+	// A visible object to draw
+	struct DrawPacket
+	{
+		u64 m_SortKey;
+		u32 m_ObjectIdx;
+	};
+
+	// Instanced draw of consecutive packets that share the pipeline, material, mesh and LOD.
+	// The object indices of the instances are m_FirstInstance..m_FirstInstance + m_InstanceCount of the instance list.
+	struct DrawBatch
+	{
+		TResourceID<MeshResource>           m_MeshID;
+		TResourceID<RenderMaterialResource> m_MaterialID;
+		u32                                 m_LODIndex;
+		u32                                 m_FirstInstance;
+		u32                                 m_InstanceCount;
+		DrawPipeline                        m_Pipeline;
+	};
+
+	// Visible objects of the scene sorted and merged in instanced draws, built once per frame
+	// and read by all the passes that draw the scene geometry.
+	class DrawList
+	{
+	public:
+		DrawList();
+
+		// Slots
+		//-----------------------------------------------------------------------------
+
+		// Small index of a mesh or material for the sort keys, the slots are kept between frames.
+		// Slot 0 is always the invalid id, which objects without a material use.
+		u16 GetMeshSlot(TResourceID<MeshResource> meshID);
+		u16 GetMaterialSlot(TResourceID<RenderMaterialResource> materialID);
+
+		// Build
+		//-----------------------------------------------------------------------------
+
+		// Creates, sorts and batches the packets of the visible objects, sorting instances by
+		// the distance from the view position to the center of their bounds
+		void Build(Vector<RenderObjectData> const& objects, Vector<u32> const& visibleObjects,
+		           CullingBVH const& objectBounds, Vec3 viewPosition);
+
+		// Sorts the packets by key keeping the order of equal keys, an LSD radix sort
+		// that skips the bytes all the keys share
+		static void SortPackets(Vector<DrawPacket>& packets, Vector<DrawPacket>& scratch);
+
+		// Draws
+		//-----------------------------------------------------------------------------
+
+		inline Vector<DrawPacket> const& GetPackets() const { return m_Packets; }
+		inline Vector<DrawBatch> const&  GetBatches() const { return m_Batches; }
+
+		// Object index of every instance, uploaded for the shaders to find the object data of each instance
+		inline Vector<u32> const& GetInstances() const { return m_Instances; }
+
+	private:
+		void BuildBatches();
+
+	private:
+		Map<u64, u16>                               m_MeshSlots;
+		Map<u64, u16>                               m_MaterialSlots;
+		Vector<TResourceID<MeshResource>>           m_Meshes;
+		Vector<TResourceID<RenderMaterialResource>> m_Materials;
+
+		Vector<DrawPacket> m_Packets;
+		Vector<DrawPacket> m_SortScratch;
+		Vector<DrawBatch>  m_Batches;
+		Vector<u32>        m_Instances;
+	};
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Math.h"
+#include "CookieKat/Core/Math/Bounds.h"
+
+namespace CKE {
+	class TaskSystem;
+}
+
+namespace CKE {
+	// Representation of a point light structure in the GPU
+	struct PointLightGPU
+	{
+		Vec4 m_ViewSpacePosition; // w is the radius the light reaches
+		Vec4 m_Radiance;
+	};
+
+	// Range of the light index list with the lights that touch a cluster
+	struct LightClusterGPU
+	{
+		u32 m_FirstLight;
+		u32 m_NumLights;
+	};
+
+	// Parameters the lighting shader finds the cluster of a pixel with
+	struct LightGridGPU
+	{
+		UInt4 m_Size;    // Tiles in x and y, depth slices and number of lights
+		Vec4  m_Slicing; // Scale and bias from log(view depth) to the depth slice
+	};
+
+	// Screen tiles and exponential depth slices the view frustum is split in.
+	// Depths closer than m_Near belong to the first slice, depths past m_Far to none.
+	struct LightGridDesc
+	{
+		u32 m_TilesX = 16;
+		u32 m_TilesY = 9;
+		u32 m_NumSlices = 24;
+		f32 m_Near = 0.1f;
+		f32 m_Far = 1000.0f;
+
+		inline bool operator==(LightGridDesc const& other) const = default;
+	};
+
+	// Assigns point lights to the clusters of a view frustum grid that their bounding spheres touch,
+	// so the lighting only evaluates the lights of the cluster each pixel is in.
+	//
+	// Clusters are indexed as (slice * tilesY + tileY) * tilesX + tileX. Each one gets a range of the
+	// light index list, with its lights in increasing order.
+	class LightClusterBuilder
+	{
+	public:
+		// Computes the view space bounds of the clusters, does nothing if the grid and projection didn't change
+		void SetGrid(LightGridDesc const& desc, Mat4 const& proj);
+
+		// Assigns the lights, with view space positions, to the clusters of the grid.
+		// With a task system the rows of clusters are tested from all the worker threads.
+		void Build(Vector<PointLightGPU> const& lights, TaskSystem* pTaskSystem = nullptr);
+
+		inline u32 GetClusterIndex(u32 tileX, u32 tileY, u32 slice) const {
+			return (slice * m_Desc.m_TilesY + tileY) * m_Desc.m_TilesX + tileX;
+		}
+
+		inline u32                  GetNumClusters() const { return static_cast<u32>(m_Clusters.size()); }
+		inline LightGridDesc const& GetGridDesc() const { return m_Desc; }
+		LightGridGPU                GetGridGPU(u32 numLights) const;
+
+		// View space bounds of a cluster, the lights touch the clusters their sphere intersects
+		AABB GetClusterBounds(u32 clusterIdx) const;
+
+		inline Vector<LightClusterGPU> const& GetClusters() const { return m_Clusters; }
+		inline Vector<u32> const&             GetLightIndices() const { return m_LightIndices; }
+
+	private:
+		void AssignRow(u32 row, Vector<PointLightGPU> const& lights);
+
+	private:
+		LightGridDesc m_Desc{};
+		Mat4          m_Proj{0.0f};
+		u32           m_PaddedTilesX = 0; // Tiles in x rounded up to the SIMD width
+
+		// Bounds of the clusters split by axis, x only depends on the slice and the tile column,
+		// y on the slice and the row and z on the slice
+		Vector<f32> m_TileMinX; // [slice * m_PaddedTilesX + tileX]
+		Vector<f32> m_TileMaxX;
+		Vector<f32> m_TileMinY; // [slice * tilesY + tileY]
+		Vector<f32> m_TileMaxY;
+		Vector<f32> m_SliceMinZ;
+		Vector<f32> m_SliceMaxZ;
+		Vector<f32> m_SliceDepths; // Depth where each slice starts, the first one starts at 0
+
+		Vector<Vector<u32>> m_SliceLights{};   // Lights whose spheres reach the depths of each slice
+		Vector<Vector<u32>> m_ClusterLights{}; // Lights of each cluster, filled by the row jobs
+
+		Vector<LightClusterGPU> m_Clusters{};
+		Vector<u32>             m_LightIndices{};
+	};
+}
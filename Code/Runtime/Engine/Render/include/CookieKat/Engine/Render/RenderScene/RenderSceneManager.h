@@ -3,10 +3,19 @@
 #include "CookieKat/Core/Containers/Containers.h"
 #include "CookieKat/Core/Math/Math.h"
 #include "CookieKat/Systems/RenderAPI/RenderHandle.h"
+#include "CookieKat/Systems/RenderAPI/UploadRing.h"
+#include "CookieKat/Systems/Resources/ResourceID.h"
+#include "CookieKat/Engine/Render/RenderScene/CullingBVH.h"
+#include "CookieKat/Engine/Render/RenderScene/DrawList.h"
+#include "CookieKat/Engine/Render/RenderScene/LightClusters.h"
 
 namespace CKE {
 	class RenderDevice;
+	class TaskSystem;
 	class EntityDatabase;
+	class ResourceSystem;
+	class MeshResource;
+	class RenderMaterialResource;
 }
 
 namespace CKE {
@@ -20,20 +29,6 @@ namespace CKE {
 		Mat4 m_ProjInv;
 	};
 
-	// Representation of a point light structure in the GPU
-	struct PointLightGPU
-	{
-		Vec4 m_ViewSpacePosition;
-		Vec4 m_Radiance;
-	};
-
-	// Scene lights data uploaded to the GPU for rendering
-	struct LightsDataGPU
-	{
-		Vec4          m_Size;
-		PointLightGPU m_PointLights[1000];
-	};
-
 	// Per-Object data that is uploaded to the GPU for rendering
 	struct ObjectDataGPU
 	{
@@ -45,6 +40,17 @@ namespace CKE {
 		f32              m_Reflectance;
 	};
 
+	// CPU-side data of an object needed to record its draw calls
+	struct RenderObjectData
+	{
+		TResourceID<MeshResource>           m_MeshID;
+		TResourceID<RenderMaterialResource> m_MaterialID;
+		u32                                 m_LODIndex = 0;
+		u16                                 m_MeshSlot = 0;     // Slots of the ids in the draw list
+		u16                                 m_MaterialSlot = 0;
+		DrawPipeline                        m_Pipeline = DrawPipeline::Opaque;
+	};
+
 	struct SHCoeffs9GPU
 	{
 		Vec4 m_Coeffs[9];
@@ -76,41 +82,98 @@ namespace CKE {
 	// All of the scene data that will be uploaded to the GPU for rendering
 	struct RenderSceneData
 	{
-		ViewDataGPU           m_ViewData{};
-		Vector<ObjectDataGPU> m_ObjectData{};
-		LightsDataGPU         m_LightsData{};
-		EnvironmentGPU        m_EnviorementData{};
+		ViewDataGPU              m_ViewData{};
+		Vector<ObjectDataGPU>    m_ObjectData{};
+		Vector<RenderObjectData> m_Objects{};        // Same indices as m_ObjectData
+		Vector<u32>              m_VisibleObjects{}; // Objects inside the view frustum of m_ViewData
+		DrawList                 m_DrawList{};       // Sorted and batched draws of m_VisibleObjects
+		Vector<PointLightGPU>    m_PointLights{};
+		LightClusterBuilder      m_LightClusters{};  // Point lights of each cluster of the view frustum
+		EnvironmentGPU           m_EnviorementData{};
 	};
 
 	// Contains all of the object and lights data to render a scene from a specific view.
 	// Handles the lifetime and contents of the GPU-side buffers of said data.
+	//
+	// The data rebuilt every frame (view, instances and lights) is written to an upload ring and bound
+	// at its offset in it. The object data persists in a buffer per frame in flight, only the rows
+	// that changed since each copy was last written are written to it.
 	class RenderSceneManager
 	{
 	public:
-		// Creates the required GPU buffers that will contain this scene data
-		void InitializeGPUBuffers(RenderDevice* pDevice);
+		// Creates the required GPU buffers that will contain this scene data.
+		// The task system, if any, is used to assign the lights to the clusters.
+		void InitializeGPUBuffers(RenderDevice* pDevice, TaskSystem* pTaskSystem = nullptr);
 		// Destroys all of the GPU-side buffers that represent this scene
 		void CleanupGPUBuffers(RenderDevice* pDevice);
 
+		// Starts writing the data of a frame whose work will signal the fence, the memory the frames
+		// that signaled it before used is reused. Uploads can only happen between BeginFrame and EndFrame.
+		void BeginFrame(FenceHandle frameFence);
+		// Called once the work of the frame is submitted
+		void EndFrame();
+
 		// Sets and uploads the new camera matrices to the GPU
 		void SetCameraMatrices(Mat4 view, Mat4 proj);
 		// Sets the base Render Area, Viewport and Scissor settings that will be used for the rendering commands
 		void SetRenderingViewSettings(RenderingSettings view);
-		// Sets and uploads environment data to the GPU
+		// Sets the environment data, it is written to the GPU in the next frames
 		void SetEnviorementData(EnvironmentGPU data);
 
-		// Copies all of the scene data from an entity world and sends it to the GPU
-		void CopySceneDataFromEntityWorld(RenderDevice* pDevice, EntityDatabase* pEntities);
+		// Copies all of the scene data from an entity world and sends it to the GPU.
+		// Also selects the LOD that each mesh will be drawn with from the main camera
+		// and culls the objects outside of its frustum.
+		void CopySceneDataFromEntityWorld(RenderDevice* pDevice, EntityDatabase* pEntities, ResourceSystem* pResources);
+
+		// Fills m_Scene.m_VisibleObjects with the objects in the culling BVH that are inside the view frustum,
+		// then builds the draw list of the visible objects and uploads its instances
+		void CullObjects();
+
+		// Assigns the point lights to the clusters of the view and uploads the lights and the clusters
+		void BuildLightClusters();
+
+		// Bytes written to GPU memory since BeginFrame, ring uploads and object rows
+		inline u64 GetFrameUploadBytes() const { return m_UploadRing.GetFrameUploadBytes() + m_FrameRowUploadBytes; }
+
+	private:
+		// Ring memory for data of the current frame, bindings can't be empty so neither is the allocation
+		UploadAllocation AllocateFrameData(u64 sizeInBytes);
+
+		// Flags the object as out of date in every copy of the object data buffer
+		void MarkObjectChanged(u32 objectIdx);
+
+		// Writes the object rows and environment data that the copy of the current frame is missing
+		void WriteStaleData();
 
 	public:
 		RenderDevice* m_pDevice = nullptr;
+		TaskSystem*   m_pTaskSystem = nullptr;
 
 		RenderingSettings m_RenderingViewSettings{};
 		RenderSceneData   m_Scene{};
+		f32               m_LODMaxPixelError = 1.0f; // Max simplification error on screen when selecting mesh LODs
+		LightGridDesc     m_LightGrid{};             // Clusters the lights are assigned to
+		f32               m_LightCutoff = 0.01f;     // Irradiance under which a point light doesn't reach
+
+		CullingBVH m_CullingBVH{};
+		Vector<u8> m_IsObjectInWorld{}; // Objects copied this frame, the rest are removed from the BVH
 
-		BufferHandle m_ViewBuffer;
+		// Ranges of the upload ring with the data of the current frame
+		UploadRing  m_UploadRing{};
+		BufferRange m_ViewBuffer{};
+		BufferRange m_InstanceBuffer{};      // Object index of each instance in the draw list
+		BufferRange m_LightsBuffer{};        // Light grid followed by the point lights
+		BufferRange m_LightClustersBuffer{}; // Light range of each cluster followed by the light indices
+
+		// Persistently mapped, with a copy per frame in flight
 		BufferHandle m_ObjectDataBuffer;
-		BufferHandle m_LightsBuffer;
 		BufferHandle m_EnviorementBuffer;
+
+	private:
+		// Bit i is set when the copy of frame in flight i is out of date
+		Vector<u8>  m_StaleObjectCopies{};
+		Vector<u32> m_StaleObjects{}; // Objects with any stale copy
+		u8          m_StaleEnvironmentCopies = 0;
+		u64         m_FrameRowUploadBytes = 0;
 	};
 }
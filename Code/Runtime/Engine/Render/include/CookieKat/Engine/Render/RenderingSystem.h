@@ -9,6 +9,7 @@
 #include "CookieKat/Engine/Render/PipelineManager/PipelineManager.h"
 #include "CookieKat/Engine/Render/RenderScene/RenderSceneManager.h"
 #include "CookieKat/Systems/RenderUtils/TextureSamplersCache.h"
+#include "CookieKat/Systems/RenderUtils/TextureUploadQueue.h"
 #include "CookieKat/Systems/EngineSystem/IEngineSystem.h"
 
 //-----------------------------------------------------------------------------
@@ -46,22 +47,30 @@ namespace CKE {
 		void RenderFrame();
 		void Shutdown();
 
+		void RecordMetrics(MetricsRegistry& metrics) override;
+
 		void RecordRenderTargetResizeEvent(Int2 newSize);
 
 		inline RenderDevice& GetRenderDevice();
 
+		// Texture loaders upload through it, it submits the copies of each frame within its budget
+		inline TextureUploadQueue* GetTextureUploadQueue();
+
 	private:
 		EntitySystem*   m_pEntitySystem = nullptr;
 		ResourceSystem* m_pResources = nullptr;
 		TaskSystem*     m_pTaskSystem = nullptr;
 
 		RenderDevice         m_Device{};
+		TextureUploadQueue   m_TextureUploadQueue{};
 		TextureSamplersCache m_SamplerCache{};
 		PipelineManager      m_PipelineManager{};
 		RTextureManager      m_RTexManager{};
 		FrameGraph           m_FrameGraph{};
 		bool                 m_TriggerBackBufferResize = false;
 
+		DescriptorSetCacheStats m_LastDescriptorSetStats{}; // Totals when the metrics were last recorded
+
 		RenderSceneManager m_RenderSceneManager{};
 
 		DepthPrePass* m_DepthPass{};
@@ -80,5 +89,6 @@ namespace CKE {
 //-----------------------------------------------------------------------------
 
 namespace CKE {
-	RenderDevice& RenderingSystem::GetRenderDevice() { return m_Device; }
+	RenderDevice&       RenderingSystem::GetRenderDevice() { return m_Device; }
+	TextureUploadQueue* RenderingSystem::GetTextureUploadQueue() { return &m_TextureUploadQueue; }
 }
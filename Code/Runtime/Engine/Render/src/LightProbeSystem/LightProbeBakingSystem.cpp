@@ -71,8 +71,10 @@ namespace CKE {
 		m_FrameGraph.AddTransferPass(&m_CopyToCubemapPass);
 
 		m_FrameGraph.ImportBuffer(SceneGlobal::ObjectData, pSceneData->m_ObjectDataBuffer);
-		m_FrameGraph.ImportBuffer(SceneGlobal::View, pSceneData->m_ViewBuffer);
-		m_FrameGraph.ImportBuffer(SceneGlobal::Lights, pSceneData->m_LightsBuffer);
+		m_FrameGraph.ImportBuffer(SceneGlobal::InstanceData, BufferRange{});
+		m_FrameGraph.ImportBuffer(SceneGlobal::View, BufferRange{});
+		m_FrameGraph.ImportBuffer(SceneGlobal::Lights, BufferRange{});
+		m_FrameGraph.ImportBuffer(SceneGlobal::LightClusters, BufferRange{});
 		m_FrameGraph.ImportBuffer(SceneGlobal::EnviorementData, pSceneData->m_EnviorementBuffer);
 
 		Vec2 renderSize{64, 64};
@@ -80,11 +82,10 @@ namespace CKE {
 			renderSize,
 			ViewportData{Vec2{0.0f}, renderSize}
 		});
+		// The view data is uploaded with each face, as its memory only lives for a frame
 		Mat4 proj = glm::perspective(glm::radians(45.0f), 1.0f, 0.005f, 1'000.0f);
 		proj[1][1] *= -1;
-		pSceneData->SetCameraMatrices(pSceneData->m_Scene.m_ViewData.m_View,
-		                              proj
-		);
+		pSceneData->m_Scene.m_ViewData.m_Proj = proj;
 		m_FrameGraph.Compile(renderSize);
 		m_FrameGraph.UpdateRenderTargetSize(renderSize);
 	}
@@ -109,12 +110,18 @@ namespace CKE {
 
 		for (i32 i = 0; i < 6; ++i) {
 			m_CopyToCubemapPass.SetFaceToCopy(i);
+			m_pRenderScene->BeginFrame(f);
 			m_pRenderScene->SetCameraMatrices(
 				glm::lookAt(pos, pos + dirs[i].forward, dirs[i].up)
 				, m_pRenderScene->m_Scene.m_ViewData.m_Proj
 			);
+			m_FrameGraph.ImportBuffer(SceneGlobal::InstanceData, m_pRenderScene->m_InstanceBuffer);
+			m_FrameGraph.ImportBuffer(SceneGlobal::View, m_pRenderScene->m_ViewBuffer);
+			m_FrameGraph.ImportBuffer(SceneGlobal::Lights, m_pRenderScene->m_LightsBuffer);
+			m_FrameGraph.ImportBuffer(SceneGlobal::LightClusters, m_pRenderScene->m_LightClustersBuffer);
 
 			m_FrameGraph.Execute({SemaphoreHandle{0}, PipelineStage::AllCommands}, SemaphoreHandle{0}, f);
+			m_pRenderScene->EndFrame();
 			m_pDevice->WaitForFence(f);
 			m_pDevice->ResetFence(f);
 			m_pDevice->WaitForDevice();
@@ -143,13 +150,13 @@ namespace CKE {
 			}
 
 			{
-				VkBufferImageCopy c{};
+				BufferImageCopyInfo c{};
 				c.bufferOffset = sizeof(float) * 4 * 64 * 64 * 0;
 				c.bufferImageHeight = 0;
 				c.bufferRowLength = 0;
-				c.imageExtent = VkExtent3D{64, 64, 1};
-				c.imageOffset = VkOffset3D{0, 0, 0};
-				c.imageSubresource = VkImageSubresourceLayers{VK_IMAGE_ASPECT_COLOR_BIT, 0, static_cast<u32>(i), 1};
+				c.imageExtent = UInt3{64, 64, 1};
+				c.imageOffset = Int3{0, 0, 0};
+				c.imageSubresource = TextureSubresourceLayers{TextureAspectMask::Color, 0, static_cast<u32>(i), 1};
 				TransferCommandList t = m_pDevice->GetTransferCmdList();
 				t.Begin();
 				t.CopyTextureToBuffer(m_CubeMapTex, m_ReadBackBuffer, c);
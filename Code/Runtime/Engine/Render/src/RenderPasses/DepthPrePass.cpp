@@ -12,11 +12,13 @@ namespace CKE {
 		m_pEntityDb = pInitCtx->GetEntityDatabase();
 		m_pResources = pInitCtx->GetResourceSystem();
 		m_pRenderingSettings = pInitCtx->GetRenderingSettings();
+		m_pRenderScene = pInitCtx->GetRenderScene();
 		m_Pipeline = pInitCtx->GetPipelineManager()->GetPipeline(PipelineIDS::DepthPrePass);
 	}
 
 	void DepthPrePass::Setup(FrameGraphSetupContext& setup) {
 		setup.UseBuffer(SceneGlobal::ObjectData);
+		setup.UseBuffer(SceneGlobal::InstanceData);
 		setup.UseBuffer(SceneGlobal::View);
 
 		TextureDesc depthStencilDesc{};
@@ -29,20 +31,14 @@ namespace CKE {
 		setup.UseTexture(GBuffer::DepthStencil, FGPipelineAccessInfo::DepthStencil());
 	}
 
-	struct RenderBatch
-	{
-		BufferHandle m_VertexBuffer;
-		BufferHandle m_IndexBuffer;
-		u32 m_IndexCount;
-	};
-
-	void DepthPrePass::Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) {
+	u32 DepthPrePass::BeginParallelExecute(ExecuteResourcesCtx& ctx, RenderDevice& rd, RenderingInfo& renderingInfo) {
 		TextureViewHandle const depthStencil = ctx.GetTextureView(General::DepthStencil);
-		BufferHandle const      viewBuffer = ctx.GetBuffer(SceneGlobal::View);
+		BufferRange const       viewBuffer = ctx.GetBufferRange(SceneGlobal::View);
 		BufferHandle const      objectBuffer = ctx.GetBuffer(SceneGlobal::ObjectData);
+		BufferRange const       instanceBuffer = ctx.GetBufferRange(SceneGlobal::InstanceData);
 
 		// Rendering Setup
-		cmdList.BeginRendering(RenderingInfo{
+		renderingInfo = RenderingInfo{
 			.m_RenderArea = m_pRenderingSettings->m_RenderArea,
 			.m_ColorAttachments = {},
 			.m_UseDepthAttachment = true,
@@ -51,27 +47,36 @@ namespace CKE {
 				TextureLayout::DepthStencil_Attachment,
 				LoadOp::Clear, StoreOp::Store,
 			},
-		});
+		};
+
+		DescriptorSetBuilder descriptorBuilder = rd.CreateDescriptorSetBuilder(m_Pipeline, 0);
+		m_GlobalDescriptor = descriptorBuilder
+		                     .BindDynamicUniformBuffer(0, viewBuffer)
+		                     .BindStorageBuffer(1, objectBuffer)
+		                     .BindDynamicStorageBuffer(2, instanceBuffer)
+		                     .Build();
+
+		return static_cast<u32>(m_pRenderScene->m_Scene.m_DrawList.GetBatches().size());
+	}
 
+	void DepthPrePass::ExecuteRange(CommandList& cmdList, RenderDevice& rd, FGRecordRange const& range) {
 		cmdList.SetGraphicsPipeline(m_Pipeline);
 		cmdList.SetDefaultViewportScissor(m_pRenderingSettings->m_Viewport.m_Extent);
+		cmdList.BindDescriptor(m_Pipeline, m_GlobalDescriptor);
 
-		DescriptorSetBuilder      descriptorBuilder = rd.CreateDescriptorSetBuilder(m_Pipeline, 0);
-		DescriptorSetHandle const descriptor = descriptorBuilder
-		                                       .BindUniformBuffer(0, viewBuffer)
-		                                       .BindStorageBuffer(1, objectBuffer)
-		                                       .Build();
-		cmdList.BindDescriptor(m_Pipeline, descriptor);
-
-		// Record draw calls
-		for (auto& [l2w, mesh] : m_pEntityDb->GetMultiCompTupleIter<
-			     LocalToWorldComponent, MeshComponent>()) {
-			MeshResource const* m = m_pResources->GetResource<MeshResource>(mesh->m_MeshID);
-			cmdList.SetVertexBuffer(m->GetVertexBuffer());
-			cmdList.SetIndexBuffer(m->GetIndexBuffer(), 0);
-			cmdList.DrawIndexed(m->GetIndices().size(), mesh->m_ObjectIdx - 1);
+		// Record the instanced draws of the range, consecutive batches of a mesh keep its buffers bound
+		Vector<DrawBatch> const& batches = m_pRenderScene->m_Scene.m_DrawList.GetBatches();
+		MeshResource const*      pLastMesh = nullptr;
+		for (u32 i = range.m_Begin; i < range.m_End; ++i) {
+			DrawBatch const&    batch = batches[i];
+			MeshResource const* m = m_pResources->GetResource<MeshResource>(batch.m_MeshID);
+			if (m != pLastMesh) {
+				cmdList.SetVertexBuffer(m->GetVertexBuffer());
+				cmdList.SetIndexBuffer(m->GetIndexBuffer(), 0);
+				pLastMesh = m;
+			}
+			MeshProcessing::MeshLOD const& lod = m->GetLOD(batch.m_LODIndex);
+			cmdList.DrawIndexed(lod.m_IndexCount, batch.m_InstanceCount, lod.m_IndexOffset, 0, batch.m_FirstInstance);
 		}
-
-		cmdList.EndRendering();
 	}
 }
@@ -17,6 +17,7 @@ namespace CKE {
 		m_pEntityDB = pCtx->GetEntityDatabase();
 		m_pResources = pCtx->GetResourceSystem();
 		m_pRenderingSettings = pCtx->GetRenderingSettings();
+		m_pRenderScene = pCtx->GetRenderScene();
 		m_Pipeline = pCtx->GetPipelineManager()->GetPipeline(PipelineIDS::GBufferPass);
 	}
 
@@ -24,6 +25,7 @@ namespace CKE {
 		setup.UseTexture(GBuffer::DepthStencil, FGPipelineAccessInfo::DepthStencil());
 		setup.UseBuffer(SceneGlobal::View);
 		setup.UseBuffer(SceneGlobal::ObjectData);
+		setup.UseBuffer(SceneGlobal::InstanceData);
 
 		// GBuffer Textures
 		//-----------------------------------------------------------------------------
@@ -62,7 +64,7 @@ namespace CKE {
 		setup.UseTexture(GBuffer::ObjectIdx, FGPipelineAccessInfo::ColorAttachmentWrite());
 	}
 
-	void GBufferPass::Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) {
+	u32 GBufferPass::BeginParallelExecute(ExecuteResourcesCtx& ctx, RenderDevice& rd, RenderingInfo& renderingInfo) {
 		TextureViewHandle depthBufferTex = ctx.GetTextureView(GBuffer::DepthStencil);
 		TextureViewHandle albedoTex = ctx.GetTextureView(GBuffer::Albedo);
 		TextureViewHandle normalsTex = ctx.GetTextureView(GBuffer::Normals);
@@ -70,13 +72,14 @@ namespace CKE {
 		TextureViewHandle roughnessMetallicTex = ctx.GetTextureView(GBuffer::RoughMetalRefl);
 		TextureViewHandle objIdxTex = ctx.GetTextureView(GBuffer::ObjectIdx);
 
-		BufferHandle viewBuffer = ctx.GetBuffer(SceneGlobal::View);
+		BufferRange  viewBuffer = ctx.GetBufferRange(SceneGlobal::View);
 		BufferHandle objectBuffer = ctx.GetBuffer(SceneGlobal::ObjectData);
+		BufferRange  instanceBuffer = ctx.GetBufferRange(SceneGlobal::InstanceData);
 
 		// Rendering Setup
 		//-----------------------------------------------------------------------------
 
-		cmdList.BeginRendering(RenderingInfo{
+		renderingInfo = RenderingInfo{
 			.m_RenderArea = m_pRenderingSettings->m_RenderArea,
 			.m_ColorAttachments = {
 				RenderingAttachment{
@@ -110,85 +113,92 @@ namespace CKE {
 				TextureLayout::DepthStencil_Attachment,
 				LoadOp::Load, StoreOp::Store,
 			},
-		});
-
-		cmdList.SetGraphicsPipeline(m_Pipeline);
-		cmdList.SetDefaultViewportScissor(m_pRenderingSettings->m_Viewport.m_Extent);
+		};
 
 		// Global Descriptor
 		//-----------------------------------------------------------------------------
 
-		{
-			DescriptorSetBuilder b = rd.CreateDescriptorSetBuilder(m_Pipeline, 0);
-			auto                 globalDescriptor =
-					b.BindUniformBuffer(0, viewBuffer)
-					 .BindStorageBuffer(1, objectBuffer)
-					 .Build();
-			cmdList.BindDescriptor(m_Pipeline, globalDescriptor);
-		}
+		DescriptorSetBuilder b = rd.CreateDescriptorSetBuilder(m_Pipeline, 0);
+		m_GlobalDescriptor =
+				b.BindDynamicUniformBuffer(0, viewBuffer)
+				 .BindStorageBuffer(1, objectBuffer)
+				 .BindDynamicStorageBuffer(2, instanceBuffer)
+				 .Build();
 
-		// Record draw calls
-		//-----------------------------------------------------------------------------
+		SamplerDesc samplerDesc{};
+		samplerDesc.m_WrapU = TextureWrapMode::Repeat;
+		samplerDesc.m_WrapV = TextureWrapMode::Repeat;
+		samplerDesc.m_MaxLod = 16.0f; // Allow sampling the whole mip chain of the material textures
+		m_MaterialSampler = m_pSamplerCache->CreateSampler(samplerDesc);
 
-		DescriptorSetBuilder b = rd.CreateDescriptorSetBuilder(m_Pipeline, 1);
-		u64                  lastMaterialHandle = -1;
-		for (auto& [l2w, mesh] : m_pEntityDB->GetMultiCompTupleIter<LocalToWorldComponent, MeshComponent>()) {
+		return static_cast<u32>(m_pRenderScene->m_Scene.m_DrawList.GetBatches().size());
+	}
 
-			// Skip over currently loading meshes
-			if (!m_pResources->IsResourceLoaded(mesh->m_MeshID)) {
-				continue;
-			}
+	void GBufferPass::ExecuteRange(CommandList& cmdList, RenderDevice& rd, FGRecordRange const& range) {
+		cmdList.SetGraphicsPipeline(m_Pipeline);
+		cmdList.SetDefaultViewportScissor(m_pRenderingSettings->m_Viewport.m_Extent);
+		cmdList.BindDescriptor(m_Pipeline, m_GlobalDescriptor);
 
-			// Initially set default textures
-			TextureViewHandle albedo = GlobalRenderAssets::White1x1();
-			TextureViewHandle normal = GlobalRenderAssets::NormalDefault();
-			TextureViewHandle roughness = GlobalRenderAssets::White1x1();
-			TextureViewHandle metallic = GlobalRenderAssets::White1x1();
-
-			// Override default textures with material textures if any exist
-			if (mesh->m_MaterialID.IsValid() && m_pResources->IsResourceLoaded(mesh->m_MaterialID)) {
-				auto const material = m_pResources->GetResource<RenderMaterialResource>(mesh->m_MaterialID);
-				if (material->GetAlbedoTexture().IsValid()) {
-					albedo = m_pResources->GetResource<RenderTextureResource>(material->GetAlbedoTexture())->GetTextureView();
-				}
-				if (material->GetNormalTexture().IsValid()) {
-					normal = m_pResources->GetResource<RenderTextureResource>(material->GetNormalTexture())->GetTextureView();
-				}
-				if (material->GetRoughnessTexture().IsValid()) {
-					roughness = m_pResources->GetResource<RenderTextureResource>(material->GetRoughnessTexture())->
-					                          GetTextureView();
-				}
-				if (material->GetMetalicTexture().IsValid()) {
-					metallic = m_pResources->GetResource<RenderTextureResource>(material->GetMetalicTexture())->
-					                         GetTextureView();
-				}
-			}
+		// Record draw calls
+		//-----------------------------------------------------------------------------
+
+		// The draw list is sorted by material, so each material is bound once per range
+		Vector<DrawBatch> const& batches = m_pRenderScene->m_Scene.m_DrawList.GetBatches();
+		u64                      lastMaterialHandle = -1;
+		MeshResource const*      pLastMesh = nullptr;
+		for (u32 i = range.m_Begin; i < range.m_End; ++i) {
+			DrawBatch const& batch = batches[i];
 
 			// Material Bindings
 			// Only bind if the material changed
-			if (mesh->m_MaterialID.GetU64() != lastMaterialHandle) {
-				SamplerDesc samplerDesc{};
-				samplerDesc.m_WrapU = TextureWrapMode::Repeat;
-				samplerDesc.m_WrapV = TextureWrapMode::Repeat;
-				SamplerHandle       samplerHandle = m_pSamplerCache->CreateSampler(samplerDesc);
-				DescriptorSetHandle materialDescriptor =
-						b.BindTextureWithSampler(0, albedo, samplerHandle)
-						 .BindTextureWithSampler(1, normal, samplerHandle)
-						 .BindTextureWithSampler(2, roughness, samplerHandle)
-						 .BindTextureWithSampler(3, metallic, samplerHandle)
+			if (batch.m_MaterialID.GetU64() != lastMaterialHandle) {
+				// Initially set default textures
+				TextureViewHandle albedo = GlobalRenderAssets::White1x1();
+				TextureViewHandle normal = GlobalRenderAssets::NormalDefault();
+				TextureViewHandle roughness = GlobalRenderAssets::White1x1();
+				TextureViewHandle metallic = GlobalRenderAssets::White1x1();
+
+				// Override default textures with material textures if any exist
+				if (batch.m_MaterialID.IsValid() && m_pResources->IsResourceLoaded(batch.m_MaterialID)) {
+					auto const material = m_pResources->GetResource<RenderMaterialResource>(batch.m_MaterialID);
+					if (material->GetAlbedoTexture().IsValid()) {
+						albedo = m_pResources->GetResource<RenderTextureResource>(material->GetAlbedoTexture())->GetTextureView();
+					}
+					if (material->GetNormalTexture().IsValid()) {
+						normal = m_pResources->GetResource<RenderTextureResource>(material->GetNormalTexture())->GetTextureView();
+					}
+					if (material->GetRoughnessTexture().IsValid()) {
+						roughness = m_pResources->GetResource<RenderTextureResource>(material->GetRoughnessTexture())->
+						                          GetTextureView();
+					}
+					if (material->GetMetalicTexture().IsValid()) {
+						metallic = m_pResources->GetResource<RenderTextureResource>(material->GetMetalicTexture())->
+						                         GetTextureView();
+					}
+				}
+
+				// Sets of each range come from the descriptor pools of its list
+				DescriptorSetBuilder b = rd.CreateDescriptorSetBuilder(m_Pipeline, 1, range.m_ListIdx);
+				DescriptorSetHandle  materialDescriptor =
+						b.BindTextureWithSampler(0, albedo, m_MaterialSampler)
+						 .BindTextureWithSampler(1, normal, m_MaterialSampler)
+						 .BindTextureWithSampler(2, roughness, m_MaterialSampler)
+						 .BindTextureWithSampler(3, metallic, m_MaterialSampler)
 						 .Build();
 
 				cmdList.BindDescriptor(m_Pipeline, materialDescriptor);
-				lastMaterialHandle = mesh->m_MaterialID.GetU64();
+				lastMaterialHandle = batch.m_MaterialID.GetU64();
 			}
 
 			// Mesh Buffers
-			MeshResource const* m = m_pResources->GetResource<MeshResource>(mesh->m_MeshID);
-			cmdList.SetVertexBuffer(m->GetVertexBuffer());
-			cmdList.SetIndexBuffer(m->GetIndexBuffer(), 0);
-			cmdList.DrawIndexed(m->GetIndices().size(), mesh->m_ObjectIdx - 1);
+			MeshResource const* m = m_pResources->GetResource<MeshResource>(batch.m_MeshID);
+			if (m != pLastMesh) {
+				cmdList.SetVertexBuffer(m->GetVertexBuffer());
+				cmdList.SetIndexBuffer(m->GetIndexBuffer(), 0);
+				pLastMesh = m;
+			}
+			MeshProcessing::MeshLOD const& lod = m->GetLOD(batch.m_LODIndex);
+			cmdList.DrawIndexed(lod.m_IndexCount, batch.m_InstanceCount, lod.m_IndexOffset, 0, batch.m_FirstInstance);
 		}
-
-		cmdList.EndRendering();
 	}
 }
@@ -52,6 +52,7 @@ namespace CKE {
 		setup.UseTexture(SSAOPass::SSAO_Blurred, FGPipelineAccessInfo::FragmentShaderRead());
 		setup.UseBuffer(SceneGlobal::View);
 		setup.UseBuffer(SceneGlobal::Lights);
+		setup.UseBuffer(SceneGlobal::LightClusters);
 		setup.UseBuffer(SceneGlobal::EnviorementData);
 
 		TextureDesc sceneColorDesc{};
@@ -74,8 +75,9 @@ namespace CKE {
 		TextureViewHandle roughnessMetallicTex = ctx.GetTextureView(GBuffer::RoughMetalRefl);
 		TextureViewHandle ssaoTex = ctx.GetTextureView(SSAOPass::SSAO_Blurred);
 
-		BufferHandle lightsBuffer = ctx.GetBuffer(SceneGlobal::Lights);
-		BufferHandle viewBuffer = ctx.GetBuffer(SceneGlobal::View);
+		BufferRange  lightsBuffer = ctx.GetBufferRange(SceneGlobal::Lights);
+		BufferRange  lightClustersBuffer = ctx.GetBufferRange(SceneGlobal::LightClusters);
+		BufferRange  viewBuffer = ctx.GetBufferRange(SceneGlobal::View);
 		BufferHandle envBuffer = ctx.GetBuffer(SceneGlobal::EnviorementData);
 
 		cmdList.BeginRendering(RenderingInfo{
@@ -96,14 +98,15 @@ namespace CKE {
 		SamplerHandle        sampler = m_pSamplersCache->CreateSampler(SamplerDesc{});
 		DescriptorSetBuilder b = rd.CreateDescriptorSetBuilder(m_Pipeline, 0);
 		auto                 materialDescriptor =
-				b.BindUniformBuffer(0, lightsBuffer)
+				b.BindDynamicStorageBuffer(0, lightsBuffer)
 				 .BindTextureWithSampler(1, albedoTex, sampler)
 				 .BindTextureWithSampler(2, normalsTex, sampler)
 				 .BindTextureWithSampler(3, roughnessMetallicTex, sampler)
 				 .BindTextureWithSampler(4, positionTex, sampler)
 				 .BindTextureWithSampler(5, ssaoTex, sampler)
 				 .BindUniformBuffer(6, envBuffer)
-				 .BindUniformBuffer(7, viewBuffer)
+				 .BindDynamicUniformBuffer(7, viewBuffer)
+				 .BindDynamicStorageBuffer(8, lightClustersBuffer)
 				 .Build();
 		cmdList.BindDescriptor(m_Pipeline, materialDescriptor);
 
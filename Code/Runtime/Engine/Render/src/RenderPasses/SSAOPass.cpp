@@ -112,7 +112,7 @@ namespace CKE {
 	void SSAOPass::Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList,
 	                       RenderDevice&         rd) {
 		BufferHandle sampling = ctx.GetBuffer(SamplingBuffer);
-		BufferHandle view = ctx.GetBuffer(SceneGlobal::View);
+		BufferRange  view = ctx.GetBufferRange(SceneGlobal::View);
 
 		TextureViewHandle positionTex = ctx.GetTextureView(GBuffer::Position);
 		TextureViewHandle normalTex = ctx.GetTextureView(GBuffer::Normals);
@@ -144,7 +144,7 @@ namespace CKE {
 				builder.BindTextureWithSampler(0, positionTex, sampler)
 				       .BindTextureWithSampler(1, normalTex, sampler)
 				       .BindTextureWithSampler(2, depthTex, sampler)
-				       .BindUniformBuffer(3, view)
+				       .BindDynamicUniformBuffer(3, view)
 				       .BindUniformBuffer(4, sampling)
 				       .Build();
 		cmdList.BindDescriptor(m_Pipeline, setHandle);
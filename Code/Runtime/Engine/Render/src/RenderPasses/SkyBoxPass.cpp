@@ -48,7 +48,7 @@ namespace CKE {
 	}
 
 	void SkyBoxPass::Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) {
-		BufferHandle      view = ctx.GetBuffer(SceneGlobal::View);
+		BufferRange       view = ctx.GetBufferRange(SceneGlobal::View);
 		TextureViewHandle sceneColor = ctx.GetTextureView(LightingPass::HDRSceneColor);
 		TextureViewHandle depthBuffer = ctx.GetTextureView(GBuffer::DepthStencil);
 
@@ -74,7 +74,7 @@ namespace CKE {
 
 		DescriptorSetBuilder setBuilder = rd.CreateDescriptorSetBuilder(m_Pipeline, 0);
 		DescriptorSetHandle  setHandle = setBuilder
-		                                 .BindUniformBuffer(0, view)
+		                                 .BindDynamicUniformBuffer(0, view)
 		                                 .BindTextureWithSampler(1, m_SkyBoxViewHandle,
 		                                                         m_pSamplerCache->CreateSampler(SamplerDesc{}))
 		                                 .Build();
@@ -0,0 +1,221 @@
+#include "RenderScene/CullingBVH.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <algorithm>
+
+namespace CKE {
+	namespace {
+		// Rebuild when refitting made the tree this much looser than when it was built
+		constexpr f32 REBUILD_SURFACE_AREA_RATIO = 2.0f;
+
+		constexpr u32 SAH_BINS = 16;
+
+		// Deeper nodes are split in the median, which bounds the depth of the tree for the cull stack
+		constexpr u32 MAX_SAH_DEPTH = 32;
+		constexpr u32 MAX_STACK_SIZE = 64;
+	}
+
+	void CullingBVH::SetObjectBounds(u32 objectIdx, AABB const& bounds) {
+		if (objectIdx >= m_ObjectBounds.size()) {
+			m_ObjectBounds.resize(objectIdx + 1);
+			m_IsObjectPresent.resize(objectIdx + 1, false);
+		}
+
+		if (!m_IsObjectPresent[objectIdx]) {
+			m_IsObjectPresent[objectIdx] = true;
+			++m_NumObjects;
+			m_NeedsRebuild = true;
+		}
+		else if (m_ObjectBounds[objectIdx].m_Min == bounds.m_Min && m_ObjectBounds[objectIdx].m_Max == bounds.m_Max) {
+			return;
+		}
+		m_ObjectBounds[objectIdx] = bounds;
+		m_NeedsRefit = true;
+	}
+
+	void CullingBVH::RemoveObject(u32 objectIdx) {
+		if (!HasObject(objectIdx)) { return; }
+
+		m_IsObjectPresent[objectIdx] = false;
+		--m_NumObjects;
+		m_NeedsRebuild = true;
+	}
+
+	void CullingBVH::Clear() {
+		m_ObjectBounds.clear();
+		m_IsObjectPresent.clear();
+		m_NumObjects = 0;
+		m_Nodes.clear();
+		m_NodeObjects.clear();
+		m_NeedsRebuild = false;
+		m_NeedsRefit = false;
+	}
+
+	// Tree
+	//-----------------------------------------------------------------------------
+
+	void CullingBVH::Update() {
+		if (m_NeedsRebuild) { Build(); }
+		else if (m_NeedsRefit) { Refit(); }
+		m_NeedsRebuild = false;
+		m_NeedsRefit = false;
+	}
+
+	void CullingBVH::Cull(Frustum const& frustum, Vector<u32>& visibleObjects) const {
+		if (m_Nodes.empty()) { return; }
+
+		// Nodes inside the frustum add their whole range of objects without testing the children
+		u32 stack[MAX_STACK_SIZE];
+		u32 stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0) {
+			Node const& node = m_Nodes[stack[--stackSize]];
+
+			FrustumTest const test = frustum.Test(node.m_Bounds);
+			if (test == FrustumTest::Outside) { continue; }
+
+			u32 const* pObjects = m_NodeObjects.data() + node.m_FirstObject;
+			if (test == FrustumTest::Inside) {
+				visibleObjects.insert(visibleObjects.end(), pObjects, pObjects + node.m_NumObjects);
+			}
+			else if (node.m_RightChild == 0) {
+				for (u32 i = 0; i < node.m_NumObjects; ++i) {
+					if (frustum.IsVisible(m_ObjectBounds[pObjects[i]])) { visibleObjects.push_back(pObjects[i]); }
+				}
+			}
+			else {
+				CKE_ASSERT(stackSize + 2 <= MAX_STACK_SIZE);
+				stack[stackSize++] = node.m_RightChild;
+				stack[stackSize++] = static_cast<u32>(&node - m_Nodes.data()) + 1;
+			}
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+
+	void CullingBVH::Build() {
+		m_Nodes.clear();
+		m_NodeObjects.clear();
+		++m_NumRebuilds;
+		if (m_NumObjects == 0) { return; }
+
+		// Objects are partitioned by value so the splits read them sequentially
+		Vector<BuildObject> objects{};
+		objects.reserve(m_NumObjects);
+		for (u32 i = 0; i < m_ObjectBounds.size(); ++i) {
+			if (!m_IsObjectPresent[i]) { continue; }
+			objects.push_back(BuildObject{m_ObjectBounds[i], m_ObjectBounds[i].GetCenter(), i});
+		}
+
+		m_Nodes.reserve(2 * m_NumObjects / MAX_LEAF_OBJECTS + 1);
+		BuildNode(objects, 0, m_NumObjects, 0);
+
+		m_NodeObjects.resize(m_NumObjects);
+		for (u32 i = 0; i < m_NumObjects; ++i) { m_NodeObjects[i] = objects[i].m_ObjectIdx; }
+
+		m_BuildSurfaceArea = 0.0f;
+		for (Node const& node : m_Nodes) { m_BuildSurfaceArea += node.m_Bounds.GetSurfaceArea(); }
+	}
+
+	u32 CullingBVH::BuildNode(Vector<BuildObject>& objects, u32 begin, u32 end, u32 depth) {
+		u32 const nodeIdx = static_cast<u32>(m_Nodes.size());
+		m_Nodes.push_back(Node{AABB{}, begin, end - begin, 0});
+
+		AABB bounds{};
+		AABB centroidBounds{};
+		for (u32 i = begin; i < end; ++i) {
+			bounds.Expand(objects[i].m_Bounds);
+			centroidBounds.Expand(objects[i].m_Centroid);
+		}
+		m_Nodes[nodeIdx].m_Bounds = bounds;
+		if (end - begin <= MAX_LEAF_OBJECTS) { return nodeIdx; }
+
+		// Split the longest axis of the centroids where the surface area heuristic is lowest
+		Vec3 const size = centroidBounds.m_Max - centroidBounds.m_Min;
+		u32 const  axis = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+
+		u32 mid = begin + (end - begin) / 2;
+		if (size[axis] > 0.0f && depth < MAX_SAH_DEPTH) {
+			AABB binBounds[SAH_BINS]{};
+			u32  binCounts[SAH_BINS]{};
+			f32 const binScale = SAH_BINS / size[axis];
+			auto      getBin = [&](BuildObject const& object) {
+				u32 const bin = static_cast<u32>((object.m_Centroid[axis] - centroidBounds.m_Min[axis]) * binScale);
+				return std::min(bin, SAH_BINS - 1);
+			};
+
+			for (u32 i = begin; i < end; ++i) {
+				u32 const bin = getBin(objects[i]);
+				binBounds[bin].Expand(objects[i].m_Bounds);
+				++binCounts[bin];
+			}
+
+			// Cost of splitting after each bin, sweeping from the right and then from the left
+			f32  rightCosts[SAH_BINS]{};
+			AABB rightBounds{};
+			u32  rightCount = 0;
+			for (u32 bin = SAH_BINS - 1; bin > 0; --bin) {
+				rightBounds.Expand(binBounds[bin]);
+				rightCount += binCounts[bin];
+				rightCosts[bin - 1] = rightCount > 0 ? rightBounds.GetSurfaceArea() * rightCount : 0.0f;
+			}
+
+			f32  bestCost = std::numeric_limits<f32>::max();
+			u32  bestBin = 0;
+			AABB leftBounds{};
+			u32  leftCount = 0;
+			for (u32 bin = 0; bin < SAH_BINS - 1; ++bin) {
+				leftBounds.Expand(binBounds[bin]);
+				leftCount += binCounts[bin];
+				f32 const cost = (leftCount > 0 ? leftBounds.GetSurfaceArea() * leftCount : 0.0f) + rightCosts[bin];
+				if (leftCount > 0 && leftCount < end - begin && cost < bestCost) {
+					bestCost = cost;
+					bestBin = bin;
+				}
+			}
+
+			if (bestCost < std::numeric_limits<f32>::max()) {
+				auto const midIt = std::partition(objects.begin() + begin, objects.begin() + end,
+				                                  [&](BuildObject const& object) { return getBin(object) <= bestBin; });
+				mid = static_cast<u32>(midIt - objects.begin());
+			}
+		}
+
+		// All the centroids in the same place, or in the same bin
+		if (mid == begin || mid == end) {
+			mid = begin + (end - begin) / 2;
+			std::nth_element(objects.begin() + begin, objects.begin() + mid, objects.begin() + end,
+			                 [axis](BuildObject const& a, BuildObject const& b) {
+				                 return a.m_Centroid[axis] < b.m_Centroid[axis];
+			                 });
+		}
+
+		BuildNode(objects, begin, mid, depth + 1);
+		u32 const rightChild = BuildNode(objects, mid, end, depth + 1);
+		m_Nodes[nodeIdx].m_RightChild = rightChild;
+		return nodeIdx;
+	}
+
+	void CullingBVH::Refit() {
+		// Children are always after their parent, so walking backwards refits them first
+		f32 surfaceArea = 0.0f;
+		for (u64 i = m_Nodes.size(); i-- > 0;) {
+			Node& node = m_Nodes[i];
+			AABB  bounds{};
+			if (node.m_RightChild == 0) {
+				for (u32 j = 0; j < node.m_NumObjects; ++j) {
+					bounds.Expand(m_ObjectBounds[m_NodeObjects[node.m_FirstObject + j]]);
+				}
+			}
+			else {
+				bounds = m_Nodes[i + 1].m_Bounds;
+				bounds.Expand(m_Nodes[node.m_RightChild].m_Bounds);
+			}
+			node.m_Bounds = bounds;
+			surfaceArea += bounds.GetSurfaceArea();
+		}
+
+		if (surfaceArea > m_BuildSurfaceArea * REBUILD_SURFACE_AREA_RATIO) { Build(); }
+	}
+}
@@ -0,0 +1,128 @@
+#include "RenderScene/DrawList.h"
+#include "RenderScene/RenderSceneManager.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <utility>
+
+namespace CKE {
+	DrawList::DrawList() {
+		GetMeshSlot(TResourceID<MeshResource>{});
+		GetMaterialSlot(TResourceID<RenderMaterialResource>{});
+	}
+
+	u16 DrawList::GetMeshSlot(TResourceID<MeshResource> meshID) {
+		auto const [it, inserted] = m_MeshSlots.try_emplace(meshID.GetU64(), static_cast<u16>(m_Meshes.size()));
+		if (inserted) {
+			CKE_ASSERT(m_Meshes.size() < (1u << DrawSortKey::MESH_BITS));
+			m_Meshes.push_back(meshID);
+		}
+		return it->second;
+	}
+
+	u16 DrawList::GetMaterialSlot(TResourceID<RenderMaterialResource> materialID) {
+		auto const [it, inserted] = m_MaterialSlots.try_emplace(materialID.GetU64(),
+		                                                        static_cast<u16>(m_Materials.size()));
+		if (inserted) {
+			CKE_ASSERT(m_Materials.size() < (1u << DrawSortKey::MATERIAL_BITS));
+			m_Materials.push_back(materialID);
+		}
+		return it->second;
+	}
+
+	//-----------------------------------------------------------------------------
+
+	void DrawList::Build(Vector<RenderObjectData> const& objects, Vector<u32> const& visibleObjects,
+	                     CullingBVH const& objectBounds, Vec3 viewPosition) {
+		m_Packets.resize(visibleObjects.size());
+		for (u64 i = 0; i < visibleObjects.size(); ++i) {
+			u32 const               objectIdx = visibleObjects[i];
+			RenderObjectData const& object = objects[objectIdx];
+			Vec3 const              toObject = objectBounds.GetObjectBounds(objectIdx).GetCenter() - viewPosition;
+
+			m_Packets[i].m_SortKey = DrawSortKey::Make(object.m_Pipeline, object.m_MaterialSlot, object.m_MeshSlot,
+			                                           object.m_LODIndex, glm::dot(toObject, toObject));
+			m_Packets[i].m_ObjectIdx = objectIdx;
+		}
+
+		SortPackets(m_Packets, m_SortScratch);
+		BuildBatches();
+	}
+
+	void DrawList::SortPackets(Vector<DrawPacket>& packets, Vector<DrawPacket>& scratch) {
+		constexpr u32 RADIX_BITS = 8;
+		constexpr u32 NUM_BUCKETS = 1 << RADIX_BITS;
+		constexpr u32 NUM_DIGITS = 64 / RADIX_BITS;
+
+		u64 const count = packets.size();
+		if (count < 2) { return; }
+
+		// Digits where all the keys have the same value would not move anything, find them first
+		// so they are not counted or sorted
+		u64 const firstKey = packets[0].m_SortKey;
+		u64       differentBits = 0;
+		for (DrawPacket const& packet : packets) { differentBits |= packet.m_SortKey ^ firstKey; }
+
+		u32 digits[NUM_DIGITS];
+		u32 numDigits = 0;
+		for (u32 digit = 0; digit < NUM_DIGITS; ++digit) {
+			if ((differentBits >> (digit * RADIX_BITS)) & (NUM_BUCKETS - 1)) { digits[numDigits++] = digit; }
+		}
+		if (numDigits == 0) { return; }
+
+		// Histograms of the remaining digits in a single read of the keys
+		Vector<u32> histograms(numDigits * NUM_BUCKETS, 0);
+		for (DrawPacket const& packet : packets) {
+			for (u32 i = 0; i < numDigits; ++i) {
+				++histograms[i * NUM_BUCKETS + ((packet.m_SortKey >> (digits[i] * RADIX_BITS)) & (NUM_BUCKETS - 1))];
+			}
+		}
+
+		scratch.resize(count);
+		DrawPacket* pSrc = packets.data();
+		DrawPacket* pDst = scratch.data();
+		for (u32 i = 0; i < numDigits; ++i) {
+			u32* pHistogram = histograms.data() + i * NUM_BUCKETS;
+			u32  offset = 0;
+			for (u32 bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+				u32 const bucketCount = pHistogram[bucket];
+				pHistogram[bucket] = offset;
+				offset += bucketCount;
+			}
+
+			u32 const shift = digits[i] * RADIX_BITS;
+			for (u64 j = 0; j < count; ++j) {
+				u32 const bucket = (pSrc[j].m_SortKey >> shift) & (NUM_BUCKETS - 1);
+				pDst[pHistogram[bucket]++] = pSrc[j];
+			}
+			std::swap(pSrc, pDst);
+		}
+
+		if (pSrc != packets.data()) { packets.swap(scratch); }
+	}
+
+	void DrawList::BuildBatches() {
+		m_Batches.clear();
+		m_Instances.resize(m_Packets.size());
+
+		u64 batchBits = 0;
+		for (u32 i = 0; i < m_Packets.size(); ++i) {
+			u64 const key = m_Packets[i].m_SortKey;
+			m_Instances[i] = m_Packets[i].m_ObjectIdx;
+
+			if (!m_Batches.empty() && DrawSortKey::GetBatchBits(key) == batchBits) {
+				++m_Batches.back().m_InstanceCount;
+				continue;
+			}
+
+			batchBits = DrawSortKey::GetBatchBits(key);
+			m_Batches.push_back(DrawBatch{
+				m_Meshes[DrawSortKey::GetMeshSlot(key)],
+				m_Materials[DrawSortKey::GetMaterialSlot(key)],
+				DrawSortKey::GetLODIndex(key),
+				i, 1,
+				DrawSortKey::GetPipeline(key),
+			});
+		}
+	}
+}
@@ -0,0 +1,203 @@
+#include "RenderScene/LightClusters.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+#include "CookieKat/Systems/TaskSystem/TaskSystem.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <xmmintrin.h>
+
+namespace CKE {
+	namespace {
+		// Tiles of a row tested against a light at once
+		constexpr u32 SIMD_WIDTH = 4;
+
+		// Distance from a coordinate to a range along one axis, 0 inside of it
+		inline f32 AxisDistance(f32 value, f32 min, f32 max) {
+			return std::max(std::max(min - value, value - max), 0.0f);
+		}
+
+		void RunParallel(TaskSystem* pTaskSystem, u64 count, Func<void(u64 begin, u64 end)> const& function) {
+			if (pTaskSystem == nullptr) {
+				function(0, count);
+				return;
+			}
+			pTaskSystem->Wait(pTaskSystem->ParallelFor(count, function));
+		}
+	}
+
+	void LightClusterBuilder::SetGrid(LightGridDesc const& desc, Mat4 const& proj) {
+		if (!m_SliceDepths.empty() && desc == m_Desc && proj == m_Proj) { return; }
+
+		CKE_ASSERT(desc.m_TilesX > 0 && desc.m_TilesY > 0 && desc.m_NumSlices > 0);
+		CKE_ASSERT(desc.m_Near > 0.0f && desc.m_Far > desc.m_Near);
+		m_Desc = desc;
+		m_Proj = proj;
+		m_PaddedTilesX = (desc.m_TilesX + SIMD_WIDTH - 1) / SIMD_WIDTH * SIMD_WIDTH;
+
+		u32 const numSlices = desc.m_NumSlices;
+		m_SliceDepths.resize(numSlices + 1);
+		for (u32 slice = 0; slice <= numSlices; ++slice) {
+			m_SliceDepths[slice] = desc.m_Near * std::pow(desc.m_Far / desc.m_Near,
+			                                              static_cast<f32>(slice) / numSlices);
+		}
+		m_SliceDepths[0] = 0.0f;
+		m_SliceDepths[numSlices] = desc.m_Far;
+
+		// A point at depth d on the edge between tiles is at d * slope, the slope comes from the
+		// NDC coordinate of the edge. Padding tiles are too far away to touch any light.
+		auto const edgeSlope = [](u32 edge, u32 numTiles, f32 scale, f32 offset) {
+			f32 const ndc = -1.0f + 2.0f * static_cast<f32>(edge) / numTiles;
+			return (ndc + offset) / scale;
+		};
+		m_TileMinX.assign(numSlices * m_PaddedTilesX, std::numeric_limits<f32>::max());
+		m_TileMaxX.assign(numSlices * m_PaddedTilesX, std::numeric_limits<f32>::max());
+		m_TileMinY.resize(numSlices * desc.m_TilesY);
+		m_TileMaxY.resize(numSlices * desc.m_TilesY);
+		m_SliceMinZ.resize(numSlices);
+		m_SliceMaxZ.resize(numSlices);
+
+		for (u32 slice = 0; slice < numSlices; ++slice) {
+			f32 const nearDepth = m_SliceDepths[slice];
+			f32 const farDepth = m_SliceDepths[slice + 1];
+			m_SliceMinZ[slice] = -farDepth;
+			m_SliceMaxZ[slice] = -nearDepth;
+
+			for (u32 x = 0; x < desc.m_TilesX; ++x) {
+				f32 const a = edgeSlope(x, desc.m_TilesX, proj[0][0], proj[2][0]);
+				f32 const b = edgeSlope(x + 1, desc.m_TilesX, proj[0][0], proj[2][0]);
+				m_TileMinX[slice * m_PaddedTilesX + x] = std::min({a * nearDepth, a * farDepth, b * nearDepth, b * farDepth});
+				m_TileMaxX[slice * m_PaddedTilesX + x] = std::max({a * nearDepth, a * farDepth, b * nearDepth, b * farDepth});
+			}
+			// The projection can flip y, the min and max of the corners are right either way
+			for (u32 y = 0; y < desc.m_TilesY; ++y) {
+				f32 const a = edgeSlope(y, desc.m_TilesY, proj[1][1], proj[2][1]);
+				f32 const b = edgeSlope(y + 1, desc.m_TilesY, proj[1][1], proj[2][1]);
+				m_TileMinY[slice * desc.m_TilesY + y] = std::min({a * nearDepth, a * farDepth, b * nearDepth, b * farDepth});
+				m_TileMaxY[slice * desc.m_TilesY + y] = std::max({a * nearDepth, a * farDepth, b * nearDepth, b * farDepth});
+			}
+		}
+
+		u32 const numClusters = desc.m_TilesX * desc.m_TilesY * numSlices;
+		m_Clusters.assign(numClusters, LightClusterGPU{0, 0});
+		m_ClusterLights.resize(numClusters);
+		m_SliceLights.resize(numSlices);
+		m_LightIndices.clear();
+	}
+
+	void LightClusterBuilder::Build(Vector<PointLightGPU> const& lights, TaskSystem* pTaskSystem) {
+		CKE_ASSERT(!m_SliceDepths.empty()); // SetGrid must be called before building
+
+		// Bin the lights in the slices their spheres reach, searching the slice depths gives the
+		// candidates and the test against the depth range of the slice decides
+		u32 const numSlices = m_Desc.m_NumSlices;
+		auto const findSlice = [this, numSlices](f32 depth) {
+			auto const it = std::upper_bound(m_SliceDepths.begin(), m_SliceDepths.end(), depth);
+			i32 const  slice = static_cast<i32>(it - m_SliceDepths.begin()) - 1;
+			return static_cast<u32>(std::clamp(slice, 0, static_cast<i32>(numSlices) - 1));
+		};
+
+		for (Vector<u32>& sliceLights : m_SliceLights) { sliceLights.clear(); }
+		for (u32 lightIdx = 0; lightIdx < lights.size(); ++lightIdx) {
+			Vec4 const sphere = lights[lightIdx].m_ViewSpacePosition;
+			f32 const  radiusSq = sphere.w * sphere.w;
+			u32 const  first = findSlice(-sphere.z - sphere.w);
+			u32 const  last = findSlice(-sphere.z + sphere.w);
+
+			for (u32 slice = first > 0 ? first - 1 : 0; slice <= std::min(last + 1, numSlices - 1); ++slice) {
+				f32 const dz = AxisDistance(sphere.z, m_SliceMinZ[slice], m_SliceMaxZ[slice]);
+				if (dz * dz <= radiusSq) { m_SliceLights[slice].push_back(lightIdx); }
+			}
+		}
+
+		// Each row of clusters only writes to its own lists
+		u32 const numRows = numSlices * m_Desc.m_TilesY;
+		RunParallel(pTaskSystem, numRows, [this, &lights](u64 begin, u64 end) {
+			for (u64 row = begin; row < end; ++row) { AssignRow(static_cast<u32>(row), lights); }
+		});
+
+		u32 numIndices = 0;
+		for (u32 clusterIdx = 0; clusterIdx < m_Clusters.size(); ++clusterIdx) {
+			u32 const numLights = static_cast<u32>(m_ClusterLights[clusterIdx].size());
+			m_Clusters[clusterIdx] = LightClusterGPU{numIndices, numLights};
+			numIndices += numLights;
+		}
+
+		m_LightIndices.resize(numIndices);
+		RunParallel(pTaskSystem, numRows, [this](u64 begin, u64 end) {
+			for (u64 clusterIdx = begin * m_Desc.m_TilesX; clusterIdx < end * m_Desc.m_TilesX; ++clusterIdx) {
+				Vector<u32> const& clusterLights = m_ClusterLights[clusterIdx];
+				std::copy(clusterLights.begin(), clusterLights.end(),
+				          m_LightIndices.begin() + m_Clusters[clusterIdx].m_FirstLight);
+			}
+		});
+	}
+
+	void LightClusterBuilder::AssignRow(u32 row, Vector<PointLightGPU> const& lights) {
+		u32 const slice = row / m_Desc.m_TilesY;
+		u32 const firstCluster = row * m_Desc.m_TilesX;
+		for (u32 x = 0; x < m_Desc.m_TilesX; ++x) { m_ClusterLights[firstCluster + x].clear(); }
+
+		f32 const  minY = m_TileMinY[row];
+		f32 const  maxY = m_TileMaxY[row];
+		f32 const  minZ = m_SliceMinZ[slice];
+		f32 const  maxZ = m_SliceMaxZ[slice];
+		f32 const* pMinX = m_TileMinX.data() + slice * m_PaddedTilesX;
+		f32 const* pMaxX = m_TileMaxX.data() + slice * m_PaddedTilesX;
+
+		for (u32 lightIdx : m_SliceLights[slice]) {
+			Vec4 const sphere = lights[lightIdx].m_ViewSpacePosition;
+			f32 const  radiusSq = sphere.w * sphere.w;
+			f32 const  dy = AxisDistance(sphere.y, minY, maxY);
+			f32 const  dz = AxisDistance(sphere.z, minZ, maxZ);
+
+			// Adding the x distance can't bring the sum back under the radius
+			f32 const dySq = dy * dy;
+			f32 const dzSq = dz * dz;
+			if (dySq + dzSq > radiusSq) { continue; }
+
+			// Squared distance to the closest point of each tile, summed as (dx² + dy²) + dz²
+			__m128 const center = _mm_set1_ps(sphere.x);
+			__m128 const dySqV = _mm_set1_ps(dySq);
+			__m128 const dzSqV = _mm_set1_ps(dzSq);
+			__m128 const radiusSqV = _mm_set1_ps(radiusSq);
+			__m128 const zero = _mm_setzero_ps();
+
+			for (u32 x = 0; x < m_PaddedTilesX; x += SIMD_WIDTH) {
+				__m128 const dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(pMinX + x), center),
+				                                        _mm_sub_ps(center, _mm_loadu_ps(pMaxX + x))), zero);
+				__m128 const distanceSq = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), dySqV), dzSqV);
+
+				u32 hits = static_cast<u32>(_mm_movemask_ps(_mm_cmple_ps(distanceSq, radiusSqV)));
+				while (hits != 0) {
+					m_ClusterLights[firstCluster + x + std::countr_zero(hits)].push_back(lightIdx);
+					hits &= hits - 1;
+				}
+			}
+		}
+	}
+
+	LightGridGPU LightClusterBuilder::GetGridGPU(u32 numLights) const {
+		f32 const scale = m_Desc.m_NumSlices / std::log(m_Desc.m_Far / m_Desc.m_Near);
+		f32 const bias = -std::log(m_Desc.m_Near) * scale;
+
+		LightGridGPU grid{};
+		grid.m_Size = UInt4{m_Desc.m_TilesX, m_Desc.m_TilesY, m_Desc.m_NumSlices, numLights};
+		grid.m_Slicing = Vec4{scale, bias, 0.0f, 0.0f};
+		return grid;
+	}
+
+	AABB LightClusterBuilder::GetClusterBounds(u32 clusterIdx) const {
+		CKE_ASSERT(clusterIdx < m_Clusters.size());
+		u32 const tileX = clusterIdx % m_Desc.m_TilesX;
+		u32 const row = clusterIdx / m_Desc.m_TilesX;
+		u32 const slice = row / m_Desc.m_TilesY;
+
+		AABB bounds{};
+		bounds.m_Min = Vec3{m_TileMinX[slice * m_PaddedTilesX + tileX], m_TileMinY[row], m_SliceMinZ[slice]};
+		bounds.m_Max = Vec3{m_TileMaxX[slice * m_PaddedTilesX + tileX], m_TileMaxY[row], m_SliceMaxZ[slice]};
+		return bounds;
+	}
+}
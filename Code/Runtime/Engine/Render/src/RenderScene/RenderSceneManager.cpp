@@ -2,58 +2,80 @@
 
 #include "CookieKat/Systems/ECS/EntityDatabase.h"
 #include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+#include "CookieKat/Systems/Resources/ResourceSystem.h"
+#include "CookieKat/Systems/MeshProcessing/MeshLOD.h"
 
 #include "CookieKat/Engine/Entities/Components/CameraComponent.h"
 #include "CookieKat/Engine/Entities/Components/LocalToWorldComponent.h"
 #include "CookieKat/Engine/Entities/Components/MeshComponent.h"
 #include "CookieKat/Engine/Entities/Components/PointLightComponent.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace CKE {
-	void RenderSceneManager::InitializeGPUBuffers(RenderDevice* pDevice) {
+	namespace {
+		// Per-frame data of all the frames in flight, a frame that needs more waits for the older ones
+		constexpr u64 UPLOAD_RING_SIZE = 32ull << 20;
+
+		// Bit of each frame in flight in the stale copy masks
+		static_assert(RenderSettings::MAX_FRAMES_IN_FLIGHT <= 8);
+		constexpr u8 ALL_FRAME_COPIES = static_cast<u8>((1u << RenderSettings::MAX_FRAMES_IN_FLIGHT) - 1);
+
+		// Smallest allocation of the per-frame data, empty ranges would bind the whole ring
+		constexpr u64 MIN_FRAME_DATA_SIZE = 16;
+	}
+
+	void RenderSceneManager::InitializeGPUBuffers(RenderDevice* pDevice, TaskSystem* pTaskSystem) {
 		m_pDevice = pDevice;
+		m_pTaskSystem = pTaskSystem;
 		m_Scene.m_ObjectData.resize(RenderSettings::MAX_OBJECTS);
+		m_Scene.m_Objects.resize(RenderSettings::MAX_OBJECTS);
+		m_IsObjectInWorld.resize(RenderSettings::MAX_OBJECTS, false);
+		m_StaleObjectCopies.resize(RenderSettings::MAX_OBJECTS, 0);
+		m_StaleEnvironmentCopies = ALL_FRAME_COPIES;
+
+		m_UploadRing.Initialize(pDevice, UPLOAD_RING_SIZE, BufferUsageFlags::Uniform | BufferUsageFlags::Storage,
+		                        "Scene Upload Ring");
 
 		BufferDesc objectDataBufferDesc{};
 		objectDataBufferDesc.m_DebugName = "Object Data Buffer";
-		objectDataBufferDesc.m_Usage = BufferUsageFlags::Storage | BufferUsageFlags::TransferDst;
+		objectDataBufferDesc.m_Usage = BufferUsageFlags::Storage;
 		objectDataBufferDesc.m_MemoryAccess = MemoryAccess::CPU_GPU_Coherent;
 		objectDataBufferDesc.m_DuplicationStrategy = DuplicationStrategy::PerFrameInFlight;
 		objectDataBufferDesc.m_SizeInBytes = sizeof(ObjectDataGPU) * RenderSettings::MAX_OBJECTS;
 		objectDataBufferDesc.m_StrideInBytes = sizeof(ObjectDataGPU);
 		m_ObjectDataBuffer = pDevice->CreateBuffer(objectDataBufferDesc);
 
-		BufferDesc viewDataBufferDesc{};
-		viewDataBufferDesc.m_DebugName = "View Buffer";
-		viewDataBufferDesc.m_Usage = BufferUsageFlags::Uniform | BufferUsageFlags::TransferDst;
-		viewDataBufferDesc.m_MemoryAccess = MemoryAccess::CPU_GPU_Coherent;
-		viewDataBufferDesc.m_DuplicationStrategy = DuplicationStrategy::PerFrameInFlight;
-		viewDataBufferDesc.m_SizeInBytes = sizeof(ViewDataGPU);
-		m_ViewBuffer = pDevice->CreateBuffer(viewDataBufferDesc);
-
-		BufferDesc lightDataBufferDesc{};
-		lightDataBufferDesc.m_DebugName = "Light Data Buffer";
-		lightDataBufferDesc.m_Usage = BufferUsageFlags::Uniform | BufferUsageFlags::TransferDst;
-		lightDataBufferDesc.m_MemoryAccess = MemoryAccess::CPU_GPU_Coherent;
-		lightDataBufferDesc.m_DuplicationStrategy = DuplicationStrategy::PerFrameInFlight;
-		lightDataBufferDesc.m_SizeInBytes = sizeof(LightsDataGPU);
-		m_LightsBuffer = pDevice->CreateBuffer(lightDataBufferDesc);
-
 		BufferDesc enviorementBufferDesc{};
 		enviorementBufferDesc.m_DebugName = "Enviorement Buffer";
-		enviorementBufferDesc.m_Usage = BufferUsageFlags::Uniform | BufferUsageFlags::TransferDst;
+		enviorementBufferDesc.m_Usage = BufferUsageFlags::Uniform;
 		enviorementBufferDesc.m_MemoryAccess = MemoryAccess::CPU_GPU_Coherent;
 		enviorementBufferDesc.m_DuplicationStrategy = DuplicationStrategy::PerFrameInFlight;
 		enviorementBufferDesc.m_SizeInBytes = sizeof(EnvironmentGPU);
 		m_EnviorementBuffer = m_pDevice->CreateBuffer(enviorementBufferDesc);
 	}
 
+	void RenderSceneManager::BeginFrame(FenceHandle frameFence) {
+		m_UploadRing.BeginFrame(frameFence);
+		m_FrameRowUploadBytes = 0;
+	}
+
+	void RenderSceneManager::EndFrame() {
+		m_UploadRing.EndFrame();
+	}
+
 	void RenderSceneManager::SetCameraMatrices(Mat4 view, Mat4 proj) {
 		m_Scene.m_ViewData.m_View = view;
 		m_Scene.m_ViewData.m_Proj = proj;
 		m_Scene.m_ViewData.m_ProjInv = glm::inverse(proj);
 		m_Scene.m_ViewData.m_ViewInv = glm::inverse(view);
 		m_Scene.m_ViewData.m_ViewProj = proj * view;
-		m_pDevice->UploadBufferData_DEPR(m_ViewBuffer, &m_Scene.m_ViewData, sizeof(ViewDataGPU), 0);
+		m_ViewBuffer = m_UploadRing.Upload(&m_Scene.m_ViewData, sizeof(ViewDataGPU)).GetRange();
+
+		// The draws and the light data of the frame are written for the new view
+		CullObjects();
+		BuildLightClusters();
 	}
 
 	void RenderSceneManager::SetRenderingViewSettings(RenderingSettings view) {
@@ -62,32 +84,12 @@ namespace CKE {
 
 	void RenderSceneManager::SetEnviorementData(EnvironmentGPU data) {
 		m_Scene.m_EnviorementData = data;
-		m_pDevice->UploadBufferData_DEPR(m_EnviorementBuffer, &m_Scene.m_EnviorementData,
-		                                 sizeof(EnvironmentGPU), 0);
+		m_StaleEnvironmentCopies = ALL_FRAME_COPIES;
 	}
 
 	void RenderSceneManager::CopySceneDataFromEntityWorld(RenderDevice*   pDevice,
-	                                                      EntityDatabase* pEntities) {
-		// Upload object data of all of the objects in the scene
-		//-----------------------------------------------------------------------------
-
-		int objCount = 0;
-		for (auto& [l2w, mesh] : pEntities->GetMultiCompTupleIter<
-			     LocalToWorldComponent, MeshComponent>()) {
-			ObjectDataGPU obj{};
-			obj.m_Local2World = l2w->m_LocalToWorld;
-			obj.m_NormalMat = glm::transpose(glm::inverse(l2w->m_LocalToWorld));
-			obj.m_AlbedoOverride = mesh->m_MaterialModifiers.m_Albedo;
-			obj.m_MetallicOverride = mesh->m_MaterialModifiers.m_MetalMask;
-			obj.m_RoughnessOverride = mesh->m_MaterialModifiers.m_Roughness;
-			obj.m_Reflectance = mesh->m_MaterialModifiers.m_Reflectance;
-			CKE_ASSERT(mesh->m_ObjectIdx - 1 >= 0 && mesh->m_ObjectIdx < RenderSettings::MAX_OBJECTS);
-			m_Scene.m_ObjectData[mesh->m_ObjectIdx - 1] = obj;
-			objCount++;
-		}
-		pDevice->UploadBufferData_DEPR(m_ObjectDataBuffer, m_Scene.m_ObjectData.data(),
-		                               objCount * sizeof(ObjectDataGPU), 0);
-
+	                                                      EntityDatabase* pEntities,
+	                                                      ResourceSystem* pResources) {
 		// Init Main Camera
 		//-----------------------------------------------------------------------------
 
@@ -101,31 +103,177 @@ namespace CKE {
 			m_Scene.m_ViewData.m_ProjInv = glm::inverse(projFlipped);
 			m_Scene.m_ViewData.m_ViewInv = glm::inverse(view);
 			m_Scene.m_ViewData.m_ViewProj = projFlipped * view;
+		}
+		m_ViewBuffer = m_UploadRing.Upload(&m_Scene.m_ViewData, sizeof(ViewDataGPU)).GetRange();
+
+		// Upload the object data that changed since each copy was written
+		//-----------------------------------------------------------------------------
+
+		Vec3 const cameraPosition = Vec3{m_Scene.m_ViewData.m_ViewInv[3]};
+		f32 const  projectionScale = std::abs(m_Scene.m_ViewData.m_Proj[1][1]);
+		f32 const  viewportHeight = m_RenderingViewSettings.m_Viewport.m_Extent.y;
+
+		for (auto& [l2w, mesh] : pEntities->GetMultiCompTupleIter<
+			     LocalToWorldComponent, MeshComponent>()) {
+			CKE_ASSERT(mesh->m_ObjectIdx - 1 >= 0 && mesh->m_ObjectIdx < RenderSettings::MAX_OBJECTS);
+			u32 const objectIdx = static_cast<u32>(mesh->m_ObjectIdx - 1);
+
+			// Only the objects whose components were written since the last copy get a new row
+			if (l2w->m_Changed || mesh->m_Changed) {
+				ObjectDataGPU& obj = m_Scene.m_ObjectData[objectIdx];
+				obj.m_Local2World = l2w->m_LocalToWorld;
+				obj.m_NormalMat = glm::transpose(glm::inverse(l2w->m_LocalToWorld));
+				obj.m_AlbedoOverride = mesh->m_MaterialModifiers.m_Albedo;
+				obj.m_MetallicOverride = mesh->m_MaterialModifiers.m_MetalMask;
+				obj.m_RoughnessOverride = mesh->m_MaterialModifiers.m_Roughness;
+				obj.m_Reflectance = mesh->m_MaterialModifiers.m_Reflectance;
+				MarkObjectChanged(objectIdx);
+
+				l2w->m_Changed = false;
+				mesh->m_Changed = false;
+			}
+
+			// Select the LOD from the distance to the closest point of the bounding sphere
+			mesh->m_LODIndex = 0;
+			if (pResources->IsResourceLoaded(mesh->m_MeshID)) {
+				MeshResource const* pMesh = pResources->GetResource<MeshResource>(mesh->m_MeshID);
+				Mat4 const&         l2wMat = l2w->m_LocalToWorld;
 
-			pDevice->UploadBufferData_DEPR(m_ViewBuffer, &m_Scene.m_ViewData, sizeof(ViewDataGPU), 0);
+				f32 const scale = std::max(glm::length(Vec3{l2wMat[0]}),
+				                           std::max(glm::length(Vec3{l2wMat[1]}), glm::length(Vec3{l2wMat[2]})));
+				Vec3 const center = Vec3{l2wMat * Vec4{pMesh->GetBoundingSphereCenter(), 1.0f}};
+				f32 const  distance = glm::length(center - cameraPosition) - pMesh->GetBoundingSphereRadius() * scale;
+
+				mesh->m_LODIndex = MeshProcessing::SelectLOD(pMesh->GetLODs(), scale, distance,
+				                                             projectionScale, viewportHeight, m_LODMaxPixelError);
+
+				// Only meshes that can be drawn take part in culling
+				m_CullingBVH.SetObjectBounds(objectIdx, pMesh->GetBoundingBox().Transform(l2wMat));
+				m_IsObjectInWorld[objectIdx] = true;
+			}
+
+			// Only look up the draw list slots when the ids change
+			RenderObjectData& object = m_Scene.m_Objects[objectIdx];
+			if (object.m_MeshID != mesh->m_MeshID) {
+				object.m_MeshID = mesh->m_MeshID;
+				object.m_MeshSlot = m_Scene.m_DrawList.GetMeshSlot(mesh->m_MeshID);
+			}
+			if (object.m_MaterialID != mesh->m_MaterialID) {
+				object.m_MaterialID = mesh->m_MaterialID;
+				object.m_MaterialSlot = m_Scene.m_DrawList.GetMaterialSlot(mesh->m_MaterialID);
+			}
+			object.m_LODIndex = mesh->m_LODIndex;
+		}
+		WriteStaleData();
+
+		// Cull the objects against the camera and build the draw list
+		//-----------------------------------------------------------------------------
+
+		for (u32 i = 0; i < m_IsObjectInWorld.size(); ++i) {
+			if (!m_IsObjectInWorld[i]) { m_CullingBVH.RemoveObject(i); }
+			m_IsObjectInWorld[i] = false;
 		}
+		CullObjects();
 
-		// Collect and upload scene lights
+		// Collect scene lights and assign them to the clusters of the view
 		//-----------------------------------------------------------------------------
 
-		m_Scene.m_LightsData.m_Size.x = 0;
-		int idx = 0;
+		m_Scene.m_PointLights.clear();
 		for (auto pointLight : pEntities->GetSingleCompIter<PointLightComponent>()) {
-			m_Scene.m_LightsData.m_PointLights[idx].m_ViewSpacePosition = m_Scene.m_ViewData.m_View
-					* Vec4(
-						pointLight->m_Position, 1.0f);
-			m_Scene.m_LightsData.m_PointLights[idx].m_Radiance = Vec4(pointLight->m_Radiance, 0.0f);
-			m_Scene.m_LightsData.m_Size.x++;
-			idx++;
+			// The light stops reaching at the distance its irradiance falls under the cutoff
+			Vec3 const radiance = pointLight->m_Radiance;
+			f32 const  radius = std::sqrt(std::max(radiance.x, std::max(radiance.y, radiance.z)) / m_LightCutoff);
+
+			PointLightGPU light{};
+			light.m_ViewSpacePosition = Vec4{Vec3{m_Scene.m_ViewData.m_View * Vec4{pointLight->m_Position, 1.0f}}, radius};
+			light.m_Radiance = Vec4{radiance, 0.0f};
+			m_Scene.m_PointLights.push_back(light);
+		}
+		BuildLightClusters();
+	}
+
+	void RenderSceneManager::CullObjects() {
+		m_CullingBVH.Update();
+		m_Scene.m_VisibleObjects.clear();
+		m_CullingBVH.Cull(Frustum::FromViewProjection(m_Scene.m_ViewData.m_ViewProj), m_Scene.m_VisibleObjects);
+
+		m_Scene.m_DrawList.Build(m_Scene.m_Objects, m_Scene.m_VisibleObjects, m_CullingBVH,
+		                         Vec3{m_Scene.m_ViewData.m_ViewInv[3]});
+		Vector<u32> const&     instances = m_Scene.m_DrawList.GetInstances();
+		UploadAllocation const instanceData = AllocateFrameData(sizeof(u32) * instances.size());
+		if (instanceData.IsValid() && !instances.empty()) {
+			std::memcpy(instanceData.m_pData, instances.data(), sizeof(u32) * instances.size());
+		}
+		m_InstanceBuffer = instanceData.GetRange();
+	}
+
+	void RenderSceneManager::BuildLightClusters() {
+		LightClusterBuilder&         clusters = m_Scene.m_LightClusters;
+		Vector<PointLightGPU> const& lights = m_Scene.m_PointLights;
+		clusters.SetGrid(m_LightGrid, m_Scene.m_ViewData.m_Proj);
+		clusters.Build(lights, m_pTaskSystem);
+
+		Vector<LightClusterGPU> const& clusterRanges = clusters.GetClusters();
+		Vector<u32> const&             lightIndices = clusters.GetLightIndices();
+		u64 const                      lightsSize = sizeof(PointLightGPU) * lights.size();
+		u64 const                      rangesSize = sizeof(LightClusterGPU) * clusterRanges.size();
+		u64 const                      indicesSize = sizeof(u32) * lightIndices.size();
+
+		UploadAllocation const lightsData = AllocateFrameData(sizeof(LightGridGPU) + lightsSize);
+		if (lightsData.IsValid()) {
+			LightGridGPU const grid = clusters.GetGridGPU(static_cast<u32>(lights.size()));
+			u8* const          pData = static_cast<u8*>(lightsData.m_pData);
+			std::memcpy(pData, &grid, sizeof(LightGridGPU));
+			if (!lights.empty()) { std::memcpy(pData + sizeof(LightGridGPU), lights.data(), lightsSize); }
+		}
+		m_LightsBuffer = lightsData.GetRange();
+
+		UploadAllocation const clustersData = AllocateFrameData(rangesSize + indicesSize);
+		if (clustersData.IsValid()) {
+			u8* const pData = static_cast<u8*>(clustersData.m_pData);
+			std::memcpy(pData, clusterRanges.data(), rangesSize);
+			if (!lightIndices.empty()) { std::memcpy(pData + rangesSize, lightIndices.data(), indicesSize); }
+		}
+		m_LightClustersBuffer = clustersData.GetRange();
+	}
+
+	UploadAllocation RenderSceneManager::AllocateFrameData(u64 sizeInBytes) {
+		return m_UploadRing.Allocate(std::max(sizeInBytes, MIN_FRAME_DATA_SIZE));
+	}
+
+	void RenderSceneManager::MarkObjectChanged(u32 objectIdx) {
+		if (m_StaleObjectCopies[objectIdx] == 0) { m_StaleObjects.push_back(objectIdx); }
+		m_StaleObjectCopies[objectIdx] = ALL_FRAME_COPIES;
+	}
+
+	void RenderSceneManager::WriteStaleData() {
+		// The copies of the current frame are not in use by the GPU
+		u8 const frameCopy = static_cast<u8>(1u << m_pDevice->GetFrameIdx());
+
+		ObjectDataGPU* pObjectData = static_cast<ObjectDataGPU*>(m_pDevice->GetBufferMappedPtr(m_ObjectDataBuffer));
+		u64            numStillStale = 0;
+		for (u32 const objectIdx : m_StaleObjects) {
+			u8& staleCopies = m_StaleObjectCopies[objectIdx];
+			if ((staleCopies & frameCopy) != 0) {
+				pObjectData[objectIdx] = m_Scene.m_ObjectData[objectIdx];
+				m_FrameRowUploadBytes += sizeof(ObjectDataGPU);
+				staleCopies &= ~frameCopy;
+			}
+			if (staleCopies != 0) { m_StaleObjects[numStillStale++] = objectIdx; }
+		}
+		m_StaleObjects.resize(numStillStale);
+
+		if ((m_StaleEnvironmentCopies & frameCopy) != 0) {
+			std::memcpy(m_pDevice->GetBufferMappedPtr(m_EnviorementBuffer), &m_Scene.m_EnviorementData,
+			            sizeof(EnvironmentGPU));
+			m_FrameRowUploadBytes += sizeof(EnvironmentGPU);
+			m_StaleEnvironmentCopies &= ~frameCopy;
 		}
-		pDevice->UploadBufferData_DEPR(m_LightsBuffer, &m_Scene.m_LightsData,
-		                               sizeof(Vec4) + sizeof(PointLightGPU) * idx, 0);
 	}
 
 	void RenderSceneManager::CleanupGPUBuffers(RenderDevice* pDevice) {
-		pDevice->DestroyBuffer(m_LightsBuffer);
+		m_UploadRing.Shutdown();
 		pDevice->DestroyBuffer(m_ObjectDataBuffer);
-		pDevice->DestroyBuffer(m_ViewBuffer);
 		pDevice->DestroyBuffer(m_EnviorementBuffer);
 	}
 } // namespace CKE
@@ -2,6 +2,7 @@
 
 #include "CookieKat/Core/Math/Math.h"
 #include "CookieKat/Core/Profilling/Profilling.h"
+#include "CookieKat/Core/Metrics/MetricsRegistry.h"
 
 #include "CookieKat/Systems/Resources/ResourceSystem.h"
 #include "CookieKat/Systems/EngineSystem/SystemsRegistry.h"
@@ -12,7 +13,6 @@
 #include "CookieKat/Engine/Entities/Components/MeshComponent.h"
 
 #include "CookieKat/Engine/Render/Common/GlobalRenderAssets.h"
-#include "CookieKat/Systems/RenderUtils/SphericalHarmonicsUtils.h"
 
 #include "CookieKat/Engine/Render/RenderPasses/SharedIDs.h"
 #include "CookieKat/Engine/Render/RenderPasses/RenderPassInitCtx.h"
@@ -105,7 +105,7 @@ namespace CKE {
 		GlobalRenderAssets::Initialize(m_Device);
 
 		LoadDefaultPipelines(&m_PipelineManager);
-		m_RenderSceneManager.InitializeGPUBuffers(&m_Device);
+		m_RenderSceneManager.InitializeGPUBuffers(&m_Device, m_pTaskSystem);
 
 		// TEMP: SkyBox testing
 		//-----------------------------------------------------------------------------
@@ -116,11 +116,9 @@ namespace CKE {
 			auto cubeMap = m_pResources->GetResource<RenderCubeMapResource>(cubeMapID);
 			skyboxView = cubeMap->GetTextureView();
 
-			Vec3 envSHCoeffs[9];
-			SphericalHarmonicsUtils::SHProjectCubeMap(envSHCoeffs, cubeMap->GetFaces(), cubeMap->GetFaceSize());
 			EnvironmentGPU e{};
 			for (int i = 0; i < 9; ++i) {
-				e.m_EnvSH.m_Coeffs[i] = Vec4{envSHCoeffs[i], 0.0f};
+				e.m_EnvSH.m_Coeffs[i] = Vec4{cubeMap->GetSHCoefficient(i), 0.0f};
 				for (Vec4& coeff : e.m_TestSH[i].m_Coeffs) {
 					coeff = Vec4{1.0f};
 				}
@@ -133,7 +131,7 @@ namespace CKE {
 
 		RenderPassInitCtx initCtx{
 			&m_Device, &m_SamplerCache, m_pResources, m_pEntitySystem->GetEntityDatabase(),
-			&m_RenderSceneManager.m_RenderingViewSettings, &m_PipelineManager
+			&m_RenderSceneManager.m_RenderingViewSettings, &m_PipelineManager, &m_RenderSceneManager
 		};
 		m_DepthPass = CKE::New<DepthPrePass>();
 		m_DepthPass->Initialize(&initCtx);
@@ -159,9 +157,9 @@ namespace CKE {
 		// Setup FrameGraph
 		//-----------------------------------------------------------------------------
 
-		m_FrameGraph.Initialize(&m_Device);
-		m_FrameGraph.AddGraphicsPass(m_DepthPass);
-		m_FrameGraph.AddGraphicsPass(m_GBufferPass);
+		m_FrameGraph.Initialize(&m_Device, m_pTaskSystem);
+		m_FrameGraph.AddParallelGraphicsPass(m_DepthPass);
+		m_FrameGraph.AddParallelGraphicsPass(m_GBufferPass);
 		m_FrameGraph.AddGraphicsPass(m_SSAOPass);
 		m_FrameGraph.AddGraphicsPass(m_SSAOBlurPass);
 		m_FrameGraph.AddGraphicsPass(m_LightingPass);
@@ -185,8 +183,10 @@ namespace CKE {
 		swapChainDesc.m_LoadOp = LoadOp::DontCare;
 		m_FrameGraph.ImportTexture(swapChainDesc);
 		m_FrameGraph.ImportBuffer(SceneGlobal::ObjectData, m_RenderSceneManager.m_ObjectDataBuffer);
-		m_FrameGraph.ImportBuffer(SceneGlobal::View, m_RenderSceneManager.m_ViewBuffer);
-		m_FrameGraph.ImportBuffer(SceneGlobal::Lights, m_RenderSceneManager.m_LightsBuffer);
+		m_FrameGraph.ImportBuffer(SceneGlobal::InstanceData, BufferRange{});
+		m_FrameGraph.ImportBuffer(SceneGlobal::View, BufferRange{});
+		m_FrameGraph.ImportBuffer(SceneGlobal::Lights, BufferRange{});
+		m_FrameGraph.ImportBuffer(SceneGlobal::LightClusters, BufferRange{});
 		m_FrameGraph.ImportBuffer(SceneGlobal::EnviorementData, m_RenderSceneManager.m_EnviorementBuffer);
 
 		m_FrameGraph.Compile(m_Device.GetBackBufferSize());
@@ -196,13 +196,21 @@ namespace CKE {
 		CKE_PROFILE_EVENT();
 
 		m_Device.AcquireNextBackBuffer();
+		m_TextureUploadQueue.Update(); // Records into the transfer command lists of the frame
+		m_RenderSceneManager.BeginFrame(m_Device.GetInFlightFence());
 
 		// Update rendering buffers and config
-		m_RenderSceneManager.CopySceneDataFromEntityWorld(&m_Device, m_pEntitySystem->GetEntityDatabase());
 		m_RenderSceneManager.SetRenderingViewSettings(RenderingSettings{
 			m_Device.GetBackBufferSize(),
 			ViewportData{Vec2{0.0f}, m_Device.GetBackBufferSize()}
 		});
+		m_RenderSceneManager.CopySceneDataFromEntityWorld(&m_Device, m_pEntitySystem->GetEntityDatabase(), m_pResources);
+
+		// The per-frame data is written to a new range of the upload ring every frame
+		m_FrameGraph.ImportBuffer(SceneGlobal::InstanceData, m_RenderSceneManager.m_InstanceBuffer);
+		m_FrameGraph.ImportBuffer(SceneGlobal::View, m_RenderSceneManager.m_ViewBuffer);
+		m_FrameGraph.ImportBuffer(SceneGlobal::Lights, m_RenderSceneManager.m_LightsBuffer);
+		m_FrameGraph.ImportBuffer(SceneGlobal::LightClusters, m_RenderSceneManager.m_LightClustersBuffer);
 
 		// Update BackBuffer texture reference and execute the FrameGraph
 		m_FrameGraph.UpdateImportedTexture(GetBackBufferImportedDesc(&m_Device));
@@ -210,6 +218,7 @@ namespace CKE {
 			{m_Device.GetImageAvailableSemaphore(), PipelineStage::ColorAttachmentOutput},
 			m_Device.GetRenderFinishedSemaphore(),
 			m_Device.GetInFlightFence());
+		m_RenderSceneManager.EndFrame();
 
 		m_Device.Present();
 
@@ -223,11 +232,30 @@ namespace CKE {
 
 	void RenderingSystem::Shutdown() {
 		m_Device.WaitForDevice();
+		m_TextureUploadQueue.Shutdown();
 		m_FrameGraph.Shutdown();
 		m_RenderSceneManager.CleanupGPUBuffers(&m_Device);
 		GlobalRenderAssets::Shutdown(m_Device);
 	}
 
+	void RenderingSystem::RecordMetrics(MetricsRegistry& metrics) {
+		metrics.GetHistogram("Render.UploadBytes").Record(m_RenderSceneManager.GetFrameUploadBytes());
+		metrics.GetGauge("Render.UploadRingUsedBytes").Set(
+			static_cast<f64>(m_RenderSceneManager.m_UploadRing.GetAllocator().GetUsedBytes()));
+
+		TextureUploadStats const& textureStats = m_TextureUploadQueue.GetStats();
+		metrics.GetHistogram("Textures.UploadBytes").Record(textureStats.m_FrameUploadBytes);
+		metrics.GetHistogram("Textures.UploadStallNs").Record(textureStats.m_FrameStallNs);
+		metrics.GetGauge("Textures.PendingUploads").Set(static_cast<f64>(textureStats.m_NumPendingUploads));
+
+		// The device keeps totals, the counters only get what this frame added
+		DescriptorSetCacheStats const setStats = m_Device.GetDescriptorSetCacheStats();
+		metrics.GetCounter("DescriptorSets.CacheHits").Add(setStats.m_Hits - m_LastDescriptorSetStats.m_Hits);
+		metrics.GetCounter("DescriptorSets.CacheMisses").Add(setStats.m_Misses - m_LastDescriptorSetStats.m_Misses);
+		metrics.GetCounter("DescriptorSets.CacheEvictions").Add(setStats.m_Evictions - m_LastDescriptorSetStats.m_Evictions);
+		m_LastDescriptorSetStats = setStats;
+	}
+
 	void RenderingSystem::RecordRenderTargetResizeEvent(Int2 newSize) {
 		m_Device.RecordBackBufferResized(newSize);
 		m_TriggerBackBufferResize = true;
@@ -239,5 +267,6 @@ namespace CKE {
 
 	void RenderingSystem::InitializeDevice() {
 		m_Device.Initialize(Int2(1280, 720));
+		m_TextureUploadQueue.Initialize(&m_Device);
 	}
 }
@@ -0,0 +1,505 @@
+#include "CookieKat/Engine/Render/RenderScene/CullingBVH.h"
+#include "CookieKat/Engine/Render/RenderScene/LightClusters.h"
+#include "CookieKat/Engine/Render/RenderScene/RenderSceneManager.h"
+#include "CookieKat/Systems/TaskSystem/TaskSystem.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace CKE;
+
+//-----------------------------------------------------------------------------
+
+namespace {
+	// Unit cubes scattered in a box of the given size, like the stress test world
+	Vector<AABB> CreateSyntheticScene(u32 numObjects, f32 worldSize, u32 seed) {
+		std::mt19937                   random{seed};
+		std::uniform_real_distribution position{-worldSize, worldSize};
+		std::uniform_real_distribution scale{0.25f, 2.0f};
+
+		Vector<AABB> objects(numObjects);
+		AABB const   unitCube{Vec3{-0.5f}, Vec3{0.5f}};
+		for (AABB& object : objects) {
+			Mat4 const l2w = glm::scale(glm::translate(Mat4{1.0f}, Vec3{position(random), position(random), position(random)}),
+			                            Vec3{scale(random)});
+			object = unitCube.Transform(l2w);
+		}
+		return objects;
+	}
+
+	Frustum CreateCameraFrustum(Vec3 position, Vec3 target) {
+		Mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+		proj[1][1] *= -1;
+		return Frustum::FromViewProjection(proj * glm::lookAt(position, target, Vec3{0.0f, 1.0f, 0.0f}));
+	}
+
+	Vector<u32> CullBruteForce(Vector<AABB> const& objects, Frustum const& frustum) {
+		Vector<u32> visible{};
+		for (u32 i = 0; i < objects.size(); ++i) {
+			if (frustum.IsVisible(objects[i])) { visible.push_back(i); }
+		}
+		return visible;
+	}
+
+	Vector<u32> CullSorted(CullingBVH const& bvh, Frustum const& frustum) {
+		Vector<u32> visible{};
+		bvh.Cull(frustum, visible);
+		std::sort(visible.begin(), visible.end());
+		return visible;
+	}
+}
+
+TEST(Bounds, Frustum_Test) {
+	Frustum const frustum = CreateCameraFrustum(Vec3{0.0f}, Vec3{0.0f, 0.0f, -1.0f});
+
+	EXPECT_EQ(frustum.Test(AABB{Vec3{-1.0f, -1.0f, -11.0f}, Vec3{1.0f, 1.0f, -9.0f}}), FrustumTest::Inside);
+	EXPECT_EQ(frustum.Test(AABB{Vec3{-1.0f, -1.0f, 9.0f}, Vec3{1.0f, 1.0f, 11.0f}}), FrustumTest::Outside);
+	EXPECT_EQ(frustum.Test(AABB{Vec3{-1.0f, -1.0f, -1000.0f}, Vec3{1.0f, 1.0f, -10.0f}}), FrustumTest::Intersecting);
+	EXPECT_EQ(frustum.Test(AABB{Vec3{-1.0f, 100.0f, -11.0f}, Vec3{1.0f, 102.0f, -9.0f}}), FrustumTest::Outside);
+}
+
+TEST(Bounds, AABB_Transform) {
+	AABB const box{Vec3{-1.0f, -2.0f, -3.0f}, Vec3{1.0f, 2.0f, 3.0f}};
+	Mat4 const l2w = glm::rotate(glm::translate(Mat4{1.0f}, Vec3{10.0f, 0.0f, 0.0f}), glm::radians(90.0f),
+	                             Vec3{0.0f, 1.0f, 0.0f});
+
+	AABB const world = box.Transform(l2w);
+	EXPECT_NEAR(world.m_Min.x, 7.0f, 1e-4f);
+	EXPECT_NEAR(world.m_Max.x, 13.0f, 1e-4f);
+	EXPECT_NEAR(world.m_Min.y, -2.0f, 1e-4f);
+	EXPECT_NEAR(world.m_Max.z, 1.0f, 1e-4f);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST(CullingBVH, Matches_Brute_Force) {
+	Vector<AABB> const objects = CreateSyntheticScene(10'000, 200.0f, 1);
+
+	CullingBVH bvh{};
+	for (u32 i = 0; i < objects.size(); ++i) { bvh.SetObjectBounds(i, objects[i]); }
+	bvh.Update();
+	EXPECT_EQ(bvh.GetNumObjects(), objects.size());
+
+	std::mt19937                   random{2};
+	std::uniform_real_distribution position{-250.0f, 250.0f};
+	for (u32 view = 0; view < 20; ++view) {
+		Frustum const frustum = CreateCameraFrustum(Vec3{position(random), position(random), position(random)},
+		                                            Vec3{position(random), position(random), position(random)});
+		EXPECT_EQ(CullSorted(bvh, frustum), CullBruteForce(objects, frustum)) << view;
+	}
+}
+
+TEST(CullingBVH, Refit_And_Rebuild) {
+	Vector<AABB> objects = CreateSyntheticScene(1'000, 50.0f, 3);
+
+	CullingBVH bvh{};
+	for (u32 i = 0; i < objects.size(); ++i) { bvh.SetObjectBounds(i, objects[i]); }
+	bvh.Update();
+	EXPECT_EQ(bvh.GetNumRebuilds(), 1);
+
+	Frustum const frustum = CreateCameraFrustum(Vec3{0.0f, 0.0f, 80.0f}, Vec3{0.0f});
+
+	// Small movements are refits
+	for (u32 i = 0; i < objects.size(); i += 2) {
+		objects[i].m_Min += Vec3{0.5f};
+		objects[i].m_Max += Vec3{0.5f};
+		bvh.SetObjectBounds(i, objects[i]);
+	}
+	bvh.Update();
+	EXPECT_EQ(bvh.GetNumRebuilds(), 1);
+	EXPECT_EQ(CullSorted(bvh, frustum), CullBruteForce(objects, frustum));
+
+	// Removed objects are not returned
+	for (u32 i = 0; i < objects.size(); i += 3) {
+		bvh.RemoveObject(i);
+		objects[i] = AABB{Vec3{1e6f}, Vec3{1e6f}};
+	}
+	bvh.Update();
+	EXPECT_EQ(bvh.GetNumRebuilds(), 2);
+	EXPECT_EQ(CullSorted(bvh, frustum), CullBruteForce(objects, frustum));
+
+	// Shuffling every object makes the refitted tree too loose and it gets rebuilt
+	Vector<AABB> const shuffled = CreateSyntheticScene(1'000, 50.0f, 4);
+	for (u32 i = 0; i < objects.size(); ++i) {
+		if (!bvh.HasObject(i)) { continue; }
+		objects[i] = shuffled[i];
+		bvh.SetObjectBounds(i, objects[i]);
+	}
+	bvh.Update();
+	EXPECT_EQ(bvh.GetNumRebuilds(), 3);
+	EXPECT_EQ(CullSorted(bvh, frustum), CullBruteForce(objects, frustum));
+
+	bvh.Clear();
+	bvh.Update();
+	EXPECT_TRUE(CullSorted(bvh, frustum).empty());
+}
+
+//-----------------------------------------------------------------------------
+
+namespace {
+	// Objects of the synthetic scene drawn with a few meshes, materials and LODs
+	struct DrawListScene
+	{
+		Vector<RenderObjectData> m_Objects;
+		Vector<u32>              m_Visible;
+		CullingBVH               m_Bounds;
+		DrawList                 m_DrawList;
+	};
+
+	void CreateDrawListScene(DrawListScene& scene, u32 numObjects, u32 numMeshes, u32 numMaterials) {
+		Vector<AABB> const bounds = CreateSyntheticScene(numObjects, 300.0f, 6);
+		std::mt19937       random{7};
+
+		scene.m_Objects.resize(numObjects);
+		scene.m_Visible.resize(numObjects);
+		for (u32 i = 0; i < numObjects; ++i) {
+			RenderObjectData& object = scene.m_Objects[i];
+			object.m_MeshID.m_Value = 100 + random() % numMeshes;
+			object.m_MaterialID.m_Value = 200 + random() % numMaterials;
+			object.m_LODIndex = random() % 3;
+			object.m_MeshSlot = scene.m_DrawList.GetMeshSlot(object.m_MeshID);
+			object.m_MaterialSlot = scene.m_DrawList.GetMaterialSlot(object.m_MaterialID);
+			scene.m_Visible[i] = i;
+			scene.m_Bounds.SetObjectBounds(i, bounds[i]);
+		}
+	}
+}
+
+TEST(DrawList, Sort_Key) {
+	u64 const key = DrawSortKey::Make(DrawPipeline::Opaque, 3, 7, 2, 25.0f);
+	EXPECT_EQ(DrawSortKey::GetPipeline(key), DrawPipeline::Opaque);
+	EXPECT_EQ(DrawSortKey::GetMaterialSlot(key), 3);
+	EXPECT_EQ(DrawSortKey::GetMeshSlot(key), 7);
+	EXPECT_EQ(DrawSortKey::GetLODIndex(key), 2);
+
+	// State is more significant than depth, and closer objects go first
+	EXPECT_LT(DrawSortKey::Make(DrawPipeline::Opaque, 3, 7, 2, 1000.0f), DrawSortKey::Make(DrawPipeline::Opaque, 3, 8, 0, 1.0f));
+	EXPECT_LT(DrawSortKey::Make(DrawPipeline::Opaque, 3, 7, 2, 1.0f), DrawSortKey::Make(DrawPipeline::Opaque, 3, 7, 2, 4.0f));
+	EXPECT_LT(DrawSortKey::Make(DrawPipeline::Opaque, 3, 7, 2, 0.0f), DrawSortKey::Make(DrawPipeline::Opaque, 3, 7, 2, 1e-6f));
+	EXPECT_EQ(DrawSortKey::GetBatchBits(DrawSortKey::Make(DrawPipeline::Opaque, 3, 7, 2, 1.0f)),
+	          DrawSortKey::GetBatchBits(DrawSortKey::Make(DrawPipeline::Opaque, 3, 7, 2, 1e6f)));
+}
+
+TEST(DrawList, Radix_Sort_Is_Stable) {
+	std::mt19937 random{8};
+
+	// Few distinct values in the high bits, like real keys, and repeated keys to check stability
+	Vector<DrawPacket> packets(50'000);
+	for (u32 i = 0; i < packets.size(); ++i) {
+		u64 const key = static_cast<u64>(random() % 5) << 52 | static_cast<u64>(random() % 7) << 36 | random() % 1000;
+		packets[i] = DrawPacket{key, i};
+	}
+
+	Vector<DrawPacket> expected = packets;
+	std::stable_sort(expected.begin(), expected.end(), [](DrawPacket const& a, DrawPacket const& b) {
+		return a.m_SortKey < b.m_SortKey;
+	});
+
+	Vector<DrawPacket> scratch{};
+	DrawList::SortPackets(packets, scratch);
+	ASSERT_EQ(packets.size(), expected.size());
+	for (u32 i = 0; i < packets.size(); ++i) {
+		ASSERT_EQ(packets[i].m_SortKey, expected[i].m_SortKey) << i;
+		ASSERT_EQ(packets[i].m_ObjectIdx, expected[i].m_ObjectIdx) << i;
+	}
+}
+
+TEST(DrawList, Batches) {
+	DrawListScene scene{};
+	CreateDrawListScene(scene, 5'000, 8, 4);
+
+	// Only draw every other object
+	Vector<u32> visible{};
+	for (u32 i = 0; i < scene.m_Objects.size(); i += 2) { visible.push_back(i); }
+	Vec3 const viewPosition{0.0f, 0.0f, 350.0f};
+	scene.m_DrawList.Build(scene.m_Objects, visible, scene.m_Bounds, viewPosition);
+
+	// One batch per material, mesh and LOD, with the batches of each material together
+	Vector<DrawBatch> const& batches = scene.m_DrawList.GetBatches();
+	Vector<u32> const&       instances = scene.m_DrawList.GetInstances();
+	EXPECT_EQ(batches.size(), 8 * 4 * 3);
+	EXPECT_EQ(instances.size(), visible.size());
+
+	u32 numInstances = 0;
+	u32 numMaterialChanges = 0;
+	for (u32 b = 0; b < batches.size(); ++b) {
+		DrawBatch const& batch = batches[b];
+		EXPECT_EQ(batch.m_FirstInstance, numInstances);
+		numInstances += batch.m_InstanceCount;
+		if (b > 0 && batch.m_MaterialID != batches[b - 1].m_MaterialID) { ++numMaterialChanges; }
+
+		f32 lastDistance = 0.0f;
+		for (u32 i = batch.m_FirstInstance; i < batch.m_FirstInstance + batch.m_InstanceCount; ++i) {
+			RenderObjectData const& object = scene.m_Objects[instances[i]];
+			EXPECT_EQ(object.m_MeshID, batch.m_MeshID);
+			EXPECT_EQ(object.m_MaterialID, batch.m_MaterialID);
+			EXPECT_EQ(object.m_LODIndex, batch.m_LODIndex);
+
+			// Front to back, up to the precision of the key
+			f32 const distance = glm::length(scene.m_Bounds.GetObjectBounds(instances[i]).GetCenter() - viewPosition);
+			EXPECT_GE(distance, lastDistance * 0.999f);
+			lastDistance = distance;
+		}
+	}
+
+	EXPECT_EQ(numMaterialChanges, 3);
+
+	Vector<u32> sortedInstances = instances;
+	std::sort(sortedInstances.begin(), sortedInstances.end());
+	EXPECT_EQ(sortedInstances, visible);
+
+	// Nothing visible, nothing to draw
+	scene.m_DrawList.Build(scene.m_Objects, {}, scene.m_Bounds, viewPosition);
+	EXPECT_TRUE(scene.m_DrawList.GetBatches().empty());
+	EXPECT_TRUE(scene.m_DrawList.GetInstances().empty());
+}
+
+//-----------------------------------------------------------------------------
+
+namespace {
+	Mat4 CreateClusterProjection() {
+		Mat4 proj = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f);
+		proj[1][1] *= -1;
+		return proj;
+	}
+
+	// View space lights spread over the view frustum, a few of them behind the camera or past the far plane
+	Vector<PointLightGPU> CreateViewSpaceLights(u32 numLights, f32 maxDepth, u32 seed) {
+		std::mt19937                   random{seed};
+		std::uniform_real_distribution depth{-5.0f, maxDepth * 1.1f};
+		std::uniform_real_distribution side{-1.2f, 1.2f};
+		std::uniform_real_distribution radius{0.5f, 8.0f};
+
+		Vector<PointLightGPU> lights(numLights);
+		for (PointLightGPU& light : lights) {
+			f32 const d = depth(random);
+			f32 const halfHeight = std::abs(d) * std::tan(glm::radians(30.0f));
+			light.m_ViewSpacePosition = Vec4{side(random) * halfHeight * 16.0f / 9.0f, side(random) * halfHeight, -d,
+			                                 radius(random)};
+			light.m_Radiance = Vec4{1.0f};
+		}
+		return lights;
+	}
+
+	// Tests every light against every cluster, with the same operations as the builder
+	Vector<Vector<u32>> AssignLightsBruteForce(LightClusterBuilder const& builder, Vector<PointLightGPU> const& lights) {
+		auto const axisDistance = [](f32 value, f32 min, f32 max) {
+			return std::max(std::max(min - value, value - max), 0.0f);
+		};
+
+		Vector<Vector<u32>> clusterLights(builder.GetNumClusters());
+		for (u32 clusterIdx = 0; clusterIdx < builder.GetNumClusters(); ++clusterIdx) {
+			AABB const bounds = builder.GetClusterBounds(clusterIdx);
+			for (u32 lightIdx = 0; lightIdx < lights.size(); ++lightIdx) {
+				Vec4 const sphere = lights[lightIdx].m_ViewSpacePosition;
+				f32 const  dx = axisDistance(sphere.x, bounds.m_Min.x, bounds.m_Max.x);
+				f32 const  dy = axisDistance(sphere.y, bounds.m_Min.y, bounds.m_Max.y);
+				f32 const  dz = axisDistance(sphere.z, bounds.m_Min.z, bounds.m_Max.z);
+				if ((dx * dx + dy * dy) + dz * dz <= sphere.w * sphere.w) {
+					clusterLights[clusterIdx].push_back(lightIdx);
+				}
+			}
+		}
+		return clusterLights;
+	}
+
+	void ExpectClustersEqual(LightClusterBuilder const& builder, Vector<Vector<u32>> const& expected) {
+		ASSERT_EQ(builder.GetNumClusters(), expected.size());
+		for (u32 clusterIdx = 0; clusterIdx < expected.size(); ++clusterIdx) {
+			LightClusterGPU const cluster = builder.GetClusters()[clusterIdx];
+			Vector<u32> const     lights(builder.GetLightIndices().begin() + cluster.m_FirstLight,
+			                             builder.GetLightIndices().begin() + cluster.m_FirstLight + cluster.m_NumLights);
+			ASSERT_EQ(lights, expected[clusterIdx]) << "Cluster " << clusterIdx;
+		}
+	}
+}
+
+TEST(LightClusters, Cluster_Bounds) {
+	LightClusterBuilder builder{};
+	builder.SetGrid(LightGridDesc{}, CreateClusterProjection());
+	LightGridDesc const& desc = builder.GetGridDesc();
+	ASSERT_EQ(builder.GetNumClusters(), desc.m_TilesX * desc.m_TilesY * desc.m_NumSlices);
+
+	// Slices start at the camera and cover up to the far depth without gaps
+	EXPECT_EQ(builder.GetClusterBounds(builder.GetClusterIndex(0, 0, 0)).m_Max.z, 0.0f);
+	EXPECT_EQ(builder.GetClusterBounds(builder.GetClusterIndex(0, 0, desc.m_NumSlices - 1)).m_Min.z, -desc.m_Far);
+	for (u32 slice = 1; slice < desc.m_NumSlices; ++slice) {
+		EXPECT_EQ(builder.GetClusterBounds(builder.GetClusterIndex(3, 2, slice)).m_Max.z,
+		          builder.GetClusterBounds(builder.GetClusterIndex(3, 2, slice - 1)).m_Min.z);
+	}
+
+	// The slice the shader computes from the depth of a point contains it
+	LightGridGPU const grid = builder.GetGridGPU(0);
+	for (f32 const depth : {0.5f, 3.0f, 42.0f, 250.0f, 900.0f}) {
+		u32 const  slice = static_cast<u32>(std::log(depth) * grid.m_Slicing.x + grid.m_Slicing.y);
+		AABB const bounds = builder.GetClusterBounds(builder.GetClusterIndex(0, 0, slice));
+		EXPECT_LE(bounds.m_Min.z, -depth);
+		EXPECT_GE(bounds.m_Max.z, -depth);
+	}
+
+	// Adjacent tiles share their edges and the first row is on the top of the screen
+	AABB const left = builder.GetClusterBounds(builder.GetClusterIndex(4, 4, 10));
+	AABB const right = builder.GetClusterBounds(builder.GetClusterIndex(5, 4, 10));
+	AABB const top = builder.GetClusterBounds(builder.GetClusterIndex(4, 0, 10));
+	EXPECT_LT(left.m_Min.x, right.m_Min.x);
+	EXPECT_LT(left.m_Max.x, right.m_Max.x);
+	EXPECT_GT(top.m_Max.y, left.m_Max.y);
+}
+
+TEST(LightClusters, Matches_Brute_Force) {
+	TaskSystem taskSystem{};
+	taskSystem.Initialize();
+
+	LightClusterBuilder builder{};
+	builder.SetGrid(LightGridDesc{}, CreateClusterProjection());
+	for (u32 const numLights : {0u, 1u, 300u, 2'000u}) {
+		Vector<PointLightGPU> const lights = CreateViewSpaceLights(numLights, 300.0f, numLights);
+		Vector<Vector<u32>> const   expected = AssignLightsBruteForce(builder, lights);
+
+		builder.Build(lights);
+		ExpectClustersEqual(builder, expected);
+		builder.Build(lights, &taskSystem);
+		ExpectClustersEqual(builder, expected);
+	}
+
+	// Grids that don't fill the SIMD width
+	LightGridDesc desc{};
+	desc.m_TilesX = 5;
+	desc.m_TilesY = 3;
+	desc.m_NumSlices = 7;
+	desc.m_Far = 200.0f;
+	builder.SetGrid(desc, CreateClusterProjection());
+	Vector<PointLightGPU> const lights = CreateViewSpaceLights(500, 200.0f, 11);
+	builder.Build(lights, &taskSystem);
+	ExpectClustersEqual(builder, AssignLightsBruteForce(builder, lights));
+
+	taskSystem.Shutdown();
+}
+
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, they only print timings. Run them with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+
+// Cull time against testing every object, for a camera inside a scene like the stress test world
+TEST(CullingBVH, DISABLED_Benchmark_Cull) {
+	constexpr u32 NUM_RUNS = 10;
+
+	for (u32 const numObjects : {27'000u, 100'000u, 500'000u}) {
+		Vector<AABB> objects = CreateSyntheticScene(numObjects, 300.0f, 5);
+
+		CullingBVH bvh{};
+		for (u32 i = 0; i < objects.size(); ++i) { bvh.SetObjectBounds(i, objects[i]); }
+
+		auto const buildStart = std::chrono::high_resolution_clock::now();
+		bvh.Update();
+		auto const buildEnd = std::chrono::high_resolution_clock::now();
+
+		// Every object moves a bit, as in the cube mover
+		for (u32 i = 0; i < objects.size(); ++i) {
+			objects[i].m_Min += Vec3{0.1f};
+			objects[i].m_Max += Vec3{0.1f};
+			bvh.SetObjectBounds(i, objects[i]);
+		}
+		auto const refitStart = std::chrono::high_resolution_clock::now();
+		bvh.Update();
+		auto const refitEnd = std::chrono::high_resolution_clock::now();
+
+		Frustum const frustum = CreateCameraFrustum(Vec3{0.0f, 20.0f, 350.0f}, Vec3{0.0f});
+		Vector<u32>   visible{};
+		visible.reserve(numObjects);
+		f64 bvhMs = std::numeric_limits<f64>::max();
+		f64 bruteForceMs = std::numeric_limits<f64>::max();
+		for (u32 run = 0; run < NUM_RUNS; ++run) {
+			visible.clear();
+			auto const start = std::chrono::high_resolution_clock::now();
+			bvh.Cull(frustum, visible);
+			auto const end = std::chrono::high_resolution_clock::now();
+			bvhMs = std::min(bvhMs, std::chrono::duration<f64, std::milli>(end - start).count());
+
+			auto const bruteStart = std::chrono::high_resolution_clock::now();
+			u64        numVisible = CullBruteForce(objects, frustum).size();
+			auto const bruteEnd = std::chrono::high_resolution_clock::now();
+			bruteForceMs = std::min(bruteForceMs, std::chrono::duration<f64, std::milli>(bruteEnd - bruteStart).count());
+			EXPECT_EQ(visible.size(), numVisible);
+		}
+
+		std::cout << "[Benchmark] " << numObjects << " objects, " << visible.size() << " visible"
+				<< ", cull: " << bvhMs << " ms, brute force: " << bruteForceMs << " ms"
+				<< ", build: " << std::chrono::duration<f64, std::milli>(buildEnd - buildStart).count() << " ms"
+				<< ", refit: " << std::chrono::duration<f64, std::milli>(refitEnd - refitStart).count() << " ms\n";
+	}
+}
+
+// Packets per second of building the draw list with every object visible, std::sort of the same packets as the baseline
+TEST(DrawList, DISABLED_Benchmark_Build) {
+	constexpr u32 NUM_RUNS = 10;
+
+	for (u32 const numObjects : {27'000u, 100'000u, 500'000u}) {
+		DrawListScene scene{};
+		CreateDrawListScene(scene, numObjects, 64, 16);
+		Vec3 const viewPosition{0.0f, 20.0f, 350.0f};
+
+		f64 buildMs = std::numeric_limits<f64>::max();
+		f64 stdSortMs = std::numeric_limits<f64>::max();
+		for (u32 run = 0; run < NUM_RUNS; ++run) {
+			auto const start = std::chrono::high_resolution_clock::now();
+			scene.m_DrawList.Build(scene.m_Objects, scene.m_Visible, scene.m_Bounds, viewPosition);
+			auto const end = std::chrono::high_resolution_clock::now();
+			buildMs = std::min(buildMs, std::chrono::duration<f64, std::milli>(end - start).count());
+
+			Vector<DrawPacket> packets = scene.m_DrawList.GetPackets();
+			std::shuffle(packets.begin(), packets.end(), std::mt19937{run});
+			auto const sortStart = std::chrono::high_resolution_clock::now();
+			std::sort(packets.begin(), packets.end(), [](DrawPacket const& a, DrawPacket const& b) {
+				return a.m_SortKey < b.m_SortKey;
+			});
+			auto const sortEnd = std::chrono::high_resolution_clock::now();
+			stdSortMs = std::min(stdSortMs, std::chrono::duration<f64, std::milli>(sortEnd - sortStart).count());
+		}
+
+		std::cout << "[Benchmark] " << numObjects << " packets, " << scene.m_DrawList.GetBatches().size() << " draws"
+				<< ", build: " << buildMs << " ms (" << numObjects / buildMs / 1000.0 << " M packets/s)"
+				<< ", std::sort only: " << stdSortMs << " ms\n";
+	}
+}
+
+// Assignment time of lights spread over the view, from one thread and from the task system
+TEST(LightClusters, DISABLED_Benchmark_Build) {
+	constexpr u32 NUM_RUNS = 10;
+
+	TaskSystem taskSystem{};
+	taskSystem.Initialize();
+
+	LightClusterBuilder builder{};
+	builder.SetGrid(LightGridDesc{}, CreateClusterProjection());
+	for (u32 const numLights : {1'000u, 10'000u, 50'000u}) {
+		Vector<PointLightGPU> const lights = CreateViewSpaceLights(numLights, 500.0f, 3);
+
+		f64 serialMs = std::numeric_limits<f64>::max();
+		f64 parallelMs = std::numeric_limits<f64>::max();
+		for (u32 run = 0; run < NUM_RUNS; ++run) {
+			auto const start = std::chrono::high_resolution_clock::now();
+			builder.Build(lights);
+			auto const end = std::chrono::high_resolution_clock::now();
+			serialMs = std::min(serialMs, std::chrono::duration<f64, std::milli>(end - start).count());
+
+			auto const parallelStart = std::chrono::high_resolution_clock::now();
+			builder.Build(lights, &taskSystem);
+			auto const parallelEnd = std::chrono::high_resolution_clock::now();
+			parallelMs = std::min(parallelMs, std::chrono::duration<f64, std::milli>(parallelEnd - parallelStart).count());
+		}
+
+		std::cout << "[Benchmark] " << numLights << " lights, " << builder.GetNumClusters() << " clusters"
+				<< ", " << builder.GetLightIndices().size() << " indices"
+				<< ", 1 thread: " << serialMs << " ms"
+				<< ", " << taskSystem.GetNumThreads() << " threads: " << parallelMs << " ms\n";
+	}
+
+	taskSystem.Shutdown();
+}
@@ -5,6 +5,7 @@
 #include "CookieKat/Systems/RenderAPI/RenderDevice.h"
 
 namespace CKE {
+	// Imports fbx/obj meshes at runtime, without any offline processing
 	class MeshLoader : public ResourceLoader
 	{
 	public:
@@ -19,4 +20,20 @@ namespace CKE {
 	private:
 		RenderDevice* m_pDevice = nullptr;
 	};
+
+	// Loads meshes optimized offline by the resource compiler
+	class CompiledMeshLoader : public CompiledResourcesLoader
+	{
+	public:
+		void Initialize(RenderDevice* pRenderDevice);
+
+		LoadResult LoadCompiledResource(LoadContext& ctx, BinaryInputArchive& ar, LoadOutput& out) override;
+		LoadResult Install(InstallContext& ctx) override;
+		LoadResult Unload(UnloadContext& ctx) override;
+
+		Array<ResourceTypeID, 16> GetLoadableTypes() override { return {ResourceTypeID("mesh")}; }
+
+	private:
+		RenderDevice* m_pDevice = nullptr;
+	};
 }
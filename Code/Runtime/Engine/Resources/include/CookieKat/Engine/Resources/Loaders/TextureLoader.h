@@ -4,40 +4,50 @@
 
 #include "CookieKat/Systems/RenderAPI/RenderDevice.h"
 #include "CookieKat/Systems/Resources/ResourceLoader.h"
-#include "CookieKat/Systems/RenderUtils/TextureUploader.h"
+#include "CookieKat/Systems/RenderUtils/TextureUploadQueue.h"
 
 namespace CKE {
+	// The install of a texture completes when the upload queue finishes copying its data
 	class TextureLoader : public CompiledResourcesLoader
 	{
 	public:
-		void Initialize(RenderDevice* pRenderDevice);
-		void Shutdown();
+		void Initialize(RenderDevice* pRenderDevice, TextureUploadQueue* pUploadQueue);
 
 		LoadResult LoadCompiledResource(LoadContext& ctx, BinaryInputArchive& ar, LoadOutput& out) override;
 		LoadResult Install(InstallContext& ctx) override;
 		LoadResult Uninstall(UninstallContext& ctx) override;
 		LoadResult Unload(UnloadContext& ctx) override;
 
+		InstallResult CheckInstallStatus(InstallContext& ctx) override;
+		void          WaitForInstall(InstallContext& ctx) override;
+
 		Array<ResourceTypeID, 16> GetLoadableTypes() override { return {ResourceTypeID("tex")}; }
 
 	private:
-		RenderDevice* m_pRenderDevice = nullptr;
-		TextureUploader m_Uploader{};
+		RenderDevice*                        m_pRenderDevice = nullptr;
+		TextureUploadQueue*                  m_pUploadQueue = nullptr;
+		Map<IResource*, TextureUploadTicket> m_Uploads{}; // Installs in progress
 	};
 
 	class CubeMapLoader : public CompiledResourcesLoader
 	{
 	public:
-		void Initialize(RenderDevice* pRenderDevice);
+		// Cube maps are uploaded through a queue shared with other loaders to avoid creating a staging buffer per cube map
+		void Initialize(RenderDevice* pRenderDevice, TextureUploadQueue* pUploadQueue);
 
 		LoadResult LoadCompiledResource(LoadContext& ctx, BinaryInputArchive& ar, LoadOutput& out) override;
 		LoadResult Install(InstallContext& ctx) override;
 		LoadResult Uninstall(UninstallContext& ctx) override;
 		LoadResult Unload(UnloadContext& ctx) override;
 
+		InstallResult CheckInstallStatus(InstallContext& ctx) override;
+		void          WaitForInstall(InstallContext& ctx) override;
+
 		Array<ResourceTypeID, 16> GetLoadableTypes() override { return {ResourceTypeID("cubeMap")}; }
 
 	private:
-		RenderDevice* m_pRenderDevice = nullptr;
+		RenderDevice*                        m_pRenderDevice = nullptr;
+		TextureUploadQueue*                  m_pUploadQueue = nullptr;
+		Map<IResource*, TextureUploadTicket> m_Uploads{}; // Installs in progress
 	};
 }
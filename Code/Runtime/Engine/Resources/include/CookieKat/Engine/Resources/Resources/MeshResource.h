@@ -1,14 +1,18 @@
 #pragma once
 
 #include "CookieKat/Core/Math/Math.h"
+#include "CookieKat/Core/Math/Bounds.h"
 #include "CookieKat/Core/Containers/Containers.h"
 #include "CookieKat/Systems/Resources/IResource.h"
 #include "CookieKat/Systems/RenderAPI/RenderHandle.h"
+#include "CookieKat/Systems/MeshProcessing/MeshLOD.h"
 
 //-----------------------------------------------------------------------------
 
 namespace CKE {
 	class MeshLoader;
+	class CompiledMeshLoader;
+	class MeshCompiler;
 }
 
 //-----------------------------------------------------------------------------
@@ -35,12 +39,33 @@ namespace CKE {
 		Vertex_3P3N3T2Tc(Vec3 pos, Vec3 normal, Vec3 tangent, Vec2 texCoord)
 			: m_Position(pos), m_Normal(normal), m_Tangent(tangent), m_TexCoord(texCoord) {}
 	};
+
+	// Compact version of Vertex_3P3N3T2Tc, 20 bytes instead of 44
+	struct Vertex_Quantized
+	{
+		u16 m_Position[4]; // Unorm16, normalized to the mesh bounds. W is padding
+		i16 m_Normal[2];   // Snorm16, octahedral encoded
+		i16 m_Tangent[2];  // Snorm16, octahedral encoded
+		u16 m_TexCoord[2]; // Half-float
+	};
+
+	// Layout of the vertex stream stored in a compiled mesh
+	enum class MeshVertexFormat : u8
+	{
+		Full_3P3N3T2Tc,
+		Quantized,
+	};
 }
 
 namespace CKE {
 	class MeshResource : public IResource
 	{
+		CKE_SERIALIZE_VERSIONED(1, m_VertexFormat, m_VertexCount, m_VertexData, m_Indices, m_PositionScale, m_PositionBias,
+		                           m_LODs, m_BoundingSphere);
+
 		friend MeshLoader;
+		friend CompiledMeshLoader;
+		friend MeshCompiler;
 
 	public:
 		inline Vector<Vertex_3P3N3T2Tc> const& GetVertices() const { return m_Vertices; }
@@ -49,11 +74,34 @@ namespace CKE {
 		inline BufferHandle const& GetVertexBuffer() const { return m_VertexBufferHandle; }
 		inline BufferHandle const& GetIndexBuffer() const { return m_IndexBufferHandle; }
 
+		// Levels of detail, all of them are ranges of the index buffer. LOD 0 is the full detail mesh
+		inline Vector<MeshProcessing::MeshLOD> const& GetLODs() const { return m_LODs; }
+		inline MeshProcessing::MeshLOD const&         GetLOD(u32 lodIndex) const { return m_LODs[lodIndex]; }
+
+		// Object space bounding sphere, used to measure the distance for LOD selection
+		inline Vec3 GetBoundingSphereCenter() const { return Vec3{m_BoundingSphere[0], m_BoundingSphere[1], m_BoundingSphere[2]}; }
+		inline f32  GetBoundingSphereRadius() const { return m_BoundingSphere[3]; }
+
+		// Object space bounding box, used for culling
+		inline AABB const& GetBoundingBox() const { return m_BoundingBox; }
+
 	private:
 		// Triangle Mesh Data
 		Vector<Vertex_3P3N3T2Tc> m_Vertices;
 		Vector<u32>              m_Indices;
 
+		// Compiled vertex stream, it is decoded into m_Vertices when loaded
+		MeshVertexFormat m_VertexFormat = MeshVertexFormat::Full_3P3N3T2Tc;
+		u32              m_VertexCount = 0;
+		Blob             m_VertexData;
+		Array<f32, 3>    m_PositionScale{1.0f, 1.0f, 1.0f}; // Quantized position dequantization
+		Array<f32, 3>    m_PositionBias{0.0f, 0.0f, 0.0f};
+
+		// Level of detail data
+		Vector<MeshProcessing::MeshLOD> m_LODs;
+		Array<f32, 4>                   m_BoundingSphere{0.0f, 0.0f, 0.0f, 0.0f};
+		AABB                            m_BoundingBox{}; // Computed from the vertices when loaded
+
 		// Render Resources
 		BufferHandle m_VertexBufferHandle;
 		BufferHandle m_IndexBufferHandle;
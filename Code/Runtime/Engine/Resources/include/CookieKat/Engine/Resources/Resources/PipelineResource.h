@@ -6,7 +6,7 @@
 namespace CKE {
 	class PipelineResource : public IResource
 	{
-		CKE_SERIALIZE(m_VertShaderSource, m_FragShaderSource);
+		CKE_SERIALIZE_VERSIONED(1, m_VertShaderSource, m_FragShaderSource);
 
 		friend class PipelineLoader;
 		friend class ResourceCompiler;
@@ -8,7 +8,7 @@
 namespace CKE {
 	class RenderMaterialResource : public IResource
 	{
-		CKE_SERIALIZE(m_AlbedoTexture, m_RoughnessTexture, m_MetalicTexture, m_NormalTexture);
+		CKE_SERIALIZE_VERSIONED(1, m_AlbedoTexture, m_RoughnessTexture, m_MetalicTexture, m_NormalTexture);
 
 		friend class MaterialLoader;
 		friend class ResourceCompiler;
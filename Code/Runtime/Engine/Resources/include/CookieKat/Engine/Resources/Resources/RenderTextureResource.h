@@ -15,13 +15,18 @@ namespace CKE {
 namespace CKE {
 	class RenderCubeMapResource : public IResource
 	{
-		CKE_SERIALIZE(m_FaceWidth, m_FaceHeight, m_Faces);
+		CKE_SERIALIZE_VERSIONED(1, m_FaceWidth, m_FaceHeight, m_Format, m_MipLevels, m_Faces, m_SHCoefficients);
 
 	public:
 		TextureHandle     GetTexture() const { return m_Texture; }
 		TextureViewHandle GetTextureView() const { return m_TextureView; }
-		Array<Vector<u8>, 6> const& GetFaces() const { return m_Faces; }
-		u32 GetFaceSize() const { return m_FaceWidth; }
+		u32               GetFaceSize() const { return m_FaceWidth; }
+		u32               GetMipLevels() const { return m_MipLevels; }
+
+		// 2nd degree spherical harmonics of the irradiance, computed when compiling the cube map
+		Vec3 GetSHCoefficient(u32 index) const {
+			return Vec3{m_SHCoefficients[index][0], m_SHCoefficients[index][1], m_SHCoefficients[index][2]};
+		}
 
 	private:
 		friend CubeMapLoader;
@@ -29,18 +34,24 @@ namespace CKE {
 		friend CubeMapCompiler;
 
 	private:
-		TextureHandle        m_Texture;
-		TextureViewHandle    m_TextureView;
-		u32                  m_FaceWidth{};
-		u32                  m_FaceHeight{};
-		Array<Vector<u8>, 6> m_Faces{};
+		TextureHandle     m_Texture;
+		TextureViewHandle m_TextureView;
+		u32               m_FaceWidth{};
+		u32               m_FaceHeight{};
+		TextureFormat     m_Format = TextureFormat::R8G8B8A8_SRGB;
+		u32               m_MipLevels = 1;
+
+		// Mips of each face in the GPU layout of the format, from the largest to the smallest.
+		// Mips after the first one hold the GGX prefiltered radiance for increasing roughness.
+		Array<Vector<u8>, 6>  m_Faces{};
+		Array<Array<f32, 3>, 9> m_SHCoefficients{};
 	};
 }
 
 namespace CKE {
 	class RenderTextureResource : public IResource
 	{
-		CKE_SERIALIZE(m_Data, m_Desc);
+		CKE_SERIALIZE_VERSIONED(1, m_Data, m_Desc);
 
 		friend TextureLoader;
 		friend ResourceCompiler;
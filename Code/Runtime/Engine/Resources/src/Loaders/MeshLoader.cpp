@@ -4,6 +4,7 @@
 #include "CookieKat/Core/Memory/Memory.h"
 
 #include "CookieKat/Engine/Resources/Resources/MeshResource.h"
+#include "CookieKat/Systems/MeshProcessing/MeshQuantization.h"
 
 #include <assimp/Importer.hpp>
 #include <assimp/postprocess.h>
@@ -12,6 +13,47 @@
 #include <rapidjson/document.h>
 
 namespace CKE {
+	namespace {
+		// Creates the GPU-side vertex and index buffers of a loaded mesh
+		void CreateMeshBuffers(RenderDevice* pDevice, MeshResource* meshResource) {
+			BufferDesc vertexBufferDesc;
+			vertexBufferDesc.m_Usage = BufferUsageFlags::Vertex | BufferUsageFlags::TransferDst;
+			vertexBufferDesc.m_MemoryAccess = MemoryAccess::GPU;
+			vertexBufferDesc.m_SizeInBytes = meshResource->m_Vertices.size() * sizeof(meshResource->
+				m_Vertices[0]);
+			vertexBufferDesc.m_StrideInBytes = sizeof(meshResource->m_Vertices[0]);
+			meshResource->m_VertexBufferHandle = pDevice->CreateBuffer(vertexBufferDesc);
+
+			BufferDesc indexBufferDesc;
+			indexBufferDesc.m_Usage = BufferUsageFlags::Index | BufferUsageFlags::TransferDst;
+			indexBufferDesc.m_MemoryAccess = MemoryAccess::GPU;
+			indexBufferDesc.m_SizeInBytes = meshResource->m_Indices.size() * sizeof(u32);
+			indexBufferDesc.m_StrideInBytes = sizeof(u32);
+			meshResource->m_IndexBufferHandle = pDevice->CreateBuffer(indexBufferDesc);
+		}
+
+		// Meshes without a LOD chain are drawn with a single full detail level
+		void SetupDefaultLODData(MeshResource* meshResource) {
+			if (meshResource->m_LODs.empty()) {
+				meshResource->m_LODs.push_back({0, static_cast<u32>(meshResource->m_Indices.size()), 0.0f});
+			}
+
+			if (meshResource->m_BoundingSphere[3] == 0.0f) {
+				Vector<Vec3> positions{};
+				positions.reserve(meshResource->m_Vertices.size());
+				for (Vertex_3P3N3T2Tc const& v : meshResource->m_Vertices) { positions.push_back(v.m_Position); }
+
+				Vec4 const sphere = MeshProcessing::ComputeBoundingSphere(positions);
+				meshResource->m_BoundingSphere = {sphere.x, sphere.y, sphere.z, sphere.w};
+			}
+		}
+
+		void ComputeBoundingBox(MeshResource* meshResource) {
+			meshResource->m_BoundingBox = AABB{};
+			for (Vertex_3P3N3T2Tc const& v : meshResource->m_Vertices) { meshResource->m_BoundingBox.Expand(v.m_Position); }
+		}
+	}
+
 	void MeshLoader::Initialize(RenderDevice* pRenderDevice) {
 		m_pDevice = pRenderDevice;
 	}
@@ -59,6 +101,9 @@ namespace CKE {
 			}
 		}
 
+		SetupDefaultLODData(meshResource);
+		ComputeBoundingBox(meshResource);
+
 		// Set texture dependencies
 		//-----------------------------------------------------------------------------
 
@@ -67,23 +112,7 @@ namespace CKE {
 	}
 
 	LoadResult MeshLoader::Install(InstallContext& ctx) {
-		auto meshResource = ctx.GetResource<MeshResource>();
-
-		BufferDesc vertexBufferDesc;
-		vertexBufferDesc.m_Usage = BufferUsageFlags::Vertex | BufferUsageFlags::TransferDst;
-		vertexBufferDesc.m_MemoryAccess = MemoryAccess::GPU;
-		vertexBufferDesc.m_SizeInBytes = meshResource->m_Vertices.size() * sizeof(meshResource->
-			m_Vertices[0]);
-		vertexBufferDesc.m_StrideInBytes = sizeof(meshResource->m_Vertices[0]);
-		meshResource->m_VertexBufferHandle = m_pDevice->CreateBuffer(vertexBufferDesc);
-
-		BufferDesc indexBufferDesc;
-		indexBufferDesc.m_Usage = BufferUsageFlags::Index | BufferUsageFlags::TransferDst;
-		indexBufferDesc.m_MemoryAccess = MemoryAccess::GPU;
-		indexBufferDesc.m_SizeInBytes = meshResource->m_Indices.size() * sizeof(u32);
-		indexBufferDesc.m_StrideInBytes = sizeof(u32);
-		meshResource->m_IndexBufferHandle = m_pDevice->CreateBuffer(indexBufferDesc);
-
+		CreateMeshBuffers(m_pDevice, ctx.GetResource<MeshResource>());
 		return LoadResult::Successful;
 	}
 
@@ -96,4 +125,74 @@ namespace CKE {
 
 		return LoadResult::Successful;
 	}
+
+	//-----------------------------------------------------------------------------
+
+	void CompiledMeshLoader::Initialize(RenderDevice* pRenderDevice) {
+		m_pDevice = pRenderDevice;
+	}
+
+	LoadResult CompiledMeshLoader::LoadCompiledResource(LoadContext& ctx, BinaryInputArchive& ar, LoadOutput& out) {
+		auto pMesh = New<MeshResource>();
+		ar << *pMesh;
+
+		// Decode the vertex stream into the runtime vertex format
+		//-----------------------------------------------------------------------------
+
+		pMesh->m_Vertices.resize(pMesh->m_VertexCount);
+
+		if (pMesh->m_VertexFormat == MeshVertexFormat::Full_3P3N3T2Tc) {
+			CKE_ASSERT(pMesh->m_VertexData.size() == pMesh->m_VertexCount * sizeof(Vertex_3P3N3T2Tc));
+			memcpy(pMesh->m_Vertices.data(), pMesh->m_VertexData.data(), pMesh->m_VertexData.size());
+		}
+		else {
+			CKE_ASSERT(pMesh->m_VertexData.size() == pMesh->m_VertexCount * sizeof(Vertex_Quantized));
+			auto const* pQuantized = reinterpret_cast<Vertex_Quantized const*>(pMesh->m_VertexData.data());
+
+			MeshProcessing::PositionQuantization quantization{};
+			quantization.m_Scale = Vec3{pMesh->m_PositionScale[0], pMesh->m_PositionScale[1], pMesh->m_PositionScale[2]};
+			quantization.m_Bias = Vec3{pMesh->m_PositionBias[0], pMesh->m_PositionBias[1], pMesh->m_PositionBias[2]};
+
+			for (u32 i = 0; i < pMesh->m_VertexCount; ++i) {
+				using namespace MeshProcessing;
+				Vertex_Quantized const& q = pQuantized[i];
+
+				Vec3 const normalizedPos{
+					DequantizeUnorm16(q.m_Position[0]),
+					DequantizeUnorm16(q.m_Position[1]),
+					DequantizeUnorm16(q.m_Position[2])
+				};
+				Vec2 const normal{DequantizeSnorm16(q.m_Normal[0]), DequantizeSnorm16(q.m_Normal[1])};
+				Vec2 const tangent{DequantizeSnorm16(q.m_Tangent[0]), DequantizeSnorm16(q.m_Tangent[1])};
+
+				pMesh->m_Vertices[i] = Vertex_3P3N3T2Tc{
+					DenormalizePosition(normalizedPos, quantization),
+					DecodeOctahedral(normal),
+					DecodeOctahedral(tangent),
+					Vec2{DequantizeHalf(q.m_TexCoord[0]), DequantizeHalf(q.m_TexCoord[1])}
+				};
+			}
+		}
+
+		// The compiled stream isn't needed anymore
+		pMesh->m_VertexData.clear();
+		pMesh->m_VertexData.shrink_to_fit();
+
+		SetupDefaultLODData(pMesh);
+		ComputeBoundingBox(pMesh);
+
+		out.SetResource(pMesh);
+		return LoadResult::Successful;
+	}
+
+	LoadResult CompiledMeshLoader::Install(InstallContext& ctx) {
+		CreateMeshBuffers(m_pDevice, ctx.GetResource<MeshResource>());
+		return LoadResult::Successful;
+	}
+
+	LoadResult CompiledMeshLoader::Unload(UnloadContext& ctx) {
+		auto mesh = ctx.GetResource<MeshResource>();
+		CKE::Delete(mesh);
+		return LoadResult::Successful;
+	}
 }
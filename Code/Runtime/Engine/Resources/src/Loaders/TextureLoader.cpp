@@ -3,30 +3,19 @@
 #include "CookieKat/Core/Memory/Memory.h"
 #include "CookieKat/Engine/Resources/Resources/RenderTextureResource.h"
 
-#include <lodepng.h>
-
 namespace CKE {
-	void TextureLoader::Initialize(RenderDevice* pRenderDevice) {
+	void TextureLoader::Initialize(RenderDevice* pRenderDevice, TextureUploadQueue* pUploadQueue) {
+		CKE_ASSERT(pRenderDevice != nullptr);
+		CKE_ASSERT(pUploadQueue != nullptr);
 		m_pRenderDevice = pRenderDevice;
-		m_Uploader.Initialize(m_pRenderDevice, sizeof(u32) * 4 * 4096 * 4096);
-	}
-
-	void TextureLoader::Shutdown() {
-		m_Uploader.Shutdown();
+		m_pUploadQueue = pUploadQueue;
 	}
 
 	LoadResult TextureLoader::LoadCompiledResource(LoadContext& ctx, BinaryInputArchive& ar, LoadOutput& out) {
+		// The compiled data is already in the GPU layout, mips included
 		auto pTexture = New<RenderTextureResource>();
 		ar << *pTexture;
 
-		UInt3 texSize = pTexture->m_Desc.m_Size;
-
-		// Uncompress Texture
-		Vector<u8> uncompressedTexture{};
-		uncompressedTexture.reserve(texSize.x * texSize.y);
-		lodepng::decode(uncompressedTexture, texSize.x, texSize.y, pTexture->m_Data);
-		pTexture->m_Data = uncompressedTexture;
-
 		out.SetResource(pTexture);
 		return LoadResult::Successful;
 	}
@@ -42,13 +31,14 @@ namespace CKE {
 		texDesc.m_AspectMask = TextureAspectMask::Color;
 		texDesc.m_TextureType = TextureType::Tex2D;
 		texDesc.m_Format = pTexture->m_Desc.m_Format;
+		texDesc.m_MipLevels = pTexture->m_Desc.m_MipLevels;
 		TextureHandle texHandle = m_pRenderDevice->CreateTexture(texDesc);
 		pTexture->m_TextureHandle = texHandle;
 
-		// Upload it to GPU
-		CKE_ASSERT(texSize.x <= 4096 && texSize.y <= 4096);
-		m_Uploader.UploadColorTexture2D(texHandle, pTexture->m_Data.data(),
-		                              UInt2{texSize.x, texSize.y}, sizeof(u32));
+		// Upload it to GPU, the install completes when the copies finish
+		m_Uploads[pTexture] = m_pUploadQueue->EnqueueTexture2DMips(texHandle, pTexture->m_Data.data(),
+		                                                           UInt2{texSize.x, texSize.y},
+		                                                           texDesc.m_MipLevels, texDesc.m_Format);
 
 		// Create Texture View of the complete texture
 		TextureViewDesc viewDesc{};
@@ -56,11 +46,31 @@ namespace CKE {
 		viewDesc.m_Texture = texHandle;
 		viewDesc.m_Type = TextureViewType::Tex2D;
 		viewDesc.m_AspectMask = TextureAspectMask::Color;
+		viewDesc.m_MipLevelCount = texDesc.m_MipLevels;
 		pTexture->m_TextureView = m_pRenderDevice->CreateTextureView(viewDesc);
 
 		return LoadResult::Successful;
 	}
 
+	InstallResult TextureLoader::CheckInstallStatus(InstallContext& ctx) {
+		auto const upload = m_Uploads.find(ctx.GetResource<RenderTextureResource>());
+		if (upload == m_Uploads.end()) { return InstallResult::Completed; }
+		if (!m_pUploadQueue->IsUploadComplete(upload->second)) { return InstallResult::InProgress; }
+
+		// The GPU owns the data from now on
+		Blob{}.swap(ctx.GetResource<RenderTextureResource>()->m_Data);
+		m_Uploads.erase(upload);
+		return InstallResult::Completed;
+	}
+
+	void TextureLoader::WaitForInstall(InstallContext& ctx) {
+		auto const upload = m_Uploads.find(ctx.GetResource<RenderTextureResource>());
+		if (upload == m_Uploads.end()) { return; }
+
+		m_pUploadQueue->WaitForUpload(upload->second);
+		CheckInstallStatus(ctx);
+	}
+
 	LoadResult TextureLoader::Uninstall(UninstallContext& ctx) {
 		RenderTextureResource* pTex = ctx.GetResource<RenderTextureResource>();
 		m_pRenderDevice->DestroyTextureView(pTex->m_TextureView);
@@ -76,12 +86,15 @@ namespace CKE {
 }
 
 namespace CKE {
-	void CubeMapLoader::Initialize(RenderDevice* pRenderDevice) {
+	void CubeMapLoader::Initialize(RenderDevice* pRenderDevice, TextureUploadQueue* pUploadQueue) {
 		CKE_ASSERT(pRenderDevice != nullptr);
+		CKE_ASSERT(pUploadQueue != nullptr);
 		m_pRenderDevice = pRenderDevice;
+		m_pUploadQueue = pUploadQueue;
 	}
 
 	LoadResult CubeMapLoader::LoadCompiledResource(LoadContext& ctx, BinaryInputArchive& ar, LoadOutput& out) {
+		// The compiled faces are already in the GPU layout, mips included
 		auto pCubeMapAsset = CKE::New<RenderCubeMapResource>();
 		ar << *pCubeMapAsset;
 		out.SetResource(pCubeMapAsset);
@@ -91,43 +104,52 @@ namespace CKE {
 	LoadResult CubeMapLoader::Install(InstallContext& ctx) {
 		auto cubeMap = ctx.GetResource<RenderCubeMapResource>();
 
-		Array<Vector<u8>, 6> rawTex{};
-		void*                pCubeMapPtrs[6];
-		for (int i = 0; i < 6; ++i) {
-			rawTex[i].reserve(cubeMap->m_FaceWidth * cubeMap->m_FaceHeight);
-			lodepng::decode(rawTex[i],
-			                cubeMap->m_FaceWidth,
-			                cubeMap->m_FaceHeight,
-			                cubeMap->m_Faces[i]);
-			pCubeMapPtrs[i] = rawTex[i].data();
-		}
-		cubeMap->m_Faces = rawTex;
-
 		TextureDesc textureDesc{};
 		textureDesc.m_DebugName = "CubeMap";
-		textureDesc.m_Format = TextureFormat::R8G8B8A8_SRGB;
+		textureDesc.m_Format = cubeMap->m_Format;
 		textureDesc.m_Size = UInt3{cubeMap->m_FaceWidth, cubeMap->m_FaceHeight, 1};
 		textureDesc.m_AspectMask = TextureAspectMask::Color;
 		textureDesc.m_MiscFlags = TextureMiscFlags::Texture_CubeMap;
 		textureDesc.m_ArraySize = 6;
+		textureDesc.m_MipLevels = cubeMap->m_MipLevels;
 		cubeMap->m_Texture = m_pRenderDevice->CreateTexture(textureDesc);
 
-		TextureUploader uploader{};
-		uploader.Initialize(m_pRenderDevice, cubeMap->m_FaceWidth * cubeMap->m_FaceHeight * 4 * 6);
-		uploader.UploadTextureCubeMap(cubeMap->m_Texture, pCubeMapPtrs,
-		                              UInt2{cubeMap->m_FaceWidth, cubeMap->m_FaceWidth});
-		uploader.Shutdown();
+		// The faces are kept until the copies finish
+		void const* pCubeMapPtrs[6];
+		for (int i = 0; i < 6; ++i) { pCubeMapPtrs[i] = cubeMap->m_Faces[i].data(); }
+		m_Uploads[cubeMap] = m_pUploadQueue->EnqueueCubeMapMips(cubeMap->m_Texture, pCubeMapPtrs,
+		                                                        UInt2{cubeMap->m_FaceWidth, cubeMap->m_FaceHeight},
+		                                                        textureDesc.m_MipLevels, textureDesc.m_Format);
 
 		TextureViewDesc viewDesc{
 			cubeMap->m_Texture, TextureViewType::Cube,
 			textureDesc.m_AspectMask, textureDesc.m_Format,
-			0, 1, 0, 6
+			0, textureDesc.m_MipLevels, 0, 6
 		};
 		cubeMap->m_TextureView = m_pRenderDevice->CreateTextureView(viewDesc);
 
 		return LoadResult::Successful;
 	}
 
+	InstallResult CubeMapLoader::CheckInstallStatus(InstallContext& ctx) {
+		auto const upload = m_Uploads.find(ctx.GetResource<RenderCubeMapResource>());
+		if (upload == m_Uploads.end()) { return InstallResult::Completed; }
+		if (!m_pUploadQueue->IsUploadComplete(upload->second)) { return InstallResult::InProgress; }
+
+		// The GPU owns the data from now on
+		for (Vector<u8>& face : ctx.GetResource<RenderCubeMapResource>()->m_Faces) { Vector<u8>{}.swap(face); }
+		m_Uploads.erase(upload);
+		return InstallResult::Completed;
+	}
+
+	void CubeMapLoader::WaitForInstall(InstallContext& ctx) {
+		auto const upload = m_Uploads.find(ctx.GetResource<RenderCubeMapResource>());
+		if (upload == m_Uploads.end()) { return; }
+
+		m_pUploadQueue->WaitForUpload(upload->second);
+		CheckInstallStatus(ctx);
+	}
+
 	LoadResult CubeMapLoader::Uninstall(UninstallContext& ctx) {
 		auto cubeMap = ctx.GetResource<RenderCubeMapResource>();
 		m_pRenderDevice->DestroyTextureView(cubeMap->m_TextureView);
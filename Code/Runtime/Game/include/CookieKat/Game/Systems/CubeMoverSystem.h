@@ -27,6 +27,7 @@ namespace CKE {
 			l2w->m_LocalToWorld[3].x += vel->m_Velocity.x;
 			l2w->m_LocalToWorld[3].y += vel->m_Velocity.y;
 			l2w->m_LocalToWorld[3].z += vel->m_Velocity.z;
+			l2w->m_Changed = true;
 		}
 	};
 
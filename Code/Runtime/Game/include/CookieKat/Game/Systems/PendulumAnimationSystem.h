@@ -32,6 +32,7 @@ namespace CKE {
 
 				l2w->m_LocalToWorld[3].x = x;
 				l2w->m_LocalToWorld[3].y = y;
+				l2w->m_Changed = true;
 			}
 		}
 	};
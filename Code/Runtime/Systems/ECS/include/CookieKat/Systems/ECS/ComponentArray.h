@@ -22,6 +22,9 @@ namespace CKE {
 		// Adds a new component to the end and returns its index
 		inline u64 AppendComponentToEnd();
 
+		// Adds count uninitialized components to the end and returns a pointer to the first one
+		inline u8* AppendComponentsToEnd(u64 count);
+
 		// Returns a pointer to the component at the given position
 		inline u8* GetCompAtIndex(u64 index);
 
@@ -32,6 +35,11 @@ namespace CKE {
 		// Returns the size in bytes of the component type that is stored in this array
 		inline u64 GetCompSizeInBytes() const;
 
+		// Returns a pointer to the packed component data
+		inline u8* GetData() const { return m_pData; }
+
+		inline u64 GetNumComponents() const { return m_NumComponents; }
+
 	private:
 		u8*             m_pData;
 		u64             m_NumComponents;
@@ -91,6 +99,13 @@ namespace CKE {
 		return rowIndex;
 	}
 
+	u8* ComponentArray::AppendComponentsToEnd(u64 count) {
+		CKE_ASSERT(m_NumComponents + count <= m_NumMaxComponents); // Ran out of space
+		u8* pFirst = m_pData + m_ComponentSize * m_NumComponents;
+		m_NumComponents += count;
+		return pFirst;
+	}
+
 	u8* ComponentArray::GetCompAtIndex(u64 index) {
 		CKE_ASSERT(index < m_NumComponents); // Trying to access a component that doesn't exist
 		return m_ComponentSize * index + m_pData;
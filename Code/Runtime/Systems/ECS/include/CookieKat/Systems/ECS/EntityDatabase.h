@@ -11,6 +11,7 @@
 #include "Iterators/MultiComponentIterator.h"
 #include "Iterators/EntityComponentIterator.h"
 #include "CookieKat/Core/Memory/PoolAllocator.h"
+#include "CookieKat/Core/Serialization/Archive.h"
 
 #include <typeinfo>
 #include <functional>
@@ -278,6 +279,24 @@ namespace CKE {
 		template <typename T>
 		void RemoveSingletonComponent();
 
+		//-----------------------------------------------------------------------------
+		// Snapshots
+		//-----------------------------------------------------------------------------
+
+		// Writes the whole state of the database: the component registry, the component columns of
+		// every archetype as contiguous blobs, the entity records and the singleton components
+		void SaveSnapshot(Archive<BinaryWriter>& archive);
+
+		// Restores a snapshot into an initialized database that has no entities or archetypes yet.
+		// Archetypes are filled with bulk copies of their columns instead of replaying every structural change.
+		// Component types that are already registered must match the snapshot ones, the rest are registered from it.
+		// Returns false if the snapshot is invalid, doesn't match the registered components or doesn't fit
+		// in the max number of entities, the database has to be discarded in that case
+		//
+		// Asserts:
+		//   The database doesn't have entities
+		bool LoadSnapshot(BinaryInputArchive& archive);
+
 		//-----------------------------------------------------------------------------
 		// Queries
 		//-----------------------------------------------------------------------------
@@ -5,6 +5,18 @@
 #include <ranges>
 
 namespace CKE {
+	namespace {
+		constexpr u32 SNAPSHOT_VERSION = 1;
+
+		// Entity record as stored in a snapshot, archetypes are referenced by ID
+		struct SnapshotEntityRecord
+		{
+			u32 m_EntityID;
+			u32 m_ArchetypeID;
+			u64 m_ArchetypeRow;
+		};
+	}
+
 	void EntityDatabase::Initialize(u64 maxEntities) {
 		m_MaxNumEntities = maxEntities;
 		m_Entities.reserve(maxEntities);
@@ -126,8 +138,8 @@ namespace CKE {
 
 		SingletonComponentRecord record{};
 		record.m_SizeInBytes = m_ComponentTypeData.at(componentID).m_SizeInBytes;
-		record.m_pComponentData = CKE::Alloc(m_ComponentTypeData.at(componentID).m_SizeInBytes);
-		memcpy(record.m_pComponentData, pComponentData, sizeof(SingletonComponentRecord));
+		record.m_pComponentData = Memory::Alloc(record.m_SizeInBytes);
+		memcpy(record.m_pComponentData, pComponentData, record.m_SizeInBytes);
 		m_IDToSingletonComponents.insert({componentID, record});
 	}
 
@@ -555,4 +567,158 @@ namespace CKE {
 		// Erase entity to record relationship
 		m_EntityToRecord.erase(entity);
 	}
+
+	void EntityDatabase::SaveSnapshot(Archive<BinaryWriter>& archive) {
+		u32 version = SNAPSHOT_VERSION;
+		u64 numEntities = m_Entities.size();
+		u32 nextEntityID = m_NextEntityID.GetValue();
+		u32 lastComponentTypeID = m_LastComponentTypeID.GetValue();
+		u32 lastArchetypeID = m_LastArchetypeID.GetValue();
+		archive << version << numEntities << nextEntityID << lastComponentTypeID << lastArchetypeID;
+
+		// Component registry
+		u64 numComponentTypes = m_ComponentTypes.size();
+		archive << numComponentTypes;
+		for (ComponentTypeID componentID : m_ComponentTypes) {
+			ComponentTypeData& typeData = m_ComponentTypeData.at(componentID);
+			u32                id = componentID.GetValue();
+			archive << id << typeData.m_Name << typeData.m_SizeInBytes << typeData.m_Alignment;
+		}
+
+		// Archetypes in creation order, each component column is written as a single blob
+		u64 numArchetypes = m_Archetypes.size();
+		archive << numArchetypes;
+		for (Archetype* pArchetype : m_Archetypes) {
+			u32 archetypeID = pArchetype->m_ID.GetValue();
+			u32 numRows = pArchetype->m_NumEntities;
+			u64 numComponents = pArchetype->m_ComponentSet.size();
+			archive << archetypeID << numRows << numComponents;
+			archive.SerializeBlob(pArchetype->m_ComponentSet.data(), numComponents * sizeof(ComponentTypeID));
+			archive.SerializeBlob(pArchetype->m_RowIndexToEntity.data(), numRows * sizeof(EntityID));
+			for (ComponentArray& componentArray : pArchetype->m_ArchTable) {
+				archive.SerializeBlob(componentArray.GetData(),
+				                      componentArray.GetNumComponents() * componentArray.GetCompSizeInBytes());
+			}
+		}
+
+		// Entity records, entities without components don't have an archetype row to rebuild them from
+		Vector<SnapshotEntityRecord> records{};
+		records.reserve(numEntities);
+		for (EntityID entityID : m_Entities) {
+			EntityRecord const& record = m_EntityToRecord.at(entityID);
+			records.push_back(SnapshotEntityRecord{
+				entityID.GetValue(), record.m_pArchetype->m_ID.GetValue(), record.m_EntityArchetypeRow
+			});
+		}
+		archive.SerializeBlob(records.data(), numEntities * sizeof(SnapshotEntityRecord));
+
+		// Singleton components
+		u64 numSingletons = m_IDToSingletonComponents.size();
+		archive << numSingletons;
+		for (auto& [componentID, singletonRecord] : m_IDToSingletonComponents) {
+			u32 id = componentID.GetValue();
+			archive << id << singletonRecord.m_SizeInBytes;
+			archive.SerializeBlob(singletonRecord.m_pComponentData, singletonRecord.m_SizeInBytes);
+		}
+	}
+
+	bool EntityDatabase::LoadSnapshot(BinaryInputArchive& archive) {
+		CKE_ASSERT(m_Entities.empty() && m_Archetypes.empty());
+
+		u32 version = 0;
+		u64 numEntities = 0;
+		u32 nextEntityID = 0;
+		u32 lastComponentTypeID = 0;
+		u32 lastArchetypeID = 0;
+		archive << version << numEntities << nextEntityID << lastComponentTypeID << lastArchetypeID;
+		if (version != SNAPSHOT_VERSION || numEntities > m_MaxNumEntities) { return false; }
+
+		// Component registry, the IDs are stored in the component arrays so they must be the same
+		u64 numComponentTypes = 0;
+		archive << numComponentTypes;
+		for (u64 i = 0; i < numComponentTypes; ++i) {
+			u32               id = 0;
+			ComponentTypeData typeData{};
+			archive << id << typeData.m_Name << typeData.m_SizeInBytes << typeData.m_Alignment;
+			if (archive.HasReadPastEnd()) { return false; }
+
+			ComponentTypeID componentID{id};
+			auto const      it = m_ComponentTypeData.find(componentID);
+			if (it == m_ComponentTypeData.end()) {
+				m_ComponentTypeData.insert({componentID, typeData});
+				m_ComponentTypes.push_back(componentID);
+			}
+			else if (it->second.m_Name != typeData.m_Name || it->second.m_SizeInBytes != typeData.m_SizeInBytes ||
+			         it->second.m_Alignment != typeData.m_Alignment) { return false; }
+		}
+		m_LastComponentTypeID = ComponentTypeID{std::max(m_LastComponentTypeID.GetValue(), lastComponentTypeID)};
+
+		// Archetypes are recreated in the same order with their original IDs and filled with bulk copies
+		u64 numArchetypes = 0;
+		archive << numArchetypes;
+		for (u64 i = 0; i < numArchetypes; ++i) {
+			u32 archetypeID = 0;
+			u32 numRows = 0;
+			u64 numComponents = 0;
+			archive << archetypeID << numRows << numComponents;
+			if (archive.HasReadPastEnd() || numRows > m_MaxNumEntities || numComponents > m_ComponentTypes.size()) {
+				return false;
+			}
+			// IDs are given in creation order starting from 1, any other order would give two archetypes the same ID
+			if (archetypeID <= m_LastArchetypeID.GetValue()) { return false; }
+
+			ComponentSet componentSet(numComponents);
+			archive.SerializeBlob(componentSet.data(), numComponents * sizeof(ComponentTypeID));
+			for (ComponentTypeID componentID : componentSet) {
+				if (!m_ComponentTypeData.contains(componentID)) { return false; }
+			}
+
+			m_LastArchetypeID = ArchetypeID{archetypeID - 1};
+			CreateArchetype(componentSet);
+			Archetype* pArchetype = m_Archetypes.back();
+			pArchetype->m_NumEntities = numRows;
+			archive.SerializeBlob(pArchetype->m_RowIndexToEntity.data(), numRows * sizeof(EntityID));
+			for (ComponentArray& componentArray : pArchetype->m_ArchTable) {
+				archive.SerializeBlob(componentArray.AppendComponentsToEnd(numRows),
+				                      numRows * componentArray.GetCompSizeInBytes());
+			}
+			if (archive.HasReadPastEnd()) { return false; }
+		}
+		if (lastArchetypeID < m_LastArchetypeID.GetValue()) { return false; }
+		m_LastArchetypeID = ArchetypeID{lastArchetypeID};
+
+		// Entity records
+		Vector<SnapshotEntityRecord> records(numEntities);
+		archive.SerializeBlob(records.data(), numEntities * sizeof(SnapshotEntityRecord));
+		if (archive.HasReadPastEnd()) { return false; }
+
+		m_EntityToRecord.reserve(numEntities);
+		for (SnapshotEntityRecord const& record : records) {
+			auto const it = m_IDToArchetype.find(ArchetypeID{record.m_ArchetypeID});
+			if (it == m_IDToArchetype.end() || record.m_ArchetypeRow >= it->second->m_NumEntities) { return false; }
+
+			EntityID const entityID{record.m_EntityID};
+			if (!m_EntityToRecord.insert({entityID, EntityRecord{it->second, record.m_ArchetypeRow}}).second) {
+				return false;
+			}
+			m_Entities.push_back(entityID);
+		}
+		m_NextEntityID = EntityID{nextEntityID};
+
+		// Singleton components
+		u64 numSingletons = 0;
+		archive << numSingletons;
+		for (u64 i = 0; i < numSingletons; ++i) {
+			u32                      id = 0;
+			SingletonComponentRecord singletonRecord{};
+			archive << id << singletonRecord.m_SizeInBytes;
+			if (archive.HasReadPastEnd() || singletonRecord.m_SizeInBytes > archive.GetRemainingBytes()) { return false; }
+
+			singletonRecord.m_pComponentData = Memory::Alloc(singletonRecord.m_SizeInBytes);
+			archive.SerializeBlob(singletonRecord.m_pComponentData, singletonRecord.m_SizeInBytes);
+			m_IDToSingletonComponents.insert({ComponentTypeID{id}, singletonRecord});
+		}
+
+		return !archive.HasReadPastEnd();
+	}
 }
@@ -1,6 +1,9 @@
 #include "CookieKat/Systems/ECS/EntityDatabase.h"
 #include <gtest/gtest.h>
 
+#include <chrono>
+#include <iostream>
+
 //-----------------------------------------------------------------------------
 // Utilities and Configuration
 //-----------------------------------------------------------------------------
@@ -465,3 +468,207 @@ TEST_F(Iterators_T, Iterator_Single_Multi) {
 }
 
 //-----------------------------------------------------------------------------
+// Snapshots
+//-----------------------------------------------------------------------------
+
+using Snapshots_T = EntityDatabase_T;
+
+TEST_F(Snapshots_T, Save_Load_Round_Trip) {
+	ConfigurationInfo c = DefaultComponentConfiguration(m_EntityDB);
+	EntityID          emptyEntity = m_EntityDB.CreateEntity();
+	for (u32 i = 0; i < c.m_EntitiesC.size(); ++i) {
+		m_EntityDB.GetComponent<I32_Component>(c.m_EntitiesC[i])->a = static_cast<i32>(i);
+	}
+	m_EntityDB.AddSingletonComponent<ComplexT1_Component>(ComplexT1_Component{4, 5, 6, 7});
+
+	BinaryOutputArchive writeArchive{};
+	m_EntityDB.SaveSnapshot(writeArchive);
+	writeArchive.WriteToFile("test_snapshot.hehe");
+
+	EntityDatabase loadedDB{};
+	loadedDB.Initialize(MAX_ENTITIES);
+	loadedDB.RegisterComponent<ComplexT1_Component>();
+	loadedDB.RegisterComponent<ComplexT2_Component>();
+	loadedDB.RegisterComponent<I32_Component>();
+	loadedDB.RegisterComponent<F64_Component>();
+	loadedDB.RegisterComponent<U8_Component>();
+
+	BinaryInputArchive readArchive{};
+	readArchive.ReadFromFile("test_snapshot.hehe");
+	ASSERT_TRUE(loadedDB.LoadSnapshot(readArchive));
+
+	EntityDatabaseStateSnapshot const original = m_Debugger.GetStateSnapshot();
+	EntityDatabaseStateSnapshot const loaded = loadedDB.GetDebugger().GetStateSnapshot();
+	EXPECT_EQ(loaded.m_NumEntities, original.m_NumEntities);
+	EXPECT_EQ(loaded.m_NumComponentTypes, original.m_NumComponentTypes);
+	EXPECT_EQ(loaded.m_NumArchetypes, original.m_NumArchetypes);
+
+	for (u32 i = 0; i < c.m_EntitiesC.size(); ++i) {
+		EXPECT_EQ(loadedDB.GetComponent<I32_Component>(c.m_EntitiesC[i])->a, static_cast<i32>(i));
+		EXPECT_EQ(loadedDB.GetComponent<U8_Component>(c.m_EntitiesC[i])->a, 255);
+	}
+	EXPECT_EQ(loadedDB.GetComponent<F64_Component>(c.m_EntitiesD[0])->a, 3.141516);
+	EXPECT_EQ(*loadedDB.GetSingletonComponent<ComplexT1_Component>(), (ComplexT1_Component{4, 5, 6, 7}));
+
+	QueryResult result{};
+	loadedDB.Query(QueryBuilder{}.Add<I32_Component>().Add<F64_Component>().Build(), &result);
+	EXPECT_EQ(result.m_TotalEntities, 200);
+
+	// The database keeps working after loading, new entities don't reuse the IDs of the snapshot
+	loadedDB.DeleteEntity(emptyEntity);
+	loadedDB.RemoveComponent<I32_Component>(c.m_EntitiesB[0]);
+	EntityID newEntity = loadedDB.CreateEntity();
+	loadedDB.AddComponent<I32_Component>(newEntity);
+	EXPECT_GT(newEntity.GetValue(), emptyEntity.GetValue());
+	EXPECT_EQ(loadedDB.GetComponent<I32_Component>(newEntity)->a, -53);
+	EXPECT_EQ(loadedDB.GetComponent<F64_Component>(c.m_EntitiesB[0])->a, 3.141516);
+
+	loadedDB.Shutdown();
+}
+
+TEST_F(Snapshots_T, Load_Mismatched_Registry_Fails) {
+	DefaultComponentConfiguration(m_EntityDB);
+
+	BinaryOutputArchive writeArchive{};
+	m_EntityDB.SaveSnapshot(writeArchive);
+	writeArchive.WriteToFile("test_snapshot_mismatch.hehe");
+
+	// Same number of components registered in a different order
+	EntityDatabase loadedDB{};
+	loadedDB.Initialize(MAX_ENTITIES);
+	loadedDB.RegisterComponent("U8_Component", sizeof(U8_Component), alignof(U8_Component));
+
+	BinaryInputArchive readArchive{};
+	readArchive.ReadFromFile("test_snapshot_mismatch.hehe");
+	EXPECT_FALSE(loadedDB.LoadSnapshot(readArchive));
+	loadedDB.Shutdown();
+}
+
+TEST_F(Snapshots_T, Load_Corrupted_Snapshot_Fails) {
+	EntityID const entityA = m_EntityDB.CreateEntity();
+	EntityID const entityB = m_EntityDB.CreateEntity();
+	m_EntityDB.AddComponent<I32_Component>(entityA);
+	m_EntityDB.AddComponent<I32_Component>(entityB);
+
+	BinaryOutputArchive writeArchive{};
+	m_EntityDB.SaveSnapshot(writeArchive);
+	writeArchive.WriteToFile("test_snapshot_corrupted.hehe");
+	Blob const snapshot = g_FileSystem.ReadBinaryFile("test_snapshot_corrupted.hehe");
+
+	// The component types are registered from the snapshot
+	auto loadCorrupted = [](Blob const& data) {
+		EntityDatabase loadedDB{};
+		loadedDB.Initialize(MAX_ENTITIES);
+
+		BinaryInputArchive readArchive{};
+		readArchive.ReadFromBlob(data);
+		bool const isLoaded = loadedDB.LoadSnapshot(readArchive);
+		loadedDB.Shutdown();
+		return isLoaded;
+	};
+	EXPECT_TRUE(loadCorrupted(snapshot));
+
+	// Entity records are the {u32 entity ID, u32 archetype ID, u64 row} before the singleton count
+	u64 const lastRecordOffset = snapshot.size() - sizeof(u64) - 16;
+	u64 const firstRecordOffset = lastRecordOffset - 16;
+
+	Blob      rowOutOfRange = snapshot;
+	u64 const invalidRow = 2;
+	memcpy(rowOutOfRange.data() + lastRecordOffset + 8, &invalidRow, sizeof(u64));
+	EXPECT_FALSE(loadCorrupted(rowOutOfRange));
+
+	Blob      duplicatedEntity = snapshot;
+	memcpy(duplicatedEntity.data() + lastRecordOffset, duplicatedEntity.data() + firstRecordOffset, sizeof(u32));
+	EXPECT_FALSE(loadCorrupted(duplicatedEntity));
+
+	// Header, component type count and archetype count come before the ID of the first archetype
+	EntityDatabase emptyDB{};
+	emptyDB.Initialize(MAX_ENTITIES);
+	emptyDB.CreateEntity();
+	BinaryOutputArchive emptyArchive{};
+	emptyDB.SaveSnapshot(emptyArchive);
+	emptyArchive.WriteToFile("test_snapshot_corrupted.hehe");
+	emptyDB.Shutdown();
+
+	Blob      zeroArchetypeID = g_FileSystem.ReadBinaryFile("test_snapshot_corrupted.hehe");
+	u64 const archetypeIDOffset = 4 + 8 + 4 + 4 + 4 + 8 + 8;
+	memset(zeroArchetypeID.data() + archetypeIDOffset, 0, sizeof(u32));
+	memset(zeroArchetypeID.data() + zeroArchetypeID.size() - sizeof(u64) - 12, 0, sizeof(u32)); // Record of the entity
+	EXPECT_FALSE(loadCorrupted(zeroArchetypeID));
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, it only prints timings. Run it with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+
+// Compares building a world like the stress test scene through the regular API against loading its snapshot
+TEST(EntityDatabase, DISABLED_Benchmark_Snapshot) {
+	struct Transform_Component
+	{
+		Mat4 m_LocalToWorld{1.0f};
+	};
+
+	struct Velocity_Component
+	{
+		Vec3 m_Velocity{0.0f, 1.0f, 0.0f};
+	};
+
+	// Best of a few runs, the databases are set up outside of the measured part
+	auto bestOf = [](auto&& setUp, auto&& function) {
+		f64 bestMs = std::numeric_limits<f64>::max();
+		for (u32 run = 0; run < 5; ++run) {
+			setUp();
+			auto const start = std::chrono::high_resolution_clock::now();
+			function();
+			auto const end = std::chrono::high_resolution_clock::now();
+			bestMs = std::min(bestMs, std::chrono::duration<f64, std::milli>(end - start).count());
+		}
+		return bestMs;
+	};
+
+	auto registerComponents = [](EntityDatabase& db) {
+		db.RegisterComponent<Transform_Component>();
+		db.RegisterComponent<Velocity_Component>();
+		db.RegisterComponent<I32_Component>();
+	};
+
+	for (u64 numEntities : {27'000ull, 1'000'000ull}) {
+		auto resetDB = [&](EntityDatabase& db) {
+			db = EntityDatabase{};
+			db.Initialize(numEntities);
+			registerComponents(db);
+		};
+
+		EntityDatabase sourceDB{};
+		f64 const      buildMs = bestOf([&] { resetDB(sourceDB); }, [&] {
+			for (u64 i = 0; i < numEntities; ++i) {
+				EntityID entity = sourceDB.CreateEntity();
+				sourceDB.AddComponent<Transform_Component>(entity);
+				sourceDB.AddComponent<Velocity_Component>(entity);
+				sourceDB.AddComponent<I32_Component>(entity, I32_Component{static_cast<i32>(i)});
+			}
+		});
+
+		f64 const saveMs = bestOf([] {}, [&] {
+			BinaryOutputArchive writeArchive{};
+			sourceDB.SaveSnapshot(writeArchive);
+			writeArchive.WriteToFile("bench_snapshot.hehe");
+		});
+
+		EntityDatabase loadedDB{};
+		f64 const      loadMs = bestOf([&] { resetDB(loadedDB); }, [&] {
+			BinaryInputArchive readArchive{};
+			readArchive.ReadFromFile("bench_snapshot.hehe");
+			EXPECT_TRUE(loadedDB.LoadSnapshot(readArchive));
+		});
+		EXPECT_EQ(loadedDB.GetDebugger().GetStateSnapshot().m_NumEntities, numEntities);
+		EXPECT_EQ(loadedDB.GetComponent<I32_Component>(EntityID{static_cast<u32>(numEntities)})->a,
+		          static_cast<i32>(numEntities - 1));
+
+		std::cout << "[Benchmark] " << numEntities << " entities: build " << buildMs << " ms, save snapshot "
+				<< saveMs << " ms, load snapshot " << loadMs << " ms\n";
+	}
+	std::remove("bench_snapshot.hehe");
+}
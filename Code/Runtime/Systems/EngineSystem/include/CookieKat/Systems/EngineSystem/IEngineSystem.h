@@ -2,6 +2,10 @@
 
 #include "CookieKat/Core/Platform/PlatformTime.h"
 
+namespace CKE {
+	class MetricsRegistry;
+}
+
 namespace CKE {
 	// ID That uniquely identifies an engine system
 	using EngineSystemID = u64;
@@ -9,5 +13,12 @@ namespace CKE {
 	// Base interface for all engine systems
 	// All of the engine systems can be accessed through the engine systems registry
 	// Example: RenderingSystem, EntitiesSystem, ResourcesSystem...
-	class IEngineSystem { };
+	class IEngineSystem
+	{
+	public:
+		virtual ~IEngineSystem() = default;
+
+		// Called by the engine at the end of every frame to update the metrics owned by the system
+		virtual void RecordMetrics(MetricsRegistry&) {}
+	};
 }
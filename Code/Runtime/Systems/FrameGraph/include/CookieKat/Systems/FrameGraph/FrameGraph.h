@@ -4,10 +4,12 @@
 #include "CookieKat/Core/Memory/Memory.h"
 
 #include "CookieKat/Systems/FrameGraph/FrameGraphRegistry.h"
+#include "CookieKat/Systems/FrameGraph/FrameGraphAliasing.h"
 #include "CookieKat/Systems/FrameGraph/FrameGraphBuilder.h"
 #include "CookieKat/Systems/FrameGraph/FrameGraphPass.h"
 #include "CookieKat/Systems/FrameGraph/FrameGraphResources.h"
 #include "CookieKat/Systems/FrameGraph/FrameGraphDB.h"
+#include "CookieKat/Systems/FrameGraph/FrameGraphRecording.h"
 #include "CookieKat/Systems/RenderAPI/CommandList.h"
 
 namespace CKE {
@@ -16,6 +18,22 @@ namespace CKE {
 }
 
 namespace CKE {
+	// Work done by FrameGraph::Compile(...) since the graph was initialized
+	struct FGCompileStats
+	{
+		u32 m_NumCompilations = 0;       // Compilations that rebuilt the resources and barriers
+		u32 m_NumCachedCompilations = 0; // Compilations skipped because the pass setups didn't change
+		u32 m_NumResizes = 0;            // Render target size changes patching the relative sized textures
+	};
+
+	// Memory of the transient textures of the current compilation
+	struct FGTransientMemoryStats
+	{
+		u64 m_UnaliasedSizeInBytes = 0; // Memory with an allocation for each texture
+		u64 m_AliasedSizeInBytes = 0;   // Memory of the heaps the textures are placed in
+		u32 m_NumHeaps = 0;
+	};
+
 	// FrameGraph/RenderGraph implementation to aid in the creation of modular rendering code split
 	// into render passes.
 	class FrameGraph
@@ -23,7 +41,8 @@ namespace CKE {
 	public:
 		//-----------------------------------------------------------------------------
 
-		void Initialize(RenderDevice* pDevice);
+		// With a TaskSystem the parallel graphics passes are recorded from its threads
+		void Initialize(RenderDevice* pDevice, TaskSystem* pTaskSystem = nullptr);
 		void Shutdown();
 
 		//-----------------------------------------------------------------------------
@@ -33,6 +52,11 @@ namespace CKE {
 		// The pointer must remain valid through all of the FrameGraph's lifetime.
 		void AddGraphicsPass(FGGraphicsRenderPass* pRenderPass);
 
+		// Add a new Graphics Pass that records its draws in parallel to the end of the graph.
+		//
+		// The pointer must remain valid through all of the FrameGraph's lifetime.
+		void AddParallelGraphicsPass(FGParallelGraphicsRenderPass* pRenderPass);
+
 		// Add a new Transfer Pass to the end of the graph.
 		//
 		// The pointer must remain valid through all of the FrameGraph's lifetime.
@@ -46,9 +70,20 @@ namespace CKE {
 		//-----------------------------------------------------------------------------
 
 		// Calculates the required information about the graph
-		// and prepares it for execution
+		// and prepares it for execution.
+		//
+		// The compilation is keyed by a hash of the pass setups, if they are the same
+		// as in the last compilation only the render target size is updated.
 		void Compile(UInt2 renderTargetSize);
 
+		inline FGCompileStats const& GetCompileStats() const { return m_CompileStats; }
+
+		// Transient textures that are never alive at the same time share memory, on by default.
+		// Changing it takes effect in the next compilation.
+		void SetTransientAliasing(bool enabled);
+
+		FGTransientMemoryStats GetTransientMemoryStats() const;
+
 		// Executes the configured graph, syncing using the provided objects
 		void Execute(CmdListWaitSemaphoreInfo waitInfoAtStart,
 		             SemaphoreHandle          signalSemaphoreOnFinish,
@@ -63,9 +98,13 @@ namespace CKE {
 		// it to its initial layout when finished.
 		void ImportTexture(FGImportedTextureDesc desc);
 
-		// Imports a new buffer and makes it available to all of the passes.
+		// Imports a new buffer or updates an existing one, for buffers that get recreated.
+		// Makes it available to all of the passes.
 		void ImportBuffer(FGResourceID fgID, BufferHandle bufferHandle);
 
+		// Imports a range of a buffer or updates it, for data sub-allocated from a bigger buffer each frame
+		void ImportBuffer(FGResourceID fgID, BufferRange range);
+
 		// Updates the data of an existing imported texture.
 		void UpdateImportedTexture(FGImportedTextureDesc desc);
 
@@ -95,6 +134,7 @@ namespace CKE {
 			RenderPassType      m_Type;           // Indicates the queue to which the pass will be submitted
 			FGRenderPass*       m_pPass;          // Ptr to the pass defining object
 			ExecuteResourcesCtx m_ExecuteContext; // All of the data accessible by the pass when executing
+			bool                m_IsParallel = false; // Graphics pass recorded in secondary cmd lists
 
 			// Data defined when compiling the graph
 			Vector<TextureBarrierDescription> m_TransitionsBefore; // Required texture barriers BEFORE executing the pass commands
@@ -112,6 +152,7 @@ namespace CKE {
 				m_WaitSemaphores.clear();
 				m_SignalSemaphores.clear();
 				m_SignalFences = FenceHandle{0};
+				m_ExecuteContext = ExecuteResourcesCtx{};
 			}
 
 			inline CmdListSubmitInfo GetSubmitInfo() {
@@ -123,6 +164,14 @@ namespace CKE {
 			}
 		};
 
+		// Transient textures placed together in the heaps of an aliasing plan
+		struct TransientTextureGroup
+		{
+			Vector<FGResourceID>     m_Textures; // In creation order
+			Vector<MemoryHeapHandle> m_Heaps;
+			FGTransientMemoryStats   m_MemoryStats;
+		};
+
 		// Tracks the deferred destruction of Semaphores that are still in use
 		struct DeletionEntry
 		{
@@ -131,15 +180,30 @@ namespace CKE {
 		};
 
 	private:
-		void CreateTransientResources(FrameGraphSetupContext setupCtx);
+		// Runs the setup of every pass, in pass order
+		Vector<FrameGraphSetupContext> SetupPasses();
+
+		// Hash of everything from the pass setups that the compilation depends on
+		u64 HashPassSetups(Vector<FrameGraphSetupContext> const& setups);
+
+		void CreateTransientResources(Vector<FrameGraphSetupContext> const& setups);
+		void DestroyTransientResources();
+
+		// Creates the textures of the group, and the heaps they are placed in when aliasing
+		void PlaceTransientTextures(TransientTextureGroup& group);
+		// Destroys the textures of the group and their heaps, the textures stay in the DB
+		void ReleaseTransientTextures(TransientTextureGroup& group);
 		void RecordResouceTransitions(CommandList& cmdList, RenderPassData& renderPass);
 
+		// Records the ranges of the pass in secondary cmd lists and executes them in order in the cmd list
+		void RecordParallelPass(CommandList& cmdList, RenderPassData& renderPass);
+
 		void ClearCurrentCompilation();
 
 		void AddPass(FGRenderPassID id, FGRenderPass* pPass, RenderPassType type);
 
-		void Compile_TransientTexUsageFlags();
-		void Compile_BarriersAndQueueSync();
+		void Compile_TransientTexUsageFlags(Vector<FrameGraphSetupContext>& setups);
+		void Compile_BarriersAndQueueSync(Vector<FrameGraphSetupContext>& setups);
 		void Execute_ReturnTexturesToOriginal(SemaphoreHandle signalSemaphoreOnFinish, FenceHandle signalFenceOnFinish);
 
 	private:
@@ -151,6 +215,21 @@ namespace CKE {
 		FrameGraphDB             m_DB{};                    // Graph resources
 		UInt2                    m_RenderTargetSize{0, 0};  // Current backbuffer size used to calculate relative texture sizes
 		Vector<DeletionEntry>    m_SemaphoreDeletionList{}; // Info to deffer the destruction of in-use data
+
+		bool            m_IsCompiled = false;
+		u64             m_CompiledSetupHash = 0;       // Hash of the pass setups used in the last compilation
+		SemaphoreHandle m_ExecutionFinishedSemaphore{}; // Signaled by the last pass, waited by the layout reverts
+		FGCompileStats  m_CompileStats{};
+
+		// Fixed and relative sized textures don't share heaps so a resize only repacks the relative ones
+		Map<FGResourceID, FGResourceLifetime> m_TransientLifetimes{};
+		TransientTextureGroup                 m_FixedSizeTextures{};
+		TransientTextureGroup                 m_RelativeSizeTextures{};
+		bool                                  m_UseTransientAliasing = true;
+
+		FGParallelRecorder    m_Recorder{};
+		Vector<FGRecordRange> m_RecordRanges{};      // Ranges of the parallel pass being recorded
+		Vector<CommandList>   m_SecondaryCmdLists{}; // Secondary list of each range, in range order
 	};
 }
 
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Systems/FrameGraph/FrameGraphBuilder.h"
+
+namespace CKE {
+	// Range of passes, both included, in which a transient resource holds data
+	struct FGResourceLifetime
+	{
+		u32 m_FirstPass = 0;
+		u32 m_LastPass = 0;
+
+		inline bool Overlaps(FGResourceLifetime const& other) const {
+			return m_FirstPass <= other.m_LastPass && other.m_FirstPass <= m_LastPass;
+		}
+	};
+
+	// Memory that a transient resource needs during its lifetime
+	struct FGAliasingRequest
+	{
+		FGResourceLifetime m_Lifetime;
+		u64                m_SizeInBytes = 0;
+		u64                m_Alignment = 1;
+		u32                m_MemoryTypeBits = ~0u;
+	};
+
+	// Where a request was placed, in the same order as the requests
+	struct FGAliasingPlacement
+	{
+		u32  m_HeapIdx = 0;
+		u64  m_OffsetInBytes = 0;
+		bool m_IsAliased = false; // Shares memory with another resource of the heap
+	};
+
+	struct FGAliasingHeap
+	{
+		u64 m_SizeInBytes = 0;
+		u64 m_Alignment = 1;        // Largest alignment of the resources in the heap
+		u32 m_MemoryTypeBits = ~0u; // Memory types that all the resources in the heap support
+	};
+
+	struct FGAliasingPlan
+	{
+		Vector<FGAliasingHeap>      m_Heaps;
+		Vector<FGAliasingPlacement> m_Placements;
+		u64                         m_UnaliasedSizeInBytes = 0; // Memory with one allocation per resource
+		u64                         m_AliasedSizeInBytes = 0;   // Memory of all the heaps
+	};
+
+	// Lifetime of every transient resource created in the setups, from the pass that creates it
+	// to the last pass that uses it. The setups must be in execution order.
+	Map<FGResourceID, FGResourceLifetime> ComputeTransientLifetimes(Vector<FrameGraphSetupContext> const& setups);
+
+	// Places the requests in as few heaps as possible, resources whose lifetimes don't overlap can share memory.
+	//
+	// The requests are placed from biggest to smallest at the lowest offset that doesn't collide with a
+	// placed resource alive at the same time. Heaps grow up to the max size, a request bigger than it
+	// gets a heap of its own.
+	FGAliasingPlan PackTransientResources(Vector<FGAliasingRequest> const& requests, u64 maxHeapSizeInBytes);
+}
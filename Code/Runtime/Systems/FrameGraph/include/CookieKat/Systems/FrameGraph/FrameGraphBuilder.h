@@ -3,6 +3,11 @@
 #include "CookieKat/Systems/FrameGraph/FrameGraphResources.h"
 #include "CookieKat/Systems/RenderAPI/Buffer.h"
 
+namespace CKE {
+	// Forward Declarations
+	struct FGResourceLifetime;
+}
+
 namespace CKE {
 	struct FGTextureDesc
 	{
@@ -55,6 +60,8 @@ namespace CKE {
 
 	private:
 		friend class FrameGraph;
+		friend Map<FGResourceID, FGResourceLifetime> ComputeTransientLifetimes(
+			Vector<FrameGraphSetupContext> const& setups);
 
 		Vector<FGPassResourceUsageInfo> m_ResourceUsageMetadata;
 		Vector<FGTextureAccessInfo>     m_TextureAccessInfo;
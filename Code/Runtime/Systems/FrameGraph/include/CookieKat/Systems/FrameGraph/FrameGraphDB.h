@@ -31,6 +31,7 @@ namespace CKE {
 		Vector<FGResourceID> GetAllTransientBuffers();
 
 		bool CheckImportedTextureExists(FGResourceID fgID);
+		bool CheckImportedBufferExists(FGResourceID fgID);
 
 	private:
 		Map<FGResourceID, FGResourceInfo> m_ResourceMetadata;
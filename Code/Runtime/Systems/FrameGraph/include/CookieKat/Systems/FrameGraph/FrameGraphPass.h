@@ -40,6 +40,36 @@ namespace CKE {
 		virtual void Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) = 0;
 	};
 
+	// Range of the items of a parallel pass that are recorded in the same command list
+	struct FGRecordRange
+	{
+		u32 m_Begin;
+		u32 m_End;
+		u32 m_ListIdx; // Position of the list in the pass, also the thread index for the RenderDevice
+	};
+
+	// Graphics pass that splits its draws in ranges recorded from multiple threads in secondary
+	// command lists, which the FrameGraph executes in order inside a single BeginRendering(...).
+	class FGParallelGraphicsRenderPass : public FGGraphicsRenderPass
+	{
+	public:
+		FGParallelGraphicsRenderPass() : FGGraphicsRenderPass() {};
+		FGParallelGraphicsRenderPass(FGRenderPassID id) : FGGraphicsRenderPass(id) { }
+
+		// Called in the main thread before recording the ranges, returns the number of items to record
+		// and fills the rendering info. The resources of the context and any descriptor or sampler
+		// shared by all the ranges must be created here, the ranges don't get the context.
+		virtual u32 BeginParallelExecute(ExecuteResourcesCtx& ctx, RenderDevice& rd, RenderingInfo& renderingInfo) = 0;
+
+		// Records the items of the range, can be called from any thread.
+		// Secondary lists don't inherit the pipeline or the bindings, every range must set them, and the
+		// descriptor sets created must use range.m_ListIdx as the thread index.
+		virtual void ExecuteRange(CommandList& cmdList, RenderDevice& rd, FGRecordRange const& range) = 0;
+
+		// Records all the items in the given command list, used when the pass is added as a regular graphics pass
+		void Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) override;
+	};
+
 	class FGTransferRenderPass : public FGRenderPass
 	{
 	public:
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+
+#include "CookieKat/Systems/FrameGraph/FrameGraphPass.h"
+#include "CookieKat/Systems/RenderAPI/RenderSettings.h"
+
+namespace CKE {
+	// Forward Declarations
+	class TaskSystem;
+}
+
+namespace CKE {
+	// Splits the items of the parallel passes in ranges and records them from the TaskSystem threads.
+	// Independent of the RenderDevice, the caller decides what recording a range means.
+	class FGParallelRecorder
+	{
+	public:
+		// Ranges with fewer items don't make up for the cost of the job and the secondary list
+		static constexpr u32 DEFAULT_MIN_ITEMS_PER_LIST = 64;
+
+		// Without a TaskSystem all the ranges are recorded in the calling thread
+		void Initialize(TaskSystem* pTaskSystem,
+		                u32         maxLists = RenderSettings::MAX_RECORDING_THREADS,
+		                u32         minItemsPerList = DEFAULT_MIN_ITEMS_PER_LIST);
+
+		// Fills the ranges with consecutive ranges that cover [0, numItems) in order.
+		// The split only depends on the item count and the number of threads, never on timing.
+		void SplitRanges(u32 numItems, Vector<FGRecordRange>& ranges) const;
+
+		// Calls the function once for every range and waits for all of them, ranges may run at
+		// the same time in different threads but never two with the same list index
+		void RecordRanges(Vector<FGRecordRange> const& ranges, Func<void(FGRecordRange const&)> const& recordFunc);
+
+		inline u32 GetMaxLists() const { return m_MaxLists; }
+
+	private:
+		TaskSystem* m_pTaskSystem = nullptr;
+		u32         m_MaxLists = 1;
+		u32         m_MinItemsPerList = DEFAULT_MIN_ITEMS_PER_LIST;
+	};
+}
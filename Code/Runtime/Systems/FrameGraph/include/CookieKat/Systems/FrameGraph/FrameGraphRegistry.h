@@ -2,6 +2,11 @@
 
 #include "CookieKat/Systems/FrameGraph/FrameGraphResources.h"
 
+namespace CKE {
+	// Forward Declarations
+	class FrameGraphDB;
+}
+
 namespace CKE {
 	// Available context for a pass when in the execution phase
 	class ExecuteResourcesCtx
@@ -22,6 +27,11 @@ namespace CKE {
 		//   Buffer is available for pass
 		BufferHandle GetBuffer(FGResourceID buffer);
 
+		// Returns the range of the buffer associated with the given ID, the whole buffer if it wasn't imported as a range
+		// Asserts:
+		//   Buffer is available for pass
+		BufferRange GetBufferRange(FGResourceID buffer);
+
 	private:
 		friend class FrameGraph;
 		friend class FrameGraphDB;
@@ -32,6 +42,6 @@ namespace CKE {
 		Vector<FGPassResourceUsageInfo>      m_ResourceUsages;
 		Map<FGResourceID, TextureHandle>     m_Textures;
 		Map<FGResourceID, TextureViewHandle> m_TextureViews;
-		Map<FGResourceID, BufferHandle>      m_Buffers;
+		Map<FGResourceID, BufferRange>       m_Buffers;
 	};
 }
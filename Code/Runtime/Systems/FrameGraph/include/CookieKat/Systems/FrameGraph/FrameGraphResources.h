@@ -73,6 +73,8 @@ namespace CKE {
 	{
 		FGResourceID m_ID;
 		BufferHandle m_Handle;
+		u64          m_OffsetInBytes = 0; // Range the passes bind, imported buffers can be a part of a bigger one
+		u64          m_SizeInBytes = 0;
 	};
 
 	struct FGTransientBuffer
@@ -152,7 +152,9 @@ namespace CKE {
 	}
 
 	FGTextureData* FrameGraphDB::GetTexture(FGResourceID fgID) {
-		return &m_Textures[fgID];
+		auto const it = m_Textures.find(fgID);
+		CKE_ASSERT(it != m_Textures.end());
+		return &it->second;
 	}
 
 	FGTransientTexture* FrameGraphDB::GetTransientTexture(FGResourceID fgID) {
@@ -164,7 +166,9 @@ namespace CKE {
 	}
 
 	FGBufferData* FrameGraphDB::GetBuffer(FGResourceID fgID) {
-		return &m_Buffers[fgID];
+		auto const it = m_Buffers.find(fgID);
+		CKE_ASSERT(it != m_Buffers.end());
+		return &it->second;
 	}
 
 	FGTransientBuffer* FrameGraphDB::GetTransientBuffer(FGResourceID fgID) {
@@ -190,26 +194,41 @@ namespace CKE {
 	bool FrameGraphDB::CheckImportedTextureExists(FGResourceID fgID) {
 		return m_ImportedTextures.contains(fgID);
 	}
+
+	bool FrameGraphDB::CheckImportedBufferExists(FGResourceID fgID) {
+		return m_ImportedBuffers.contains(fgID);
+	}
 }
 
 namespace CKE {
-	void FrameGraph::Initialize(RenderDevice* pDevice) {
+	void FrameGraph::Initialize(RenderDevice* pDevice, TaskSystem* pTaskSystem) {
 		CKE_ASSERT(pDevice != nullptr);
 		m_pDevice = pDevice;
+		m_Recorder.Initialize(pTaskSystem);
 	}
 
 	void FrameGraph::Shutdown() {
 		ClearCurrentCompilation();
+		DestroyTransientResources();
+
+		if (m_ExecutionFinishedSemaphore.IsValid()) {
+			m_pDevice->DestroySemaphore(m_ExecutionFinishedSemaphore);
+			m_ExecutionFinishedSemaphore = SemaphoreHandle{};
+		}
+		m_IsCompiled = false;
+	}
 
-		// Destroy all transient textures and buffers
+	void FrameGraph::DestroyTransientResources() {
+		ReleaseTransientTextures(m_FixedSizeTextures);
+		ReleaseTransientTextures(m_RelativeSizeTextures);
 		for (FGResourceID transientTexID : m_DB.GetAllTransientTextures()) {
-			FGTextureData* pTexture = m_DB.GetTexture(transientTexID);
-			m_pDevice->DestroyTextureView(pTexture->m_ViewHandle);
-			m_pDevice->DestroyTexture(pTexture->m_TexHandle);
 			// We can remove them while iterating because we iterate over a copy
 			// of the IDs and not the actual resources.
 			m_DB.RemoveTransientTexture(transientTexID);
 		}
+		m_FixedSizeTextures = TransientTextureGroup{};
+		m_RelativeSizeTextures = TransientTextureGroup{};
+		m_TransientLifetimes.clear();
 
 		for (FGResourceID transientBufferID : m_DB.GetAllTransientBuffers()) {
 			FGBufferData* pBuffer = m_DB.GetBuffer(transientBufferID);
@@ -235,6 +254,11 @@ namespace CKE {
 		AddPass(pRenderPass->m_ID, pRenderPass, RenderPassType::Graphics);
 	}
 
+	void FrameGraph::AddParallelGraphicsPass(FGParallelGraphicsRenderPass* pRenderPass) {
+		AddPass(pRenderPass->m_ID, pRenderPass, RenderPassType::Graphics);
+		m_Passes.back().m_IsParallel = true;
+	}
+
 	void FrameGraph::AddTransferPass(FGTransferRenderPass* pRenderPass) {
 		AddPass(pRenderPass->m_ID, pRenderPass, RenderPassType::Transfer);
 	}
@@ -243,36 +267,140 @@ namespace CKE {
 		AddPass(pRenderPass->m_ID, pRenderPass, RenderPassType::Compute);
 	}
 
-	void FrameGraph::CreateTransientResources(FrameGraphSetupContext setupCtx) {
-		// Create all transient textures and buffers
-		for (auto& [fgID, textureDesc, extra] : setupCtx.m_CreateTextures) {
-			if (extra.m_UseSizeRelativeToRenderTarget) {
-				textureDesc.m_Size = {
-					m_RenderTargetSize.x * extra.m_RelativeSize.x,
-					m_RenderTargetSize.y * extra.m_RelativeSize.y,
-					1
-				};
+	void FrameGraph::CreateTransientResources(Vector<FrameGraphSetupContext> const& setups) {
+		m_TransientLifetimes = ComputeTransientLifetimes(setups);
+
+		// The textures are registered first, they are only created once all of them are known so they can be packed
+		for (FrameGraphSetupContext const& setupCtx : setups) {
+			for (auto [fgID, textureDesc, extra] : setupCtx.m_CreateTextures) {
+				if (extra.m_UseSizeRelativeToRenderTarget) {
+					textureDesc.m_Size = {
+						m_RenderTargetSize.x * extra.m_RelativeSize.x,
+						m_RenderTargetSize.y * extra.m_RelativeSize.y,
+						1
+					};
+				}
+				m_DB.AddTransientTexture(fgID, TextureHandle{}, textureDesc, TextureViewHandle{}, extra);
+
+				TransientTextureGroup& group = extra.m_UseSizeRelativeToRenderTarget
+					                               ? m_RelativeSizeTextures
+					                               : m_FixedSizeTextures;
+				group.m_Textures.push_back(fgID);
+			}
+			for (auto const& [fgID, bufferDesc] : setupCtx.m_CreateBuffers) {
+				BufferHandle bufferHandle = m_pDevice->CreateBuffer(bufferDesc);
+				m_DB.AddTransientBuffer(fgID, bufferHandle, bufferDesc);
 			}
+		}
 
-			TextureHandle textureHandle = m_pDevice->CreateTexture(textureDesc);
+		PlaceTransientTextures(m_FixedSizeTextures);
+		PlaceTransientTextures(m_RelativeSizeTextures);
 
-			TextureViewDesc viewDesc{};
-			viewDesc.m_Texture = textureHandle;
-			viewDesc.m_Format = textureDesc.m_Format;
-			viewDesc.m_Type = TextureViewType::Tex2D;
-			viewDesc.m_AspectMask = textureDesc.m_AspectMask;
-			if (static_cast<bool>(textureDesc.m_AspectMask & TextureAspectMask::Depth)) {
-				// HACK
-				viewDesc.m_AspectMask = TextureAspectMask::Depth;
+		FGTransientMemoryStats const stats = GetTransientMemoryStats();
+		CKE_LOG(Debug, Rendering, "FrameGraph transient textures: {} KiB in {} heaps, {} KiB without aliasing",
+		        stats.m_AliasedSizeInBytes / 1024, stats.m_NumHeaps, stats.m_UnaliasedSizeInBytes / 1024);
+	}
+
+	TextureViewHandle CreateFullTextureView(RenderDevice* pDevice, TextureHandle texHandle, TextureDesc const& desc) {
+		TextureViewDesc viewDesc{};
+		viewDesc.m_Texture = texHandle;
+		viewDesc.m_Format = desc.m_Format;
+		viewDesc.m_Type = TextureViewType::Tex2D;
+		viewDesc.m_AspectMask = desc.m_AspectMask;
+		viewDesc.m_BaseArrayLayer = 0;
+		viewDesc.m_ArrayLayerCount = desc.m_ArraySize;
+		viewDesc.m_BaseMipLevel = 0;
+		viewDesc.m_MipLevelCount = desc.m_MipLevels;
+		if (static_cast<bool>(desc.m_AspectMask & TextureAspectMask::Depth)) {
+			// HACK
+			viewDesc.m_AspectMask = TextureAspectMask::Depth;
+		}
+		return pDevice->CreateTextureView(viewDesc);
+	}
+
+	void FrameGraph::PlaceTransientTextures(TransientTextureGroup& group) {
+		// Bigger heaps pack better but are harder to find for the driver after a resize
+		constexpr u64 MAX_HEAP_SIZE_IN_BYTES = 256ull * 1024 * 1024;
+
+		Vector<FGAliasingRequest> requests(group.m_Textures.size());
+		for (u64 i = 0; i < group.m_Textures.size(); ++i) {
+			FGTextureData const*     pTex = m_DB.GetTexture(group.m_Textures[i]);
+			MemoryRequirements const memory = m_pDevice->GetTextureMemoryRequirements(pTex->m_TexDesc);
+			requests[i].m_Lifetime = m_TransientLifetimes.at(group.m_Textures[i]);
+			requests[i].m_SizeInBytes = memory.m_SizeInBytes;
+			requests[i].m_Alignment = memory.m_Alignment;
+			requests[i].m_MemoryTypeBits = memory.m_MemoryTypeBits;
+		}
+		FGAliasingPlan const plan = PackTransientResources(requests, MAX_HEAP_SIZE_IN_BYTES);
+
+		group.m_MemoryStats.m_UnaliasedSizeInBytes = plan.m_UnaliasedSizeInBytes;
+		if (m_UseTransientAliasing) {
+			group.m_MemoryStats.m_AliasedSizeInBytes = plan.m_AliasedSizeInBytes;
+			group.m_MemoryStats.m_NumHeaps = static_cast<u32>(plan.m_Heaps.size());
+			for (FGAliasingHeap const& heap : plan.m_Heaps) {
+				group.m_Heaps.push_back(m_pDevice->CreateMemoryHeap(
+					MemoryRequirements{heap.m_SizeInBytes, heap.m_Alignment, heap.m_MemoryTypeBits}));
+			}
+		}
+		else {
+			group.m_MemoryStats.m_AliasedSizeInBytes = plan.m_UnaliasedSizeInBytes;
+			group.m_MemoryStats.m_NumHeaps = 0;
+		}
+
+		for (u64 i = 0; i < group.m_Textures.size(); ++i) {
+			FGTextureData* pTex = m_DB.GetTexture(group.m_Textures[i]);
+			if (m_UseTransientAliasing) {
+				FGAliasingPlacement const& placement = plan.m_Placements[i];
+				pTex->m_TexHandle = m_pDevice->CreatePlacedTexture(pTex->m_TexDesc, group.m_Heaps[placement.m_HeapIdx],
+				                                                   placement.m_OffsetInBytes);
+
+				// The memory may have been written by another texture in this or the previous frame, the first
+				// barrier waits for all of the writes. Done for every placed texture and not only the aliased
+				// ones so a resize, that repacks the heaps, never needs to patch the compiled barriers.
+				pTex->m_InitialAccess.m_Stage = PipelineStage::AllCommands;
+				pTex->m_InitialAccess.m_Access = AccessMask::ColorAttachment_Write |
+						AccessMask::DepthStencilAttachment_Write | AccessMask::Shader_Write | AccessMask::Transfer_Write;
+			}
+			else {
+				pTex->m_TexHandle = m_pDevice->CreateTexture(pTex->m_TexDesc);
+				pTex->m_InitialAccess.m_Stage = PipelineStage::TopOfPipe;
+				pTex->m_InitialAccess.m_Access = AccessMask::None;
 			}
-			TextureViewHandle viewHandle = m_pDevice->CreateTextureView(viewDesc);
+			pTex->m_ViewHandle = CreateFullTextureView(m_pDevice, pTex->m_TexHandle, pTex->m_TexDesc);
+		}
+	}
+
+	void FrameGraph::ReleaseTransientTextures(TransientTextureGroup& group) {
+		// The textures must be destroyed before the heaps they are placed in
+		for (FGResourceID const& texID : group.m_Textures) {
+			FGTextureData* pTex = m_DB.GetTexture(texID);
+			m_pDevice->DestroyTextureView(pTex->m_ViewHandle);
+			m_pDevice->DestroyTexture(pTex->m_TexHandle);
+			pTex->m_TexHandle = TextureHandle{};
+			pTex->m_ViewHandle = TextureViewHandle{};
+		}
+		for (MemoryHeapHandle heap : group.m_Heaps) {
+			m_pDevice->DestroyMemoryHeap(heap);
+		}
+		group.m_Heaps.clear();
+		group.m_MemoryStats = FGTransientMemoryStats{};
+	}
 
-			m_DB.AddTransientTexture(fgID, textureHandle, textureDesc, viewHandle, extra);
+	void FrameGraph::SetTransientAliasing(bool enabled) {
+		if (enabled != m_UseTransientAliasing) {
+			m_UseTransientAliasing = enabled;
+			m_IsCompiled = false;
 		}
-		for (auto& [fgID, bufferDesc] : setupCtx.m_CreateBuffers) {
-			BufferHandle bufferHandle = m_pDevice->CreateBuffer(bufferDesc);
-			m_DB.AddTransientBuffer(fgID, bufferHandle, bufferDesc);
+	}
+
+	FGTransientMemoryStats FrameGraph::GetTransientMemoryStats() const {
+		FGTransientMemoryStats stats{};
+		for (TransientTextureGroup const* pGroup : {&m_FixedSizeTextures, &m_RelativeSizeTextures}) {
+			stats.m_UnaliasedSizeInBytes += pGroup->m_MemoryStats.m_UnaliasedSizeInBytes;
+			stats.m_AliasedSizeInBytes += pGroup->m_MemoryStats.m_AliasedSizeInBytes;
+			stats.m_NumHeaps += pGroup->m_MemoryStats.m_NumHeaps;
 		}
+		return stats;
 	}
 
 	FGTextureAccessInfo* FindInfoWithID(FGResourceID id, Vector<FGTextureAccessInfo>& vec) {
@@ -288,6 +416,9 @@ namespace CKE {
 		for (RenderPassData& node : m_Passes) {
 			// Deffer the destruction of the semaphores so we are sure they are not in use
 			for (SemaphoreHandle semaphoreHandle : node.m_SignalSemaphores) {
+				if (semaphoreHandle == m_ExecutionFinishedSemaphore) {
+					continue; // Kept through compilations
+				}
 				m_SemaphoreDeletionList.push_back({
 					RenderSettings::MAX_FRAMES_IN_FLIGHT, semaphoreHandle
 				});
@@ -297,7 +428,108 @@ namespace CKE {
 		}
 	}
 
-	void FrameGraph::Compile_TransientTexUsageFlags() {
+	Vector<FrameGraphSetupContext> FrameGraph::SetupPasses() {
+		Vector<FrameGraphSetupContext> setups(m_Passes.size());
+		for (u64 i = 0; i < m_Passes.size(); ++i) {
+			m_Passes[i].m_pPass->Setup(setups[i]);
+		}
+		return setups;
+	}
+
+	// Incremental FNV-1a hash of the pass setup declarations
+	class FGSetupHasher
+	{
+	public:
+		void Add(void const* pData, u64 sizeInBytes) {
+			u8 const* pBytes = static_cast<u8 const*>(pData);
+			for (u64 i = 0; i < sizeInBytes; ++i) {
+				m_Hash = (m_Hash ^ pBytes[i]) * 1099511628211u;
+			}
+		}
+
+		void Add(String const& str) {
+			Add(static_cast<u64>(str.size()));
+			Add(str.data(), str.size());
+		}
+
+		template <typename T>
+			requires std::is_arithmetic_v<T> || std::is_enum_v<T>
+		void Add(T value) { Add(&value, sizeof(T)); }
+
+		void Add(FGPipelineAccessInfo const& access) {
+			Add(access.m_Stage);
+			Add(access.m_Access);
+			Add(access.m_Layout);
+			Add(access.m_Aspect);
+			Add(access.m_LoadOp);
+		}
+
+		inline u64 GetHash() const { return m_Hash; }
+
+	private:
+		u64 m_Hash = 14695981039346656037u;
+	};
+
+	u64 FrameGraph::HashPassSetups(Vector<FrameGraphSetupContext> const& setups) {
+		FGSetupHasher hasher{};
+		for (u64 i = 0; i < m_Passes.size(); ++i) {
+			RenderPassData const&         pass = m_Passes[i];
+			FrameGraphSetupContext const& setup = setups[i];
+			hasher.Add(pass.m_pPass->m_ID);
+			hasher.Add(pass.m_Type);
+			hasher.Add(pass.m_IsParallel);
+
+			// Transient resources, the size of the relative ones is patched on resize so it is not part of the hash
+			for (auto const& [fgID, desc, extra] : setup.m_CreateTextures) {
+				hasher.Add(fgID);
+				hasher.Add(desc.m_Format);
+				hasher.Add(desc.m_TextureType);
+				hasher.Add(desc.m_AspectMask);
+				hasher.Add(desc.m_Usage);
+				hasher.Add(desc.m_ArraySize);
+				hasher.Add(desc.m_MipLevels);
+				hasher.Add(desc.m_SampleCount);
+				hasher.Add(desc.m_MiscFlags);
+				hasher.Add(extra.m_UseSizeRelativeToRenderTarget);
+				if (extra.m_UseSizeRelativeToRenderTarget) {
+					hasher.Add(extra.m_RelativeSize.x);
+					hasher.Add(extra.m_RelativeSize.y);
+				}
+				else {
+					hasher.Add(desc.m_Size.x);
+					hasher.Add(desc.m_Size.y);
+					hasher.Add(desc.m_Size.z);
+				}
+			}
+			for (auto const& [fgID, desc] : setup.m_CreateBuffers) {
+				hasher.Add(fgID);
+				hasher.Add(desc.m_Usage);
+				hasher.Add(desc.m_MemoryAccess);
+				hasher.Add(desc.m_DuplicationStrategy);
+				hasher.Add(desc.m_SizeInBytes);
+				hasher.Add(desc.m_StrideInBytes);
+			}
+
+			// Resource usages, they define the barriers and the queue syncing
+			for (FGPassResourceUsageInfo const& usage : setup.m_ResourceUsageMetadata) {
+				hasher.Add(usage.m_ID);
+				hasher.Add(usage.m_Type);
+				hasher.Add(usage.m_AccessOp);
+			}
+			for (FGTextureAccessInfo const& texAccess : setup.m_TextureAccessInfo) {
+				hasher.Add(texAccess.m_ID);
+				hasher.Add(texAccess.m_Access);
+
+				// The first barrier of an imported texture starts from its initial state
+				if (m_DB.CheckImportedTextureExists(texAccess.m_ID)) {
+					hasher.Add(m_DB.GetTexture(texAccess.m_ID)->m_InitialAccess);
+				}
+			}
+		}
+		return hasher.GetHash();
+	}
+
+	void FrameGraph::Compile_TransientTexUsageFlags(Vector<FrameGraphSetupContext>& setups) {
 		struct UsageData
 		{
 			TextureUsage m_Usage{};
@@ -305,11 +537,7 @@ namespace CKE {
 		Map<FGResourceID, UsageData> usageDataMap{};
 
 		// Store references to all of the transient textures to create
-		for (RenderPassData& nodeData : m_Passes) {
-			FGRenderPass*          pPass = (FGRenderPass*)nodeData.m_pPass;
-			FrameGraphSetupContext setupCtx{};
-			pPass->Setup(setupCtx);
-
+		for (FrameGraphSetupContext const& setupCtx : setups) {
 			for (auto&& createInfo : setupCtx.m_CreateTextures) {
 				if (!usageDataMap.contains(createInfo.m_ID)) {
 					usageDataMap.insert({createInfo.m_ID, UsageData{}});
@@ -319,11 +547,7 @@ namespace CKE {
 
 		// For each pass, check if they access a transient texture, if so then
 		// check the access mask and add the necessary usage to the current usages
-		for (RenderPassData& nodeData : m_Passes) {
-			FGRenderPass*          pPass = (FGRenderPass*)nodeData.m_pPass;
-			FrameGraphSetupContext setupCtx{};
-			pPass->Setup(setupCtx);
-
+		for (FrameGraphSetupContext const& setupCtx : setups) {
 			for (auto&& accessInfo : setupCtx.m_TextureAccessInfo) {
 				if (usageDataMap.contains(accessInfo.m_ID)) {
 					TextureUsage usage = usageDataMap[accessInfo.m_ID].m_Usage;
@@ -355,18 +579,13 @@ namespace CKE {
 		}
 
 		// Update the transient texture descriptions and create them
-		for (RenderPassData& nodeData : m_Passes) {
-			FGRenderPass*          pPass = (FGRenderPass*)nodeData.m_pPass;
-			FrameGraphSetupContext setupCtx{};
-			pPass->Setup(setupCtx);
-
+		for (FrameGraphSetupContext& setupCtx : setups) {
 			for (auto&& createInfo : setupCtx.m_CreateTextures) {
 				createInfo.m_Desc.m_Usage = usageDataMap[createInfo.m_ID].m_Usage;
 				createInfo.m_Desc.m_ConcurrentSharingMode = false;
 			}
-
-			CreateTransientResources(setupCtx);
 		}
+		CreateTransientResources(setups);
 	}
 
 	TextureBarrierDescription TexBarrierFromToAccess(FGPipelineAccessInfo src,
@@ -396,7 +615,7 @@ namespace CKE {
 		return FGTextureAccessInfo{};
 	}
 
-	void FrameGraph::Compile_BarriersAndQueueSync() {
+	void FrameGraph::Compile_BarriersAndQueueSync(Vector<FrameGraphSetupContext>& setups) {
 		// Contains info of the last usage of a resource
 		struct ResourceTrackingInfo
 		{
@@ -415,11 +634,9 @@ namespace CKE {
 
 		//-----------------------------------------------------------------------------
 
-		for (RenderPassData& passData : m_Passes) {
-			// Get resources accessed by the pass by calling its setup
-			FGRenderPass*          pPass = (FGRenderPass*)passData.m_pPass;
-			FrameGraphSetupContext setupCtx{};
-			pPass->Setup(setupCtx);
+		for (u64 passIdx = 0; passIdx < m_Passes.size(); ++passIdx) {
+			RenderPassData&         passData = m_Passes[passIdx];
+			FrameGraphSetupContext& setupCtx = setups[passIdx];
 
 			// Setup Initial References
 			if (isFirstPassInGraph) {
@@ -534,18 +751,34 @@ namespace CKE {
 
 	// Adds the already calculated barriers for the resources to the command list
 	void FrameGraph::RecordResouceTransitions(CommandList& cmdList, RenderPassData& renderPass) {
-		cmdList.Barrier(renderPass.m_TransitionsBefore);
+		cmdList.Barrier(renderPass.m_TransitionsBefore.data(), static_cast<u32>(renderPass.m_TransitionsBefore.size()));
 	}
 
-	SemaphoreHandle i_PassExecutionFinishedSemaphore{};
-
 	void FrameGraph::Compile(UInt2 renderTargetSize) {
+		// The setups are only called once, everything in the compilation is derived from them
+		Vector<FrameGraphSetupContext> setups = SetupPasses();
+		u64 const                      setupHash = HashPassSetups(setups);
+
+		if (m_IsCompiled && setupHash == m_CompiledSetupHash) {
+			m_CompileStats.m_NumCachedCompilations++;
+			UpdateRenderTargetSize(renderTargetSize);
+			return;
+		}
+
 		m_RenderTargetSize = renderTargetSize;
-		i_PassExecutionFinishedSemaphore = m_pDevice->CreateSemaphoreGPU();
+		if (!m_ExecutionFinishedSemaphore.IsValid()) {
+			m_ExecutionFinishedSemaphore = m_pDevice->CreateSemaphoreGPU();
+		}
 
+		// The transient resources of the previous compilation may have a different description or usage
 		ClearCurrentCompilation();
-		Compile_TransientTexUsageFlags();
-		Compile_BarriersAndQueueSync();
+		DestroyTransientResources();
+		Compile_TransientTexUsageFlags(setups);
+		Compile_BarriersAndQueueSync(setups);
+
+		m_IsCompiled = true;
+		m_CompiledSetupHash = setupHash;
+		m_CompileStats.m_NumCompilations++;
 	}
 
 	void FrameGraph::Execute_ReturnTexturesToOriginal(SemaphoreHandle signalSemaphoreOnFinish, FenceHandle signalFenceOnFinish) {
@@ -588,7 +821,7 @@ namespace CKE {
 
 		CmdListSubmitInfo        revertLayoutsSubmInfo{};
 		CmdListWaitSemaphoreInfo wait1{};
-		wait1.m_Semaphore = i_PassExecutionFinishedSemaphore;
+		wait1.m_Semaphore = m_ExecutionFinishedSemaphore;
 		wait1.m_Stage = PipelineStage::BottomOfPipe;
 		revertLayoutsSubmInfo.m_WaitSemaphores.push_back(wait1);
 		revertLayoutsSubmInfo.m_SignalSemaphores.push_back(signalSemaphoreOnFinish);
@@ -621,13 +854,36 @@ namespace CKE {
 		return Vec3{Random::F32(0, 1), Random::F32(0, 1), Random::F32(0, 1)};
 	}
 
+	void FrameGraph::RecordParallelPass(CommandList& cmdList, RenderPassData& renderPass) {
+		auto pPass = (FGParallelGraphicsRenderPass*)renderPass.m_pPass;
+
+		RenderingInfo renderingInfo{};
+		u32 const     numItems = pPass->BeginParallelExecute(renderPass.m_ExecuteContext, *m_pDevice, renderingInfo);
+
+		m_Recorder.SplitRanges(numItems, m_RecordRanges);
+		m_SecondaryCmdLists.resize(m_RecordRanges.size());
+		m_Recorder.RecordRanges(m_RecordRanges, [&](FGRecordRange const& range) {
+			CommandList secondaryCmdList = m_pDevice->GetSecondaryGraphicsCmdList(range.m_ListIdx);
+			secondaryCmdList.BeginSecondary(renderingInfo);
+			pPass->ExecuteRange(secondaryCmdList, *m_pDevice, range);
+			secondaryCmdList.End();
+			m_SecondaryCmdLists[range.m_ListIdx] = secondaryCmdList;
+		});
+
+		// Executing them in range order makes the result independent of which thread recorded each list
+		renderingInfo.m_ContentsInSecondaryCmdLists = true;
+		cmdList.BeginRendering(renderingInfo);
+		cmdList.ExecuteCommands(m_SecondaryCmdLists);
+		cmdList.EndRendering();
+	}
+
 	void FrameGraph::Execute(CmdListWaitSemaphoreInfo waitInfoAtStart,
 	                         SemaphoreHandle          signalSemaphoreOnFinish,
 	                         FenceHandle              signalFenceOnFinish) {
 		// The last pass must always be submitted and sync
 		RenderPassData& finalRenderPassData = m_Passes[m_Passes.size() - 1];
 		finalRenderPassData.m_SignalSemaphores.clear(); // TODO: Not great to just clear all
-		finalRenderPassData.m_SignalSemaphores.push_back(i_PassExecutionFinishedSemaphore);
+		finalRenderPassData.m_SignalSemaphores.push_back(m_ExecutionFinishedSemaphore);
 		finalRenderPassData.m_SubmitAfterExecuting = true;
 
 		//-----------------------------------------------------------------------------
@@ -652,7 +908,12 @@ namespace CKE {
 
 				gfxState.m_CmdList.BeginDebugLabel(pPass->m_ID.c_str(), RandomColor());
 				RecordResouceTransitions(gfxState.m_CmdList, passData);
-				pPass->Execute(passData.m_ExecuteContext, gfxState.m_CmdList, *m_pDevice);
+				if (passData.m_IsParallel) {
+					RecordParallelPass(gfxState.m_CmdList, passData);
+				}
+				else {
+					pPass->Execute(passData.m_ExecuteContext, gfxState.m_CmdList, *m_pDevice);
+				}
 				gfxState.m_CmdList.EndDebugLabel();
 
 				if (passData.m_SubmitAfterExecuting) {
@@ -780,7 +1041,18 @@ namespace CKE {
 	}
 
 	void FrameGraph::ImportBuffer(FGResourceID fgID, BufferHandle bufferHandle) {
-		m_DB.AddImportedBuffer(fgID, bufferHandle, {});
+		ImportBuffer(fgID, BufferRange{bufferHandle});
+	}
+
+	void FrameGraph::ImportBuffer(FGResourceID fgID, BufferRange range) {
+		// The passes get the buffer handles when executed, updating it is enough
+		if (!m_DB.CheckImportedBufferExists(fgID)) {
+			m_DB.AddImportedBuffer(fgID, range.m_Buffer, {});
+		}
+		FGBufferData* pBuffer = m_DB.GetBuffer(fgID);
+		pBuffer->m_Handle = range.m_Buffer;
+		pBuffer->m_OffsetInBytes = range.m_OffsetInBytes;
+		pBuffer->m_SizeInBytes = range.m_SizeInBytes;
 	}
 
 	void FrameGraph::UpdateImportedTexture(FGImportedTextureDesc desc) {
@@ -842,51 +1114,44 @@ namespace CKE {
 		}
 
 		m_RenderTargetSize = newSize;
+		m_CompileStats.m_NumResizes++;
 
 		// Go through all of the textures with size relative to the swapchain
-		// and recreate them with the appropriate new size
-		for (FGResourceID texID : m_DB.GetAllTransientTextures()) {
+		// and recreate them with the appropriate new size, repacking their heaps
+		Vector<TextureHandle> oldHandles{};
+		for (FGResourceID const& texID : m_RelativeSizeTextures.m_Textures) {
+			oldHandles.push_back(m_DB.GetTexture(texID)->m_TexHandle);
+		}
+		ReleaseTransientTextures(m_RelativeSizeTextures);
+
+		for (FGResourceID const& texID : m_RelativeSizeTextures.m_Textures) {
 			FGTextureData*      t1 = m_DB.GetTexture(texID);
 			FGTransientTexture* t2 = m_DB.GetTransientTexture(texID);
+			t1->m_TexDesc.m_Size = {
+				m_RenderTargetSize.x * t2->m_Extra.m_RelativeSize.x,
+				m_RenderTargetSize.y * t2->m_Extra.m_RelativeSize.y,
+				1
+			};
+		}
+		PlaceTransientTextures(m_RelativeSizeTextures);
 
-			if (t2->m_Extra.m_UseSizeRelativeToRenderTarget) {
-				m_pDevice->DestroyTexture(t1->m_TexHandle);
-
-				// Calculate new relative size and create the texture + its full view
-				t1->m_TexDesc.m_Size = {
-					m_RenderTargetSize.x * t2->m_Extra.m_RelativeSize.x,
-					m_RenderTargetSize.y * t2->m_Extra.m_RelativeSize.y,
-					1
-				};
-				TextureHandle newHandle = m_pDevice->CreateTexture(t1->m_TexDesc);
-
-				TextureViewDesc viewDesc{};
-				viewDesc.m_Format = t1->m_TexDesc.m_Format;
-				viewDesc.m_Type = TextureViewType::Tex2D;
-				viewDesc.m_AspectMask = t1->m_TexDesc.m_AspectMask;
-				viewDesc.m_BaseArrayLayer = 0;
-				viewDesc.m_ArrayLayerCount = t1->m_TexDesc.m_ArraySize;
-				viewDesc.m_BaseMipLevel = 0;
-				viewDesc.m_MipLevelCount = t1->m_TexDesc.m_MipLevels;
-				viewDesc.m_Texture = newHandle;
-				if (static_cast<bool>(viewDesc.m_AspectMask & TextureAspectMask::Depth)) {
-					viewDesc.m_AspectMask = TextureAspectMask::Depth;
-				}
-				TextureViewHandle viewHandle = m_pDevice->CreateTextureView(viewDesc);
+		Map<TextureHandle, TextureHandle> recreatedTextures{};
+		for (u64 i = 0; i < oldHandles.size(); ++i) {
+			recreatedTextures.insert({oldHandles[i], m_DB.GetTexture(m_RelativeSizeTextures.m_Textures[i])->m_TexHandle});
+		}
 
-				// We have to update the already compiled barriers
-				for (RenderPassData& pass : m_Passes) {
-					for (TextureBarrierDescription& barrier : pass.m_TransitionsBefore) {
-						if (barrier.m_Texture == t1->m_TexHandle) {
-							barrier.m_Texture = newHandle;
-						}
-					}
+		// We have to update the already compiled barriers, the rest of the compilation doesn't depend on the size
+		auto patchBarriers = [&recreatedTextures](Vector<TextureBarrierDescription>& barriers) {
+			for (TextureBarrierDescription& barrier : barriers) {
+				auto it = recreatedTextures.find(barrier.m_Texture);
+				if (it != recreatedTextures.end()) {
+					barrier.m_Texture = it->second;
 				}
-
-				// Update the transient texture
-				t1->m_TexHandle = newHandle;
-				t1->m_ViewHandle = viewHandle;
 			}
+		};
+		for (RenderPassData& pass : m_Passes) {
+			patchBarriers(pass.m_TransitionsBefore);
+			patchBarriers(pass.m_TransitionsAfter);
 		}
 	}
 }
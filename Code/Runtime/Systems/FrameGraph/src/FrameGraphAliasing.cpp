@@ -0,0 +1,136 @@
+#include "CookieKat/Systems/FrameGraph/FrameGraphAliasing.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <algorithm>
+
+namespace CKE {
+	Map<FGResourceID, FGResourceLifetime> ComputeTransientLifetimes(Vector<FrameGraphSetupContext> const& setups) {
+		Map<FGResourceID, FGResourceLifetime> lifetimes{};
+		for (u32 passIdx = 0; passIdx < setups.size(); ++passIdx) {
+			FrameGraphSetupContext const& setup = setups[passIdx];
+			for (auto const& createInfo : setup.m_CreateTextures) {
+				CKE_ASSERT(!lifetimes.contains(createInfo.m_ID));
+				lifetimes.insert({createInfo.m_ID, FGResourceLifetime{passIdx, passIdx}});
+			}
+			for (auto const& createInfo : setup.m_CreateBuffers) {
+				CKE_ASSERT(!lifetimes.contains(createInfo.m_ID));
+				lifetimes.insert({createInfo.m_ID, FGResourceLifetime{passIdx, passIdx}});
+			}
+		}
+
+		// Usages before the creating pass are allowed, the resources exist for the whole frame
+		for (u32 passIdx = 0; passIdx < setups.size(); ++passIdx) {
+			for (FGPassResourceUsageInfo const& usage : setups[passIdx].m_ResourceUsageMetadata) {
+				auto it = lifetimes.find(usage.m_ID);
+				if (it != lifetimes.end()) {
+					it->second.m_FirstPass = std::min(it->second.m_FirstPass, passIdx);
+					it->second.m_LastPass = std::max(it->second.m_LastPass, passIdx);
+				}
+			}
+		}
+		return lifetimes;
+	}
+
+	u64 AlignUp(u64 value, u64 alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	FGAliasingPlan PackTransientResources(Vector<FGAliasingRequest> const& requests, u64 maxHeapSizeInBytes) {
+		FGAliasingPlan plan{};
+		plan.m_Placements.resize(requests.size());
+
+		// Biggest first, the small ones fill the gaps left between them
+		Vector<u32> order(requests.size());
+		for (u32 i = 0; i < order.size(); ++i) { order[i] = i; }
+		std::sort(order.begin(), order.end(), [&requests](u32 lhs, u32 rhs) {
+			FGAliasingRequest const& l = requests[lhs];
+			FGAliasingRequest const& r = requests[rhs];
+			if (l.m_SizeInBytes != r.m_SizeInBytes) { return l.m_SizeInBytes > r.m_SizeInBytes; }
+			if (l.m_Lifetime.m_FirstPass != r.m_Lifetime.m_FirstPass) {
+				return l.m_Lifetime.m_FirstPass < r.m_Lifetime.m_FirstPass;
+			}
+			return lhs < rhs;
+		});
+
+		// Memory ranges taken by the resources alive at the same time as the one being placed
+		struct UsedRange
+		{
+			u64 m_Begin;
+			u64 m_End;
+		};
+		Vector<Vector<u32>> placedInHeap{};
+		Vector<UsedRange>   usedRanges{};
+
+		for (u32 requestIdx : order) {
+			FGAliasingRequest const& request = requests[requestIdx];
+			CKE_ASSERT(request.m_Alignment > 0);
+			plan.m_UnaliasedSizeInBytes += AlignUp(request.m_SizeInBytes, request.m_Alignment);
+
+			bool isPlaced = false;
+			for (u32 heapIdx = 0; heapIdx < plan.m_Heaps.size() && !isPlaced; ++heapIdx) {
+				FGAliasingHeap& heap = plan.m_Heaps[heapIdx];
+				if ((heap.m_MemoryTypeBits & request.m_MemoryTypeBits) == 0) { continue; }
+
+				usedRanges.clear();
+				for (u32 placedIdx : placedInHeap[heapIdx]) {
+					if (requests[placedIdx].m_Lifetime.Overlaps(request.m_Lifetime)) {
+						u64 const begin = plan.m_Placements[placedIdx].m_OffsetInBytes;
+						usedRanges.push_back({begin, begin + requests[placedIdx].m_SizeInBytes});
+					}
+				}
+				std::sort(usedRanges.begin(), usedRanges.end(), [](UsedRange const& lhs, UsedRange const& rhs) {
+					return lhs.m_Begin < rhs.m_Begin;
+				});
+
+				// Lowest aligned offset in a gap between the used ranges
+				u64 offset = 0;
+				for (UsedRange const& range : usedRanges) {
+					if (offset + request.m_SizeInBytes <= range.m_Begin) { break; }
+					offset = std::max(offset, AlignUp(range.m_End, request.m_Alignment));
+				}
+
+				u64 const end = offset + request.m_SizeInBytes;
+				if (end > heap.m_SizeInBytes && end > maxHeapSizeInBytes) { continue; }
+
+				heap.m_SizeInBytes = std::max(heap.m_SizeInBytes, end);
+				heap.m_Alignment = std::max(heap.m_Alignment, request.m_Alignment);
+				heap.m_MemoryTypeBits &= request.m_MemoryTypeBits;
+				plan.m_Placements[requestIdx] = FGAliasingPlacement{heapIdx, offset, false};
+				placedInHeap[heapIdx].push_back(requestIdx);
+				isPlaced = true;
+			}
+
+			if (!isPlaced) {
+				FGAliasingHeap heap{};
+				heap.m_SizeInBytes = request.m_SizeInBytes;
+				heap.m_Alignment = request.m_Alignment;
+				heap.m_MemoryTypeBits = request.m_MemoryTypeBits;
+				plan.m_Placements[requestIdx] = FGAliasingPlacement{static_cast<u32>(plan.m_Heaps.size()), 0, false};
+				plan.m_Heaps.push_back(heap);
+				placedInHeap.push_back({requestIdx});
+			}
+		}
+
+		// Resources of the same heap that share bytes can only be the ones that are never alive together
+		for (Vector<u32> const& placed : placedInHeap) {
+			for (u64 i = 0; i < placed.size(); ++i) {
+				for (u64 j = i + 1; j < placed.size(); ++j) {
+					FGAliasingPlacement& a = plan.m_Placements[placed[i]];
+					FGAliasingPlacement& b = plan.m_Placements[placed[j]];
+					u64 const            aEnd = a.m_OffsetInBytes + requests[placed[i]].m_SizeInBytes;
+					u64 const            bEnd = b.m_OffsetInBytes + requests[placed[j]].m_SizeInBytes;
+					if (a.m_OffsetInBytes < bEnd && b.m_OffsetInBytes < aEnd) {
+						a.m_IsAliased = true;
+						b.m_IsAliased = true;
+					}
+				}
+			}
+		}
+
+		for (FGAliasingHeap const& heap : plan.m_Heaps) {
+			plan.m_AliasedSizeInBytes += heap.m_SizeInBytes;
+		}
+		return plan;
+	}
+}
@@ -0,0 +1,61 @@
+#include "CookieKat/Systems/FrameGraph/FrameGraphRecording.h"
+#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+#include "CookieKat/Systems/TaskSystem/TaskSystem.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <algorithm>
+
+namespace CKE {
+	void FGParallelGraphicsRenderPass::Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) {
+		RenderingInfo renderingInfo{};
+		u32 const     numItems = BeginParallelExecute(ctx, rd, renderingInfo);
+
+		cmdList.BeginRendering(renderingInfo);
+		ExecuteRange(cmdList, rd, FGRecordRange{0, numItems, 0});
+		cmdList.EndRendering();
+	}
+
+	//-----------------------------------------------------------------------------
+
+	void FGParallelRecorder::Initialize(TaskSystem* pTaskSystem, u32 maxLists, u32 minItemsPerList) {
+		CKE_ASSERT(maxLists > 0 && maxLists <= RenderSettings::MAX_RECORDING_THREADS);
+		CKE_ASSERT(minItemsPerList > 0);
+		m_pTaskSystem = pTaskSystem;
+		m_MaxLists = maxLists;
+		m_MinItemsPerList = minItemsPerList;
+	}
+
+	void FGParallelRecorder::SplitRanges(u32 numItems, Vector<FGRecordRange>& ranges) const {
+		// A couple of lists per thread so the threads that finish first can take the remaining ones
+		constexpr u32 LISTS_PER_THREAD = 2;
+
+		ranges.clear();
+		if (numItems == 0) { return; }
+
+		u32 const maxLists = m_pTaskSystem != nullptr
+			                     ? std::min(m_MaxLists, m_pTaskSystem->GetNumThreads() * LISTS_PER_THREAD)
+			                     : 1;
+		u32 const numLists = std::clamp(numItems / m_MinItemsPerList, 1u, maxLists);
+
+		for (u32 i = 0; i < numLists; ++i) {
+			u32 const begin = static_cast<u32>(static_cast<u64>(numItems) * i / numLists);
+			u32 const end = static_cast<u32>(static_cast<u64>(numItems) * (i + 1) / numLists);
+			ranges.push_back(FGRecordRange{begin, end, i});
+		}
+	}
+
+	void FGParallelRecorder::RecordRanges(Vector<FGRecordRange> const&           ranges,
+	                                      Func<void(FGRecordRange const&)> const& recordFunc) {
+		if (m_pTaskSystem == nullptr || ranges.size() <= 1) {
+			for (FGRecordRange const& range : ranges) { recordFunc(range); }
+			return;
+		}
+
+		// Each range is its own job, so a list index is never recorded from two threads
+		JobHandle const job = m_pTaskSystem->ParallelFor(ranges.size(), [&](u64 begin, u64 end) {
+			for (u64 i = begin; i < end; ++i) { recordFunc(ranges[i]); }
+		}, 1);
+		m_pTaskSystem->Wait(job);
+	}
+}
@@ -13,6 +13,11 @@ namespace CKE {
 	}
 
 	BufferHandle ExecuteResourcesCtx::GetBuffer(FGResourceID buffer) {
+		CKE_ASSERT(m_Buffers.contains(buffer));
+		return m_Buffers[buffer].m_Buffer;
+	}
+
+	BufferRange ExecuteResourcesCtx::GetBufferRange(FGResourceID buffer) {
 		CKE_ASSERT(m_Buffers.contains(buffer));
 		return m_Buffers[buffer];
 	}
@@ -32,8 +37,8 @@ namespace CKE {
 			}
 			break;
 			case FGResourceType::Buffer: {
-				BufferHandle bufferHandle = pDb->GetBuffer(usageMeta.m_ID)->m_Handle;
-				m_Buffers[usageMeta.m_ID] = bufferHandle;
+				FGBufferData const* pBuffer = pDb->GetBuffer(usageMeta.m_ID);
+				m_Buffers[usageMeta.m_ID] = BufferRange{pBuffer->m_Handle, pBuffer->m_OffsetInBytes, pBuffer->m_SizeInBytes};
 			}
 			break;
 			default: CKE_UNREACHABLE_CODE();
@@ -54,8 +59,8 @@ namespace CKE {
 			}
 			break;
 			case FGResourceType::Buffer: {
-				BufferHandle bufferHandle = pDb->GetBuffer(usageMeta.m_ID)->m_Handle;
-				m_Buffers.insert({usageMeta.m_ID, bufferHandle});
+				FGBufferData const* pBuffer = pDb->GetBuffer(usageMeta.m_ID);
+				m_Buffers.insert({usageMeta.m_ID, BufferRange{pBuffer->m_Handle, pBuffer->m_OffsetInBytes, pBuffer->m_SizeInBytes}});
 			}
 			break;
 			default: CKE_UNREACHABLE_CODE();
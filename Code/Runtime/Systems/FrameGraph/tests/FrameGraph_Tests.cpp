@@ -1,8 +1,567 @@
+#ifdef CKE_GRAPHICS_VULKAN_BACKEND
 #define NOMINMAX
 #define VK_USE_PLATFORM_WIN32_KHR
 #define GLFW_INCLUDE_VULKAN
 #include <GLFW/glfw3.h>
 #define GLFW_EXPOSE_NATIVE_WIN32
 #include <GLFW/glfw3native.h>
+#endif
 
 #include "CookieKat/Systems/FrameGraph/FrameGraph.h"
+#include "CookieKat/Systems/TaskSystem/TaskSystem.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <string>
+
+using namespace CKE;
+
+//-----------------------------------------------------------------------------
+
+namespace {
+	// Recording backend that stores the commands of each list as text, so the order
+	// of the stitched lists can be compared without a RenderDevice
+	struct MockCmdList
+	{
+		Vector<String> m_Commands;
+	};
+
+	// Records the items of a pass like the draw list passes do, the state is set
+	// at the start of every list and each item is a draw
+	void RecordMockRange(MockCmdList& cmdList, FGRecordRange const& range) {
+		cmdList.m_Commands.push_back("SetPipeline");
+		cmdList.m_Commands.push_back("BindDescriptor Global");
+		for (u32 i = range.m_Begin; i < range.m_End; ++i) {
+			// Uneven work so the lists finish in a different order than they started
+			volatile u32 spin = 0;
+			for (u32 j = 0; j < (i * 7919) % 500; ++j) { spin = spin + j; }
+			cmdList.m_Commands.push_back("Draw " + std::to_string(i));
+		}
+	}
+
+	// Records the items through the recorder and executes the lists in range order
+	Vector<String> RecordMockPass(FGParallelRecorder& recorder, u32 numItems) {
+		Vector<FGRecordRange> ranges{};
+		recorder.SplitRanges(numItems, ranges);
+
+		Vector<MockCmdList> cmdLists(ranges.size());
+		recorder.RecordRanges(ranges, [&](FGRecordRange const& range) {
+			RecordMockRange(cmdLists[range.m_ListIdx], range);
+		});
+
+		Vector<String> commands{};
+		for (MockCmdList const& cmdList : cmdLists) {
+			commands.insert(commands.end(), cmdList.m_Commands.begin(), cmdList.m_Commands.end());
+		}
+		return commands;
+	}
+
+	Vector<String> GetDraws(Vector<String> const& commands) {
+		Vector<String> draws{};
+		for (String const& command : commands) {
+			if (command.starts_with("Draw")) { draws.push_back(command); }
+		}
+		return draws;
+	}
+}
+
+class ParallelRecordingFixture : public testing::Test
+{
+protected:
+	void SetUp() override { m_TaskSystem.Initialize(); }
+	void TearDown() override { m_TaskSystem.Shutdown(); }
+
+	TaskSystem m_TaskSystem{};
+};
+
+TEST(ParallelRecording, Split_Ranges) {
+	FGParallelRecorder recorder{};
+	recorder.Initialize(nullptr, 4, 16);
+
+	Vector<FGRecordRange> ranges{};
+	recorder.SplitRanges(0, ranges);
+	EXPECT_TRUE(ranges.empty());
+
+	// Without a TaskSystem there is a single thread to record
+	recorder.SplitRanges(1000, ranges);
+	ASSERT_EQ(ranges.size(), 1);
+	EXPECT_EQ(ranges[0].m_Begin, 0);
+	EXPECT_EQ(ranges[0].m_End, 1000);
+}
+
+TEST_F(ParallelRecordingFixture, Split_Ranges_Cover_The_Items_In_Order) {
+	FGParallelRecorder recorder{};
+	recorder.Initialize(&m_TaskSystem, 4, 16);
+	u32 const maxLists = std::min(4u, m_TaskSystem.GetNumThreads() * 2);
+
+	for (u32 numItems : {1u, 15u, 16u, 17u, 100u, 1001u, 100'000u}) {
+		Vector<FGRecordRange> ranges{};
+		recorder.SplitRanges(numItems, ranges);
+
+		ASSERT_FALSE(ranges.empty());
+		EXPECT_LE(ranges.size(), maxLists);
+		EXPECT_EQ(ranges.front().m_Begin, 0);
+		EXPECT_EQ(ranges.back().m_End, numItems);
+		for (u32 i = 0; i < ranges.size(); ++i) {
+			EXPECT_EQ(ranges[i].m_ListIdx, i);
+			EXPECT_LT(ranges[i].m_Begin, ranges[i].m_End);
+			if (i > 0) { EXPECT_EQ(ranges[i].m_Begin, ranges[i - 1].m_End); }
+			if (ranges.size() > 1) { EXPECT_GE(ranges[i].m_End - ranges[i].m_Begin, 16); }
+		}
+
+		// Same split every time
+		Vector<FGRecordRange> ranges2{};
+		recorder.SplitRanges(numItems, ranges2);
+		ASSERT_EQ(ranges.size(), ranges2.size());
+		for (u32 i = 0; i < ranges.size(); ++i) {
+			EXPECT_EQ(ranges[i].m_Begin, ranges2[i].m_Begin);
+			EXPECT_EQ(ranges[i].m_End, ranges2[i].m_End);
+		}
+	}
+}
+
+TEST_F(ParallelRecordingFixture, Stitched_Lists_Keep_The_Serial_Order) {
+	constexpr u32 NUM_ITEMS = 5000;
+
+	FGParallelRecorder serialRecorder{};
+	serialRecorder.Initialize(nullptr);
+	Vector<String> const serialCommands = RecordMockPass(serialRecorder, NUM_ITEMS);
+
+	FGParallelRecorder parallelRecorder{};
+	parallelRecorder.Initialize(&m_TaskSystem, RenderSettings::MAX_RECORDING_THREADS, 16);
+	Vector<String> const parallelCommands = RecordMockPass(parallelRecorder, NUM_ITEMS);
+
+	// Every item drawn once and in the order of the serial recording
+	EXPECT_EQ(GetDraws(parallelCommands), GetDraws(serialCommands));
+
+	// Every list sets its state before the draws
+	EXPECT_EQ(parallelCommands.front(), "SetPipeline");
+	EXPECT_EQ(parallelCommands[1], "BindDescriptor Global");
+
+	// The commands are the same every frame, whatever thread recorded each list
+	for (u32 frame = 0; frame < 20; ++frame) {
+		EXPECT_EQ(RecordMockPass(parallelRecorder, NUM_ITEMS), parallelCommands);
+	}
+}
+
+TEST_F(ParallelRecordingFixture, List_Index_Is_Not_Shared_Between_Threads) {
+	// The RenderDevice command and descriptor pools of a list index can only be used by one thread at a time
+	FGParallelRecorder recorder{};
+	recorder.Initialize(&m_TaskSystem, RenderSettings::MAX_RECORDING_THREADS, 1);
+
+	Array<std::atomic<u32>, RenderSettings::MAX_RECORDING_THREADS> listsInUse{};
+	std::atomic<u32>                                               numConflicts{0};
+	std::atomic<u32>                                               numRecorded{0};
+
+	Vector<FGRecordRange> ranges{};
+	for (u32 frame = 0; frame < 50; ++frame) {
+		recorder.SplitRanges(1000, ranges);
+		recorder.RecordRanges(ranges, [&](FGRecordRange const& range) {
+			if (listsInUse[range.m_ListIdx].exchange(1) != 0) { ++numConflicts; }
+			MockCmdList cmdList{};
+			RecordMockRange(cmdList, range);
+			numRecorded += range.m_End - range.m_Begin;
+			listsInUse[range.m_ListIdx] = 0;
+		});
+	}
+
+	EXPECT_EQ(numConflicts, 0);
+	EXPECT_EQ(numRecorded, 50 * 1000);
+}
+
+// Transient Aliasing
+//-----------------------------------------------------------------------------
+
+namespace {
+	FGAliasingRequest Request(u32 firstPass, u32 lastPass, u64 sizeInBytes, u64 alignment = 1) {
+		FGAliasingRequest request{};
+		request.m_Lifetime = FGResourceLifetime{firstPass, lastPass};
+		request.m_SizeInBytes = sizeInBytes;
+		request.m_Alignment = alignment;
+		return request;
+	}
+}
+
+TEST(TransientAliasing, Lifetimes_Go_From_Creation_To_Last_Use) {
+	Vector<FrameGraphSetupContext> setups(4);
+	setups[0].CreateTransientTexture("A", TextureDesc{}, TextureExtraSettings{});
+	setups[0].UseTexture("A", FGPipelineAccessInfo::ColorAttachmentWrite());
+	setups[1].CreateTransientTexture("B", TextureDesc{}, TextureExtraSettings{});
+	setups[1].UseTexture("A", FGPipelineAccessInfo::FragmentShaderRead());
+	setups[1].UseTexture("B", FGPipelineAccessInfo::ColorAttachmentWrite());
+	setups[2].CreateTransientBuffer("Buffer", BufferDesc{});
+	setups[3].UseTexture("B", FGPipelineAccessInfo::FragmentShaderRead());
+	setups[3].UseTexture("Imported", FGPipelineAccessInfo::ColorAttachmentWrite());
+
+	Map<FGResourceID, FGResourceLifetime> const lifetimes = ComputeTransientLifetimes(setups);
+	ASSERT_EQ(lifetimes.size(), 3);
+	EXPECT_EQ(lifetimes.at("A").m_FirstPass, 0);
+	EXPECT_EQ(lifetimes.at("A").m_LastPass, 1);
+	EXPECT_EQ(lifetimes.at("B").m_FirstPass, 1);
+	EXPECT_EQ(lifetimes.at("B").m_LastPass, 3);
+	EXPECT_EQ(lifetimes.at("Buffer").m_FirstPass, 2);
+	EXPECT_EQ(lifetimes.at("Buffer").m_LastPass, 2);
+}
+
+TEST(TransientAliasing, Lifetime_Overlaps) {
+	FGResourceLifetime const lifetime{2, 5};
+	EXPECT_TRUE(lifetime.Overlaps({2, 5}));
+	EXPECT_TRUE(lifetime.Overlaps({0, 2}));
+	EXPECT_TRUE(lifetime.Overlaps({5, 8}));
+	EXPECT_TRUE(lifetime.Overlaps({3, 4}));
+	EXPECT_TRUE(lifetime.Overlaps({0, 9}));
+	EXPECT_FALSE(lifetime.Overlaps({0, 1}));
+	EXPECT_FALSE(lifetime.Overlaps({6, 6}));
+}
+
+TEST(TransientAliasing, Disjoint_Lifetimes_Share_Memory) {
+	FGAliasingPlan const plan = PackTransientResources({Request(0, 1, 1000), Request(2, 3, 1000)}, 1 << 20);
+
+	ASSERT_EQ(plan.m_Heaps.size(), 1);
+	EXPECT_EQ(plan.m_Heaps[0].m_SizeInBytes, 1000);
+	EXPECT_EQ(plan.m_Placements[0].m_OffsetInBytes, 0);
+	EXPECT_EQ(plan.m_Placements[1].m_OffsetInBytes, 0);
+	EXPECT_TRUE(plan.m_Placements[0].m_IsAliased);
+	EXPECT_TRUE(plan.m_Placements[1].m_IsAliased);
+	EXPECT_EQ(plan.m_UnaliasedSizeInBytes, 2000);
+	EXPECT_EQ(plan.m_AliasedSizeInBytes, 1000);
+}
+
+TEST(TransientAliasing, Overlapping_Lifetimes_Dont_Share_Memory) {
+	FGAliasingPlan const plan = PackTransientResources({Request(0, 2, 1000), Request(2, 3, 500)}, 1 << 20);
+
+	ASSERT_EQ(plan.m_Heaps.size(), 1);
+	EXPECT_EQ(plan.m_Heaps[0].m_SizeInBytes, 1500);
+	EXPECT_EQ(plan.m_Placements[0].m_OffsetInBytes, 0);
+	EXPECT_EQ(plan.m_Placements[1].m_OffsetInBytes, 1000);
+	EXPECT_FALSE(plan.m_Placements[0].m_IsAliased);
+	EXPECT_FALSE(plan.m_Placements[1].m_IsAliased);
+	EXPECT_EQ(plan.m_AliasedSizeInBytes, plan.m_UnaliasedSizeInBytes);
+}
+
+TEST(TransientAliasing, Nested_Lifetimes_Share_The_Gaps) {
+	// The long lived one overlaps both short ones, the short ones can share the memory next to it
+	FGAliasingPlan const plan = PackTransientResources({
+		                                                   Request(1, 2, 300),
+		                                                   Request(0, 9, 1000),
+		                                                   Request(4, 8, 200),
+		                                                   Request(3, 3, 100),
+	                                                   }, 1 << 20);
+
+	ASSERT_EQ(plan.m_Heaps.size(), 1);
+	EXPECT_EQ(plan.m_Heaps[0].m_SizeInBytes, 1300);
+	EXPECT_EQ(plan.m_Placements[1].m_OffsetInBytes, 0);
+	EXPECT_EQ(plan.m_Placements[0].m_OffsetInBytes, 1000);
+	EXPECT_EQ(plan.m_Placements[2].m_OffsetInBytes, 1000);
+	EXPECT_EQ(plan.m_Placements[3].m_OffsetInBytes, 1000);
+	EXPECT_FALSE(plan.m_Placements[1].m_IsAliased);
+	EXPECT_TRUE(plan.m_Placements[0].m_IsAliased);
+	EXPECT_EQ(plan.m_UnaliasedSizeInBytes, 1600);
+}
+
+TEST(TransientAliasing, Placements_Are_Aligned) {
+	FGAliasingPlan const plan = PackTransientResources({Request(0, 1, 1000), Request(1, 2, 10, 256)}, 1 << 20);
+
+	ASSERT_EQ(plan.m_Heaps.size(), 1);
+	EXPECT_EQ(plan.m_Placements[1].m_OffsetInBytes, 1024);
+	EXPECT_EQ(plan.m_Heaps[0].m_SizeInBytes, 1034);
+	EXPECT_EQ(plan.m_Heaps[0].m_Alignment, 256);
+}
+
+TEST(TransientAliasing, Heaps_Respect_Memory_Types_And_Max_Size) {
+	FGAliasingRequest otherMemory = Request(2, 3, 1000);
+	otherMemory.m_MemoryTypeBits = 0b10;
+	FGAliasingRequest anyMemory = Request(4, 5, 1000);
+	anyMemory.m_MemoryTypeBits = 0b11;
+
+	FGAliasingRequest firstMemory = Request(0, 1, 1000);
+	firstMemory.m_MemoryTypeBits = 0b01;
+	FGAliasingPlan const typesPlan = PackTransientResources({firstMemory, otherMemory, anyMemory}, 1 << 20);
+	ASSERT_EQ(typesPlan.m_Heaps.size(), 2);
+	EXPECT_NE(typesPlan.m_Placements[0].m_HeapIdx, typesPlan.m_Placements[1].m_HeapIdx);
+	EXPECT_EQ(typesPlan.m_Placements[2].m_HeapIdx, typesPlan.m_Placements[0].m_HeapIdx);
+	EXPECT_EQ(typesPlan.m_Heaps[typesPlan.m_Placements[0].m_HeapIdx].m_MemoryTypeBits, 0b01);
+
+	// Alive at the same time and too big to be together in a heap
+	FGAliasingPlan const sizePlan = PackTransientResources({Request(0, 1, 600), Request(0, 1, 600),
+	                                                        Request(0, 1, 3000)}, 1000);
+	ASSERT_EQ(sizePlan.m_Heaps.size(), 3);
+	EXPECT_EQ(sizePlan.m_Heaps[sizePlan.m_Placements[2].m_HeapIdx].m_SizeInBytes, 3000);
+	EXPECT_EQ(sizePlan.m_AliasedSizeInBytes, 4200);
+}
+
+#ifdef CKE_GRAPHICS_NULL_BACKEND
+
+#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+
+#include <chrono>
+#include <iostream>
+#include <limits>
+
+// Compilation
+//-----------------------------------------------------------------------------
+
+namespace {
+	// Pass with the setup given by the test, it records the textures it gets when executed
+	class DeclaredPass : public FGGraphicsRenderPass
+	{
+	public:
+		DeclaredPass(FGRenderPassID id, Func<void(FrameGraphSetupContext&)> setup)
+			: FGGraphicsRenderPass(id), m_Setup{setup} {}
+
+		void Setup(FrameGraphSetupContext& setup) override { m_Setup(setup); }
+
+		void Execute(ExecuteResourcesCtx& ctx, CommandList& cmdList, RenderDevice& rd) override {
+			for (FGResourceID const& id : m_Reads) { m_ExecutedTextures.push_back(ctx.GetTexture(id)); }
+		}
+
+		Func<void(FrameGraphSetupContext&)> m_Setup;
+		Vector<FGResourceID>                m_Reads{};
+		Vector<TextureHandle>               m_ExecutedTextures{};
+	};
+
+	TextureDesc ColorTargetDesc(TextureFormat format = TextureFormat::R8G8B8A8_SRGB) {
+		TextureDesc desc{};
+		desc.m_Format = format;
+		return desc;
+	}
+
+	// Chain where each pass renders to a render target sized texture sampled by the next one,
+	// every 4th pass also samples a fixed size texture created by the first one
+	Vector<DeclaredPass*> AddChainPasses(FrameGraph& graph, u32 numPasses) {
+		Vector<DeclaredPass*> passes{};
+		for (u32 i = 0; i < numPasses; ++i) {
+			FGResourceID const target = "Target " + std::to_string(i);
+			FGResourceID const prevTarget = "Target " + std::to_string(i - 1);
+
+			DeclaredPass* pPass = new DeclaredPass("Pass " + std::to_string(i), [=](FrameGraphSetupContext& setup) {
+				if (i == 0) {
+					TextureDesc lutDesc = ColorTargetDesc();
+					lutDesc.m_Size = UInt3{32, 32, 1};
+					setup.CreateTransientTexture("Lut", lutDesc, TextureExtraSettings{});
+					setup.UseTexture("Lut", FGPipelineAccessInfo::ColorAttachmentWrite());
+				}
+				setup.CreateTransientTexture(target, ColorTargetDesc(), TextureExtraSettings{true, Vec2{1.0f}});
+				setup.UseTexture(target, FGPipelineAccessInfo::ColorAttachmentWrite());
+				if (i > 0) { setup.UseTexture(prevTarget, FGPipelineAccessInfo::FragmentShaderRead()); }
+				if (i > 0 && i % 4 == 0) { setup.UseTexture("Lut", FGPipelineAccessInfo::FragmentShaderRead()); }
+			});
+			pPass->m_Reads.push_back(target);
+			if (i > 0) { pPass->m_Reads.push_back(prevTarget); }
+			if (i > 0 && i % 4 == 0) { pPass->m_Reads.push_back("Lut"); }
+			graph.AddGraphicsPass(pPass);
+			passes.push_back(pPass);
+		}
+		return passes;
+	}
+}
+
+class FrameGraphCompileFixture : public testing::Test
+{
+protected:
+	void SetUp() override {
+		m_Device.Initialize({1280, 720});
+		m_Graph.Initialize(&m_Device);
+	}
+
+	void TearDown() override {
+		m_Graph.Shutdown();
+		for (DeclaredPass* pPass : m_Passes) { delete pPass; }
+		m_Device.Shutdown();
+	}
+
+	// Executes the graph in a new frame and returns the texture of every barrier it recorded
+	Vector<TextureHandle> ExecuteFrame() {
+		m_Device.AcquireNextBackBuffer();
+		m_Graph.Execute({SemaphoreHandle{}, PipelineStage::TopOfPipe}, SemaphoreHandle{}, m_Device.GetInFlightFence());
+
+		Vector<TextureHandle> barrierTextures{};
+		for (NullSubmission const& submission : m_Device.GetSubmissions()) {
+			for (NullCommand const& command : submission.m_pStream->m_Commands) {
+				if (command.m_Type == NullCommandType::Barrier) {
+					barrierTextures.push_back(TextureHandle{RenderHandle{command.m_Args[0]}});
+				}
+			}
+		}
+		m_Device.Present();
+		return barrierTextures;
+	}
+
+	RenderDevice          m_Device{};
+	FrameGraph            m_Graph{};
+	Vector<DeclaredPass*> m_Passes{};
+};
+
+TEST_F(FrameGraphCompileFixture, Unchanged_Setup_Skips_Compilation) {
+	m_Passes = AddChainPasses(m_Graph, 10);
+	m_Graph.Compile({1280, 720});
+	u64 const numTextures = m_Device.GetNumTextures();
+	Vector<TextureHandle> const barriers = ExecuteFrame();
+
+	m_Graph.Compile({1280, 720});
+	EXPECT_EQ(m_Graph.GetCompileStats().m_NumCompilations, 1);
+	EXPECT_EQ(m_Graph.GetCompileStats().m_NumCachedCompilations, 1);
+	EXPECT_EQ(m_Graph.GetCompileStats().m_NumResizes, 0);
+
+	// Same resources and barriers as before
+	EXPECT_EQ(m_Device.GetNumTextures(), numTextures);
+	EXPECT_EQ(ExecuteFrame(), barriers);
+}
+
+TEST_F(FrameGraphCompileFixture, Changed_Setup_Recompiles) {
+	m_Passes = AddChainPasses(m_Graph, 10);
+	m_Graph.Compile({1280, 720});
+	u64 const numTextures = m_Device.GetNumTextures();
+
+	// A pass now writes a different format
+	m_Passes[3]->m_Setup = [](FrameGraphSetupContext& setup) {
+		setup.CreateTransientTexture("Target 3", ColorTargetDesc(TextureFormat::R16G16B16A16_SFLOAT),
+		                             TextureExtraSettings{true, Vec2{1.0f}});
+		setup.UseTexture("Target 3", FGPipelineAccessInfo::ColorAttachmentWrite());
+		setup.UseTexture("Target 2", FGPipelineAccessInfo::FragmentShaderRead());
+	};
+	m_Graph.Compile({1280, 720});
+	EXPECT_EQ(m_Graph.GetCompileStats().m_NumCompilations, 2);
+	EXPECT_EQ(m_Graph.GetCompileStats().m_NumCachedCompilations, 0);
+
+	// The transient textures of the previous compilation are released
+	EXPECT_EQ(m_Device.GetNumTextures(), numTextures);
+}
+
+TEST_F(FrameGraphCompileFixture, Resize_Only_Recreates_Relative_Textures) {
+	m_Passes = AddChainPasses(m_Graph, 10);
+	m_Graph.Compile({1280, 720});
+	ExecuteFrame();
+	TextureHandle const lut = m_Passes[4]->m_ExecutedTextures.back();
+	TextureHandle const target = m_Passes[0]->m_ExecutedTextures.front();
+	u64 const           numTextures = m_Device.GetNumTextures();
+
+	m_Graph.Compile({640, 360});
+	EXPECT_EQ(m_Graph.GetCompileStats().m_NumCompilations, 1);
+	EXPECT_EQ(m_Graph.GetCompileStats().m_NumResizes, 1);
+	EXPECT_EQ(m_Device.GetNumTextures(), numTextures);
+
+	for (DeclaredPass* pPass : m_Passes) { pPass->m_ExecutedTextures.clear(); }
+	Vector<TextureHandle> const barriers = ExecuteFrame();
+	EXPECT_EQ(m_Passes[4]->m_ExecutedTextures.back(), lut);
+	EXPECT_NE(m_Passes[0]->m_ExecutedTextures.front(), target);
+
+	// The compiled barriers use the recreated textures
+	for (DeclaredPass* pPass : m_Passes) {
+		for (TextureHandle texture : pPass->m_ExecutedTextures) {
+			EXPECT_NE(std::find(barriers.begin(), barriers.end(), texture), barriers.end());
+		}
+	}
+	EXPECT_EQ(std::find(barriers.begin(), barriers.end(), target), barriers.end());
+}
+
+TEST_F(FrameGraphCompileFixture, Not_Imported_Resources_Crash) {
+	m_Passes.push_back(new DeclaredPass("Pass", [](FrameGraphSetupContext& setup) {
+		setup.CreateTransientTexture("Target", ColorTargetDesc(), TextureExtraSettings{true, Vec2{1.0f}});
+		setup.UseTexture("Target", FGPipelineAccessInfo::ColorAttachmentWrite());
+		setup.UseBuffer("Not Imported Buffer");
+	}));
+	m_Graph.AddGraphicsPass(m_Passes.back());
+	EXPECT_DEATH(m_Graph.Compile({1280, 720}), "Assertion");
+
+	m_Passes.back()->m_Setup = [](FrameGraphSetupContext& setup) {
+		setup.UseTexture("Not Imported Texture", FGPipelineAccessInfo::FragmentShaderRead());
+	};
+	EXPECT_DEATH(m_Graph.Compile({1280, 720}), "Assertion");
+}
+
+TEST_F(FrameGraphCompileFixture, Aliasing_Reduces_Transient_Memory) {
+	m_Passes = AddChainPasses(m_Graph, 10);
+	m_Graph.SetTransientAliasing(false);
+	m_Graph.Compile({1280, 720});
+	FGTransientMemoryStats const unaliased = m_Graph.GetTransientMemoryStats();
+	EXPECT_EQ(unaliased.m_NumHeaps, 0);
+	EXPECT_EQ(unaliased.m_AliasedSizeInBytes, unaliased.m_UnaliasedSizeInBytes);
+
+	m_Graph.SetTransientAliasing(true);
+	m_Graph.Compile({1280, 720});
+	FGTransientMemoryStats const aliased = m_Graph.GetTransientMemoryStats();
+	EXPECT_EQ(m_Graph.GetCompileStats().m_NumCompilations, 2);
+	EXPECT_EQ(aliased.m_UnaliasedSizeInBytes, unaliased.m_UnaliasedSizeInBytes);
+	EXPECT_EQ(m_Device.GetNumMemoryHeaps(), aliased.m_NumHeaps);
+
+	// Only two targets of the chain are alive at the same time, the LUT has a heap of its own
+	EXPECT_EQ(aliased.m_NumHeaps, 2);
+	EXPECT_LT(aliased.m_AliasedSizeInBytes * 4, unaliased.m_UnaliasedSizeInBytes);
+
+	// The textures a pass uses never share memory
+	ExecuteFrame();
+	for (DeclaredPass* pPass : m_Passes) {
+		for (u64 i = 0; i < pPass->m_ExecutedTextures.size(); ++i) {
+			for (u64 j = i + 1; j < pPass->m_ExecutedTextures.size(); ++j) {
+				u64 offsetA = 0;
+				u64 offsetB = 0;
+				MemoryHeapHandle const heapA = m_Device.GetTextureHeap(pPass->m_ExecutedTextures[i], offsetA);
+				MemoryHeapHandle const heapB = m_Device.GetTextureHeap(pPass->m_ExecutedTextures[j], offsetB);
+				ASSERT_TRUE(heapA.IsValid());
+				EXPECT_TRUE(heapA != heapB || offsetA != offsetB);
+			}
+		}
+	}
+
+	// A resize repacks the heaps of the relative sized textures
+	m_Graph.Compile({640, 360});
+	EXPECT_EQ(m_Device.GetNumMemoryHeaps(), 2);
+	EXPECT_LT(m_Graph.GetTransientMemoryStats().m_AliasedSizeInBytes, aliased.m_AliasedSizeInBytes);
+}
+
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, they only print timings. Run them with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+
+namespace {
+	constexpr u32 BENCHMARK_RUNS = 20;
+
+	template <typename Func>
+	f64 BestUs(Func&& run) {
+		f64 bestUs = std::numeric_limits<f64>::max();
+		for (u32 i = 0; i < BENCHMARK_RUNS; ++i) {
+			auto const start = std::chrono::high_resolution_clock::now();
+			run();
+			auto const end = std::chrono::high_resolution_clock::now();
+			bestUs = std::min(bestUs, std::chrono::duration<f64, std::micro>(end - start).count());
+		}
+		return bestUs;
+	}
+}
+
+// Full compilation against the cached one and a resize, for a graph the size of the main one and a synthetic one
+TEST_F(FrameGraphCompileFixture, DISABLED_Benchmark_Compile) {
+	for (u32 numPasses : {10u, 200u}) {
+		FrameGraph graph{};
+		graph.Initialize(&m_Device);
+		Vector<DeclaredPass*> passes = AddChainPasses(graph, numPasses);
+
+		// Changing the setup of the last pass forces a full compilation every run
+		u32        run = 0;
+		f64 const  fullUs = BestUs([&] {
+			passes.back()->m_Reads.clear();
+			TextureFormat const format = (++run % 2) ? TextureFormat::R8G8B8A8_SRGB : TextureFormat::R16G16B16A16_SFLOAT;
+			passes.back()->m_Setup = [=](FrameGraphSetupContext& setup) {
+				setup.CreateTransientTexture("Last", ColorTargetDesc(format), TextureExtraSettings{true, Vec2{1.0f}});
+				setup.UseTexture("Last", FGPipelineAccessInfo::ColorAttachmentWrite());
+			};
+			graph.Compile({1280, 720});
+		});
+		f64 const cachedUs = BestUs([&] { graph.Compile({1280, 720}); });
+		f64 const resizeUs = BestUs([&] {
+			graph.Compile({640, 360});
+			graph.Compile({1280, 720});
+		}) / 2.0;
+		EXPECT_EQ(graph.GetCompileStats().m_NumCompilations, BENCHMARK_RUNS);
+
+		std::cout << "[Benchmark] Compile " << numPasses << " passes, full: " << fullUs << " us, cached: "
+			<< cachedUs << " us, resize: " << resizeUs << " us\n";
+
+		graph.Shutdown();
+		for (DeclaredPass* pPass : passes) { delete pPass; }
+	}
+}
+
+#endif
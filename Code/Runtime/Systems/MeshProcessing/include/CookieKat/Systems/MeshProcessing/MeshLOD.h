@@ -0,0 +1,30 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Math.h"
+#include "CookieKat/Core/Serialization/Archive.h"
+
+namespace CKE::MeshProcessing {
+	// Range of a shared index buffer that draws one level of detail of a mesh
+	struct MeshLOD
+	{
+		CKE_SERIALIZE_AS_BYTES();
+
+		u32 m_IndexOffset = 0;
+		u32 m_IndexCount = 0;
+		f32 m_Error = 0.0f; // Distance to the full detail surface, in mesh units
+	};
+
+	// Sphere centered in the bounds of the positions, xyz is the center and w the radius
+	Vec4 ComputeBoundingSphere(Vector<Vec3> const& positions);
+
+	// Projected size in pixels of a geometric error seen at the given distance.
+	// projectionScale is the vertical scale of the projection matrix (proj[1][1] = 1 / tan(fovY / 2)).
+	f32 ComputeScreenSpaceError(f32 geometricError, f32 distance, f32 projectionScale, f32 viewportHeight);
+
+	// Returns the coarsest LOD whose projected error doesn't exceed maxPixelError.
+	// LODs must be sorted from the most to the least detailed, with increasing errors.
+	// errorScale converts the LOD errors to world units, usually the biggest scale axis of the object.
+	u32 SelectLOD(Vector<MeshLOD> const& lods, f32 errorScale, f32 distance,
+	              f32 projectionScale, f32 viewportHeight, f32 maxPixelError = 1.0f);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Math.h"
+#include "CookieKat/Core/Platform/Asserts.h"
+
+// Offline triangle mesh optimizations used by the resource compiler.
+// All of the functions operate on indexed triangle lists (3 indices per triangle)
+// and only need the vertex positions, so they are agnostic of the vertex layout.
+
+namespace CKE::MeshProcessing {
+	// Size of the FIFO post-transform cache simulated when analyzing a mesh
+	static constexpr u32 DEFAULT_SIMULATED_CACHE_SIZE = 16;
+
+	// Index value used by remap tables to mark unreferenced vertices
+	static constexpr u32 INVALID_VERTEX_INDEX = 0xFFFFFFFF;
+
+	// Post-transform vertex cache statistics of an index buffer
+	struct VertexCacheStats
+	{
+		u32 m_TriangleCount = 0;
+		u32 m_VerticesTransformed = 0; // Number of cache misses
+		f32 m_ACMR = 0.0f;             // Average Cache Miss Ratio, transformed vertices per triangle [0.5, 3.0]
+		f32 m_ATVR = 0.0f;             // Average Transformed Vertex Ratio, transformed vertices per used vertex [1.0, 3.0]
+	};
+
+	// Vertex fetch statistics of an index buffer, with a simulated 64-byte cache line
+	struct VertexFetchStats
+	{
+		u64 m_BytesFetched = 0;
+		f32 m_Overfetch = 0.0f; // Bytes fetched / Bytes of the vertex buffer, 1.0 is optimal
+	};
+
+	// Analysis
+	//-----------------------------------------------------------------------------
+
+	// Simulates a FIFO post-transform cache of the given size over the index buffer
+	VertexCacheStats AnalyzeVertexCache(Vector<u32> const& indices, u64 vertexCount,
+	                                    u32                cacheSize = DEFAULT_SIMULATED_CACHE_SIZE);
+
+	// Simulates a small direct mapped cache of 64-byte lines over the vertex buffer reads
+	VertexFetchStats AnalyzeVertexFetch(Vector<u32> const& indices, u64 vertexCount, u64 vertexSizeInBytes);
+
+	// Optimizations
+	//-----------------------------------------------------------------------------
+
+	// Reorders the triangles to maximize the post-transform vertex cache hit rate.
+	// Uses Tom Forsyth's linear-speed vertex cache optimization algorithm.
+	void OptimizeVertexCache(Vector<u32>& indices, u64 vertexCount);
+
+	// Reorders clusters of triangles so that outward facing ones are drawn first, which reduces overdraw.
+	// The indices should already be optimized for the vertex cache, the clusters are split at points
+	// where it doesn't degrade the cache ACMR more than the given threshold (1.05 = 5% worse at most).
+	void OptimizeOverdraw(Vector<u32>& indices, Vector<Vec3> const& positions, f32 threshold = 1.05f);
+
+	// Generates a remap table so that vertices are laid out in the order they are first referenced
+	// by the index buffer, the indices are rewritten in place with the new vertex order.
+	// Unreferenced vertices are marked with INVALID_VERTEX_INDEX in the table and dropped.
+	// Outputs the remap table (old index -> new index) and returns the number of vertices that are kept.
+	u64 OptimizeVertexFetchRemap(Vector<u32>& indices, u64 vertexCount, Vector<u32>& outRemap);
+
+	// Applies a remap table generated by OptimizeVertexFetchRemap to a vertex stream
+	template <typename T>
+	void RemapVertexStream(Vector<T>& vertices, Vector<u32> const& remap, u64 newVertexCount);
+}
+
+//-----------------------------------------------------------------------------
+
+namespace CKE::MeshProcessing {
+	template <typename T>
+	void RemapVertexStream(Vector<T>& vertices, Vector<u32> const& remap, u64 newVertexCount) {
+		CKE_ASSERT(vertices.size() == remap.size());
+
+		Vector<T> remapped(newVertexCount);
+		for (u64 i = 0; i < remap.size(); ++i) {
+			if (remap[i] != INVALID_VERTEX_INDEX) { remapped[remap[i]] = vertices[i]; }
+		}
+		vertices = std::move(remapped);
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Math.h"
+
+// Encoding functions used to build compact vertex streams.
+// Every Quantize/Encode function has a matching Dequantize/Decode one that reverses it.
+
+namespace CKE::MeshProcessing {
+	// Per-mesh transform from normalized [0, 1] positions back to model space:
+	//    position = normalizedPosition * m_Scale + m_Bias
+	struct PositionQuantization
+	{
+		Vec3 m_Scale{1.0f};
+		Vec3 m_Bias{0.0f};
+	};
+
+	// Scalars
+	//-----------------------------------------------------------------------------
+
+	// IEEE 754 half-precision float with round-to-nearest.
+	// Values too small for a normalized half are flushed to zero, values too big are clamped to infinity.
+	u16 QuantizeHalf(f32 value);
+	f32 DequantizeHalf(u16 value);
+
+	// Maps a value in the [0, 1] range to the full u16 range
+	u16 QuantizeUnorm16(f32 value);
+	f32 DequantizeUnorm16(u16 value);
+
+	// Maps a value in the [-1, 1] range to the [-32767, 32767] range
+	i16 QuantizeSnorm16(f32 value);
+	f32 DequantizeSnorm16(i16 value);
+
+	// Directions
+	//-----------------------------------------------------------------------------
+
+	// Encodes a unit vector into 2 components in the [-1, 1] range with an octahedral mapping,
+	// which distributes the precision evenly over the sphere.
+	Vec2 EncodeOctahedral(Vec3 direction);
+	Vec3 DecodeOctahedral(Vec2 encoded);
+
+	// Positions
+	//-----------------------------------------------------------------------------
+
+	// Computes the scale and bias that map the bounding box of the positions to [0, 1]
+	PositionQuantization ComputePositionQuantization(Vector<Vec3> const& positions);
+
+	Vec3 NormalizePosition(Vec3 position, PositionQuantization const& quantization);
+	Vec3 DenormalizePosition(Vec3 normalized, PositionQuantization const& quantization);
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Math.h"
+
+namespace CKE::MeshProcessing {
+	struct SimplificationSettings
+	{
+		u64 m_TargetIndexCount = 0;
+		f32 m_MaxError = 0.01f; // Relative to the mesh extent, 0.01 = 1% of the size of the mesh
+
+		// Weight of each of the per-vertex attributes passed to SimplifyMesh.
+		// Only used to penalize collapses that snap a vertex across an attribute seam (UV/normal splits)
+		Vector<f32> m_AttributeWeights{};
+	};
+
+	struct SimplificationResult
+	{
+		Vector<u32> m_Indices{};
+		f32         m_Error = 0.0f; // Approximate distance to the original surface, in mesh units
+	};
+
+	// Simplifies an indexed triangle list with quadric error metric edge collapses until the target index count
+	// is reached or no collapse can be done without exceeding the max error.
+	// Vertices are never moved or created, the result indexes the same vertex buffer so it can be used as a LOD.
+	//
+	// Vertices that share a position but not their attributes (seams) are collapsed together, keeping each
+	// of them on its side of the seam. Open borders are preserved with constraint planes.
+	//
+	// attributes:
+	//    Either empty or (vertexCount * m_AttributeWeights.size()) floats, with the attributes of each vertex packed together
+	SimplificationResult SimplifyMesh(Vector<u32> const&            indices,
+	                                  Vector<Vec3> const&           positions,
+	                                  Vector<f32> const&            attributes,
+	                                  SimplificationSettings const& settings);
+
+	// Returns the scale used to convert SimplificationSettings::m_MaxError to mesh units
+	f32 ComputeMeshExtent(Vector<Vec3> const& positions);
+}
@@ -0,0 +1,44 @@
+#include "MeshLOD.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CKE::MeshProcessing {
+	Vec4 ComputeBoundingSphere(Vector<Vec3> const& positions) {
+		if (positions.empty()) { return Vec4{0.0f}; }
+
+		Vec3 min = positions[0];
+		Vec3 max = positions[0];
+		for (Vec3 const& p : positions) {
+			min = glm::min(min, p);
+			max = glm::max(max, p);
+		}
+
+		Vec3 const center = (min + max) * 0.5f;
+		f32        radiusSq = 0.0f;
+		for (Vec3 const& p : positions) {
+			Vec3 const d = p - center;
+			radiusSq = std::max(radiusSq, glm::dot(d, d));
+		}
+		return Vec4{center, std::sqrt(radiusSq)};
+	}
+
+	f32 ComputeScreenSpaceError(f32 geometricError, f32 distance, f32 projectionScale, f32 viewportHeight) {
+		// Closer than the near plane everything is considered infinitely big
+		distance = std::max(distance, 1e-4f);
+		return geometricError * projectionScale * 0.5f * viewportHeight / distance;
+	}
+
+	u32 SelectLOD(Vector<MeshLOD> const& lods, f32 errorScale, f32 distance,
+	              f32 projectionScale, f32 viewportHeight, f32 maxPixelError) {
+		// Compare in world units to avoid a division per LOD
+		f32 const maxError = maxPixelError * std::max(distance, 1e-4f) / (projectionScale * 0.5f * viewportHeight);
+
+		u32 selected = 0;
+		for (u32 i = 1; i < lods.size(); ++i) {
+			if (lods[i].m_Error * errorScale > maxError) { break; }
+			selected = i;
+		}
+		return selected;
+	}
+}
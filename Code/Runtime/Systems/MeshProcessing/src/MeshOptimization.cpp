@@ -0,0 +1,342 @@
+#include "MeshOptimization.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CKE::MeshProcessing {
+	// Analysis
+	//-----------------------------------------------------------------------------
+
+	VertexCacheStats AnalyzeVertexCache(Vector<u32> const& indices, u64 vertexCount, u32 cacheSize) {
+		CKE_ASSERT(indices.size() % 3 == 0);
+
+		VertexCacheStats stats{};
+		stats.m_TriangleCount = static_cast<u32>(indices.size() / 3);
+		if (stats.m_TriangleCount == 0) { return stats; }
+
+		// A vertex is in the FIFO cache if it was inserted less than cacheSize misses ago
+		Vector<u32> timestamps(vertexCount, 0);
+		u32         time = cacheSize + 1;
+		u32         usedVertices = 0;
+		for (u32 index : indices) {
+			CKE_ASSERT(index < vertexCount);
+			if (timestamps[index] == 0) { usedVertices++; }
+			if (time - timestamps[index] > cacheSize) {
+				timestamps[index] = time++;
+				stats.m_VerticesTransformed++;
+			}
+		}
+
+		stats.m_ACMR = static_cast<f32>(stats.m_VerticesTransformed) / stats.m_TriangleCount;
+		stats.m_ATVR = static_cast<f32>(stats.m_VerticesTransformed) / usedVertices;
+		return stats;
+	}
+
+	VertexFetchStats AnalyzeVertexFetch(Vector<u32> const& indices, u64 vertexCount, u64 vertexSizeInBytes) {
+		constexpr u64 CACHE_LINE_SIZE = 64;
+		constexpr u64 CACHE_LINE_COUNT = 128;
+
+		VertexFetchStats stats{};
+		if (indices.empty() || vertexCount == 0) { return stats; }
+
+		Array<u64, CACHE_LINE_COUNT> cache;
+		cache.fill(~0ull);
+
+		for (u32 index : indices) {
+			u64 const firstByte = index * vertexSizeInBytes;
+			u64 const lastByte = firstByte + vertexSizeInBytes - 1;
+			for (u64 line = firstByte / CACHE_LINE_SIZE; line <= lastByte / CACHE_LINE_SIZE; ++line) {
+				u64& slot = cache[line % CACHE_LINE_COUNT];
+				if (slot != line) {
+					slot = line;
+					stats.m_BytesFetched += CACHE_LINE_SIZE;
+				}
+			}
+		}
+
+		stats.m_Overfetch = static_cast<f32>(stats.m_BytesFetched) / (vertexCount * vertexSizeInBytes);
+		return stats;
+	}
+
+	// Vertex Cache
+	//-----------------------------------------------------------------------------
+
+	namespace {
+		// Tuning values from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation"
+		constexpr u32 FORSYTH_CACHE_SIZE = 32;
+		constexpr f32 CACHE_DECAY_POWER = 1.5f;
+		constexpr f32 LAST_TRIANGLE_SCORE = 0.75f;
+		constexpr f32 VALENCE_BOOST_SCALE = 2.0f;
+		constexpr f32 VALENCE_BOOST_POWER = 0.5f;
+
+		f32 ComputeVertexScore(i32 cachePosition, u32 remainingValence) {
+			// Vertices without triangles left to emit are never picked again
+			if (remainingValence == 0) { return -1.0f; }
+
+			f32 score = 0.0f;
+			if (cachePosition >= 0) {
+				// The vertices of the last triangle get a fixed score so that we don't favour
+				// re-using them in the same order, which hurts some hardware caches
+				if (cachePosition < 3) { score = LAST_TRIANGLE_SCORE; }
+				else {
+					f32 const scaler = 1.0f / (FORSYTH_CACHE_SIZE - 3);
+					score = std::pow(1.0f - (cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+				}
+			}
+
+			// Boost vertices with few triangles left so that we finish them off
+			score += VALENCE_BOOST_SCALE * std::pow(static_cast<f32>(remainingValence), -VALENCE_BOOST_POWER);
+			return score;
+		}
+	}
+
+	void OptimizeVertexCache(Vector<u32>& indices, u64 vertexCount) {
+		CKE_ASSERT(indices.size() % 3 == 0);
+
+		u64 const triangleCount = indices.size() / 3;
+		if (triangleCount == 0) { return; }
+
+		// Build Vertex -> Triangles adjacency
+		//-----------------------------------------------------------------------------
+
+		Vector<u32> remainingValence(vertexCount, 0);
+		for (u32 index : indices) { remainingValence[index]++; }
+
+		Vector<u32> adjacencyOffsets(vertexCount + 1, 0);
+		for (u64 v = 0; v < vertexCount; ++v) {
+			adjacencyOffsets[v + 1] = adjacencyOffsets[v] + remainingValence[v];
+		}
+
+		Vector<u32> adjacency(indices.size());
+		{
+			Vector<u32> fillCursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (u64 i = 0; i < indices.size(); ++i) {
+				adjacency[fillCursor[indices[i]]++] = static_cast<u32>(i / 3);
+			}
+		}
+
+		// Initial scores
+		//-----------------------------------------------------------------------------
+
+		Vector<i32> cachePosition(vertexCount, -1);
+		Vector<f32> vertexScore(vertexCount);
+		for (u64 v = 0; v < vertexCount; ++v) {
+			vertexScore[v] = ComputeVertexScore(-1, remainingValence[v]);
+		}
+
+		Vector<f32>  triangleScore(triangleCount);
+		Vector<bool> triangleEmitted(triangleCount, false);
+		for (u64 t = 0; t < triangleCount; ++t) {
+			triangleScore[t] = vertexScore[indices[t * 3 + 0]] +
+					vertexScore[indices[t * 3 + 1]] +
+					vertexScore[indices[t * 3 + 2]];
+		}
+
+		// Greedily emit the best scoring triangle of the ones adjacent to the cache
+		//-----------------------------------------------------------------------------
+
+		Vector<u32> output{};
+		output.reserve(indices.size());
+
+		Array<u32, FORSYTH_CACHE_SIZE + 3> cache{};
+		Array<u32, FORSYTH_CACHE_SIZE + 3> newCache{};
+		u32                                cacheCount = 0;
+
+		u64 bestTriangle = std::max_element(triangleScore.begin(), triangleScore.end()) - triangleScore.begin();
+		u64 inputCursor = 0;
+
+		for (u64 emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+			// Nothing adjacent to the cache, continue from the first triangle that hasn't been emitted
+			if (bestTriangle == ~0ull) {
+				while (triangleEmitted[inputCursor]) { inputCursor++; }
+				bestTriangle = inputCursor;
+			}
+
+			u32 const* pTri = &indices[bestTriangle * 3];
+			output.insert(output.end(), pTri, pTri + 3);
+			triangleEmitted[bestTriangle] = true;
+
+			// Remove the triangle from the adjacency of its vertices
+			for (u32 i = 0; i < 3; ++i) {
+				u32 const  v = pTri[i];
+				u32* const pAdjacent = &adjacency[adjacencyOffsets[v]];
+				u32 const  count = remainingValence[v];
+				for (u32 j = 0; j < count; ++j) {
+					if (pAdjacent[j] == bestTriangle) {
+						std::swap(pAdjacent[j], pAdjacent[count - 1]);
+						break;
+					}
+				}
+				remainingValence[v]--;
+			}
+
+			// Push the triangle vertices to the front of the LRU cache
+			u32 newCacheCount = 0;
+			for (u32 i = 0; i < 3; ++i) {
+				u32 const v = pTri[i];
+				if (std::find(newCache.begin(), newCache.begin() + newCacheCount, v) == newCache.begin() + newCacheCount) {
+					newCache[newCacheCount++] = v;
+				}
+			}
+			for (u32 i = 0; i < cacheCount; ++i) {
+				u32 const v = cache[i];
+				if (v != pTri[0] && v != pTri[1] && v != pTri[2]) { newCache[newCacheCount++] = v; }
+			}
+
+			// Update the scores of every vertex whose cache position changed, including the evicted ones
+			for (u32 i = 0; i < newCacheCount; ++i) {
+				u32 const v = newCache[i];
+				cachePosition[v] = i < FORSYTH_CACHE_SIZE ? static_cast<i32>(i) : -1;
+
+				f32 const newScore = ComputeVertexScore(cachePosition[v], remainingValence[v]);
+				f32 const scoreDelta = newScore - vertexScore[v];
+				vertexScore[v] = newScore;
+
+				u32 const* pAdjacent = &adjacency[adjacencyOffsets[v]];
+				for (u32 j = 0; j < remainingValence[v]; ++j) { triangleScore[pAdjacent[j]] += scoreDelta; }
+			}
+
+			cacheCount = std::min(newCacheCount, FORSYTH_CACHE_SIZE);
+			std::copy_n(newCache.begin(), cacheCount, cache.begin());
+
+			// Find the next best triangle, only looking at the ones using cached vertices
+			bestTriangle = ~0ull;
+			f32 bestScore = -1.0f;
+			for (u32 i = 0; i < cacheCount; ++i) {
+				u32 const  v = cache[i];
+				u32 const* pAdjacent = &adjacency[adjacencyOffsets[v]];
+				for (u32 j = 0; j < remainingValence[v]; ++j) {
+					u32 const t = pAdjacent[j];
+					if (triangleScore[t] > bestScore) {
+						bestScore = triangleScore[t];
+						bestTriangle = t;
+					}
+				}
+			}
+		}
+
+		indices = std::move(output);
+	}
+
+	// Overdraw
+	//-----------------------------------------------------------------------------
+
+	void OptimizeOverdraw(Vector<u32>& indices, Vector<Vec3> const& positions, f32 threshold) {
+		CKE_ASSERT(indices.size() % 3 == 0);
+
+		// Clusters smaller than this don't have enough triangles to be sorted in a meaningful way
+		constexpr u32 MIN_CLUSTER_TRIANGLES = 8;
+
+		u64 const triangleCount = indices.size() / 3;
+		if (triangleCount == 0) { return; }
+
+		// Split the triangles into clusters
+		//-----------------------------------------------------------------------------
+
+		// Hard boundaries are placed where the cache is effectively flushed (3 misses on a triangle),
+		// soft boundaries anywhere where the cluster so far has an ACMR within the threshold.
+		// Reordering the clusters then costs little vertex cache efficiency.
+		VertexCacheStats const originalStats = AnalyzeVertexCache(indices, positions.size());
+		f32 const              maxClusterACMR = originalStats.m_ACMR * threshold;
+
+		Vector<u32> clusterStarts{0};
+		Vector<u32> timestamps(positions.size(), 0);
+		u32         time = DEFAULT_SIMULATED_CACHE_SIZE + 1;
+		u32         clusterMisses = 0;
+
+		for (u32 t = 0; t < triangleCount; ++t) {
+			u32 triangleMisses = 0;
+			for (u32 i = 0; i < 3; ++i) {
+				u32 const index = indices[t * 3 + i];
+				if (time - timestamps[index] > DEFAULT_SIMULATED_CACHE_SIZE) {
+					timestamps[index] = time++;
+					triangleMisses++;
+				}
+			}
+
+			u32 const clusterSize = t - clusterStarts.back();
+			if (clusterSize > 0) {
+				bool const hardBoundary = triangleMisses == 3;
+				bool const softBoundary = triangleMisses > 0 && clusterSize >= MIN_CLUSTER_TRIANGLES &&
+						static_cast<f32>(clusterMisses) / clusterSize <= maxClusterACMR;
+				if (hardBoundary || softBoundary) {
+					clusterStarts.push_back(t);
+					clusterMisses = 0;
+				}
+			}
+			clusterMisses += triangleMisses;
+		}
+		clusterStarts.push_back(static_cast<u32>(triangleCount));
+
+		// Compute the sort key of each cluster
+		//-----------------------------------------------------------------------------
+
+		Vec3 meshCentroid{0.0f};
+		f32  meshArea = 0.0f;
+		for (u64 t = 0; t < triangleCount; ++t) {
+			Vec3 const& p0 = positions[indices[t * 3 + 0]];
+			Vec3 const& p1 = positions[indices[t * 3 + 1]];
+			Vec3 const& p2 = positions[indices[t * 3 + 2]];
+			f32 const   area = glm::length(glm::cross(p1 - p0, p2 - p0));
+			meshCentroid += (p0 + p1 + p2) * (area / 3.0f);
+			meshArea += area;
+		}
+		meshCentroid = meshArea > 0.0f ? meshCentroid / meshArea : meshCentroid;
+
+		u64 const              clusterCount = clusterStarts.size() - 1;
+		Vector<Pair<f32, u32>> clusterKeys(clusterCount);
+		for (u64 c = 0; c < clusterCount; ++c) {
+			Vec3 centroid{0.0f};
+			Vec3 normal{0.0f};
+			f32  area = 0.0f;
+			for (u32 t = clusterStarts[c]; t < clusterStarts[c + 1]; ++t) {
+				Vec3 const& p0 = positions[indices[t * 3 + 0]];
+				Vec3 const& p1 = positions[indices[t * 3 + 1]];
+				Vec3 const& p2 = positions[indices[t * 3 + 2]];
+				Vec3 const  areaNormal = glm::cross(p1 - p0, p2 - p0);
+				f32 const   triangleArea = glm::length(areaNormal);
+				centroid += (p0 + p1 + p2) * (triangleArea / 3.0f);
+				normal += areaNormal;
+				area += triangleArea;
+			}
+
+			f32 const normalLength = glm::length(normal);
+			centroid = area > 0.0f ? centroid / area : centroid;
+			normal = normalLength > 0.0f ? normal / normalLength : normal;
+
+			// Clusters facing away from the center of the mesh are more likely to occlude the others
+			clusterKeys[c] = {glm::dot(centroid - meshCentroid, normal), static_cast<u32>(c)};
+		}
+
+		std::stable_sort(clusterKeys.begin(), clusterKeys.end(),
+		                 [](Pair<f32, u32> const& a, Pair<f32, u32> const& b) { return a.first > b.first; });
+
+		// Rebuild the index buffer with the sorted clusters
+		//-----------------------------------------------------------------------------
+
+		Vector<u32> output{};
+		output.reserve(indices.size());
+		for (auto const& [key, c] : clusterKeys) {
+			output.insert(output.end(),
+			              indices.begin() + clusterStarts[c] * 3,
+			              indices.begin() + clusterStarts[c + 1] * 3);
+		}
+		indices = std::move(output);
+	}
+
+	// Vertex Fetch
+	//-----------------------------------------------------------------------------
+
+	u64 OptimizeVertexFetchRemap(Vector<u32>& indices, u64 vertexCount, Vector<u32>& outRemap) {
+		outRemap.assign(vertexCount, INVALID_VERTEX_INDEX);
+
+		u32 nextVertex = 0;
+		for (u32& index : indices) {
+			CKE_ASSERT(index < vertexCount);
+			if (outRemap[index] == INVALID_VERTEX_INDEX) { outRemap[index] = nextVertex++; }
+			index = outRemap[index];
+		}
+
+		return nextVertex;
+	}
+}
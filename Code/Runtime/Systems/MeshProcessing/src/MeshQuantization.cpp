@@ -0,0 +1,126 @@
+#include "MeshQuantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace CKE::MeshProcessing {
+	// Scalars
+	//-----------------------------------------------------------------------------
+
+	u16 QuantizeHalf(f32 value) {
+		u32 bits;
+		memcpy(&bits, &value, sizeof(f32));
+
+		u32 const sign = (bits >> 16) & 0x8000;
+		u32 const exponentMantissa = bits & 0x7FFFFFFF;
+
+		// Re-bias the exponent (127 -> 15) and round the mantissa to the nearest 10 bits
+		u32 half = (exponentMantissa - (112u << 23) + (1u << 12)) >> 13;
+
+		// Underflow, the smallest normalized half has an exponent of -14
+		if (exponentMantissa < (113u << 23)) { half = 0; }
+		// Overflow, the biggest half has an exponent of 15
+		if (exponentMantissa >= (143u << 23)) { half = 0x7C00; }
+		// NaN, all of them are converted to a quiet NaN
+		if (exponentMantissa > (255u << 23)) { half = 0x7E00; }
+
+		return static_cast<u16>(sign | half);
+	}
+
+	f32 DequantizeHalf(u16 value) {
+		u32 const sign = static_cast<u32>(value & 0x8000) << 16;
+		u32 const exponentMantissa = value & 0x7FFF;
+
+		// Re-bias the exponent (15 -> 127)
+		u32 bits = (exponentMantissa + (112u << 10)) << 13;
+
+		// Denormals are flushed to zero
+		if (exponentMantissa < (1u << 10)) { bits = 0; }
+		// Infinity and NaN need the maximum float exponent
+		if (exponentMantissa >= (31u << 10)) { bits += 112u << 23; }
+
+		bits |= sign;
+		f32 result;
+		memcpy(&result, &bits, sizeof(f32));
+		return result;
+	}
+
+	u16 QuantizeUnorm16(f32 value) {
+		value = std::clamp(value, 0.0f, 1.0f);
+		return static_cast<u16>(value * 65535.0f + 0.5f);
+	}
+
+	f32 DequantizeUnorm16(u16 value) {
+		return static_cast<f32>(value) / 65535.0f;
+	}
+
+	i16 QuantizeSnorm16(f32 value) {
+		value = std::clamp(value, -1.0f, 1.0f);
+		return static_cast<i16>(std::round(value * 32767.0f));
+	}
+
+	f32 DequantizeSnorm16(i16 value) {
+		return std::max(static_cast<f32>(value) / 32767.0f, -1.0f);
+	}
+
+	// Directions
+	//-----------------------------------------------------------------------------
+
+	Vec2 EncodeOctahedral(Vec3 direction) {
+		f32 const l1Norm = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+		if (l1Norm == 0.0f) { return Vec2{0.0f, 0.0f}; }
+
+		// Project onto the octahedron and fold the lower hemisphere over the upper one
+		direction /= l1Norm;
+		Vec2 encoded{direction.x, direction.y};
+		if (direction.z < 0.0f) {
+			encoded = Vec2{
+				(1.0f - std::abs(direction.y)) * (direction.x >= 0.0f ? 1.0f : -1.0f),
+				(1.0f - std::abs(direction.x)) * (direction.y >= 0.0f ? 1.0f : -1.0f)
+			};
+		}
+		return encoded;
+	}
+
+	Vec3 DecodeOctahedral(Vec2 encoded) {
+		Vec3      direction{encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y)};
+		f32 const fold = std::max(-direction.z, 0.0f);
+		direction.x += direction.x >= 0.0f ? -fold : fold;
+		direction.y += direction.y >= 0.0f ? -fold : fold;
+		return glm::normalize(direction);
+	}
+
+	// Positions
+	//-----------------------------------------------------------------------------
+
+	PositionQuantization ComputePositionQuantization(Vector<Vec3> const& positions) {
+		PositionQuantization quantization{};
+		if (positions.empty()) { return quantization; }
+
+		Vec3 min = positions[0];
+		Vec3 max = positions[0];
+		for (Vec3 const& p : positions) {
+			min = glm::min(min, p);
+			max = glm::max(max, p);
+		}
+
+		// Flat axes keep a scale of 1 to avoid divisions by zero when normalizing
+		Vec3 const extent = max - min;
+		quantization.m_Bias = min;
+		quantization.m_Scale = Vec3{
+			extent.x > 0.0f ? extent.x : 1.0f,
+			extent.y > 0.0f ? extent.y : 1.0f,
+			extent.z > 0.0f ? extent.z : 1.0f,
+		};
+		return quantization;
+	}
+
+	Vec3 NormalizePosition(Vec3 position, PositionQuantization const& quantization) {
+		return (position - quantization.m_Bias) / quantization.m_Scale;
+	}
+
+	Vec3 DenormalizePosition(Vec3 normalized, PositionQuantization const& quantization) {
+		return normalized * quantization.m_Scale + quantization.m_Bias;
+	}
+}
@@ -0,0 +1,429 @@
+#include "MeshSimplification.h"
+
+#include "MeshOptimization.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <tuple>
+
+namespace CKE::MeshProcessing {
+	namespace {
+		// Weight of the planes that keep open borders in place, relative to the triangle planes
+		constexpr f64 BORDER_CONSTRAINT_WEIGHT = 10.0;
+
+		// Symmetric 4x4 matrix with the sum of the squared distances to a set of planes (Garland-Heckbert)
+		struct Quadric
+		{
+			f64 m_A00 = 0.0, m_A01 = 0.0, m_A02 = 0.0;
+			f64 m_A11 = 0.0, m_A12 = 0.0, m_A22 = 0.0;
+			f64 m_B0 = 0.0, m_B1 = 0.0, m_B2 = 0.0;
+			f64 m_C = 0.0;
+			f64 m_Weight = 0.0;
+
+			void AddPlane(Vec3 n, f64 d, f64 weight) {
+				m_A00 += weight * n.x * n.x;
+				m_A01 += weight * n.x * n.y;
+				m_A02 += weight * n.x * n.z;
+				m_A11 += weight * n.y * n.y;
+				m_A12 += weight * n.y * n.z;
+				m_A22 += weight * n.z * n.z;
+				m_B0 += weight * n.x * d;
+				m_B1 += weight * n.y * d;
+				m_B2 += weight * n.z * d;
+				m_C += weight * d * d;
+				m_Weight += weight;
+			}
+
+			Quadric& operator+=(Quadric const& other) {
+				m_A00 += other.m_A00;
+				m_A01 += other.m_A01;
+				m_A02 += other.m_A02;
+				m_A11 += other.m_A11;
+				m_A12 += other.m_A12;
+				m_A22 += other.m_A22;
+				m_B0 += other.m_B0;
+				m_B1 += other.m_B1;
+				m_B2 += other.m_B2;
+				m_C += other.m_C;
+				m_Weight += other.m_Weight;
+				return *this;
+			}
+
+			// Weighted mean of the squared distances from the point to the planes
+			f64 Evaluate(Vec3 p) const {
+				if (m_Weight <= 0.0) { return 0.0; }
+				f64 const x = p.x, y = p.y, z = p.z;
+				f64 const error =
+					m_A00 * x * x + m_A11 * y * y + m_A22 * z * z +
+					2.0 * (m_A01 * x * y + m_A02 * x * z + m_A12 * y * z) +
+					2.0 * (m_B0 * x + m_B1 * y + m_B2 * z) +
+					m_C;
+				return std::abs(error) / m_Weight;
+			}
+		};
+
+		enum class VertexKind : u8
+		{
+			Manifold, // Can be collapsed to any neighbour
+			Border,   // Can only be collapsed along its border
+			Locked,   // Non-manifold or corner of several borders, never collapsed
+		};
+
+		struct Collapse
+		{
+			u32 m_From;
+			u32 m_To;
+			f64 m_GeometricCost;
+			f64 m_Cost;
+		};
+
+		u64 EdgeKey(u32 a, u32 b) {
+			return a < b ? (static_cast<u64>(a) << 32) | b : (static_cast<u64>(b) << 32) | a;
+		}
+
+		// Maps every vertex to the first vertex with the exact same position.
+		// Collapses work on these so that seams don't look like open borders.
+		Vector<u32> BuildPositionRemap(Vector<Vec3> const& positions) {
+			Vector<u32> order(positions.size());
+			for (u32 i = 0; i < order.size(); ++i) { order[i] = i; }
+			std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b) {
+				Vec3 const& pa = positions[a];
+				Vec3 const& pb = positions[b];
+				return std::tie(pa.x, pa.y, pa.z) < std::tie(pb.x, pb.y, pb.z);
+			});
+
+			Vector<u32> remap(positions.size());
+			for (u64 i = 0; i < order.size();) {
+				u64 runEnd = i + 1;
+				while (runEnd < order.size() && positions[order[runEnd]] == positions[order[i]]) { ++runEnd; }
+				for (u64 j = i; j < runEnd; ++j) { remap[order[j]] = order[i]; }
+				i = runEnd;
+			}
+			return remap;
+		}
+
+		f64 AttributeDistance(Vector<f32> const& attributes, Vector<f32> const& weights, u32 a, u32 b) {
+			u64 const stride = weights.size();
+			f64       distance = 0.0;
+			for (u64 k = 0; k < stride; ++k) {
+				f64 const diff = weights[k] * (attributes[a * stride + k] - attributes[b * stride + k]);
+				distance += diff * diff;
+			}
+			return distance;
+		}
+
+		// Per pass view of the triangles around each position
+		struct Adjacency
+		{
+			Vector<u32> m_Offsets;
+			Vector<u32> m_Triangles;
+
+			void Build(Vector<u32> const& indices, Vector<u32> const& canonical) {
+				u64 const vertexCount = canonical.size();
+				m_Offsets.assign(vertexCount + 1, 0);
+				for (u32 index : indices) { m_Offsets[canonical[index] + 1]++; }
+				for (u64 v = 0; v < vertexCount; ++v) { m_Offsets[v + 1] += m_Offsets[v]; }
+
+				m_Triangles.resize(indices.size());
+				Vector<u32> cursor(m_Offsets.begin(), m_Offsets.end() - 1);
+				for (u32 i = 0; i < indices.size(); ++i) {
+					m_Triangles[cursor[canonical[indices[i]]]++] = i / 3;
+				}
+			}
+
+			u32 const* begin(u32 v) const { return m_Triangles.data() + m_Offsets[v]; }
+			u32 const* end(u32 v) const { return m_Triangles.data() + m_Offsets[v + 1]; }
+		};
+	}
+
+	f32 ComputeMeshExtent(Vector<Vec3> const& positions) {
+		if (positions.empty()) { return 0.0f; }
+
+		Vec3 min = positions[0];
+		Vec3 max = positions[0];
+		for (Vec3 const& p : positions) {
+			min = glm::min(min, p);
+			max = glm::max(max, p);
+		}
+		Vec3 const extent = max - min;
+		return std::max(extent.x, std::max(extent.y, extent.z));
+	}
+
+	SimplificationResult SimplifyMesh(Vector<u32> const&            indices,
+	                                  Vector<Vec3> const&           positions,
+	                                  Vector<f32> const&            attributes,
+	                                  SimplificationSettings const& settings) {
+		CKE_ASSERT(indices.size() % 3 == 0);
+		CKE_ASSERT(attributes.empty() || attributes.size() == positions.size() * settings.m_AttributeWeights.size());
+
+		SimplificationResult result{};
+		f32 const            extent = ComputeMeshExtent(positions);
+		if (extent <= 0.0f || indices.size() <= settings.m_TargetIndexCount) {
+			result.m_Indices = indices;
+			return result;
+		}
+
+		// Work in a unit sized space so the errors don't depend on the scale of the mesh
+		Vec3 const   origin = positions[0];
+		Vector<Vec3> points(positions.size());
+		for (u64 i = 0; i < positions.size(); ++i) { points[i] = (positions[i] - origin) / extent; }
+
+		Vector<u32> const canonical = BuildPositionRemap(positions);
+		u64 const         vertexCount = positions.size();
+		bool const        useAttributes = !attributes.empty() && !settings.m_AttributeWeights.empty();
+
+		Vector<u32>& current = result.m_Indices;
+		current.reserve(indices.size());
+		for (u64 i = 0; i < indices.size(); i += 3) {
+			u32 const a = canonical[indices[i + 0]];
+			u32 const b = canonical[indices[i + 1]];
+			u32 const c = canonical[indices[i + 2]];
+			if (a == b || b == c || c == a) { continue; }
+			current.insert(current.end(), {indices[i + 0], indices[i + 1], indices[i + 2]});
+		}
+
+		// Triangle planes weighted by area and border constraint planes, gathered once from the original surface
+		// and accumulated on every collapse so the error is always measured against the source mesh
+		//-----------------------------------------------------------------------------
+
+		Vector<Quadric> quadrics(vertexCount);
+		Vector<u64>     edgeKeys{};
+		edgeKeys.reserve(current.size());
+		for (u64 i = 0; i < current.size(); i += 3) {
+			for (u64 e = 0; e < 3; ++e) {
+				edgeKeys.push_back(EdgeKey(canonical[current[i + e]], canonical[current[i + (e + 1) % 3]]));
+			}
+		}
+		std::sort(edgeKeys.begin(), edgeKeys.end());
+
+		for (u64 i = 0; i < current.size(); i += 3) {
+			u32 const  v[3] = {canonical[current[i]], canonical[current[i + 1]], canonical[current[i + 2]]};
+			Vec3 const normal = glm::cross(points[v[1]] - points[v[0]], points[v[2]] - points[v[0]]);
+			f32 const  doubleArea = glm::length(normal);
+			if (doubleArea <= 0.0f) { continue; }
+
+			Vec3 const n = normal / doubleArea;
+			f64 const  d = -glm::dot(n, points[v[0]]);
+			for (u32 vertex : v) { quadrics[vertex].AddPlane(n, d, doubleArea * 0.5); }
+
+			for (u64 e = 0; e < 3; ++e) {
+				u32 const a = v[e];
+				u32 const b = v[(e + 1) % 3];
+				u64 const key = EdgeKey(a, b);
+				auto      range = std::equal_range(edgeKeys.begin(), edgeKeys.end(), key);
+				if (range.second - range.first != 1) { continue; }
+
+				// Plane perpendicular to the triangle that contains the border edge
+				Vec3 const edge = points[b] - points[a];
+				Vec3       borderNormal = glm::cross(edge, n);
+				f32 const  length = glm::length(borderNormal);
+				if (length <= 0.0f) { continue; }
+				borderNormal /= length;
+
+				f64 const borderD = -glm::dot(borderNormal, points[a]);
+				f64 const weight = glm::dot(edge, edge) * BORDER_CONSTRAINT_WEIGHT;
+				quadrics[a].AddPlane(borderNormal, borderD, weight);
+				quadrics[b].AddPlane(borderNormal, borderD, weight);
+			}
+		}
+
+		// Collapse passes, each one collapses a set of independent edges in order of increasing cost
+		//-----------------------------------------------------------------------------
+
+		f64 const maxCost = static_cast<f64>(settings.m_MaxError) * settings.m_MaxError;
+		f64       maxGeometricCost = 0.0;
+
+		Adjacency          adjacency{};
+		Vector<VertexKind> kinds(vertexCount);
+		Vector<u8>         borderEdgeCount(vertexCount);
+		Vector<u8>         touched(vertexCount);
+		Vector<u32>        wedgeRemap(vertexCount);
+		Vector<Collapse>   collapses{};
+		Vector<Pair<u32, u32>> wedgeTargets{};
+
+		// Finds the wedge that each wedge of 'from' collapses to, returns the attribute error of the collapse.
+		// Wedges that share a triangle with a wedge of 'to' stay on their side of any seam and are free,
+		// the rest have to snap to the closest wedge of 'to' and pay for the attribute difference.
+		auto const findWedgeTargets = [&](u32 from, u32 to) -> f64 {
+			wedgeTargets.clear();
+			f64 attributeError = 0.0;
+
+			for (u32 const* tri = adjacency.begin(from); tri != adjacency.end(from); ++tri) {
+				for (u64 k = 0; k < 3; ++k) {
+					u32 const wedge = current[*tri * 3 + k];
+					if (canonical[wedge] != from) { continue; }
+
+					auto const it = std::find_if(wedgeTargets.begin(), wedgeTargets.end(),
+					                             [&](Pair<u32, u32> const& t) { return t.first == wedge; });
+					if (it != wedgeTargets.end() && it->second != INVALID_VERTEX_INDEX) { continue; }
+
+					u32 target = INVALID_VERTEX_INDEX;
+					for (u64 j = 0; j < 3; ++j) {
+						if (canonical[current[*tri * 3 + j]] == to) { target = current[*tri * 3 + j]; }
+					}
+					if (it != wedgeTargets.end()) { it->second = target; }
+					else { wedgeTargets.emplace_back(wedge, target); }
+				}
+			}
+
+			for (Pair<u32, u32>& wedgeTarget : wedgeTargets) {
+				if (wedgeTarget.second != INVALID_VERTEX_INDEX) { continue; }
+
+				f64 bestDistance = std::numeric_limits<f64>::max();
+				for (u32 const* tri = adjacency.begin(to); tri != adjacency.end(to); ++tri) {
+					for (u64 k = 0; k < 3; ++k) {
+						u32 const candidate = current[*tri * 3 + k];
+						if (canonical[candidate] != to) { continue; }
+
+						f64 const distance = useAttributes
+							                     ? AttributeDistance(attributes, settings.m_AttributeWeights,
+							                                         wedgeTarget.first, candidate)
+							                     : 0.0;
+						if (distance < bestDistance) {
+							bestDistance = distance;
+							wedgeTarget.second = candidate;
+						}
+					}
+				}
+				attributeError += bestDistance;
+			}
+			return attributeError;
+		};
+
+		// Rejects collapses that would flip or degenerate any of the triangles that remain
+		auto const preservesOrientation = [&](u32 from, u32 to) -> bool {
+			for (u32 const* tri = adjacency.begin(from); tri != adjacency.end(from); ++tri) {
+				u32 v[3] = {canonical[current[*tri * 3]], canonical[current[*tri * 3 + 1]], canonical[current[*tri * 3 + 2]]};
+				if (v[0] == to || v[1] == to || v[2] == to) { continue; }
+
+				Vec3 const before = glm::cross(points[v[1]] - points[v[0]], points[v[2]] - points[v[0]]);
+				for (u32& vertex : v) { if (vertex == from) { vertex = to; } }
+				Vec3 const after = glm::cross(points[v[1]] - points[v[0]], points[v[2]] - points[v[0]]);
+
+				f32 const lengths = glm::length(before) * glm::length(after);
+				if (lengths <= 0.0f || glm::dot(before, after) <= 0.0f) { return false; }
+			}
+			return true;
+		};
+
+		while (current.size() > settings.m_TargetIndexCount) {
+			adjacency.Build(current, canonical);
+
+			// Classify vertices from the edges of the current mesh
+			edgeKeys.clear();
+			for (u64 i = 0; i < current.size(); i += 3) {
+				for (u64 e = 0; e < 3; ++e) {
+					edgeKeys.push_back(EdgeKey(canonical[current[i + e]], canonical[current[i + (e + 1) % 3]]));
+				}
+			}
+			std::sort(edgeKeys.begin(), edgeKeys.end());
+
+			std::fill(kinds.begin(), kinds.end(), VertexKind::Manifold);
+			std::fill(borderEdgeCount.begin(), borderEdgeCount.end(), 0);
+			for (u64 i = 0; i < edgeKeys.size();) {
+				u64 runEnd = i + 1;
+				while (runEnd < edgeKeys.size() && edgeKeys[runEnd] == edgeKeys[i]) { ++runEnd; }
+
+				u32 const a = static_cast<u32>(edgeKeys[i] >> 32);
+				u32 const b = static_cast<u32>(edgeKeys[i] & 0xFFFFFFFF);
+				if (runEnd - i == 1) {
+					borderEdgeCount[a] = static_cast<u8>(std::min(borderEdgeCount[a] + 1, 255));
+					borderEdgeCount[b] = static_cast<u8>(std::min(borderEdgeCount[b] + 1, 255));
+				}
+				else if (runEnd - i > 2) {
+					kinds[a] = VertexKind::Locked;
+					kinds[b] = VertexKind::Locked;
+				}
+				i = runEnd;
+			}
+			for (u64 v = 0; v < vertexCount; ++v) {
+				if (kinds[v] == VertexKind::Locked || borderEdgeCount[v] == 0) { continue; }
+				kinds[v] = borderEdgeCount[v] == 2 ? VertexKind::Border : VertexKind::Locked;
+			}
+
+			// Evaluate both directions of every edge
+			collapses.clear();
+			for (u64 i = 0; i < edgeKeys.size();) {
+				u64 runEnd = i + 1;
+				while (runEnd < edgeKeys.size() && edgeKeys[runEnd] == edgeKeys[i]) { ++runEnd; }
+				bool const isBorderEdge = runEnd - i == 1;
+
+				u32 const a = static_cast<u32>(edgeKeys[i] >> 32);
+				u32 const b = static_cast<u32>(edgeKeys[i] & 0xFFFFFFFF);
+				for (auto const& edge : {Pair<u32, u32>{a, b}, Pair<u32, u32>{b, a}}) {
+					u32 const from = edge.first;
+					u32 const to = edge.second;
+					if (kinds[from] == VertexKind::Locked) { continue; }
+					if (kinds[from] == VertexKind::Border && !isBorderEdge) { continue; }
+
+					Quadric combined = quadrics[from];
+					combined += quadrics[to];
+					f64 const geometricCost = combined.Evaluate(points[to]);
+					f64 const attributeCost = findWedgeTargets(from, to);
+					collapses.push_back({from, to, geometricCost, geometricCost + attributeCost});
+				}
+				i = runEnd;
+			}
+			std::sort(collapses.begin(), collapses.end(), [](Collapse const& a, Collapse const& b) {
+				return a.m_Cost < b.m_Cost;
+			});
+
+			// Apply the cheapest collapses whose neighbourhoods don't overlap
+			std::fill(touched.begin(), touched.end(), 0);
+			for (u32 i = 0; i < vertexCount; ++i) { wedgeRemap[i] = i; }
+
+			u64 const trianglesToRemove = (current.size() - settings.m_TargetIndexCount) / 3;
+			u64       trianglesRemoved = 0;
+			u64       collapseCount = 0;
+			for (Collapse const& collapse : collapses) {
+				if (collapse.m_Cost > maxCost || trianglesRemoved >= trianglesToRemove) { break; }
+				if (touched[collapse.m_From] || touched[collapse.m_To]) { continue; }
+				if (!preservesOrientation(collapse.m_From, collapse.m_To)) { continue; }
+
+				findWedgeTargets(collapse.m_From, collapse.m_To);
+				for (Pair<u32, u32> const& wedgeTarget : wedgeTargets) {
+					wedgeRemap[wedgeTarget.first] = wedgeTarget.second;
+				}
+				quadrics[collapse.m_To] += quadrics[collapse.m_From];
+
+				for (u32 const* tri = adjacency.begin(collapse.m_From); tri != adjacency.end(collapse.m_From); ++tri) {
+					bool removesTriangle = false;
+					for (u64 k = 0; k < 3; ++k) {
+						u32 const vertex = canonical[current[*tri * 3 + k]];
+						touched[vertex] = 1;
+						removesTriangle |= vertex == collapse.m_To;
+					}
+					trianglesRemoved += removesTriangle ? 1 : 0;
+				}
+
+				maxGeometricCost = std::max(maxGeometricCost, collapse.m_GeometricCost);
+				collapseCount++;
+			}
+
+			if (collapseCount == 0) { break; }
+
+			// Rebuild the index buffer without the collapsed triangles
+			u64 writeIndex = 0;
+			for (u64 i = 0; i < current.size(); i += 3) {
+				u32 const i0 = wedgeRemap[current[i + 0]];
+				u32 const i1 = wedgeRemap[current[i + 1]];
+				u32 const i2 = wedgeRemap[current[i + 2]];
+				u32 const a = canonical[i0];
+				u32 const b = canonical[i1];
+				u32 const c = canonical[i2];
+				if (a == b || b == c || c == a) { continue; }
+
+				current[writeIndex++] = i0;
+				current[writeIndex++] = i1;
+				current[writeIndex++] = i2;
+			}
+			current.resize(writeIndex);
+		}
+
+		result.m_Error = static_cast<f32>(std::sqrt(maxGeometricCost)) * extent;
+		return result;
+	}
+}
@@ -0,0 +1,512 @@
+#include "CookieKat/Systems/MeshProcessing/MeshOptimization.h"
+#include "CookieKat/Systems/MeshProcessing/MeshQuantization.h"
+#include "CookieKat/Systems/MeshProcessing/MeshSimplification.h"
+#include "CookieKat/Systems/MeshProcessing/MeshLOD.h"
+
+#include <gtest/gtest.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+//-----------------------------------------------------------------------------
+// Utilities
+//-----------------------------------------------------------------------------
+
+using namespace CKE;
+using namespace CKE::MeshProcessing;
+
+struct TestMesh
+{
+	Vector<Vec3> m_Positions;
+	Vector<u32>  m_Indices;
+};
+
+// Regular grid of (size x size) quads in the XY plane
+static TestMesh CreateGrid(u32 size) {
+	TestMesh mesh{};
+	for (u32 y = 0; y <= size; ++y) {
+		for (u32 x = 0; x <= size; ++x) {
+			mesh.m_Positions.emplace_back(static_cast<f32>(x), static_cast<f32>(y), 0.0f);
+		}
+	}
+
+	for (u32 y = 0; y < size; ++y) {
+		for (u32 x = 0; x < size; ++x) {
+			u32 const v0 = y * (size + 1) + x;
+			u32 const v1 = v0 + 1;
+			u32 const v2 = v0 + size + 1;
+			u32 const v3 = v2 + 1;
+			mesh.m_Indices.insert(mesh.m_Indices.end(), {v0, v1, v2, v2, v1, v3});
+		}
+	}
+	return mesh;
+}
+
+// Same grid with the triangle order shuffled, which is the worst case for the vertex cache
+static TestMesh CreateShuffledGrid(u32 size) {
+	TestMesh mesh = CreateGrid(size);
+
+	u64         triangleCount = mesh.m_Indices.size() / 3;
+	Vector<u32> order(triangleCount);
+	for (u32 i = 0; i < triangleCount; ++i) { order[i] = i; }
+	std::shuffle(order.begin(), order.end(), std::mt19937{42});
+
+	Vector<u32> shuffled{};
+	for (u32 t : order) {
+		shuffled.insert(shuffled.end(), mesh.m_Indices.begin() + t * 3, mesh.m_Indices.begin() + t * 3 + 3);
+	}
+	mesh.m_Indices = shuffled;
+	return mesh;
+}
+
+// UV sphere of radius 1 with a texture seam, the first and last column of vertices share positions
+// but not texture coordinates. m_TexCoords has 2 floats per vertex.
+struct TestSphere : TestMesh
+{
+	Vector<f32> m_TexCoords;
+};
+
+static TestSphere CreateSphere(u32 segments, u32 rings) {
+	TestSphere mesh{};
+	for (u32 r = 0; r <= rings; ++r) {
+		f32 const v = static_cast<f32>(r) / rings;
+		f32 const theta = v * glm::pi<f32>();
+		for (u32 s = 0; s <= segments; ++s) {
+			f32 const u = static_cast<f32>(s) / segments;
+			f32 const phi = u * glm::two_pi<f32>();
+			// Avoid the floating point noise of sin/cos so that the seam and the poles share exact positions
+			f32 const cosPhi = s == segments ? 1.0f : std::cos(phi);
+			f32 const sinPhi = s == segments ? 0.0f : std::sin(phi);
+			f32 const sinTheta = r == 0 || r == rings ? 0.0f : std::sin(theta);
+			mesh.m_Positions.emplace_back(sinTheta * cosPhi, std::cos(theta), sinTheta * sinPhi);
+			mesh.m_TexCoords.insert(mesh.m_TexCoords.end(), {u, v});
+		}
+	}
+
+	for (u32 r = 0; r < rings; ++r) {
+		for (u32 s = 0; s < segments; ++s) {
+			u32 const v0 = r * (segments + 1) + s;
+			u32 const v1 = v0 + 1;
+			u32 const v2 = v0 + segments + 1;
+			u32 const v3 = v2 + 1;
+			if (r != 0) { mesh.m_Indices.insert(mesh.m_Indices.end(), {v0, v1, v2}); }
+			if (r != rings - 1) { mesh.m_Indices.insert(mesh.m_Indices.end(), {v2, v1, v3}); }
+		}
+	}
+	return mesh;
+}
+
+// Number of edges, keyed by position, that are used by a single triangle
+static u64 CountOpenEdges(TestMesh const& mesh) {
+	using Edge = Pair<Array<f32, 3>, Array<f32, 3>>;
+	Vector<Edge> edges{};
+	for (u64 i = 0; i < mesh.m_Indices.size(); i += 3) {
+		for (u64 e = 0; e < 3; ++e) {
+			Vec3 const    a = mesh.m_Positions[mesh.m_Indices[i + e]];
+			Vec3 const    b = mesh.m_Positions[mesh.m_Indices[i + (e + 1) % 3]];
+			Array<f32, 3> ka{a.x, a.y, a.z};
+			Array<f32, 3> kb{b.x, b.y, b.z};
+			edges.push_back(ka < kb ? Edge{ka, kb} : Edge{kb, ka});
+		}
+	}
+	std::sort(edges.begin(), edges.end());
+
+	u64 openEdges = 0;
+	for (u64 i = 0; i < edges.size();) {
+		u64 runEnd = i + 1;
+		while (runEnd < edges.size() && edges[runEnd] == edges[i]) { ++runEnd; }
+		openEdges += runEnd - i == 1 ? 1 : 0;
+		i = runEnd;
+	}
+	return openEdges;
+}
+
+// Returns the triangles as sorted tuples so that two index buffers can be compared ignoring the order
+static Vector<Array<Vec3, 3>> GetSortedTriangles(TestMesh const& mesh) {
+	Vector<Array<Vec3, 3>> triangles{};
+	for (u64 i = 0; i < mesh.m_Indices.size(); i += 3) {
+		triangles.push_back({
+			mesh.m_Positions[mesh.m_Indices[i + 0]],
+			mesh.m_Positions[mesh.m_Indices[i + 1]],
+			mesh.m_Positions[mesh.m_Indices[i + 2]],
+		});
+	}
+
+	auto const lessVec3 = [](Vec3 const& a, Vec3 const& b) {
+		return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+	};
+	std::sort(triangles.begin(), triangles.end(), [&](Array<Vec3, 3> const& a, Array<Vec3, 3> const& b) {
+		return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), lessVec3);
+	});
+	return triangles;
+}
+
+//-----------------------------------------------------------------------------
+// Analysis
+//-----------------------------------------------------------------------------
+
+TEST(MeshProcessing, AnalyzeVertexCache_SingleTriangle) {
+	Vector<u32> indices{0, 1, 2};
+
+	VertexCacheStats stats = AnalyzeVertexCache(indices, 3);
+	EXPECT_EQ(stats.m_TriangleCount, 1);
+	EXPECT_EQ(stats.m_VerticesTransformed, 3);
+	EXPECT_FLOAT_EQ(stats.m_ACMR, 3.0f);
+	EXPECT_FLOAT_EQ(stats.m_ATVR, 1.0f);
+}
+
+TEST(MeshProcessing, AnalyzeVertexCache_SharedVerticesHit) {
+	// Quad made of 2 triangles sharing an edge, only 4 vertices are transformed
+	Vector<u32> indices{0, 1, 2, 2, 1, 3};
+
+	VertexCacheStats stats = AnalyzeVertexCache(indices, 4);
+	EXPECT_EQ(stats.m_VerticesTransformed, 4);
+	EXPECT_FLOAT_EQ(stats.m_ACMR, 2.0f);
+	EXPECT_FLOAT_EQ(stats.m_ATVR, 1.0f);
+}
+
+//-----------------------------------------------------------------------------
+// Optimizations
+//-----------------------------------------------------------------------------
+
+TEST(MeshProcessing, OptimizeVertexCache_ImprovesACMR) {
+	TestMesh mesh = CreateShuffledGrid(64);
+	auto     trianglesBefore = GetSortedTriangles(mesh);
+
+	VertexCacheStats before = AnalyzeVertexCache(mesh.m_Indices, mesh.m_Positions.size());
+	OptimizeVertexCache(mesh.m_Indices, mesh.m_Positions.size());
+	VertexCacheStats after = AnalyzeVertexCache(mesh.m_Indices, mesh.m_Positions.size());
+
+	// A regular grid can reach an ACMR close to 0.5-0.7 with a 16 entry cache
+	EXPECT_LT(after.m_ACMR, before.m_ACMR);
+	EXPECT_LT(after.m_ACMR, 0.9f);
+	EXPECT_EQ(GetSortedTriangles(mesh), trianglesBefore);
+}
+
+TEST(MeshProcessing, OptimizeOverdraw_KeepsTrianglesAndCacheEfficiency) {
+	TestMesh mesh = CreateShuffledGrid(64);
+	OptimizeVertexCache(mesh.m_Indices, mesh.m_Positions.size());
+	auto trianglesBefore = GetSortedTriangles(mesh);
+
+	VertexCacheStats before = AnalyzeVertexCache(mesh.m_Indices, mesh.m_Positions.size());
+	OptimizeOverdraw(mesh.m_Indices, mesh.m_Positions, 1.05f);
+	VertexCacheStats after = AnalyzeVertexCache(mesh.m_Indices, mesh.m_Positions.size());
+
+	EXPECT_EQ(GetSortedTriangles(mesh), trianglesBefore);
+	EXPECT_LT(after.m_ACMR, before.m_ACMR * 1.25f);
+}
+
+TEST(MeshProcessing, OptimizeVertexFetchRemap_SequentialOrder) {
+	TestMesh mesh = CreateShuffledGrid(16);
+	auto     trianglesBefore = GetSortedTriangles(mesh);
+
+	// Add an unreferenced vertex that must be dropped
+	mesh.m_Positions.emplace_back(100.0f, 100.0f, 100.0f);
+
+	Vector<u32> remap{};
+	u64 const   newVertexCount = OptimizeVertexFetchRemap(mesh.m_Indices, mesh.m_Positions.size(), remap);
+	RemapVertexStream(mesh.m_Positions, remap, newVertexCount);
+
+	EXPECT_EQ(newVertexCount, 17 * 17);
+	EXPECT_EQ(remap.back(), INVALID_VERTEX_INDEX);
+	EXPECT_EQ(GetSortedTriangles(mesh), trianglesBefore);
+
+	// Every vertex is first referenced in increasing order
+	u32 maxSeen = 0;
+	for (u32 index : mesh.m_Indices) {
+		EXPECT_LE(index, maxSeen + 1);
+		maxSeen = std::max(maxSeen, index);
+	}
+
+	VertexFetchStats fetch = AnalyzeVertexFetch(mesh.m_Indices, mesh.m_Positions.size(), sizeof(Vec3));
+	EXPECT_GE(fetch.m_Overfetch, 1.0f);
+}
+
+//-----------------------------------------------------------------------------
+// Quantization
+//-----------------------------------------------------------------------------
+
+TEST(MeshProcessing, Half_RoundTrip) {
+	EXPECT_EQ(QuantizeHalf(0.0f), 0x0000);
+	EXPECT_EQ(QuantizeHalf(1.0f), 0x3C00);
+	EXPECT_EQ(QuantizeHalf(-2.0f), 0xC000);
+	EXPECT_EQ(QuantizeHalf(1e6f), 0x7C00);
+
+	for (f32 v : {0.0f, 0.5f, 1.0f, -1.0f, 0.333f, 0.999f, 12.75f, -4096.0f}) {
+		EXPECT_NEAR(DequantizeHalf(QuantizeHalf(v)), v, std::abs(v) * 1e-3f);
+	}
+}
+
+TEST(MeshProcessing, Norm16_RoundTrip) {
+	EXPECT_EQ(QuantizeUnorm16(0.0f), 0);
+	EXPECT_EQ(QuantizeUnorm16(1.0f), 65535);
+	EXPECT_EQ(QuantizeSnorm16(-1.0f), -32767);
+	EXPECT_EQ(QuantizeSnorm16(1.0f), 32767);
+
+	for (f32 v : {0.0f, 0.25f, 0.5f, 0.75f, 1.0f}) {
+		EXPECT_NEAR(DequantizeUnorm16(QuantizeUnorm16(v)), v, 1.0f / 65535.0f);
+		EXPECT_NEAR(DequantizeSnorm16(QuantizeSnorm16(-v)), -v, 1.0f / 32767.0f);
+	}
+}
+
+TEST(MeshProcessing, Octahedral_RoundTrip) {
+	std::mt19937                        rng{7};
+	std::uniform_real_distribution<f32> dist{-1.0f, 1.0f};
+
+	for (u32 i = 0; i < 1000; ++i) {
+		Vec3 dir{dist(rng), dist(rng), dist(rng)};
+		if (glm::length(dir) < 0.01f) { continue; }
+		dir = glm::normalize(dir);
+
+		// Through the 16-bit snorm storage used by the vertex streams
+		Vec2 encoded = EncodeOctahedral(dir);
+		Vec2 stored{
+			DequantizeSnorm16(QuantizeSnorm16(encoded.x)),
+			DequantizeSnorm16(QuantizeSnorm16(encoded.y))
+		};
+		Vec3 decoded = DecodeOctahedral(stored);
+
+		EXPECT_GT(glm::dot(dir, decoded), 0.99999f);
+	}
+}
+
+TEST(MeshProcessing, PositionQuantization_RoundTrip) {
+	Vector<Vec3> positions{{-2.0f, 0.0f, 5.0f}, {3.0f, 0.0f, 7.5f}, {0.5f, 0.0f, 6.0f}};
+
+	PositionQuantization q = ComputePositionQuantization(positions);
+	EXPECT_EQ(q.m_Bias, Vec3(-2.0f, 0.0f, 5.0f));
+	EXPECT_EQ(q.m_Scale, Vec3(5.0f, 1.0f, 2.5f));
+
+	for (Vec3 const& p : positions) {
+		Vec3 n = NormalizePosition(p, q);
+		Vec3 stored{DequantizeUnorm16(QuantizeUnorm16(n.x)),
+		            DequantizeUnorm16(QuantizeUnorm16(n.y)),
+		            DequantizeUnorm16(QuantizeUnorm16(n.z))};
+		Vec3 restored = DenormalizePosition(stored, q);
+		EXPECT_LT(glm::length(restored - p), 1e-3f);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Simplification
+//-----------------------------------------------------------------------------
+
+TEST(MeshProcessing, SimplifyMesh_FlatGridKeepsBorders) {
+	TestMesh mesh = CreateGrid(32);
+
+	SimplificationSettings settings{};
+	settings.m_TargetIndexCount = 0;
+	settings.m_MaxError = 1e-4f;
+	SimplificationResult result = SimplifyMesh(mesh.m_Indices, mesh.m_Positions, {}, settings);
+
+	// A plane can be collapsed to a handful of triangles without any error
+	EXPECT_LT(result.m_Indices.size(), mesh.m_Indices.size() / 8);
+	EXPECT_LT(result.m_Error, 1e-3f);
+
+	// The outline of the grid is still covered
+	f32 area = 0.0f;
+	for (u64 i = 0; i < result.m_Indices.size(); i += 3) {
+		Vec3 const a = mesh.m_Positions[result.m_Indices[i]];
+		Vec3 const b = mesh.m_Positions[result.m_Indices[i + 1]];
+		Vec3 const c = mesh.m_Positions[result.m_Indices[i + 2]];
+		Vec3 const normal = glm::cross(b - a, c - a);
+		EXPECT_GT(normal.z, 0.0f);
+		area += normal.z * 0.5f;
+	}
+	EXPECT_NEAR(area, 32.0f * 32.0f, 1e-2f);
+}
+
+TEST(MeshProcessing, SimplifyMesh_SphereReachesTargetWithinError) {
+	TestSphere sphere = CreateSphere(64, 32);
+
+	SimplificationSettings settings{};
+	settings.m_TargetIndexCount = sphere.m_Indices.size() / 4;
+	settings.m_MaxError = 0.05f;
+	SimplificationResult result = SimplifyMesh(sphere.m_Indices, sphere.m_Positions, {}, settings);
+
+	EXPECT_LE(result.m_Indices.size(), settings.m_TargetIndexCount);
+	EXPECT_GT(result.m_Indices.size(), 0);
+	EXPECT_GT(result.m_Error, 0.0f);
+	EXPECT_LE(result.m_Error, settings.m_MaxError * ComputeMeshExtent(sphere.m_Positions));
+
+	// Collapsing never moves vertices, so the surface is still closed around the seam
+	TestMesh simplified{sphere.m_Positions, result.m_Indices};
+	EXPECT_EQ(CountOpenEdges(simplified), 0);
+}
+
+TEST(MeshProcessing, SimplifyMesh_SeamWedgesStayOnTheirSide) {
+	TestSphere sphere = CreateSphere(32, 16);
+
+	SimplificationSettings settings{};
+	settings.m_TargetIndexCount = sphere.m_Indices.size() / 4;
+	settings.m_MaxError = 0.1f;
+	settings.m_AttributeWeights = {1.0f, 1.0f};
+	SimplificationResult result = SimplifyMesh(sphere.m_Indices, sphere.m_Positions, sphere.m_TexCoords, settings);
+	EXPECT_LT(result.m_Indices.size(), sphere.m_Indices.size() / 2);
+
+	// No triangle stretches its texture coordinates across the whole texture
+	for (u64 i = 0; i < result.m_Indices.size(); i += 3) {
+		f32 minU = 1.0f, maxU = 0.0f;
+		for (u64 k = 0; k < 3; ++k) {
+			f32 const u = sphere.m_TexCoords[result.m_Indices[i + k] * 2];
+			minU = std::min(minU, u);
+			maxU = std::max(maxU, u);
+		}
+		EXPECT_LT(maxU - minU, 0.5f);
+	}
+}
+
+TEST(MeshProcessing, SimplifyMesh_ErrorIncreasesWithReduction) {
+	TestSphere sphere = CreateSphere(64, 32);
+
+	f32 previousError = 0.0f;
+	for (u64 divisor : {2, 4, 8, 16}) {
+		SimplificationSettings settings{};
+		settings.m_TargetIndexCount = sphere.m_Indices.size() / divisor;
+		settings.m_MaxError = 1.0f;
+		SimplificationResult result = SimplifyMesh(sphere.m_Indices, sphere.m_Positions, {}, settings);
+
+		EXPECT_GE(result.m_Error, previousError);
+		previousError = result.m_Error;
+	}
+}
+
+//-----------------------------------------------------------------------------
+// LOD Selection
+//-----------------------------------------------------------------------------
+
+TEST(MeshProcessing, ComputeScreenSpaceError_ProjectsToPixels) {
+	// 90 degrees vertical FOV, 1080 pixels viewport, 1 unit at 1 unit of distance covers half the screen
+	f32 const projectionScale = 1.0f / std::tan(glm::radians(45.0f));
+	EXPECT_NEAR(ComputeScreenSpaceError(1.0f, 1.0f, projectionScale, 1080.0f), 540.0f, 1e-2f);
+	EXPECT_NEAR(ComputeScreenSpaceError(1.0f, 10.0f, projectionScale, 1080.0f), 54.0f, 1e-2f);
+	EXPECT_NEAR(ComputeScreenSpaceError(0.5f, 10.0f, projectionScale, 1080.0f), 27.0f, 1e-2f);
+}
+
+TEST(MeshProcessing, SelectLOD_CoarserWithDistance) {
+	Vector<MeshLOD> lods{
+		{0, 3000, 0.0f},
+		{3000, 1500, 0.001f},
+		{4500, 750, 0.004f},
+		{5250, 375, 0.016f},
+	};
+	f32 const projectionScale = 1.0f / std::tan(glm::radians(30.0f));
+
+	EXPECT_EQ(SelectLOD(lods, 1.0f, 0.1f, projectionScale, 1080.0f), 0);
+
+	u32 previous = 0;
+	for (f32 distance = 0.1f; distance < 1000.0f; distance *= 1.5f) {
+		u32 const lod = SelectLOD(lods, 1.0f, distance, projectionScale, 1080.0f);
+		EXPECT_GE(lod, previous);
+		EXPECT_LE(ComputeScreenSpaceError(lods[lod].m_Error, distance, projectionScale, 1080.0f), 1.0f);
+		previous = lod;
+	}
+	EXPECT_EQ(previous, 3);
+
+	// A scaled up object needs to be further away for the same LOD
+	f32 const distance = 20.0f;
+	EXPECT_LE(SelectLOD(lods, 4.0f, distance, projectionScale, 1080.0f),
+	          SelectLOD(lods, 1.0f, distance, projectionScale, 1080.0f));
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, they only print timings. Run them with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+
+// Imported like the MeshCompiler does, m_TexCoords packs the texture coordinates and the normal of each vertex
+static bool LoadModel(char const* path, TestSphere& outMesh) {
+	Assimp::Importer importer;
+	aiScene const*   aiScene = importer.ReadFile(path,
+	                                             aiProcess_GenSmoothNormals |
+	                                             aiProcess_Triangulate |
+	                                             aiProcess_JoinIdenticalVertices |
+	                                             aiProcess_SortByPType);
+	if (aiScene == nullptr || aiScene->mNumMeshes == 0) { return false; }
+
+	aiMesh const* aiMesh = aiScene->mMeshes[0];
+	for (u32 i = 0; i < aiMesh->mNumVertices; ++i) {
+		aiVector3D const& pos = aiMesh->mVertices[i];
+		aiVector3D const& normal = aiMesh->mNormals[i];
+		aiVector3D const  texCoord = aiMesh->HasTextureCoords(0) ? aiMesh->mTextureCoords[0][i] : aiVector3D{};
+		outMesh.m_Positions.emplace_back(pos.x, pos.y, pos.z);
+		outMesh.m_TexCoords.insert(outMesh.m_TexCoords.end(), {
+			                           texCoord.x, texCoord.y, normal.x, normal.y, normal.z
+		                           });
+	}
+	for (u32 i = 0; i < aiMesh->mNumFaces; ++i) {
+		if (aiMesh->mFaces[i].mNumIndices != 3) { continue; }
+		outMesh.m_Indices.insert(outMesh.m_Indices.end(), aiMesh->mFaces[i].mIndices, aiMesh->mFaces[i].mIndices + 3);
+	}
+	return !outMesh.m_Indices.empty();
+}
+
+// Same chain as the MeshCompiler, each LOD halves the previous one until the simplification stalls
+static Vector<MeshLOD> BuildLODChain(TestSphere const& mesh, Vector<f32> const& attributeWeights) {
+	Vector<MeshLOD> lods{{0, static_cast<u32>(mesh.m_Indices.size()), 0.0f}};
+	Vector<u32>     indices = mesh.m_Indices;
+	while (lods.size() < 8) {
+		SimplificationSettings settings{};
+		settings.m_TargetIndexCount = indices.size() / 6 * 3;
+		settings.m_MaxError = 0.05f;
+		settings.m_AttributeWeights = attributeWeights;
+
+		SimplificationResult lod = SimplifyMesh(indices, mesh.m_Positions, mesh.m_TexCoords, settings);
+		if (lod.m_Indices.empty() || lod.m_Indices.size() > indices.size() * 0.9f) { break; }
+
+		lods.push_back({0, static_cast<u32>(lod.m_Indices.size()), lods.back().m_Error + lod.m_Error});
+		indices = std::move(lod.m_Indices);
+	}
+	return lods;
+}
+
+static void PrintLODChainTime(char const* name, TestSphere const& mesh, Vector<f32> const& attributeWeights) {
+	auto const            start = std::chrono::high_resolution_clock::now();
+	Vector<MeshLOD> const lods = BuildLODChain(mesh, attributeWeights);
+	auto const            end = std::chrono::high_resolution_clock::now();
+
+	f64 const ms = std::chrono::duration<f64, std::milli>(end - start).count();
+	std::cout << "[Benchmark] " << name << ": " << mesh.m_Indices.size() / 3 << " triangles, "
+		<< lods.size() << " LODs in " << ms << " ms, coarsest LOD " << lods.back().m_IndexCount / 3 << " triangles"
+		<< std::endl;
+}
+
+TEST(MeshProcessing, DISABLED_Benchmark_SimplifyLODChain) {
+	TestSphere const sphere = CreateSphere(512, 256);
+	PrintLODChainTime("Sphere", sphere, {1.0f, 1.0f});
+
+	// Source models of the Data folder, resolved from the binaries folder like the ResourceSystem does
+	for (char const* model : {"Cerberus", "Monkey"}) {
+		String const path = String{"../../../../Data/Models/"} + model + ".fbx";
+		TestSphere   mesh{};
+		if (!LoadModel(path.c_str(), mesh)) {
+			std::cout << "[Benchmark] " << model << ": can't load " << path << std::endl;
+			continue;
+		}
+		PrintLODChainTime(model, mesh, {1.0f, 1.0f, 0.5f, 0.5f, 0.5f});
+	}
+}
+
+TEST(MeshProcessing, DISABLED_Benchmark_SelectLOD) {
+	Vector<MeshLOD> lods{{0, 0, 0.0f}, {0, 0, 0.001f}, {0, 0, 0.002f}, {0, 0, 0.004f}, {0, 0, 0.008f}};
+	f32 const       projectionScale = 1.0f / std::tan(glm::radians(30.0f));
+
+	constexpr u32 SELECTIONS = 1'000'000;
+	u64           lodSum = 0;
+
+	auto const start = std::chrono::high_resolution_clock::now();
+	for (u32 i = 0; i < SELECTIONS; ++i) {
+		lodSum += SelectLOD(lods, 1.0f, 1.0f + static_cast<f32>(i % 1000), projectionScale, 1080.0f);
+	}
+	auto const end = std::chrono::high_resolution_clock::now();
+
+	f64 const ns = std::chrono::duration<f64, std::nano>(end - start).count() / SELECTIONS;
+	std::cout << "[Benchmark] SelectLOD " << ns << " ns per object" << std::endl;
+	EXPECT_GT(lodSum, 0);
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "CookieKat/Core/Containers/String.h"
+#include "CookieKat/Systems/RenderAPI/RenderHandle.h"
 
 namespace CKE {
 	enum class BufferUsageFlags : u32
@@ -90,4 +91,12 @@ namespace CKE {
 			  m_StrideInBytes{mStrideInBytes},
 			  m_DebugName{mName} {}
 	};
+
+	// Bytes of a buffer that a shader binding reads, a size of 0 reaches the end of the buffer
+	struct BufferRange
+	{
+		BufferHandle m_Buffer{};
+		u64          m_OffsetInBytes = 0;
+		u64          m_SizeInBytes = 0;
+	};
 }
@@ -144,5 +144,7 @@ namespace CKE {
 
 #ifdef CKE_GRAPHICS_VULKAN_BACKEND
 #include "CookieKat/Systems/RenderAPI/Vulkan/CommandList_Vk.h"
+#elif defined(CKE_GRAPHICS_NULL_BACKEND)
+#include "CookieKat/Systems/RenderAPI/Null/CommandList_Null.h"
 #else
 #endif
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "CookieKat/Systems/RenderAPI/RenderHandle.h"
+#include "CookieKat/Systems/RenderAPI/Buffer.h"
 #include "CookieKat/Systems/RenderAPI/Pipeline.h"
 
+namespace CKE {
+	// Forward Declarations
+	class RenderDevice;
+}
+
 namespace CKE {
 	// A DescriptorSetBuilder is created using RenderDevice::CreateDescriptorSetBuilder(...)
 	class DescriptorSetBuilder
@@ -13,16 +19,28 @@ namespace CKE {
 
 		// Binds a buffer to the specified slot as an uniform buffer
 		DescriptorSetBuilder& BindUniformBuffer(u32 slot, BufferHandle buffer);
+		DescriptorSetBuilder& BindUniformBuffer(u32 slot, BufferRange range);
 
 		// Binds a buffer to the specified slot as an storage buffer
 		DescriptorSetBuilder& BindStorageBuffer(u32 slot, BufferHandle buffer);
+		DescriptorSetBuilder& BindStorageBuffer(u32 slot, BufferRange range);
+
+		// Binds a range that moves every frame, like the ones of the upload ring. The offset is passed
+		// when the set is bound, so every range of the buffer reuses the same cached set.
+		DescriptorSetBuilder& BindDynamicUniformBuffer(u32 slot, BufferRange range);
+		DescriptorSetBuilder& BindDynamicStorageBuffer(u32 slot, BufferRange range);
 
 		// Binds a combined texture sampler pair to the given slot
 		DescriptorSetBuilder& BindTextureWithSampler(u32 slot, TextureViewHandle textureView, SamplerHandle sampler);
 
-		// Builds a descriptor set using the binded resources
+		// Builds a descriptor set using the binded resources, the set is valid for the current frame.
+		// Sets built with the same bindings are cached, building them again returns the cached set.
 		DescriptorSetHandle Build();
 
+		// Builds a set that stays cached until a resource it binds is destroyed, for long-lived
+		// bindings like the ones of static materials that are built again every frame
+		DescriptorSetHandle BuildPersistent();
+
 	public:
 		// Contains a generic descriptor binding
 		struct Bindings
@@ -33,6 +51,12 @@ namespace CKE {
 			// on the shader binding type.
 			u64 m_ResourceID1;
 			u64 m_ResourceID2;
+			// Range of the buffer bindings, a size of 0 reaches the end of the buffer
+			u64  m_OffsetInBytes = 0;
+			u64  m_SizeInBytes = 0;
+			bool m_IsDynamic = false; // The offset is passed when the set is bound instead of written to it
+
+			bool operator==(Bindings const&) const = default;
 		};
 
 	private:
@@ -42,6 +66,7 @@ namespace CKE {
 
 		PipelineHandle   m_PipelineHandle{};
 		u64              m_SetIndex{}; // Index at which the set will be bound to
+		u32              m_ThreadIdx = 0; // Recording thread that builds the set
 		Vector<Bindings> m_Bindings{};
 	};
 }
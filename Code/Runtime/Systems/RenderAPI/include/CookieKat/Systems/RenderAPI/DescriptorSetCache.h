@@ -0,0 +1,89 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Systems/RenderAPI/RenderHandle.h"
+#include "CookieKat/Systems/RenderAPI/DescriptorSetBuilder.h"
+
+namespace CKE {
+	struct DescriptorSetCacheStats
+	{
+		u64 m_Hits = 0;
+		u64 m_Misses = 0;
+		u64 m_Evictions = 0; // Sets dropped to make room, invalidated ones aren't counted
+	};
+
+	// Hash of the descriptor set built with the bindings for the set index of a pipeline layout.
+	// The order of the bindings is part of it, binding the same resources in another order is another set.
+	// Dynamic bindings leave out their offset, and dynamic storage buffers their size as they reach the end of the buffer.
+	u64 HashDescriptorSetBindings(u64 layoutID, u64 setIndex, Vector<DescriptorSetBuilder::Bindings> const& bindings);
+
+	// True if both bindings build the same set, compares what HashDescriptorSetBindings hashes
+	bool IsSameDescriptorSet(Vector<DescriptorSetBuilder::Bindings> const& a, Vector<DescriptorSetBuilder::Bindings> const& b);
+
+	// Finds descriptor sets that were already built with the same layout, set index and bindings.
+	//
+	// It only keeps track of the handles, the device creates the sets and destroys the ones that the
+	// cache hands back. Up to the capacity of sets are evicted least recently used first, persistent
+	// sets aren't counted in it and stay until a resource they bind is invalidated or the cache is cleared.
+	class DescriptorSetCache
+	{
+	public:
+		void Initialize(u64 capacity);
+
+		// Returns an invalid handle if the set isn't cached, a persistent lookup pins the set it finds
+		DescriptorSetHandle Find(u64                                           hash, u64 layoutID, u64 setIndex,
+		                         Vector<DescriptorSetBuilder::Bindings> const& bindings, bool isPersistent = false);
+
+		// Adds a set that Find missed, the sets evicted to make room are appended to evictedSets
+		void Insert(u64                                           hash, u64 layoutID, u64 setIndex,
+		            Vector<DescriptorSetBuilder::Bindings> const& bindings, DescriptorSetHandle set,
+		            bool                                          isPersistent, Vector<DescriptorSetHandle>& evictedSets);
+
+		// Removes the sets with the layout or with a binding to the resource, persistent ones included
+		void InvalidateResource(u64 resourceID, Vector<DescriptorSetHandle>& removedSets);
+
+		// Removes every set, persistent ones included
+		void Clear(Vector<DescriptorSetHandle>& removedSets);
+
+		inline DescriptorSetCacheStats const& GetStats() const { return m_Stats; }
+		inline u64                            GetCapacity() const { return m_Capacity; }
+		inline u64                            GetNumSets() const { return m_NumRecentSets + m_NumPersistentSets; }
+		inline u64                            GetNumPersistentSets() const { return m_NumPersistentSets; }
+
+	private:
+		static constexpr u32 INVALID_ENTRY = 0xFFFFFFFF;
+
+		struct Entry
+		{
+			u64                                    m_Hash = 0;
+			u64                                    m_LayoutID = 0;
+			u64                                    m_SetIndex = 0;
+			Vector<DescriptorSetBuilder::Bindings> m_Bindings{}; // Compared on lookup, hashes can collide
+			DescriptorSetHandle                    m_Set{};
+			bool                                   m_IsPersistent = false;
+			u32                                    m_NextInBucket = INVALID_ENTRY;
+			u32                                    m_Newer = INVALID_ENTRY; // Recently used list, only of non-persistent sets
+			u32                                    m_Older = INVALID_ENTRY;
+		};
+
+		u32  FindEntry(u64 hash, u64 layoutID, u64 setIndex, Vector<DescriptorSetBuilder::Bindings> const& bindings) const;
+		void RemoveEntry(u32 entryIdx, Vector<DescriptorSetHandle>& removedSets);
+
+		void LinkAsNewest(u32 entryIdx);
+		void Unlink(u32 entryIdx);
+
+	private:
+		u64 m_Capacity = 0;
+
+		Vector<Entry> m_Entries{};
+		Vector<u32>   m_FreeEntries{};
+		Map<u64, u32> m_Buckets{}; // First entry with each hash
+
+		u32 m_Newest = INVALID_ENTRY;
+		u32 m_Oldest = INVALID_ENTRY;
+		u64 m_NumRecentSets = 0;
+		u64 m_NumPersistentSets = 0;
+
+		DescriptorSetCacheStats m_Stats{};
+	};
+}
@@ -55,6 +55,10 @@ namespace CKE {
 		TextureSampler* GetTextureSampler(SamplerHandle handle);
 		void            RemoveTextureSampler(SamplerHandle handle);
 
+		MemoryHeap* CreateMemoryHeap();
+		MemoryHeap* GetMemoryHeap(MemoryHeapHandle handle);
+		void        RemoveMemoryHeap(MemoryHeapHandle handle);
+
 		// Queue
 		//-----------------------------------------------------------------------------
 
@@ -90,6 +94,10 @@ namespace CKE {
 		DescriptorSet*             CreateDescriptorSetForFrame(u32 frameIdx);
 		DescriptorSet&             GetDescriptorSet(DescriptorSetHandle handle, u32 frameIdx);
 		void                       DestroyAllDescriptorSets(u32 frameIdx);
+
+		// Sets of the descriptor set cache, DestroyAllDescriptorSets(...) doesn't remove them
+		DescriptorSet* CreateCachedDescriptorSet(u32 frameIdx);
+		void           RemoveCachedDescriptorSet(DescriptorSetHandle handle, u32 frameIdx);
 		void                       CreatePipelineFrameData(PipelineHandle renderHandle);
 
 	private:
@@ -152,6 +160,7 @@ namespace CKE {
 		PooledMap<TextureHandle, Texture>         m_Textures{1000};
 		PooledMap<TextureViewHandle, TextureView> m_TextureViews{1000};
 		PooledMap<SamplerHandle, TextureSampler>  m_TextureSamplers{50};
+		PooledMap<MemoryHeapHandle, MemoryHeap>   m_MemoryHeaps{50};
 
 		PooledMap<SemaphoreHandle, Semaphore> m_Semaphores{500};
 		PooledMap<FenceHandle, Fence>         m_Fences{500};
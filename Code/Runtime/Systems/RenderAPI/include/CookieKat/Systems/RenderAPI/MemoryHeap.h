@@ -0,0 +1,13 @@
+#pragma once
+
+#include "CookieKat/Core/Platform/PrimitiveTypes.h"
+
+namespace CKE {
+	// Memory needed to place a resource in a MemoryHeap
+	struct MemoryRequirements
+	{
+		u64 m_SizeInBytes = 0;
+		u64 m_Alignment = 1;
+		u32 m_MemoryTypeBits = ~0u; // Memory types the resource can be placed in, the heap must use one of them
+	};
+}
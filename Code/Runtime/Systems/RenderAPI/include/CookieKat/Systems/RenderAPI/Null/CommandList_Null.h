@@ -0,0 +1,156 @@
+#pragma once
+
+#include "CookieKat/Systems/RenderAPI/Pipeline.h"
+#include "CookieKat/Systems/RenderAPI/Texture.h"
+#include "CookieKat/Core/Containers/String.h"
+
+namespace CKE {
+	// Forward Declarations
+	class RenderDevice;
+}
+
+namespace CKE {
+	// Commands the null backend records, one for each CommandList method
+	enum class NullCommandType : u8
+	{
+		Begin,
+		End,
+		BeginSecondary,
+		ExecuteCommands,
+		BeginRendering,
+		EndRendering,
+		SetVertexBuffer,
+		SetIndexBuffer,
+		Draw,
+		DrawIndexed,
+		SetPipeline,
+		SetViewport,
+		SetScissor,
+		BindDescriptor,
+		PushConstant,
+		Barrier,
+		CopyBuffer,
+		CopyTexture,
+		CopyBufferToTexture,
+		CopyTextureToBuffer,
+		Dispatch,
+		BeginDebugLabel,
+		EndDebugLabel,
+	};
+
+	// A recorded command, the arguments are the ones of the CommandList method that recorded it
+	// in the same order, handles as their raw value. Float arguments are not recorded.
+	struct NullCommand
+	{
+		NullCommandType m_Type;
+		u64             m_Args[5]{};
+	};
+
+	// In-memory stream a null command list records into, it stays readable until
+	// the device reuses it for the same frame in flight
+	struct NullCommandStream
+	{
+		QueueType           m_Queue = QueueType::Graphics;
+		bool                m_IsSecondary = false;
+		bool                m_IsRecording = false;
+		Vector<NullCommand> m_Commands{};
+		Vector<String>      m_DebugLabels{}; // BeginDebugLabel records the index of its name here
+
+		// Returns the number of recorded commands of the given type
+		u64 Count(NullCommandType type) const;
+	};
+}
+
+namespace CKE {
+	class CommandList
+	{
+	public:
+		CommandList() = default;
+
+		CommandList(RenderDevice* pRenderDevice, NullCommandStream* pStream);
+
+		void Begin(); // Being the recording of the command list
+		void End();   // End the recording of the command list
+
+		// Begin the recording of a secondary command list that continues the
+		// dynamic rendering described by the rendering info
+		void BeginSecondary(RenderingInfo const& renderingInfo);
+
+		// Records the secondary command lists in order, must be inside a
+		// BeginRendering(...) with m_ContentsInSecondaryCmdLists.
+		// Their commands are copied after the ExecuteCommands one, so the stream reads
+		// in the order the commands would run
+		void ExecuteCommands(Vector<CommandList> const& secondaryCmdLists);
+
+		// Dynamic Rendering
+		void BeginRendering(RenderingInfo renderingInfo);
+		void EndRendering();
+
+		// Vertex & Index Buffers
+		void SetVertexBuffer(BufferHandle bufferHandle, u32 firstBinding, u32 bindingCount, u64 offset);
+		void SetVertexBuffer(BufferHandle bufferHandle);
+		void SetIndexBuffer(BufferHandle bufferHandle, u64 offset, IndicesFormat indicesFormat);
+		void SetIndexBuffer(BufferHandle bufferHandle, u64 offset);
+
+		// Draw
+		void Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance);
+		void DrawIndexed(u32 indexCount, u32 instanceCount, u32 firstIndex, i32 vertexOffset, u32 firstInstance);
+		void DrawIndexed(u64 indexCount, u64 firstInstance);
+
+		// Pipeline
+		void SetPipeline(PipelineHandle pipeline, PipelineBindPoint bindPoint);
+		void SetGraphicsPipeline(PipelineHandle pipeline);
+		void SetViewport(Vec2 offset, Vec2 size, Vec2 minMaxDepth);
+		void SetScissor(Int2 offset, UInt2 extent);
+		void SetDefaultViewportScissor(Vec2 size);
+
+		// Shader Bindings
+		void BindDescriptor(PipelineHandle pipeline, DescriptorSetHandle descriptorSet);
+		void PushConstant(PipelineHandle pipeline, u64 dataSize, void* data);
+
+		// Sync & Transitions
+		void Barrier(TextureBarrierDescription const* desc, u32 count);
+		void Barrier(TextureBarrierDescription desc);
+
+		// Copy
+		void CopyBuffer(BufferHandle src, BufferHandle dst, BufferCopyInfo copyInfo);
+		void CopyTexture(TextureCopyInfo srcInfo, TextureCopyInfo dstInfo, UInt3 size);
+		void CopyBufferToTexture(BufferHandle src, TextureHandle dst, BufferImageCopyInfo copyInfo);
+		void CopyTextureToBuffer(TextureHandle src, BufferHandle dst, BufferImageCopyInfo copyInfo);
+
+		// Compute
+		void BindComputeDescriptor(PipelineHandle pipeline, DescriptorSetHandle set);
+		void SetComputePipeline(PipelineHandle pipeline);
+		void Dispatch(u32 groupCountX, u32 groupCountY, u32 groupCountZ);
+
+		// Debugging
+		void BeginDebugLabel(const char* pName, Vec3 color);
+		void EndDebugLabel();
+
+		// Returns the commands recorded by this list
+		inline NullCommandStream const& GetStream() const { return *m_pStream; }
+
+	private:
+		void Record(NullCommandType type, u64 arg0 = 0, u64 arg1 = 0, u64 arg2 = 0, u64 arg3 = 0, u64 arg4 = 0);
+
+	private:
+		friend class RenderDevice;
+
+		RenderDevice*      m_pDevice = nullptr;
+		NullCommandStream* m_pStream = nullptr;
+	};
+
+	// Transfer and compute lists record like the graphics ones, the device
+	// keeps their streams apart to tell the queues they were submitted to
+	class TransferCommandList : public CommandList
+	{
+	public:
+		using CommandList::CommandList;
+	};
+
+	class ComputeCommandList : public CommandList
+	{
+	public:
+		using CommandList::CommandList;
+	};
+}
@@ -0,0 +1,391 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Platform/PrimitiveTypes.h"
+
+#include "CookieKat/Systems/RenderAPI/DescriptorSetBuilder.h"
+#include "CookieKat/Systems/RenderAPI/DescriptorSetCache.h"
+#include "CookieKat/Systems/RenderAPI/Buffer.h"
+#include "CookieKat/Systems/RenderAPI/CommandList.h"
+#include "CookieKat/Systems/RenderAPI/MemoryHeap.h"
+#include "CookieKat/Systems/RenderAPI/Pipeline.h"
+#include "CookieKat/Systems/RenderAPI/Texture.h"
+
+#include "CookieKat/Systems/RenderAPI/Null/RenderResources_Null.h"
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+
+//-----------------------------------------------------------------------------
+
+namespace CKE {
+	// A command list submitted to the null device
+	struct NullSubmission
+	{
+		QueueType                m_Queue;
+		NullCommandStream const* m_pStream;
+		CmdListSubmitInfo        m_SubmitInfo;
+	};
+
+	// Headless device without a GPU or a window, selected building with CKE_GRAPHICS_BACKEND=Null.
+	// Handles are allocated as in a real device, buffers are CPU memory and command lists record
+	// into in-memory streams that can be inspected after they are submitted.
+	// Submitting runs the buffer copies and signals the fence, anything else is only recorded.
+	// The fences can be held back to stand in for a GPU that takes frames to finish the work.
+	class RenderDevice
+	{
+	public:
+		// Lifetime
+		//-----------------------------------------------------------------------------
+
+		// Unused, the null device doesn't present to a window
+		void SetRenderTargetData(void* pData);
+
+		// A RenderDevice must be initialized using RenderDevice::Initialize(...)
+		// and must be destroyed calling RenderDevice::Shutdown()
+		void Initialize(Int2 backBufferSize);
+		void Shutdown();
+
+		// Frame Sync
+		//-----------------------------------------------------------------------------
+
+		// Starts a new frame reusing the command lists and descriptor sets of the frame in flight
+		void AcquireNextBackBuffer();
+
+		// Ends the frame, recreating the BackBuffers if a resize was recorded
+		void Present();
+
+		// Returns the semaphore that is signaled when an image is available to render
+		SemaphoreHandle GetImageAvailableSemaphore();
+
+		// Returns the semaphore that should be signaled when a
+		// render has finished writing to the backbuffer
+		SemaphoreHandle GetRenderFinishedSemaphore();
+		FenceHandle     GetInFlightFence();
+
+		// Submitted work finishes when it is submitted, there is nothing to wait for
+		void WaitForDevice();
+		void WaitGraphicsQueueIdle();
+		void WaitTransferQueueIdle();
+
+		// Buffers
+		//-----------------------------------------------------------------------------
+
+		// Creates a buffer using the given description and returns its handle
+		BufferHandle CreateBuffer(BufferDesc bufferDesc);
+
+		// Destroys a buffer associated with the given handle
+		void DestroyBuffer(BufferHandle bufferHandle);
+
+		// Returns the memory of the buffer, CPU_GPU_Coherent buffers are mapped from their creation
+		void* MapBuffer(BufferHandle bufferHandle);
+
+		// CPU_GPU_Coherent buffers stay mapped until they are destroyed
+		void UnMapBuffer(BufferHandle bufferHandle);
+
+		// Returns a pointer to the mapped memory space of the given buffer
+		//
+		// Pre-Requisites:
+		//   The buffer must be mapped
+		void* GetBufferMappedPtr(BufferHandle bufferHandle);
+
+		// Copies the data to the buffer, to the copy of the current frame if it is per-frame
+		void UploadBufferData_DEPR(BufferHandle bufferHandle, void const* pData, u64 sizeInBytes, u64 offsetInBytes);
+
+		// Textures and Samplers
+		//-----------------------------------------------------------------------------
+
+		// Create a texture with the given description
+		TextureHandle CreateTexture(TextureDesc desc);
+
+		// Create a texture view with the given description
+		TextureViewHandle CreateTextureView(TextureViewDesc desc);
+
+		// Create a sampler with the given description
+		SamplerHandle CreateSampler(SamplerDesc desc);
+
+		// Destroys the texture and all of views
+		void DestroyTexture(TextureHandle textureHandle);
+
+		// Destroys the given texture view.
+		void DestroyTextureView(TextureViewHandle handle);
+
+		// Destroys the given sampler.
+		void DestroySampler(SamplerHandle samplerHandle);
+
+		// Memory Heaps
+		//-----------------------------------------------------------------------------
+
+		// Returns the texel memory of the texture and all of its mips, aligned as render targets are in most GPUs
+		MemoryRequirements GetTextureMemoryRequirements(TextureDesc const& desc);
+
+		// Creates a heap of the given size that textures can be placed in
+		MemoryHeapHandle CreateMemoryHeap(MemoryRequirements const& requirements);
+
+		// Destroys the heap, asserts that no texture is placed in it
+		void DestroyMemoryHeap(MemoryHeapHandle heapHandle);
+
+		// Creates a texture placed at the given offset of the heap, asserts that it is aligned and fits
+		TextureHandle CreatePlacedTexture(TextureDesc desc, MemoryHeapHandle heapHandle, u64 offsetInBytes);
+
+		// Pipelines
+		//-----------------------------------------------------------------------------
+
+		// Creates a pipeline layout using the given description
+		PipelineLayoutHandle CreatePipelineLayout(PipelineLayoutDesc const& layoutDesc);
+
+		// Destroys the given pipeline layout
+		void DestroyPipelineLayout(PipelineLayoutHandle handle);
+
+		// Create a graphics pipeline using the given description, the shaders are not compiled
+		PipelineHandle CreateGraphicsPipeline(GraphicsPipelineDesc const& desc);
+
+		// Create a compute pipeline using the given description, the shader is not compiled
+		PipelineHandle CreateComputePipeline(ComputePipelineDesc const& desc);
+
+		// Destroy the given pipeline.
+		void DestroyPipeline(PipelineHandle pipelineHandle);
+
+		// Semaphores and Fences
+		//-----------------------------------------------------------------------------
+
+		// Create a semaphore for GPU-GPU Synchronization
+		SemaphoreHandle CreateSemaphoreGPU();
+
+		// Destroy the given semaphore
+		void DestroySemaphore(SemaphoreHandle handle);
+
+		// Create a fence used for GPU-CPU synchronization
+		FenceHandle CreateFence(bool createSignaled);
+
+		// Destroy the given fence.
+		void DestroyFence(FenceHandle fence);
+
+		// Returns immediately, asserts that the fence was signaled by a submission
+		// since waiting for it on a GPU would never return. Held submissions complete up to the fence.
+		void WaitForFence(FenceHandle fence);
+
+		// Returns whether the fence is signaled without blocking
+		bool IsFenceSignaled(FenceHandle fence);
+
+		// Reset the given fence so it can be signaled again
+		void ResetFence(FenceHandle fence);
+
+		// Queues
+		//-----------------------------------------------------------------------------
+
+		CommandQueueHandle CreateCommandQueue(CommandQueueDesc desc);
+
+		// Command Lists
+		//-----------------------------------------------------------------------------
+
+		// Returns an available command list of the queue for this frame
+		//
+		// Asserts:
+		//   Requested cmdList count is lower than the max amount
+		CommandList         GetGraphicsCmdList();
+		TransferCommandList GetTransferCmdList();
+		ComputeCommandList  GetComputeCmdList();
+
+		// Returns an available secondary graphics command list for this frame that
+		// can be recorded from the thread with the given index while other threads record theirs.
+		// It must be executed from a primary command list with CommandList::ExecuteCommands(...)
+		//
+		// Asserts:
+		//   Thread index is lower than RenderSettings::MAX_RECORDING_THREADS
+		//   Requested cmdList count for the thread is lower than the max amount
+		CommandList GetSecondaryGraphicsCmdList(u32 threadIdx);
+
+		// Submit command lists to their queue
+		void SubmitGraphicsCommandList(CommandList& cmdList, CmdListSubmitInfo submitInfo);
+		void SubmitGraphicsCommandLists(Vector<CommandList>& cmdList, CmdListSubmitInfo submitInfo);
+		void SubmitTransferCommandList(TransferCommandList& cmdList, CmdListSubmitInfo submitInfo);
+		void SubmitComputeCommandList(ComputeCommandList& cmdList, CmdListSubmitInfo submitInfo);
+
+		// Descriptor Sets
+		//-----------------------------------------------------------------------------
+
+		// Returns an interface object used to define a descriptor set that can be bound
+		// to a pipeline to access data from shaders.
+		// NOTE: Don't create a descriptor set builder directly, use this method instead.
+		//
+		// Descriptor sets can be built from multiple threads at once if each of them
+		// uses a different thread index, each thread index caches the sets it builds.
+		DescriptorSetBuilder CreateDescriptorSetBuilder(PipelineHandle p, u64 setIndex, u32 threadIdx = 0);
+
+		// Hits, misses and evictions of the descriptor set caches of all the frames in flight
+		DescriptorSetCacheStats GetDescriptorSetCacheStats();
+
+		// Utils
+		//-----------------------------------------------------------------------------
+
+		// The frame Idx is a incrementing and repeating number that goes
+		// from 0 to MAX_FRAMES_IN_FLIGHT.
+		u32 GetFrameIdx();
+
+		// Returns the BackBuffer texture of the current frame
+		TextureHandle GetBackBuffer();
+
+		// Returns the BackBuffer view of the current frame
+		TextureViewHandle GetBackBufferView();
+
+		// Returns a description of the BackBuffer texture
+		TextureDesc GetBackBufferDesc();
+
+		// Returns the BackBuffer size as a UInt2
+		UInt2 GetBackBufferSize() const;
+
+		// Returns the BackBuffer size as a UInt3
+		UInt3 GetBackBufferSize3() const;
+
+		// Records a deferred backbuffer resize event, it will be handled
+		// after the current frame is presented
+		void RecordBackBufferResized(Int2 newSize);
+
+		// Inspection
+		//-----------------------------------------------------------------------------
+
+		// Command lists submitted since the current frame was acquired, in submission order
+		inline Vector<NullSubmission> const& GetSubmissions() const { return m_Submissions; }
+
+		// Descriptor set cached by the current frame, its bindings are the ones of the builder.
+		// Sets built with dynamic bindings also have the offsets that they are bound with.
+		DescriptorSet const* GetDescriptorSet(DescriptorSetHandle handle);
+
+		// Descriptor sets of all the frames in flight, the ones waiting to be freed included
+		u64 GetNumDescriptorSets();
+
+		// Descriptor pools of all the recording threads and frames in flight
+		u64 GetNumDescriptorPools();
+
+		// Number of live resources, to check that systems release what they create
+		u64 GetNumBuffers() const { return m_Buffers.size(); }
+		u64 GetNumTextures() const { return m_Textures.size(); }
+		u64 GetNumPipelines() const { return m_Pipelines.size(); }
+		u64 GetNumMemoryHeaps() const { return m_MemoryHeaps.size(); }
+
+		// Heap and offset of a placed texture, the heap is invalid if the texture has its own memory
+		MemoryHeapHandle GetTextureHeap(TextureHandle handle, u64& offsetInBytes) const;
+
+		// While held, the fences of the submissions stay unsignaled as if the GPU was still running them,
+		// to test systems that poll their work. They are signaled in submission order when completed.
+		void SetHoldSubmissions(bool hold) { m_HoldSubmissions = hold; }
+		void CompleteHeldSubmissions(u64 count = std::numeric_limits<u64>::max());
+		u64  GetNumHeldSubmissions() const { return m_HeldFences.size(); }
+
+	private:
+		// Command streams of a frame in flight, reserved on initialization and reused every
+		// time the frame is acquired so their pointers stay valid for the command lists
+		struct FrameCommandStreams
+		{
+			Vector<NullCommandStream> m_Graphics;
+			Vector<NullCommandStream> m_Transfer;
+			Vector<NullCommandStream> m_Compute;
+			u32                       m_NextGraphics = 0;
+			u32                       m_NextTransfer = 0;
+			u32                       m_NextCompute = 0;
+
+			Array<Vector<NullCommandStream>, RenderSettings::MAX_RECORDING_THREADS> m_Secondary;
+			Array<u32, RenderSettings::MAX_RECORDING_THREADS>                       m_NextSecondary{};
+		};
+
+		// Sets cached by a recording thread in a frame in flight. Only that thread builds them, the lock
+		// is contended only when a resource invalidates them or the stats are read.
+		struct ThreadDescriptorSets
+		{
+			std::mutex                  m_Mutex;
+			DescriptorSetCache          m_Cache;
+			Vector<u32>                 m_PoolNumSets; // Sets allocated from each pool, added when all are full
+			Vector<DescriptorSetHandle> m_SetsToFree;  // Dropped by the cache, freed after the frame's fence wait
+		};
+
+		struct FrameSync
+		{
+			SemaphoreHandle m_ImageAvailable;
+			SemaphoreHandle m_RenderFinished;
+			FenceHandle     m_InFlight;
+		};
+
+		// Commands
+		//-----------------------------------------------------------------------------
+
+		NullCommandStream* GetNextStream(Vector<NullCommandStream>& streams, u32& nextIdx);
+
+		// Runs the buffer copies of the stream and logs the submission
+		void SubmitStream(NullCommandStream* pStream, CmdListSubmitInfo const& submitInfo);
+		void SignalSubmission(CmdListSubmitInfo const& submitInfo);
+
+		// Auxiliary
+		//-----------------------------------------------------------------------------
+
+		template <typename T>
+		TRenderHandle<T> AllocateHandle() { return TRenderHandle<T>{RenderHandle{m_NextHandle.fetch_add(1)}}; }
+
+		// Returns the memory of the buffer, the copy of the current frame if it is per-frame
+		Vector<u8>& GetBufferData(BufferHandle bufferHandle);
+
+		void CreateBackBuffers(Int2 size);
+		void DestroyBackBuffers();
+
+		void ResetAllPerFrameData();
+
+		// Descriptors
+		//-----------------------------------------------------------------------------
+
+		// Returns the set cached by the current frame for the bindings, creating it on a miss
+		DescriptorSetHandle CreateDescriptorSetForFrame(PipelineHandle pipelineHandle, u32 layoutSlot, u32 threadIdx,
+		                                                Vector<DescriptorSetBuilder::Bindings>& shaderBindings,
+		                                                bool isPersistent);
+
+		// Returns a copy of the cached set with the offsets of the dynamic bindings, valid for the current frame.
+		// Sets without dynamic bindings are bound as they are cached.
+		DescriptorSetHandle CreateDynamicDescriptorSet(DescriptorSetHandle                           cachedSet,
+		                                               Vector<DescriptorSetBuilder::Bindings> const& shaderBindings);
+
+		// Drops the cached sets that bind the resource, called when it is destroyed
+		void InvalidateDescriptorSets(u64 resourceID);
+
+		// Frees the sets that the caches of the frame dropped, its GPU work must be done
+		void FreeDroppedDescriptorSets(u32 frameIdx);
+
+	private:
+		friend CommandList;
+		friend DescriptorSetBuilder;
+
+	private:
+		std::atomic<u64> m_NextHandle{1};
+
+		Map<BufferHandle, Buffer>                 m_Buffers;
+		Map<TextureHandle, Texture>               m_Textures;
+		Map<MemoryHeapHandle, MemoryHeap>         m_MemoryHeaps;
+		Map<TextureViewHandle, TextureView>       m_TextureViews;
+		Map<SamplerHandle, TextureSampler>        m_Samplers;
+		Map<PipelineLayoutHandle, PipelineLayout> m_PipelineLayouts;
+		Map<PipelineHandle, Pipeline>             m_Pipelines;
+		Map<SemaphoreHandle, Semaphore>           m_Semaphores;
+		Map<FenceHandle, Fence>                   m_Fences;
+		Map<CommandQueueHandle, CommandQueue>     m_Queues;
+
+		FrameArray<Map<DescriptorSetHandle, DescriptorSet>> m_DescriptorSets;
+		FrameArray<Map<DescriptorSetHandle, DescriptorSet>> m_DynamicDescriptorSets; // Dropped when their frame comes back
+		std::mutex                                          m_DescriptorSetMutex; // Sets are built while recording in parallel
+
+		FrameArray<Array<ThreadDescriptorSets, RenderSettings::MAX_RECORDING_THREADS>> m_ThreadDescriptorSets;
+
+		FrameArray<FrameCommandStreams> m_CommandStreams;
+		FrameArray<FrameSync>           m_FrameSync;
+		Vector<NullSubmission>          m_Submissions;
+		u32                             m_CurrFrameInFlightIdx = 0;
+		bool                            m_HoldSubmissions = false;
+		Vector<FenceHandle>             m_HeldFences; // Oldest first
+
+		// BackBuffers
+		Vector<TextureHandle>     m_BackBuffers;
+		Vector<TextureViewHandle> m_BackBufferViews;
+		TextureDesc               m_BackBufferDesc{};
+		u32                       m_CurrBackBufferIdx = 0;
+		bool                      m_BackBufferResized = false;
+		Int2                      m_NewBackBufferSize{};
+	};
+}
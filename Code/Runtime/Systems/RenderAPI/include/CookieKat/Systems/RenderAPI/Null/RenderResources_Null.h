@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CookieKat/Systems/RenderAPI/Internal/RenderResource.h"
+#include "CookieKat/Systems/RenderAPI/RenderSettings.h"
+#include "CookieKat/Systems/RenderAPI/DescriptorSetBuilder.h"
+#include "CookieKat/Systems/RenderAPI/CommandQueue.h"
+#include "CookieKat/Systems/RenderAPI/Buffer.h"
+#include "CookieKat/Systems/RenderAPI/MemoryHeap.h"
+#include "CookieKat/Systems/RenderAPI/Pipeline.h"
+#include "CookieKat/Systems/RenderAPI/Texture.h"
+
+namespace CKE {
+	// Shorthand for an array that contains data that has a per-frame copy
+	template <typename T>
+	using FrameArray = Array<T, RenderSettings::MAX_FRAMES_IN_FLIGHT>;
+
+	class PipelineLayout : public RenderResource<PipelineLayout>
+	{
+	public:
+		PipelineLayoutDesc m_Desc;
+	};
+
+	class Pipeline : public RenderResource<Pipeline>
+	{
+	public:
+		PipelineLayoutHandle m_PipelineLayout;
+		bool                 m_IsCompute = false;
+	};
+
+	class Semaphore : public RenderResource<Semaphore> { };
+
+	class Fence : public RenderResource<Fence>
+	{
+	public:
+		bool m_IsSignaled = false;
+	};
+
+	// Buffers are CPU memory, per-frame buffers have a copy for each frame in flight
+	class Buffer : public RenderResource<Buffer>
+	{
+	public:
+		BufferDesc             m_Desc{};
+		FrameArray<Vector<u8>> m_Data{};
+		bool                   m_IsPerFrame = false;
+		bool                   m_IsMapped = false;
+	};
+
+	class Texture : public RenderResource<Texture>
+	{
+	public:
+		TextureDesc               m_Desc{};
+		Vector<TextureViewHandle> m_ExistingViews{};
+		MemoryHeapHandle          m_Heap{}; // Heap the texture is placed in, if any
+		u64                       m_HeapOffset = 0;
+	};
+
+	class MemoryHeap : public RenderResource<MemoryHeap>
+	{
+	public:
+		u64 m_SizeInBytes = 0;
+		u32 m_NumPlacedTextures = 0;
+	};
+
+	class TextureView : public RenderResource<TextureView>
+	{
+	public:
+		TextureViewDesc m_Desc{};
+	};
+
+	class TextureSampler : public RenderResource<TextureSampler>
+	{
+	public:
+		SamplerDesc m_Desc{};
+	};
+
+	class DescriptorSet : public RenderResource<DescriptorSet>
+	{
+	public:
+		PipelineHandle                         m_Pipeline;
+		u32                                    m_LayoutIndex = 0;
+		Vector<DescriptorSetBuilder::Bindings> m_Bindings{};
+		u32                                    m_PoolIdx = 0; // Pool of the thread that built it
+		Vector<u32>                            m_DynamicOffsets{}; // Of the dynamic bindings by slot, passed when it's bound
+	};
+
+	class CommandQueue : public RenderResource<CommandQueue>
+	{
+	public:
+		QueueType m_Type = QueueType::Graphics;
+	};
+}
@@ -2,5 +2,7 @@
 
 #ifdef CKE_GRAPHICS_VULKAN_BACKEND
 #include "CookieKat/Systems/RenderAPI/Vulkan/RenderDevice_Vk.h"
+#elif defined(CKE_GRAPHICS_NULL_BACKEND)
+#include "CookieKat/Systems/RenderAPI/Null/RenderDevice_Null.h"
 #else
 #endif
@@ -64,6 +64,7 @@ namespace CKE {
 	class Semaphore;
 	class Fence;
 	class CommandQueue;
+	class MemoryHeap;
 
 	using BufferHandle = TRenderHandle<Buffer>;
 
@@ -80,6 +81,8 @@ namespace CKE {
 
 	using CommandQueueHandle = TRenderHandle<CommandQueue>;
 
+	using MemoryHeapHandle = TRenderHandle<MemoryHeap>;
+
 	template class TRenderHandle<Buffer>;
 
 	template class TRenderHandle<Texture>;
@@ -94,6 +97,8 @@ namespace CKE {
 	template class TRenderHandle<PipelineLayout>;
 
 	template class TRenderHandle<CommandQueue>;
+
+	template class TRenderHandle<MemoryHeap>;
 }
 
 //-----------------------------------------------------------------------------
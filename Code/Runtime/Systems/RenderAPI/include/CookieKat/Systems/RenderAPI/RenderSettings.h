@@ -9,6 +9,11 @@ namespace CKE {
 		static constexpr i32  GRAPHICS_CMDLIST_COUNT_PERFRAME = 100;
 		static constexpr i32  TRANSFER_CMDLIST_COUNT_PERFRAME = 100;
 		static constexpr i32  COMPUTE_CMDLIST_COUNT_PERFRAME = 50;
+		static constexpr u32  MAX_RECORDING_THREADS = 8; // Threads that can record secondary cmd lists at once
+		static constexpr i32  SECONDARY_CMDLIST_COUNT_PERTHREAD = 32;
+		static constexpr u32  DESCRIPTOR_SET_CACHE_CAPACITY = 4096; // Sets reused by each recording thread and frame, persistent aside
+		static constexpr u32  DESCRIPTOR_SETS_PER_POOL = 256; // Cached sets of each descriptor pool, pools are added as needed
+		static constexpr u32  MAX_BUFFERS_PER_SET = 12; // Buffer bindings of a descriptor set, each one is bound with an offset
 		static constexpr bool ENABLE_DEBUG = true;
 	};
 }
\ No newline at end of file
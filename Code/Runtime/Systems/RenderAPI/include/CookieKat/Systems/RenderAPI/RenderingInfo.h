@@ -39,5 +39,6 @@ namespace CKE {
 		RenderingAttachment         m_DepthAttachment{};
 		bool                        m_UseStencilAttachment = false;
 		RenderingAttachment         m_StencilAttachment{};
+		bool                        m_ContentsInSecondaryCmdLists = false; // Commands are only ExecuteCommands(...) of secondary lists
 	};
 }
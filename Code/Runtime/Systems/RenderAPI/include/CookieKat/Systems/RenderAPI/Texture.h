@@ -106,8 +106,46 @@ namespace CKE {
 		R16G16B16A16_SFLOAT,
 		R32G32B32A32_SFLOAT,
 		R32_UINT,
+
+		// Block compressed, 4x4 texel blocks
+		BC1_RGBA_UNORM,
+		BC1_RGBA_SRGB,
+		BC3_UNORM,
+		BC3_SRGB,
+		BC5_UNORM,
+		BC7_UNORM,
+		BC7_SRGB,
 	};
 
+	inline bool IsBlockCompressedFormat(TextureFormat format) {
+		return format >= TextureFormat::BC1_RGBA_UNORM && format <= TextureFormat::BC7_SRGB;
+	}
+
+	// Bytes per texel for uncompressed formats, bytes per 4x4 block for compressed ones
+	inline u32 GetTextureFormatByteSize(TextureFormat format) {
+		switch (format) {
+		case TextureFormat::R16G16B16A16_SFLOAT: return 8;
+		case TextureFormat::D32_SFLOAT_S8_UINT: return 8;
+		case TextureFormat::R32G32B32A32_SFLOAT: return 16;
+		case TextureFormat::BC1_RGBA_UNORM:
+		case TextureFormat::BC1_RGBA_SRGB: return 8;
+		case TextureFormat::BC3_UNORM:
+		case TextureFormat::BC3_SRGB:
+		case TextureFormat::BC5_UNORM:
+		case TextureFormat::BC7_UNORM:
+		case TextureFormat::BC7_SRGB: return 16;
+		default: return 4;
+		}
+	}
+
+	// Size in bytes of one mip level of a 2D texture
+	inline u64 GetTextureMipByteSize(TextureFormat format, u32 width, u32 height) {
+		if (IsBlockCompressedFormat(format)) {
+			return static_cast<u64>((width + 3) / 4) * ((height + 3) / 4) * GetTextureFormatByteSize(format);
+		}
+		return static_cast<u64>(width) * height * GetTextureFormatByteSize(format);
+	}
+
 	enum class TextureMiscFlags
 	{
 		None = 0,
@@ -148,7 +186,10 @@ namespace CKE {
 					m_MinFilter == other.m_MinFilter &&
 					m_MipmapMode == other.m_MipmapMode &&
 					m_AnisotropyEnable == other.m_AnisotropyEnable &&
-					std::abs(m_MaxAnisotropy - other.m_MaxAnisotropy) < 0.00001f;
+					std::abs(m_MaxAnisotropy - other.m_MaxAnisotropy) < 0.00001f &&
+					std::abs(m_LodBias - other.m_LodBias) < 0.00001f &&
+					std::abs(m_MinLod - other.m_MinLod) < 0.00001f &&
+					std::abs(m_MaxLod - other.m_MaxLod) < 0.00001f;
 		}
 	};
 
@@ -178,7 +219,7 @@ namespace CKE {
 		template <typename Serializer>
 			requires IsSerializer<Serializer>
 		void Serialize(CKE::Archive<Serializer>& archive) {
-			archive.Serialize(m_Size.x, m_Size.y, m_Size.z, m_Format);
+			archive.Serialize(m_Size.x, m_Size.y, m_Size.z, m_Format, m_MipLevels);
 		}
 	};
 
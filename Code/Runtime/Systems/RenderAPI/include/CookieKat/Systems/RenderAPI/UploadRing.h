@@ -0,0 +1,112 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Systems/RenderAPI/RenderHandle.h"
+#include "CookieKat/Systems/RenderAPI/Buffer.h"
+
+namespace CKE {
+	class RenderDevice;
+}
+
+namespace CKE {
+	// Sub-allocates the memory of a ring for the frames in flight, it only deals with offsets.
+	//
+	// Each allocation goes after the previous one and wraps to the start when it doesn't fit before
+	// the end of the ring. A frame's allocations are freed together when its fence value is retired,
+	// frames must be retired in the order they ended.
+	class UploadRingAllocator
+	{
+	public:
+		void Initialize(u64 capacityInBytes);
+
+		// Returns false when the frames in flight don't leave room for the size, retiring them frees it
+		bool TryAllocate(u64 sizeInBytes, u64 alignment, u64& offsetInBytes);
+
+		// Closes the allocations of the current frame, they are freed when the fence value is retired
+		void EndFrame(u64 fenceValue);
+
+		// Frees the frames that ended with a fence value up to the completed one
+		void Retire(u64 completedFenceValue);
+
+		inline u64 GetCapacity() const { return m_Capacity; }
+		inline u64 GetUsedBytes() const { return m_UsedBytes; }   // Frames in flight and current frame, with padding
+		inline u64 GetFrameBytes() const { return m_FrameBytes; } // Current frame, with padding
+		inline u64 GetNumFramesInFlight() const { return m_FramesInFlight.size(); }
+
+	private:
+		struct FrameInFlight
+		{
+			u64 m_FenceValue;
+			u64 m_EndOffset;   // Head of the ring when the frame ended
+			u64 m_SizeInBytes; // Includes the alignment padding and the bytes skipped to wrap around
+		};
+
+		u64                  m_Capacity = 0;
+		u64                  m_Head = 0; // Where the next allocation starts looking
+		u64                  m_Tail = 0; // Start of the oldest frame in flight
+		u64                  m_UsedBytes = 0;
+		u64                  m_FrameBytes = 0;
+		Queue<FrameInFlight> m_FramesInFlight{};
+	};
+
+	// Ring memory that a frame writes the data the GPU reads from
+	struct UploadAllocation
+	{
+		BufferHandle m_Buffer{};
+		u64          m_OffsetInBytes = 0;
+		u64          m_SizeInBytes = 0;
+		void*        m_pData = nullptr; // Mapped memory at the offset
+
+		inline bool        IsValid() const { return m_pData != nullptr; }
+		inline BufferRange GetRange() const { return BufferRange{m_Buffer, m_OffsetInBytes, m_SizeInBytes}; }
+	};
+
+	// Persistently mapped buffer that per-frame data is written straight into, with no staging copies.
+	// The frames sub-allocate it in order and their memory is reused once the fence their work signals
+	// is done, when the ring is full the allocation waits for the oldest frame in flight.
+	class UploadRing
+	{
+	public:
+		// Offsets every device can bind uniform and storage buffers at, the largest minimum Vulkan allows
+		static constexpr u64 DEFAULT_ALIGNMENT = 256;
+
+		void Initialize(RenderDevice* pDevice, u64 sizeInBytes, BufferUsageFlags usage, DebugString debugName);
+		void Shutdown();
+
+		// Starts the allocations of a frame whose work will signal the fence. As the fence can't be pending,
+		// the frames that signaled it before, and the ones older than them, are done and their memory is reused.
+		void BeginFrame(FenceHandle frameFence);
+
+		// Closes the allocations of the frame, called after its work is submitted
+		void EndFrame();
+
+		// Memory for the current frame, not valid if the size doesn't fit in the ring
+		UploadAllocation Allocate(u64 sizeInBytes, u64 alignment = DEFAULT_ALIGNMENT);
+
+		// Allocates the memory and copies the data to it
+		UploadAllocation Upload(void const* pData, u64 sizeInBytes, u64 alignment = DEFAULT_ALIGNMENT);
+
+		inline BufferHandle               GetBuffer() const { return m_Buffer; }
+		inline UploadRingAllocator const& GetAllocator() const { return m_Allocator; }
+		inline u64                        GetFrameUploadBytes() const { return m_FrameUploadBytes; }
+
+	private:
+		void RetireFrames(u64 completedFenceValue);
+
+	private:
+		struct PendingFrame
+		{
+			u64         m_FenceValue;
+			FenceHandle m_Fence;
+		};
+
+		RenderDevice*        m_pDevice = nullptr;
+		BufferHandle         m_Buffer{};
+		u8*                  m_pMappedData = nullptr;
+		UploadRingAllocator  m_Allocator{};
+		Vector<PendingFrame> m_PendingFrames{}; // Oldest first
+		FenceHandle          m_FrameFence{};
+		u64                  m_FrameNumber = 0;      // Fence value of the current frame
+		u64                  m_FrameUploadBytes = 0; // Requested by the current frame, without padding
+	};
+}
@@ -22,6 +22,14 @@ namespace CKE {
 		void Begin(); // Being the recording of the command list
 		void End();   // End the recording of the command list
 
+		// Begin the recording of a secondary command list that continues the
+		// dynamic rendering described by the rendering info
+		void BeginSecondary(RenderingInfo const& renderingInfo);
+
+		// Records the secondary command lists in order, must be inside a
+		// BeginRendering(...) with m_ContentsInSecondaryCmdLists
+		void ExecuteCommands(Vector<CommandList> const& secondaryCmdLists);
+
 		// Dynamic Rendering
 		void BeginRendering(RenderingInfo renderingInfo);
 		void EndRendering();
@@ -53,8 +53,9 @@ namespace CKE {
 
 		static VkDescriptorType GetVkDescriptorType(ShaderBindingType type) {
 			switch (type) {
-			case ShaderBindingType::UniformBuffer: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			case ShaderBindingType::StorageBuffer: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			// Buffers are always dynamic, the ones that aren't bound as dynamic are bound at an offset of 0
+			case ShaderBindingType::UniformBuffer: return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+			case ShaderBindingType::StorageBuffer: return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
 			case ShaderBindingType::ImageViewSampler: return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
 			default: CKE_UNREACHABLE_CODE();
 			}
@@ -198,6 +199,14 @@ namespace CKE {
 			case TextureFormat::R32_UINT: return VK_FORMAT_R32_UINT;
 
 			case TextureFormat::B8G8R8A8_SRGB: return VK_FORMAT_B8G8R8A8_SRGB;
+
+			case TextureFormat::BC1_RGBA_UNORM: return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+			case TextureFormat::BC1_RGBA_SRGB: return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+			case TextureFormat::BC3_UNORM: return VK_FORMAT_BC3_UNORM_BLOCK;
+			case TextureFormat::BC3_SRGB: return VK_FORMAT_BC3_SRGB_BLOCK;
+			case TextureFormat::BC5_UNORM: return VK_FORMAT_BC5_UNORM_BLOCK;
+			case TextureFormat::BC7_UNORM: return VK_FORMAT_BC7_UNORM_BLOCK;
+			case TextureFormat::BC7_SRGB: return VK_FORMAT_BC7_SRGB_BLOCK;
 			default: CKE_UNREACHABLE_CODE();
 			}
 			return (VkFormat)0;
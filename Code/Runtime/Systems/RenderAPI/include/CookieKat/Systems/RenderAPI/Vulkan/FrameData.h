@@ -26,6 +26,7 @@ namespace CKE {
 	public:
 		Map<BufferHandle, Buffer>               m_Buffers{};
 		Map<DescriptorSetHandle, DescriptorSet> m_DescriptorSets{};
+		Map<DescriptorSetHandle, DescriptorSet> m_CachedDescriptorSets{}; // Outlive the frame, freed when evicted
 		Map<PipelineHandle, PipelineFrameData>  m_PipelineFrameData{};
 	};
 
@@ -37,7 +38,23 @@ namespace CKE {
 		VkCommandBuffer GetNextTransfer();
 		VkCommandBuffer GetNextCompute();
 
+		// Only the thread with the given index can record to the returned cmd buffer
+		VkCommandBuffer GetNextSecondaryGraphics(u32 threadIdx);
+
+		// Makes every cmd buffer available again, called when the frame starts
+		void ResetForNewFrame();
+
 	private:
+		friend class RenderDevice;
+
+		// Command pool and secondary cmd buffers of a recording thread
+		struct ThreadCommandBuffers
+		{
+			u64                     m_LastSecondaryCmdIdxGraphics = 0;
+			Vector<VkCommandBuffer> m_SecondaryGraphicsCommandBuffer{};
+			VkCommandPool           m_GraphicsCommandPool{};
+		};
+
 		u64                     m_LastCmdIdxGraphics = 0;
 		u64                     m_LastCmdIdxTransfer = 0;
 		u64                     m_LastCmdIdxCompute = 0;
@@ -48,6 +65,8 @@ namespace CKE {
 		VkCommandPool m_GraphicsCommandPool{};
 		VkCommandPool m_TransferCommandPool{};
 		VkCommandPool m_ComputeCommandPool{};
+
+		Array<ThreadCommandBuffers, RenderSettings::MAX_RECORDING_THREADS> m_ThreadCommandBuffers{};
 	};
 
 	class FrameSyncObjects
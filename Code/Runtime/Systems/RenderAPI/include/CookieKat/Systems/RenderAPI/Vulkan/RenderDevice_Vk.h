@@ -5,8 +5,10 @@
 #include "CookieKat/Core/Logging/LoggingSystem.h"
 
 #include "CookieKat/Systems/RenderAPI/DescriptorSetBuilder.h"
+#include "CookieKat/Systems/RenderAPI/DescriptorSetCache.h"
 #include "CookieKat/Systems/RenderAPI/Buffer.h"
 #include "CookieKat/Systems/RenderAPI/CommandList.h"
+#include "CookieKat/Systems/RenderAPI/MemoryHeap.h"
 #include "CookieKat/Systems/RenderAPI/Pipeline.h"
 #include "CookieKat/Systems/RenderAPI/Texture.h"
 
@@ -16,6 +18,7 @@
 #include "CookieKat/Systems/RenderAPI/Vulkan/FrameData.h"
 
 #include <vulkan/vulkan_core.h>
+#include <mutex>
 
 #include "vk_mem_alloc.h"
 
@@ -26,7 +29,7 @@
 static void CheckCallVk(VkResult result, char const* filePath, CKE::i32 fileLine) {
 	using namespace CKE;
 	if (result != VK_SUCCESS) {
-		g_LoggingSystem.Log(LogLevel::Error, LogChannel::Rendering, "Error in vulkan function at path: {}, Line: {}", filePath, fileLine);
+		CKE_LOG(Error, Rendering, "Error in vulkan function at path: {}, Line: {}", filePath, fileLine);
 	}
 }
 
@@ -87,8 +90,11 @@ namespace CKE {
 		// Destroys a buffer associated with the given handle
 		void DestroyBuffer(BufferHandle bufferHandle);
 
+		// Returns the memory of a CPU_GPU_Coherent buffer, they are persistently mapped from their creation
+		// so the CPU writes are visible to the GPU without copies or flushes
 		void* MapBuffer(BufferHandle bufferHandle);
 
+		// CPU_GPU_Coherent buffers stay mapped until they are destroyed
 		void UnMapBuffer(BufferHandle bufferHandle);
 
 		// Returns a pointer to the mapped memory space of the given buffer
@@ -127,6 +133,30 @@ namespace CKE {
 		//	 Sampler should not be in use.
 		void DestroySampler(SamplerHandle samplerHandle);
 
+		// Memory Heaps
+		//-----------------------------------------------------------------------------
+
+		// Returns the memory a texture with the given description needs when placed in a heap
+		MemoryRequirements GetTextureMemoryRequirements(TextureDesc const& desc);
+
+		// Allocates GPU-only memory that textures can be placed in, the memory
+		// type is one of the allowed by the requirements
+		MemoryHeapHandle CreateMemoryHeap(MemoryRequirements const& requirements);
+
+		// Frees the heap memory
+		//
+		// Pre-Condition:
+		//	 The textures placed in the heap must be destroyed.
+		void DestroyMemoryHeap(MemoryHeapHandle heapHandle);
+
+		// Creates a texture placed at the given offset of the heap. Textures placed in overlapping
+		// ranges alias, only one of them can be in use at a time and its contents are undefined
+		// when it starts being used. It is destroyed with DestroyTexture(...), which doesn't free the heap memory.
+		//
+		// Pre-Condition:
+		//	 The offset is aligned and the range fits in the heap, see GetTextureMemoryRequirements(...).
+		TextureHandle CreatePlacedTexture(TextureDesc desc, MemoryHeapHandle heapHandle, u64 offsetInBytes);
+
 		// Pipelines
 		//-----------------------------------------------------------------------------
 
@@ -175,6 +205,9 @@ namespace CKE {
 		// Block the calling thread until the given fence is signaled
 		void WaitForFence(FenceHandle fence);
 
+		// Returns whether the fence is signaled without blocking
+		bool IsFenceSignaled(FenceHandle fence);
+
 		// Reset the given fence so it can be signaled again
 		void ResetFence(FenceHandle fence);
 
@@ -193,6 +226,15 @@ namespace CKE {
 		//   Requested cmdList count is lower than the max amount
 		CommandList GetGraphicsCmdList();
 
+		// Returns an available secondary graphics command list for this frame that
+		// can be recorded from the thread with the given index while other threads record theirs.
+		// It must be executed from a primary command list with CommandList::ExecuteCommands(...)
+		//
+		// Asserts:
+		//   Thread index is lower than RenderSettings::MAX_RECORDING_THREADS
+		//   Requested cmdList count for the thread is lower than the max amount
+		CommandList GetSecondaryGraphicsCmdList(u32 threadIdx);
+
 		// Submit a command list to the graphics queue
 		void SubmitGraphicsCommandList(CommandList& cmdList, CmdListSubmitInfo submitInfo);
 
@@ -208,7 +250,13 @@ namespace CKE {
 		// Returns an interface object used to define a descriptor set that can be bound
 		// to a pipeline to access data from shaders.
 		// NOTE: Don't create a descriptor set builder directly, use this method instead.
-		DescriptorSetBuilder CreateDescriptorSetBuilder(PipelineHandle p, u64 setIndex);
+		//
+		// Descriptor sets can be built from multiple threads at once if each of them
+		// uses a different thread index, each thread index caches the sets it builds.
+		DescriptorSetBuilder CreateDescriptorSetBuilder(PipelineHandle p, u64 setIndex, u32 threadIdx = 0);
+
+		// Hits, misses and evictions of the descriptor set caches of all the frames in flight
+		DescriptorSetCacheStats GetDescriptorSetCacheStats();
 
 		// Utils
 		//-----------------------------------------------------------------------------
@@ -276,6 +324,10 @@ namespace CKE {
 		// NOTE: See render settings for specific amounts
 		void CreateDefaultCommandLists();
 
+		// Create the command pools and secondary command lists of the recording threads
+		void CreateSecondaryCommandLists();
+		void DestroySecondaryCommandPools();
+
 		//Create an internal per-frame command list using the given description
 		void CreateCommandList(CommandListDesc desc);
 		void SetObjectDebugName(u64 objectHandle, VkObjectType objectType, const char* name);
@@ -300,6 +352,9 @@ namespace CKE {
 
 		void ConvertQueueFamilyFlagsToIndices(QueueFamilyFlags familyFlags, Array<u32, 3>& familyIndices, i32& familyIndicesCount);
 
+		// Fills the image info of a texture, the family indices must outlive it
+		void FillImageCreateInfo(TextureDesc const& desc, Array<u32, 3>& familyIndices, VkImageCreateInfo& imageInfo);
+
 		// Descriptors
 		//-----------------------------------------------------------------------------
 
@@ -308,22 +363,56 @@ namespace CKE {
 
 		// Allocate a descriptor set for the given pipeline using its descriptor pool
 		void AllocateDescriptorSet(PipelineHandle pipelineHandle, PipelineLayout* pPipelineLayout, u32 setIndex, u32 countPerFrame);
-		DescriptorSetHandle CreateDescriptorSetForFrame(PipelineHandle pipelineHandle, u32 layoutSlot,
-		                                                Vector<DescriptorSetBuilder::Bindings>& shaderBindings);
+		// Returns the set cached by the current frame for the bindings, allocating and writing it on a miss
+		DescriptorSetHandle CreateDescriptorSetForFrame(PipelineHandle pipelineHandle, u32 layoutSlot, u32 threadIdx,
+		                                                Vector<DescriptorSetBuilder::Bindings>& shaderBindings,
+		                                                bool isPersistent);
+
+		// Returns a copy of the cached set with the offsets of the dynamic bindings, valid for the current frame.
+		// Sets without dynamic bindings are bound with the offsets of 0 they are cached with.
+		DescriptorSetHandle CreateDynamicDescriptorSet(DescriptorSetHandle                           cachedSet,
+		                                               PipelineLayout const*                         pPipelineLayout,
+		                                               Vector<DescriptorSetBuilder::Bindings> const& shaderBindings);
+
+		// Allocates a cached set from the pools of a recording thread, adding a pool when they run out
+		VkDescriptorSet AllocateCachedDescriptorSet(Vector<VkDescriptorPool>& pools, Vector<u32>& poolNumSets,
+		                                            VkDescriptorSetLayout layout, u32& outPoolIdx);
+		void            DestroyCachedDescriptorPools();
+
+		// Drops the cached sets that bind the resource, called when it is destroyed
+		void InvalidateDescriptorSets(u64 resourceID);
+
+		// Frees the sets that the caches of the frame dropped, its fence must have been waited for
+		void FreeDroppedDescriptorSets(u32 frameIdx);
 
 	private:
 		friend RenderInstance;
+		friend CommandList;
 		friend DescriptorSetBuilder;
 		friend class RenderDeviceDebugUtils;
 
 	private:
+		// Sets cached by a recording thread in a frame in flight. Only that thread builds them, the lock
+		// is contended only when a resource invalidates them or the stats are read.
+		struct ThreadDescriptorSets
+		{
+			std::mutex                  m_Mutex;
+			DescriptorSetCache          m_Cache;
+			Vector<VkDescriptorPool>    m_Pools;       // Added when the others are full
+			Vector<u32>                 m_PoolNumSets; // Sets allocated from each pool, full ones aren't tried
+			Vector<DescriptorSetHandle> m_SetsToFree;  // Dropped by the cache, freed after the frame's fence wait
+		};
+
 		RenderInstance* m_RenderInstance{};
 
 		RenderResourcesDatabase m_ResourcesDB{};
+		std::mutex              m_DescriptorSetMutex; // Guards the descriptor sets of the DB while recording in parallel
+
+		FrameArray<Array<ThreadDescriptorSets, RenderSettings::MAX_RECORDING_THREADS>> m_ThreadDescriptorSets{};
 
-		CommandBufferManager m_CommandBufferManager{};
-		FrameSyncObjects     m_FrameSyncObjects{};
-		u32                  m_CurrFrameInFlightIdx = 0;
+		FrameArray<CommandBufferManager> m_CommandBuffers{};
+		FrameSyncObjects                 m_FrameSyncObjects{};
+		u32                              m_CurrFrameInFlightIdx = 0;
 
 		VkPhysicalDevice m_PhysicalDevice{};
 		VkDevice         m_Device{};
@@ -17,6 +17,7 @@ namespace CKE {
 	public:
 		i32                             m_DescriptorSetsInUse = 0;
 		Array<VkDescriptorSetLayout, 4> m_DescriptorSetLayouts;
+		Array<Vector<u32>, 4>           m_BufferSlots{}; // Buffer bindings of each set by slot, the order of their offsets
 		VkPipelineLayout                m_vkPipelineLayout;
 		PipelineLayoutDesc              m_Desc;
 	};
@@ -55,7 +56,15 @@ namespace CKE {
 	public:
 		Vector<TextureViewHandle> m_ExistingViews{};
 		VkImage                   m_vkImage{};
-		VmaAllocation             m_vmaAllocation{};
+		VmaAllocation             m_vmaAllocation{}; // Null if the texture is placed in a MemoryHeap
+	};
+
+	// Memory that textures are placed in, they are bound at an offset of the allocation
+	class MemoryHeap : public RenderResource<MemoryHeap>
+	{
+	public:
+		VmaAllocation m_vmaAllocation{};
+		u64           m_SizeInBytes = 0;
 	};
 
 	class TextureView : public RenderResource<TextureView>
@@ -63,6 +72,7 @@ namespace CKE {
 	public:
 		TextureHandle m_Texture;
 		VkImageView   m_vkView;
+		VkFormat      m_vkFormat; // Secondary cmd lists inherit the attachment formats
 	};
 
 	class TextureSampler : public RenderResource<TextureSampler>
@@ -77,6 +87,10 @@ namespace CKE {
 	public:
 		VkDescriptorSet m_DescriptorSet;
 		u32             m_LayoutIndex;
+		u32             m_PoolIdx = 0; // Pool of the thread that built it, cached sets are freed to it
+
+		Array<u32, RenderSettings::MAX_BUFFERS_PER_SET> m_DynamicOffsets{}; // Of every buffer binding, 0 unless it's dynamic
+		u32                                             m_NumDynamicOffsets = 0;
 	};
 
 	class CommandQueue : public RenderResource<CommandQueue>
@@ -0,0 +1,224 @@
+#include "CookieKat/Systems/RenderAPI/DescriptorSetCache.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+namespace CKE {
+	namespace {
+		// FNV-1a
+		class BindingsHasher
+		{
+		public:
+			template <typename T>
+			void Add(T value) {
+				u8 const* pBytes = reinterpret_cast<u8 const*>(&value);
+				for (u64 i = 0; i < sizeof(T); ++i) {
+					m_Hash = (m_Hash ^ pBytes[i]) * 1099511628211u;
+				}
+			}
+
+			inline u64 GetHash() const { return m_Hash; }
+
+		private:
+			u64 m_Hash = 14695981039346656037u;
+		};
+
+		// Dynamic storage buffers are written to reach the end of the buffer, whatever offset they are bound at
+		bool IsSizeInKey(DescriptorSetBuilder::Bindings const& binding) {
+			return !binding.m_IsDynamic || binding.m_Type != ShaderBindingType::StorageBuffer;
+		}
+	}
+
+	u64 HashDescriptorSetBindings(u64 layoutID, u64 setIndex, Vector<DescriptorSetBuilder::Bindings> const& bindings) {
+		BindingsHasher hasher{};
+		hasher.Add(layoutID);
+		hasher.Add(setIndex);
+		for (DescriptorSetBuilder::Bindings const& binding : bindings) {
+			hasher.Add(binding.m_Type);
+			hasher.Add(binding.m_Slot);
+			hasher.Add(binding.m_ResourceID1);
+			hasher.Add(binding.m_ResourceID2);
+			hasher.Add(binding.m_IsDynamic);
+			if (!binding.m_IsDynamic) { hasher.Add(binding.m_OffsetInBytes); }
+			if (IsSizeInKey(binding)) { hasher.Add(binding.m_SizeInBytes); }
+		}
+		return hasher.GetHash();
+	}
+
+	bool IsSameDescriptorSet(Vector<DescriptorSetBuilder::Bindings> const& a, Vector<DescriptorSetBuilder::Bindings> const& b) {
+		if (a.size() != b.size()) { return false; }
+		for (u64 i = 0; i < a.size(); ++i) {
+			if (a[i].m_Type != b[i].m_Type || a[i].m_Slot != b[i].m_Slot ||
+				a[i].m_ResourceID1 != b[i].m_ResourceID1 || a[i].m_ResourceID2 != b[i].m_ResourceID2 ||
+				a[i].m_IsDynamic != b[i].m_IsDynamic) { return false; }
+			if (!a[i].m_IsDynamic && a[i].m_OffsetInBytes != b[i].m_OffsetInBytes) { return false; }
+			if (IsSizeInKey(a[i]) && a[i].m_SizeInBytes != b[i].m_SizeInBytes) { return false; }
+		}
+		return true;
+	}
+
+	//-----------------------------------------------------------------------------
+
+	void DescriptorSetCache::Initialize(u64 capacity) {
+		CKE_ASSERT(capacity > 0);
+		m_Capacity = capacity;
+		m_Entries.clear();
+		m_Entries.reserve(capacity);
+		m_FreeEntries.clear();
+		m_Buckets.clear();
+		m_Newest = INVALID_ENTRY;
+		m_Oldest = INVALID_ENTRY;
+		m_NumRecentSets = 0;
+		m_NumPersistentSets = 0;
+		m_Stats = {};
+	}
+
+	DescriptorSetHandle DescriptorSetCache::Find(u64                                           hash, u64 layoutID, u64 setIndex,
+	                                             Vector<DescriptorSetBuilder::Bindings> const& bindings, bool isPersistent) {
+		u32 const entryIdx = FindEntry(hash, layoutID, setIndex, bindings);
+		if (entryIdx == INVALID_ENTRY) {
+			m_Stats.m_Misses++;
+			return DescriptorSetHandle{};
+		}
+
+		m_Stats.m_Hits++;
+		Entry& entry = m_Entries[entryIdx];
+		if (!entry.m_IsPersistent) {
+			Unlink(entryIdx);
+			if (isPersistent) {
+				entry.m_IsPersistent = true;
+				m_NumPersistentSets++;
+			}
+			else { LinkAsNewest(entryIdx); }
+		}
+		return entry.m_Set;
+	}
+
+	void DescriptorSetCache::Insert(u64                                           hash, u64 layoutID, u64 setIndex,
+	                                Vector<DescriptorSetBuilder::Bindings> const& bindings, DescriptorSetHandle set,
+	                                bool isPersistent, Vector<DescriptorSetHandle>& evictedSets) {
+		CKE_ASSERT(set.IsValid());
+		CKE_ASSERT(FindEntry(hash, layoutID, setIndex, bindings) == INVALID_ENTRY);
+
+		if (!isPersistent) {
+			while (m_NumRecentSets >= m_Capacity) {
+				RemoveEntry(m_Oldest, evictedSets);
+				m_Stats.m_Evictions++;
+			}
+		}
+
+		u32 entryIdx = INVALID_ENTRY;
+		if (!m_FreeEntries.empty()) {
+			entryIdx = m_FreeEntries.back();
+			m_FreeEntries.pop_back();
+		}
+		else {
+			entryIdx = static_cast<u32>(m_Entries.size());
+			m_Entries.emplace_back();
+		}
+
+		Entry& entry = m_Entries[entryIdx];
+		entry.m_Hash = hash;
+		entry.m_LayoutID = layoutID;
+		entry.m_SetIndex = setIndex;
+		entry.m_Bindings = bindings;
+		entry.m_Set = set;
+		entry.m_IsPersistent = isPersistent;
+
+		// Push to the front of the bucket
+		auto const bucketIt = m_Buckets.find(hash);
+		if (bucketIt != m_Buckets.end()) {
+			entry.m_NextInBucket = bucketIt->second;
+			bucketIt->second = entryIdx;
+		}
+		else { m_Buckets.insert({hash, entryIdx}); }
+
+		if (isPersistent) { m_NumPersistentSets++; }
+		else { LinkAsNewest(entryIdx); }
+	}
+
+	void DescriptorSetCache::InvalidateResource(u64 resourceID, Vector<DescriptorSetHandle>& removedSets) {
+		for (u32 i = 0; i < m_Entries.size(); ++i) {
+			Entry const& entry = m_Entries[i];
+			if (!entry.m_Set.IsValid()) { continue; }
+
+			bool isReferenced = entry.m_LayoutID == resourceID;
+			for (DescriptorSetBuilder::Bindings const& binding : entry.m_Bindings) {
+				isReferenced |= binding.m_ResourceID1 == resourceID || binding.m_ResourceID2 == resourceID;
+			}
+			if (isReferenced) { RemoveEntry(i, removedSets); }
+		}
+	}
+
+	void DescriptorSetCache::Clear(Vector<DescriptorSetHandle>& removedSets) {
+		for (Entry const& entry : m_Entries) {
+			if (entry.m_Set.IsValid()) { removedSets.push_back(entry.m_Set); }
+		}
+
+		m_Entries.clear();
+		m_FreeEntries.clear();
+		m_Buckets.clear();
+		m_Newest = INVALID_ENTRY;
+		m_Oldest = INVALID_ENTRY;
+		m_NumRecentSets = 0;
+		m_NumPersistentSets = 0;
+	}
+
+	u32 DescriptorSetCache::FindEntry(u64                                           hash, u64 layoutID, u64 setIndex,
+	                                  Vector<DescriptorSetBuilder::Bindings> const& bindings) const {
+		auto const bucketIt = m_Buckets.find(hash);
+		if (bucketIt == m_Buckets.end()) { return INVALID_ENTRY; }
+
+		for (u32 entryIdx = bucketIt->second; entryIdx != INVALID_ENTRY; entryIdx = m_Entries[entryIdx].m_NextInBucket) {
+			Entry const& entry = m_Entries[entryIdx];
+			if (entry.m_LayoutID == layoutID && entry.m_SetIndex == setIndex && IsSameDescriptorSet(entry.m_Bindings, bindings)) {
+				return entryIdx;
+			}
+		}
+		return INVALID_ENTRY;
+	}
+
+	void DescriptorSetCache::RemoveEntry(u32 entryIdx, Vector<DescriptorSetHandle>& removedSets) {
+		Entry& entry = m_Entries[entryIdx];
+
+		// Unlink it from its bucket
+		auto const bucketIt = m_Buckets.find(entry.m_Hash);
+		CKE_ASSERT(bucketIt != m_Buckets.end());
+		if (bucketIt->second == entryIdx) {
+			if (entry.m_NextInBucket == INVALID_ENTRY) { m_Buckets.erase(bucketIt); }
+			else { bucketIt->second = entry.m_NextInBucket; }
+		}
+		else {
+			u32 prevIdx = bucketIt->second;
+			while (m_Entries[prevIdx].m_NextInBucket != entryIdx) { prevIdx = m_Entries[prevIdx].m_NextInBucket; }
+			m_Entries[prevIdx].m_NextInBucket = entry.m_NextInBucket;
+		}
+
+		if (entry.m_IsPersistent) { m_NumPersistentSets--; }
+		else { Unlink(entryIdx); }
+
+		removedSets.push_back(entry.m_Set);
+		entry = Entry{};
+		m_FreeEntries.push_back(entryIdx);
+	}
+
+	void DescriptorSetCache::LinkAsNewest(u32 entryIdx) {
+		Entry& entry = m_Entries[entryIdx];
+		entry.m_Newer = INVALID_ENTRY;
+		entry.m_Older = m_Newest;
+		if (m_Newest != INVALID_ENTRY) { m_Entries[m_Newest].m_Newer = entryIdx; }
+		else { m_Oldest = entryIdx; }
+		m_Newest = entryIdx;
+		m_NumRecentSets++;
+	}
+
+	void DescriptorSetCache::Unlink(u32 entryIdx) {
+		Entry& entry = m_Entries[entryIdx];
+		if (entry.m_Newer != INVALID_ENTRY) { m_Entries[entry.m_Newer].m_Older = entry.m_Older; }
+		else { m_Newest = entry.m_Older; }
+		if (entry.m_Older != INVALID_ENTRY) { m_Entries[entry.m_Older].m_Newer = entry.m_Newer; }
+		else { m_Oldest = entry.m_Newer; }
+		entry.m_Newer = INVALID_ENTRY;
+		entry.m_Older = INVALID_ENTRY;
+		m_NumRecentSets--;
+	}
+}
@@ -0,0 +1,182 @@
+#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <algorithm>
+
+namespace CKE {
+	u64 NullCommandStream::Count(NullCommandType type) const {
+		return std::count_if(m_Commands.begin(), m_Commands.end(),
+		                     [type](NullCommand const& command) { return command.m_Type == type; });
+	}
+
+	CommandList::CommandList(RenderDevice* pRenderDevice, NullCommandStream* pStream)
+		: m_pDevice{pRenderDevice}, m_pStream{pStream} { }
+
+	void CommandList::Record(NullCommandType type, u64 arg0, u64 arg1, u64 arg2, u64 arg3, u64 arg4) {
+		CKE_ASSERT(m_pStream->m_IsRecording);
+		m_pStream->m_Commands.push_back(NullCommand{type, {arg0, arg1, arg2, arg3, arg4}});
+	}
+
+	void CommandList::Begin() {
+		m_pStream->m_Commands.clear();
+		m_pStream->m_DebugLabels.clear();
+		m_pStream->m_IsRecording = true;
+		Record(NullCommandType::Begin);
+	}
+
+	void CommandList::End() {
+		Record(NullCommandType::End);
+		m_pStream->m_IsRecording = false;
+	}
+
+	void CommandList::BeginSecondary(RenderingInfo const& renderingInfo) {
+		CKE_ASSERT(m_pStream->m_IsSecondary);
+		m_pStream->m_Commands.clear();
+		m_pStream->m_DebugLabels.clear();
+		m_pStream->m_IsRecording = true;
+		Record(NullCommandType::BeginSecondary, renderingInfo.m_ColorAttachments.size(),
+		       renderingInfo.m_UseDepthAttachment);
+	}
+
+	void CommandList::ExecuteCommands(Vector<CommandList> const& secondaryCmdLists) {
+		Record(NullCommandType::ExecuteCommands, secondaryCmdLists.size());
+		for (CommandList const& secondary : secondaryCmdLists) {
+			NullCommandStream const& stream = secondary.GetStream();
+			CKE_ASSERT(stream.m_IsSecondary && !stream.m_IsRecording);
+
+			// Labels are renumbered to the ones of this stream
+			u64 const labelOffset = m_pStream->m_DebugLabels.size();
+			for (NullCommand command : stream.m_Commands) {
+				if (command.m_Type == NullCommandType::BeginDebugLabel) { command.m_Args[0] += labelOffset; }
+				m_pStream->m_Commands.push_back(command);
+			}
+			m_pStream->m_DebugLabels.insert(m_pStream->m_DebugLabels.end(),
+			                                stream.m_DebugLabels.begin(), stream.m_DebugLabels.end());
+		}
+	}
+
+	void CommandList::BeginRendering(RenderingInfo renderingInfo) {
+		Record(NullCommandType::BeginRendering, renderingInfo.m_ColorAttachments.size(),
+		       renderingInfo.m_UseDepthAttachment, renderingInfo.m_ContentsInSecondaryCmdLists,
+		       renderingInfo.m_RenderArea.x, renderingInfo.m_RenderArea.y);
+	}
+
+	void CommandList::EndRendering() {
+		Record(NullCommandType::EndRendering);
+	}
+
+	void CommandList::SetViewport(Vec2, Vec2, Vec2) {
+		Record(NullCommandType::SetViewport);
+	}
+
+	void CommandList::SetScissor(Int2 offset, UInt2 extent) {
+		Record(NullCommandType::SetScissor, static_cast<u64>(offset.x), static_cast<u64>(offset.y), extent.x, extent.y);
+	}
+
+	void CommandList::SetGraphicsPipeline(PipelineHandle pipeline) {
+		SetPipeline(pipeline, PipelineBindPoint::Graphics);
+	}
+
+	void CommandList::SetPipeline(PipelineHandle pipeline, PipelineBindPoint bindPoint) {
+		Record(NullCommandType::SetPipeline, pipeline.m_Value, static_cast<u64>(bindPoint));
+	}
+
+	void CommandList::SetDefaultViewportScissor(Vec2 size) {
+		SetViewport({0.0f, 0.0f}, size, {0.0f, 1.0f});
+		SetScissor({0, 0}, UInt2(size));
+	}
+
+	void CommandList::SetVertexBuffer(BufferHandle bufferHandle) {
+		SetVertexBuffer(bufferHandle, 0, 1, 0);
+	}
+
+	void CommandList::SetVertexBuffer(BufferHandle bufferHandle, u32 firstBinding, u32 bindingCount, u64 offset) {
+		CKE_ASSERT(m_pDevice->m_Buffers.contains(bufferHandle));
+		Record(NullCommandType::SetVertexBuffer, bufferHandle.m_Value, firstBinding, bindingCount, offset);
+	}
+
+	void CommandList::SetIndexBuffer(BufferHandle bufferHandle, u64 offset) {
+		SetIndexBuffer(bufferHandle, offset, IndicesFormat::UINT32);
+	}
+
+	void CommandList::SetIndexBuffer(BufferHandle bufferHandle, u64 offset, IndicesFormat indicesFormat) {
+		CKE_ASSERT(m_pDevice->m_Buffers.contains(bufferHandle));
+		Record(NullCommandType::SetIndexBuffer, bufferHandle.m_Value, offset, static_cast<u64>(indicesFormat));
+	}
+
+	void CommandList::Draw(u32 vertexCount, u32 instanceCount, u32 firstVertex, u32 firstInstance) {
+		Record(NullCommandType::Draw, vertexCount, instanceCount, firstVertex, firstInstance);
+	}
+
+	void CommandList::DrawIndexed(u64 indexCount, u64 firstInstance) {
+		DrawIndexed(static_cast<u32>(indexCount), 1, 0, 0, static_cast<u32>(firstInstance));
+	}
+
+	void CommandList::DrawIndexed(u32 indexCount, u32 instanceCount, u32 firstIndex, i32 vertexOffset, u32 firstInstance) {
+		Record(NullCommandType::DrawIndexed, indexCount, instanceCount, firstIndex, static_cast<u64>(vertexOffset),
+		       firstInstance);
+	}
+
+	void CommandList::BindDescriptor(PipelineHandle pipeline, DescriptorSetHandle descriptorSet) {
+		CKE_ASSERT(m_pDevice->GetDescriptorSet(descriptorSet) != nullptr);
+		Record(NullCommandType::BindDescriptor, pipeline.m_Value, descriptorSet.m_Value,
+		       static_cast<u64>(PipelineBindPoint::Graphics));
+	}
+
+	void CommandList::PushConstant(PipelineHandle pipeline, u64 dataSize, void*) {
+		Record(NullCommandType::PushConstant, pipeline.m_Value, dataSize);
+	}
+
+	void CommandList::Barrier(TextureBarrierDescription desc) {
+		Barrier(&desc, 1);
+	}
+
+	void CommandList::Barrier(TextureBarrierDescription const* pDesc, u32 count) {
+		for (u32 i = 0; i < count; ++i) {
+			Record(NullCommandType::Barrier, pDesc[i].m_Texture.m_Value, static_cast<u64>(pDesc[i].m_OldLayout),
+			       static_cast<u64>(pDesc[i].m_NewLayout));
+		}
+	}
+
+	void CommandList::CopyBuffer(BufferHandle src, BufferHandle dst, BufferCopyInfo copyInfo) {
+		Record(NullCommandType::CopyBuffer, src.m_Value, dst.m_Value, copyInfo.srcOffset, copyInfo.dstOffset,
+		       copyInfo.size);
+	}
+
+	void CommandList::CopyTexture(TextureCopyInfo srcInfo, TextureCopyInfo dstInfo, UInt3 size) {
+		Record(NullCommandType::CopyTexture, srcInfo.m_TexHandle.m_Value, dstInfo.m_TexHandle.m_Value,
+		       size.x, size.y, size.z);
+	}
+
+	void CommandList::CopyBufferToTexture(BufferHandle src, TextureHandle dst, BufferImageCopyInfo copyInfo) {
+		Record(NullCommandType::CopyBufferToTexture, src.m_Value, dst.m_Value, copyInfo.bufferOffset,
+		       copyInfo.imageSubresource.m_MipLevel, copyInfo.imageSubresource.m_ArrayBaseLayer);
+	}
+
+	void CommandList::CopyTextureToBuffer(TextureHandle src, BufferHandle dst, BufferImageCopyInfo copyInfo) {
+		Record(NullCommandType::CopyTextureToBuffer, src.m_Value, dst.m_Value, copyInfo.bufferOffset,
+		       copyInfo.imageSubresource.m_MipLevel, copyInfo.imageSubresource.m_ArrayBaseLayer);
+	}
+
+	void CommandList::BindComputeDescriptor(PipelineHandle pipeline, DescriptorSetHandle set) {
+		CKE_ASSERT(m_pDevice->GetDescriptorSet(set) != nullptr);
+		Record(NullCommandType::BindDescriptor, pipeline.m_Value, set.m_Value, static_cast<u64>(PipelineBindPoint::Compute));
+	}
+
+	void CommandList::SetComputePipeline(PipelineHandle pipeline) {
+		SetPipeline(pipeline, PipelineBindPoint::Compute);
+	}
+
+	void CommandList::Dispatch(u32 groupCountX, u32 groupCountY, u32 groupCountZ) {
+		Record(NullCommandType::Dispatch, groupCountX, groupCountY, groupCountZ);
+	}
+
+	void CommandList::BeginDebugLabel(const char* pName, Vec3) {
+		Record(NullCommandType::BeginDebugLabel, m_pStream->m_DebugLabels.size());
+		m_pStream->m_DebugLabels.emplace_back(pName);
+	}
+
+	void CommandList::EndDebugLabel() {
+		Record(NullCommandType::EndDebugLabel);
+	}
+}
@@ -0,0 +1,729 @@
+#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+
+namespace CKE {
+	void RenderDevice::SetRenderTargetData(void*) { }
+
+	void RenderDevice::Initialize(Int2 backBufferSize) {
+		for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) {
+			FrameCommandStreams& streams = m_CommandStreams[i];
+			streams.m_Graphics.resize(RenderSettings::GRAPHICS_CMDLIST_COUNT_PERFRAME, {QueueType::Graphics});
+			streams.m_Transfer.resize(RenderSettings::TRANSFER_CMDLIST_COUNT_PERFRAME, {QueueType::Transfer});
+			streams.m_Compute.resize(RenderSettings::COMPUTE_CMDLIST_COUNT_PERFRAME, {QueueType::Compute});
+			for (Vector<NullCommandStream>& threadStreams : streams.m_Secondary) {
+				threadStreams.resize(RenderSettings::SECONDARY_CMDLIST_COUNT_PERTHREAD, {QueueType::Graphics, true});
+			}
+
+			m_FrameSync[i].m_ImageAvailable = CreateSemaphoreGPU();
+			m_FrameSync[i].m_RenderFinished = CreateSemaphoreGPU();
+			m_FrameSync[i].m_InFlight = CreateFence(true);
+			for (ThreadDescriptorSets& threadSets : m_ThreadDescriptorSets[i]) {
+				threadSets.m_Cache.Initialize(RenderSettings::DESCRIPTOR_SET_CACHE_CAPACITY);
+			}
+		}
+
+		CreateBackBuffers(backBufferSize);
+	}
+
+	void RenderDevice::Shutdown() {
+		DestroyBackBuffers();
+		for (FrameSync& sync : m_FrameSync) {
+			DestroySemaphore(sync.m_ImageAvailable);
+			DestroySemaphore(sync.m_RenderFinished);
+			DestroyFence(sync.m_InFlight);
+		}
+		for (FrameCommandStreams& streams : m_CommandStreams) { streams = FrameCommandStreams{}; }
+		for (auto& frameThreadSets : m_ThreadDescriptorSets) {
+			for (ThreadDescriptorSets& threadSets : frameThreadSets) {
+				threadSets.m_Cache.Clear(threadSets.m_SetsToFree);
+				threadSets.m_SetsToFree.clear();
+				threadSets.m_PoolNumSets.clear();
+			}
+		}
+		for (auto& descriptorSets : m_DescriptorSets) { descriptorSets.clear(); }
+		for (auto& descriptorSets : m_DynamicDescriptorSets) { descriptorSets.clear(); }
+		m_Submissions.clear();
+	}
+
+	// Frame Sync
+	//-----------------------------------------------------------------------------
+
+	void RenderDevice::AcquireNextBackBuffer() {
+		WaitForFence(GetInFlightFence());
+		ResetFence(GetInFlightFence());
+
+		m_CurrBackBufferIdx = (m_CurrBackBufferIdx + 1) % m_BackBuffers.size();
+		ResetAllPerFrameData();
+	}
+
+	void RenderDevice::ResetAllPerFrameData() {
+		FrameCommandStreams& streams = m_CommandStreams[m_CurrFrameInFlightIdx];
+		streams.m_NextGraphics = 0;
+		streams.m_NextTransfer = 0;
+		streams.m_NextCompute = 0;
+		streams.m_NextSecondary.fill(0);
+
+		m_Submissions.clear();
+		FreeDroppedDescriptorSets(m_CurrFrameInFlightIdx);
+		std::lock_guard lock{m_DescriptorSetMutex};
+		m_DynamicDescriptorSets[m_CurrFrameInFlightIdx].clear();
+	}
+
+	void RenderDevice::Present() {
+		if (m_BackBufferResized) {
+			m_BackBufferResized = false;
+			DestroyBackBuffers();
+			CreateBackBuffers(m_NewBackBufferSize);
+		}
+
+		// Advance frame idx counter
+		m_CurrFrameInFlightIdx = (m_CurrFrameInFlightIdx + 1) % RenderSettings::MAX_FRAMES_IN_FLIGHT;
+	}
+
+	SemaphoreHandle RenderDevice::GetImageAvailableSemaphore() {
+		return m_FrameSync[m_CurrFrameInFlightIdx].m_ImageAvailable;
+	}
+
+	SemaphoreHandle RenderDevice::GetRenderFinishedSemaphore() {
+		return m_FrameSync[m_CurrFrameInFlightIdx].m_RenderFinished;
+	}
+
+	FenceHandle RenderDevice::GetInFlightFence() {
+		return m_FrameSync[m_CurrFrameInFlightIdx].m_InFlight;
+	}
+
+	void RenderDevice::WaitForDevice() { }
+
+	void RenderDevice::WaitGraphicsQueueIdle() { }
+
+	void RenderDevice::WaitTransferQueueIdle() { }
+
+	// Buffers
+	//-----------------------------------------------------------------------------
+
+	BufferHandle RenderDevice::CreateBuffer(BufferDesc bufferDesc) {
+		BufferHandle const handle = AllocateHandle<Buffer>();
+		Buffer&            buffer = m_Buffers[handle];
+		buffer.m_DBHandle = handle;
+		buffer.m_Desc = bufferDesc;
+		buffer.m_IsPerFrame = bufferDesc.m_DuplicationStrategy == DuplicationStrategy::PerFrameInFlight;
+		buffer.m_IsMapped = bufferDesc.m_MemoryAccess == MemoryAccess::CPU_GPU_Coherent;
+
+		u32 const copies = buffer.m_IsPerFrame ? RenderSettings::MAX_FRAMES_IN_FLIGHT : 1;
+		for (u32 i = 0; i < copies; ++i) { buffer.m_Data[i].resize(bufferDesc.m_SizeInBytes, 0); }
+		return handle;
+	}
+
+	void RenderDevice::DestroyBuffer(BufferHandle bufferHandle) {
+		CKE_ASSERT(m_Buffers.contains(bufferHandle));
+		InvalidateDescriptorSets(bufferHandle.m_Value);
+		m_Buffers.erase(bufferHandle);
+	}
+
+	void* RenderDevice::MapBuffer(BufferHandle bufferHandle) {
+		m_Buffers.at(bufferHandle).m_IsMapped = true;
+		return GetBufferData(bufferHandle).data();
+	}
+
+	void RenderDevice::UnMapBuffer(BufferHandle bufferHandle) {
+		Buffer& buffer = m_Buffers.at(bufferHandle);
+		buffer.m_IsMapped = buffer.m_Desc.m_MemoryAccess == MemoryAccess::CPU_GPU_Coherent;
+	}
+
+	void* RenderDevice::GetBufferMappedPtr(BufferHandle bufferHandle) {
+		CKE_ASSERT(m_Buffers.at(bufferHandle).m_IsMapped);
+		return GetBufferData(bufferHandle).data();
+	}
+
+	void RenderDevice::UploadBufferData_DEPR(BufferHandle bufferHandle, void const* pData, u64 sizeInBytes,
+	                                         u64          offsetInBytes) {
+		Vector<u8>& data = GetBufferData(bufferHandle);
+		CKE_ASSERT(offsetInBytes + sizeInBytes <= data.size());
+		std::memcpy(data.data() + offsetInBytes, pData, sizeInBytes);
+	}
+
+	Vector<u8>& RenderDevice::GetBufferData(BufferHandle bufferHandle) {
+		Buffer& buffer = m_Buffers.at(bufferHandle);
+		return buffer.m_Data[buffer.m_IsPerFrame ? m_CurrFrameInFlightIdx : 0];
+	}
+
+	// Textures and Samplers
+	//-----------------------------------------------------------------------------
+
+	TextureHandle RenderDevice::CreateTexture(TextureDesc desc) {
+		TextureHandle const handle = AllocateHandle<Texture>();
+		Texture&            texture = m_Textures[handle];
+		texture.m_DBHandle = handle;
+		texture.m_Desc = desc;
+		return handle;
+	}
+
+	TextureViewHandle RenderDevice::CreateTextureView(TextureViewDesc desc) {
+		TextureViewHandle const handle = AllocateHandle<TextureView>();
+		TextureView&            view = m_TextureViews[handle];
+		view.m_DBHandle = handle;
+		view.m_Desc = desc;
+		m_Textures.at(desc.m_Texture).m_ExistingViews.push_back(handle);
+		return handle;
+	}
+
+	SamplerHandle RenderDevice::CreateSampler(SamplerDesc desc) {
+		SamplerHandle const handle = AllocateHandle<TextureSampler>();
+		TextureSampler&     sampler = m_Samplers[handle];
+		sampler.m_DBHandle = handle;
+		sampler.m_Desc = desc;
+		return handle;
+	}
+
+	void RenderDevice::DestroyTexture(TextureHandle textureHandle) {
+		Texture const& texture = m_Textures.at(textureHandle);
+		for (TextureViewHandle view : texture.m_ExistingViews) {
+			InvalidateDescriptorSets(view.m_Value);
+			m_TextureViews.erase(view);
+		}
+		if (texture.m_Heap.IsValid()) {
+			m_MemoryHeaps.at(texture.m_Heap).m_NumPlacedTextures--;
+		}
+		m_Textures.erase(textureHandle);
+	}
+
+	void RenderDevice::DestroyTextureView(TextureViewHandle handle) {
+		TextureView const& view = m_TextureViews.at(handle);
+		Vector<TextureViewHandle>& views = m_Textures.at(view.m_Desc.m_Texture).m_ExistingViews;
+		views.erase(std::find(views.begin(), views.end(), handle));
+		InvalidateDescriptorSets(handle.m_Value);
+		m_TextureViews.erase(handle);
+	}
+
+	void RenderDevice::DestroySampler(SamplerHandle samplerHandle) {
+		CKE_ASSERT(m_Samplers.contains(samplerHandle));
+		InvalidateDescriptorSets(samplerHandle.m_Value);
+		m_Samplers.erase(samplerHandle);
+	}
+
+	// Memory Heaps
+	//-----------------------------------------------------------------------------
+
+	MemoryRequirements RenderDevice::GetTextureMemoryRequirements(TextureDesc const& desc) {
+		u64 mipChainSize = 0;
+		for (u32 mip = 0; mip < desc.m_MipLevels; ++mip) {
+			u32 const width = std::max(desc.m_Size.x >> mip, 1u);
+			u32 const height = std::max(desc.m_Size.y >> mip, 1u);
+			u32 const depth = std::max(desc.m_Size.z >> mip, 1u);
+			mipChainSize += GetTextureMipByteSize(desc.m_Format, width, height) * depth;
+		}
+
+		MemoryRequirements requirements{};
+		requirements.m_Alignment = 64 * 1024;
+		requirements.m_SizeInBytes = mipChainSize * desc.m_ArraySize * desc.m_SampleCount;
+		requirements.m_SizeInBytes = (requirements.m_SizeInBytes + requirements.m_Alignment - 1) /
+				requirements.m_Alignment * requirements.m_Alignment;
+		requirements.m_MemoryTypeBits = 1;
+		return requirements;
+	}
+
+	MemoryHeapHandle RenderDevice::CreateMemoryHeap(MemoryRequirements const& requirements) {
+		CKE_ASSERT(requirements.m_MemoryTypeBits & 1);
+		MemoryHeapHandle const handle = AllocateHandle<MemoryHeap>();
+		MemoryHeap&            heap = m_MemoryHeaps[handle];
+		heap.m_DBHandle = handle;
+		heap.m_SizeInBytes = requirements.m_SizeInBytes;
+		return handle;
+	}
+
+	void RenderDevice::DestroyMemoryHeap(MemoryHeapHandle heapHandle) {
+		CKE_ASSERT(m_MemoryHeaps.at(heapHandle).m_NumPlacedTextures == 0);
+		m_MemoryHeaps.erase(heapHandle);
+	}
+
+	TextureHandle RenderDevice::CreatePlacedTexture(TextureDesc desc, MemoryHeapHandle heapHandle, u64 offsetInBytes) {
+		MemoryHeap&              heap = m_MemoryHeaps.at(heapHandle);
+		MemoryRequirements const requirements = GetTextureMemoryRequirements(desc);
+		CKE_ASSERT(offsetInBytes % requirements.m_Alignment == 0);
+		CKE_ASSERT(offsetInBytes + requirements.m_SizeInBytes <= heap.m_SizeInBytes);
+
+		TextureHandle const handle = CreateTexture(desc);
+		Texture&            texture = m_Textures.at(handle);
+		texture.m_Heap = heapHandle;
+		texture.m_HeapOffset = offsetInBytes;
+		heap.m_NumPlacedTextures++;
+		return handle;
+	}
+
+	MemoryHeapHandle RenderDevice::GetTextureHeap(TextureHandle handle, u64& offsetInBytes) const {
+		Texture const& texture = m_Textures.at(handle);
+		offsetInBytes = texture.m_HeapOffset;
+		return texture.m_Heap;
+	}
+
+	// Pipelines
+	//-----------------------------------------------------------------------------
+
+	PipelineLayoutHandle RenderDevice::CreatePipelineLayout(PipelineLayoutDesc const& layoutDesc) {
+		PipelineLayoutHandle const handle = AllocateHandle<PipelineLayout>();
+		PipelineLayout&            layout = m_PipelineLayouts[handle];
+		layout.m_DBHandle = handle;
+		layout.m_Desc = layoutDesc;
+		return handle;
+	}
+
+	void RenderDevice::DestroyPipelineLayout(PipelineLayoutHandle handle) {
+		CKE_ASSERT(m_PipelineLayouts.contains(handle));
+		InvalidateDescriptorSets(handle.m_Value);
+		m_PipelineLayouts.erase(handle);
+	}
+
+	PipelineHandle RenderDevice::CreateGraphicsPipeline(GraphicsPipelineDesc const& desc) {
+		PipelineHandle const handle = AllocateHandle<Pipeline>();
+		Pipeline&            pipeline = m_Pipelines[handle];
+		pipeline.m_DBHandle = handle;
+		pipeline.m_PipelineLayout = desc.m_LayoutHandle;
+		return handle;
+	}
+
+	PipelineHandle RenderDevice::CreateComputePipeline(ComputePipelineDesc const& desc) {
+		PipelineHandle const handle = AllocateHandle<Pipeline>();
+		Pipeline&            pipeline = m_Pipelines[handle];
+		pipeline.m_DBHandle = handle;
+		pipeline.m_PipelineLayout = desc.m_Layout;
+		pipeline.m_IsCompute = true;
+		return handle;
+	}
+
+	void RenderDevice::DestroyPipeline(PipelineHandle pipelineHandle) {
+		CKE_ASSERT(m_Pipelines.contains(pipelineHandle));
+		m_Pipelines.erase(pipelineHandle);
+	}
+
+	// Semaphores and Fences
+	//-----------------------------------------------------------------------------
+
+	SemaphoreHandle RenderDevice::CreateSemaphoreGPU() {
+		SemaphoreHandle const handle = AllocateHandle<Semaphore>();
+		m_Semaphores[handle].m_DBHandle = handle;
+		return handle;
+	}
+
+	void RenderDevice::DestroySemaphore(SemaphoreHandle handle) {
+		CKE_ASSERT(m_Semaphores.contains(handle));
+		m_Semaphores.erase(handle);
+	}
+
+	FenceHandle RenderDevice::CreateFence(bool createSignaled) {
+		FenceHandle const handle = AllocateHandle<Fence>();
+		Fence&            fence = m_Fences[handle];
+		fence.m_DBHandle = handle;
+		fence.m_IsSignaled = createSignaled;
+		return handle;
+	}
+
+	void RenderDevice::DestroyFence(FenceHandle fence) {
+		CKE_ASSERT(m_Fences.contains(fence));
+		m_Fences.erase(fence);
+	}
+
+	void RenderDevice::WaitForFence(FenceHandle fence) {
+		auto const held = std::find(m_HeldFences.begin(), m_HeldFences.end(), fence);
+		if (held != m_HeldFences.end()) { CompleteHeldSubmissions(held - m_HeldFences.begin() + 1); }
+		CKE_ASSERT(m_Fences.at(fence).m_IsSignaled);
+	}
+
+	bool RenderDevice::IsFenceSignaled(FenceHandle fence) {
+		return m_Fences.at(fence).m_IsSignaled;
+	}
+
+	void RenderDevice::ResetFence(FenceHandle fence) {
+		m_Fences.at(fence).m_IsSignaled = false;
+	}
+
+	// Queues
+	//-----------------------------------------------------------------------------
+
+	CommandQueueHandle RenderDevice::CreateCommandQueue(CommandQueueDesc desc) {
+		CommandQueueHandle const handle = AllocateHandle<CommandQueue>();
+		CommandQueue&            queue = m_Queues[handle];
+		queue.m_DBHandle = handle;
+		queue.m_Type = desc.m_QueueType;
+		return handle;
+	}
+
+	// Command Lists
+	//-----------------------------------------------------------------------------
+
+	NullCommandStream* RenderDevice::GetNextStream(Vector<NullCommandStream>& streams, u32& nextIdx) {
+		CKE_ASSERT(nextIdx < streams.size());
+		return &streams[nextIdx++];
+	}
+
+	CommandList RenderDevice::GetGraphicsCmdList() {
+		FrameCommandStreams& f = m_CommandStreams[m_CurrFrameInFlightIdx];
+		return CommandList{this, GetNextStream(f.m_Graphics, f.m_NextGraphics)};
+	}
+
+	TransferCommandList RenderDevice::GetTransferCmdList() {
+		FrameCommandStreams& f = m_CommandStreams[m_CurrFrameInFlightIdx];
+		return TransferCommandList{this, GetNextStream(f.m_Transfer, f.m_NextTransfer)};
+	}
+
+	ComputeCommandList RenderDevice::GetComputeCmdList() {
+		FrameCommandStreams& f = m_CommandStreams[m_CurrFrameInFlightIdx];
+		return ComputeCommandList{this, GetNextStream(f.m_Compute, f.m_NextCompute)};
+	}
+
+	CommandList RenderDevice::GetSecondaryGraphicsCmdList(u32 threadIdx) {
+		CKE_ASSERT(threadIdx < RenderSettings::MAX_RECORDING_THREADS);
+		FrameCommandStreams& f = m_CommandStreams[m_CurrFrameInFlightIdx];
+		return CommandList{this, GetNextStream(f.m_Secondary[threadIdx], f.m_NextSecondary[threadIdx])};
+	}
+
+	void RenderDevice::SubmitGraphicsCommandList(CommandList& cmdList, CmdListSubmitInfo submitInfo) {
+		SubmitStream(cmdList.m_pStream, submitInfo);
+		SignalSubmission(submitInfo);
+	}
+
+	void RenderDevice::SubmitGraphicsCommandLists(Vector<CommandList>& cmdList, CmdListSubmitInfo submitInfo) {
+		for (CommandList& c : cmdList) { SubmitStream(c.m_pStream, submitInfo); }
+		SignalSubmission(submitInfo);
+	}
+
+	void RenderDevice::SubmitTransferCommandList(TransferCommandList& cmdList, CmdListSubmitInfo submitInfo) {
+		SubmitStream(cmdList.m_pStream, submitInfo);
+		SignalSubmission(submitInfo);
+	}
+
+	void RenderDevice::SubmitComputeCommandList(ComputeCommandList& cmdList, CmdListSubmitInfo submitInfo) {
+		SubmitStream(cmdList.m_pStream, submitInfo);
+		SignalSubmission(submitInfo);
+	}
+
+	void RenderDevice::SubmitStream(NullCommandStream* pStream, CmdListSubmitInfo const& submitInfo) {
+		CKE_ASSERT(!pStream->m_IsRecording && !pStream->m_IsSecondary);
+
+		for (NullCommand const& command : pStream->m_Commands) {
+			if (command.m_Type != NullCommandType::CopyBuffer) { continue; }
+
+			Vector<u8> const& src = GetBufferData(BufferHandle{RenderHandle{command.m_Args[0]}});
+			Vector<u8>&       dst = GetBufferData(BufferHandle{RenderHandle{command.m_Args[1]}});
+			u64 const         srcOffset = command.m_Args[2];
+			u64 const         dstOffset = command.m_Args[3];
+			u64 const         size = command.m_Args[4];
+			CKE_ASSERT(srcOffset + size <= src.size() && dstOffset + size <= dst.size());
+			std::memmove(dst.data() + dstOffset, src.data() + srcOffset, size);
+		}
+
+		m_Submissions.push_back(NullSubmission{pStream->m_Queue, pStream, submitInfo});
+	}
+
+	void RenderDevice::SignalSubmission(CmdListSubmitInfo const& submitInfo) {
+		if (!submitInfo.m_SignalFence.IsValid()) { return; }
+		if (m_HoldSubmissions) { m_HeldFences.push_back(submitInfo.m_SignalFence); }
+		else { m_Fences.at(submitInfo.m_SignalFence).m_IsSignaled = true; }
+	}
+
+	void RenderDevice::CompleteHeldSubmissions(u64 count) {
+		u64 const numCompleted = std::min(count, static_cast<u64>(m_HeldFences.size()));
+		for (u64 i = 0; i < numCompleted; ++i) { m_Fences.at(m_HeldFences[i]).m_IsSignaled = true; }
+		m_HeldFences.erase(m_HeldFences.begin(), m_HeldFences.begin() + numCompleted);
+	}
+
+	// Descriptor Sets
+	//-----------------------------------------------------------------------------
+
+	DescriptorSetBuilder
+	RenderDevice::CreateDescriptorSetBuilder(PipelineHandle p, u64 setIndex, u32 threadIdx) {
+		CKE_ASSERT(threadIdx < RenderSettings::MAX_RECORDING_THREADS);
+		DescriptorSetBuilder b{};
+		b.m_PipelineHandle = p;
+		b.m_SetIndex = setIndex;
+		b.m_ThreadIdx = threadIdx;
+		b.m_pDevice = this;
+		return b;
+	}
+
+	DescriptorSetCacheStats RenderDevice::GetDescriptorSetCacheStats() {
+		DescriptorSetCacheStats stats{};
+		for (auto& frameThreadSets : m_ThreadDescriptorSets) {
+			for (ThreadDescriptorSets& threadSets : frameThreadSets) {
+				std::lock_guard lock{threadSets.m_Mutex};
+				stats.m_Hits += threadSets.m_Cache.GetStats().m_Hits;
+				stats.m_Misses += threadSets.m_Cache.GetStats().m_Misses;
+				stats.m_Evictions += threadSets.m_Cache.GetStats().m_Evictions;
+			}
+		}
+		return stats;
+	}
+
+	DescriptorSetHandle RenderDevice::CreateDescriptorSetForFrame(PipelineHandle                          pipelineHandle,
+	                                                              u32                                     layoutIndex,
+	                                                              u32                                     threadIdx,
+	                                                              Vector<DescriptorSetBuilder::Bindings>& shaderBindings,
+	                                                              bool                                    isPersistent) {
+		CKE_ASSERT(m_Pipelines.contains(pipelineHandle));
+		CKE_ASSERT(threadIdx < RenderSettings::MAX_RECORDING_THREADS);
+		u64 const layoutID = m_Pipelines.at(pipelineHandle).m_PipelineLayout.m_Value;
+		u64 const hash = HashDescriptorSetBindings(layoutID, layoutIndex, shaderBindings);
+
+		// Each recording thread has its own cache and pools, a miss doesn't make the other threads wait
+		ThreadDescriptorSets& threadSets = m_ThreadDescriptorSets[m_CurrFrameInFlightIdx][threadIdx];
+		std::lock_guard       threadLock{threadSets.m_Mutex};
+		DescriptorSetCache&   cache = threadSets.m_Cache;
+		DescriptorSetHandle   handle = cache.Find(hash, layoutID, layoutIndex, shaderBindings, isPersistent);
+		if (handle.IsValid()) { return CreateDynamicDescriptorSet(handle, shaderBindings); }
+
+		// The newest pool with room, freed sets leave room in the older ones
+		Vector<u32>& poolNumSets = threadSets.m_PoolNumSets;
+		auto const   freePool = std::find_if(poolNumSets.rbegin(), poolNumSets.rend(), [](u32 numSets) {
+			return numSets < RenderSettings::DESCRIPTOR_SETS_PER_POOL;
+		});
+		u32 poolIdx = static_cast<u32>(poolNumSets.size());
+		if (freePool != poolNumSets.rend()) { poolIdx = static_cast<u32>(freePool.base() - poolNumSets.begin()) - 1; }
+		else { poolNumSets.push_back(0); }
+		poolNumSets[poolIdx]++;
+
+		handle = AllocateHandle<DescriptorSet>();
+		DescriptorSet set{};
+		set.m_DBHandle = handle;
+		set.m_Pipeline = pipelineHandle; // The first one built with it, any pipeline with the same layout can bind it
+		set.m_LayoutIndex = layoutIndex;
+		set.m_Bindings = shaderBindings;
+		set.m_PoolIdx = poolIdx;
+		{
+			std::lock_guard lock{m_DescriptorSetMutex};
+			m_DescriptorSets[m_CurrFrameInFlightIdx].insert({handle, set});
+		}
+
+		// Evicted sets can be bound earlier in the frame, they are freed once its fence is waited for
+		cache.Insert(hash, layoutID, layoutIndex, shaderBindings, handle, isPersistent, threadSets.m_SetsToFree);
+		return CreateDynamicDescriptorSet(handle, shaderBindings);
+	}
+
+	DescriptorSetHandle RenderDevice::CreateDynamicDescriptorSet(DescriptorSetHandle                           cachedSet,
+	                                                             Vector<DescriptorSetBuilder::Bindings> const& shaderBindings) {
+		auto const isDynamic = [](DescriptorSetBuilder::Bindings const& binding) { return binding.m_IsDynamic; };
+		if (std::none_of(shaderBindings.begin(), shaderBindings.end(), isDynamic)) { return cachedSet; }
+
+		// Offsets are passed in the order of the bindings in the set
+		Vector<DescriptorSetBuilder::Bindings> dynamicBindings{};
+		std::copy_if(shaderBindings.begin(), shaderBindings.end(), std::back_inserter(dynamicBindings), isDynamic);
+		std::sort(dynamicBindings.begin(), dynamicBindings.end(), [](auto const& a, auto const& b) {
+			return a.m_Slot < b.m_Slot;
+		});
+
+		std::lock_guard lock{m_DescriptorSetMutex};
+		DescriptorSet   set = m_DescriptorSets[m_CurrFrameInFlightIdx].at(cachedSet);
+		set.m_DBHandle = AllocateHandle<DescriptorSet>();
+		set.m_Bindings = shaderBindings;
+		for (DescriptorSetBuilder::Bindings const& binding : dynamicBindings) {
+			CKE_ASSERT(binding.m_OffsetInBytes <= std::numeric_limits<u32>::max());
+			set.m_DynamicOffsets.push_back(static_cast<u32>(binding.m_OffsetInBytes));
+		}
+		m_DynamicDescriptorSets[m_CurrFrameInFlightIdx].insert({set.m_DBHandle, set});
+		return set.m_DBHandle;
+	}
+
+	void RenderDevice::InvalidateDescriptorSets(u64 resourceID) {
+		// The frames in flight can be using the sets, they are only dropped from the caches for now
+		for (auto& frameThreadSets : m_ThreadDescriptorSets) {
+			for (ThreadDescriptorSets& threadSets : frameThreadSets) {
+				std::lock_guard lock{threadSets.m_Mutex};
+				threadSets.m_Cache.InvalidateResource(resourceID, threadSets.m_SetsToFree);
+			}
+		}
+	}
+
+	void RenderDevice::FreeDroppedDescriptorSets(u32 frameIdx) {
+		for (ThreadDescriptorSets& threadSets : m_ThreadDescriptorSets[frameIdx]) {
+			std::lock_guard threadLock{threadSets.m_Mutex};
+			std::lock_guard lock{m_DescriptorSetMutex};
+			for (DescriptorSetHandle setHandle : threadSets.m_SetsToFree) {
+				auto const set = m_DescriptorSets[frameIdx].find(setHandle);
+				CKE_ASSERT(set != m_DescriptorSets[frameIdx].end());
+				threadSets.m_PoolNumSets[set->second.m_PoolIdx]--;
+				m_DescriptorSets[frameIdx].erase(set);
+			}
+			threadSets.m_SetsToFree.clear();
+		}
+	}
+
+	DescriptorSet const* RenderDevice::GetDescriptorSet(DescriptorSetHandle handle) {
+		std::lock_guard lock{m_DescriptorSetMutex};
+		for (auto const* pSets : {&m_DescriptorSets[m_CurrFrameInFlightIdx], &m_DynamicDescriptorSets[m_CurrFrameInFlightIdx]}) {
+			auto const it = pSets->find(handle);
+			if (it != pSets->end()) { return &it->second; }
+		}
+		return nullptr;
+	}
+
+	u64 RenderDevice::GetNumDescriptorSets() {
+		std::lock_guard lock{m_DescriptorSetMutex};
+		u64             numSets = 0;
+		for (auto const& descriptorSets : m_DescriptorSets) { numSets += descriptorSets.size(); }
+		return numSets;
+	}
+
+	u64 RenderDevice::GetNumDescriptorPools() {
+		u64 numPools = 0;
+		for (auto& frameThreadSets : m_ThreadDescriptorSets) {
+			for (ThreadDescriptorSets& threadSets : frameThreadSets) {
+				std::lock_guard lock{threadSets.m_Mutex};
+				numPools += threadSets.m_PoolNumSets.size();
+			}
+		}
+		return numPools;
+	}
+
+	DescriptorSetBuilder::DescriptorSetBuilder() {
+		// We assume that most descriptors will have less than 7 bindings
+		// so we reserve this to avoid constant re-allocations
+		m_Bindings.reserve(7);
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindUniformBuffer(u32 slot, BufferHandle buffer) {
+		return BindUniformBuffer(slot, BufferRange{buffer});
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindUniformBuffer(u32 slot, BufferRange range) {
+		Bindings b{
+			.m_Type = ShaderBindingType::UniformBuffer,
+			.m_Slot = slot,
+			.m_ResourceID1 = range.m_Buffer.m_Value,
+			.m_OffsetInBytes = range.m_OffsetInBytes,
+			.m_SizeInBytes = range.m_SizeInBytes
+		};
+		m_Bindings.emplace_back(b);
+		return *this;
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindStorageBuffer(u32 slot, BufferHandle buffer) {
+		return BindStorageBuffer(slot, BufferRange{buffer});
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindStorageBuffer(u32 slot, BufferRange range) {
+		Bindings b{
+			.m_Type = ShaderBindingType::StorageBuffer,
+			.m_Slot = slot,
+			.m_ResourceID1 = range.m_Buffer.m_Value,
+			.m_OffsetInBytes = range.m_OffsetInBytes,
+			.m_SizeInBytes = range.m_SizeInBytes
+		};
+		m_Bindings.emplace_back(b);
+		return *this;
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindDynamicUniformBuffer(u32 slot, BufferRange range) {
+		// The set is written with the size of the first range, every range bound with it must have it
+		CKE_ASSERT(range.m_SizeInBytes > 0);
+		BindUniformBuffer(slot, range);
+		m_Bindings.back().m_IsDynamic = true;
+		return *this;
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindDynamicStorageBuffer(u32 slot, BufferRange range) {
+		BindStorageBuffer(slot, range);
+		m_Bindings.back().m_IsDynamic = true;
+		return *this;
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindTextureWithSampler(
+		u32 slot, TextureViewHandle textureView, SamplerHandle sampler) {
+		CKE_ASSERT(textureView.IsValid());
+		CKE_ASSERT(sampler.IsValid());
+		Bindings b{};
+		b.m_Type = ShaderBindingType::ImageViewSampler;
+		b.m_Slot = slot;
+		b.m_ResourceID1 = textureView.m_Value;
+		b.m_ResourceID2 = sampler.m_Value;
+		m_Bindings.emplace_back(b);
+		return *this;
+	}
+
+	DescriptorSetHandle DescriptorSetBuilder::Build() {
+		return m_pDevice->CreateDescriptorSetForFrame(m_PipelineHandle, m_SetIndex, m_ThreadIdx, m_Bindings, false);
+	}
+
+	DescriptorSetHandle DescriptorSetBuilder::BuildPersistent() {
+		return m_pDevice->CreateDescriptorSetForFrame(m_PipelineHandle, m_SetIndex, m_ThreadIdx, m_Bindings, true);
+	}
+
+	// Utils
+	//-----------------------------------------------------------------------------
+
+	u32 RenderDevice::GetFrameIdx() {
+		return m_CurrFrameInFlightIdx;
+	}
+
+	TextureHandle RenderDevice::GetBackBuffer() {
+		return m_BackBuffers[m_CurrBackBufferIdx];
+	}
+
+	TextureViewHandle RenderDevice::GetBackBufferView() {
+		return m_BackBufferViews[m_CurrBackBufferIdx];
+	}
+
+	TextureDesc RenderDevice::GetBackBufferDesc() {
+		return m_BackBufferDesc;
+	}
+
+	UInt2 RenderDevice::GetBackBufferSize() const {
+		return {m_BackBufferDesc.m_Size.x, m_BackBufferDesc.m_Size.y};
+	}
+
+	UInt3 RenderDevice::GetBackBufferSize3() const {
+		return {m_BackBufferDesc.m_Size.x, m_BackBufferDesc.m_Size.y, 1};
+	}
+
+	void RenderDevice::RecordBackBufferResized(Int2 newSize) {
+		m_BackBufferResized = true;
+		m_NewBackBufferSize = newSize;
+	}
+
+	void RenderDevice::CreateBackBuffers(Int2 size) {
+		m_BackBufferDesc = TextureDesc{};
+		m_BackBufferDesc.m_Format = TextureFormat::B8G8R8A8_SRGB;
+		m_BackBufferDesc.m_Usage = TextureUsage::Color_Attachment | TextureUsage::Sampled;
+		m_BackBufferDesc.m_Size = UInt3{size.x, size.y, 1};
+		m_BackBufferDesc.m_DebugName = DebugString{"BackBuffer"};
+
+		// Same amount of images a swapchain usually has, one more than frames in flight
+		for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT + 1; ++i) {
+			TextureHandle const backBuffer = CreateTexture(m_BackBufferDesc);
+			m_BackBuffers.push_back(backBuffer);
+			m_BackBufferViews.push_back(CreateTextureView(TextureViewDesc{
+				backBuffer, TextureViewType::Tex2D, TextureAspectMask::Color, m_BackBufferDesc.m_Format, 0, 1, 0, 1
+			}));
+		}
+		m_CurrBackBufferIdx = 0;
+	}
+
+	void RenderDevice::DestroyBackBuffers() {
+		for (TextureHandle backBuffer : m_BackBuffers) { DestroyTexture(backBuffer); }
+		m_BackBuffers.clear();
+		m_BackBufferViews.clear();
+	}
+}
+
+namespace CKE {
+	void PipelineLayoutDesc::SetShaderBindings(Vector<ShaderBinding> const& bindings) {
+		m_ShaderBindings = bindings;
+	}
+
+	void VertexInputLayoutDesc::SetVertexInput(Vector<VertexInputInfo> const& vertexInput) {
+		for (VertexInputInfo input : vertexInput) {
+			VertexInputInfo attr{};
+			attr.m_Type = input.m_Type;
+			switch (input.m_Type) {
+			case VertexInputFormat::Float_R32G32B32: attr.m_ByteSize = 12; break;
+			case VertexInputFormat::Float_R32G32: attr.m_ByteSize = 8; break;
+			case VertexInputFormat::UInt:
+			case VertexInputFormat::Int: attr.m_ByteSize = 4; break;
+			}
+			m_Stride += attr.m_ByteSize;
+			m_VertexInput.emplace_back(attr);
+		}
+	}
+}
@@ -3,6 +3,11 @@
 #include "Vulkan/CommandList_Impl_Vk.h"
 #include "Vulkan/RenderDevice_Impl_Vk.h"
 
+#elif defined(CKE_GRAPHICS_NULL_BACKEND)
+
+#include "Null/CommandList_Impl_Null.h"
+#include "Null/RenderDevice_Impl_Null.h"
+
 #else
 
 #endif
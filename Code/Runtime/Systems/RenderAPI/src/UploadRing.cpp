@@ -0,0 +1,162 @@
+#include "CookieKat/Systems/RenderAPI/UploadRing.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+#include "CookieKat/Core/Logging/LoggingSystem.h"
+#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+
+#include <cstring>
+
+namespace CKE {
+	namespace {
+		inline u64 AlignOffset(u64 offset, u64 alignment) {
+			return (offset + alignment - 1) / alignment * alignment;
+		}
+	}
+
+	void UploadRingAllocator::Initialize(u64 capacityInBytes) {
+		CKE_ASSERT(capacityInBytes > 0);
+		m_Capacity = capacityInBytes;
+		m_Head = 0;
+		m_Tail = 0;
+		m_UsedBytes = 0;
+		m_FrameBytes = 0;
+		m_FramesInFlight = {};
+	}
+
+	bool UploadRingAllocator::TryAllocate(u64 sizeInBytes, u64 alignment, u64& offsetInBytes) {
+		CKE_ASSERT(alignment > 0);
+		if (m_UsedBytes == m_Capacity) { return false; }
+
+		// Nothing is alive, start over so the allocations don't have to wrap
+		if (m_UsedBytes == 0) {
+			m_Head = 0;
+			m_Tail = 0;
+		}
+
+		u64 offset = AlignOffset(m_Head, alignment);
+		if (m_Head >= m_Tail) {
+			// Free from the head to the end and from the start to the tail, the end is skipped when wrapping
+			if (offset + sizeInBytes > m_Capacity) {
+				if (sizeInBytes > m_Tail) { return false; }
+				offset = 0;
+			}
+		}
+		else if (offset + sizeInBytes > m_Tail) { return false; }
+
+		u64 const usedBytes = offset >= m_Head ? offset - m_Head + sizeInBytes : m_Capacity - m_Head + sizeInBytes;
+		m_UsedBytes += usedBytes;
+		m_FrameBytes += usedBytes;
+		m_Head = offset + sizeInBytes;
+		offsetInBytes = offset;
+		return true;
+	}
+
+	void UploadRingAllocator::EndFrame(u64 fenceValue) {
+		if (m_FrameBytes == 0) { return; }
+
+		CKE_ASSERT(m_FramesInFlight.empty() || m_FramesInFlight.back().m_FenceValue < fenceValue);
+		m_FramesInFlight.push(FrameInFlight{fenceValue, m_Head, m_FrameBytes});
+		m_FrameBytes = 0;
+	}
+
+	void UploadRingAllocator::Retire(u64 completedFenceValue) {
+		while (!m_FramesInFlight.empty() && m_FramesInFlight.front().m_FenceValue <= completedFenceValue) {
+			FrameInFlight const& frame = m_FramesInFlight.front();
+			m_Tail = frame.m_EndOffset;
+			m_UsedBytes -= frame.m_SizeInBytes;
+			m_FramesInFlight.pop();
+		}
+	}
+
+	//-----------------------------------------------------------------------------
+
+	void UploadRing::Initialize(RenderDevice* pDevice, u64 sizeInBytes, BufferUsageFlags usage, DebugString debugName) {
+		CKE_ASSERT(pDevice != nullptr);
+		m_pDevice = pDevice;
+
+		BufferDesc desc{};
+		desc.m_DebugName = debugName;
+		desc.m_Usage = usage;
+		desc.m_MemoryAccess = MemoryAccess::CPU_GPU_Coherent;
+		desc.m_DuplicationStrategy = DuplicationStrategy::Unique;
+		desc.m_SizeInBytes = sizeInBytes;
+		m_Buffer = pDevice->CreateBuffer(desc);
+		m_pMappedData = static_cast<u8*>(pDevice->MapBuffer(m_Buffer));
+
+		m_Allocator.Initialize(sizeInBytes);
+		m_PendingFrames.clear();
+		m_FrameFence = FenceHandle{};
+		m_FrameNumber = 0;
+		m_FrameUploadBytes = 0;
+	}
+
+	void UploadRing::Shutdown() {
+		m_pDevice->UnMapBuffer(m_Buffer);
+		m_pDevice->DestroyBuffer(m_Buffer);
+		m_Buffer = BufferHandle{};
+		m_pMappedData = nullptr;
+	}
+
+	void UploadRing::BeginFrame(FenceHandle frameFence) {
+		CKE_ASSERT(!m_FrameFence.IsValid()); // The previous frame didn't end
+		CKE_ASSERT(frameFence.IsValid());
+
+		// Queue submissions finish in order, a done frame means all the older ones are too
+		u64 completedFenceValue = 0;
+		for (PendingFrame const& frame : m_PendingFrames) {
+			if (frame.m_Fence == frameFence || m_pDevice->IsFenceSignaled(frame.m_Fence)) {
+				completedFenceValue = frame.m_FenceValue;
+			}
+		}
+		RetireFrames(completedFenceValue);
+
+		m_FrameFence = frameFence;
+		++m_FrameNumber;
+		m_FrameUploadBytes = 0;
+	}
+
+	void UploadRing::EndFrame() {
+		CKE_ASSERT(m_FrameFence.IsValid());
+		if (m_Allocator.GetFrameBytes() > 0) {
+			m_Allocator.EndFrame(m_FrameNumber);
+			m_PendingFrames.push_back(PendingFrame{m_FrameNumber, m_FrameFence});
+		}
+		m_FrameFence = FenceHandle{};
+	}
+
+	UploadAllocation UploadRing::Allocate(u64 sizeInBytes, u64 alignment) {
+		CKE_ASSERT(m_FrameFence.IsValid()); // Allocations happen between BeginFrame and EndFrame
+
+		u64 offset = 0;
+		while (!m_Allocator.TryAllocate(sizeInBytes, alignment, offset)) {
+			if (m_PendingFrames.empty()) {
+				CKE_LOG(Error, Rendering, "Upload ring is out of memory, {} bytes requested of {}",
+				        sizeInBytes, m_Allocator.GetCapacity());
+				return UploadAllocation{};
+			}
+
+			PendingFrame const oldestFrame = m_PendingFrames.front();
+			m_pDevice->WaitForFence(oldestFrame.m_Fence);
+			RetireFrames(oldestFrame.m_FenceValue);
+		}
+
+		m_FrameUploadBytes += sizeInBytes;
+		return UploadAllocation{m_Buffer, offset, sizeInBytes, m_pMappedData + offset};
+	}
+
+	UploadAllocation UploadRing::Upload(void const* pData, u64 sizeInBytes, u64 alignment) {
+		UploadAllocation const allocation = Allocate(sizeInBytes, alignment);
+		if (allocation.IsValid()) { std::memcpy(allocation.m_pData, pData, sizeInBytes); }
+		return allocation;
+	}
+
+	void UploadRing::RetireFrames(u64 completedFenceValue) {
+		m_Allocator.Retire(completedFenceValue);
+
+		u64 numRetired = 0;
+		while (numRetired < m_PendingFrames.size() && m_PendingFrames[numRetired].m_FenceValue <= completedFenceValue) {
+			++numRetired;
+		}
+		m_PendingFrames.erase(m_PendingFrames.begin(), m_PendingFrames.begin() + numRetired);
+	}
+}
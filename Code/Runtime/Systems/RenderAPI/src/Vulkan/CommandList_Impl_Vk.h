@@ -25,6 +25,53 @@ namespace CKE {
 		VK_CHECK_CALL(vkEndCommandBuffer(m_CmdBuffer));
 	}
 
+	void CommandList::BeginSecondary(RenderingInfo const& renderingInfo) {
+		vkResetCommandBuffer(m_CmdBuffer, 0);
+
+		Vector<VkFormat> colorFormats{};
+		for (RenderingAttachment const& attach : renderingInfo.m_ColorAttachments) {
+			colorFormats.push_back(m_pDevice->m_ResourcesDB.GetTextureView(attach.m_TextureView)->m_vkFormat);
+		}
+		VkFormat const depthFormat = renderingInfo.m_UseDepthAttachment
+			                             ? m_pDevice->m_ResourcesDB.GetTextureView(
+				                             renderingInfo.m_DepthAttachment.m_TextureView)->m_vkFormat
+			                             : VK_FORMAT_UNDEFINED;
+
+		VkCommandBufferInheritanceRenderingInfo inheritanceRendering{
+			.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO,
+			.flags = 0,
+			.viewMask = 0,
+			.colorAttachmentCount = u32(colorFormats.size()),
+			.pColorAttachmentFormats = colorFormats.data(),
+			.depthAttachmentFormat = depthFormat,
+			.stencilAttachmentFormat = depthFormat, // Same as BeginRendering(...), the depth view has the stencil
+			.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT,
+		};
+
+		VkCommandBufferInheritanceInfo inheritanceInfo{};
+		inheritanceInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+		inheritanceInfo.pNext = &inheritanceRendering;
+
+		VkCommandBufferBeginInfo commandBufferBeginInfo{};
+		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT |
+				VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+		commandBufferBeginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		VK_CHECK_CALL(vkBeginCommandBuffer(m_CmdBuffer, &commandBufferBeginInfo));
+	}
+
+	void CommandList::ExecuteCommands(Vector<CommandList> const& secondaryCmdLists) {
+		if (secondaryCmdLists.empty()) { return; }
+
+		Vector<VkCommandBuffer> cmdBuffers{};
+		cmdBuffers.reserve(secondaryCmdLists.size());
+		for (CommandList const& cmdList : secondaryCmdLists) {
+			cmdBuffers.push_back(cmdList.m_CmdBuffer);
+		}
+		vkCmdExecuteCommands(m_CmdBuffer, u32(cmdBuffers.size()), cmdBuffers.data());
+	}
+
 	void CommandList::BeginDebugLabel(const char* pName, Vec3 color) {
 		VkDebugUtilsLabelEXT info{};
 		info.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
@@ -36,7 +83,8 @@ namespace CKE {
 		pfnCmdBeginDebugUtilsLabelEXT(m_CmdBuffer, &info);
 	}
 
-	inline CommandList::CommandList(RenderDevice* pRenderDevice, VkCommandBuffer cmdBuffer) { }
+	inline CommandList::CommandList(RenderDevice* pRenderDevice, VkCommandBuffer cmdBuffer)
+		: m_pDevice{pRenderDevice}, m_CmdBuffer{cmdBuffer} { }
 
 	void CommandList::BeginRendering(RenderingInfo renderingInfo) {
 		Vector<VkRenderingAttachmentInfo> vkColAttach{};
@@ -77,7 +125,9 @@ namespace CKE {
 		// Render Info
 		VkRenderingInfo vkRenderingInfo{
 			.sType = VK_STRUCTURE_TYPE_RENDERING_INFO,
-			.flags = 0,
+			.flags = renderingInfo.m_ContentsInSecondaryCmdLists
+				         ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT
+				         : VkRenderingFlags{0},
 			.renderArea = VkRect2D{
 				.offset = VkOffset2D{0, 0}, .extent = {renderingInfo.m_RenderArea.x, renderingInfo.m_RenderArea.y}
 			},
@@ -163,11 +213,18 @@ namespace CKE {
 	void CommandList::BindDescriptor(PipelineHandle pipeline, DescriptorSetHandle descriptorSet) {
 		Pipeline*       pPipeline = m_pDevice->m_ResourcesDB.GetPipeline(pipeline);
 		PipelineLayout* layout = m_pDevice->m_ResourcesDB.GetPipelineLayout(pPipeline->m_PipelineLayout);
-		DescriptorSet&  descriptorSets = m_pDevice->m_ResourcesDB.GetDescriptorSet(descriptorSet, m_pDevice->m_CurrFrameInFlightIdx);
+
+		// Other recording threads could be adding sets to the DB
+		DescriptorSet descriptorSets{};
+		{
+			std::lock_guard lock{m_pDevice->m_DescriptorSetMutex};
+			descriptorSets = m_pDevice->m_ResourcesDB.GetDescriptorSet(descriptorSet, m_pDevice->m_CurrFrameInFlightIdx);
+		}
 		vkCmdBindDescriptorSets(m_CmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
 		                        layout->m_vkPipelineLayout,
 		                        descriptorSets.m_LayoutIndex, 1,
-		                        &descriptorSets.m_DescriptorSet, 0, 0);
+		                        &descriptorSets.m_DescriptorSet,
+		                        descriptorSets.m_NumDynamicOffsets, descriptorSets.m_DynamicOffsets.data());
 	}
 
 	void CommandList::PushConstant(PipelineHandle pipeline, u64 dataSize, void* data) {
@@ -304,7 +361,8 @@ namespace CKE {
 		vkCmdBindDescriptorSets(m_CmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE,
 		                        layout->m_vkPipelineLayout,
 		                        descriptorSets.m_LayoutIndex, 1,
-		                        &descriptorSets.m_DescriptorSet, 0, 0);
+		                        &descriptorSets.m_DescriptorSet,
+		                        descriptorSets.m_NumDynamicOffsets, descriptorSets.m_DynamicOffsets.data());
 	}
 
 	void CommandList::SetComputePipeline(PipelineHandle pipeline) {
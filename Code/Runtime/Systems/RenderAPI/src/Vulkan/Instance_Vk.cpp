@@ -1,3 +1,5 @@
+#ifdef CKE_GRAPHICS_VULKAN_BACKEND
+
 #include "CookieKat/Core/Platform/PrimitiveTypes.h"
 #include "CookieKat/Core/Containers/String.h"
 
@@ -439,42 +441,57 @@ namespace CKE {
 		for (auto& [handle, frameData] : m_da) {
 			frameData.m_DescriptorSets.clear();
 		}
+	}
+
+	void FrameData::Destroy(RenderDevice& device) { }
 
+	void CommandBufferManager::ResetForNewFrame() {
 		m_LastCmdIdxGraphics = 0;
 		m_LastCmdIdxTransfer = 0;
 		m_LastCmdIdxCompute = 0;
+		for (auto& threadData : m_ThreadCommandBuffers) {
+			threadData.m_LastSecondaryCmdIdxGraphics = 0;
+		}
 	}
 
-	void FrameData::Destroy(RenderDevice& device) { }
-
-	VkCommandBuffer FrameData::GetNextCmdBuffer(QueueType type) {
+	VkCommandBuffer CommandBufferManager::GetNextCmdBuffer(QueueType type) {
 		switch (type) {
-		case QueueType::Graphics: return GetNextGraphicsCmdBuffer();
-		case QueueType::Transfer: return GetNextTransferCmdBuffer();
-		case QueueType::Compute: return GetNextComputeCmdBuffer();
+		case QueueType::Graphics: return GetNextGraphics();
+		case QueueType::Transfer: return GetNextTransfer();
+		case QueueType::Compute: return GetNextCompute();
 		default: CKE_UNREACHABLE_CODE();
 		}
 		return (VkCommandBuffer)0;
 	}
 
-	VkCommandBuffer FrameData::GetNextGraphicsCmdBuffer() {
+	VkCommandBuffer CommandBufferManager::GetNextGraphics() {
 		CKE_ASSERT(m_LastCmdIdxGraphics < m_GraphicsCommandBuffer.size());
 		VkCommandBuffer cmdBuff = m_GraphicsCommandBuffer[m_LastCmdIdxGraphics];
 		m_LastCmdIdxGraphics++;
 		return cmdBuff;
 	}
 
-	VkCommandBuffer FrameData::GetNextTransferCmdBuffer() {
+	VkCommandBuffer CommandBufferManager::GetNextSecondaryGraphics(u32 threadIdx) {
+		auto& threadData = m_ThreadCommandBuffers[threadIdx];
+		CKE_ASSERT(threadData.m_LastSecondaryCmdIdxGraphics < threadData.m_SecondaryGraphicsCommandBuffer.size());
+		VkCommandBuffer cmdBuff = threadData.m_SecondaryGraphicsCommandBuffer[threadData.m_LastSecondaryCmdIdxGraphics];
+		threadData.m_LastSecondaryCmdIdxGraphics++;
+		return cmdBuff;
+	}
+
+	VkCommandBuffer CommandBufferManager::GetNextTransfer() {
 		CKE_ASSERT(m_LastCmdIdxTransfer < m_TransferCommandBuffer.size());
 		VkCommandBuffer cmdBuff = m_TransferCommandBuffer[m_LastCmdIdxTransfer];
 		m_LastCmdIdxTransfer++;
 		return cmdBuff;
 	}
 
-	VkCommandBuffer FrameData::GetNextComputeCmdBuffer() {
+	VkCommandBuffer CommandBufferManager::GetNextCompute() {
 		CKE_ASSERT(m_LastCmdIdxCompute < m_ComputeCommandBuffer.size());
 		VkCommandBuffer cmdBuff = m_ComputeCommandBuffer[m_LastCmdIdxCompute];
 		m_LastCmdIdxCompute++;
 		return cmdBuff;
 	}
 }
+
+#endif
@@ -11,6 +11,7 @@
 #include <vulkan/vulkan_core.h>
 #include <algorithm>
 #include <iostream>
+#include <limits>
 #include <vk_mem_alloc.h>
 
 #define NOMINMAX
@@ -28,6 +29,7 @@ namespace CKE {
 		// Initialize allocator
 		VmaAllocatorCreateInfo allocCreateInfo{};
 		allocCreateInfo.physicalDevice = m_PhysicalDevice;
+		allocCreateInfo.device = m_Device;
 		allocCreateInfo.instance = m_RenderInstance->m_Instance;
 		allocCreateInfo.vulkanApiVersion = VK_API_VERSION_1_3;
 		VK_CHECK_CALL(vmaCreateAllocator(&allocCreateInfo, &m_Allocator));
@@ -41,6 +43,13 @@ namespace CKE {
 		// that can be queried every frame
 		CreateDefaultCommandPools();
 		CreateDefaultCommandLists();
+		CreateSecondaryCommandLists();
+
+		for (auto& frameThreadSets : m_ThreadDescriptorSets) {
+			for (ThreadDescriptorSets& threadSets : frameThreadSets) {
+				threadSets.m_Cache.Initialize(RenderSettings::DESCRIPTOR_SET_CACHE_CAPACITY);
+			}
+		}
 	}
 
 	void RenderDevice::Shutdown() {
@@ -50,6 +59,19 @@ namespace CKE {
 		//	frame.Destroy(*this);
 		//}
 
+		// The sets are freed with their pools
+		for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) {
+			for (ThreadDescriptorSets& threadSets : m_ThreadDescriptorSets[i]) {
+				threadSets.m_Cache.Clear(threadSets.m_SetsToFree);
+				for (DescriptorSetHandle set : threadSets.m_SetsToFree) {
+					m_ResourcesDB.RemoveCachedDescriptorSet(set, i);
+				}
+				threadSets.m_SetsToFree.clear();
+			}
+		}
+		DestroyCachedDescriptorPools();
+
+		DestroySecondaryCommandPools();
 		DestroyDefaultCommandPools();
 		vkDestroyDevice(m_Device, nullptr);
 
@@ -463,11 +485,11 @@ namespace CKE {
 			allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
 			allocInfo.commandBufferCount = 1;
 			if (desc.m_Type == QueueType::Graphics)
-				allocInfo.commandPool = m_FrameSyncObjects[i].m_GraphicsCommandPool;
+				allocInfo.commandPool = m_CommandBuffers[i].m_GraphicsCommandPool;
 			else if (desc.m_Type == QueueType::Transfer)
-				allocInfo.commandPool = m_FrameSyncObjects[i].m_TransferCommandPool;
+				allocInfo.commandPool = m_CommandBuffers[i].m_TransferCommandPool;
 			else if (desc.m_Type == QueueType::Compute) {
-				allocInfo.commandPool = m_FrameSyncObjects[i].m_ComputeCommandPool;
+				allocInfo.commandPool = m_CommandBuffers[i].m_ComputeCommandPool;
 			}
 
 			if (vkAllocateCommandBuffers(m_Device, &allocInfo, &tempBuffer[i]) != VK_SUCCESS) {
@@ -478,11 +500,11 @@ namespace CKE {
 		// Copy them to their final place
 		for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) {
 			if (desc.m_Type == QueueType::Graphics)
-				m_FrameSyncObjects[i].m_GraphicsCommandBuffer.push_back(tempBuffer[i]);
+				m_CommandBuffers[i].m_GraphicsCommandBuffer.push_back(tempBuffer[i]);
 			else if (desc.m_Type == QueueType::Transfer)
-				m_FrameSyncObjects[i].m_TransferCommandBuffer.push_back(tempBuffer[i]);
+				m_CommandBuffers[i].m_TransferCommandBuffer.push_back(tempBuffer[i]);
 			else if (desc.m_Type == QueueType::Compute)
-				m_FrameSyncObjects[i].m_ComputeCommandBuffer.push_back(tempBuffer[i]);
+				m_CommandBuffers[i].m_ComputeCommandBuffer.push_back(tempBuffer[i]);
 		}
 	}
 
@@ -527,9 +549,19 @@ namespace CKE {
 		bufferInfo.queueFamilyIndexCount = familyIndicesCount;
 		bufferInfo.pQueueFamilyIndices = familyIndices.data();
 
+		// CPU visible buffers are mapped for as long as they live
 		VmaAllocationCreateInfo allocInfo{};
 		allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
-		VK_CHECK_CALL(vmaCreateBuffer(m_Allocator, &bufferInfo, &allocInfo, &pBuffer->m_vkBuffer, &pBuffer->m_vmaAllocation, nullptr));
+		if (bufferDesc.m_MemoryAccess == MemoryAccess::CPU_GPU_Coherent) {
+			allocInfo.usage = VMA_MEMORY_USAGE_CPU_TO_GPU;
+			allocInfo.requiredFlags = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+			allocInfo.flags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		}
+
+		VmaAllocationInfo allocationInfo{};
+		VK_CHECK_CALL(vmaCreateBuffer(m_Allocator, &bufferInfo, &allocInfo, &pBuffer->m_vkBuffer, &pBuffer->m_vmaAllocation,
+		                              &allocationInfo));
+		pBuffer->m_pMappedAddress = allocationInfo.pMappedData;
 
 		SetObjectDebugName(reinterpret_cast<u64>(pBuffer->m_vkBuffer), VK_OBJECT_TYPE_BUFFER, bufferDesc.m_DebugName.GetStr());
 	}
@@ -584,6 +616,8 @@ namespace CKE {
 	}
 
 	void RenderDevice::DestroyBuffer(BufferHandle bufferHandle) {
+		InvalidateDescriptorSets(bufferHandle.m_Value);
+
 		bool                isPerFrame = false;
 		FrameArray<Buffer*> buffers = m_ResourcesDB.GetBuffer(bufferHandle, isPerFrame);
 
@@ -601,14 +635,12 @@ namespace CKE {
 
 	void* RenderDevice::MapBuffer(BufferHandle bufferHandle) {
 		Buffer* pBuffer = m_ResourcesDB.GetBuffer(bufferHandle);
-		vmaMapMemory(m_Allocator, pBuffer->m_vmaAllocation, &pBuffer->m_pMappedAddress);
+		CKE_ASSERT(pBuffer->m_pMappedAddress != nullptr); // Only CPU visible buffers can be mapped
 		return pBuffer->m_pMappedAddress;
 	}
 
 	void RenderDevice::UnMapBuffer(BufferHandle bufferHandle) {
-		Buffer* pBuffer = m_ResourcesDB.GetBuffer(bufferHandle);
-		vmaUnmapMemory(m_Allocator, pBuffer->m_vmaAllocation);
-		pBuffer->m_pMappedAddress = nullptr;
+		// The memory stays mapped until the buffer is destroyed
 	}
 
 	TextureViewHandle RenderDevice::CreateTextureView(TextureViewDesc desc) {
@@ -630,6 +662,7 @@ namespace CKE {
 
 		pTex->m_ExistingViews.push_back(pTexView->m_DBHandle);
 		pTexView->m_Texture = desc.m_Texture;
+		pTexView->m_vkFormat = viewInfo.format;
 		return pTexView->m_DBHandle;
 	}
 
@@ -638,6 +671,7 @@ namespace CKE {
 
 		// Destroy all of the texture views if there are any left
 		for (TextureViewHandle viewHandle : pTex->m_ExistingViews) {
+			InvalidateDescriptorSets(viewHandle.m_Value);
 			TextureView* textureView = m_ResourcesDB.GetTextureView(viewHandle);
 			vkDestroyImageView(m_Device, textureView->m_vkView, nullptr);
 			m_ResourcesDB.RemoveTextureView(viewHandle);
@@ -647,10 +681,74 @@ namespace CKE {
 		m_ResourcesDB.RemoveTexture(textureHandle);
 	}
 
+	MemoryRequirements RenderDevice::GetTextureMemoryRequirements(TextureDesc const& desc) {
+		Array<u32, 3>     familyIndices{};
+		VkImageCreateInfo imageInfo{};
+		FillImageCreateInfo(desc, familyIndices, imageInfo);
+
+		VkDeviceImageMemoryRequirements requirementsInfo{};
+		requirementsInfo.sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+		requirementsInfo.pCreateInfo = &imageInfo;
+		VkMemoryRequirements2 requirements{};
+		requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+		vkGetDeviceImageMemoryRequirements(m_Device, &requirementsInfo, &requirements);
+
+		MemoryRequirements memoryRequirements{};
+		memoryRequirements.m_SizeInBytes = requirements.memoryRequirements.size;
+		memoryRequirements.m_Alignment = requirements.memoryRequirements.alignment;
+		memoryRequirements.m_MemoryTypeBits = requirements.memoryRequirements.memoryTypeBits;
+		return memoryRequirements;
+	}
+
+	MemoryHeapHandle RenderDevice::CreateMemoryHeap(MemoryRequirements const& requirements) {
+		MemoryHeap* pHeap = m_ResourcesDB.CreateMemoryHeap();
+
+		VkMemoryRequirements vkRequirements{};
+		vkRequirements.size = requirements.m_SizeInBytes;
+		vkRequirements.alignment = requirements.m_Alignment;
+		vkRequirements.memoryTypeBits = requirements.m_MemoryTypeBits;
+
+		VmaAllocationCreateInfo allocInfo{};
+		allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+		allocInfo.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+
+		VK_CHECK_CALL(vmaAllocateMemory(m_Allocator, &vkRequirements, &allocInfo, &pHeap->m_vmaAllocation, nullptr));
+		pHeap->m_SizeInBytes = requirements.m_SizeInBytes;
+		return pHeap->m_DBHandle;
+	}
+
+	void RenderDevice::DestroyMemoryHeap(MemoryHeapHandle heapHandle) {
+		MemoryHeap* pHeap = m_ResourcesDB.GetMemoryHeap(heapHandle);
+		vmaFreeMemory(m_Allocator, pHeap->m_vmaAllocation);
+		m_ResourcesDB.RemoveMemoryHeap(heapHandle);
+	}
+
+	TextureHandle RenderDevice::CreatePlacedTexture(TextureDesc desc, MemoryHeapHandle heapHandle, u64 offsetInBytes) {
+		MemoryHeap* pHeap = m_ResourcesDB.GetMemoryHeap(heapHandle);
+		Texture*    pTex = m_ResourcesDB.CreateTexture();
+
+		Array<u32, 3>     familyIndices{};
+		VkImageCreateInfo imageInfo{};
+		FillImageCreateInfo(desc, familyIndices, imageInfo);
+		imageInfo.flags |= VK_IMAGE_CREATE_ALIAS_BIT;
+
+		VK_CHECK_CALL(vkCreateImage(m_Device, &imageInfo, nullptr, &pTex->m_vkImage));
+		CKE_ASSERT(offsetInBytes + GetTextureMemoryRequirements(desc).m_SizeInBytes <= pHeap->m_SizeInBytes);
+		VK_CHECK_CALL(vmaBindImageMemory2(m_Allocator, pHeap->m_vmaAllocation, offsetInBytes, pTex->m_vkImage, nullptr));
+
+		// Destroying the texture only destroys the image, the memory belongs to the heap
+		pTex->m_vmaAllocation = VK_NULL_HANDLE;
+
+		SetObjectDebugName(reinterpret_cast<u64>(pTex->m_vkImage), VK_OBJECT_TYPE_IMAGE, desc.m_DebugName.GetStr());
+
+		return pTex->m_DBHandle;
+	}
+
 	void RenderDevice::DestroyTextureView(TextureViewHandle handle) {
 		TextureView* pView = m_ResourcesDB.GetTextureView(handle);
 		Texture*     pTex = m_ResourcesDB.GetTexture(pView->m_Texture);
 
+		InvalidateDescriptorSets(handle.m_Value);
 		vkDestroyImageView(m_Device, pView->m_vkView, nullptr);
 
 		// Remove handle from texture reference
@@ -671,19 +769,19 @@ namespace CKE {
 
 		for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) {
 			poolInfo.queueFamilyIndex = m_QueueFamilyIndices.GetGraphicsIdx();
-			if (vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_FrameSyncObjects[i].m_GraphicsCommandPool)
+			if (vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_CommandBuffers[i].m_GraphicsCommandPool)
 				!= VK_SUCCESS) {
 				std::cout << "Error creating command pool" << std::endl;
 			}
 
 			poolInfo.queueFamilyIndex = m_QueueFamilyIndices.GetTransferIdx();
-			if (vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_FrameSyncObjects[i].m_TransferCommandPool)
+			if (vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_CommandBuffers[i].m_TransferCommandPool)
 				!= VK_SUCCESS) {
 				std::cout << "Error creating command pool" << std::endl;
 			}
 
 			poolInfo.queueFamilyIndex = m_QueueFamilyIndices.GetComputeIdx();
-			if (vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_FrameSyncObjects[i].m_ComputeCommandPool)
+			if (vkCreateCommandPool(m_Device, &poolInfo, nullptr, &m_CommandBuffers[i].m_ComputeCommandPool)
 				!= VK_SUCCESS) {
 				std::cout << "Error creating command pool" << std::endl;
 			}
@@ -731,7 +829,9 @@ namespace CKE {
 			vkResetDescriptorPool(m_Device, pipelineFrameData.m_DescriptorPool, 0);
 		}
 		newFrameData.ResetForNewFrame();
+		m_CommandBuffers[GetFrameIdx()].ResetForNewFrame();
 		m_ResourcesDB.DestroyAllDescriptorSets(m_CurrFrameInFlightIdx);
+		FreeDroppedDescriptorSets(m_CurrFrameInFlightIdx);
 	}
 
 	void RenderDevice::Present() {
@@ -805,10 +905,12 @@ namespace CKE {
 	}
 
 	DescriptorSetBuilder
-	RenderDevice::CreateDescriptorSetBuilder(PipelineHandle p, u64 setIndex) {
+	RenderDevice::CreateDescriptorSetBuilder(PipelineHandle p, u64 setIndex, u32 threadIdx) {
+		CKE_ASSERT(threadIdx < RenderSettings::MAX_RECORDING_THREADS);
 		DescriptorSetBuilder b{};
 		b.m_PipelineHandle = p;
 		b.m_SetIndex = setIndex;
+		b.m_ThreadIdx = threadIdx;
 		b.m_pDevice = this;
 		return b;
 	}
@@ -819,14 +921,12 @@ namespace CKE {
 		return ptr;
 	}
 
-	TextureHandle RenderDevice::CreateTexture(TextureDesc desc) {
-		Texture* pTex = m_ResourcesDB.CreateTexture();
-
-		i32           familyCount = 0;
-		Array<u32, 3> familyIndices{};
+	void RenderDevice::FillImageCreateInfo(TextureDesc const& desc, Array<u32, 3>& familyIndices,
+	                                       VkImageCreateInfo& imageInfo) {
+		i32 familyCount = 0;
 		ConvertQueueFamilyFlagsToIndices(desc.m_QueueFamilies, familyIndices, familyCount);
 
-		VkImageCreateInfo imageInfo{};
+		imageInfo = VkImageCreateInfo{};
 		imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
 		imageInfo.imageType = ConversionsVk::GetVkImageType(desc.m_TextureType);
 		imageInfo.extent.width = desc.m_Size.x;
@@ -843,6 +943,14 @@ namespace CKE {
 		imageInfo.pQueueFamilyIndices = familyIndices.data();
 		imageInfo.samples = ConversionsVk::GetVkSampleCountFlags(desc.m_SampleCount);
 		imageInfo.flags = ConversionsVk::GetVkImageCreateFlags(desc.m_MiscFlags);
+	}
+
+	TextureHandle RenderDevice::CreateTexture(TextureDesc desc) {
+		Texture* pTex = m_ResourcesDB.CreateTexture();
+
+		Array<u32, 3>     familyIndices{};
+		VkImageCreateInfo imageInfo{};
+		FillImageCreateInfo(desc, familyIndices, imageInfo);
 
 		VmaAllocationCreateInfo allocInfo{};
 		allocInfo.usage = VMA_MEMORY_USAGE_GPU_ONLY;
@@ -907,6 +1015,7 @@ namespace CKE {
 
 	void RenderDevice::DestroySampler(SamplerHandle samplerHandle) {
 		TextureSampler* pSampler = m_ResourcesDB.GetTextureSampler(samplerHandle);
+		InvalidateDescriptorSets(samplerHandle.m_Value);
 		vkDestroySampler(m_Device, pSampler->m_vkSampler, nullptr);
 		m_ResourcesDB.RemoveTextureSampler(samplerHandle);
 	}
@@ -940,6 +1049,17 @@ namespace CKE {
 				vkBindings.emplace_back(vkBinding);
 			}
 
+			// Buffer bindings are dynamic, they take an offset when the set is bound in the order of their slots
+			Vector<u32>& bufferSlots = pPipelineLayout->m_BufferSlots[i];
+			for (ShaderBinding const& shaderBinding : sortedBindings[i]) {
+				if (shaderBinding.m_Type == ShaderBindingType::UniformBuffer ||
+					shaderBinding.m_Type == ShaderBindingType::StorageBuffer) {
+					bufferSlots.insert(bufferSlots.end(), shaderBinding.m_Count, shaderBinding.m_BindingPoint);
+				}
+			}
+			std::sort(bufferSlots.begin(), bufferSlots.end());
+			CKE_ASSERT(bufferSlots.size() <= RenderSettings::MAX_BUFFERS_PER_SET);
+
 			VkDescriptorSetLayoutCreateInfo layoutInfo{};
 			layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 			layoutInfo.bindingCount = static_cast<u32>(vkBindings.size());
@@ -966,6 +1086,7 @@ namespace CKE {
 
 	void RenderDevice::DestroyPipelineLayout(PipelineLayoutHandle handle) {
 		PipelineLayout* pLayout = m_ResourcesDB.GetPipelineLayout(handle);
+		InvalidateDescriptorSets(handle.m_Value);
 		vkDestroyPipelineLayout(m_Device, pLayout->m_vkPipelineLayout, nullptr);
 	}
 
@@ -1000,7 +1121,7 @@ namespace CKE {
 	}
 
 	FenceHandle RenderDevice::CreateFence(bool createSignaled) {
-		VkFenceCreateInfo createInfo;
+		VkFenceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
 		createInfo.flags = createSignaled ? VK_FENCE_CREATE_SIGNALED_BIT : 0;
 
@@ -1018,6 +1139,10 @@ namespace CKE {
 		vkWaitForFences(m_Device, 1, &m_ResourcesDB.GetFence(fence)->m_vkFence, true, UINT64_MAX);
 	}
 
+	bool RenderDevice::IsFenceSignaled(FenceHandle fence) {
+		return vkGetFenceStatus(m_Device, m_ResourcesDB.GetFence(fence)->m_vkFence) == VK_SUCCESS;
+	}
+
 	void RenderDevice::ResetFence(FenceHandle fence) {
 		vkResetFences(m_Device, 1, &m_ResourcesDB.GetFence(fence)->m_vkFence);
 	}
@@ -1027,8 +1152,13 @@ namespace CKE {
 	}
 
 	CommandList RenderDevice::GetGraphicsCmdList() {
-		FrameData&      f = GetCurrentFrameData();
-		VkCommandBuffer cmdBuff = f.GetNextGraphicsCmdBuffer();
+		VkCommandBuffer cmdBuff = m_CommandBuffers[GetFrameIdx()].GetNextGraphics();
+		return CommandList{this, cmdBuff};
+	}
+
+	CommandList RenderDevice::GetSecondaryGraphicsCmdList(u32 threadIdx) {
+		CKE_ASSERT(threadIdx < RenderSettings::MAX_RECORDING_THREADS);
+		VkCommandBuffer cmdBuff = m_CommandBuffers[GetFrameIdx()].GetNextSecondaryGraphics(threadIdx);
 		return CommandList{this, cmdBuff};
 	}
 
@@ -1039,9 +1169,9 @@ namespace CKE {
 
 	void RenderDevice::DestroyDefaultCommandPools() {
 		for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) {
-			vkDestroyCommandPool(m_Device, m_FrameSyncObjects[i].m_GraphicsCommandPool, nullptr);
-			vkDestroyCommandPool(m_Device, m_FrameSyncObjects[i].m_TransferCommandPool, nullptr);
-			vkDestroyCommandPool(m_Device, m_FrameSyncObjects[i].m_ComputeCommandPool, nullptr);
+			vkDestroyCommandPool(m_Device, m_CommandBuffers[i].m_GraphicsCommandPool, nullptr);
+			vkDestroyCommandPool(m_Device, m_CommandBuffers[i].m_TransferCommandPool, nullptr);
+			vkDestroyCommandPool(m_Device, m_CommandBuffers[i].m_ComputeCommandPool, nullptr);
 		}
 	}
 
@@ -1057,6 +1187,44 @@ namespace CKE {
 		}
 	}
 
+	void RenderDevice::CreateSecondaryCommandLists() {
+		VkCommandPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+		poolInfo.queueFamilyIndex = m_QueueFamilyIndices.GetGraphicsIdx();
+
+		// Each thread allocates from its own pool so they can record at the same time
+		for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) {
+			for (u32 t = 0; t < RenderSettings::MAX_RECORDING_THREADS; ++t) {
+				auto& threadData = m_CommandBuffers[i].m_ThreadCommandBuffers[t];
+				if (vkCreateCommandPool(m_Device, &poolInfo, nullptr, &threadData.m_GraphicsCommandPool)
+					!= VK_SUCCESS) {
+					std::cout << "Error creating command pool" << std::endl;
+				}
+
+				VkCommandBufferAllocateInfo allocInfo{};
+				allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				allocInfo.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+				allocInfo.commandPool = threadData.m_GraphicsCommandPool;
+				allocInfo.commandBufferCount = RenderSettings::SECONDARY_CMDLIST_COUNT_PERTHREAD;
+
+				threadData.m_SecondaryGraphicsCommandBuffer.resize(RenderSettings::SECONDARY_CMDLIST_COUNT_PERTHREAD);
+				if (vkAllocateCommandBuffers(m_Device, &allocInfo, threadData.m_SecondaryGraphicsCommandBuffer.data())
+					!= VK_SUCCESS) {
+					std::cout << "Error creating command buffer" << std::endl;
+				}
+			}
+		}
+	}
+
+	void RenderDevice::DestroySecondaryCommandPools() {
+		for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) {
+			for (auto& threadData : m_CommandBuffers[i].m_ThreadCommandBuffers) {
+				vkDestroyCommandPool(m_Device, threadData.m_GraphicsCommandPool, nullptr);
+			}
+		}
+	}
+
 	void RenderDevice::CreateDescriptorSetLayouts(Vector<Vector<ShaderBinding>> const& sortedBindings) { }
 
 	DescriptorSetBuilder::DescriptorSetBuilder() {
@@ -1066,25 +1234,51 @@ namespace CKE {
 	}
 
 	DescriptorSetBuilder& DescriptorSetBuilder::BindUniformBuffer(u32 slot, BufferHandle buffer) {
+		return BindUniformBuffer(slot, BufferRange{buffer});
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindUniformBuffer(u32 slot, BufferRange range) {
 		Bindings b{
 			.m_Type = ShaderBindingType::UniformBuffer,
 			.m_Slot = slot,
-			.m_ResourceID1 = buffer.m_Value
+			.m_ResourceID1 = range.m_Buffer.m_Value,
+			.m_OffsetInBytes = range.m_OffsetInBytes,
+			.m_SizeInBytes = range.m_SizeInBytes
 		};
 		m_Bindings.emplace_back(b);
 		return *this;
 	}
 
 	DescriptorSetBuilder& DescriptorSetBuilder::BindStorageBuffer(u32 slot, BufferHandle buffer) {
+		return BindStorageBuffer(slot, BufferRange{buffer});
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindStorageBuffer(u32 slot, BufferRange range) {
 		Bindings b{
 			.m_Type = ShaderBindingType::StorageBuffer,
 			.m_Slot = slot,
-			.m_ResourceID1 = buffer.m_Value
+			.m_ResourceID1 = range.m_Buffer.m_Value,
+			.m_OffsetInBytes = range.m_OffsetInBytes,
+			.m_SizeInBytes = range.m_SizeInBytes
 		};
 		m_Bindings.emplace_back(b);
 		return *this;
 	}
 
+	DescriptorSetBuilder& DescriptorSetBuilder::BindDynamicUniformBuffer(u32 slot, BufferRange range) {
+		// The set is written with the size of the first range, every range bound with it must have it
+		CKE_ASSERT(range.m_SizeInBytes > 0);
+		BindUniformBuffer(slot, range);
+		m_Bindings.back().m_IsDynamic = true;
+		return *this;
+	}
+
+	DescriptorSetBuilder& DescriptorSetBuilder::BindDynamicStorageBuffer(u32 slot, BufferRange range) {
+		BindStorageBuffer(slot, range);
+		m_Bindings.back().m_IsDynamic = true;
+		return *this;
+	}
+
 	DescriptorSetBuilder& DescriptorSetBuilder::BindTextureWithSampler(
 		u32 slot, TextureViewHandle textureView, SamplerHandle sampler) {
 		CKE_ASSERT(textureView.IsValid());
@@ -1099,7 +1293,106 @@ namespace CKE {
 	}
 
 	DescriptorSetHandle DescriptorSetBuilder::Build() {
-		return m_pDevice->CreateDescriptorSetForFrame(m_PipelineHandle, m_SetIndex, m_Bindings);
+		return m_pDevice->CreateDescriptorSetForFrame(m_PipelineHandle, m_SetIndex, m_ThreadIdx, m_Bindings, false);
+	}
+
+	DescriptorSetHandle DescriptorSetBuilder::BuildPersistent() {
+		return m_pDevice->CreateDescriptorSetForFrame(m_PipelineHandle, m_SetIndex, m_ThreadIdx, m_Bindings, true);
+	}
+
+	DescriptorSetCacheStats RenderDevice::GetDescriptorSetCacheStats() {
+		DescriptorSetCacheStats stats{};
+		for (auto& frameThreadSets : m_ThreadDescriptorSets) {
+			for (ThreadDescriptorSets& threadSets : frameThreadSets) {
+				std::lock_guard lock{threadSets.m_Mutex};
+				stats.m_Hits += threadSets.m_Cache.GetStats().m_Hits;
+				stats.m_Misses += threadSets.m_Cache.GetStats().m_Misses;
+				stats.m_Evictions += threadSets.m_Cache.GetStats().m_Evictions;
+			}
+		}
+		return stats;
+	}
+
+	VkDescriptorSet RenderDevice::AllocateCachedDescriptorSet(Vector<VkDescriptorPool>& pools,
+	                                                          Vector<u32>&              poolNumSets,
+	                                                          VkDescriptorSetLayout     layout,
+	                                                          u32&                      outPoolIdx) {
+		VkDescriptorSetAllocateInfo allocInfo{};
+		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocInfo.descriptorSetCount = 1;
+		allocInfo.pSetLayouts = &layout;
+
+		// Newest pool with room first, freed sets leave room in the older ones.
+		// Full pools are skipped, a pool with room can still run out of descriptors or be fragmented.
+		VkDescriptorSet vkSet{};
+		for (u32 poolIdx = static_cast<u32>(pools.size()); poolIdx-- > 0;) {
+			if (poolNumSets[poolIdx] >= RenderSettings::DESCRIPTOR_SETS_PER_POOL) { continue; }
+			allocInfo.descriptorPool = pools[poolIdx];
+			VkResult const result = vkAllocateDescriptorSets(m_Device, &allocInfo, &vkSet);
+			if (result == VK_SUCCESS) {
+				poolNumSets[poolIdx]++;
+				outPoolIdx = poolIdx;
+				return vkSet;
+			}
+			CKE_ASSERT(result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL);
+		}
+
+		// All of them are full, a few bindings of each type per set
+		u32 const                      maxSets = RenderSettings::DESCRIPTOR_SETS_PER_POOL;
+		Array<VkDescriptorPoolSize, 3> poolSizes{};
+		poolSizes[0] = {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 4 * maxSets};
+		poolSizes[1] = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 4 * maxSets};
+		poolSizes[2] = {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 * maxSets};
+
+		VkDescriptorPoolCreateInfo poolInfo{};
+		poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		poolInfo.poolSizeCount = static_cast<u32>(poolSizes.size());
+		poolInfo.pPoolSizes = poolSizes.data();
+		poolInfo.maxSets = maxSets;
+		poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT; // Dropped sets are freed one by one
+
+		VkDescriptorPool& newPool = pools.emplace_back();
+		VK_CHECK_CALL(vkCreateDescriptorPool(m_Device, &poolInfo, nullptr, &newPool));
+		allocInfo.descriptorPool = newPool;
+		VK_CHECK_CALL(vkAllocateDescriptorSets(m_Device, &allocInfo, &vkSet));
+		poolNumSets.push_back(1);
+		outPoolIdx = static_cast<u32>(pools.size()) - 1;
+		return vkSet;
+	}
+
+	void RenderDevice::DestroyCachedDescriptorPools() {
+		for (auto& frameThreadSets : m_ThreadDescriptorSets) {
+			for (ThreadDescriptorSets& threadSets : frameThreadSets) {
+				for (VkDescriptorPool pool : threadSets.m_Pools) { vkDestroyDescriptorPool(m_Device, pool, nullptr); }
+				threadSets.m_Pools.clear();
+				threadSets.m_PoolNumSets.clear();
+			}
+		}
+	}
+
+	void RenderDevice::InvalidateDescriptorSets(u64 resourceID) {
+		// The frames in flight can be using the sets, they are only dropped from the caches for now
+		for (auto& frameThreadSets : m_ThreadDescriptorSets) {
+			for (ThreadDescriptorSets& threadSets : frameThreadSets) {
+				std::lock_guard lock{threadSets.m_Mutex};
+				threadSets.m_Cache.InvalidateResource(resourceID, threadSets.m_SetsToFree);
+			}
+		}
+	}
+
+	void RenderDevice::FreeDroppedDescriptorSets(u32 frameIdx) {
+		for (ThreadDescriptorSets& threadSets : m_ThreadDescriptorSets[frameIdx]) {
+			std::lock_guard threadLock{threadSets.m_Mutex};
+			std::lock_guard lock{m_DescriptorSetMutex};
+			for (DescriptorSetHandle set : threadSets.m_SetsToFree) {
+				DescriptorSet const& descriptorSet = m_ResourcesDB.GetDescriptorSet(set, frameIdx);
+				VkDescriptorPool     pool = threadSets.m_Pools[descriptorSet.m_PoolIdx];
+				VK_CHECK_CALL(vkFreeDescriptorSets(m_Device, pool, 1, &descriptorSet.m_DescriptorSet));
+				threadSets.m_PoolNumSets[descriptorSet.m_PoolIdx]--;
+				m_ResourcesDB.RemoveCachedDescriptorSet(set, frameIdx);
+			}
+			threadSets.m_SetsToFree.clear();
+		}
 	}
 
 	void RenderDevice::CreatePipelineDescriptorPool(Pipeline&                            pipeline,
@@ -1158,31 +1451,36 @@ namespace CKE {
 
 	DescriptorSetHandle RenderDevice::CreateDescriptorSetForFrame(PipelineHandle                          pipelineHandle,
 	                                                              u32                                     layoutIndex,
-	                                                              Vector<DescriptorSetBuilder::Bindings>& shaderBindings) {
-		Pipeline*          pPipeline = m_ResourcesDB.GetPipeline(pipelineHandle);
-		PipelineLayout*    pPipelineLayout = m_ResourcesDB.GetPipelineLayout(pPipeline->m_PipelineLayout);
-		PipelineFrameData& pipelineFrameData = GetCurrentFrameData().GetPipelineState(pipelineHandle);
-
-		// Allocate New Descriptor Set
-		VkDescriptorSetAllocateInfo allocInfo{};
-		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-		allocInfo.descriptorPool = pipelineFrameData.m_DescriptorPool;
-		allocInfo.descriptorSetCount = 1;
-		allocInfo.pSetLayouts = &pPipelineLayout->m_DescriptorSetLayouts[layoutIndex];
-
-		VkDescriptorSet vkDescriptorSet{};
-		if (vkAllocateDescriptorSets(m_Device, &allocInfo, &vkDescriptorSet) != VK_SUCCESS) {
-			CKE_UNREACHABLE_CODE();
-		}
+	                                                              u32                                     threadIdx,
+	                                                              Vector<DescriptorSetBuilder::Bindings>& shaderBindings,
+	                                                              bool                                    isPersistent) {
+		Pipeline*       pPipeline = m_ResourcesDB.GetPipeline(pipelineHandle);
+		PipelineLayout* pPipelineLayout = m_ResourcesDB.GetPipelineLayout(pPipeline->m_PipelineLayout);
+		u64 const       layoutID = pPipeline->m_PipelineLayout.m_Value;
+		u64 const       hash = HashDescriptorSetBindings(layoutID, layoutIndex, shaderBindings);
+
+		// Sets only read the resources, pipelines with the same layout can share them.
+		// Each recording thread has its own cache and pools, a miss doesn't make the other threads wait.
+		CKE_ASSERT(threadIdx < RenderSettings::MAX_RECORDING_THREADS);
+		ThreadDescriptorSets& threadSets = m_ThreadDescriptorSets[GetFrameIdx()][threadIdx];
+		std::lock_guard       threadLock{threadSets.m_Mutex};
+		DescriptorSetCache&   cache = threadSets.m_Cache;
+		DescriptorSetHandle   cachedSet = cache.Find(hash, layoutID, layoutIndex, shaderBindings, isPersistent);
+		if (cachedSet.IsValid()) { return CreateDynamicDescriptorSet(cachedSet, pPipelineLayout, shaderBindings); }
+
+		u32             poolIdx = 0;
+		VkDescriptorSet vkDescriptorSet = AllocateCachedDescriptorSet(
+			threadSets.m_Pools, threadSets.m_PoolNumSets, pPipelineLayout->m_DescriptorSetLayouts[layoutIndex], poolIdx);
 
 		// Because VkWriteDescriptorSet has a pointer to a buffer or image info
 		// we have to store those structures somewhere until we submit the write
 		// Its important that we reserve the vectors because if we don't the vector
 		// will probably reallocate the resources and the pointers to them will become
 		// invalid.
-		static Vector<VkDescriptorBufferInfo> bufferInfos{30};
-		static Vector<VkDescriptorImageInfo>  imageInfos{30};
-		static Vector<VkWriteDescriptorSet>   descWrites{30};
+		// They are per thread because sets can be built while recording in parallel.
+		thread_local Vector<VkDescriptorBufferInfo> bufferInfos{30};
+		thread_local Vector<VkDescriptorImageInfo>  imageInfos{30};
+		thread_local Vector<VkWriteDescriptorSet>   descWrites{30};
 		bufferInfos.clear();
 		imageInfos.clear();
 		descWrites.clear();
@@ -1192,10 +1490,16 @@ namespace CKE {
 				binding.m_Type == ShaderBindingType::StorageBuffer) {
 				Buffer* pBuffer = m_ResourcesDB.GetBuffer(BufferHandle{binding.m_ResourceID1});
 
+				// Dynamic bindings are written at the start of the buffer, the offset is added when the set is bound.
+				// Storage buffers reach the end of the buffer from any offset, so ranges of any size share the set.
 				VkDescriptorBufferInfo bufferInfo{};
 				bufferInfo.buffer = pBuffer->m_vkBuffer;
-				bufferInfo.offset = 0;
-				bufferInfo.range = pBuffer->m_Size;
+				if (!binding.m_IsDynamic) {
+					bufferInfo.offset = binding.m_OffsetInBytes;
+					bufferInfo.range = binding.m_SizeInBytes != 0 ? binding.m_SizeInBytes : pBuffer->m_Size - binding.m_OffsetInBytes;
+				}
+				else if (binding.m_Type == ShaderBindingType::UniformBuffer) { bufferInfo.range = binding.m_SizeInBytes; }
+				else { bufferInfo.range = VK_WHOLE_SIZE; }
 				bufferInfos.push_back(bufferInfo);
 
 				VkWriteDescriptorSet bufferWrite{};
@@ -1235,11 +1539,46 @@ namespace CKE {
 		}
 		vkUpdateDescriptorSets(m_Device, descWrites.size(), descWrites.data(), 0, nullptr);
 
-		DescriptorSet* pDescriptorSet = m_ResourcesDB.CreateDescriptorSetForFrame(GetFrameIdx());
-		pDescriptorSet->m_DescriptorSet = vkDescriptorSet;
-		pDescriptorSet->m_LayoutIndex = layoutIndex;
-		pipelineFrameData.m_DescriptorSets.push_back(pDescriptorSet->m_DBHandle);
-		return pDescriptorSet->m_DBHandle;
+		DescriptorSetHandle setHandle{};
+		{
+			std::lock_guard lock{m_DescriptorSetMutex};
+			DescriptorSet*  pDescriptorSet = m_ResourcesDB.CreateCachedDescriptorSet(GetFrameIdx());
+			pDescriptorSet->m_DescriptorSet = vkDescriptorSet;
+			pDescriptorSet->m_LayoutIndex = layoutIndex;
+			pDescriptorSet->m_PoolIdx = poolIdx;
+			pDescriptorSet->m_NumDynamicOffsets = static_cast<u32>(pPipelineLayout->m_BufferSlots[layoutIndex].size());
+			setHandle = pDescriptorSet->m_DBHandle;
+		}
+
+		// Evicted sets can be bound earlier in the frame, they are freed once its fence is waited for
+		cache.Insert(hash, layoutID, layoutIndex, shaderBindings, setHandle, isPersistent, threadSets.m_SetsToFree);
+		return CreateDynamicDescriptorSet(setHandle, pPipelineLayout, shaderBindings);
+	}
+
+	DescriptorSetHandle RenderDevice::CreateDynamicDescriptorSet(DescriptorSetHandle                           cachedSet,
+	                                                             PipelineLayout const*                         pPipelineLayout,
+	                                                             Vector<DescriptorSetBuilder::Bindings> const& shaderBindings) {
+		auto const isDynamic = [](DescriptorSetBuilder::Bindings const& binding) { return binding.m_IsDynamic; };
+		if (std::none_of(shaderBindings.begin(), shaderBindings.end(), isDynamic)) { return cachedSet; }
+
+		std::lock_guard lock{m_DescriptorSetMutex};
+		DescriptorSet   cached = m_ResourcesDB.GetDescriptorSet(cachedSet, GetFrameIdx());
+		DescriptorSet*  pSet = m_ResourcesDB.CreateDescriptorSetForFrame(GetFrameIdx());
+		pSet->m_DescriptorSet = cached.m_DescriptorSet;
+		pSet->m_LayoutIndex = cached.m_LayoutIndex;
+		pSet->m_NumDynamicOffsets = cached.m_NumDynamicOffsets;
+
+		// The same slot can't be bound twice, each offset is the one of the binding to its slot
+		Vector<u32> const& bufferSlots = pPipelineLayout->m_BufferSlots[cached.m_LayoutIndex];
+		for (u32 i = 0; i < bufferSlots.size(); ++i) {
+			for (DescriptorSetBuilder::Bindings const& binding : shaderBindings) {
+				if (binding.m_IsDynamic && binding.m_Slot == bufferSlots[i]) {
+					CKE_ASSERT(binding.m_OffsetInBytes <= std::numeric_limits<u32>::max());
+					pSet->m_DynamicOffsets[i] = static_cast<u32>(binding.m_OffsetInBytes);
+				}
+			}
+		}
+		return pSet->m_DBHandle;
 	}
 
 	template <typename T>
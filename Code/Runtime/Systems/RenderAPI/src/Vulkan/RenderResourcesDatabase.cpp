@@ -1,3 +1,5 @@
+#ifdef CKE_GRAPHICS_VULKAN_BACKEND
+
 #include "CookieKat/Systems/RenderAPI/Internal/RenderResourcesDatabase.h"
 
 #include "CookieKat/Core/Platform/Asserts.h"
@@ -130,6 +132,21 @@ namespace CKE {
 		m_TextureSamplers.Delete(handle);
 	}
 
+	MemoryHeap* RenderResourcesDatabase::CreateMemoryHeap() {
+		MemoryHeap heap{};
+		heap.m_DBHandle = GenerateResourceHandle<MemoryHeapHandle>();
+		m_MemoryHeaps.Add(heap.m_DBHandle, heap);
+		return m_MemoryHeaps.Get(heap.m_DBHandle);
+	}
+
+	MemoryHeap* RenderResourcesDatabase::GetMemoryHeap(MemoryHeapHandle handle) {
+		return m_MemoryHeaps.Get(handle);
+	}
+
+	void RenderResourcesDatabase::RemoveMemoryHeap(MemoryHeapHandle handle) {
+		m_MemoryHeaps.Delete(handle);
+	}
+
 	CommandQueue* RenderResourcesDatabase::CreateQueue() {
 		CommandQueue sampler{};
 		sampler.m_DBHandle = GenerateResourceHandle<CommandQueueHandle>();
@@ -219,13 +236,29 @@ namespace CKE {
 	}
 
 	DescriptorSet& RenderResourcesDatabase::GetDescriptorSet(DescriptorSetHandle handle, u32 frameIdx) {
-		return m_FrameResources[frameIdx].m_DescriptorSets[handle];
+		FrameResources& frameResources = m_FrameResources[frameIdx];
+		auto const      cachedIt = frameResources.m_CachedDescriptorSets.find(handle);
+		if (cachedIt != frameResources.m_CachedDescriptorSets.end()) { return cachedIt->second; }
+		return frameResources.m_DescriptorSets[handle];
 	}
 
 	void RenderResourcesDatabase::DestroyAllDescriptorSets(u32 frameIdx) {
 		m_FrameResources[frameIdx].m_DescriptorSets.clear();
 	}
 
+	DescriptorSet* RenderResourcesDatabase::CreateCachedDescriptorSet(u32 frameIdx) {
+		auto          handle = GenerateResourceHandle<DescriptorSetHandle>();
+		DescriptorSet s{};
+		s.m_DBHandle = handle;
+		m_FrameResources[frameIdx].m_CachedDescriptorSets.insert({handle, s});
+		return &m_FrameResources[frameIdx].m_CachedDescriptorSets[handle];
+	}
+
+	void RenderResourcesDatabase::RemoveCachedDescriptorSet(DescriptorSetHandle handle, u32 frameIdx) {
+		CKE_ASSERT(m_FrameResources[frameIdx].m_CachedDescriptorSets.contains(handle));
+		m_FrameResources[frameIdx].m_CachedDescriptorSets.erase(handle);
+	}
+
 	void RenderResourcesDatabase::CreatePipelineFrameData(PipelineHandle renderHandle) {
 		m_FrameResources[m_FrameIdx].m_PipelineFrameData.insert({ renderHandle, {} });
 	}
@@ -234,3 +267,5 @@ namespace CKE {
 		return m_Pipelines.GetMap();
 	}
 }
+
+#endif
@@ -1,3 +1,15 @@
+#include <gtest/gtest.h>
+
+#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+#include "CookieKat/Systems/RenderAPI/DescriptorSetCache.h"
+#include "CookieKat/Systems/RenderAPI/UploadRing.h"
+
+#include <cstring>
+
+using namespace CKE;
+
+#ifdef CKE_GRAPHICS_VULKAN_BACKEND
+
 #define NOMINMAX
 #define VK_USE_PLATFORM_WIN32_KHR
 #define GLFW_INCLUDE_VULKAN
@@ -5,12 +17,6 @@
 #define GLFW_EXPOSE_NATIVE_WIN32
 #include <GLFW/glfw3native.h>
 
-#include <gtest/gtest.h>
-
-#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
-
-using namespace CKE;
-
 namespace
 {
 	using namespace CKE;
@@ -99,4 +105,638 @@ TEST(Rendering, Open_Window)
 
 	glfwTerminate();
 	EXPECT_TRUE(true);
-}
\ No newline at end of file
+}
+
+#endif
+
+// Upload Ring
+//-----------------------------------------------------------------------------
+
+TEST(UploadRingAllocator, Allocations_Are_Aligned_And_In_Order) {
+	UploadRingAllocator ring{};
+	ring.Initialize(1024);
+
+	u64 offset = 0;
+	ASSERT_TRUE(ring.TryAllocate(10, 1, offset));
+	EXPECT_EQ(offset, 0);
+	ASSERT_TRUE(ring.TryAllocate(16, 256, offset));
+	EXPECT_EQ(offset, 256);
+	EXPECT_EQ(ring.GetUsedBytes(), 272); // Padding included
+	EXPECT_EQ(ring.GetFrameBytes(), 272);
+
+	ring.EndFrame(1);
+	EXPECT_EQ(ring.GetFrameBytes(), 0);
+	EXPECT_EQ(ring.GetNumFramesInFlight(), 1);
+}
+
+TEST(UploadRingAllocator, Frames_Are_Freed_When_Retired) {
+	UploadRingAllocator ring{};
+	ring.Initialize(1024);
+
+	u64 offset = 0;
+	ASSERT_TRUE(ring.TryAllocate(512, 256, offset));
+	ring.EndFrame(1);
+	ASSERT_TRUE(ring.TryAllocate(512, 256, offset));
+	EXPECT_EQ(offset, 512);
+	ring.EndFrame(2);
+	EXPECT_FALSE(ring.TryAllocate(1, 1, offset));
+
+	// Older fence values than the completed one are done too
+	ring.Retire(2);
+	EXPECT_EQ(ring.GetUsedBytes(), 0);
+	EXPECT_EQ(ring.GetNumFramesInFlight(), 0);
+	ASSERT_TRUE(ring.TryAllocate(1024, 256, offset));
+	EXPECT_EQ(offset, 0);
+}
+
+TEST(UploadRingAllocator, Allocations_Wrap_Around_The_End) {
+	UploadRingAllocator ring{};
+	ring.Initialize(1024);
+
+	u64 offset = 0;
+	ASSERT_TRUE(ring.TryAllocate(512, 256, offset));
+	ring.EndFrame(1);
+	ASSERT_TRUE(ring.TryAllocate(256, 256, offset));
+	ring.EndFrame(2);
+
+	// Doesn't fit before the end and the first frame is still in use at the start
+	EXPECT_FALSE(ring.TryAllocate(512, 256, offset));
+
+	ring.Retire(1);
+	ASSERT_TRUE(ring.TryAllocate(512, 256, offset));
+	EXPECT_EQ(offset, 0);
+	EXPECT_EQ(ring.GetUsedBytes(), 1024); // The skipped end is used until the frame retires
+	ring.EndFrame(3);
+
+	// The skipped end belongs to the frame that wrapped, only the second frame's memory is free
+	ring.Retire(2);
+	EXPECT_EQ(ring.GetUsedBytes(), 768);
+	ASSERT_TRUE(ring.TryAllocate(256, 256, offset));
+	EXPECT_EQ(offset, 512);
+	EXPECT_FALSE(ring.TryAllocate(1, 1, offset));
+}
+
+// Descriptor Set Cache
+//-----------------------------------------------------------------------------
+
+namespace {
+	using Bindings = Vector<DescriptorSetBuilder::Bindings>;
+
+	// Material-like set, a uniform buffer and a texture, the IDs stand in for resource handles
+	Bindings MakeBindings(u64 bufferID, u64 viewID, u64 samplerID = 1000) {
+		return Bindings{
+			{.m_Type = ShaderBindingType::UniformBuffer, .m_Slot = 0, .m_ResourceID1 = bufferID, .m_ResourceID2 = 0},
+			{.m_Type = ShaderBindingType::ImageViewSampler, .m_Slot = 1, .m_ResourceID1 = viewID, .m_ResourceID2 = samplerID}
+		};
+	}
+
+	// Looks the bindings up and inserts a new set on a miss, as the device does
+	DescriptorSetHandle FindOrInsert(DescriptorSetCache&          cache, u64 layoutID, Bindings const& bindings,
+	                                 Vector<DescriptorSetHandle>& evictedSets, bool isPersistent = false) {
+		static u64 nextSet = 1;
+
+		u64 const           hash = HashDescriptorSetBindings(layoutID, 0, bindings);
+		DescriptorSetHandle set = cache.Find(hash, layoutID, 0, bindings, isPersistent);
+		if (!set.IsValid()) {
+			set = DescriptorSetHandle{RenderHandle{nextSet++}};
+			cache.Insert(hash, layoutID, 0, bindings, set, isPersistent, evictedSets);
+		}
+		return set;
+	}
+}
+
+TEST(DescriptorSetCache, Hash_Covers_Layout_Set_And_Bindings) {
+	Bindings const bindings = MakeBindings(1, 2);
+	u64 const      hash = HashDescriptorSetBindings(7, 0, bindings);
+	EXPECT_EQ(hash, HashDescriptorSetBindings(7, 0, MakeBindings(1, 2)));
+
+	EXPECT_NE(hash, HashDescriptorSetBindings(8, 0, bindings));
+	EXPECT_NE(hash, HashDescriptorSetBindings(7, 1, bindings));
+	EXPECT_NE(hash, HashDescriptorSetBindings(7, 0, MakeBindings(1, 3)));
+	EXPECT_NE(hash, HashDescriptorSetBindings(7, 0, Bindings{bindings[1], bindings[0]}));
+
+	Bindings range = bindings;
+	range[0].m_OffsetInBytes = 256;
+	EXPECT_NE(hash, HashDescriptorSetBindings(7, 0, range));
+}
+
+TEST(DescriptorSetCache, Dynamic_Bindings_Are_Keyed_Without_Their_Offset) {
+	Bindings uniform = MakeBindings(1, 2);
+	uniform[0].m_SizeInBytes = 64;
+	uniform[0].m_IsDynamic = true;
+	u64 const uniformHash = HashDescriptorSetBindings(7, 0, uniform);
+
+	// Ring ranges move every frame, the offset is passed when the set is bound
+	Bindings moved = uniform;
+	moved[0].m_OffsetInBytes = 256;
+	EXPECT_EQ(uniformHash, HashDescriptorSetBindings(7, 0, moved));
+	EXPECT_TRUE(IsSameDescriptorSet(uniform, moved));
+
+	// Uniform buffers are written with their size
+	moved[0].m_SizeInBytes = 128;
+	EXPECT_NE(uniformHash, HashDescriptorSetBindings(7, 0, moved));
+	EXPECT_FALSE(IsSameDescriptorSet(uniform, moved));
+
+	// Storage buffers reach the end of the buffer, ranges of any size share the set
+	Bindings storage = uniform;
+	storage[0].m_Type = ShaderBindingType::StorageBuffer;
+	Bindings resized = storage;
+	resized[0].m_OffsetInBytes = 1024;
+	resized[0].m_SizeInBytes = 512;
+	EXPECT_EQ(HashDescriptorSetBindings(7, 0, storage), HashDescriptorSetBindings(7, 0, resized));
+	EXPECT_TRUE(IsSameDescriptorSet(storage, resized));
+
+	// Binding the same range as a static one is another set
+	Bindings staticRange = uniform;
+	staticRange[0].m_IsDynamic = false;
+	EXPECT_NE(uniformHash, HashDescriptorSetBindings(7, 0, staticRange));
+	EXPECT_FALSE(IsSameDescriptorSet(uniform, staticRange));
+}
+
+TEST(DescriptorSetCache, Repeated_Bindings_Hit) {
+	DescriptorSetCache cache{};
+	cache.Initialize(16);
+	Vector<DescriptorSetHandle> evicted{};
+
+	// A frame of 4 materials drawn over 3 frames
+	Vector<DescriptorSetHandle> firstFrameSets{};
+	for (u32 frame = 0; frame < 3; ++frame) {
+		for (u64 material = 0; material < 4; ++material) {
+			DescriptorSetHandle const set = FindOrInsert(cache, 7, MakeBindings(10 + material, 20 + material), evicted);
+			if (frame == 0) { firstFrameSets.push_back(set); }
+			else { EXPECT_EQ(set, firstFrameSets[material]); }
+		}
+	}
+
+	EXPECT_EQ(cache.GetStats().m_Misses, 4);
+	EXPECT_EQ(cache.GetStats().m_Hits, 8);
+	EXPECT_EQ(cache.GetStats().m_Evictions, 0);
+	EXPECT_EQ(cache.GetNumSets(), 4);
+	EXPECT_TRUE(evicted.empty());
+}
+
+TEST(DescriptorSetCache, Colliding_Hashes_Compare_The_Bindings) {
+	DescriptorSetCache cache{};
+	cache.Initialize(16);
+	Vector<DescriptorSetHandle> evicted{};
+
+	// Both sets forced in the same bucket
+	Bindings const            first = MakeBindings(1, 2);
+	Bindings const            second = MakeBindings(3, 4);
+	DescriptorSetHandle const firstSet{RenderHandle{100}};
+	DescriptorSetHandle const secondSet{RenderHandle{101}};
+	EXPECT_FALSE(cache.Find(42, 7, 0, first).IsValid());
+	cache.Insert(42, 7, 0, first, firstSet, false, evicted);
+	EXPECT_FALSE(cache.Find(42, 7, 0, second).IsValid());
+	cache.Insert(42, 7, 0, second, secondSet, false, evicted);
+
+	EXPECT_EQ(cache.Find(42, 7, 0, first), firstSet);
+	EXPECT_EQ(cache.Find(42, 7, 0, second), secondSet);
+	EXPECT_FALSE(cache.Find(42, 8, 0, first).IsValid());
+
+	// Removing the first of the bucket keeps the rest of it
+	cache.InvalidateResource(1, evicted);
+	EXPECT_FALSE(cache.Find(42, 7, 0, first).IsValid());
+	EXPECT_EQ(cache.Find(42, 7, 0, second), secondSet);
+}
+
+TEST(DescriptorSetCache, Least_Recently_Used_Sets_Are_Evicted) {
+	DescriptorSetCache cache{};
+	cache.Initialize(3);
+	Vector<DescriptorSetHandle> evicted{};
+
+	DescriptorSetHandle const a = FindOrInsert(cache, 7, MakeBindings(1, 1), evicted);
+	DescriptorSetHandle const b = FindOrInsert(cache, 7, MakeBindings(2, 2), evicted);
+	DescriptorSetHandle const c = FindOrInsert(cache, 7, MakeBindings(3, 3), evicted);
+
+	// Using the oldest one makes the second the least recently used
+	EXPECT_EQ(FindOrInsert(cache, 7, MakeBindings(1, 1), evicted), a);
+	FindOrInsert(cache, 7, MakeBindings(4, 4), evicted);
+	ASSERT_EQ(evicted.size(), 1);
+	EXPECT_EQ(evicted[0], b);
+
+	FindOrInsert(cache, 7, MakeBindings(5, 5), evicted);
+	ASSERT_EQ(evicted.size(), 2);
+	EXPECT_EQ(evicted[1], c);
+
+	EXPECT_EQ(cache.GetNumSets(), 3);
+	EXPECT_EQ(cache.GetStats().m_Evictions, 2);
+	EXPECT_NE(FindOrInsert(cache, 7, MakeBindings(2, 2), evicted), b);
+}
+
+TEST(DescriptorSetCache, Persistent_Sets_Are_Not_Evicted) {
+	DescriptorSetCache cache{};
+	cache.Initialize(2);
+	Vector<DescriptorSetHandle> evicted{};
+
+	DescriptorSetHandle const material = FindOrInsert(cache, 7, MakeBindings(1, 1), evicted, true);
+	DescriptorSetHandle const pinned = FindOrInsert(cache, 7, MakeBindings(2, 2), evicted);
+	EXPECT_EQ(FindOrInsert(cache, 7, MakeBindings(2, 2), evicted, true), pinned);
+	EXPECT_EQ(cache.GetNumPersistentSets(), 2);
+
+	// A stream of transient sets only cycles the recently used ones
+	for (u64 i = 0; i < 10; ++i) { FindOrInsert(cache, 7, MakeBindings(100 + i, 100 + i), evicted); }
+	EXPECT_EQ(cache.GetStats().m_Evictions, 8);
+	EXPECT_EQ(cache.GetNumSets(), 4);
+	EXPECT_EQ(FindOrInsert(cache, 7, MakeBindings(1, 1), evicted), material);
+	EXPECT_EQ(FindOrInsert(cache, 7, MakeBindings(2, 2), evicted), pinned);
+	for (DescriptorSetHandle set : evicted) { EXPECT_TRUE(set != material && set != pinned); }
+}
+
+TEST(DescriptorSetCache, Invalidated_Resources_Remove_Their_Sets) {
+	DescriptorSetCache cache{};
+	cache.Initialize(16);
+	Vector<DescriptorSetHandle> evicted{};
+
+	DescriptorSetHandle const material = FindOrInsert(cache, 7, MakeBindings(1, 2, 50), evicted, true);
+	DescriptorSetHandle const other = FindOrInsert(cache, 7, MakeBindings(3, 4, 50), evicted);
+	FindOrInsert(cache, 8, MakeBindings(5, 6), evicted);
+
+	// View of the material, persistent sets are removed too
+	Vector<DescriptorSetHandle> removed{};
+	cache.InvalidateResource(2, removed);
+	ASSERT_EQ(removed.size(), 1);
+	EXPECT_EQ(removed[0], material);
+	EXPECT_EQ(cache.GetNumPersistentSets(), 0);
+
+	// Shared sampler and layout
+	cache.InvalidateResource(50, removed);
+	ASSERT_EQ(removed.size(), 2);
+	EXPECT_EQ(removed[1], other);
+	cache.InvalidateResource(8, removed);
+	EXPECT_EQ(removed.size(), 3);
+
+	EXPECT_EQ(cache.GetNumSets(), 0);
+	EXPECT_EQ(cache.GetStats().m_Evictions, 0);
+	EXPECT_TRUE(evicted.empty());
+
+	// Freed entries are reused
+	FindOrInsert(cache, 7, MakeBindings(1, 2), evicted);
+	cache.Clear(removed);
+	EXPECT_EQ(removed.size(), 4);
+	EXPECT_EQ(cache.GetNumSets(), 0);
+}
+
+#ifdef CKE_GRAPHICS_NULL_BACKEND
+
+// Null Backend
+//-----------------------------------------------------------------------------
+
+class NullDeviceFixture : public testing::Test
+{
+protected:
+	void SetUp() override { m_Device.Initialize({1280, 720}); }
+	void TearDown() override { m_Device.Shutdown(); }
+
+	// Buffer of u32 values, zeroed
+	BufferHandle CreateBuffer(u32 count, DuplicationStrategy duplication = DuplicationStrategy::Unique) {
+		BufferDesc desc{};
+		desc.m_Usage = BufferUsageFlags::Storage | BufferUsageFlags::TransferSrc | BufferUsageFlags::TransferDst;
+		desc.m_DuplicationStrategy = duplication;
+		desc.m_SizeInBytes = count * sizeof(u32);
+		return m_Device.CreateBuffer(desc);
+	}
+
+	// Ends the frame signaling its fence, as the last submission of a frame would
+	void NextFrame() {
+		CommandList cmdList = m_Device.GetGraphicsCmdList();
+		cmdList.Begin();
+		cmdList.End();
+		m_Device.SubmitGraphicsCommandList(cmdList, {.m_SignalFence = m_Device.GetInFlightFence()});
+		m_Device.Present();
+		m_Device.AcquireNextBackBuffer();
+	}
+
+	RenderDevice m_Device{};
+};
+
+TEST_F(NullDeviceFixture, Handles_Are_Unique_And_Released) {
+	u64 const numTextures = m_Device.GetNumTextures(); // BackBuffers
+
+	BufferHandle const  buffer = CreateBuffer(4);
+	TextureHandle const texture = m_Device.CreateTexture(TextureDesc{});
+	TextureViewHandle const view = m_Device.CreateTextureView(TextureViewDesc{
+		texture, TextureViewType::Tex2D, TextureAspectMask::Color, TextureFormat::R8G8B8A8_SRGB, 0, 1, 0, 1
+	});
+
+	EXPECT_TRUE(buffer.IsValid() && texture.IsValid() && view.IsValid());
+	EXPECT_NE(buffer.m_Value, texture.m_Value);
+	EXPECT_NE(texture.m_Value, view.m_Value);
+	EXPECT_EQ(m_Device.GetNumTextures(), numTextures + 1);
+
+	m_Device.DestroyTexture(texture);
+	m_Device.DestroyBuffer(buffer);
+	EXPECT_EQ(m_Device.GetNumTextures(), numTextures);
+	EXPECT_EQ(m_Device.GetNumBuffers(), 0);
+}
+
+TEST_F(NullDeviceFixture, Buffers_Are_CPU_Memory) {
+	BufferHandle const src = CreateBuffer(4);
+	BufferHandle const dst = CreateBuffer(4);
+
+	u32 const values[4] = {1, 2, 3, 4};
+	m_Device.UploadBufferData_DEPR(src, values, sizeof(values), 0);
+
+	// Copies run when the list is submitted
+	m_Device.AcquireNextBackBuffer();
+	CommandList cmdList = m_Device.GetGraphicsCmdList();
+	cmdList.Begin();
+	BufferCopyInfo copyInfo{};
+	copyInfo.srcOffset = 4;
+	copyInfo.size = 12;
+	cmdList.CopyBuffer(src, dst, copyInfo);
+	cmdList.End();
+	m_Device.SubmitGraphicsCommandList(cmdList, {});
+
+	u32 const* pDst = static_cast<u32*>(m_Device.MapBuffer(dst));
+	EXPECT_EQ(pDst[0], 2);
+	EXPECT_EQ(pDst[1], 3);
+	EXPECT_EQ(pDst[2], 4);
+	EXPECT_EQ(pDst[3], 0);
+	m_Device.UnMapBuffer(dst);
+}
+
+TEST_F(NullDeviceFixture, Per_Frame_Buffers_Have_A_Copy_Per_Frame) {
+	BufferHandle const buffer = CreateBuffer(1, DuplicationStrategy::PerFrameInFlight);
+
+	m_Device.AcquireNextBackBuffer();
+	u32 const frame0 = 10;
+	m_Device.UploadBufferData_DEPR(buffer, &frame0, sizeof(u32), 0);
+
+	NextFrame();
+	EXPECT_EQ(*static_cast<u32*>(m_Device.MapBuffer(buffer)), 0);
+
+	for (u32 i = 1; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) { NextFrame(); }
+	EXPECT_EQ(*static_cast<u32*>(m_Device.MapBuffer(buffer)), frame0);
+}
+
+TEST_F(NullDeviceFixture, Secondary_Lists_Are_Executed_In_Order) {
+	PipelineHandle const pipeline = m_Device.CreateGraphicsPipeline(GraphicsPipelineDesc{});
+
+	m_Device.AcquireNextBackBuffer();
+	RenderingInfo renderingInfo{};
+	renderingInfo.m_RenderArea = m_Device.GetBackBufferSize();
+
+	// Recorded from different threads in a real frame, each list draws its own range
+	Vector<CommandList> secondaryLists{};
+	for (u32 i = 0; i < 3; ++i) {
+		CommandList secondary = m_Device.GetSecondaryGraphicsCmdList(i);
+		secondary.BeginSecondary(renderingInfo);
+		secondary.SetGraphicsPipeline(pipeline);
+		secondary.BindDescriptor(pipeline, m_Device.CreateDescriptorSetBuilder(pipeline, 0, i).Build());
+		secondary.Draw(3, 1, 0, i);
+		secondary.End();
+		secondaryLists.push_back(secondary);
+	}
+
+	CommandList cmdList = m_Device.GetGraphicsCmdList();
+	cmdList.Begin();
+	cmdList.BeginDebugLabel("Pass", Vec3{1.0f});
+	renderingInfo.m_ContentsInSecondaryCmdLists = true;
+	cmdList.BeginRendering(renderingInfo);
+	cmdList.ExecuteCommands(secondaryLists);
+	cmdList.EndRendering();
+	cmdList.EndDebugLabel();
+	cmdList.End();
+	m_Device.SubmitGraphicsCommandList(cmdList, {});
+
+	ASSERT_EQ(m_Device.GetSubmissions().size(), 1);
+	NullCommandStream const& stream = *m_Device.GetSubmissions()[0].m_pStream;
+	EXPECT_EQ(stream.Count(NullCommandType::Draw), 3);
+	EXPECT_EQ(stream.Count(NullCommandType::BindDescriptor), 3);
+	EXPECT_EQ(stream.m_DebugLabels[0], "Pass");
+
+	u64 nextInstance = 0;
+	for (NullCommand const& command : stream.m_Commands) {
+		if (command.m_Type == NullCommandType::Draw) { EXPECT_EQ(command.m_Args[3], nextInstance++); }
+	}
+
+	NextFrame();
+	EXPECT_TRUE(m_Device.GetSubmissions().empty());
+}
+
+TEST_F(NullDeviceFixture, Descriptor_Sets_Are_Cached_Per_Frame_In_Flight) {
+	PipelineLayoutHandle const layout = m_Device.CreatePipelineLayout(PipelineLayoutDesc{});
+	GraphicsPipelineDesc       pipelineDesc{};
+	pipelineDesc.m_LayoutHandle = layout;
+	PipelineHandle const pipeline = m_Device.CreateGraphicsPipeline(pipelineDesc);
+	PipelineHandle const otherPipeline = m_Device.CreateGraphicsPipeline(pipelineDesc);
+	BufferHandle const   buffer = CreateBuffer(4);
+
+	m_Device.AcquireNextBackBuffer();
+	DescriptorSetHandle const set = m_Device.CreateDescriptorSetBuilder(pipeline, 0).BindStorageBuffer(0, buffer).Build();
+	ASSERT_NE(m_Device.GetDescriptorSet(set), nullptr);
+
+	// Pipelines with the same layout share the set, other offsets are another set
+	EXPECT_EQ(m_Device.CreateDescriptorSetBuilder(otherPipeline, 0).BindStorageBuffer(0, buffer).Build(), set);
+	EXPECT_NE(m_Device.CreateDescriptorSetBuilder(pipeline, 0).BindStorageBuffer(0, {buffer, 4, 4}).Build(), set);
+
+	// Each recording thread has its own cache
+	EXPECT_NE(m_Device.CreateDescriptorSetBuilder(pipeline, 0, 1).BindStorageBuffer(0, buffer).Build(), set);
+
+	// The next frame in flight has its own cache, the set comes back once the frame does
+	for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) {
+		NextFrame();
+		m_Device.CreateDescriptorSetBuilder(pipeline, 0).BindStorageBuffer(0, buffer).Build();
+	}
+	EXPECT_EQ(m_Device.CreateDescriptorSetBuilder(pipeline, 0).BindStorageBuffer(0, buffer).Build(), set);
+
+	DescriptorSetCacheStats const stats = m_Device.GetDescriptorSetCacheStats();
+	EXPECT_EQ(stats.m_Misses, 2 + RenderSettings::MAX_FRAMES_IN_FLIGHT);
+	EXPECT_EQ(stats.m_Hits, 3);
+
+	// Destroying a bound resource drops its sets, they are freed once their frame comes back
+	m_Device.DestroyBuffer(buffer);
+	EXPECT_NE(m_Device.GetDescriptorSet(set), nullptr);
+	for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) { NextFrame(); }
+	EXPECT_EQ(m_Device.GetDescriptorSet(set), nullptr);
+	EXPECT_EQ(m_Device.GetNumDescriptorSets(), 0);
+
+	m_Device.DestroyPipeline(pipeline);
+	m_Device.DestroyPipeline(otherPipeline);
+	m_Device.DestroyPipelineLayout(layout);
+}
+
+TEST_F(NullDeviceFixture, Evicted_Descriptor_Sets_Live_Until_Their_Frame_Comes_Back) {
+	PipelineLayoutHandle const layout = m_Device.CreatePipelineLayout(PipelineLayoutDesc{});
+	GraphicsPipelineDesc       pipelineDesc{};
+	pipelineDesc.m_LayoutHandle = layout;
+	PipelineHandle const pipeline = m_Device.CreateGraphicsPipeline(pipelineDesc);
+	BufferHandle const   buffer = CreateBuffer(RenderSettings::DESCRIPTOR_SET_CACHE_CAPACITY + 1);
+	auto const           buildSet = [&](u32 idx) {
+		return m_Device.CreateDescriptorSetBuilder(pipeline, 0).BindStorageBuffer(0, {buffer, idx * 4, 4}).Build();
+	};
+
+	m_Device.AcquireNextBackBuffer();
+	DescriptorSetHandle const first = buildSet(0);
+	for (u32 i = 1; i <= RenderSettings::DESCRIPTOR_SET_CACHE_CAPACITY; ++i) { buildSet(i); }
+	EXPECT_EQ(m_Device.GetDescriptorSetCacheStats().m_Evictions, 1);
+
+	// The frame could have bound it already, so it stays until the frame's fence is waited for
+	EXPECT_NE(m_Device.GetDescriptorSet(first), nullptr);
+	EXPECT_NE(buildSet(0), first);
+	EXPECT_EQ(m_Device.GetNumDescriptorSets(), RenderSettings::DESCRIPTOR_SET_CACHE_CAPACITY + 2);
+
+	for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) { NextFrame(); }
+	EXPECT_EQ(m_Device.GetDescriptorSet(first), nullptr);
+	EXPECT_EQ(m_Device.GetNumDescriptorSets(), RenderSettings::DESCRIPTOR_SET_CACHE_CAPACITY);
+
+	m_Device.DestroyBuffer(buffer);
+	m_Device.DestroyPipeline(pipeline);
+	m_Device.DestroyPipelineLayout(layout);
+}
+
+TEST_F(NullDeviceFixture, Full_Descriptor_Pools_Add_Another_Pool) {
+	PipelineLayoutHandle const layout = m_Device.CreatePipelineLayout(PipelineLayoutDesc{});
+	GraphicsPipelineDesc       pipelineDesc{};
+	pipelineDesc.m_LayoutHandle = layout;
+	PipelineHandle const pipeline = m_Device.CreateGraphicsPipeline(pipelineDesc);
+	BufferHandle const   buffer = CreateBuffer(RenderSettings::DESCRIPTOR_SETS_PER_POOL + 1);
+	auto const           buildSet = [&](u32 idx, u32 threadIdx = 0) {
+		DescriptorSetBuilder builder = m_Device.CreateDescriptorSetBuilder(pipeline, 0, threadIdx);
+		return builder.BindStorageBuffer(0, {buffer, idx * 4, 4}).Build();
+	};
+
+	m_Device.AcquireNextBackBuffer();
+	for (u32 i = 0; i < RenderSettings::DESCRIPTOR_SETS_PER_POOL; ++i) { buildSet(i); }
+	EXPECT_EQ(m_Device.GetNumDescriptorPools(), 1);
+	buildSet(RenderSettings::DESCRIPTOR_SETS_PER_POOL);
+	EXPECT_EQ(m_Device.GetNumDescriptorPools(), 2);
+
+	// Other recording threads allocate from pools of their own
+	buildSet(0, 1);
+	EXPECT_EQ(m_Device.GetNumDescriptorPools(), 3);
+
+	// Freed sets leave room for the next ones
+	m_Device.DestroyBuffer(buffer);
+	for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) { NextFrame(); }
+	BufferHandle const otherBuffer = CreateBuffer(RenderSettings::DESCRIPTOR_SETS_PER_POOL + 1);
+	for (u32 i = 0; i <= RenderSettings::DESCRIPTOR_SETS_PER_POOL; ++i) {
+		m_Device.CreateDescriptorSetBuilder(pipeline, 0).BindStorageBuffer(0, {otherBuffer, i * 4, 4}).Build();
+	}
+	EXPECT_EQ(m_Device.GetNumDescriptorPools(), 3);
+
+	m_Device.DestroyBuffer(otherBuffer);
+	m_Device.DestroyPipeline(pipeline);
+	m_Device.DestroyPipelineLayout(layout);
+}
+
+TEST_F(NullDeviceFixture, Upload_Ring_Ranges_Hit_The_Descriptor_Set_Cache) {
+	PipelineLayoutHandle const layout = m_Device.CreatePipelineLayout(PipelineLayoutDesc{});
+	GraphicsPipelineDesc       pipelineDesc{};
+	pipelineDesc.m_LayoutHandle = layout;
+	PipelineHandle const pipeline = m_Device.CreateGraphicsPipeline(pipelineDesc);
+	BufferHandle const   objects = CreateBuffer(16);
+	UploadRing           ring{};
+	ring.Initialize(&m_Device, 4096, BufferUsageFlags::Uniform | BufferUsageFlags::Storage, "Upload Ring");
+
+	// A frame of the scene, the visible instances and the view are written to the ring
+	Vector<u32> frameOffsets{};
+	auto const  recordFrame = [&](u32 numInstances) {
+		ring.BeginFrame(m_Device.GetInFlightFence());
+		UploadAllocation const instances = ring.Allocate(numInstances * sizeof(Mat4));
+		UploadAllocation const view = ring.Allocate(64);
+
+		DescriptorSetHandle const set = m_Device.CreateDescriptorSetBuilder(pipeline, 0)
+		                                        .BindDynamicUniformBuffer(0, view.GetRange())
+		                                        .BindStorageBuffer(1, objects)
+		                                        .BindDynamicStorageBuffer(2, instances.GetRange())
+		                                        .Build();
+		DescriptorSet const* pSet = m_Device.GetDescriptorSet(set);
+		EXPECT_NE(pSet, nullptr);
+		if (pSet != nullptr) {
+			Vector<u32> const offsets{static_cast<u32>(view.m_OffsetInBytes), static_cast<u32>(instances.m_OffsetInBytes)};
+			EXPECT_EQ(pSet->m_DynamicOffsets, offsets);
+			frameOffsets = pSet->m_DynamicOffsets;
+		}
+
+		CommandList cmdList = m_Device.GetGraphicsCmdList();
+		cmdList.Begin();
+		cmdList.BindDescriptor(pipeline, set);
+		cmdList.End();
+		m_Device.SubmitGraphicsCommandList(cmdList, {});
+		ring.EndFrame();
+		NextFrame();
+	};
+
+	// Each frame in flight builds the set once
+	m_Device.AcquireNextBackBuffer();
+	for (u32 i = 0; i < RenderSettings::MAX_FRAMES_IN_FLIGHT; ++i) { recordFrame(10); }
+	DescriptorSetCacheStats const warmStats = m_Device.GetDescriptorSetCacheStats();
+	EXPECT_EQ(warmStats.m_Misses, RenderSettings::MAX_FRAMES_IN_FLIGHT);
+
+	// The number of instances changes, so the view moves through the ring and the sets are reused
+	Vector<u32> const warmOffsets = frameOffsets;
+	for (u32 frame = 0; frame < 8; ++frame) { recordFrame(10 + frame); }
+	EXPECT_NE(frameOffsets[0], warmOffsets[0]);
+	DescriptorSetCacheStats const stats = m_Device.GetDescriptorSetCacheStats();
+	EXPECT_EQ(stats.m_Misses, warmStats.m_Misses);
+	EXPECT_EQ(stats.m_Hits, warmStats.m_Hits + 8);
+
+	ring.Shutdown();
+	m_Device.DestroyBuffer(objects);
+	m_Device.DestroyPipeline(pipeline);
+	m_Device.DestroyPipelineLayout(layout);
+}
+
+TEST_F(NullDeviceFixture, Upload_Ring_Writes_To_Mapped_Memory) {
+	UploadRing ring{};
+	ring.Initialize(&m_Device, 1024, BufferUsageFlags::Storage, "Upload Ring");
+
+	m_Device.AcquireNextBackBuffer();
+	ring.BeginFrame(m_Device.GetInFlightFence());
+	u32 const              values[4] = {1, 2, 3, 4};
+	UploadAllocation const allocation = ring.Upload(values, sizeof(values));
+	ring.EndFrame();
+
+	ASSERT_TRUE(allocation.IsValid());
+	EXPECT_EQ(allocation.GetRange().m_Buffer, ring.GetBuffer());
+	EXPECT_EQ(ring.GetFrameUploadBytes(), sizeof(values));
+
+	u8 const* pRing = static_cast<u8*>(m_Device.GetBufferMappedPtr(ring.GetBuffer()));
+	EXPECT_EQ(std::memcmp(pRing + allocation.m_OffsetInBytes, values, sizeof(values)), 0);
+
+	// The frame is retired once its fence is signaled
+	NextFrame();
+	ring.BeginFrame(m_Device.GetInFlightFence());
+	EXPECT_EQ(ring.GetAllocator().GetNumFramesInFlight(), 0);
+	ring.EndFrame();
+
+	ring.Shutdown();
+}
+
+TEST_F(NullDeviceFixture, Full_Upload_Ring_Waits_For_The_Oldest_Frame) {
+	UploadRing ring{};
+	ring.Initialize(&m_Device, 1024, BufferUsageFlags::Storage, "Upload Ring");
+	FenceHandle const firstFence = m_Device.CreateFence(false);
+	FenceHandle const secondFence = m_Device.CreateFence(false);
+
+	m_Device.AcquireNextBackBuffer();
+	ring.BeginFrame(firstFence);
+	EXPECT_TRUE(ring.Allocate(768).IsValid());
+	ring.EndFrame();
+
+	// The first frame's work hasn't been submitted, so its memory is still in use
+	ring.BeginFrame(secondFence);
+	EXPECT_EQ(ring.GetAllocator().GetNumFramesInFlight(), 1);
+
+	CommandList cmdList = m_Device.GetGraphicsCmdList();
+	cmdList.Begin();
+	cmdList.End();
+	m_Device.SubmitGraphicsCommandList(cmdList, {.m_SignalFence = firstFence});
+
+	UploadAllocation const allocation = ring.Allocate(768);
+	ASSERT_TRUE(allocation.IsValid());
+	EXPECT_EQ(allocation.m_OffsetInBytes, 0);
+	EXPECT_EQ(ring.GetAllocator().GetNumFramesInFlight(), 0);
+
+	// Nothing in flight can free more memory
+	EXPECT_FALSE(ring.Allocate(768).IsValid());
+	ring.EndFrame();
+
+	ring.Shutdown();
+	m_Device.DestroyFence(firstFence);
+	m_Device.DestroyFence(secondFence);
+}
+
+#endif
@@ -0,0 +1,125 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+#include "CookieKat/Systems/RenderAPI/UploadRing.h"
+
+namespace CKE {
+	// Identifies an enqueued upload, uploads complete in the order they were enqueued
+	struct TextureUploadTicket
+	{
+		u64 m_Value = 0;
+
+		inline bool IsValid() const { return m_Value != 0; }
+	};
+
+	struct TextureUploadQueueSettings
+	{
+		u64 m_StagingSizeInBytes = 64 * 1024 * 1024;
+		u64 m_FrameBudgetInBytes = 16 * 1024 * 1024; // Bytes staged by each update
+	};
+
+	struct TextureUploadStats
+	{
+		u64 m_FrameUploadBytes = 0;  // Staged by the last update
+		u64 m_FrameStallNs = 0;      // Waited for the GPU since the last update started
+		u64 m_MaxFrameStallNs = 0;   // Worst stall of an update since the queue was initialized
+		u64 m_TotalUploadBytes = 0;
+		u64 m_NumPendingUploads = 0; // Enqueued uploads that aren't complete
+	};
+
+	// Uploads textures to the GPU without waiting for the copies to finish.
+	//
+	// Each texture is split into a copy per mip and layer, mips larger than what an update can stage
+	// are split again in bands of rows. Every update stages copies up to the frame budget in a ring of
+	// staging memory and submits them on the transfer queue with a fence, the staging memory is reused
+	// once the fence signals. The texture data must stay alive until its upload is complete.
+	class TextureUploadQueue
+	{
+	public:
+		void Initialize(RenderDevice* pDevice, TextureUploadQueueSettings const& settings = {});
+		void Shutdown(); // Waits for the copies in flight, uploads that weren't staged are dropped
+
+		// Full mip chain stored contiguously from the largest to the smallest mip,
+		// each mip tightly packed in the layout of the format (4x4 blocks for compressed formats)
+		TextureUploadTicket EnqueueTexture2DMips(TextureHandle texture, void const* pMipData, UInt2 texSize,
+		                                         u32           mipCount, TextureFormat format);
+		// Full mip chain of each face, every face laid out like in EnqueueTexture2DMips
+		TextureUploadTicket EnqueueCubeMapMips(TextureHandle texture, void const* const pFaceData[6], UInt2 faceSize,
+		                                       u32           mipCount, TextureFormat format);
+
+		// Called once per frame, retires the finished copies and submits the next ones within the budget
+		void Update();
+
+		// The texture is in the shader read only layout once the GPU finishes the upload
+		bool IsUploadComplete(TextureUploadTicket ticket) const;
+
+		// Submits what is left of the upload ignoring the budget and waits for it to finish
+		void WaitForUpload(TextureUploadTicket ticket);
+
+		inline TextureUploadStats const& GetStats() const { return m_Stats; }
+		inline u64                       GetNumBatchesInFlight() const { return m_BatchesInFlight.size(); }
+
+	private:
+		// Copy of a band of rows of a mip of a texture layer
+		struct QueuedCopy
+		{
+			u8 const* m_pData;
+			u64       m_SizeInBytes;
+			u32       m_Mip;
+			u32       m_Layer;
+			u32       m_FirstRow;
+			UInt2     m_Extent;
+		};
+
+		struct QueuedTexture
+		{
+			u64                     m_Ticket;
+			TextureHandle           m_Texture;
+			TextureSubresourceRange m_Range;
+			u64                     m_NumCopies;
+		};
+
+		// Copies submitted together on a transfer command list
+		struct Batch
+		{
+			u64         m_BatchNumber;  // Fence value of its staging memory
+			u64         m_UpdateNumber; // Update whose command lists it was recorded in
+			FenceHandle m_Fence;
+			u64         m_LastTicket;   // Newest upload complete once the batch is
+		};
+
+		TextureUploadTicket EnqueueTexture(TextureHandle texture, void const* const* pLayerData, u32 layerCount,
+		                                   UInt2         size, u32 mipCount, TextureFormat format);
+		void                EnqueueMipCopies(void const* pMipData, u32 mip, u32 layer, UInt2 mipSize,
+		                                     TextureFormat format);
+
+		// Stages the queued copies that fit in the budget and the ring, returns false if none did
+		bool SubmitBatch(u64 budgetInBytes);
+		void RetireBatches();
+		void WaitForOldestBatch();
+		void RecordStall(u64 stallNs);
+
+	private:
+		RenderDevice*              m_pDevice = nullptr;
+		TextureUploadQueueSettings m_Settings{};
+		BufferHandle               m_StagingBuffer{};
+		u8*                        m_pStagingData = nullptr;
+		UploadRingAllocator        m_StagingAllocator{};
+		u64                        m_MaxCopySize = 0; // Largest copy an update can stage, larger mips are split
+
+		Queue<QueuedTexture> m_QueuedTextures{};
+		Queue<QueuedCopy>    m_QueuedCopies{};
+		u64                  m_NumFrontCopiesStaged = 0; // Copies of the front texture already submitted
+
+		Vector<Batch>       m_BatchesInFlight{}; // Oldest first
+		Vector<FenceHandle> m_FreeFences{};
+		u64                 m_NextTicket = 1;
+		u64                 m_LastSubmittedTicket = 0; // Newest upload with all of its copies submitted
+		u64                 m_LastCompletedTicket = 0;
+		u64                 m_NextBatchNumber = 1;
+		u64                 m_UpdateNumber = 0;
+
+		TextureUploadStats m_Stats{};
+	};
+}
@@ -13,6 +13,10 @@ namespace CKE {
 		void UploadColorTexture2D(TextureHandle targetTexture, void* pTextureData, UInt2 texSize, u32 pixelByteSize);
 		void UploadTexture2D(TextureHandle     targetTexture, void* pTextureData, UInt2 texSize, u32 pixelByteSize,
 			TextureAspectMask aspectType);
+		// Uploads a full mip chain stored contiguously from the largest to the smallest mip,
+		// each mip tightly packed in the layout of the format (4x4 blocks for compressed formats)
+		void UploadTexture2DMips(TextureHandle targetTexture, void* pMipData, UInt2 texSize, u32 mipCount,
+		                         TextureFormat format);
 		void UploadTextureCubeMap(TextureHandle targetTexture, void* pTextureData, UInt2 texFaceSize);
 		void UploadTextureCubeMap(TextureHandle targetTexture, void* pTexFaceData[6], UInt2 texFaceSize);
 
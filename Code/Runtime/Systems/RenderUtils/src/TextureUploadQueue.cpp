@@ -0,0 +1,279 @@
+#include "CookieKat/Systems/RenderUtils/TextureUploadQueue.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+namespace CKE {
+	namespace {
+		// Multiple of the texel and block sizes of every format, copies must start at one of them
+		constexpr u64 COPY_ALIGNMENT = 16;
+
+		inline u64 ElapsedNs(std::chrono::steady_clock::time_point start) {
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+		}
+	}
+
+	void TextureUploadQueue::Initialize(RenderDevice* pDevice, TextureUploadQueueSettings const& settings) {
+		CKE_ASSERT(pDevice != nullptr);
+		CKE_ASSERT(settings.m_StagingSizeInBytes > 0 && settings.m_FrameBudgetInBytes > 0);
+		m_pDevice = pDevice;
+		m_Settings = settings;
+
+		BufferDesc stagingDesc{};
+		stagingDesc.m_DebugName = "TextureUploadStaging";
+		stagingDesc.m_Usage = BufferUsageFlags::TransferSrc;
+		stagingDesc.m_MemoryAccess = MemoryAccess::CPU_GPU_Coherent;
+		stagingDesc.m_DuplicationStrategy = DuplicationStrategy::Unique;
+		stagingDesc.m_SizeInBytes = settings.m_StagingSizeInBytes;
+		m_StagingBuffer = pDevice->CreateBuffer(stagingDesc);
+		m_pStagingData = static_cast<u8*>(pDevice->MapBuffer(m_StagingBuffer));
+
+		m_StagingAllocator.Initialize(settings.m_StagingSizeInBytes);
+		m_MaxCopySize = std::min(settings.m_FrameBudgetInBytes, settings.m_StagingSizeInBytes);
+		m_Stats = TextureUploadStats{};
+	}
+
+	void TextureUploadQueue::Shutdown() {
+		while (!m_BatchesInFlight.empty()) { WaitForOldestBatch(); }
+		for (FenceHandle fence : m_FreeFences) { m_pDevice->DestroyFence(fence); }
+		m_FreeFences.clear();
+
+		m_QueuedTextures = {};
+		m_QueuedCopies = {};
+		m_NumFrontCopiesStaged = 0;
+
+		m_pDevice->UnMapBuffer(m_StagingBuffer);
+		m_pDevice->DestroyBuffer(m_StagingBuffer);
+		m_StagingBuffer = BufferHandle{};
+		m_pStagingData = nullptr;
+	}
+
+	TextureUploadTicket TextureUploadQueue::EnqueueTexture2DMips(TextureHandle texture, void const* pMipData,
+	                                                             UInt2         texSize, u32 mipCount,
+	                                                             TextureFormat format) {
+		return EnqueueTexture(texture, &pMipData, 1, texSize, mipCount, format);
+	}
+
+	TextureUploadTicket TextureUploadQueue::EnqueueCubeMapMips(TextureHandle texture, void const* const pFaceData[6],
+	                                                           UInt2         faceSize, u32 mipCount,
+	                                                           TextureFormat format) {
+		return EnqueueTexture(texture, pFaceData, 6, faceSize, mipCount, format);
+	}
+
+	TextureUploadTicket TextureUploadQueue::EnqueueTexture(TextureHandle texture, void const* const* pLayerData,
+	                                                       u32           layerCount, UInt2 size, u32 mipCount,
+	                                                       TextureFormat format) {
+		CKE_ASSERT(m_pDevice != nullptr);
+		CKE_ASSERT(texture.IsValid());
+		CKE_ASSERT(mipCount > 0);
+
+		u64 const firstCopy = m_QueuedCopies.size();
+		for (u32 layer = 0; layer < layerCount; ++layer) {
+			CKE_ASSERT(pLayerData[layer] != nullptr);
+			u8 const* pMipData = static_cast<u8 const*>(pLayerData[layer]);
+			for (u32 mip = 0; mip < mipCount; ++mip) {
+				UInt2 const mipSize{std::max(size.x >> mip, 1u), std::max(size.y >> mip, 1u)};
+				EnqueueMipCopies(pMipData, mip, layer, mipSize, format);
+				pMipData += GetTextureMipByteSize(format, mipSize.x, mipSize.y);
+			}
+		}
+
+		TextureUploadTicket const ticket{m_NextTicket++};
+		m_QueuedTextures.push(QueuedTexture{
+			ticket.m_Value, texture,
+			TextureSubresourceRange{
+				.m_AspectMask = TextureAspectMask::Color,
+				.m_BaseMip = 0,
+				.m_MipCount = mipCount,
+				.m_BaseLayer = 0,
+				.m_LayerCount = layerCount
+			},
+			m_QueuedCopies.size() - firstCopy
+		});
+		m_Stats.m_NumPendingUploads = m_NextTicket - 1 - m_LastCompletedTicket;
+		return ticket;
+	}
+
+	void TextureUploadQueue::EnqueueMipCopies(void const* pMipData, u32 mip, u32 layer, UInt2 mipSize,
+	                                          TextureFormat format) {
+		// Compressed formats are copied in whole rows of blocks
+		u32 const blockHeight = IsBlockCompressedFormat(format) ? 4 : 1;
+		u32 const numBlockRows = (mipSize.y + blockHeight - 1) / blockHeight;
+		u64 const blockRowSize = GetTextureMipByteSize(format, mipSize.x, blockHeight);
+		CKE_ASSERT(blockRowSize <= m_MaxCopySize); // A row can't be split
+
+		u32 const blockRowsPerCopy = static_cast<u32>(std::min<u64>(m_MaxCopySize / blockRowSize, numBlockRows));
+		for (u32 blockRow = 0; blockRow < numBlockRows; blockRow += blockRowsPerCopy) {
+			u32 const firstRow = blockRow * blockHeight;
+			u32 const numRows = std::min((blockRow + blockRowsPerCopy) * blockHeight, mipSize.y) - firstRow;
+			m_QueuedCopies.push(QueuedCopy{
+				static_cast<u8 const*>(pMipData) + blockRow * blockRowSize,
+				GetTextureMipByteSize(format, mipSize.x, numRows),
+				mip, layer, firstRow, UInt2{mipSize.x, numRows}
+			});
+		}
+	}
+
+	void TextureUploadQueue::Update() {
+		++m_UpdateNumber;
+		m_Stats.m_FrameUploadBytes = 0;
+		m_Stats.m_FrameStallNs = 0;
+
+		RetireBatches();
+
+		// The transfer command lists of a frame are reused once the device is back at the same frame in flight
+		auto const start = std::chrono::steady_clock::now();
+		bool       stalled = false;
+		while (!m_BatchesInFlight.empty() &&
+		       m_BatchesInFlight.front().m_UpdateNumber + RenderSettings::MAX_FRAMES_IN_FLIGHT <= m_UpdateNumber) {
+			WaitForOldestBatch();
+			stalled = true;
+		}
+		if (stalled) { RecordStall(ElapsedNs(start)); }
+
+		SubmitBatch(m_Settings.m_FrameBudgetInBytes);
+		m_Stats.m_NumPendingUploads = m_NextTicket - 1 - m_LastCompletedTicket;
+	}
+
+	bool TextureUploadQueue::IsUploadComplete(TextureUploadTicket ticket) const {
+		CKE_ASSERT(ticket.IsValid());
+		return ticket.m_Value <= m_LastCompletedTicket;
+	}
+
+	void TextureUploadQueue::WaitForUpload(TextureUploadTicket ticket) {
+		RetireBatches();
+		if (IsUploadComplete(ticket)) { return; }
+
+		auto const start = std::chrono::steady_clock::now();
+		while (!IsUploadComplete(ticket)) {
+			// Stage the rest of the upload first so it is waited for in as few batches as possible
+			bool const isSubmitted = ticket.m_Value <= m_LastSubmittedTicket;
+			if (isSubmitted || !SubmitBatch(std::numeric_limits<u64>::max())) { WaitForOldestBatch(); }
+			RetireBatches();
+		}
+		RecordStall(ElapsedNs(start));
+		m_Stats.m_NumPendingUploads = m_NextTicket - 1 - m_LastCompletedTicket;
+	}
+
+	bool TextureUploadQueue::SubmitBatch(u64 budgetInBytes) {
+		Vector<TextureBarrierDescription>                toTransferDst{};
+		Vector<TextureBarrierDescription>                toShaderReadOnly{};
+		Vector<Pair<TextureHandle, BufferImageCopyInfo>> copies{};
+		u64                                              stagedBytes = 0;
+
+		while (!m_QueuedCopies.empty()) {
+			QueuedCopy const& copy = m_QueuedCopies.front();
+			if (stagedBytes + copy.m_SizeInBytes > budgetInBytes) { break; }
+
+			u64 offset = 0;
+			if (!m_StagingAllocator.TryAllocate(copy.m_SizeInBytes, COPY_ALIGNMENT, offset)) { break; }
+			std::memcpy(m_pStagingData + offset, copy.m_pData, copy.m_SizeInBytes);
+			stagedBytes += copy.m_SizeInBytes;
+
+			QueuedTexture const& texture = m_QueuedTextures.front();
+			if (m_NumFrontCopiesStaged == 0) {
+				toTransferDst.push_back(TextureBarrierDescription{
+					.m_SrcStage = PipelineStage::AllCommands,
+					.m_SrcAccessMask = AccessMask::None,
+					.m_DstStage = PipelineStage::Transfer,
+					.m_DstAccessMask = AccessMask::Transfer_Write,
+					.m_OldLayout = TextureLayout::Undefined,
+					.m_NewLayout = TextureLayout::Transfer_Dst,
+					.m_Texture = texture.m_Texture,
+					.m_AspectMask = TextureAspectMask::Color,
+					.m_Range = texture.m_Range,
+				});
+			}
+
+			copies.emplace_back(texture.m_Texture, BufferImageCopyInfo{
+				                    .bufferOffset = offset,
+				                    .bufferRowLength = 0,
+				                    .bufferImageHeight = 0,
+				                    .imageSubresource = {
+					                    .m_AspectMask = TextureAspectMask::Color,
+					                    .m_MipLevel = copy.m_Mip,
+					                    .m_ArrayBaseLayer = copy.m_Layer,
+					                    .m_ArrayLayerCount = 1,
+				                    },
+				                    .imageOffset = {0, static_cast<i32>(copy.m_FirstRow), 0},
+				                    .imageExtent = UInt3{copy.m_Extent.x, copy.m_Extent.y, 1},
+			                    });
+			m_QueuedCopies.pop();
+
+			// The last copy of the texture leaves it ready to be sampled
+			if (++m_NumFrontCopiesStaged == texture.m_NumCopies) {
+				toShaderReadOnly.push_back(TextureBarrierDescription{
+					.m_SrcStage = PipelineStage::Transfer,
+					.m_SrcAccessMask = AccessMask::Transfer_Write,
+					.m_DstStage = PipelineStage::AllCommands,
+					.m_DstAccessMask = AccessMask::None,
+					.m_OldLayout = TextureLayout::Transfer_Dst,
+					.m_NewLayout = TextureLayout::Shader_ReadOnly,
+					.m_Texture = texture.m_Texture,
+					.m_AspectMask = TextureAspectMask::Color,
+					.m_Range = texture.m_Range,
+				});
+				m_LastSubmittedTicket = texture.m_Ticket;
+				m_QueuedTextures.pop();
+				m_NumFrontCopiesStaged = 0;
+			}
+		}
+		if (copies.empty()) { return false; }
+
+		// Textures are created with concurrent sharing, the transfer queue can change their layouts
+		TransferCommandList cmdList = m_pDevice->GetTransferCmdList();
+		cmdList.Begin();
+		if (!toTransferDst.empty()) { cmdList.Barrier(toTransferDst.data(), static_cast<u32>(toTransferDst.size())); }
+		for (auto const& [texture, copyInfo] : copies) {
+			cmdList.CopyBufferToTexture(m_StagingBuffer, texture, copyInfo);
+		}
+		if (!toShaderReadOnly.empty()) {
+			cmdList.Barrier(toShaderReadOnly.data(), static_cast<u32>(toShaderReadOnly.size()));
+		}
+		cmdList.End();
+
+		FenceHandle fence{};
+		if (m_FreeFences.empty()) { fence = m_pDevice->CreateFence(false); }
+		else {
+			fence = m_FreeFences.back();
+			m_FreeFences.pop_back();
+		}
+		m_pDevice->SubmitTransferCommandList(cmdList, {.m_SignalFence = fence});
+
+		u64 const batchNumber = m_NextBatchNumber++;
+		m_StagingAllocator.EndFrame(batchNumber);
+		m_BatchesInFlight.push_back(Batch{batchNumber, m_UpdateNumber, fence, m_LastSubmittedTicket});
+
+		m_Stats.m_FrameUploadBytes += stagedBytes;
+		m_Stats.m_TotalUploadBytes += stagedBytes;
+		return true;
+	}
+
+	void TextureUploadQueue::RetireBatches() {
+		// Transfer submissions finish in order, stop at the first one that didn't
+		while (!m_BatchesInFlight.empty() && m_pDevice->IsFenceSignaled(m_BatchesInFlight.front().m_Fence)) {
+			Batch const batch = m_BatchesInFlight.front();
+			m_BatchesInFlight.erase(m_BatchesInFlight.begin());
+
+			m_StagingAllocator.Retire(batch.m_BatchNumber);
+			m_LastCompletedTicket = batch.m_LastTicket;
+			m_pDevice->ResetFence(batch.m_Fence);
+			m_FreeFences.push_back(batch.m_Fence);
+		}
+	}
+
+	void TextureUploadQueue::WaitForOldestBatch() {
+		CKE_ASSERT(!m_BatchesInFlight.empty());
+		m_pDevice->WaitForFence(m_BatchesInFlight.front().m_Fence);
+		RetireBatches();
+	}
+
+	void TextureUploadQueue::RecordStall(u64 stallNs) {
+		m_Stats.m_FrameStallNs += stallNs;
+		m_Stats.m_MaxFrameStallNs = std::max(m_Stats.m_MaxFrameStallNs, m_Stats.m_FrameStallNs);
+	}
+}
@@ -1,7 +1,8 @@
-#include "CookieKat/Systems/RenderAPI/Vulkan/Conversions_Vk.h"
 #include "CookieKat/Systems/RenderUtils/TextureUploader.h"
 #include "CookieKat/Systems/RenderUtils/TextureSamplersCache.h"
 
+#include <algorithm>
+
 namespace CKE {
 	void TextureUploader::Initialize(RenderDevice* pDevice, u32 stagingBufferSize) {
 		// Create and fill staging buffer
@@ -63,18 +64,18 @@ namespace CKE {
 
 		TransferCommandList transferCtx = m_pDevice->GetTransferCmdList();
 
-		VkBufferImageCopy copyRegion{
+		BufferImageCopyInfo copyRegion{
 			.bufferOffset = 0,
 			.bufferRowLength = 0,
 			.bufferImageHeight = 0,
 			.imageSubresource = {
-				.aspectMask = ConversionsVk::GetVkImageAspectFlags(aspectType),
-				.mipLevel = 0,
-				.baseArrayLayer = 0,
-				.layerCount = 1,
+				.m_AspectMask = aspectType,
+				.m_MipLevel = 0,
+				.m_ArrayBaseLayer = 0,
+				.m_ArrayLayerCount = 1,
 			},
 			.imageOffset = {0, 0, 0},
-			.imageExtent = VkExtent3D{texSize.x, texSize.y, 1},
+			.imageExtent = UInt3{texSize.x, texSize.y, 1},
 		};
 
 		transferCtx.Begin();
@@ -116,6 +117,110 @@ namespace CKE {
 		m_pDevice->DestroySemaphore(imageLayoutToTransfer);
 	}
 
+	void TextureUploader::UploadTexture2DMips(TextureHandle targetTexture, void* pMipData,
+	                                          UInt2         texSize, u32 mipCount, TextureFormat format) {
+		CKE_ASSERT(pMipData != nullptr);
+		CKE_ASSERT(mipCount > 0);
+
+		// Offset of each mip inside the staging buffer
+		Vector<BufferImageCopyInfo> copyRegions{};
+		copyRegions.reserve(mipCount);
+		u64 textureByteSize = 0;
+		for (u32 mip = 0; mip < mipCount; ++mip) {
+			u32 const mipWidth = std::max(texSize.x >> mip, 1u);
+			u32 const mipHeight = std::max(texSize.y >> mip, 1u);
+			copyRegions.push_back(BufferImageCopyInfo{
+				.bufferOffset = textureByteSize,
+				.bufferRowLength = 0,
+				.bufferImageHeight = 0,
+				.imageSubresource = {
+					.m_AspectMask = TextureAspectMask::Color,
+					.m_MipLevel = mip,
+					.m_ArrayBaseLayer = 0,
+					.m_ArrayLayerCount = 1,
+				},
+				.imageOffset = {0, 0, 0},
+				.imageExtent = UInt3{mipWidth, mipHeight, 1},
+			});
+			textureByteSize += GetTextureMipByteSize(format, mipWidth, mipHeight);
+		}
+		CKE_ASSERT(textureByteSize <= m_StagingBufferSize);
+
+		m_pDevice->UploadBufferData_DEPR(m_StagingBuffer, pMipData, textureByteSize, 0);
+
+		TextureSubresourceRange const allMips{
+			.m_AspectMask = TextureAspectMask::Color,
+			.m_BaseMip = 0,
+			.m_MipCount = mipCount,
+			.m_BaseLayer = 0,
+			.m_LayerCount = 1
+		};
+
+		// Set image layout to Transfer Dst
+		//-----------------------------------------------------------------------------
+
+		CommandList graphicsCmdList = m_pDevice->GetGraphicsCmdList();
+		graphicsCmdList.Begin();
+		graphicsCmdList.Barrier(TextureBarrierDescription{
+			.m_SrcStage = PipelineStage::AllCommands,
+			.m_SrcAccessMask = AccessMask::None,
+			.m_DstStage = PipelineStage::Transfer,
+			.m_DstAccessMask = AccessMask::Transfer_Write,
+			.m_OldLayout = TextureLayout::Undefined,
+			.m_NewLayout = TextureLayout::Transfer_Dst,
+			.m_Texture = targetTexture,
+			.m_AspectMask = TextureAspectMask::Color,
+			.m_Range = allMips,
+		});
+		graphicsCmdList.End();
+		SemaphoreHandle imageLayoutTransfer = m_pDevice->CreateSemaphoreGPU();
+		m_pDevice->SubmitGraphicsCommandList(graphicsCmdList, {
+			                                     .m_SignalSemaphores = {imageLayoutTransfer}
+		                                     });
+
+		// Copy every mip from the staging buffer to the image
+		//-----------------------------------------------------------------------------
+
+		TransferCommandList transferCtx = m_pDevice->GetTransferCmdList();
+		transferCtx.Begin();
+		for (BufferImageCopyInfo const& copyRegion : copyRegions) {
+			transferCtx.CopyBufferToTexture(m_StagingBuffer, targetTexture, copyRegion);
+		}
+		transferCtx.End();
+		FenceHandle const transferFinished = m_pDevice->CreateFence(false);
+		m_pDevice->SubmitTransferCommandList(transferCtx, {
+			                                     .m_WaitSemaphores = {
+				                                     {imageLayoutTransfer, PipelineStage::Transfer}
+			                                     },
+			                                     .m_SignalSemaphores = {},
+			                                     .m_SignalFence = transferFinished
+		                                     });
+
+		// Set image layout to shader read only
+		//-----------------------------------------------------------------------------
+
+		m_pDevice->WaitForFence(transferFinished);
+		m_pDevice->ResetFence(transferFinished);
+		graphicsCmdList.Begin();
+		graphicsCmdList.Barrier(TextureBarrierDescription{
+			.m_SrcStage = PipelineStage::Transfer,
+			.m_SrcAccessMask = AccessMask::Transfer_Write,
+			.m_DstStage = PipelineStage::AllCommands,
+			.m_DstAccessMask = AccessMask::None,
+			.m_OldLayout = TextureLayout::Transfer_Dst,
+			.m_NewLayout = TextureLayout::Shader_ReadOnly,
+			.m_Texture = targetTexture,
+			.m_AspectMask = TextureAspectMask::Color,
+			.m_Range = allMips,
+		});
+		graphicsCmdList.End();
+		m_pDevice->SubmitGraphicsCommandList(graphicsCmdList, {.m_SignalFence = transferFinished});
+		m_pDevice->WaitForFence(transferFinished);
+
+		m_pDevice->DestroyFence(transferFinished);
+		m_pDevice->DestroySemaphore(imageLayoutTransfer);
+	}
+
 	void TextureUploader::UploadTextureCubeMap(TextureHandle targetTexture, void* pTextureData,
 	                                           UInt2         texFaceSize) {
 		CKE_ASSERT(pTextureData != nullptr);
@@ -161,18 +266,18 @@ namespace CKE {
 
 		transferCtx.Begin();
 		for (i32 i = 0; i < 6; ++i) {
-			VkBufferImageCopy copyRegion{
+			BufferImageCopyInfo copyRegion{
 				.bufferOffset = texFaceSize.x * i * pixelByteSize,
 				.bufferRowLength = texFaceSize.x * 6,
 				.bufferImageHeight = texFaceSize.y,
 				.imageSubresource = {
-					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-					.mipLevel = 0,
-					.baseArrayLayer = (u32)i,
-					.layerCount = 1,
+					.m_AspectMask = TextureAspectMask::Color,
+					.m_MipLevel = 0,
+					.m_ArrayBaseLayer = (u32)i,
+					.m_ArrayLayerCount = 1,
 				},
 				.imageOffset = {0, 0, 0},
-				.imageExtent = VkExtent3D{texFaceSize.x, texFaceSize.y, 1},
+				.imageExtent = UInt3{texFaceSize.x, texFaceSize.y, 1},
 			};
 
 			transferCtx.CopyBufferToTexture(m_StagingBuffer, targetTexture, copyRegion);
@@ -267,18 +372,18 @@ namespace CKE {
 
 		transferCtx.Begin();
 		for (i32 i = 0; i < 6; ++i) {
-			VkBufferImageCopy copyRegion{
+			BufferImageCopyInfo copyRegion{
 				.bufferOffset = texFaceSize.x * texFaceSize.y * pixelByteSize * i,
 				.bufferRowLength = 0,
 				.bufferImageHeight = 0,
 				.imageSubresource = {
-					.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
-					.mipLevel = 0,
-					.baseArrayLayer = (u32)i,
-					.layerCount = 1,
+					.m_AspectMask = TextureAspectMask::Color,
+					.m_MipLevel = 0,
+					.m_ArrayBaseLayer = (u32)i,
+					.m_ArrayLayerCount = 1,
 				},
 				.imageOffset = {0, 0, 0},
-				.imageExtent = VkExtent3D{texFaceSize.x, texFaceSize.y, 1},
+				.imageExtent = UInt3{texFaceSize.x, texFaceSize.y, 1},
 			};
 
 			transferCtx.CopyBufferToTexture(m_StagingBuffer, targetTexture, copyRegion);
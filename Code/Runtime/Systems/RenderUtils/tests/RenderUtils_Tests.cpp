@@ -0,0 +1,296 @@
+#include <gtest/gtest.h>
+
+#include "CookieKat/Systems/RenderAPI/RenderDevice.h"
+#include "CookieKat/Systems/RenderUtils/TextureUploadQueue.h"
+
+#include <lodepng.h>
+
+#include <chrono>
+#include <iostream>
+
+using namespace CKE;
+
+#ifdef CKE_GRAPHICS_NULL_BACKEND
+
+//-----------------------------------------------------------------------------
+
+namespace {
+	constexpr u64 KB = 1024;
+}
+
+class TextureUploadQueueFixture : public testing::Test
+{
+protected:
+	void SetUp() override {
+		m_Device.Initialize({1280, 720});
+		m_Data.resize(1024 * KB, 0xAB); // Enqueued uploads point to it, it can't be reallocated
+	}
+
+	void TearDown() override {
+		m_Queue.Shutdown();
+		for (TextureHandle texture : m_Textures) { m_Device.DestroyTexture(texture); }
+		EXPECT_EQ(m_Device.GetNumBuffers(), 0);
+		m_Device.Shutdown();
+	}
+
+	void InitializeQueue(u64 stagingSize, u64 frameBudget) {
+		m_Queue.Initialize(&m_Device, TextureUploadQueueSettings{stagingSize, frameBudget});
+	}
+
+	// Square RGBA texture, the data is shared by all the textures
+	TextureUploadTicket EnqueueTexture(u32 size, u32 mipCount, u32 layerCount = 1) {
+		TextureDesc desc{};
+		desc.m_Format = TextureFormat::R8G8B8A8_UNORM;
+		desc.m_Size = UInt3{size, size, 1};
+		desc.m_MipLevels = mipCount;
+		desc.m_ArraySize = layerCount;
+		TextureHandle const texture = m_Device.CreateTexture(desc);
+		m_Textures.push_back(texture);
+
+		u64 byteSize = 0;
+		for (u32 mip = 0; mip < mipCount; ++mip) {
+			byteSize += GetTextureMipByteSize(desc.m_Format, std::max(size >> mip, 1u), std::max(size >> mip, 1u));
+		}
+		EXPECT_LE(byteSize, m_Data.size());
+		m_UploadBytes += byteSize * layerCount;
+
+		if (layerCount == 6) {
+			void const* faces[6] = {m_Data.data(), m_Data.data(), m_Data.data(), m_Data.data(), m_Data.data(), m_Data.data()};
+			return m_Queue.EnqueueCubeMapMips(texture, faces, UInt2{size, size}, mipCount, desc.m_Format);
+		}
+		return m_Queue.EnqueueTexture2DMips(texture, m_Data.data(), UInt2{size, size}, mipCount, desc.m_Format);
+	}
+
+	// Updates the queue and ends the frame, its submissions stay readable until the next one is acquired
+	void NextFrame() {
+		m_Device.AcquireNextBackBuffer();
+		m_Queue.Update();
+
+		CommandList cmdList = m_Device.GetGraphicsCmdList();
+		cmdList.Begin();
+		cmdList.End();
+		m_Device.SubmitGraphicsCommandList(cmdList, {.m_SignalFence = m_Device.GetInFlightFence()});
+		m_Device.Present();
+	}
+
+	u64 CountSubmittedCommands(NullCommandType type) const {
+		u64 count = 0;
+		for (NullSubmission const& submission : m_Device.GetSubmissions()) { count += submission.m_pStream->Count(type); }
+		return count;
+	}
+
+	RenderDevice          m_Device{};
+	TextureUploadQueue    m_Queue{};
+	Vector<TextureHandle> m_Textures{};
+	Vector<u8>            m_Data{};
+	u64                   m_UploadBytes = 0;
+};
+
+TEST_F(TextureUploadQueueFixture, Burst_Of_Textures_Stays_Within_Frame_Budget) {
+	u64 const frameBudget = 256 * KB;
+	InitializeQueue(1024 * KB, frameBudget);
+
+	Vector<TextureUploadTicket> tickets{};
+	for (u32 i = 0; i < 300; ++i) { tickets.push_back(EnqueueTexture(64, 7)); }
+	EXPECT_EQ(m_Queue.GetStats().m_NumPendingUploads, 300);
+
+	u32 numFrames = 0;
+	while (!m_Queue.IsUploadComplete(tickets.back())) {
+		NextFrame();
+		EXPECT_LE(m_Queue.GetStats().m_FrameUploadBytes, frameBudget);
+		EXPECT_LE(m_Device.GetSubmissions().size(), 2); // One batch and the frame
+		ASSERT_LT(++numFrames, 1000);
+	}
+
+	// Every update but the last one fills most of the budget
+	EXPECT_GE(numFrames, m_UploadBytes / frameBudget);
+	EXPECT_LE(numFrames, m_UploadBytes / (frameBudget / 2) + 2);
+	EXPECT_EQ(m_Queue.GetStats().m_TotalUploadBytes, m_UploadBytes);
+	for (TextureUploadTicket ticket : tickets) { EXPECT_TRUE(m_Queue.IsUploadComplete(ticket)); }
+}
+
+TEST_F(TextureUploadQueueFixture, Uploads_Complete_When_Their_Fence_Signals) {
+	InitializeQueue(1024 * KB, 256 * KB);
+	m_Device.SetHoldSubmissions(true);
+
+	TextureUploadTicket const ticket = EnqueueTexture(64, 1);
+	m_Queue.Update();
+	EXPECT_EQ(m_Device.GetNumHeldSubmissions(), 1);
+	EXPECT_EQ(m_Queue.GetStats().m_FrameUploadBytes, m_UploadBytes);
+
+	// The copies are submitted but the GPU didn't run them
+	m_Queue.Update();
+	EXPECT_FALSE(m_Queue.IsUploadComplete(ticket));
+	EXPECT_EQ(m_Queue.GetStats().m_NumPendingUploads, 1);
+
+	m_Device.CompleteHeldSubmissions();
+	m_Queue.Update();
+	EXPECT_TRUE(m_Queue.IsUploadComplete(ticket));
+	EXPECT_EQ(m_Queue.GetStats().m_NumPendingUploads, 0);
+	EXPECT_EQ(m_Queue.GetNumBatchesInFlight(), 0);
+}
+
+TEST_F(TextureUploadQueueFixture, Full_Staging_Ring_Does_Not_Block_The_Update) {
+	InitializeQueue(64 * KB, 64 * KB);
+	m_Device.SetHoldSubmissions(true);
+
+	TextureUploadTicket const first = EnqueueTexture(128, 1);  // 64 KB
+	TextureUploadTicket const second = EnqueueTexture(128, 1);
+	m_Queue.Update();
+	EXPECT_EQ(m_Queue.GetStats().m_FrameUploadBytes, 64 * KB);
+
+	// The first upload holds the whole ring, nothing is staged until its fence signals
+	m_Queue.Update();
+	EXPECT_EQ(m_Queue.GetStats().m_FrameUploadBytes, 0);
+	EXPECT_EQ(m_Device.GetNumHeldSubmissions(), 1);
+
+	// Its command list is reused by this update, so it has to be waited for
+	m_Queue.Update();
+	EXPECT_TRUE(m_Queue.IsUploadComplete(first));
+	EXPECT_FALSE(m_Queue.IsUploadComplete(second));
+	EXPECT_EQ(m_Queue.GetStats().m_FrameUploadBytes, 64 * KB);
+	EXPECT_GE(m_Queue.GetStats().m_MaxFrameStallNs, m_Queue.GetStats().m_FrameStallNs);
+}
+
+TEST_F(TextureUploadQueueFixture, Large_Mips_Are_Split_In_Row_Bands) {
+	InitializeQueue(1024 * KB, 64 * KB);
+
+	// The 256 KB of the first mip are copied in bands of 64 rows, the rest of the mips fit in one copy
+	TextureUploadTicket const ticket = EnqueueTexture(256, 3);
+	m_Device.AcquireNextBackBuffer();
+	m_Queue.WaitForUpload(ticket);
+	EXPECT_TRUE(m_Queue.IsUploadComplete(ticket));
+
+	u64 numFirstMipCopies = 0;
+	u64 numCopies = 0;
+	for (NullSubmission const& submission : m_Device.GetSubmissions()) {
+		EXPECT_EQ(submission.m_Queue, QueueType::Transfer);
+		for (NullCommand const& command : submission.m_pStream->m_Commands) {
+			if (command.m_Type != NullCommandType::CopyBufferToTexture) { continue; }
+			++numCopies;
+			if (command.m_Args[3] == 0) { ++numFirstMipCopies; }
+		}
+	}
+	EXPECT_EQ(numFirstMipCopies, 4);
+	EXPECT_EQ(numCopies, 6);
+}
+
+TEST_F(TextureUploadQueueFixture, WaitForUpload_Ignores_The_Frame_Budget) {
+	InitializeQueue(1024 * KB, 16 * KB);
+	m_Device.SetHoldSubmissions(true);
+
+	TextureUploadTicket const first = EnqueueTexture(64, 7);
+	TextureUploadTicket const cubeMap = EnqueueTexture(64, 7, 6);
+	m_Device.AcquireNextBackBuffer();
+	m_Queue.WaitForUpload(cubeMap);
+
+	EXPECT_TRUE(m_Queue.IsUploadComplete(first));
+	EXPECT_TRUE(m_Queue.IsUploadComplete(cubeMap));
+	EXPECT_EQ(m_Device.GetNumHeldSubmissions(), 0);
+	EXPECT_EQ(m_Queue.GetStats().m_TotalUploadBytes, m_UploadBytes);
+
+	// Both textures go to the transfer layout before their copies and to the shader layout after them
+	EXPECT_EQ(CountSubmittedCommands(NullCommandType::Barrier), 4);
+	EXPECT_EQ(CountSubmittedCommands(NullCommandType::CopyBufferToTexture), 7 + 7 * 6);
+}
+
+//-----------------------------------------------------------------------------
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, it only prints timings. Run it with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+//
+// Main thread time of installing a 1024x1024 cube map. Before the compiled format, Install decoded six PNG
+// faces and uploaded them waiting for the copies. Now it enqueues the compiled BC7 mip chain and each
+// frame's Update stages a part of it.
+TEST_F(TextureUploadQueueFixture, DISABLED_Benchmark_CubeMap_Install_Stall) {
+	using Clock = std::chrono::high_resolution_clock;
+	constexpr u32 FACE_SIZE = 1024;
+
+	auto const toMs = [](Clock::duration duration) {
+		return std::chrono::duration<f64, std::milli>(duration).count();
+	};
+	auto const endFrame = [this]() {
+		CommandList cmdList = m_Device.GetGraphicsCmdList();
+		cmdList.Begin();
+		cmdList.End();
+		m_Device.SubmitGraphicsCommandList(cmdList, {.m_SignalFence = m_Device.GetInFlightFence()});
+		m_Device.Present();
+	};
+
+	TextureDesc desc{};
+	desc.m_Size = UInt3{FACE_SIZE, FACE_SIZE, 1};
+	desc.m_MiscFlags = TextureMiscFlags::Texture_CubeMap;
+	desc.m_ArraySize = 6;
+
+	// Before: PNG faces decoded in the install and uploaded waiting for the copies
+	//-----------------------------------------------------------------------------
+
+	InitializeQueue(64 * 1024 * KB, 16 * 1024 * KB);
+
+	Array<Vector<u8>, 6> pngFaces{};
+	for (u32 face = 0; face < 6; ++face) {
+		Vector<u8> pixels(FACE_SIZE * FACE_SIZE * 4);
+		for (u32 i = 0; i < pixels.size(); ++i) { pixels[i] = static_cast<u8>((i / 4 % FACE_SIZE) ^ (i * 31 + face)); }
+		lodepng::encode(pngFaces[face], pixels, FACE_SIZE, FACE_SIZE);
+	}
+
+	m_Device.AcquireNextBackBuffer();
+	auto const           pngStart = Clock::now();
+	Array<Vector<u8>, 6> rawFaces{};
+	void const*          pRawFaces[6];
+	for (u32 face = 0; face < 6; ++face) {
+		u32 width = 0;
+		u32 height = 0;
+		lodepng::decode(rawFaces[face], width, height, pngFaces[face]);
+		pRawFaces[face] = rawFaces[face].data();
+	}
+	desc.m_Format = TextureFormat::R8G8B8A8_SRGB;
+	m_Textures.push_back(m_Device.CreateTexture(desc));
+	m_Queue.WaitForUpload(m_Queue.EnqueueCubeMapMips(m_Textures.back(), pRawFaces, UInt2{FACE_SIZE, FACE_SIZE},
+	                                                 1, desc.m_Format));
+	f64 const pngInstallMs = toMs(Clock::now() - pngStart);
+	endFrame();
+
+	// After: compiled mips enqueued, staged within the frame budget
+	//-----------------------------------------------------------------------------
+
+	desc.m_Format = TextureFormat::BC7_SRGB;
+	desc.m_MipLevels = 11;
+
+	u64 faceByteSize = 0;
+	for (u32 mip = 0; mip < desc.m_MipLevels; ++mip) {
+		faceByteSize += GetTextureMipByteSize(desc.m_Format, std::max(FACE_SIZE >> mip, 1u),
+		                                      std::max(FACE_SIZE >> mip, 1u));
+	}
+	Vector<u8> const compiledFace(faceByteSize, 0xAB);
+	void const*      pCompiledFaces[6];
+	for (u32 face = 0; face < 6; ++face) { pCompiledFaces[face] = compiledFace.data(); }
+
+	auto const                installStart = Clock::now();
+	m_Textures.push_back(m_Device.CreateTexture(desc));
+	TextureUploadTicket const ticket = m_Queue.EnqueueCubeMapMips(m_Textures.back(), pCompiledFaces,
+	                                                              UInt2{FACE_SIZE, FACE_SIZE},
+	                                                              desc.m_MipLevels, desc.m_Format);
+	f64 const installMs = toMs(Clock::now() - installStart);
+
+	u32 numFrames = 0;
+	f64 maxUpdateMs = 0.0;
+	f64 maxStallMs = 0.0;
+	while (!m_Queue.IsUploadComplete(ticket)) {
+		m_Device.AcquireNextBackBuffer();
+		auto const updateStart = Clock::now();
+		m_Queue.Update();
+		maxUpdateMs = std::max(maxUpdateMs, toMs(Clock::now() - updateStart));
+		maxStallMs = std::max(maxStallMs, m_Queue.GetStats().m_FrameStallNs / 1000000.0);
+		endFrame();
+		ASSERT_LT(++numFrames, 1000);
+	}
+
+	std::cout << "[Benchmark] PNG cube map install: " << pngInstallMs << " ms in one frame" << std::endl;
+	std::cout << "[Benchmark] Compiled cube map install: " << installMs << " ms, then " << numFrames
+		<< " updates of at most " << maxUpdateMs << " ms, " << maxStallMs << " ms of them waiting for the GPU"
+		<< std::endl;
+}
+
+#endif
@@ -7,7 +7,7 @@ namespace CKE {
 	// Header that is added to all of the compiled resources
 	struct ResourceHeader
 	{
-		CKE_SERIALIZE(m_ResourceType, m_ResourcePath, m_DependencyPaths);
+		CKE_SERIALIZE_VERSIONED(1, m_ResourceType, m_ResourcePath, m_DependencyPaths);
 
 		u32          m_ResourceType{};
 		Path         m_ResourcePath;
@@ -164,7 +164,11 @@ namespace CKE {
 		//-----------------------------------------------------------------------------
 
 		// This method is useful for defining async Install(...) procedures.
-		virtual InstallResult CheckInstallStatus() { return InstallResult::Completed; }
+		// Polled every streaming update after a successful Install until it stops returning InProgress
+		virtual InstallResult CheckInstallStatus(InstallContext& ctx) { return InstallResult::Completed; }
+
+		// Blocks until an install in progress finishes, used by synchronous loads
+		virtual void WaitForInstall(InstallContext& ctx) { }
 
 		// Returns the resource types that the loader will handle
 		virtual Array<ResourceTypeID, 16> GetLoadableTypes() = 0;
@@ -66,6 +66,8 @@ namespace CKE {
 		void UpdateStreaming(); // Called on the main thread
 		void Shutdown();
 
+		void RecordMetrics(MetricsRegistry& metrics) override;
+
 		//-----------------------------------------------------------------------------
 		// Resource Management
 		//-----------------------------------------------------------------------------
@@ -145,6 +147,7 @@ namespace CKE {
 		Map<ResourceTypeID, ResourceLoader*> m_pResourceLoaders;
 		Map<ResourceID, ResourceRecord*>     m_ResourceRecords;
 		Map<Path, ResourceID>                m_PathToResourceID;
+		u64                                  m_NumResidentResources = 0; // Records ready to use
 
 		Queue<ResourceID> m_AvailableResourceIDs{};
 
@@ -161,6 +164,7 @@ namespace CKE {
 		Vector<PendingLoadRequest*>          m_WaitingInstallRequests; // Requests waiting installation until dependencies are loaded
 		Vector<PendingLoadRequest*>          m_RequestsToInstall; // Requests that will be installed this update
 		Vector<PendingLoadRequest*>          m_StillWaitingRequests; // Requests still waiting dependencies to install
+		Vector<AsyncInstallRequestState*>    m_InstallingRequests; // Requests whose loader is finishing the install
 		ResourceStreamingJob                 m_ResourceStreamingJob;
 	};
 }
@@ -3,6 +3,7 @@
 #include "CookieKat/Core/Platform/PlatformTime.h"
 #include "CookieKat/Core/Logging/LoggingSystem.h"
 #include "CookieKat/Core/Memory/Memory.h"
+#include "CookieKat/Core/Metrics/MetricsRegistry.h"
 
 #include <chrono>
 
@@ -20,7 +21,7 @@ namespace CKE {
 
 			LoadContext loadContext{&r->m_RawData, r->m_ResourceID, r->m_Path};
 			if (r->m_pLoader->Load(loadContext, r->m_LoadOutput) == LoadResult::Failed) {
-				g_LoggingSystem.Log(LogLevel::Error, LogChannel::Resources, "Resource loading failed successfully! {}\n", r->m_Path);
+				CKE_LOG(Error, Resources, "Resource loading failed successfully! {}", r->m_Path);
 			}
 			CKE_ASSERT(r->m_LoadOutput.m_pResource != nullptr);
 
@@ -50,12 +51,34 @@ namespace CKE {
 		};
 		m_PendingLoadRequestAllocator = TPoolAllocator<PendingLoadRequest>{ Memory::Alloc(sizeof(PendingLoadRequest) * 200), 200};
 		m_AsyncRequestStateAllocator = TPoolAllocator<AsyncLoadRequestState>{ Memory::Alloc(sizeof(AsyncLoadRequestState) * 200), 200};
-		m_AsyncInstallRequestAllocator = TPoolAllocator<AsyncInstallRequestState>{ Memory::Alloc(sizeof(AsyncInstallRequestState) * 200), 200};
+		// Installs waiting for GPU uploads can outlive many load requests
+		m_AsyncInstallRequestAllocator = TPoolAllocator<AsyncInstallRequestState>{ Memory::Alloc(sizeof(AsyncInstallRequestState) * 1000), 1000};
 	}
 
 	void ResourceSystem::UpdateStreaming() {
 		CKE_PROFILE_EVENT()
 
+		// Finish the installs the loaders completed, they don't touch the streaming job data
+		//-----------------------------------------------------------------------------
+		for (i32 i = m_InstallingRequests.size() - 1; i >= 0; --i) {
+			AsyncInstallRequestState* r = m_InstallingRequests[i];
+			InstallContext            installContext{r->m_pResource, r->m_InstallDependencies};
+			InstallResult const       status = r->m_pLoader->CheckInstallStatus(installContext);
+			if (status == InstallResult::InProgress) { continue; }
+
+			ResourceRecord* pRecord = m_ResourceRecords[r->m_ResourceID];
+			if (status == InstallResult::Failed) {
+				CKE_LOG(Error, Assets, "Failed Install: {}", pRecord->m_Path);
+			}
+
+			pRecord->m_IsReadyToUse = true;
+			++m_NumResidentResources;
+			CKE_LOG(Info, Resources, "Request Installed: {}", pRecord->m_Path);
+
+			ArrayUtils::RemoveElementAtIndexAndPack(m_InstallingRequests, i);
+			m_AsyncInstallRequestAllocator.Delete(r);
+		}
+
 		// We don't do anything if there is a streaming job currently in progress
 		if (!m_ResourceStreamingJob.GetIsComplete()) { return; }
 
@@ -91,8 +114,7 @@ namespace CKE {
 			// Process already loaded requests
 			//-----------------------------------------------------------------------------
 			for (AsyncLoadRequestState* r : m_ResourceStreamingJob.m_Loaded) {
-				g_LoggingSystem.Log(LogLevel::Info, LogChannel::Resources, "Request Loaded: {}\n",
-				                    r->m_Path);
+				CKE_LOG(Info, Resources, "Request Loaded: {}", r->m_Path);
 
 				ResourceRecord* pRecord = m_ResourceRecords[r->m_ResourceID];
 				pRecord->m_pResource = r->m_LoadOutput.m_pResource;
@@ -147,12 +169,24 @@ namespace CKE {
 
 				InstallContext installContext{pRecord->m_pResource, r->m_Deps};
 				if (pLoader->Install(installContext) != LoadResult::Successful) {
-					g_LoggingSystem.Log(LogLevel::Error, LogChannel::Assets, "Failed Install: {}", r->m_Path);
+					CKE_LOG(Error, Assets, "Failed Install: {}", r->m_Path);
+				}
+				else if (pLoader->CheckInstallStatus(installContext) == InstallResult::InProgress) {
+					// The resource is ready to use once the loader completes the install
+					AsyncInstallRequestState* pInstallRequest = m_AsyncInstallRequestAllocator.New();
+					pInstallRequest->m_ResourceID = r->m_ResourceID;
+					pInstallRequest->m_pResource = pRecord->m_pResource;
+					pInstallRequest->m_InstallDependencies = r->m_Deps;
+					pInstallRequest->m_pLoader = pLoader;
+					m_InstallingRequests.push_back(pInstallRequest);
+
+					m_PendingLoadRequestAllocator.Delete(r);
+					continue;
 				}
 
 				pRecord->m_IsReadyToUse = true;
-				g_LoggingSystem.Log(LogLevel::Info, LogChannel::Resources, "Request Installed: {}\n",
-				                    pRecord->m_Path);
+				++m_NumResidentResources;
+				CKE_LOG(Info, Resources, "Request Installed: {}", pRecord->m_Path);
 
 				m_PendingLoadRequestAllocator.Delete(r);
 			}
@@ -175,6 +209,14 @@ namespace CKE {
 		Memory::Free(m_AsyncInstallRequestAllocator.GetUnderlyingMemoryBuffer());
 	}
 
+	void ResourceSystem::RecordMetrics(MetricsRegistry& metrics) {
+		metrics.GetGauge("Resources.Records").Set(static_cast<f64>(m_ResourceRecords.size()));
+		metrics.GetGauge("Resources.Resident").Set(static_cast<f64>(m_NumResidentResources));
+		metrics.GetGauge("Resources.InProgressRequests").Set(static_cast<f64>(m_InProgressRequests.size()));
+		metrics.GetGauge("Resources.WaitingInstall").Set(static_cast<f64>(m_WaitingInstallRequests.size()));
+		metrics.GetGauge("Resources.Installing").Set(static_cast<f64>(m_InstallingRequests.size()));
+	}
+
 	//-----------------------------------------------------------------------------
 
 	ResourceID ResourceSystem::LoadResourceAsync(Path resourcePath) {
@@ -215,7 +257,7 @@ namespace CKE {
 
 		auto const loaderPair = m_pResourceLoaders.find(resTypeID);
 		if (loaderPair == m_pResourceLoaders.end()) {
-			g_LoggingSystem.Log(LogLevel::Fatal, LogChannel::Assets, "Couldn't find a loader for the given extension [{}]", extension);
+			CKE_LOG(Fatal, Assets, "Couldn't find a loader for the given extension [{}]", extension);
 		}
 		pLoader = loaderPair->second;
 	}
@@ -247,6 +289,7 @@ namespace CKE {
 		pRecord->m_Path = resourcePath;
 		pRecord->m_ID = id;
 		pRecord->m_IsReadyToUse = true;
+		++m_NumResidentResources;
 
 		m_PathToResourceID.insert({resourcePath, id});
 		m_ResourceRecords.insert({id, pRecord});
@@ -270,7 +313,7 @@ namespace CKE {
 		LoadContext loadContext{&blob, pRecord->m_ID, pRecord->m_Path};
 		LoadOutput  loadOutput{};
 		if (pLoader->Load(loadContext, loadOutput) == LoadResult::Failed) {
-			g_LoggingSystem.Log(LogLevel::Fatal, LogChannel::Assets, "Load failed -> AssetPath: {}", resourcePath);
+			CKE_LOG(Fatal, Assets, "Load failed -> AssetPath: {}", resourcePath);
 		}
 		CKE_ASSERT(loadOutput.m_pResource != nullptr);
 		pRecord->m_pResource = loadOutput.m_pResource;
@@ -292,15 +335,17 @@ namespace CKE {
 		// Install parent resource
 		InstallContext installContext{pRecord->m_pResource, installDependencies};
 		if (pLoader->Install(installContext) == LoadResult::Failed) {
-			g_LoggingSystem.Log(LogLevel::Fatal, LogChannel::Assets, "Install failed -> AssetPath: {}", resourcePath);
+			CKE_LOG(Fatal, Assets, "Install failed -> AssetPath: {}", resourcePath);
+		}
+		if (pLoader->CheckInstallStatus(installContext) == InstallResult::InProgress) {
+			pLoader->WaitForInstall(installContext);
 		}
 
 		// Time to load tracking
 		auto endTime = std::chrono::system_clock::now();
 		auto elapsed =
 				std::chrono::duration_cast<std::chrono::milliseconds>(endTime - startTime);
-		g_LoggingSystem.Log(LogLevel::Info, LogChannel::Assets, "Loaded {} / Time: {}ms\n", pRecord->m_Path,
-		                    elapsed.count());
+		CKE_LOG(Info, Assets, "Loaded {} / Time: {}ms", pRecord->m_Path, elapsed.count());
 
 		return pRecord->m_ID;
 	}
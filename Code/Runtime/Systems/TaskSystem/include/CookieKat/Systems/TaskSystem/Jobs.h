@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "TaskScheduler.h"
+
+#include <atomic>
+#include <coroutine>
+#include <mutex>
+#include <utility>
+
+namespace CKE {
+	class TaskSystem;
+	class JobTask;
+
+	// Number of unfinished jobs that were scheduled with it, waiting on it waits for all of them
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(JobCounter const&) = delete;
+		JobCounter& operator=(JobCounter const&) = delete;
+
+		inline u32  GetValue() const { return m_Value.load(std::memory_order_acquire); }
+		inline bool IsZero() const { return GetValue() == 0; }
+
+	private:
+		friend class TaskSystem;
+
+		std::atomic<u32> m_Value{0};
+	};
+
+	// Bookkeeping of a scheduled job, pooled by the TaskSystem and only used through JobHandle.
+	// A job runs once all its dependencies completed and completes when its function returns,
+	// or for coroutines when they reach the end.
+	class Job : public enki::ITaskSet
+	{
+	public:
+		void ExecuteRange(enki::TaskSetPartition range, u32 threadNum) override;
+
+	private:
+		friend class TaskSystem;
+		friend class JobHandle;
+		friend class JobTask;
+
+		TaskSystem*             m_pTaskSystem = nullptr;
+		Func<void()>            m_Function;
+		Func<void(u64, u64)>    m_RangeFunction;
+		std::coroutine_handle<> m_Coroutine;
+		JobCounter*             m_pCounter = nullptr;
+
+		std::atomic<u64>  m_RemainingItems{0};
+		std::atomic<u32>  m_PendingDependencies{0};
+		std::atomic<u32>  m_RefCount{0};
+		std::atomic<bool> m_IsSubmitted{false};
+		std::atomic<bool> m_IsComplete{false};
+
+		// Jobs waiting for this one, only modified before m_IsComplete is set
+		std::mutex   m_ContinuationsMutex;
+		Vector<Job*> m_Continuations;
+	};
+
+	// Reference to a scheduled job that can be waited on, used as a dependency or awaited in a JobTask.
+	// The job is recycled once it completed and no handle references it.
+	class JobHandle
+	{
+	public:
+		JobHandle() = default;
+		~JobHandle();
+
+		JobHandle(JobHandle const& other);
+		JobHandle(JobHandle&& other) noexcept;
+		JobHandle& operator=(JobHandle const& other);
+		JobHandle& operator=(JobHandle&& other) noexcept;
+
+		inline bool IsValid() const { return m_pJob != nullptr; }
+
+		// An invalid handle counts as complete
+		inline bool IsComplete() const {
+			return m_pJob == nullptr || m_pJob->m_IsComplete.load(std::memory_order_acquire);
+		}
+
+		// Suspends the coroutine until the job completes, it is resumed from a worker thread
+		struct Awaiter
+		{
+			bool await_ready() const { return m_pHandle->IsComplete(); }
+			void await_suspend(std::coroutine_handle<> coroutine) const;
+			void await_resume() const {}
+
+			JobHandle const* m_pHandle;
+		};
+
+		Awaiter operator co_await() const { return Awaiter{this}; }
+
+	private:
+		friend class TaskSystem;
+
+		// Takes a reference to the job
+		explicit JobHandle(Job* pJob);
+
+		Job* m_pJob = nullptr;
+	};
+
+	// Coroutine that runs as a job, scheduled with TaskSystem::Schedule.
+	// Awaiting a JobHandle inside it releases the worker thread instead of blocking it:
+	//
+	//	JobTask LoadLevel(TaskSystem* pTaskSystem) {
+	//		co_await pTaskSystem->ParallelFor(numChunks, DecompressChunks);
+	//		co_await pTaskSystem->Schedule(BuildNavMesh);
+	//	}
+	class JobTask
+	{
+	public:
+		struct FinalAwaiter
+		{
+			bool await_ready() const noexcept { return false; }
+			void await_suspend(std::coroutine_handle<> coroutine) const noexcept;
+			void await_resume() const noexcept {}
+
+			Job* m_pJob;
+		};
+
+		struct promise_type
+		{
+			JobTask get_return_object() {
+				return JobTask{std::coroutine_handle<promise_type>::from_promise(*this)};
+			}
+
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			FinalAwaiter        final_suspend() const noexcept { return FinalAwaiter{m_pJob}; }
+			void                return_void() const {}
+			void                unhandled_exception() const { std::terminate(); }
+
+			Job* m_pJob = nullptr;
+		};
+
+		JobTask(JobTask&& other) noexcept : m_Coroutine{std::exchange(other.m_Coroutine, {})} {}
+		~JobTask();
+
+		JobTask(JobTask const&) = delete;
+		JobTask& operator=(JobTask const&) = delete;
+		JobTask& operator=(JobTask&&) = delete;
+
+	private:
+		friend class TaskSystem;
+
+		explicit JobTask(std::coroutine_handle<promise_type> coroutine) : m_Coroutine{coroutine} {}
+
+		std::coroutine_handle<promise_type> m_Coroutine;
+	};
+}
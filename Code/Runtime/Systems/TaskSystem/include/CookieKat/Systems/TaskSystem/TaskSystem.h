@@ -1,8 +1,13 @@
 #pragma once
 
 #include "CookieKat/Systems/EngineSystem/IEngineSystem.h"
+#include "CookieKat/Systems/TaskSystem/Jobs.h"
 #include "TaskScheduler.h"
 
+#include <initializer_list>
+#include <mutex>
+#include <span>
+
 namespace CKE {
 	using ITaskSet = enki::ITaskSet;
 	using IPinnedTask = enki::IPinnedTask;
@@ -28,7 +33,59 @@ namespace CKE {
 
 		inline enki::TaskScheduler* GetScheduler() { return  &m_TaskScheduler; }
 
+		// Threads that run tasks, the calling thread included
+		inline u32 GetNumThreads() const { return m_TaskScheduler.GetNumTaskThreads(); }
+
+		// Jobs
+		//-----------------------------------------------------------------------------
+
+		// Runs the function once all the dependencies completed, without blocking the calling thread.
+		// If a counter is given it is incremented now and decremented when the job completes.
+		JobHandle Schedule(Func<void()> function, std::initializer_list<JobHandle> dependencies = {},
+		                   JobCounter* pCounter = nullptr);
+		JobHandle Schedule(Func<void()> function, JobCounter* pCounter);
+
+		// Starts the coroutine once all the dependencies completed, the job completes when the coroutine returns
+		JobHandle Schedule(JobTask task, std::initializer_list<JobHandle> dependencies = {},
+		                   JobCounter* pCounter = nullptr);
+
+		// Runs the function after the job completes
+		JobHandle Then(JobHandle const& job, Func<void()> function);
+
+		// Calls the function with [begin, end) ranges that cover [0, count) from all the worker threads.
+		// Ranges have at least grainSize items, 0 picks it from the count and the number of threads.
+		JobHandle ParallelFor(u64 count, Func<void(u64 begin, u64 end)> function, u64 grainSize = 0,
+		                      std::initializer_list<JobHandle> dependencies = {}, JobCounter* pCounter = nullptr);
+
+		// Runs other tasks on the calling thread until the job or all the jobs of the counter completed
+		void Wait(JobHandle const& job);
+		void Wait(JobCounter const& counter);
+
+		u64 GetParallelForGrainSize(u64 count) const;
+
+	private:
+		friend class Job;
+		friend class JobHandle;
+		friend class JobTask;
+
+		Job* AllocateJob();
+		void ReleaseJob(Job* pJob);
+
+		// Submits the job once the dependencies are complete
+		JobHandle ScheduleJob(Job* pJob, std::span<JobHandle const> dependencies, JobCounter* pCounter);
+		void      CompleteJob(Job* pJob);
+
+		// Resumes the coroutine from a worker thread once the job completes
+		void ResumeAfter(JobHandle const& job, std::coroutine_handle<> coroutine);
+
+		template <typename Predicate>
+		void WaitUntil(Predicate isDone);
+
 	private:
 		enki::TaskScheduler m_TaskScheduler;
+
+		std::mutex   m_JobPoolMutex;
+		Vector<Job*> m_FreeJobs;
+		Vector<Job*> m_AllJobs;
 	};
 }
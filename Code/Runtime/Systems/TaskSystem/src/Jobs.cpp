@@ -0,0 +1,79 @@
+#include "Jobs.h"
+
+#include "TaskSystem.h"
+
+namespace CKE {
+	void Job::ExecuteRange(enki::TaskSetPartition range, u32)
+	{
+		// Coroutines complete when they reach the end, which can happen from a later resume
+		if (m_Coroutine) {
+			m_Coroutine.resume();
+			return;
+		}
+
+		if (m_RangeFunction) { m_RangeFunction(range.start, range.end); }
+		else { m_Function(); }
+
+		// The last range to finish completes the job
+		u64 const numItems = range.end - range.start;
+		if (m_RemainingItems.fetch_sub(numItems, std::memory_order_acq_rel) == numItems) {
+			m_pTaskSystem->CompleteJob(this);
+		}
+	}
+
+	// JobHandle
+	//-----------------------------------------------------------------------------
+
+	JobHandle::JobHandle(Job* pJob) : m_pJob{pJob}
+	{
+		m_pJob->m_RefCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	JobHandle::~JobHandle()
+	{
+		if (m_pJob != nullptr) { m_pJob->m_pTaskSystem->ReleaseJob(m_pJob); }
+	}
+
+	JobHandle::JobHandle(JobHandle const& other) : m_pJob{other.m_pJob}
+	{
+		if (m_pJob != nullptr) { m_pJob->m_RefCount.fetch_add(1, std::memory_order_relaxed); }
+	}
+
+	JobHandle::JobHandle(JobHandle&& other) noexcept : m_pJob{std::exchange(other.m_pJob, nullptr)} {}
+
+	JobHandle& JobHandle::operator=(JobHandle const& other)
+	{
+		JobHandle copy{other};
+		std::swap(m_pJob, copy.m_pJob);
+		return *this;
+	}
+
+	JobHandle& JobHandle::operator=(JobHandle&& other) noexcept
+	{
+		JobHandle moved{std::move(other)};
+		std::swap(m_pJob, moved.m_pJob);
+		return *this;
+	}
+
+	void JobHandle::Awaiter::await_suspend(std::coroutine_handle<> coroutine) const
+	{
+		m_pHandle->m_pJob->m_pTaskSystem->ResumeAfter(*m_pHandle, coroutine);
+	}
+
+	// JobTask
+	//-----------------------------------------------------------------------------
+
+	JobTask::~JobTask()
+	{
+		// Only set if it was never scheduled
+		if (m_Coroutine) { m_Coroutine.destroy(); }
+	}
+
+	void JobTask::FinalAwaiter::await_suspend(std::coroutine_handle<> coroutine) const noexcept
+	{
+		// The frame is gone before the job completes, so waiters see all its destructors run
+		Job* pJob = m_pJob;
+		coroutine.destroy();
+		pJob->m_pTaskSystem->CompleteJob(pJob);
+	}
+}
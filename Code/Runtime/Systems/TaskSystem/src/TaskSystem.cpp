@@ -4,9 +4,13 @@
 #include "CookieKat/Core/Containers/String.h"
 
 #include "TaskScheduler.h"
+#include "CookieKat/Core/Platform/Asserts.h"
 #include "CookieKat/Core/Platform/PlatformTime.h"
 
 #include "format"
+#include <algorithm>
+#include <limits>
+#include <thread>
 
 namespace CKE
 {
@@ -15,12 +19,12 @@ namespace CKE
 	static void OnThreadStart(u32 threadNum)
 	{
 		String name = std::format("Worker {}", threadNum);
-		OPTICK_START_THREAD(name.c_str());
+		CKE_PROFILE_THREAD_START(name.c_str());
 	}
 
 	static void OnThreadStop(u32 threadNum)
 	{
-		OPTICK_STOP_THREAD();
+		CKE_PROFILE_THREAD_STOP();
 	}
 
 	//-----------------------------------------------------------------------------
@@ -37,5 +41,191 @@ namespace CKE
 	void TaskSystem::Shutdown()
 	{
 		m_TaskScheduler.WaitforAllAndShutdown();
+
+		// Every job must have completed and have no handles left
+		CKE_ASSERT(m_FreeJobs.size() == m_AllJobs.size());
+		for (Job* pJob : m_AllJobs) { delete pJob; }
+		m_AllJobs.clear();
+		m_FreeJobs.clear();
+	}
+
+	// Jobs
+	//-----------------------------------------------------------------------------
+
+	JobHandle TaskSystem::Schedule(Func<void()> function, std::initializer_list<JobHandle> dependencies,
+	                               JobCounter* pCounter)
+	{
+		Job* pJob = AllocateJob();
+		pJob->m_Function = std::move(function);
+		return ScheduleJob(pJob, {dependencies.begin(), dependencies.size()}, pCounter);
+	}
+
+	JobHandle TaskSystem::Schedule(Func<void()> function, JobCounter* pCounter)
+	{
+		return Schedule(std::move(function), {}, pCounter);
+	}
+
+	JobHandle TaskSystem::Schedule(JobTask task, std::initializer_list<JobHandle> dependencies, JobCounter* pCounter)
+	{
+		CKE_ASSERT(task.m_Coroutine);
+
+		Job* pJob = AllocateJob();
+		task.m_Coroutine.promise().m_pJob = pJob;
+		pJob->m_Coroutine = std::exchange(task.m_Coroutine, {});
+		return ScheduleJob(pJob, {dependencies.begin(), dependencies.size()}, pCounter);
+	}
+
+	JobHandle TaskSystem::Then(JobHandle const& job, Func<void()> function)
+	{
+		return Schedule(std::move(function), {job});
+	}
+
+	JobHandle TaskSystem::ParallelFor(u64 count, Func<void(u64 begin, u64 end)> function, u64 grainSize,
+	                                  std::initializer_list<JobHandle> dependencies, JobCounter* pCounter)
+	{
+		CKE_ASSERT(count <= std::numeric_limits<u32>::max());
+		if (count == 0) { return Schedule([] {}, dependencies, pCounter); }
+
+		Job* pJob = AllocateJob();
+		pJob->m_RangeFunction = std::move(function);
+		pJob->m_SetSize = static_cast<u32>(count);
+		pJob->m_MinRange = static_cast<u32>(grainSize == 0 ? GetParallelForGrainSize(count) : grainSize);
+		pJob->m_RemainingItems.store(count, std::memory_order_relaxed);
+		return ScheduleJob(pJob, {dependencies.begin(), dependencies.size()}, pCounter);
+	}
+
+	void TaskSystem::Wait(JobHandle const& job)
+	{
+		Job* pJob = job.m_pJob;
+		if (pJob == nullptr) { return; }
+
+		// Function jobs complete inside their task, once submitted enkiTS can wait on it and sleep if needed
+		if (!pJob->m_Coroutine) {
+			WaitUntil([pJob] { return pJob->m_IsSubmitted.load(std::memory_order_acquire); });
+			m_TaskScheduler.WaitforTask(pJob);
+		}
+		WaitUntil([&job] { return job.IsComplete(); });
+	}
+
+	void TaskSystem::Wait(JobCounter const& counter)
+	{
+		WaitUntil([&counter] { return counter.IsZero(); });
+	}
+
+	u64 TaskSystem::GetParallelForGrainSize(u64 count) const
+	{
+		// A few ranges per thread so that threads that finish early can steal the remaining ones
+		constexpr u64 RANGES_PER_THREAD = 4;
+		return std::max<u64>(1, count / (m_TaskScheduler.GetNumTaskThreads() * RANGES_PER_THREAD));
+	}
+
+	//-----------------------------------------------------------------------------
+
+	Job* TaskSystem::AllocateJob()
+	{
+		Job* pJob = nullptr;
+		{
+			std::lock_guard lock{m_JobPoolMutex};
+			if (!m_FreeJobs.empty()) {
+				pJob = m_FreeJobs.back();
+				m_FreeJobs.pop_back();
+			}
+			else {
+				pJob = new Job{};
+				m_AllJobs.push_back(pJob);
+			}
+		}
+
+		// A completed job is released from inside its task, the worker may still be returning from it
+		if (!pJob->GetIsComplete()) { m_TaskScheduler.WaitforTask(pJob); }
+
+		pJob->m_pTaskSystem = this;
+		pJob->m_Coroutine = {};
+		pJob->m_pCounter = nullptr;
+		pJob->m_SetSize = 1;
+		pJob->m_MinRange = 1;
+		pJob->m_RemainingItems.store(1, std::memory_order_relaxed);
+		pJob->m_IsSubmitted.store(false, std::memory_order_relaxed);
+		pJob->m_IsComplete.store(false, std::memory_order_relaxed);
+		return pJob;
+	}
+
+	void TaskSystem::ReleaseJob(Job* pJob)
+	{
+		if (pJob->m_RefCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			std::lock_guard lock{m_JobPoolMutex};
+			m_FreeJobs.push_back(pJob);
+		}
+	}
+
+	JobHandle TaskSystem::ScheduleJob(Job* pJob, std::span<JobHandle const> dependencies, JobCounter* pCounter)
+	{
+		if (pCounter != nullptr) {
+			pCounter->m_Value.fetch_add(1, std::memory_order_relaxed);
+			pJob->m_pCounter = pCounter;
+		}
+
+		// The scheduler keeps a reference until the job completes, the handle the other one
+		pJob->m_RefCount.store(1, std::memory_order_relaxed);
+		JobHandle handle{pJob};
+
+		// The extra dependency keeps the job from being submitted while the others are added
+		pJob->m_PendingDependencies.store(1, std::memory_order_relaxed);
+		for (JobHandle const& dependency : dependencies) {
+			Job* pDependency = dependency.m_pJob;
+			if (pDependency == nullptr) { continue; }
+
+			std::lock_guard lock{pDependency->m_ContinuationsMutex};
+			if (!pDependency->m_IsComplete.load(std::memory_order_relaxed)) {
+				pJob->m_PendingDependencies.fetch_add(1, std::memory_order_relaxed);
+				pDependency->m_Continuations.push_back(pJob);
+			}
+		}
+
+		if (pJob->m_PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+			pJob->m_IsSubmitted.store(true, std::memory_order_release);
+			m_TaskScheduler.AddTaskSetToPipe(pJob);
+		}
+		return handle;
+	}
+
+	void TaskSystem::CompleteJob(Job* pJob)
+	{
+		// Captures are released before anyone sees the job complete
+		pJob->m_Function = nullptr;
+		pJob->m_RangeFunction = nullptr;
+
+		{
+			std::lock_guard lock{pJob->m_ContinuationsMutex};
+			pJob->m_IsComplete.store(true, std::memory_order_release);
+		}
+
+		// No continuations can be added anymore
+		for (Job* pContinuation : pJob->m_Continuations) {
+			if (pContinuation->m_PendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+				pContinuation->m_IsSubmitted.store(true, std::memory_order_release);
+				m_TaskScheduler.AddTaskSetToPipe(pContinuation);
+			}
+		}
+		pJob->m_Continuations.clear();
+
+		if (pJob->m_pCounter != nullptr) { pJob->m_pCounter->m_Value.fetch_sub(1, std::memory_order_release); }
+		ReleaseJob(pJob);
+	}
+
+	void TaskSystem::ResumeAfter(JobHandle const& job, std::coroutine_handle<> coroutine)
+	{
+		Schedule([coroutine] { coroutine.resume(); }, {job});
+	}
+
+	template <typename Predicate>
+	void TaskSystem::WaitUntil(Predicate isDone)
+	{
+		u32 spinCount = 0;
+		while (!isDone()) {
+			// Runs one of the pending tasks if there is any
+			m_TaskScheduler.WaitforTask(nullptr);
+			if (++spinCount > 64) { std::this_thread::yield(); }
+		}
 	}
 }
\ No newline at end of file
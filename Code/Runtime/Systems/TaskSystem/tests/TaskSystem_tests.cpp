@@ -0,0 +1,237 @@
+#include "CookieKat/Systems/TaskSystem/TaskSystem.h"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <mutex>
+
+using namespace CKE;
+
+//-----------------------------------------------------------------------------
+
+class JobsFixture : public testing::Test
+{
+protected:
+	void SetUp() override { m_TaskSystem.Initialize(); }
+	void TearDown() override { m_TaskSystem.Shutdown(); }
+
+	TaskSystem m_TaskSystem{};
+};
+
+TEST_F(JobsFixture, Schedule_And_Wait) {
+	std::atomic<u32> value{0};
+	JobHandle        job = m_TaskSystem.Schedule([&value] { value = 1; });
+	m_TaskSystem.Wait(job);
+
+	EXPECT_TRUE(job.IsComplete());
+	EXPECT_EQ(value, 1);
+	EXPECT_TRUE(JobHandle{}.IsComplete());
+}
+
+TEST_F(JobsFixture, Dependencies_Run_In_Order) {
+	std::mutex  mutex;
+	Vector<u32> order{};
+	auto        push = [&](u32 value) {
+		return [&, value] {
+			std::lock_guard lock{mutex};
+			order.push_back(value);
+		};
+	};
+
+	// Diamond, 0 -> {1, 2} -> 3 -> 4
+	JobHandle const root = m_TaskSystem.Schedule(push(0));
+	JobHandle const left = m_TaskSystem.Schedule(push(1), {root});
+	JobHandle const right = m_TaskSystem.Schedule(push(2), {root});
+	JobHandle const join = m_TaskSystem.Schedule(push(3), {left, right});
+	JobHandle const last = m_TaskSystem.Then(join, push(4));
+	m_TaskSystem.Wait(last);
+
+	ASSERT_EQ(order.size(), 5);
+	EXPECT_EQ(order[0], 0);
+	EXPECT_EQ(std::min(order[1], order[2]), 1);
+	EXPECT_EQ(std::max(order[1], order[2]), 2);
+	EXPECT_EQ(order[3], 3);
+	EXPECT_EQ(order[4], 4);
+}
+
+TEST_F(JobsFixture, Dependency_On_Completed_Job) {
+	JobHandle const first = m_TaskSystem.Schedule([] {});
+	m_TaskSystem.Wait(first);
+
+	bool            hasRun = false;
+	JobHandle const second = m_TaskSystem.Then(first, [&hasRun] { hasRun = true; });
+	m_TaskSystem.Wait(second);
+	EXPECT_TRUE(hasRun);
+}
+
+TEST_F(JobsFixture, Counter) {
+	JobCounter       counter{};
+	std::atomic<u32> sum{0};
+	for (u32 i = 1; i <= 100; ++i) {
+		m_TaskSystem.Schedule([&sum, i] { sum += i; }, &counter);
+	}
+	m_TaskSystem.Wait(counter);
+
+	EXPECT_TRUE(counter.IsZero());
+	EXPECT_EQ(sum, 5050);
+}
+
+TEST_F(JobsFixture, ParallelFor_Covers_Range) {
+	constexpr u64    COUNT = 100'003;
+	Vector<u8>       visits(COUNT, 0);
+	std::atomic<u32> numRanges{0};
+
+	JobHandle const job = m_TaskSystem.ParallelFor(COUNT, [&](u64 begin, u64 end) {
+		for (u64 i = begin; i < end; ++i) { ++visits[i]; }
+		++numRanges;
+	});
+	m_TaskSystem.Wait(job);
+
+	EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](u8 visit) { return visit == 1; }));
+	EXPECT_GE(numRanges, 1);
+	EXPECT_GE(m_TaskSystem.GetParallelForGrainSize(COUNT), 1);
+
+	// Empty ranges still complete
+	m_TaskSystem.Wait(m_TaskSystem.ParallelFor(0, [](u64, u64) { FAIL(); }));
+}
+
+//-----------------------------------------------------------------------------
+
+static JobTask SumCoroutine(TaskSystem* pTaskSystem, std::atomic<u64>* pSum) {
+	// Both children run while the coroutine is suspended
+	JobHandle const first = pTaskSystem->Schedule([pSum] { *pSum += 1; });
+	JobHandle const second = pTaskSystem->ParallelFor(1000, [pSum](u64 begin, u64 end) { *pSum += end - begin; });
+	co_await first;
+	co_await second;
+
+	EXPECT_EQ(*pSum, 1001);
+	co_await pTaskSystem->Schedule([pSum] { *pSum = *pSum * 2; });
+}
+
+static JobTask NestedCoroutine(TaskSystem* pTaskSystem, std::atomic<u64>* pSum) {
+	co_await pTaskSystem->Schedule(SumCoroutine(pTaskSystem, pSum));
+	*pSum += 1;
+}
+
+TEST_F(JobsFixture, Coroutines) {
+	std::atomic<u64> sum{0};
+	JobHandle const  job = m_TaskSystem.Schedule(NestedCoroutine(&m_TaskSystem, &sum));
+	m_TaskSystem.Wait(job);
+	EXPECT_EQ(sum, 2003);
+
+	// Coroutines can be dependencies and be waited through counters
+	JobCounter counter{};
+	sum = 0;
+	JobHandle const coroutine = m_TaskSystem.Schedule(SumCoroutine(&m_TaskSystem, &sum), {}, &counter);
+	m_TaskSystem.Schedule([&sum] { sum += 1; }, {coroutine}, &counter);
+	m_TaskSystem.Wait(counter);
+	EXPECT_EQ(sum, 2003);
+}
+
+static JobTask HoldValueCoroutine(std::shared_ptr<u32> value) { co_return; }
+
+TEST(Jobs, Unscheduled_Coroutine_Is_Destroyed) {
+	std::shared_ptr<u32> value = std::make_shared<u32>(0);
+	{
+		JobTask task = HoldValueCoroutine(value);
+		EXPECT_EQ(value.use_count(), 2);
+	}
+	EXPECT_EQ(value.use_count(), 1);
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_F(JobsFixture, Spawn_Many_Jobs) {
+	constexpr u32 NUM_JOBS = 10'000;
+
+	JobCounter       counter{};
+	std::atomic<u32> numExecuted{0};
+	for (u32 i = 0; i < NUM_JOBS; ++i) { m_TaskSystem.Schedule([&numExecuted] { numExecuted++; }, &counter); }
+	m_TaskSystem.Wait(counter);
+
+	EXPECT_TRUE(counter.IsZero());
+	EXPECT_EQ(numExecuted, NUM_JOBS);
+}
+
+TEST_F(JobsFixture, Long_Continuation_Chain) {
+	constexpr u32 NUM_JOBS = 10'000;
+
+	std::atomic<u32> numExecuted{0};
+	std::atomic<u32> numOutOfOrder{0};
+	auto             step = [&](u32 index) {
+		return [&, index] { if (numExecuted++ != index) { numOutOfOrder++; } };
+	};
+
+	JobHandle job = m_TaskSystem.Schedule(step(0));
+	for (u32 i = 1; i < NUM_JOBS; ++i) { job = m_TaskSystem.Then(job, step(i)); }
+	m_TaskSystem.Wait(job);
+
+	EXPECT_EQ(numExecuted, NUM_JOBS);
+	EXPECT_EQ(numOutOfOrder, 0);
+}
+
+// Benchmarks
+//-----------------------------------------------------------------------------
+
+// Disabled, they only print timings. Run them with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+
+namespace {
+	constexpr u32 BENCHMARK_RUNS = 5;
+	constexpr u32 BENCHMARK_JOBS = 10'000;
+
+	template <typename Func>
+	f64 BestNsPerJob(Func&& run) {
+		f64 bestNs = std::numeric_limits<f64>::max();
+		for (u32 i = 0; i < BENCHMARK_RUNS; ++i) {
+			auto const start = std::chrono::high_resolution_clock::now();
+			run();
+			auto const end = std::chrono::high_resolution_clock::now();
+			bestNs = std::min(bestNs, std::chrono::duration<f64, std::nano>(end - start).count() / BENCHMARK_JOBS);
+		}
+		return bestNs;
+	}
+
+	struct EmptyTaskSet : ITaskSet
+	{
+		void ExecuteRange(enki::TaskSetPartition, u32) override {}
+	};
+}
+
+// Spawn and wait overhead of empty jobs, raw enkiTS task sets preallocated by the caller as the baseline
+TEST_F(JobsFixture, DISABLED_Benchmark_SpawnAndWait) {
+	Vector<EmptyTaskSet> taskSets(BENCHMARK_JOBS);
+	f64 const            enkiNs = BestNsPerJob([&] {
+		for (EmptyTaskSet& taskSet : taskSets) { m_TaskSystem.ScheduleTask(&taskSet); }
+		for (EmptyTaskSet& taskSet : taskSets) { m_TaskSystem.WaitForTask(&taskSet); }
+	});
+
+	f64 const jobsNs = BestNsPerJob([&] {
+		JobCounter counter{};
+		for (u32 i = 0; i < BENCHMARK_JOBS; ++i) { m_TaskSystem.Schedule([] {}, &counter); }
+		m_TaskSystem.Wait(counter);
+	});
+
+	std::cout << "[Benchmark] Spawn and wait, enkiTS: " << enkiNs << " ns, jobs: " << jobsNs << " ns per job\n";
+}
+
+// Chain where each job starts when the previous one completes, enkiTS dependencies as the baseline
+TEST_F(JobsFixture, DISABLED_Benchmark_Continuations) {
+	Vector<EmptyTaskSet>     taskSets(BENCHMARK_JOBS);
+	Vector<enki::Dependency> dependencies(BENCHMARK_JOBS - 1);
+	for (u32 i = 1; i < BENCHMARK_JOBS; ++i) { dependencies[i - 1].SetDependency(&taskSets[i - 1], &taskSets[i]); }
+	f64 const enkiNs = BestNsPerJob([&] {
+		m_TaskSystem.ScheduleTask(&taskSets[0]);
+		m_TaskSystem.WaitForTask(&taskSets.back());
+	});
+	dependencies.clear();
+
+	f64 const jobsNs = BestNsPerJob([&] {
+		JobHandle job = m_TaskSystem.Schedule([] {});
+		for (u32 i = 1; i < BENCHMARK_JOBS; ++i) { job = m_TaskSystem.Then(job, [] {}); }
+		m_TaskSystem.Wait(job);
+	});
+
+	std::cout << "[Benchmark] Continuation chain, enkiTS: " << enkiNs << " ns, jobs: " << jobsNs << " ns per job\n";
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "CookieKat/Systems/TextureProcessing/TextureMips.h"
+
+// Offline filtering of cube maps for image based lighting.
+// Faces are ordered +X, -X, +Y, -Y, +Z, -Z with the orientation of the Vulkan cube map layers.
+
+namespace CKE::TextureProcessing {
+	// Square faces of a single mip level of a cube map
+	struct CubeMap
+	{
+		u32             m_FaceSize = 0;
+		Array<Image, 6> m_Faces{};
+
+		// Bilinear sample of the face pointed by the direction, doesn't filter across face edges
+		Vec4 Sample(Vec3 const& direction) const;
+	};
+
+	// Normalized direction of the point with coordinates (u, v) in [0, 1] of a face
+	Vec3 GetCubeMapDirection(u32 face, f32 u, f32 v);
+
+	// Face pointed by the direction and the coordinates in [0, 1] of the point inside of it
+	void GetCubeMapFaceCoords(Vec3 const& direction, u32& outFace, f32& outU, f32& outV);
+
+	// Box filtered mips of the cube map down to 1x1, the first entry is the cube map itself
+	Vector<CubeMap> GenerateCubeMapMips(CubeMap const& cubeMap);
+
+	// Computes one face of the GGX prefiltered radiance for the given roughness (split sum approximation, N = V = R).
+	// Samples the box filtered mips of the source with filtered importance sampling to avoid aliasing with few samples.
+	Image PrefilterCubeMapFace(Vector<CubeMap> const& sourceMips, u32 face, u32 faceSize,
+	                           f32 roughness, u32 sampleCount);
+}
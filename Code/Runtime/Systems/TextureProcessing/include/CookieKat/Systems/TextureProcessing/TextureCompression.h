@@ -0,0 +1,35 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Math.h"
+
+// Block compression of RGBA8 images into the BCn formats sampled by the GPU.
+// All formats encode blocks of 4x4 texels, images that aren't multiple of 4 are padded
+// repeating their last row and column.
+
+namespace CKE::TextureProcessing {
+	enum class BlockFormat : u8
+	{
+		BC1, // RGB, 1 bit alpha. 8 bytes per block
+		BC3, // RGBA, interpolated alpha. 16 bytes per block
+		BC5, // RG, two independent channels, used for normal maps. 16 bytes per block
+		BC7, // RGBA, high quality. 16 bytes per block
+	};
+
+	u32 GetBlockByteSize(BlockFormat format);
+	u64 GetCompressedImageByteSize(BlockFormat format, u32 width, u32 height);
+
+	inline u32 GetBlockCount(u32 texels) { return (texels + 3) / 4; }
+
+	// Compresses the blocks in the rows [blockRowBegin, blockRowEnd) of the image.
+	// pOutBlocks points to the start of the compressed image, each row is written to its final position
+	// so different ranges can be compressed in parallel.
+	void CompressBlockRows(u8 const* pRGBA8, u32 width, u32 height, BlockFormat format,
+	                       u32 blockRowBegin, u32 blockRowEnd, u8* pOutBlocks);
+
+	void CompressImage(u8 const* pRGBA8, u32 width, u32 height, BlockFormat format, Vector<u8>& outBlocks);
+
+	// Decodes a compressed image back to RGBA8, used to measure the compression error.
+	// BC7 only supports the single subset mode used by CompressImage.
+	void DecompressImage(u8 const* pBlocks, u32 width, u32 height, BlockFormat format, Vector<u8>& outRGBA8);
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/Math/Math.h"
+
+// Offline mip chain generation. Filtering is done in linear space with floating point
+// precision, images are only converted back to 8 bits once each mip has been computed.
+
+namespace CKE::TextureProcessing {
+	enum class MipFilter : u8
+	{
+		Box,    // Average of the source texels covered by each destination texel
+		Kaiser, // Windowed sinc, sharper mips with less aliasing than a box filter
+	};
+
+	// How the texels of an image have to be interpreted when filtering
+	enum class ImageContent : u8
+	{
+		Color_SRGB,   // RGB is sRGB encoded, filtered in linear space. Alpha is always linear
+		Color_Linear, // Data that is already linear, roughness, metalness, masks...
+		NormalMap,    // Tangent space normals, renormalized after filtering
+	};
+
+	// Floating point RGBA image in the space used for filtering
+	struct Image
+	{
+		u32          m_Width = 0;
+		u32          m_Height = 0;
+		Vector<Vec4> m_Texels{};
+
+		inline Vec4 const& GetTexel(u32 x, u32 y) const { return m_Texels[y * m_Width + x]; }
+	};
+
+	// Number of mips in a full chain down to 1x1
+	u32 ComputeMipCount(u32 width, u32 height);
+
+	// Conversion from/to RGBA8 texels
+	Image DecodeImage(u8 const* pRGBA8, u32 width, u32 height, ImageContent content);
+	void  EncodeImage(Image const& image, ImageContent content, Vector<u8>& outRGBA8);
+
+	// Returns the next mip of the image, half the size rounded down on each axis
+	Image DownsampleImage(Image const& image, MipFilter filter, ImageContent content);
+
+	// Peak signal-to-noise ratio in dB between two RGBA8 images over the channels set in the mask (bit 0 = R).
+	// Returns infinity for identical images.
+	f64 ComputePSNR(u8 const* pReference, u8 const* pImage, u64 texelCount, u32 channelMask = 0b1111);
+
+	// sRGB transfer function
+	f32 SRGBToLinear(f32 value);
+	f32 LinearToSRGB(f32 value);
+}
@@ -0,0 +1,178 @@
+#include "CubeMapFiltering.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace CKE::TextureProcessing {
+	namespace {
+		// Van der Corput radical inverse in base 2
+		f32 RadicalInverse(u32 bits) {
+			bits = (bits << 16u) | (bits >> 16u);
+			bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+			bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+			bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+			bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+			return static_cast<f32>(bits) * 2.3283064365386963e-10f;
+		}
+
+		// Trilinear sample of the mip chain
+		Vec4 SampleCubeMapLod(Vector<CubeMap> const& mips, Vec3 const& direction, f32 lod) {
+			lod = std::clamp(lod, 0.0f, static_cast<f32>(mips.size() - 1));
+			u32 const mip0 = static_cast<u32>(lod);
+			u32 const mip1 = std::min(mip0 + 1, static_cast<u32>(mips.size() - 1));
+			f32 const t = lod - static_cast<f32>(mip0);
+
+			Vec4 const sample0 = mips[mip0].Sample(direction);
+			if (t == 0.0f || mip0 == mip1) { return sample0; }
+			return glm::mix(sample0, mips[mip1].Sample(direction), t);
+		}
+
+		// Light direction of a GGX sample around +Z and the mip it has to be read from
+		struct PrefilterSample
+		{
+			Vec3 m_Direction;
+			f32  m_NoL;
+			f32  m_Lod;
+		};
+	}
+
+	Vec4 CubeMap::Sample(Vec3 const& direction) const {
+		u32 face;
+		f32 u, v;
+		GetCubeMapFaceCoords(direction, face, u, v);
+
+		Image const& image = m_Faces[face];
+		f32 const    x = u * static_cast<f32>(m_FaceSize) - 0.5f;
+		f32 const    y = v * static_cast<f32>(m_FaceSize) - 0.5f;
+		i32 const    maxCoord = static_cast<i32>(m_FaceSize) - 1;
+		i32 const    x0 = std::clamp(static_cast<i32>(std::floor(x)), 0, maxCoord);
+		i32 const    y0 = std::clamp(static_cast<i32>(std::floor(y)), 0, maxCoord);
+		i32 const    x1 = std::min(x0 + 1, maxCoord);
+		i32 const    y1 = std::min(y0 + 1, maxCoord);
+		f32 const    tx = std::clamp(x - static_cast<f32>(x0), 0.0f, 1.0f);
+		f32 const    ty = std::clamp(y - static_cast<f32>(y0), 0.0f, 1.0f);
+
+		Vec4 const top = glm::mix(image.GetTexel(x0, y0), image.GetTexel(x1, y0), tx);
+		Vec4 const bottom = glm::mix(image.GetTexel(x0, y1), image.GetTexel(x1, y1), tx);
+		return glm::mix(top, bottom, ty);
+	}
+
+	Vec3 GetCubeMapDirection(u32 face, f32 u, f32 v) {
+		f32 const s = u * 2.0f - 1.0f;
+		f32 const t = v * 2.0f - 1.0f;
+
+		Vec3 direction{};
+		switch (face) {
+		case 0: direction = Vec3{1.0f, -t, -s};
+			break;
+		case 1: direction = Vec3{-1.0f, -t, s};
+			break;
+		case 2: direction = Vec3{s, 1.0f, t};
+			break;
+		case 3: direction = Vec3{s, -1.0f, -t};
+			break;
+		case 4: direction = Vec3{s, -t, 1.0f};
+			break;
+		case 5: direction = Vec3{-s, -t, -1.0f};
+			break;
+		}
+		return glm::normalize(direction);
+	}
+
+	void GetCubeMapFaceCoords(Vec3 const& direction, u32& outFace, f32& outU, f32& outV) {
+		Vec3 const absDir = glm::abs(direction);
+
+		f32 majorAxis, s, t;
+		if (absDir.x >= absDir.y && absDir.x >= absDir.z) {
+			outFace = direction.x > 0.0f ? 0 : 1;
+			majorAxis = absDir.x;
+			s = direction.x > 0.0f ? -direction.z : direction.z;
+			t = -direction.y;
+		}
+		else if (absDir.y >= absDir.z) {
+			outFace = direction.y > 0.0f ? 2 : 3;
+			majorAxis = absDir.y;
+			s = direction.x;
+			t = direction.y > 0.0f ? direction.z : -direction.z;
+		}
+		else {
+			outFace = direction.z > 0.0f ? 4 : 5;
+			majorAxis = absDir.z;
+			s = direction.z > 0.0f ? direction.x : -direction.x;
+			t = -direction.y;
+		}
+
+		outU = (s / majorAxis + 1.0f) * 0.5f;
+		outV = (t / majorAxis + 1.0f) * 0.5f;
+	}
+
+	Vector<CubeMap> GenerateCubeMapMips(CubeMap const& cubeMap) {
+		Vector<CubeMap> mips{cubeMap};
+		while (mips.back().m_FaceSize > 1) {
+			CubeMap mip{};
+			mip.m_FaceSize = mips.back().m_FaceSize / 2;
+			for (u32 face = 0; face < 6; ++face) {
+				mip.m_Faces[face] = DownsampleImage(mips.back().m_Faces[face], MipFilter::Box, ImageContent::Color_Linear);
+			}
+			mips.push_back(std::move(mip));
+		}
+		return mips;
+	}
+
+	Image PrefilterCubeMapFace(Vector<CubeMap> const& sourceMips, u32 face, u32 faceSize,
+	                           f32 roughness, u32 sampleCount) {
+		f32 const alpha = roughness * roughness;
+		f32 const alphaSq = alpha * alpha;
+		f32 const sourceSize = static_cast<f32>(sourceMips[0].m_FaceSize);
+		f32 const texelSolidAngle = 4.0f * glm::pi<f32>() / (6.0f * sourceSize * sourceSize);
+
+		// GGX importance samples are the same for every texel, compute them once in tangent space
+		Vector<PrefilterSample> samples{};
+		samples.reserve(sampleCount);
+		for (u32 i = 0; i < sampleCount; ++i) {
+			f32 const phi = 2.0f * glm::pi<f32>() * static_cast<f32>(i) / static_cast<f32>(sampleCount);
+			f32 const xi = RadicalInverse(i);
+			f32 const cosTheta = std::sqrt((1.0f - xi) / (1.0f + (alphaSq - 1.0f) * xi));
+			f32 const sinTheta = std::sqrt(1.0f - cosTheta * cosTheta);
+
+			Vec3 const halfVector{sinTheta * std::cos(phi), sinTheta * std::sin(phi), cosTheta};
+			Vec3 const light = 2.0f * cosTheta * halfVector - Vec3{0.0f, 0.0f, 1.0f};
+			if (light.z <= 0.0f) { continue; }
+
+			// With N = V the pdf of the light direction is D / 4
+			f32 const denom = cosTheta * cosTheta * (alphaSq - 1.0f) + 1.0f;
+			f32 const distribution = alphaSq / (glm::pi<f32>() * denom * denom);
+			f32 const pdf = distribution * 0.25f;
+			f32 const sampleSolidAngle = 1.0f / (static_cast<f32>(sampleCount) * pdf + 1e-6f);
+			f32 const lod = alpha == 0.0f ? 0.0f : std::max(0.5f * std::log2(sampleSolidAngle / texelSolidAngle) + 1.0f, 0.0f);
+
+			samples.push_back(PrefilterSample{light, light.z, lod});
+		}
+
+		Image image{};
+		image.m_Width = faceSize;
+		image.m_Height = faceSize;
+		image.m_Texels.resize(static_cast<u64>(faceSize) * faceSize);
+		for (u32 y = 0; y < faceSize; ++y) {
+			for (u32 x = 0; x < faceSize; ++x) {
+				Vec3 const normal = GetCubeMapDirection(face, (x + 0.5f) / faceSize, (y + 0.5f) / faceSize);
+				Vec3 const up = std::abs(normal.z) < 0.999f ? Vec3{0.0f, 0.0f, 1.0f} : Vec3{1.0f, 0.0f, 0.0f};
+				Vec3 const tangent = glm::normalize(glm::cross(up, normal));
+				Vec3 const bitangent = glm::cross(normal, tangent);
+
+				Vec4 radiance{0.0f};
+				f32  weight = 0.0f;
+				for (PrefilterSample const& sample : samples) {
+					Vec3 const light = tangent * sample.m_Direction.x + bitangent * sample.m_Direction.y +
+					                   normal * sample.m_Direction.z;
+					radiance += SampleCubeMapLod(sourceMips, light, sample.m_Lod) * sample.m_NoL;
+					weight += sample.m_NoL;
+				}
+				image.m_Texels[static_cast<u64>(y) * faceSize + x] = weight > 0.0f
+					                                                     ? radiance / weight
+					                                                     : sourceMips[0].Sample(normal);
+			}
+		}
+		return image;
+	}
+}
@@ -0,0 +1,396 @@
+#include "TextureCompression.h"
+
+#include "CookieKat/Core/Platform/Asserts.h"
+
+#include "stb_dxt.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace CKE::TextureProcessing {
+	namespace {
+		// Copies a 4x4 block of RGBA8 texels, texels outside of the image repeat the last row/column
+		void FetchBlock(u8 const* pRGBA8, u32 width, u32 height, u32 blockX, u32 blockY, u8 outBlock[64]) {
+			for (u32 y = 0; y < 4; ++y) {
+				u32 const srcY = std::min(blockY * 4 + y, height - 1);
+				for (u32 x = 0; x < 4; ++x) {
+					u32 const srcX = std::min(blockX * 4 + x, width - 1);
+					memcpy(outBlock + (y * 4 + x) * 4, pRGBA8 + (static_cast<u64>(srcY) * width + srcX) * 4, 4);
+				}
+			}
+		}
+
+		// BC7
+		//-----------------------------------------------------------------------------
+
+		// Only mode 6 is used: a single subset with RGBA endpoints of 7 bits + 1 unique p-bit and 4 bit indices.
+		// It handles smooth gradients and alpha well and is simple enough to search exhaustively per block.
+		constexpr u32 BC7_WEIGHTS_4BIT[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+		struct BC7Endpoints
+		{
+			u8 m_Color[2][4]; // 7 bit values
+			u8 m_PBit[2];
+		};
+
+		u8 BC7Interpolate(u32 e0, u32 e1, u32 weight) {
+			return static_cast<u8>(((64 - weight) * e0 + weight * e1 + 32) >> 6);
+		}
+
+		void BC7ExpandEndpoints(BC7Endpoints const& endpoints, u8 outColors[2][4]) {
+			for (u32 e = 0; e < 2; ++e) {
+				for (u32 c = 0; c < 4; ++c) {
+					outColors[e][c] = static_cast<u8>((endpoints.m_Color[e][c] << 1) | endpoints.m_PBit[e]);
+				}
+			}
+		}
+
+		// Assigns the closest palette entry to each texel, returns the squared error of the block
+		u32 BC7FindIndices(u8 const block[64], BC7Endpoints const& endpoints, u8 outIndices[16]) {
+			u8 colors[2][4];
+			BC7ExpandEndpoints(endpoints, colors);
+
+			u8 palette[16][4];
+			for (u32 i = 0; i < 16; ++i) {
+				for (u32 c = 0; c < 4; ++c) {
+					palette[i][c] = BC7Interpolate(colors[0][c], colors[1][c], BC7_WEIGHTS_4BIT[i]);
+				}
+			}
+
+			u32 totalError = 0;
+			for (u32 t = 0; t < 16; ++t) {
+				u32 bestError = UINT32_MAX;
+				for (u32 i = 0; i < 16; ++i) {
+					u32 error = 0;
+					for (u32 c = 0; c < 4; ++c) {
+						i32 const diff = static_cast<i32>(block[t * 4 + c]) - static_cast<i32>(palette[i][c]);
+						error += diff * diff;
+					}
+					if (error < bestError) {
+						bestError = error;
+						outIndices[t] = static_cast<u8>(i);
+					}
+				}
+				totalError += bestError;
+			}
+			return totalError;
+		}
+
+		// Finds the best p-bits for a pair of 8 bit endpoints, returns the squared error of the block
+		u32 BC7QuantizeEndpoints(u8 const block[64], Vec4 const endpoints[2],
+		                         BC7Endpoints& outEndpoints, u8 outIndices[16]) {
+			u32 bestError = UINT32_MAX;
+			for (u32 pBits = 0; pBits < 4; ++pBits) {
+				BC7Endpoints candidate{};
+				for (u32 e = 0; e < 2; ++e) {
+					u8 const pBit = static_cast<u8>((pBits >> e) & 1);
+					candidate.m_PBit[e] = pBit;
+					for (u32 c = 0; c < 4; ++c) {
+						f32 const value = std::round((endpoints[e][c] - pBit) * 0.5f);
+						candidate.m_Color[e][c] = static_cast<u8>(std::clamp(value, 0.0f, 127.0f));
+					}
+				}
+
+				u8        indices[16];
+				u32 const error = BC7FindIndices(block, candidate, indices);
+				if (error < bestError) {
+					bestError = error;
+					outEndpoints = candidate;
+					memcpy(outIndices, indices, 16);
+				}
+			}
+			return bestError;
+		}
+
+		void CompressBlockBC7(u8 const block[64], u8 outBlock[16]) {
+			// Principal axis of the block colors
+			Vec4 mean{0.0f};
+			for (u32 t = 0; t < 16; ++t) {
+				mean += Vec4{block[t * 4], block[t * 4 + 1], block[t * 4 + 2], block[t * 4 + 3]};
+			}
+			mean /= 16.0f;
+
+			Mat4 covariance{0.0f};
+			for (u32 t = 0; t < 16; ++t) {
+				Vec4 const d = Vec4{block[t * 4], block[t * 4 + 1], block[t * 4 + 2], block[t * 4 + 3]} - mean;
+				covariance += glm::outerProduct(d, d);
+			}
+
+			Vec4 axis{1.0f, 1.0f, 1.0f, 1.0f};
+			for (u32 i = 0; i < 8; ++i) {
+				Vec4 const next = covariance * axis;
+				f32 const  length = glm::length(next);
+				if (length < 1e-6f) { break; }
+				axis = next / length;
+			}
+
+			f32 minT = 0.0f;
+			f32 maxT = 0.0f;
+			for (u32 t = 0; t < 16; ++t) {
+				Vec4 const d = Vec4{block[t * 4], block[t * 4 + 1], block[t * 4 + 2], block[t * 4 + 3]} - mean;
+				f32 const  projection = glm::dot(d, axis);
+				minT = std::min(minT, projection);
+				maxT = std::max(maxT, projection);
+			}
+
+			Vec4 endpoints[2] = {
+				glm::clamp(mean + axis * minT, Vec4{0.0f}, Vec4{255.0f}),
+				glm::clamp(mean + axis * maxT, Vec4{0.0f}, Vec4{255.0f}),
+			};
+
+			BC7Endpoints bestEndpoints{};
+			u8           bestIndices[16];
+			u32          bestError = BC7QuantizeEndpoints(block, endpoints, bestEndpoints, bestIndices);
+
+			// Least squares refinement of the endpoints for the selected indices
+			for (u32 iteration = 0; iteration < 2 && bestError > 0; ++iteration) {
+				f32  aa = 0.0f, ab = 0.0f, bb = 0.0f;
+				Vec4 ax{0.0f}, bx{0.0f};
+				for (u32 t = 0; t < 16; ++t) {
+					f32 const  w = static_cast<f32>(BC7_WEIGHTS_4BIT[bestIndices[t]]) / 64.0f;
+					Vec4 const x{block[t * 4], block[t * 4 + 1], block[t * 4 + 2], block[t * 4 + 3]};
+					aa += (1.0f - w) * (1.0f - w);
+					ab += (1.0f - w) * w;
+					bb += w * w;
+					ax += x * (1.0f - w);
+					bx += x * w;
+				}
+
+				f32 const determinant = aa * bb - ab * ab;
+				if (std::abs(determinant) < 1e-6f) { break; }
+				endpoints[0] = glm::clamp((ax * bb - bx * ab) / determinant, Vec4{0.0f}, Vec4{255.0f});
+				endpoints[1] = glm::clamp((bx * aa - ax * ab) / determinant, Vec4{0.0f}, Vec4{255.0f});
+
+				BC7Endpoints refinedEndpoints{};
+				u8           refinedIndices[16];
+				u32 const    refinedError = BC7QuantizeEndpoints(block, endpoints, refinedEndpoints, refinedIndices);
+				if (refinedError >= bestError) { break; }
+
+				bestError = refinedError;
+				bestEndpoints = refinedEndpoints;
+				memcpy(bestIndices, refinedIndices, 16);
+			}
+
+			// The MSB of the first index is implicit, swap the endpoints if it's set
+			if (bestIndices[0] & 0x8) {
+				std::swap(bestEndpoints.m_Color[0], bestEndpoints.m_Color[1]);
+				std::swap(bestEndpoints.m_PBit[0], bestEndpoints.m_PBit[1]);
+				for (u8& index : bestIndices) { index = static_cast<u8>(15 - index); }
+			}
+
+			// Pack the block, fields are stored from the least significant bit
+			u64  bits[2] = {0, 0};
+			u32  bitOffset = 0;
+			auto write = [&](u64 value, u32 bitCount) {
+				for (u32 i = 0; i < bitCount; ++i, ++bitOffset) {
+					bits[bitOffset / 64] |= ((value >> i) & 1) << (bitOffset % 64);
+				}
+			};
+
+			write(1 << 6, 7); // Mode 6
+			for (u32 c = 0; c < 4; ++c) {
+				write(bestEndpoints.m_Color[0][c], 7);
+				write(bestEndpoints.m_Color[1][c], 7);
+			}
+			write(bestEndpoints.m_PBit[0], 1);
+			write(bestEndpoints.m_PBit[1], 1);
+			write(bestIndices[0], 3);
+			for (u32 t = 1; t < 16; ++t) { write(bestIndices[t], 4); }
+
+			memcpy(outBlock, bits, 16);
+		}
+
+		void DecompressBlockBC7(u8 const block[16], u8 outBlock[64]) {
+			u64 bits[2];
+			memcpy(bits, block, 16);
+			u32  bitOffset = 0;
+			auto read = [&](u32 bitCount) {
+				u64 value = 0;
+				for (u32 i = 0; i < bitCount; ++i, ++bitOffset) {
+					value |= ((bits[bitOffset / 64] >> (bitOffset % 64)) & 1) << i;
+				}
+				return static_cast<u32>(value);
+			};
+
+			if (read(7) != (1 << 6)) {
+				// Unsupported mode, decoded as opaque magenta to make it obvious
+				for (u32 t = 0; t < 16; ++t) {
+					outBlock[t * 4 + 0] = 255;
+					outBlock[t * 4 + 1] = 0;
+					outBlock[t * 4 + 2] = 255;
+					outBlock[t * 4 + 3] = 255;
+				}
+				return;
+			}
+
+			BC7Endpoints endpoints{};
+			for (u32 c = 0; c < 4; ++c) {
+				endpoints.m_Color[0][c] = static_cast<u8>(read(7));
+				endpoints.m_Color[1][c] = static_cast<u8>(read(7));
+			}
+			endpoints.m_PBit[0] = static_cast<u8>(read(1));
+			endpoints.m_PBit[1] = static_cast<u8>(read(1));
+
+			u8 colors[2][4];
+			BC7ExpandEndpoints(endpoints, colors);
+			for (u32 t = 0; t < 16; ++t) {
+				u32 const index = read(t == 0 ? 3 : 4);
+				for (u32 c = 0; c < 4; ++c) {
+					outBlock[t * 4 + c] = BC7Interpolate(colors[0][c], colors[1][c], BC7_WEIGHTS_4BIT[index]);
+				}
+			}
+		}
+
+		// BC1-5 decoding
+		//-----------------------------------------------------------------------------
+
+		void DecompressColorBC1(u8 const block[8], u8 outBlock[64], bool allowTransparent) {
+			u16 c[2];
+			memcpy(c, block, 4);
+
+			u8 palette[4][4];
+			for (u32 e = 0; e < 2; ++e) {
+				u32 const r = (c[e] >> 11) & 0x1F;
+				u32 const g = (c[e] >> 5) & 0x3F;
+				u32 const b = c[e] & 0x1F;
+				palette[e][0] = static_cast<u8>((r << 3) | (r >> 2));
+				palette[e][1] = static_cast<u8>((g << 2) | (g >> 4));
+				palette[e][2] = static_cast<u8>((b << 3) | (b >> 2));
+				palette[e][3] = 255;
+			}
+
+			bool const fourColors = c[0] > c[1] || !allowTransparent;
+			for (u32 ch = 0; ch < 3; ++ch) {
+				u32 const a = palette[0][ch];
+				u32 const b = palette[1][ch];
+				palette[2][ch] = static_cast<u8>(fourColors ? (2 * a + b) / 3 : (a + b) / 2);
+				palette[3][ch] = static_cast<u8>(fourColors ? (a + 2 * b) / 3 : 0);
+			}
+			palette[2][3] = 255;
+			palette[3][3] = fourColors ? 255 : 0;
+
+			u32 indices;
+			memcpy(&indices, block + 4, 4);
+			for (u32 t = 0; t < 16; ++t) {
+				memcpy(outBlock + t * 4, palette[(indices >> (t * 2)) & 0x3], 4);
+			}
+		}
+
+		// Single channel block (BC4), used for the BC3 alpha and the BC5 channels
+		void DecompressChannelBC4(u8 const block[8], u8 outBlock[64], u32 channel) {
+			u32 const a0 = block[0];
+			u32 const a1 = block[1];
+
+			u8 palette[8];
+			palette[0] = static_cast<u8>(a0);
+			palette[1] = static_cast<u8>(a1);
+			if (a0 > a1) {
+				for (u32 i = 1; i < 7; ++i) { palette[i + 1] = static_cast<u8>(((7 - i) * a0 + i * a1) / 7); }
+			}
+			else {
+				for (u32 i = 1; i < 5; ++i) { palette[i + 1] = static_cast<u8>(((5 - i) * a0 + i * a1) / 5); }
+				palette[6] = 0;
+				palette[7] = 255;
+			}
+
+			u64 indices = 0;
+			memcpy(&indices, block + 2, 6);
+			for (u32 t = 0; t < 16; ++t) {
+				outBlock[t * 4 + channel] = palette[(indices >> (t * 3)) & 0x7];
+			}
+		}
+	}
+
+	u32 GetBlockByteSize(BlockFormat format) {
+		return format == BlockFormat::BC1 ? 8 : 16;
+	}
+
+	u64 GetCompressedImageByteSize(BlockFormat format, u32 width, u32 height) {
+		return static_cast<u64>(GetBlockCount(width)) * GetBlockCount(height) * GetBlockByteSize(format);
+	}
+
+	void CompressBlockRows(u8 const* pRGBA8, u32 width, u32 height, BlockFormat format,
+	                       u32 blockRowBegin, u32 blockRowEnd, u8* pOutBlocks) {
+		u32 const blocksX = GetBlockCount(width);
+		u32 const blockSize = GetBlockByteSize(format);
+		CKE_ASSERT(blockRowEnd <= GetBlockCount(height));
+
+		u8 block[64];
+		for (u32 by = blockRowBegin; by < blockRowEnd; ++by) {
+			for (u32 bx = 0; bx < blocksX; ++bx) {
+				FetchBlock(pRGBA8, width, height, bx, by, block);
+				u8* pOut = pOutBlocks + (static_cast<u64>(by) * blocksX + bx) * blockSize;
+
+				switch (format) {
+				case BlockFormat::BC1:
+					stb_compress_dxt_block(pOut, block, 0, STB_DXT_HIGHQUAL);
+					break;
+				case BlockFormat::BC3:
+					stb_compress_dxt_block(pOut, block, 1, STB_DXT_HIGHQUAL);
+					break;
+				case BlockFormat::BC5: {
+					u8 rg[32];
+					for (u32 t = 0; t < 16; ++t) {
+						rg[t * 2 + 0] = block[t * 4 + 0];
+						rg[t * 2 + 1] = block[t * 4 + 1];
+					}
+					stb_compress_bc5_block(pOut, rg);
+					break;
+				}
+				case BlockFormat::BC7:
+					CompressBlockBC7(block, pOut);
+					break;
+				}
+			}
+		}
+	}
+
+	void CompressImage(u8 const* pRGBA8, u32 width, u32 height, BlockFormat format, Vector<u8>& outBlocks) {
+		outBlocks.resize(GetCompressedImageByteSize(format, width, height));
+		CompressBlockRows(pRGBA8, width, height, format, 0, GetBlockCount(height), outBlocks.data());
+	}
+
+	void DecompressImage(u8 const* pBlocks, u32 width, u32 height, BlockFormat format, Vector<u8>& outRGBA8) {
+		u32 const blocksX = GetBlockCount(width);
+		u32 const blocksY = GetBlockCount(height);
+		u32 const blockSize = GetBlockByteSize(format);
+		outRGBA8.resize(static_cast<u64>(width) * height * 4);
+
+		u8 block[64];
+		for (u32 by = 0; by < blocksY; ++by) {
+			for (u32 bx = 0; bx < blocksX; ++bx) {
+				u8 const* pBlock = pBlocks + (static_cast<u64>(by) * blocksX + bx) * blockSize;
+
+				switch (format) {
+				case BlockFormat::BC1:
+					DecompressColorBC1(pBlock, block, true);
+					break;
+				case BlockFormat::BC3:
+					DecompressColorBC1(pBlock + 8, block, false);
+					DecompressChannelBC4(pBlock, block, 3);
+					break;
+				case BlockFormat::BC5:
+					for (u32 t = 0; t < 16; ++t) {
+						block[t * 4 + 2] = 0;
+						block[t * 4 + 3] = 255;
+					}
+					DecompressChannelBC4(pBlock, block, 0);
+					DecompressChannelBC4(pBlock + 8, block, 1);
+					break;
+				case BlockFormat::BC7:
+					DecompressBlockBC7(pBlock, block);
+					break;
+				}
+
+				// Discard the padding texels
+				for (u32 y = 0; y < 4 && by * 4 + y < height; ++y) {
+					for (u32 x = 0; x < 4 && bx * 4 + x < width; ++x) {
+						u64 const dst = (static_cast<u64>(by * 4 + y) * width + bx * 4 + x) * 4;
+						memcpy(outRGBA8.data() + dst, block + (y * 4 + x) * 4, 4);
+					}
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,223 @@
+#include "TextureMips.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace CKE::TextureProcessing {
+	namespace {
+		// Kaiser window parameters, same defaults as NVIDIA Texture Tools
+		constexpr f32 KAISER_WIDTH = 3.0f;
+		constexpr f32 KAISER_ALPHA = 4.0f;
+
+		// Zeroth order modified Bessel function of the first kind
+		f32 BesselI0(f32 x) {
+			f32 sum = 1.0f;
+			f32 term = 1.0f;
+			f32 const halfXSq = x * x * 0.25f;
+			for (i32 k = 1; k < 32; ++k) {
+				term *= halfXSq / static_cast<f32>(k * k);
+				sum += term;
+				if (term < sum * 1e-8f) { break; }
+			}
+			return sum;
+		}
+
+		f32 Sinc(f32 x) {
+			if (std::abs(x) < 1e-4f) { return 1.0f; }
+			f32 const px = glm::pi<f32>() * x;
+			return std::sin(px) / px;
+		}
+
+		f32 Kaiser(f32 x) {
+			f32 const t = x / KAISER_WIDTH;
+			if (t * t >= 1.0f) { return 0.0f; }
+			return Sinc(x) * BesselI0(KAISER_ALPHA * std::sqrt(1.0f - t * t)) / BesselI0(KAISER_ALPHA);
+		}
+
+		// Source texels and weights that contribute to each destination texel of one axis
+		struct FilterTaps
+		{
+			Vector<u32>            m_Offsets;
+			Vector<Pair<u32, f32>> m_Taps;
+		};
+
+		FilterTaps ComputeFilterTaps(u32 srcSize, u32 dstSize, MipFilter filter) {
+			FilterTaps taps{};
+			taps.m_Offsets.reserve(dstSize + 1);
+
+			f32 const scale = static_cast<f32>(srcSize) / static_cast<f32>(dstSize);
+			for (u32 i = 0; i < dstSize; ++i) {
+				taps.m_Offsets.push_back(static_cast<u32>(taps.m_Taps.size()));
+				f32 const center = (static_cast<f32>(i) + 0.5f) * scale;
+
+				f32 const support = filter == MipFilter::Box ? scale * 0.5f : KAISER_WIDTH * scale;
+				i32 const first = static_cast<i32>(std::floor(center - support));
+				i32 const last = static_cast<i32>(std::ceil(center + support));
+
+				f32       weightSum = 0.0f;
+				u64 const firstTap = taps.m_Taps.size();
+				for (i32 j = first; j <= last; ++j) {
+					f32 weight;
+					if (filter == MipFilter::Box) {
+						// Overlap of the source texel with the footprint of the destination texel
+						f32 const overlapMin = std::max(static_cast<f32>(j), center - support);
+						f32 const overlapMax = std::min(static_cast<f32>(j + 1), center + support);
+						weight = std::max(overlapMax - overlapMin, 0.0f);
+					}
+					else {
+						weight = Kaiser((static_cast<f32>(j) + 0.5f - center) / scale);
+					}
+					if (weight == 0.0f) { continue; }
+
+					// Clamp to edge addressing
+					u32 const index = static_cast<u32>(std::clamp(j, 0, static_cast<i32>(srcSize) - 1));
+					taps.m_Taps.emplace_back(index, weight);
+					weightSum += weight;
+				}
+
+				for (u64 t = firstTap; t < taps.m_Taps.size(); ++t) { taps.m_Taps[t].second /= weightSum; }
+			}
+			taps.m_Offsets.push_back(static_cast<u32>(taps.m_Taps.size()));
+			return taps;
+		}
+
+		u8 ToUnorm8(f32 value) {
+			return static_cast<u8>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+		}
+	}
+
+	u32 ComputeMipCount(u32 width, u32 height) {
+		u32 mipCount = 1;
+		u32 size = std::max(width, height);
+		while (size > 1) {
+			size /= 2;
+			mipCount++;
+		}
+		return mipCount;
+	}
+
+	f32 SRGBToLinear(f32 value) {
+		if (value <= 0.04045f) { return value / 12.92f; }
+		return std::pow((value + 0.055f) / 1.055f, 2.4f);
+	}
+
+	f32 LinearToSRGB(f32 value) {
+		if (value <= 0.0031308f) { return value * 12.92f; }
+		return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+	}
+
+	Image DecodeImage(u8 const* pRGBA8, u32 width, u32 height, ImageContent content) {
+		// Lookup table for the 256 possible values of each conversion
+		Array<f32, 256> rgbTable{};
+		for (u32 i = 0; i < 256; ++i) {
+			f32 const unorm = static_cast<f32>(i) / 255.0f;
+			switch (content) {
+			case ImageContent::Color_SRGB: rgbTable[i] = SRGBToLinear(unorm);
+				break;
+			case ImageContent::Color_Linear: rgbTable[i] = unorm;
+				break;
+			case ImageContent::NormalMap: rgbTable[i] = unorm * 2.0f - 1.0f;
+				break;
+			}
+		}
+
+		Image image{};
+		image.m_Width = width;
+		image.m_Height = height;
+		image.m_Texels.resize(static_cast<u64>(width) * height);
+		for (u64 i = 0; i < image.m_Texels.size(); ++i) {
+			u8 const* pTexel = pRGBA8 + i * 4;
+			image.m_Texels[i] = Vec4{
+				rgbTable[pTexel[0]], rgbTable[pTexel[1]], rgbTable[pTexel[2]],
+				static_cast<f32>(pTexel[3]) / 255.0f
+			};
+		}
+		return image;
+	}
+
+	void EncodeImage(Image const& image, ImageContent content, Vector<u8>& outRGBA8) {
+		outRGBA8.resize(image.m_Texels.size() * 4);
+		for (u64 i = 0; i < image.m_Texels.size(); ++i) {
+			Vec4 texel = image.m_Texels[i];
+			switch (content) {
+			case ImageContent::Color_SRGB:
+				texel = Vec4{LinearToSRGB(texel.x), LinearToSRGB(texel.y), LinearToSRGB(texel.z), texel.w};
+				break;
+			case ImageContent::Color_Linear: break;
+			case ImageContent::NormalMap:
+				texel = Vec4{Vec3{texel} * 0.5f + 0.5f, texel.w};
+				break;
+			}
+
+			u8* pTexel = outRGBA8.data() + i * 4;
+			pTexel[0] = ToUnorm8(texel.x);
+			pTexel[1] = ToUnorm8(texel.y);
+			pTexel[2] = ToUnorm8(texel.z);
+			pTexel[3] = ToUnorm8(texel.w);
+		}
+	}
+
+	Image DownsampleImage(Image const& image, MipFilter filter, ImageContent content) {
+		u32 const dstWidth = std::max(image.m_Width / 2, 1u);
+		u32 const dstHeight = std::max(image.m_Height / 2, 1u);
+
+		FilterTaps const horizontal = ComputeFilterTaps(image.m_Width, dstWidth, filter);
+		FilterTaps const vertical = ComputeFilterTaps(image.m_Height, dstHeight, filter);
+
+		// Separable filter, rows first
+		Vector<Vec4> rows(static_cast<u64>(dstWidth) * image.m_Height);
+		for (u32 y = 0; y < image.m_Height; ++y) {
+			for (u32 x = 0; x < dstWidth; ++x) {
+				Vec4 sum{0.0f};
+				for (u32 t = horizontal.m_Offsets[x]; t < horizontal.m_Offsets[x + 1]; ++t) {
+					sum += image.GetTexel(horizontal.m_Taps[t].first, y) * horizontal.m_Taps[t].second;
+				}
+				rows[static_cast<u64>(y) * dstWidth + x] = sum;
+			}
+		}
+
+		Image mip{};
+		mip.m_Width = dstWidth;
+		mip.m_Height = dstHeight;
+		mip.m_Texels.resize(static_cast<u64>(dstWidth) * dstHeight);
+		for (u32 y = 0; y < dstHeight; ++y) {
+			for (u32 x = 0; x < dstWidth; ++x) {
+				Vec4 sum{0.0f};
+				for (u32 t = vertical.m_Offsets[y]; t < vertical.m_Offsets[y + 1]; ++t) {
+					sum += rows[static_cast<u64>(vertical.m_Taps[t].first) * dstWidth + x] * vertical.m_Taps[t].second;
+				}
+
+				// Negative lobes can overshoot, keep values in the range of the content
+				if (content == ImageContent::NormalMap) {
+					Vec3 const normal{sum};
+					f32 const  length = glm::length(normal);
+					Vec3 const renormalized = length > 1e-6f ? normal / length : Vec3{0.0f, 0.0f, 1.0f};
+					sum = Vec4{renormalized, std::clamp(sum.w, 0.0f, 1.0f)};
+				}
+				else {
+					sum = glm::clamp(sum, Vec4{0.0f}, Vec4{1.0f});
+				}
+				mip.m_Texels[static_cast<u64>(y) * dstWidth + x] = sum;
+			}
+		}
+		return mip;
+	}
+
+	f64 ComputePSNR(u8 const* pReference, u8 const* pImage, u64 texelCount, u32 channelMask) {
+		f64 squaredErrorSum = 0.0;
+		u64 sampleCount = 0;
+		for (u64 i = 0; i < texelCount; ++i) {
+			for (u32 c = 0; c < 4; ++c) {
+				if ((channelMask & (1u << c)) == 0) { continue; }
+				f64 const diff = static_cast<f64>(pReference[i * 4 + c]) - static_cast<f64>(pImage[i * 4 + c]);
+				squaredErrorSum += diff * diff;
+				sampleCount++;
+			}
+		}
+
+		if (sampleCount == 0 || squaredErrorSum == 0.0) { return std::numeric_limits<f64>::infinity(); }
+		f64 const mse = squaredErrorSum / static_cast<f64>(sampleCount);
+		return 10.0 * std::log10(255.0 * 255.0 / mse);
+	}
+}
@@ -0,0 +1,238 @@
+#include "CookieKat/Systems/TextureProcessing/TextureMips.h"
+#include "CookieKat/Systems/TextureProcessing/TextureCompression.h"
+#include "CookieKat/Systems/TextureProcessing/CubeMapFiltering.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+
+//-----------------------------------------------------------------------------
+// Utilities
+//-----------------------------------------------------------------------------
+
+using namespace CKE;
+using namespace CKE::TextureProcessing;
+
+// Smooth gradients with some high frequency detail, close to the content of a real texture
+static Vector<u8> CreateTestImage(u32 width, u32 height) {
+	std::mt19937                   rng{3};
+	std::uniform_int_distribution<i32> noise{-6, 6};
+
+	Vector<u8> image(static_cast<u64>(width) * height * 4);
+	for (u32 y = 0; y < height; ++y) {
+		for (u32 x = 0; x < width; ++x) {
+			f32 const u = static_cast<f32>(x) / width;
+			f32 const v = static_cast<f32>(y) / height;
+			f32 const wave = 0.5f + 0.5f * std::sin((u + v) * 20.0f);
+
+			u8* pTexel = image.data() + (static_cast<u64>(y) * width + x) * 4;
+			pTexel[0] = static_cast<u8>(std::clamp(static_cast<i32>(u * 255.0f) + noise(rng), 0, 255));
+			pTexel[1] = static_cast<u8>(std::clamp(static_cast<i32>(v * 255.0f) + noise(rng), 0, 255));
+			pTexel[2] = static_cast<u8>(wave * 255.0f);
+			pTexel[3] = static_cast<u8>(255.0f - u * 128.0f);
+		}
+	}
+	return image;
+}
+
+//-----------------------------------------------------------------------------
+// Mips
+//-----------------------------------------------------------------------------
+
+TEST(TextureProcessing, ComputeMipCount) {
+	EXPECT_EQ(ComputeMipCount(1, 1), 1);
+	EXPECT_EQ(ComputeMipCount(2, 2), 2);
+	EXPECT_EQ(ComputeMipCount(256, 256), 9);
+	EXPECT_EQ(ComputeMipCount(256, 16), 9);
+	EXPECT_EQ(ComputeMipCount(300, 17), 9);
+}
+
+TEST(TextureProcessing, SRGB_RoundTrip) {
+	for (u32 i = 0; i < 256; ++i) {
+		f32 const value = static_cast<f32>(i) / 255.0f;
+		EXPECT_NEAR(LinearToSRGB(SRGBToLinear(value)), value, 1e-5f);
+	}
+}
+
+TEST(TextureProcessing, DownsampleImage_GammaCorrectBox) {
+	// Black and white checkerboard, the mip has to be half the light, not half the sRGB value
+	Vector<u8> texels{
+		0, 0, 0, 255, 255, 255, 255, 255,
+		255, 255, 255, 255, 0, 0, 0, 255,
+	};
+	Image const image = DecodeImage(texels.data(), 2, 2, ImageContent::Color_SRGB);
+	Image const mip = DownsampleImage(image, MipFilter::Box, ImageContent::Color_SRGB);
+	ASSERT_EQ(mip.m_Width, 1);
+	ASSERT_EQ(mip.m_Height, 1);
+
+	Vector<u8> encoded{};
+	EncodeImage(mip, ImageContent::Color_SRGB, encoded);
+	EXPECT_EQ(encoded[0], 188);
+	EXPECT_EQ(encoded[3], 255);
+}
+
+TEST(TextureProcessing, DownsampleImage_ConstantImageStaysConstant) {
+	Vector<u8> texels{};
+	for (u32 i = 0; i < 13 * 7; ++i) { texels.insert(texels.end(), {200, 100, 50, 128}); }
+
+	for (MipFilter filter : {MipFilter::Box, MipFilter::Kaiser}) {
+		Image image = DecodeImage(texels.data(), 13, 7, ImageContent::Color_SRGB);
+		while (image.m_Width > 1 || image.m_Height > 1) {
+			image = DownsampleImage(image, filter, ImageContent::Color_SRGB);
+		}
+
+		Vector<u8> encoded{};
+		EncodeImage(image, ImageContent::Color_SRGB, encoded);
+		EXPECT_EQ(encoded, (Vector<u8>{200, 100, 50, 128}));
+	}
+}
+
+TEST(TextureProcessing, DownsampleImage_NormalMapStaysNormalized) {
+	// Bumps in every direction, averaging them shortens the normals
+	std::mt19937                        rng{5};
+	std::uniform_real_distribution<f32> dist{-0.7f, 0.7f};
+
+	Image image{};
+	image.m_Width = 16;
+	image.m_Height = 16;
+	for (u32 i = 0; i < 16 * 16; ++i) {
+		image.m_Texels.emplace_back(glm::normalize(Vec3{dist(rng), dist(rng), 1.0f}), 1.0f);
+	}
+
+	Image const mip = DownsampleImage(image, MipFilter::Kaiser, ImageContent::NormalMap);
+	for (Vec4 const& texel : mip.m_Texels) {
+		EXPECT_NEAR(glm::length(Vec3{texel}), 1.0f, 1e-5f);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Compression
+//-----------------------------------------------------------------------------
+
+TEST(TextureProcessing, CompressImage_BlockSizes) {
+	EXPECT_EQ(GetCompressedImageByteSize(BlockFormat::BC1, 256, 256), 64 * 64 * 8);
+	EXPECT_EQ(GetCompressedImageByteSize(BlockFormat::BC7, 256, 256), 64 * 64 * 16);
+	EXPECT_EQ(GetCompressedImageByteSize(BlockFormat::BC3, 5, 3), 2 * 1 * 16);
+	EXPECT_EQ(GetCompressedImageByteSize(BlockFormat::BC5, 1, 1), 16);
+}
+
+TEST(TextureProcessing, CompressImage_QualityPerFormat) {
+	// Not a multiple of the block size to exercise the padding
+	u32 const        width = 70;
+	u32 const        height = 38;
+	Vector<u8> const image = CreateTestImage(width, height);
+
+	struct Expectation
+	{
+		BlockFormat m_Format;
+		u32         m_ChannelMask;
+		f64         m_MinPSNR;
+	};
+
+	for (Expectation const& e : {
+		     Expectation{BlockFormat::BC1, 0b0111, 27.0},
+		     Expectation{BlockFormat::BC3, 0b1111, 28.0},
+		     Expectation{BlockFormat::BC5, 0b0011, 35.0},
+		     Expectation{BlockFormat::BC7, 0b1111, 34.0},
+	     }) {
+		Vector<u8> blocks{};
+		CompressImage(image.data(), width, height, e.m_Format, blocks);
+		EXPECT_EQ(blocks.size(), GetCompressedImageByteSize(e.m_Format, width, height));
+
+		Vector<u8> decoded{};
+		DecompressImage(blocks.data(), width, height, e.m_Format, decoded);
+		f64 const psnr = ComputePSNR(image.data(), decoded.data(), width * height, e.m_ChannelMask);
+		EXPECT_GT(psnr, e.m_MinPSNR) << "Format " << static_cast<u32>(e.m_Format);
+	}
+}
+
+TEST(TextureProcessing, CompressBlockRows_MatchesWholeImage) {
+	u32 const        width = 64;
+	u32 const        height = 64;
+	Vector<u8> const image = CreateTestImage(width, height);
+
+	Vector<u8> whole{};
+	CompressImage(image.data(), width, height, BlockFormat::BC7, whole);
+
+	Vector<u8> parts(whole.size());
+	for (u32 row = 0; row < GetBlockCount(height); row += 3) {
+		u32 const rowEnd = std::min(row + 3, GetBlockCount(height));
+		CompressBlockRows(image.data(), width, height, BlockFormat::BC7, row, rowEnd, parts.data());
+	}
+	EXPECT_EQ(parts, whole);
+}
+
+TEST(TextureProcessing, BC7_SolidColor) {
+	// Mixed parities can't always be represented exactly with the shared p-bit, but must stay within 1
+	Vector<u8> image{};
+	for (u32 i = 0; i < 16; ++i) { image.insert(image.end(), {12, 200, 77, 255}); }
+
+	Vector<u8> blocks{};
+	Vector<u8> decoded{};
+	CompressImage(image.data(), 4, 4, BlockFormat::BC7, blocks);
+	DecompressImage(blocks.data(), 4, 4, BlockFormat::BC7, decoded);
+	for (u64 i = 0; i < image.size(); ++i) {
+		EXPECT_NEAR(decoded[i], image[i], 1);
+	}
+}
+
+//-----------------------------------------------------------------------------
+// Cube Maps
+//-----------------------------------------------------------------------------
+
+static CubeMap CreateCubeMap(u32 faceSize, Array<Vec4, 6> const& faceColors) {
+	CubeMap cubeMap{};
+	cubeMap.m_FaceSize = faceSize;
+	for (u32 face = 0; face < 6; ++face) {
+		cubeMap.m_Faces[face].m_Width = faceSize;
+		cubeMap.m_Faces[face].m_Height = faceSize;
+		cubeMap.m_Faces[face].m_Texels.assign(faceSize * faceSize, faceColors[face]);
+	}
+	return cubeMap;
+}
+
+TEST(TextureProcessing, CubeMapDirection_RoundTrip) {
+	for (u32 face = 0; face < 6; ++face) {
+		for (f32 u : {0.1f, 0.5f, 0.8f}) {
+			for (f32 v : {0.2f, 0.5f, 0.9f}) {
+				u32 outFace;
+				f32 outU, outV;
+				GetCubeMapFaceCoords(GetCubeMapDirection(face, u, v), outFace, outU, outV);
+				EXPECT_EQ(outFace, face);
+				EXPECT_NEAR(outU, u, 1e-5f);
+				EXPECT_NEAR(outV, v, 1e-5f);
+			}
+		}
+	}
+}
+
+TEST(TextureProcessing, PrefilterCubeMap_ConstantStaysConstant) {
+	Vec4 const            color{0.3f, 0.6f, 0.9f, 1.0f};
+	Vector<CubeMap> const mips = GenerateCubeMapMips(CreateCubeMap(16, {color, color, color, color, color, color}));
+	ASSERT_EQ(mips.size(), 5);
+
+	Image const face = PrefilterCubeMapFace(mips, 2, 8, 0.7f, 32);
+	for (Vec4 const& texel : face.m_Texels) {
+		EXPECT_NEAR(texel.x, color.x, 1e-4f);
+		EXPECT_NEAR(texel.y, color.y, 1e-4f);
+		EXPECT_NEAR(texel.z, color.z, 1e-4f);
+	}
+}
+
+TEST(TextureProcessing, PrefilterCubeMap_RoughnessSpreadsLight) {
+	// Only +X emits light, rougher lobes have to bring some of it to the neighbouring faces
+	Vec4 const            black{0.0f, 0.0f, 0.0f, 1.0f};
+	Vec4 const            white{1.0f};
+	Vector<CubeMap> const mips = GenerateCubeMapMips(CreateCubeMap(16, {white, black, black, black, black, black}));
+
+	auto averageRed = [](Image const& image) {
+		f32 sum = 0.0f;
+		for (Vec4 const& texel : image.m_Texels) { sum += texel.x; }
+		return sum / static_cast<f32>(image.m_Texels.size());
+	};
+
+	f32 const smooth = averageRed(PrefilterCubeMapFace(mips, 4, 8, 0.2f, 64));
+	f32 const rough = averageRed(PrefilterCubeMapFace(mips, 4, 8, 1.0f, 64));
+	EXPECT_GT(rough, smooth);
+	EXPECT_LT(rough, 0.5f);
+}
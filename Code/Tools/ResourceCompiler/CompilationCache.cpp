@@ -0,0 +1,58 @@
+#include "CompilationCache.h"
+
+#include "CookieKat/Core/Serialization/BinarySerialization.h"
+
+namespace CKE {
+	void InputHasher::Add(void const* pData, u64 sizeInBytes) {
+		u8 const* pBytes = static_cast<u8 const*>(pData);
+		for (u64 i = 0; i < sizeInBytes; ++i) {
+			m_Hash = m_Hash ^ pBytes[i];
+			m_Hash = m_Hash * 1099511628211;
+		}
+	}
+
+	void InputHasher::Add(String const& str) {
+		Add(static_cast<u64>(str.size()));
+		Add(str.data(), str.size());
+	}
+
+	void InputHasher::Add(u64 value) {
+		Add(&value, sizeof(u64));
+	}
+
+	//-----------------------------------------------------------------------------
+
+	void CompilationCache::Load(Path const& databasePath) {
+		m_DatabasePath = databasePath;
+		m_Entries.clear();
+		if (!g_FileSystem.Exists(databasePath)) { return; }
+
+		Vector<Entry>      entries{};
+		BinaryInputArchive ar{};
+		ar.ReadFromFile(databasePath.c_str());
+		ar << entries;
+		for (Entry const& entry : entries) { m_Entries[entry.m_OutputPath] = entry.m_InputHash; }
+	}
+
+	void CompilationCache::Save() {
+		Threading::Lock lock{m_Mutex};
+		Vector<Entry>   entries{};
+		entries.reserve(m_Entries.size());
+		for (auto const& [outputPath, inputHash] : m_Entries) { entries.push_back(Entry{outputPath, inputHash}); }
+
+		BinaryOutputArchive ar{};
+		ar << entries;
+		ar.WriteToFile(m_DatabasePath.c_str());
+	}
+
+	bool CompilationCache::IsUpToDate(Path const& outputPath, u64 inputHash) const {
+		Threading::Lock lock{m_Mutex};
+		auto const it = m_Entries.find(outputPath);
+		return it != m_Entries.end() && it->second == inputHash && g_FileSystem.Exists(outputPath);
+	}
+
+	void CompilationCache::Store(Path const& outputPath, u64 inputHash) {
+		Threading::Lock lock{m_Mutex};
+		m_Entries[outputPath] = inputHash;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CookieKat/Core/Containers/Containers.h"
+#include "CookieKat/Core/FileSystem/FileSystem.h"
+#include "CookieKat/Core/Serialization/Archive.h"
+#include "CookieKat/Core/Threading/Threading.h"
+
+namespace CKE {
+	// Incremental FNV-1a hash of everything a compiled resource depends on
+	class InputHasher
+	{
+	public:
+		void Add(void const* pData, u64 sizeInBytes);
+		void Add(String const& str);
+		void Add(u64 value);
+
+		inline u64 GetHash() const { return m_Hash; }
+
+	private:
+		u64 m_Hash = 14695981039346656037u;
+	};
+
+	//-----------------------------------------------------------------------------
+
+	// Database with the input hash each resource was last compiled from, stored next to the sources.
+	// A resource is up to date if its output exists and the hash of its current inputs matches the stored one.
+	class CompilationCache
+	{
+	public:
+		void Load(Path const& databasePath);
+		void Save();
+
+		bool IsUpToDate(Path const& outputPath, u64 inputHash) const;
+
+		// Thread safe, called by the compilation jobs when a resource has been written
+		void Store(Path const& outputPath, u64 inputHash);
+
+	private:
+		struct Entry
+		{
+			CKE_SERIALIZE(m_OutputPath, m_InputHash);
+
+			Path m_OutputPath{};
+			u64  m_InputHash = 0;
+		};
+
+		Path                     m_DatabasePath{};
+		Map<String, u64>         m_Entries{};
+		mutable Threading::Mutex m_Mutex;
+	};
+}
@@ -0,0 +1,185 @@
+#include "CubeMapCompiler.h"
+
+#include "TextureCompiler.h"
+#include "CookieKat/Systems/RenderUtils/SphericalHarmonicsUtils.h"
+#include "CookieKat/Systems/TextureProcessing/CubeMapFiltering.h"
+
+#include <stb_image.h>
+
+#include <chrono>
+#include <limits>
+
+namespace CKE {
+	namespace {
+		// Each index of the set is an independent unit of work, a face or a (face, mip) pair
+		class ForEachTaskSet : public ITaskSet
+		{
+		public:
+			ForEachTaskSet(u32 count, std::function<void(u32)> const& function)
+				: ITaskSet{count, 1}, m_Function{function} {}
+
+			void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override {
+				for (u32 i = range.start; i < range.end; ++i) { m_Function(i); }
+			}
+
+		private:
+			std::function<void(u32)> const& m_Function;
+		};
+
+		f64 GetElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+			auto const end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<f64, std::milli>(end - start).count();
+		}
+	}
+
+	void CubeMapCompiler::Initialize(TaskSystem* pTaskSystem) {
+		m_pTaskSystem = pTaskSystem;
+	}
+
+	bool CubeMapCompiler::Compile(Array<Path, 6> const& facePaths, CubeMapCompilationSettings const& settings,
+	                              RenderCubeMapResource& outCubeMap, CubeMapCompilationReport& outReport) {
+		using namespace TextureProcessing;
+
+		// Import the faces
+		//-----------------------------------------------------------------------------
+
+		auto const decodeStart = std::chrono::high_resolution_clock::now();
+		Array<Vector<u8>, 6> sourceFaces{};
+		Array<UInt2, 6>      sourceSizes{};
+		ParallelFor(6, [&](u32 face) {
+			Blob const imageBlob = g_FileSystem.ReadBinaryFile(facePaths[face]);
+			i32        width = 0;
+			i32        height = 0;
+			i32        numChannels = 0;
+			stbi_uc*   pPixels = stbi_load_from_memory(imageBlob.data(), static_cast<i32>(imageBlob.size()),
+			                                           &width, &height, &numChannels, 4);
+			if (pPixels == nullptr) { return; }
+
+			sourceFaces[face].assign(pPixels, pPixels + static_cast<u64>(width) * height * 4);
+			sourceSizes[face] = UInt2{width, height};
+			stbi_image_free(pPixels);
+		});
+		outReport.m_DecodeMs = GetElapsedMs(decodeStart);
+
+		u32 const faceSize = sourceSizes[0].x;
+		for (u32 face = 0; face < 6; ++face) {
+			if (sourceFaces[face].empty()) { return false; }
+			if (sourceSizes[face].x != faceSize || sourceSizes[face].y != faceSize) { return false; }
+		}
+
+		// Irradiance, projected once here instead of every time the cube map is loaded
+		Vec3 shCoefficients[9];
+		SphericalHarmonicsUtils::SHProjectCubeMap(shCoefficients, sourceFaces, static_cast<i32>(faceSize));
+		for (u32 i = 0; i < 9; ++i) {
+			outCubeMap.m_SHCoefficients[i] = {shCoefficients[i].x, shCoefficients[i].y, shCoefficients[i].z};
+		}
+
+		// Mip chain of every face, the prefiltered radiance for increasing roughness
+		//-----------------------------------------------------------------------------
+
+		auto const prefilterStart = std::chrono::high_resolution_clock::now();
+		u32 const  mipCount = settings.m_Prefilter ? ComputeMipCount(faceSize, faceSize) : 1;
+		u32 const  mipTaskCount = 6 * mipCount;
+
+		// Encoded RGBA8 texels indexed by face * mipCount + mip
+		Vector<Vector<u8>> mips(mipTaskCount);
+		for (u32 face = 0; face < 6; ++face) { mips[face * mipCount] = sourceFaces[face]; }
+
+		if (mipCount > 1) {
+			CubeMap source{};
+			source.m_FaceSize = faceSize;
+			ParallelFor(6, [&](u32 face) {
+				source.m_Faces[face] = DecodeImage(sourceFaces[face].data(), faceSize, faceSize,
+				                                   ImageContent::Color_SRGB);
+			});
+			Vector<CubeMap> const sourceMips = GenerateCubeMapMips(source);
+
+			// The first mip is the source itself, roughness 0
+			ParallelFor(mipTaskCount, [&](u32 taskIdx) {
+				u32 const face = taskIdx / mipCount;
+				u32 const mip = taskIdx % mipCount;
+				if (mip == 0) { return; }
+
+				f32 const   roughness = static_cast<f32>(mip) / static_cast<f32>(mipCount - 1);
+				Image const image = PrefilterCubeMapFace(sourceMips, face, std::max(faceSize >> mip, 1u), roughness,
+				                                         settings.m_PrefilterSampleCount);
+				EncodeImage(image, ImageContent::Color_SRGB, mips[taskIdx]);
+			});
+		}
+		outReport.m_PrefilterMs = GetElapsedMs(prefilterStart);
+
+		// Convert the mips to the GPU layout
+		//-----------------------------------------------------------------------------
+
+		auto const compressionStart = std::chrono::high_resolution_clock::now();
+		if (settings.m_Compress) {
+			ParallelFor(mipTaskCount, [&](u32 taskIdx) {
+				u32 const  mipSize = std::max(faceSize >> (taskIdx % mipCount), 1u);
+				Vector<u8> blocks{};
+				CompressImage(mips[taskIdx].data(), mipSize, mipSize, settings.m_BlockFormat, blocks);
+				mips[taskIdx] = std::move(blocks);
+			});
+		}
+		outReport.m_CompressionMs = GetElapsedMs(compressionStart);
+
+		outCubeMap.m_FaceWidth = faceSize;
+		outCubeMap.m_FaceHeight = faceSize;
+		outCubeMap.m_MipLevels = mipCount;
+		outCubeMap.m_Format = TextureCompiler::GetTextureFormat(TextureCompilationSettings{
+			.m_Content = ImageContent::Color_SRGB,
+			.m_Compress = settings.m_Compress,
+			.m_BlockFormat = settings.m_BlockFormat
+		});
+		for (u32 face = 0; face < 6; ++face) {
+			Vector<u8>& faceData = outCubeMap.m_Faces[face];
+			faceData.clear();
+			for (u32 mip = 0; mip < mipCount; ++mip) {
+				Vector<u8> const& mipData = mips[face * mipCount + mip];
+				faceData.insert(faceData.end(), mipData.begin(), mipData.end());
+			}
+		}
+
+		// Report
+		//-----------------------------------------------------------------------------
+
+		outReport.m_FaceSize = faceSize;
+		outReport.m_MipCount = mipCount;
+		outReport.m_SourceByteSize = 0;
+		outReport.m_CompiledByteSize = 0;
+		for (u32 face = 0; face < 6; ++face) {
+			outReport.m_SourceByteSize += sourceFaces[face].size();
+			outReport.m_CompiledByteSize += outCubeMap.m_Faces[face].size();
+		}
+		outReport.m_PSNR = std::numeric_limits<f64>::infinity();
+		if (settings.m_Compress) {
+			// All the faces are measured as a single image
+			u32 channelMask = 0b1111;
+			if (settings.m_BlockFormat == BlockFormat::BC1) { channelMask = 0b0111; }
+			if (settings.m_BlockFormat == BlockFormat::BC5) { channelMask = 0b0011; }
+
+			Vector<u8> reference{};
+			Vector<u8> decoded{};
+			for (u32 face = 0; face < 6; ++face) {
+				Vector<u8> decodedFace{};
+				DecompressImage(outCubeMap.m_Faces[face].data(), faceSize, faceSize, settings.m_BlockFormat, decodedFace);
+				decoded.insert(decoded.end(), decodedFace.begin(), decodedFace.end());
+				reference.insert(reference.end(), sourceFaces[face].begin(), sourceFaces[face].end());
+			}
+			outReport.m_PSNR = ComputePSNR(reference.data(), decoded.data(),
+			                               static_cast<u64>(faceSize) * faceSize * 6, channelMask);
+		}
+
+		return true;
+	}
+
+	void CubeMapCompiler::ParallelFor(u32 count, std::function<void(u32)> const& function) {
+		ForEachTaskSet taskSet{count, function};
+		if (m_pTaskSystem != nullptr) {
+			m_pTaskSystem->ScheduleTask(&taskSet);
+			m_pTaskSystem->WaitForTask(&taskSet);
+		}
+		else {
+			taskSet.ExecuteRange(enki::TaskSetPartition{0, count}, 0);
+		}
+	}
+}
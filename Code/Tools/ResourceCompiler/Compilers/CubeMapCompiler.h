@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CookieKat/Core/FileSystem/FileSystem.h"
+#include "CookieKat/Engine/Resources/Resources/RenderTextureResource.h"
+#include "CookieKat/Systems/TaskSystem/TaskSystem.h"
+#include "CookieKat/Systems/TextureProcessing/TextureCompression.h"
+
+#include <functional>
+
+namespace CKE {
+	struct CubeMapCompilationSettings
+	{
+		// Stores the GGX prefiltered radiance in the mips, roughness goes linearly from 0 to 1 along the chain
+		bool m_Prefilter = true;
+		u32  m_PrefilterSampleCount = 64;
+
+		bool                           m_Compress = true;
+		TextureProcessing::BlockFormat m_BlockFormat = TextureProcessing::BlockFormat::BC7;
+	};
+
+	// Cost and quality of the compilation, PSNR is measured on the top mip of every face against the source images
+	struct CubeMapCompilationReport
+	{
+		u32 m_FaceSize = 0;
+		u32 m_MipCount = 0;
+		f64 m_DecodeMs = 0.0;
+		f64 m_PrefilterMs = 0.0;
+		f64 m_CompressionMs = 0.0;
+		f64 m_PSNR = 0.0;
+		u64 m_SourceByteSize = 0;
+		u64 m_CompiledByteSize = 0;
+	};
+
+	class CubeMapCompiler
+	{
+	public:
+		// Decoding, prefiltering and compression of the faces is distributed between the workers of the task system
+		void Initialize(TaskSystem* pTaskSystem);
+
+		// Imports the 6 face images (+X, -X, +Y, -Y, +Z, -Z) and fills the resource with their mip chains in the GPU layout
+		// and the irradiance spherical harmonics. Returns false if a face couldn't be imported or the faces don't match.
+		bool Compile(Array<Path, 6> const& facePaths, CubeMapCompilationSettings const& settings,
+		             RenderCubeMapResource& outCubeMap, CubeMapCompilationReport& outReport);
+
+	private:
+		// Runs the function for every index in [0, count) on the task system
+		void ParallelFor(u32 count, std::function<void(u32)> const& function);
+
+	private:
+		TaskSystem* m_pTaskSystem = nullptr;
+	};
+}
@@ -0,0 +1,235 @@
+#include "MeshCompiler.h"
+
+#include "CookieKat/Systems/MeshProcessing/MeshQuantization.h"
+#include "CookieKat/Systems/MeshProcessing/MeshLOD.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <cmath>
+#include <iostream>
+
+namespace CKE {
+	namespace {
+		// Any unit vector perpendicular to the normal, for meshes without texture coordinates to derive tangents from
+		Vec3 GetOrthogonalTangent(Vec3 normal) {
+			Vec3 const axis = std::abs(normal.x) < 0.9f ? Vec3(1.0f, 0.0f, 0.0f) : Vec3(0.0f, 1.0f, 0.0f);
+			return glm::normalize(glm::cross(axis, normal));
+		}
+	}
+
+	bool MeshCompiler::Compile(Path const& meshPath, MeshCompilationSettings const& settings,
+	                           MeshResource& outMesh, MeshCompilationReport& outReport) {
+		using namespace MeshProcessing;
+
+		// Import source mesh
+		//-----------------------------------------------------------------------------
+
+		Blob const       meshBlob = g_FileSystem.ReadBinaryFile(meshPath);
+		String const     extension = meshPath.substr(meshPath.find_last_of('.') + 1);
+		Assimp::Importer importer;
+
+		aiScene const* aiScene = importer.ReadFileFromMemory(
+			meshBlob.data(), meshBlob.size(),
+			aiProcess_CalcTangentSpace |
+			aiProcess_GenSmoothNormals |
+			aiProcess_Triangulate |
+			aiProcess_JoinIdenticalVertices |
+			aiProcess_SortByPType,
+			extension.c_str());
+
+		if (aiScene == nullptr || aiScene->mNumMeshes == 0) { return false; }
+		auto const aiMesh = aiScene->mMeshes[0];
+		if (aiMesh->mNumVertices == 0) { return false; }
+
+		// Normals are generated when missing, only meshes without triangles can lack them
+		if (!aiMesh->HasNormals()) {
+			std::cout << "Mesh has no triangles to shade: " << meshPath << std::endl;
+			return false;
+		}
+
+		// Tangents are computed from the texture coordinates, a mesh without them gets neither
+		bool const hasTexCoords = aiMesh->HasTextureCoords(0);
+		bool const hasTangents = aiMesh->HasTangentsAndBitangents();
+
+		Vector<Vertex_3P3N3T2Tc> vertices{};
+		Vector<Vec3>             positions{};
+		vertices.reserve(aiMesh->mNumVertices);
+		positions.reserve(aiMesh->mNumVertices);
+
+		for (u64 i = 0; i < aiMesh->mNumVertices; ++i) {
+			aiVector3D const& pos = aiMesh->mVertices[i];
+			aiVector3D const& aiNormal = aiMesh->mNormals[i];
+			Vec3 const        normal{aiNormal.x, aiNormal.y, aiNormal.z};
+
+			Vec3 tangent{};
+			if (hasTangents) { tangent = Vec3(aiMesh->mTangents[i].x, aiMesh->mTangents[i].y, aiMesh->mTangents[i].z); }
+			else { tangent = GetOrthogonalTangent(normal); }
+
+			Vec2 texCoord{0.0f};
+			if (hasTexCoords) { texCoord = Vec2(aiMesh->mTextureCoords[0][i].x, aiMesh->mTextureCoords[0][i].y); }
+
+			vertices.emplace_back(Vec3(pos.x, pos.y, pos.z), normal, tangent, texCoord);
+			positions.emplace_back(pos.x, pos.y, pos.z);
+		}
+
+		Vector<u32> indices{};
+		indices.reserve(aiMesh->mNumFaces * 3);
+		for (u64 i = 0; i < aiMesh->mNumFaces; ++i) {
+			for (u64 j = 0; j < aiMesh->mFaces[i].mNumIndices; ++j) {
+				indices.push_back(aiMesh->mFaces[i].mIndices[j]);
+			}
+		}
+
+		// Files can store normals without any faces, the vertex fetch remap would leave no vertices
+		if (indices.empty()) {
+			std::cout << "Mesh has no triangles to draw: " << meshPath << std::endl;
+			return false;
+		}
+
+		outReport.m_CacheBefore = AnalyzeVertexCache(indices, vertices.size());
+		outReport.m_FetchBefore = AnalyzeVertexFetch(indices, vertices.size(), sizeof(Vertex_3P3N3T2Tc));
+		outReport.m_VertexBytesBefore = vertices.size() * sizeof(Vertex_3P3N3T2Tc);
+
+		Vec4 const boundingSphere = ComputeBoundingSphere(positions);
+		outMesh.m_BoundingSphere = {boundingSphere.x, boundingSphere.y, boundingSphere.z, boundingSphere.w};
+
+		// Simplify
+		//-----------------------------------------------------------------------------
+
+		Vector<Vector<u32>> lodIndices{indices};
+		Vector<f32>         lodErrors{0.0f};
+		if (settings.m_GenerateLODs) {
+			GenerateLODChain(vertices, positions, settings, lodIndices, lodErrors);
+		}
+
+		// Optimize
+		//-----------------------------------------------------------------------------
+
+		// Every LOD is drawn on its own, so each one is optimized for the vertex cache
+		for (Vector<u32>& lod : lodIndices) {
+			if (settings.m_OptimizeVertexCache) {
+				OptimizeVertexCache(lod, vertices.size());
+			}
+
+			if (settings.m_OptimizeOverdraw) {
+				OptimizeOverdraw(lod, positions, settings.m_OverdrawThreshold);
+			}
+		}
+
+		// All LODs share one index buffer, full detail first
+		indices.clear();
+		outMesh.m_LODs.clear();
+		for (u64 i = 0; i < lodIndices.size(); ++i) {
+			outMesh.m_LODs.push_back({
+				static_cast<u32>(indices.size()), static_cast<u32>(lodIndices[i].size()), lodErrors[i]
+			});
+			indices.insert(indices.end(), lodIndices[i].begin(), lodIndices[i].end());
+		}
+
+		// Done last, it depends on the final triangle order.
+		// LOD 0 comes first in the index buffer so the vertex order is optimized for it.
+		if (settings.m_OptimizeVertexFetch) {
+			Vector<u32> remap{};
+			u64 const   newVertexCount = OptimizeVertexFetchRemap(indices, vertices.size(), remap);
+			RemapVertexStream(vertices, remap, newVertexCount);
+		}
+
+		// Write GPU-ready streams
+		//-----------------------------------------------------------------------------
+
+		if (settings.m_QuantizeVertices) { WriteQuantizedVertexStream(vertices, outMesh); }
+		else { WriteFullVertexStream(vertices, outMesh); }
+		outMesh.m_Indices = indices;
+
+		// Stats are measured on the full detail LOD to compare with the source mesh
+		Vector<u32> const lod0Indices(indices.begin(), indices.begin() + outMesh.m_LODs[0].m_IndexCount);
+		u64 const         vertexSize = outMesh.m_VertexData.size() / vertices.size();
+		outReport.m_CacheAfter = AnalyzeVertexCache(lod0Indices, vertices.size());
+		outReport.m_FetchAfter = AnalyzeVertexFetch(lod0Indices, vertices.size(), vertexSize);
+		outReport.m_VertexBytesAfter = outMesh.m_VertexData.size();
+
+		return true;
+	}
+
+	void MeshCompiler::GenerateLODChain(Vector<Vertex_3P3N3T2Tc> const& vertices, Vector<Vec3> const& positions,
+	                                    MeshCompilationSettings const& settings,
+	                                    Vector<Vector<u32>>& outLODIndices, Vector<f32>& outLODErrors) {
+		using namespace MeshProcessing;
+
+		// Texture coordinates and normals, so UV and hard edge seams are preserved
+		SimplificationSettings simplification{};
+		simplification.m_MaxError = settings.m_MaxLODError;
+		simplification.m_AttributeWeights = {1.0f, 1.0f, 0.5f, 0.5f, 0.5f};
+
+		Vector<f32> attributes{};
+		attributes.reserve(vertices.size() * simplification.m_AttributeWeights.size());
+		for (Vertex_3P3N3T2Tc const& v : vertices) {
+			attributes.insert(attributes.end(), {
+				                  v.m_TexCoord.x, v.m_TexCoord.y,
+				                  v.m_Normal.x, v.m_Normal.y, v.m_Normal.z
+			                  });
+		}
+
+		while (outLODIndices.size() < settings.m_MaxLODCount) {
+			Vector<u32> const& previous = outLODIndices.back();
+			simplification.m_TargetIndexCount = static_cast<u64>(previous.size() / 3 * settings.m_LODReduction) * 3;
+
+			SimplificationResult lod = SimplifyMesh(previous, positions, attributes, simplification);
+
+			// Stop once the simplification stalls, a LOD that barely removes triangles isn't worth its memory
+			if (lod.m_Indices.empty() || lod.m_Indices.size() > previous.size() * 0.9f) { break; }
+
+			// Each LOD is simplified from the previous one, the errors add up
+			outLODErrors.push_back(outLODErrors.back() + lod.m_Error);
+			outLODIndices.push_back(std::move(lod.m_Indices));
+		}
+	}
+
+	void MeshCompiler::WriteFullVertexStream(Vector<Vertex_3P3N3T2Tc> const& vertices, MeshResource& outMesh) {
+		outMesh.m_VertexFormat = MeshVertexFormat::Full_3P3N3T2Tc;
+		outMesh.m_VertexCount = static_cast<u32>(vertices.size());
+		outMesh.m_VertexData.resize(vertices.size() * sizeof(Vertex_3P3N3T2Tc));
+		memcpy(outMesh.m_VertexData.data(), vertices.data(), outMesh.m_VertexData.size());
+	}
+
+	void MeshCompiler::WriteQuantizedVertexStream(Vector<Vertex_3P3N3T2Tc> const& vertices, MeshResource& outMesh) {
+		using namespace MeshProcessing;
+
+		Vector<Vec3> positions{};
+		positions.reserve(vertices.size());
+		for (Vertex_3P3N3T2Tc const& v : vertices) { positions.push_back(v.m_Position); }
+		PositionQuantization const quantization = ComputePositionQuantization(positions);
+
+		Vector<Vertex_Quantized> quantized(vertices.size());
+		for (u64 i = 0; i < vertices.size(); ++i) {
+			Vertex_3P3N3T2Tc const& v = vertices[i];
+			Vertex_Quantized&       q = quantized[i];
+
+			Vec3 const normalizedPos = NormalizePosition(v.m_Position, quantization);
+			q.m_Position[0] = QuantizeUnorm16(normalizedPos.x);
+			q.m_Position[1] = QuantizeUnorm16(normalizedPos.y);
+			q.m_Position[2] = QuantizeUnorm16(normalizedPos.z);
+			q.m_Position[3] = 0;
+
+			Vec2 const normal = EncodeOctahedral(v.m_Normal);
+			q.m_Normal[0] = QuantizeSnorm16(normal.x);
+			q.m_Normal[1] = QuantizeSnorm16(normal.y);
+
+			Vec2 const tangent = EncodeOctahedral(v.m_Tangent);
+			q.m_Tangent[0] = QuantizeSnorm16(tangent.x);
+			q.m_Tangent[1] = QuantizeSnorm16(tangent.y);
+
+			q.m_TexCoord[0] = QuantizeHalf(v.m_TexCoord.x);
+			q.m_TexCoord[1] = QuantizeHalf(v.m_TexCoord.y);
+		}
+
+		outMesh.m_VertexFormat = MeshVertexFormat::Quantized;
+		outMesh.m_VertexCount = static_cast<u32>(vertices.size());
+		outMesh.m_PositionScale = {quantization.m_Scale.x, quantization.m_Scale.y, quantization.m_Scale.z};
+		outMesh.m_PositionBias = {quantization.m_Bias.x, quantization.m_Bias.y, quantization.m_Bias.z};
+		outMesh.m_VertexData.resize(quantized.size() * sizeof(Vertex_Quantized));
+		memcpy(outMesh.m_VertexData.data(), quantized.data(), outMesh.m_VertexData.size());
+	}
+}
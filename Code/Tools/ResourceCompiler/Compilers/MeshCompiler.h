@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CookieKat/Core/FileSystem/FileSystem.h"
+#include "CookieKat/Engine/Resources/Resources/MeshResource.h"
+#include "CookieKat/Systems/MeshProcessing/MeshOptimization.h"
+#include "CookieKat/Systems/MeshProcessing/MeshSimplification.h"
+
+namespace CKE {
+	struct MeshCompilationSettings
+	{
+		bool m_OptimizeVertexCache = true;
+		bool m_OptimizeOverdraw = true;
+		bool m_OptimizeVertexFetch = true;
+		bool m_QuantizeVertices = false;
+		f32  m_OverdrawThreshold = 1.05f; // Max ACMR degradation allowed when sorting for overdraw
+
+		// Level of detail chain
+		bool m_GenerateLODs = true;
+		u32  m_MaxLODCount = 8;
+		f32  m_LODReduction = 0.5f;  // Index count of each LOD relative to the previous one
+		f32  m_MaxLODError = 0.05f;  // Max simplification error per LOD, relative to the mesh extent
+	};
+
+	// Vertex processing statistics of the mesh before and after compiling it
+	struct MeshCompilationReport
+	{
+		MeshProcessing::VertexCacheStats m_CacheBefore{};
+		MeshProcessing::VertexCacheStats m_CacheAfter{};
+		MeshProcessing::VertexFetchStats m_FetchBefore{};
+		MeshProcessing::VertexFetchStats m_FetchAfter{};
+		u64                              m_VertexBytesBefore = 0;
+		u64                              m_VertexBytesAfter = 0;
+	};
+
+	class MeshCompiler
+	{
+	public:
+		// Imports the mesh file at the given path and fills the resource with its optimized vertex and index streams.
+		// Returns false if the file couldn't be imported.
+		bool Compile(Path const& meshPath, MeshCompilationSettings const& settings,
+		             MeshResource& outMesh, MeshCompilationReport& outReport);
+
+	private:
+		// Simplifies each LOD from the previous one until the reduction stalls or the error limit is reached.
+		// The first entry is the source index buffer.
+		void GenerateLODChain(Vector<Vertex_3P3N3T2Tc> const& vertices, Vector<Vec3> const& positions,
+		                      MeshCompilationSettings const& settings,
+		                      Vector<Vector<u32>>& outLODIndices, Vector<f32>& outLODErrors);
+
+		void WriteFullVertexStream(Vector<Vertex_3P3N3T2Tc> const& vertices, MeshResource& outMesh);
+		void WriteQuantizedVertexStream(Vector<Vertex_3P3N3T2Tc> const& vertices, MeshResource& outMesh);
+	};
+}
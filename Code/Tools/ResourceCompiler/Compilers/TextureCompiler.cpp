@@ -0,0 +1,178 @@
+#include "TextureCompiler.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <limits>
+
+namespace CKE {
+	namespace {
+		// Block rows of all the mips flattened into a single range so small mips don't serialize the work
+		class CompressMipsTaskSet : public ITaskSet
+		{
+		public:
+			CompressMipsTaskSet(Vector<Vector<u8>> const& mips, Vector<UInt2> const& mipSizes,
+			                    Vector<u32> const&        mipFirstRows, Vector<u64> const& mipByteOffsets,
+			                    TextureProcessing::BlockFormat format, u8* pOutData)
+				: ITaskSet{mipFirstRows.back(), 1},
+				  m_Mips{mips}, m_MipSizes{mipSizes}, m_MipFirstRows{mipFirstRows},
+				  m_MipByteOffsets{mipByteOffsets}, m_Format{format}, m_pOutData{pOutData} {}
+
+			void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override {
+				u32 row = range.start;
+				while (row < range.end) {
+					// Mip that contains the row, the last entry of the first rows is the total row count
+					u64 const mip = std::upper_bound(m_MipFirstRows.begin(), m_MipFirstRows.end(), row) -
+					                m_MipFirstRows.begin() - 1;
+					u32 const rowEnd = std::min(range.end, m_MipFirstRows[mip + 1]);
+
+					TextureProcessing::CompressBlockRows(m_Mips[mip].data(), m_MipSizes[mip].x, m_MipSizes[mip].y,
+					                                     m_Format, row - m_MipFirstRows[mip],
+					                                     rowEnd - m_MipFirstRows[mip],
+					                                     m_pOutData + m_MipByteOffsets[mip]);
+					row = rowEnd;
+				}
+			}
+
+		private:
+			Vector<Vector<u8>> const&      m_Mips;
+			Vector<UInt2> const&           m_MipSizes;
+			Vector<u32> const&             m_MipFirstRows;
+			Vector<u64> const&             m_MipByteOffsets;
+			TextureProcessing::BlockFormat m_Format;
+			u8*                            m_pOutData;
+		};
+
+		f64 GetElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+			auto const end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<f64, std::milli>(end - start).count();
+		}
+	}
+
+	void TextureCompiler::Initialize(TaskSystem* pTaskSystem) {
+		m_pTaskSystem = pTaskSystem;
+	}
+
+	bool TextureCompiler::Compile(Path const& imagePath, TextureCompilationSettings const& settings,
+	                              RenderTextureResource& outTexture, TextureCompilationReport& outReport) {
+		using namespace TextureProcessing;
+
+		// Import source image
+		//-----------------------------------------------------------------------------
+
+		Blob const imageBlob = g_FileSystem.ReadBinaryFile(imagePath);
+		i32        width = 0;
+		i32        height = 0;
+		i32        numChannels = 0;
+		stbi_uc*   pPixels = stbi_load_from_memory(imageBlob.data(), static_cast<i32>(imageBlob.size()),
+		                                           &width, &height, &numChannels, 4);
+		if (pPixels == nullptr) { return false; }
+
+		u64 const sourceByteSize = static_cast<u64>(width) * height * 4;
+
+		Vector<Vector<u8>> mips{};
+		Vector<UInt2>      mipSizes{};
+		mips.emplace_back(pPixels, pPixels + sourceByteSize);
+		mipSizes.emplace_back(width, height);
+		stbi_image_free(pPixels);
+
+		// Mip chain, each mip is filtered from the previous one in linear space
+		//-----------------------------------------------------------------------------
+
+		auto const mipStart = std::chrono::high_resolution_clock::now();
+		if (settings.m_GenerateMips) {
+			u32 const mipCount = ComputeMipCount(width, height);
+			Image     image = DecodeImage(mips[0].data(), width, height, settings.m_Content);
+			for (u32 mip = 1; mip < mipCount; ++mip) {
+				image = DownsampleImage(image, settings.m_MipFilter, settings.m_Content);
+				EncodeImage(image, settings.m_Content, mips.emplace_back());
+				mipSizes.emplace_back(image.m_Width, image.m_Height);
+			}
+		}
+		outReport.m_MipGenerationMs = GetElapsedMs(mipStart);
+
+		// Convert the mips to the GPU layout
+		//-----------------------------------------------------------------------------
+
+		auto const compressionStart = std::chrono::high_resolution_clock::now();
+		outTexture.m_Data.clear();
+		if (settings.m_Compress) {
+			CompressMips(mips, mipSizes, settings.m_BlockFormat, outTexture.m_Data);
+		}
+		else {
+			for (Vector<u8> const& mip : mips) {
+				outTexture.m_Data.insert(outTexture.m_Data.end(), mip.begin(), mip.end());
+			}
+		}
+		outReport.m_CompressionMs = GetElapsedMs(compressionStart);
+
+		outTexture.m_Desc.m_Size = UInt3{width, height, 1};
+		outTexture.m_Desc.m_Format = GetTextureFormat(settings);
+		outTexture.m_Desc.m_MipLevels = static_cast<u32>(mips.size());
+
+		// Report
+		//-----------------------------------------------------------------------------
+
+		outReport.m_Width = width;
+		outReport.m_Height = height;
+		outReport.m_MipCount = static_cast<u32>(mips.size());
+		outReport.m_SourceByteSize = sourceByteSize;
+		outReport.m_CompiledByteSize = outTexture.m_Data.size();
+		outReport.m_PSNR = std::numeric_limits<f64>::infinity();
+		if (settings.m_Compress) {
+			// BC1 alpha is a single bit and BC5 only stores two channels, ignore what the format can't hold
+			u32 channelMask = 0b1111;
+			if (settings.m_BlockFormat == BlockFormat::BC1) { channelMask = 0b0111; }
+			if (settings.m_BlockFormat == BlockFormat::BC5) { channelMask = 0b0011; }
+
+			Vector<u8> decoded{};
+			DecompressImage(outTexture.m_Data.data(), width, height, settings.m_BlockFormat, decoded);
+			outReport.m_PSNR = ComputePSNR(mips[0].data(), decoded.data(),
+			                               static_cast<u64>(width) * height, channelMask);
+		}
+
+		return true;
+	}
+
+	TextureFormat TextureCompiler::GetTextureFormat(TextureCompilationSettings const& settings) {
+		using namespace TextureProcessing;
+
+		bool const isSRGB = settings.m_Content == ImageContent::Color_SRGB;
+		if (!settings.m_Compress) {
+			return isSRGB ? TextureFormat::R8G8B8A8_SRGB : TextureFormat::R8G8B8A8_UNORM;
+		}
+
+		switch (settings.m_BlockFormat) {
+		case BlockFormat::BC1: return isSRGB ? TextureFormat::BC1_RGBA_SRGB : TextureFormat::BC1_RGBA_UNORM;
+		case BlockFormat::BC3: return isSRGB ? TextureFormat::BC3_SRGB : TextureFormat::BC3_UNORM;
+		case BlockFormat::BC5: return TextureFormat::BC5_UNORM;
+		case BlockFormat::BC7: return isSRGB ? TextureFormat::BC7_SRGB : TextureFormat::BC7_UNORM;
+		}
+		return TextureFormat::R8G8B8A8_UNORM;
+	}
+
+	void TextureCompiler::CompressMips(Vector<Vector<u8>> const& mips, Vector<UInt2> const& mipSizes,
+	                                   TextureProcessing::BlockFormat format, Vector<u8>& outData) {
+		using namespace TextureProcessing;
+
+		// Every mip is written to its final offset so the blocks can be compressed in any order
+		Vector<u32> mipFirstRows{0};
+		Vector<u64> mipByteOffsets{0};
+		for (UInt2 const& size : mipSizes) {
+			mipFirstRows.push_back(mipFirstRows.back() + GetBlockCount(size.y));
+			mipByteOffsets.push_back(mipByteOffsets.back() + GetCompressedImageByteSize(format, size.x, size.y));
+		}
+		outData.resize(mipByteOffsets.back());
+
+		CompressMipsTaskSet taskSet{mips, mipSizes, mipFirstRows, mipByteOffsets, format, outData.data()};
+		if (m_pTaskSystem != nullptr) {
+			m_pTaskSystem->ScheduleTask(&taskSet);
+			m_pTaskSystem->WaitForTask(&taskSet);
+		}
+		else {
+			taskSet.ExecuteRange(enki::TaskSetPartition{0, mipFirstRows.back()}, 0);
+		}
+	}
+}
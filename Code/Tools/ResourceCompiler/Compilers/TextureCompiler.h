@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CookieKat/Core/FileSystem/FileSystem.h"
+#include "CookieKat/Engine/Resources/Resources/RenderTextureResource.h"
+#include "CookieKat/Systems/TaskSystem/TaskSystem.h"
+#include "CookieKat/Systems/TextureProcessing/TextureMips.h"
+#include "CookieKat/Systems/TextureProcessing/TextureCompression.h"
+
+namespace CKE {
+	struct TextureCompilationSettings
+	{
+		TextureProcessing::ImageContent m_Content = TextureProcessing::ImageContent::Color_SRGB;
+
+		bool                         m_GenerateMips = true;
+		TextureProcessing::MipFilter m_MipFilter = TextureProcessing::MipFilter::Kaiser;
+
+		bool                           m_Compress = true;
+		TextureProcessing::BlockFormat m_BlockFormat = TextureProcessing::BlockFormat::BC7;
+	};
+
+	// Cost and quality of the compilation, PSNR is measured on the top mip against the source image
+	struct TextureCompilationReport
+	{
+		u32 m_Width = 0;
+		u32 m_Height = 0;
+		u32 m_MipCount = 0;
+		f64 m_MipGenerationMs = 0.0;
+		f64 m_CompressionMs = 0.0;
+		f64 m_PSNR = 0.0;
+		u64 m_SourceByteSize = 0;
+		u64 m_CompiledByteSize = 0;
+	};
+
+	class TextureCompiler
+	{
+	public:
+		// Compression of the mips is distributed between the workers of the task system
+		void Initialize(TaskSystem* pTaskSystem);
+
+		// Imports the image at the given path and fills the resource with its mip chain in the GPU layout.
+		// Returns false if the image couldn't be imported.
+		bool Compile(Path const& imagePath, TextureCompilationSettings const& settings,
+		             RenderTextureResource& outTexture, TextureCompilationReport& outReport);
+
+		static TextureFormat GetTextureFormat(TextureCompilationSettings const& settings);
+
+	private:
+		// Encodes the blocks of all the mips, each task compresses a range of block rows of a single mip
+		void CompressMips(Vector<Vector<u8>> const& mips, Vector<UInt2> const& mipSizes,
+		                  TextureProcessing::BlockFormat format, Vector<u8>& outData);
+
+	private:
+		TaskSystem* m_pTaskSystem = nullptr;
+	};
+}
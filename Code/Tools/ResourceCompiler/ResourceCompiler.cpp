@@ -11,8 +11,11 @@
 #include "CookieKat/Engine/Resources/Resources/RenderMaterialResource.h"
 
 #include <rapidjson/document.h>
-#include <stb_image.h>
-#include <lodepng.h>
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <iostream>
 
 //-----------------------------------------------------------------------------
 
@@ -20,10 +23,17 @@ namespace CKE {
 	void ResourceCompiler::Initialize(const char* inputBasePath, const char* outputBasePath) {
 		m_CompilerData.m_InputBasePath = inputBasePath;
 		m_CompilerData.m_OutputBasePath = outputBasePath;
+		m_TaskSystem.Initialize();
 		m_MaterialCompiler.Initialize();
+		m_TextureCompiler.Initialize(&m_TaskSystem);
+		m_CubeMapCompiler.Initialize(&m_TaskSystem);
+	}
+
+	void ResourceCompiler::Shutdown() {
+		m_TaskSystem.Shutdown();
 	}
 
-	void ResourceCompiler::CompileMaterial(String const& fileBaseName) {
+	bool ResourceCompiler::CompileMaterial(String const& fileBaseName) {
 		String pInputPath = String(fileBaseName).append(".ckadef");
 		String pResourcePath = String(fileBaseName).append(".mat");
 
@@ -40,7 +50,7 @@ namespace CKE {
 
 		if (doc["AssetType"].GetString() != String("Material")) {
 			std::cout << "Input file is not a material definition" << std::endl;
-			return;
+			return false;
 		}
 
 		String albedoID = doc["AlbedoTextureID"].GetString();
@@ -72,9 +82,10 @@ namespace CKE {
 		ar << material;
 
 		ar.WriteToFile(pResourcePath.c_str());
+		return true;
 	}
 
-	void ResourceCompiler::CompilePipeline(String const& fileBaseName) {
+	bool ResourceCompiler::CompilePipeline(String const& fileBaseName) {
 		String pInputPath = String(fileBaseName).append(".ckadef");
 		String pOutputPath = String(fileBaseName).append(".pipeline");
 
@@ -91,7 +102,7 @@ namespace CKE {
 
 		if (doc["AssetType"].GetString() != String("Pipeline")) {
 			std::cout << "Input file is not a material definition" << std::endl;
-			return;
+			return false;
 		}
 
 		//String pipelineType = doc["PipelineType"].GetString();
@@ -109,19 +120,27 @@ namespace CKE {
 
 		bool enableDebugInfo = false;
 
+		// Temporaries are named after the asset so several pipelines can be compiled at the same time
+		String const tempVertPath = fileBaseName + ".vert.spv.tmp";
+		String const tempFragPath = fileBaseName + ".frag.spv.tmp";
+
 		String compileCmdVert = "glslangValidator.exe -V " + vertPath +
-				" -o tempShader.vert";
+				" -o " + tempVertPath;
 		String compileCmdFrag = "glslangValidator.exe -V " + fragPath +
-				" -o tempShader.frag";
-		system(compileCmdVert.c_str());
-		system(compileCmdFrag.c_str());
+				" -o " + tempFragPath;
+		if (system(compileCmdVert.c_str()) != 0 || system(compileCmdFrag.c_str()) != 0) {
+			std::cout << "Couldn't compile the shaders of: " << fileBaseName << std::endl;
+			g_FileSystem.RemoveFile(tempVertPath);
+			g_FileSystem.RemoveFile(tempFragPath);
+			return false;
+		}
 
-		Blob   vertBlob = g_FileSystem.ReadBinaryFile("tempShader.vert");
-		Blob   fragBlob = g_FileSystem.ReadBinaryFile("tempShader.frag");
+		Blob   vertBlob = g_FileSystem.ReadBinaryFile(tempVertPath);
+		Blob   fragBlob = g_FileSystem.ReadBinaryFile(tempFragPath);
 		String vertShaderSource = String(vertBlob.begin(), vertBlob.end());
 		String fragShaderSource = String(fragBlob.begin(), fragBlob.end());
-		g_FileSystem.RemoveFile("tempShader.vert");
-		g_FileSystem.RemoveFile("tempShader.frag");
+		g_FileSystem.RemoveFile(tempVertPath);
+		g_FileSystem.RemoveFile(tempFragPath);
 
 		// Compile
 		//-----------------------------------------------------------------------------
@@ -138,9 +157,10 @@ namespace CKE {
 
 		archive << header << pipelineResource;
 		archive.WriteToFile(pOutputPath.c_str());
+		return true;
 	}
 
-	void ResourceCompiler::CompileTexture(String const& fileBaseName) {
+	bool ResourceCompiler::CompileTexture(String const& fileBaseName) {
 		String pInputPath = String(fileBaseName).append(".ckadef");
 		String pResourcePath = String(fileBaseName).append(".tex");
 
@@ -157,55 +177,72 @@ namespace CKE {
 
 		if (doc["AssetType"].GetString() != String("Texture")) {
 			std::cout << "Input file is not a material definition" << std::endl;
-			return;
+			return false;
 		}
 
 		String path = doc["TexturePath"].GetString();
 		String format = doc["Format"].GetString();
 
+		TextureCompilationSettings settings{};
+		settings.m_Content = format == "UNORM"
+			                     ? TextureProcessing::ImageContent::Color_Linear
+			                     : TextureProcessing::ImageContent::Color_SRGB;
+		if (doc.HasMember("NormalMap") && doc["NormalMap"].GetBool()) {
+			settings.m_Content = TextureProcessing::ImageContent::NormalMap;
+			settings.m_BlockFormat = TextureProcessing::BlockFormat::BC5;
+		}
+		if (doc.HasMember("GenerateMips")) {
+			settings.m_GenerateMips = doc["GenerateMips"].GetBool();
+		}
+		if (doc.HasMember("MipFilter")) {
+			String const filter = doc["MipFilter"].GetString();
+			if (filter == "Box") { settings.m_MipFilter = TextureProcessing::MipFilter::Box; }
+			else if (filter == "Kaiser") { settings.m_MipFilter = TextureProcessing::MipFilter::Kaiser; }
+		}
+		if (doc.HasMember("Compression")) {
+			String const compression = doc["Compression"].GetString();
+			if (compression == "None") { settings.m_Compress = false; }
+			else if (compression == "BC1") { settings.m_BlockFormat = TextureProcessing::BlockFormat::BC1; }
+			else if (compression == "BC3") { settings.m_BlockFormat = TextureProcessing::BlockFormat::BC3; }
+			else if (compression == "BC5") { settings.m_BlockFormat = TextureProcessing::BlockFormat::BC5; }
+			else if (compression == "BC7") { settings.m_BlockFormat = TextureProcessing::BlockFormat::BC7; }
+		}
+
+		// Compile
+		//-----------------------------------------------------------------------------
+
+		RenderTextureResource    tex{};
+		TextureCompilationReport report{};
+		if (!m_TextureCompiler.Compile(path, settings, tex, report)) {
+			std::cout << "Couldn't import texture: " << path << std::endl;
+			return false;
+		}
+
+		std::cout << std::format("Texture: {} ({}x{}, {} mips)\n", path, report.m_Width, report.m_Height, report.m_MipCount);
+		std::cout << std::format("  Mip Generation: {:.2f} ms\n", report.m_MipGenerationMs);
+		std::cout << std::format("  Compression:    {:.2f} ms\n", report.m_CompressionMs);
+		std::cout << std::format("  PSNR:           {:.2f} dB\n", report.m_PSNR);
+		std::cout << std::format("  Bytes:          {} -> {}\n", report.m_SourceByteSize, report.m_CompiledByteSize);
+
 		// Write to file
 		//-----------------------------------------------------------------------------
 
-		BinaryOutputArchive ar{};
+		// Streamed to disk while being written, the resource data is not duplicated in the archive
+		BinaryStreamOutputArchive ar{};
+		if (!ar.Open(pResourcePath.c_str())) {
+			std::cout << "Couldn't open output file: " << pResourcePath << std::endl;
+			return false;
+		}
 
 		ResourceHeader header{};
 		header.m_ResourceType = 3; // TODO: Replace with Type System
 		header.m_ResourcePath = pResourcePath;
 
-		ar << header;
-
-		RenderTextureResource tex{};
-
-		// Load image binary data
-		Blob  imageBlob = g_FileSystem.ReadBinaryFile(path);
-		u64   imageByteSize = imageBlob.size();
-		i32   numChannels = 0;
-		i32   width = 0;
-		i32   height = 0;
-		void* pRawTextureBytes = stbi_load_from_memory(imageBlob.data(), imageByteSize,
-		                                               &width, &height, &numChannels, 4);
-		tex.m_Data.resize(width * height * 4);
-		memcpy(tex.m_Data.data(), pRawTextureBytes, width * height * 4);
-
-		Vector<u8> compressedTexture{};
-		compressedTexture.reserve(width * height * 4);
-		if (lodepng::encode(compressedTexture, tex.m_Data, width, height));
-		tex.m_Data = compressedTexture;
-
-		stbi_image_free(pRawTextureBytes);
-
-		if (format == "SRGB") { tex.m_Desc.m_Format = TextureFormat::R8G8B8A8_SRGB; }
-		else if (format == "UNORM") { tex.m_Desc.m_Format = TextureFormat::R8G8B8A8_UNORM; }
-
-		tex.m_Desc.m_Size.x = width;
-		tex.m_Desc.m_Size.y = height;
-
-		ar << tex;
-
-		ar.WriteToFile(pResourcePath.c_str());
+		ar << header << tex;
+		return ar.Close();
 	}
 
-	void ResourceCompiler::CompileCubeMap(String const& fileBaseName) {
+	bool ResourceCompiler::CompileCubeMap(String const& fileBaseName) {
 		String pInputPath = String(fileBaseName).append(".ckadef");
 		String pResourcePath = String(fileBaseName).append(".cubeMap");
 
@@ -222,56 +259,431 @@ namespace CKE {
 
 		if (doc["AssetType"].GetString() != String("CubeMap")) {
 			std::cout << "Input file is not a material definition" << std::endl;
-			return;
+			return false;
 		}
 
-		Array<String, 6> cubeMapPaths;
+		Array<Path, 6> cubeMapPaths;
 		cubeMapPaths[0] = doc["N_Positive_Path"].GetString();
 		cubeMapPaths[1] = doc["N_Negative_Path"].GetString();
 		cubeMapPaths[2] = doc["Y_Positive_Path"].GetString();
 		cubeMapPaths[3] = doc["Y_Negative_Path"].GetString();
 		cubeMapPaths[4] = doc["Z_Positive_Path"].GetString();
 		cubeMapPaths[5] = doc["Z_Negative_Path"].GetString();
-		String format = doc["Format"].GetString();
+
+		CubeMapCompilationSettings settings{};
+		if (doc.HasMember("Prefilter")) {
+			settings.m_Prefilter = doc["Prefilter"].GetBool();
+		}
+		if (doc.HasMember("PrefilterSamples")) {
+			settings.m_PrefilterSampleCount = doc["PrefilterSamples"].GetUint();
+		}
+		if (doc.HasMember("Compression")) {
+			String const compression = doc["Compression"].GetString();
+			if (compression == "None") { settings.m_Compress = false; }
+			else if (compression == "BC1") { settings.m_BlockFormat = TextureProcessing::BlockFormat::BC1; }
+			else if (compression == "BC3") { settings.m_BlockFormat = TextureProcessing::BlockFormat::BC3; }
+			else if (compression == "BC7") { settings.m_BlockFormat = TextureProcessing::BlockFormat::BC7; }
+		}
+
+		// Compile
+		//-----------------------------------------------------------------------------
+
+		RenderCubeMapResource    tex{};
+		CubeMapCompilationReport report{};
+		if (!m_CubeMapCompiler.Compile(cubeMapPaths, settings, tex, report)) {
+			std::cout << "Couldn't import cube map faces: " << fileBaseName << std::endl;
+			return false;
+		}
+
+		std::cout << std::format("CubeMap: {} ({}x{}, {} mips)\n", fileBaseName, report.m_FaceSize, report.m_FaceSize,
+		                         report.m_MipCount);
+		std::cout << std::format("  Decode:      {:.2f} ms\n", report.m_DecodeMs);
+		std::cout << std::format("  Prefilter:   {:.2f} ms\n", report.m_PrefilterMs);
+		std::cout << std::format("  Compression: {:.2f} ms\n", report.m_CompressionMs);
+		std::cout << std::format("  PSNR:        {:.2f} dB\n", report.m_PSNR);
+		std::cout << std::format("  Bytes:       {} -> {}\n", report.m_SourceByteSize, report.m_CompiledByteSize);
 
 		// Write to file
 		//-----------------------------------------------------------------------------
 
-		BinaryOutputArchive ar{};
+		BinaryStreamOutputArchive ar{};
+		if (!ar.Open(pResourcePath.c_str())) {
+			std::cout << "Couldn't open output file: " << pResourcePath << std::endl;
+			return false;
+		}
 
-		// Write Asset Header
 		ResourceHeader header{};
 		header.m_ResourceType = 3; // TODO: Replace with Type System
 		header.m_ResourcePath = pResourcePath;
-		ar << header;
 
-		// Load All of the 6 faces and save them to the converted file
-		i32   numChannels = 0, width = 0, height = 0;
-		Vector<u8> uncompressedTexture{};
+		ar << header << tex;
+		return ar.Close();
+	}
 
-		RenderCubeMapResource tex{};
-		for (i32 i = 0; i < 6; ++i) {
-			String const& path = cubeMapPaths[i];
-			Vector<u8>& faceData = tex.m_Faces[i];
-			
-			Blob  imageBlob = g_FileSystem.ReadBinaryFile(path);
-			void* pRawTextureBytes = stbi_load_from_memory(imageBlob.data(), imageBlob.size(),
-			                                               &width, &height, &numChannels, 4);
-			uncompressedTexture.resize(width * height * 4);
+	bool ResourceCompiler::CompileMesh(String const& fileBaseName) {
+		String pInputPath = String(fileBaseName).append(".ckadef");
+		String pResourcePath = String(fileBaseName).append(".mesh");
+
+		// Open Json Asset Definition
+		//-----------------------------------------------------------------------------
 
-			memcpy(uncompressedTexture.data(), pRawTextureBytes, width * height * 4);
+		Blob                assetDefBlob = g_FileSystem.ReadBinaryFile(pInputPath);
+		rapidjson::Document doc;
+		String const        assetDefJson = String(assetDefBlob.begin(), assetDefBlob.end());
+		doc.Parse(assetDefJson.c_str());
 
-			faceData.reserve(width * height * 4);
-			lodepng::encode(faceData, uncompressedTexture, width, height);
+		// Parse Asset Definition
+		//-----------------------------------------------------------------------------
 
-			stbi_image_free(pRawTextureBytes);
+		if (doc["AssetType"].GetString() != String("Mesh")) {
+			std::cout << "Input file is not a mesh definition" << std::endl;
+			return false;
 		}
 
-		tex.m_FaceWidth = width;
-		tex.m_FaceHeight = height;
+		String meshPath = doc["MeshPath"].GetString();
 
-		ar << tex;
+		MeshCompilationSettings settings{};
+		if (doc.HasMember("Optimize")) {
+			bool const optimize = doc["Optimize"].GetBool();
+			settings.m_OptimizeVertexCache = optimize;
+			settings.m_OptimizeOverdraw = optimize;
+			settings.m_OptimizeVertexFetch = optimize;
+		}
+		if (doc.HasMember("Quantize")) {
+			settings.m_QuantizeVertices = doc["Quantize"].GetBool();
+		}
+		if (doc.HasMember("GenerateLODs")) {
+			settings.m_GenerateLODs = doc["GenerateLODs"].GetBool();
+		}
 
-		ar.WriteToFile(pResourcePath.c_str());
+		// Compile
+		//-----------------------------------------------------------------------------
+
+		MeshResource          mesh{};
+		MeshCompilationReport report{};
+		if (!m_MeshCompiler.Compile(meshPath, settings, mesh, report)) {
+			std::cout << "Couldn't import mesh: " << meshPath << std::endl;
+			return false;
+		}
+
+		std::cout << std::format("Mesh: {} ({} triangles)\n", meshPath, report.m_CacheAfter.m_TriangleCount);
+		std::cout << std::format("  ACMR:         {:.3f} -> {:.3f}\n", report.m_CacheBefore.m_ACMR, report.m_CacheAfter.m_ACMR);
+		std::cout << std::format("  ATVR:         {:.3f} -> {:.3f}\n", report.m_CacheBefore.m_ATVR, report.m_CacheAfter.m_ATVR);
+		std::cout << std::format("  Overfetch:    {:.3f} -> {:.3f}\n", report.m_FetchBefore.m_Overfetch, report.m_FetchAfter.m_Overfetch);
+		std::cout << std::format("  Vertex Bytes: {} -> {}\n", report.m_VertexBytesBefore, report.m_VertexBytesAfter);
+		for (u64 i = 0; i < mesh.GetLODs().size(); ++i) {
+			MeshProcessing::MeshLOD const& lod = mesh.GetLOD(static_cast<u32>(i));
+			std::cout << std::format("  LOD {}:        {} triangles, error {:.5f}\n", i, lod.m_IndexCount / 3, lod.m_Error);
+		}
+
+		// Write to file
+		//-----------------------------------------------------------------------------
+
+		BinaryStreamOutputArchive ar{};
+		if (!ar.Open(pResourcePath.c_str())) {
+			std::cout << "Couldn't open output file: " << pResourcePath << std::endl;
+			return false;
+		}
+
+		ResourceHeader header{};
+		header.m_ResourceType = 4; // TODO: Replace with Type System
+		header.m_ResourcePath = pResourcePath;
+
+		ar << header << mesh;
+		return ar.Close();
 	}
 };
+
+//-----------------------------------------------------------------------------
+// Batch Compilation
+//-----------------------------------------------------------------------------
+
+namespace CKE {
+	namespace {
+		// Extension of the resource written by each asset type, nullptr for unknown types
+		char const* GetResourceExtension(String const& assetType) {
+			if (assetType == "Material") { return ".mat"; }
+			if (assetType == "Pipeline") { return ".pipeline"; }
+			if (assetType == "Texture") { return ".tex"; }
+			if (assetType == "CubeMap") { return ".cubeMap"; }
+			if (assetType == "Mesh") { return ".mesh"; }
+			return nullptr;
+		}
+
+		bool IsResourcePath(String const& path) {
+			for (char const* pExtension : {".mat", ".pipeline", ".tex", ".cubeMap", ".mesh"}) {
+				if (path.ends_with(pExtension)) { return true; }
+			}
+			return false;
+		}
+
+		Path NormalizePath(Path path) {
+			std::replace(path.begin(), path.end(), '\\', '/');
+			return path;
+		}
+
+		bool IsShaderPath(Path const& path) {
+			for (char const* pExtension : {".vert", ".frag", ".comp", ".geom", ".tesc", ".tese", ".glsl"}) {
+				if (path.ends_with(pExtension)) { return true; }
+			}
+			return false;
+		}
+
+		// Appends the files included by the shader and by its includes, resolved relative to the including file as
+		// glslangValidator does. Includes that can't be found are left to the shader compiler to report.
+		void GatherShaderIncludes(Path const& shaderPath, Vector<Path>& includePaths) {
+			Path const normalizedPath = NormalizePath(shaderPath);
+			usize const directoryEnd = normalizedPath.find_last_of('/');
+			Path const directory = directoryEnd == Path::npos ? Path{} : normalizedPath.substr(0, directoryEnd + 1);
+
+			String const source = g_FileSystem.ReadTextFile(shaderPath);
+			usize        lineStart = 0;
+			while (lineStart < source.size()) {
+				usize lineEnd = source.find('\n', lineStart);
+				if (lineEnd == String::npos) { lineEnd = source.size(); }
+				String const line = source.substr(lineStart, lineEnd - lineStart);
+				lineStart = lineEnd + 1;
+
+				usize const directive = line.find_first_not_of(" \t");
+				if (directive == String::npos || line.compare(directive, 8, "#include") != 0) { continue; }
+				usize const nameStart = line.find_first_of("\"<", directive + 8);
+				if (nameStart == String::npos) { continue; }
+				usize const nameEnd = line.find_first_of("\">", nameStart + 1);
+				if (nameEnd == String::npos) { continue; }
+
+				Path const includePath = directory + line.substr(nameStart + 1, nameEnd - nameStart - 1);
+				if (!g_FileSystem.Exists(includePath)) { continue; }
+				if (std::find(includePaths.begin(), includePaths.end(), includePath) != includePaths.end()) { continue; }
+				includePaths.push_back(includePath);
+				GatherShaderIncludes(includePath, includePaths);
+			}
+		}
+
+		f64 GetElapsedMs(std::chrono::high_resolution_clock::time_point start) {
+			auto const end = std::chrono::high_resolution_clock::now();
+			return std::chrono::duration<f64, std::milli>(end - start).count();
+		}
+
+		struct BatchAsset
+		{
+			Path         m_BaseName{};
+			String       m_AssetType{};
+			Path         m_OutputPath{};
+			Blob         m_Definition{};
+			Vector<Path> m_SourcePaths{};     // Files read by the compiler of the asset
+			Vector<Path> m_IncludePaths{};    // Files included by the shaders of the source files
+			Vector<Path> m_DependencyPaths{}; // Resources referenced by the asset
+			Vector<u32>  m_Dependencies{};    // Assets of the batch that compile the referenced resources
+
+			u32  m_Depth = 0;
+			u64  m_InputHash = 0;
+			f64  m_CompileTimeMs = 0.0;
+			bool m_Succeeded = false; // Compiled or up to date
+		};
+
+		// Longest chain of dependencies below the asset, assets of the same depth can be compiled in parallel
+		u32 ComputeDepth(Vector<BatchAsset>& assets, Vector<u8>& visitState, u32 assetIdx) {
+			if (visitState[assetIdx] == 2) { return assets[assetIdx].m_Depth; }
+			if (visitState[assetIdx] == 1) {
+				std::cout << "Dependency cycle found at: " << assets[assetIdx].m_BaseName << std::endl;
+				return 0;
+			}
+
+			visitState[assetIdx] = 1;
+			u32 depth = 0;
+			for (u32 dependency : assets[assetIdx].m_Dependencies) {
+				depth = std::max(depth, ComputeDepth(assets, visitState, dependency) + 1);
+			}
+			assets[assetIdx].m_Depth = depth;
+			visitState[assetIdx] = 2;
+			return depth;
+		}
+
+		class CompileAssetsTaskSet : public ITaskSet
+		{
+		public:
+			CompileAssetsTaskSet(ResourceCompiler* pCompiler, Vector<BatchAsset>& assets, Vector<u32> const& assetsToCompile)
+				: ITaskSet{static_cast<u32>(assetsToCompile.size()), 1},
+				  m_pCompiler{pCompiler}, m_Assets{assets}, m_AssetsToCompile{assetsToCompile} {}
+
+			void ExecuteRange(enki::TaskSetPartition range, uint32_t threadNum) override {
+				for (u32 i = range.start; i < range.end; ++i) {
+					BatchAsset& asset = m_Assets[m_AssetsToCompile[i]];
+					auto const  start = std::chrono::high_resolution_clock::now();
+					asset.m_Succeeded = m_pCompiler->CompileAsset(asset.m_BaseName);
+					asset.m_CompileTimeMs = GetElapsedMs(start);
+				}
+			}
+
+		private:
+			ResourceCompiler*   m_pCompiler;
+			Vector<BatchAsset>& m_Assets;
+			Vector<u32> const&  m_AssetsToCompile;
+		};
+	}
+
+	bool ResourceCompiler::CompileAsset(String const& fileBaseName) {
+		Blob                assetDefBlob = g_FileSystem.ReadBinaryFile(String(fileBaseName).append(".ckadef"));
+		rapidjson::Document doc;
+		String const        assetDefJson = String(assetDefBlob.begin(), assetDefBlob.end());
+		doc.Parse(assetDefJson.c_str());
+		if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("AssetType")) {
+			std::cout << "Invalid asset definition: " << fileBaseName << std::endl;
+			return false;
+		}
+
+		String const assetType = doc["AssetType"].GetString();
+		if (assetType == "Material") { return CompileMaterial(fileBaseName); }
+		if (assetType == "Pipeline") { return CompilePipeline(fileBaseName); }
+		if (assetType == "Texture") { return CompileTexture(fileBaseName); }
+		if (assetType == "CubeMap") { return CompileCubeMap(fileBaseName); }
+		if (assetType == "Mesh") { return CompileMesh(fileBaseName); }
+
+		std::cout << "Asset type [ " << assetType << " ] not supported: " << fileBaseName << std::endl;
+		return false;
+	}
+
+	void ResourceCompiler::CompileDirectory(Path const& sourceDirectory, BatchCompilationReport& outReport) {
+		auto const batchStart = std::chrono::high_resolution_clock::now();
+		outReport = BatchCompilationReport{};
+
+		// Gather the asset definitions and the files and resources they reference
+		//-----------------------------------------------------------------------------
+
+		Vector<BatchAsset> assets{};
+		for (Path const& definitionPath : g_FileSystem.ListFilesRecursive(sourceDirectory, ".ckadef")) {
+			BatchAsset asset{};
+			asset.m_BaseName = definitionPath.substr(0, definitionPath.size() - String(".ckadef").size());
+			asset.m_Definition = g_FileSystem.ReadBinaryFile(definitionPath);
+
+			rapidjson::Document doc;
+			String const        assetDefJson = String(asset.m_Definition.begin(), asset.m_Definition.end());
+			doc.Parse(assetDefJson.c_str());
+			if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("AssetType")) {
+				std::cout << "Invalid asset definition: " << definitionPath << std::endl;
+				continue;
+			}
+
+			asset.m_AssetType = doc["AssetType"].GetString();
+			char const* pExtension = GetResourceExtension(asset.m_AssetType);
+			if (pExtension == nullptr) {
+				std::cout << "Asset type [ " << asset.m_AssetType << " ] not supported: " << definitionPath << std::endl;
+				continue;
+			}
+			asset.m_OutputPath = asset.m_BaseName + pExtension;
+
+			// Any string of the definition is either a referenced resource or a source file of the compiler
+			for (auto it = doc.MemberBegin(); it != doc.MemberEnd(); ++it) {
+				if (!it->value.IsString()) { continue; }
+				String const value = it->value.GetString();
+				if (IsResourcePath(value)) { asset.m_DependencyPaths.push_back(NormalizePath(value)); }
+				else if (g_FileSystem.Exists(value)) { asset.m_SourcePaths.push_back(value); }
+			}
+			for (Path const& sourcePath : asset.m_SourcePaths) {
+				if (IsShaderPath(sourcePath)) { GatherShaderIncludes(sourcePath, asset.m_IncludePaths); }
+			}
+
+			assets.push_back(std::move(asset));
+		}
+		outReport.m_AssetCount = static_cast<u32>(assets.size());
+
+		// Dependency graph, references to resources that aren't compiled by the batch are ignored
+		//-----------------------------------------------------------------------------
+
+		for (BatchAsset& asset : assets) {
+			for (Path const& dependencyPath : asset.m_DependencyPaths) {
+				for (u32 i = 0; i < assets.size(); ++i) {
+					if (NormalizePath(assets[i].m_OutputPath).ends_with(dependencyPath)) {
+						asset.m_Dependencies.push_back(i);
+						break;
+					}
+				}
+			}
+		}
+
+		Vector<u8> visitState(assets.size(), 0);
+		u32        maxDepth = 0;
+		for (u32 i = 0; i < assets.size(); ++i) {
+			maxDepth = std::max(maxDepth, ComputeDepth(assets, visitState, i));
+		}
+
+		Vector<Vector<u32>> levels(maxDepth + 1);
+		for (u32 i = 0; i < assets.size(); ++i) { levels[assets[i].m_Depth].push_back(i); }
+
+		// Input hashes, in depth order so the hashes of the dependencies are already known
+		//-----------------------------------------------------------------------------
+
+		for (Vector<u32> const& level : levels) {
+			for (u32 assetIdx : level) {
+				BatchAsset& asset = assets[assetIdx];
+
+				InputHasher hasher{};
+				hasher.Add(RESOURCE_COMPILER_VERSION);
+				hasher.Add(asset.m_AssetType);
+				hasher.Add(asset.m_Definition.data(), asset.m_Definition.size());
+				for (Path const& sourcePath : asset.m_SourcePaths) {
+					Blob const source = g_FileSystem.ReadBinaryFile(sourcePath);
+					hasher.Add(sourcePath);
+					hasher.Add(source.data(), source.size());
+				}
+				for (Path const& includePath : asset.m_IncludePaths) {
+					Blob const include = g_FileSystem.ReadBinaryFile(includePath);
+					hasher.Add(includePath);
+					hasher.Add(include.data(), include.size());
+				}
+				for (u32 dependency : asset.m_Dependencies) {
+					hasher.Add(assets[dependency].m_InputHash);
+				}
+				asset.m_InputHash = hasher.GetHash();
+			}
+		}
+
+		// Compile the out of date assets level by level
+		//-----------------------------------------------------------------------------
+
+		CompilationCache cache{};
+		cache.Load(sourceDirectory + "/.ckcache");
+
+		for (Vector<u32> const& level : levels) {
+			Vector<u32> assetsToCompile{};
+			for (u32 assetIdx : level) {
+				BatchAsset& asset = assets[assetIdx];
+
+				// Dependencies are in earlier levels, unless they are part of a cycle and never compiled
+				bool const isDependencyFailed = std::any_of(asset.m_Dependencies.begin(), asset.m_Dependencies.end(),
+				                                            [&](u32 dependency) { return !assets[dependency].m_Succeeded; });
+				if (isDependencyFailed) {
+					std::cout << "Skipping " << asset.m_BaseName << ", a dependency failed to compile" << std::endl;
+					outReport.m_FailedCount++;
+				}
+				else if (cache.IsUpToDate(asset.m_OutputPath, asset.m_InputHash)) {
+					asset.m_Succeeded = true;
+					outReport.m_UpToDateCount++;
+				}
+				else {
+					assetsToCompile.push_back(assetIdx);
+				}
+			}
+			if (assetsToCompile.empty()) { continue; }
+
+			CompileAssetsTaskSet taskSet{this, assets, assetsToCompile};
+			m_TaskSystem.ScheduleTask(&taskSet);
+			m_TaskSystem.WaitForTask(&taskSet);
+
+			for (u32 assetIdx : assetsToCompile) {
+				BatchAsset const& asset = assets[assetIdx];
+				outReport.m_CompileTimeMs += asset.m_CompileTimeMs;
+				if (asset.m_Succeeded) {
+					cache.Store(asset.m_OutputPath, asset.m_InputHash);
+					outReport.m_CompiledCount++;
+				}
+				else {
+					outReport.m_FailedCount++;
+				}
+			}
+		}
+
+		cache.Save();
+		outReport.m_WallTimeMs = GetElapsedMs(batchStart);
+	}
+}
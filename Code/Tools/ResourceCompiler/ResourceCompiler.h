@@ -2,7 +2,12 @@
 
 #include "CookieKat/Core/Containers/String.h"
 
+#include "Compilers/CubeMapCompiler.h"
 #include "Compilers/MaterialCompiler.h"
+#include "Compilers/MeshCompiler.h"
+#include "Compilers/TextureCompiler.h"
+#include "CompilationCache.h"
+#include "CookieKat/Systems/TaskSystem/TaskSystem.h"
 
 namespace CKE {
 	struct CompilerData
@@ -14,18 +19,54 @@ namespace CKE {
 		String m_OutputBasePath;
 	};
 
+	// Bump whenever the output of any compiler changes, invalidates every cached resource
+	constexpr u64 RESOURCE_COMPILER_VERSION = 4;
+
+	struct BatchCompilationReport
+	{
+		u32 m_AssetCount = 0;
+		u32 m_CompiledCount = 0;
+		u32 m_UpToDateCount = 0;
+		u32 m_FailedCount = 0;
+		f64 m_WallTimeMs = 0.0;    // Duration of the whole batch
+		f64 m_CompileTimeMs = 0.0; // Sum of the compilation time of each asset, the cost of compiling them serially
+
+		inline f64 GetCacheHitRate() const {
+			return m_AssetCount == 0 ? 0.0 : static_cast<f64>(m_UpToDateCount) / m_AssetCount;
+		}
+
+		inline f64 GetSpeedup() const {
+			return m_WallTimeMs == 0.0 ? 1.0 : m_CompileTimeMs / m_WallTimeMs;
+		}
+	};
+
 	class ResourceCompiler
 	{
 	public:
 		void Initialize(const char* inputBasePath, const char* outputBasePath);
+		void Shutdown();
+
+		// Each compile function returns false if the resource couldn't be written
+		bool CompileMaterial(String const& fileBaseName);
+		bool CompilePipeline(String const& fileBaseName);
+		bool CompileTexture(String const& fileBaseName);
+		bool CompileCubeMap(String const& fileBaseName);
+		bool CompileMesh(String const& fileBaseName);
+
+		// Compiles the asset with the compiler of the "AssetType" of its definition
+		bool CompileAsset(String const& fileBaseName);
 
-		void CompileMaterial(String const& fileBaseName);
-		void CompilePipeline(String const& fileBaseName);
-		void CompileTexture(String const& fileBaseName);
-		void CompileCubeMap(String const& fileBaseName);
+		// Compiles all the out of date .ckadef files of the directory, assets are compiled after the assets they depend on
+		// and independent assets are compiled in parallel, assets that depend on one that failed aren't compiled.
+		// Input hashes, shader includes among them, are cached in a .ckcache file in the directory.
+		void CompileDirectory(Path const& sourceDirectory, BatchCompilationReport& outReport);
 
 	private:
+		TaskSystem       m_TaskSystem{};
 		MaterialCompiler m_MaterialCompiler{};
+		MeshCompiler     m_MeshCompiler{};
+		TextureCompiler  m_TextureCompiler{};
+		CubeMapCompiler  m_CubeMapCompiler{};
 		CompilerData     m_CompilerData;
 	};
 }
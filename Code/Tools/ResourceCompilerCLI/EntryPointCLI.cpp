@@ -1,3 +1,4 @@
+#include <format>
 #include <iostream>
 
 #include "ResourceCompiler.h"
@@ -16,8 +17,10 @@ int main(int argc, char* argv[])
 
 	String fileType = "Unnamed";
 	String inputBaseName = "Unnamed";
-	app.add_option("-t,--type", fileType, "Type of resource: [texture, material, pipeline]");
+	String batchDirectory = "";
+	app.add_option("-t,--type", fileType, "Type of resource: [texture, cubemap, material, pipeline, mesh]");
 	app.add_option("-i,--input", inputBaseName, "File name of the .ckedef asset file without the extension");
+	app.add_option("-b,--batch", batchDirectory, "Compile all the out of date .ckadef files inside the directory");
 
 	//-----------------------------------------------------------------------------
 
@@ -30,7 +33,20 @@ int main(int argc, char* argv[])
 
 	//-----------------------------------------------------------------------------
 
-	if (fileType == "pipeline")
+	compiler.Initialize("", "");
+
+	if (!batchDirectory.empty())
+	{
+		std::cout << "Compiling Directory...\n";
+		BatchCompilationReport report{};
+		compiler.CompileDirectory(batchDirectory, report);
+		std::cout << std::format("Assets: {}, compiled {}, up to date {}, failed {}\n",
+		                         report.m_AssetCount, report.m_CompiledCount, report.m_UpToDateCount, report.m_FailedCount);
+		std::cout << std::format("Cache hit rate: {:.1f}%\n", report.GetCacheHitRate() * 100.0);
+		std::cout << std::format("Wall time: {:.2f} ms, serial compile time: {:.2f} ms, speedup: {:.2f}x\n",
+		                         report.m_WallTimeMs, report.m_CompileTimeMs, report.GetSpeedup());
+	}
+	else if (fileType == "pipeline")
 	{
 		std::cout << "Compiling Pipeline...\n";
 		compiler.CompilePipeline(inputBaseName);
@@ -54,10 +70,17 @@ int main(int argc, char* argv[])
 		compiler.CompileCubeMap(inputBaseName);
 		std::cout << "CubeMap Compiled\n";
 	}
+	else if (fileType == "mesh")
+	{
+		std::cout << "Compiling Mesh...\n";
+		compiler.CompileMesh(inputBaseName);
+		std::cout << "Mesh Compiled\n";
+	}
 	else
 	{
 		std::cout << "Resource type [ " << fileType << " ] not supported\n";
 	}
 
+	compiler.Shutdown();
 	return 0;
 }
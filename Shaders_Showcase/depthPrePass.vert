@@ -14,6 +14,11 @@ layout(std140, set = 0, binding = 1) readonly buffer ObjectBuffer{
     ObjectData objects[];
 } objectBuffer;
 
+// Object index of each instance of the draw
+layout(std430, set = 0, binding = 2) readonly buffer InstanceBuffer{
+    uint objectIndices[];
+} u_InstanceBuffer;
+
 
 layout(set = 0, binding = 0) uniform ViewData{
     mat4 viewProj;
@@ -34,6 +39,7 @@ layout(location = 3) in vec2 inTexCoord;
 //--------------------------------------------------------------------
 
 void main() {
-    mat4 model = objectBuffer.objects[gl_BaseInstance].model;
+    uint objectIdx = u_InstanceBuffer.objectIndices[gl_InstanceIndex];
+    mat4 model = objectBuffer.objects[objectIdx].model;
     gl_Position = u_ViewData.viewProj * model * vec4(inPosition, 1.0);
 }
\ No newline at end of file
@@ -33,7 +33,10 @@ void main()
 {
     // Sample textures
     vec3 albedo = texture(u_AlbedoSampler, in_UV).xyz * in_Albedo;
-    vec3 normalSampled = texture(u_NormalSampler, in_UV).xyz;
+    // Normal maps may be stored as two channels (BC5), rebuild Z from XY
+    vec3 normalSampled;
+    normalSampled.xy = texture(u_NormalSampler, in_UV).xy * 2.0 - 1.0;
+    normalSampled.z = sqrt(max(1.0 - dot(normalSampled.xy, normalSampled.xy), 0.0));
     float roughness = texture(u_RoughnessSampler, in_UV).x * in_Roughness;
     float metalness = texture(u_MetalicSampler, in_UV).x * in_Metallic;
     float reflectance = in_Reflectance;
@@ -43,7 +46,7 @@ void main()
     vec3 B = normalize(bitangent);
     vec3 N = normalize(in_Normal);
     mat3 TBN = mat3(T, B, N);
-    vec3 normal = normalize(TBN * (normalSampled * 2.0 - 1.0)); // Convert sampled normal to view space
+    vec3 normal = normalize(TBN * normalSampled); // Convert sampled normal to view space
 
     out_Albedo = vec4(albedo, 1.0);
     out_Position = vec4(in_Pos, 1.0);
@@ -24,6 +24,11 @@ layout(std140, set = 0, binding = 1) readonly buffer ObjectBuffer{
     ObjectData objects[];
 } u_ObjectBuffer;
 
+// Object index of each instance of the draw, gl_InstanceIndex starts at the first instance of the batch
+layout(std430, set = 0, binding = 2) readonly buffer InstanceBuffer{
+    uint objectIndices[];
+} u_InstanceBuffer;
+
 // Vertex Input
 //--------------------------------------------------------------------
 
@@ -50,8 +55,9 @@ layout(location = 12) out float out_ObjIdx;
 //--------------------------------------------------------------------
 
 void main() {
-    mat4 model = u_ObjectBuffer.objects[gl_BaseInstance].model; 
-    mat3 normalMat = mat3(u_ObjectBuffer.objects[gl_BaseInstance].normalMat);
+    uint objectIdx = u_InstanceBuffer.objectIndices[gl_InstanceIndex];
+    mat4 model = u_ObjectBuffer.objects[objectIdx].model; 
+    mat3 normalMat = mat3(u_ObjectBuffer.objects[objectIdx].normalMat);
 
     out_Model = model;
     out_Pos = (u_ViewData.view * model * vec4(in_Position, 1.0)).xyz;
@@ -59,11 +65,11 @@ void main() {
     out_Normal = (u_ViewData.view * vec4(normalMat * in_Normal, 0.0)).xyz;
     out_Tangent = (u_ViewData.view * vec4(normalMat * in_Tangent, 0.0)).xyz;
 
-    out_Albedo = u_ObjectBuffer.objects[gl_BaseInstance].albedo;
-    out_Roughness = u_ObjectBuffer.objects[gl_BaseInstance].roughness;
-    out_Metalic = u_ObjectBuffer.objects[gl_BaseInstance].metalic;
-    out_Reflectance = u_ObjectBuffer.objects[gl_BaseInstance].reflectance;
-    out_ObjIdx = gl_BaseInstance + 1;
+    out_Albedo = u_ObjectBuffer.objects[objectIdx].albedo;
+    out_Roughness = u_ObjectBuffer.objects[objectIdx].roughness;
+    out_Metalic = u_ObjectBuffer.objects[objectIdx].metalic;
+    out_Reflectance = u_ObjectBuffer.objects[objectIdx].reflectance;
+    out_ObjIdx = objectIdx + 1;
 
     gl_Position = u_ViewData.viewProj * model * vec4(in_Position, 1.0);
 }
\ No newline at end of file
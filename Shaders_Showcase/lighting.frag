@@ -16,9 +16,11 @@ struct SHCoeffs9{
 
 //--------------------------------------------------------------------
 
-layout(set = 0, binding = 0) uniform LightData{
-    vec4 size;
-    PointLightData light[1000];
+// Point lights of the scene, viewPos.w is the radius they reach
+layout(set = 0, binding = 0) readonly buffer LightData{
+    uvec4 gridSize; // Tiles in x and y, depth slices and number of lights
+    vec4 gridSlicing; // Scale and bias from log(view depth) to the depth slice
+    PointLightData light[];
 } u_Lights;
 
 layout(set = 0, binding = 1) uniform sampler2D u_AlbedoSampler;
@@ -40,6 +42,11 @@ layout(set = 0, binding = 7) uniform ViewData{
     mat4 projInv;
 } u_ViewData;
 
+// First light and number of lights of each cluster, followed by the light indices
+layout(set = 0, binding = 8) readonly buffer LightClusters{
+    uint data[];
+} u_LightClusters;
+
 // Vertex Stage Input
 //--------------------------------------------------------------------
 
@@ -159,15 +166,29 @@ void main()
     F0 = mix(F0, albedo, metalness);
     vec3 correctedAlbedo = albedo * (1.0 - metalness);
 
-    // Iterate over all of the lights and calculate their contribution
+    // Find the cluster of the pixel, depths outside of the slices are clamped to the first and last ones
+    uvec3 gridSize = u_Lights.gridSize.xyz;
+    uvec2 tile = min(uvec2(in_UV * vec2(gridSize.xy)), gridSize.xy - 1);
+    float sliceF = log(max(-pos.z, 1e-6)) * u_Lights.gridSlicing.x + u_Lights.gridSlicing.y;
+    uint slice = uint(clamp(sliceF, 0.0, float(gridSize.z - 1)));
+    uint cluster = (slice * gridSize.y + tile.y) * gridSize.x + tile.x;
+    uint firstLight = u_LightClusters.data[cluster * 2];
+    uint numLights = u_LightClusters.data[cluster * 2 + 1];
+    uint indicesStart = gridSize.x * gridSize.y * gridSize.z * 2 + firstLight;
+
+    // Iterate over the lights of the cluster and calculate their contribution
     vec3 Lo = vec3(0.0);
-    for (int i = 0; i < u_Lights.size.x; i++){
+    for (uint l = 0; l < numLights; l++){
+        uint i = u_LightClusters.data[indicesStart + l];
         vec3 lightPos = u_Lights.light[i].viewPos.xyz;
+        float lightRadius = u_Lights.light[i].viewPos.w;
         float lightDist = length(lightPos - pos);
         vec3 L = normalize(lightPos - pos);
         vec3 H = normalize(V + L); // In theory this could blow up if V and L are perfectly co-linear
 
-        float attenuation = min(1.0 / (lightDist * lightDist), 50000);
+        // Windowed so the light fades to 0 at its radius instead of being cut
+        float window = clamp(1.0 - pow(lightDist / lightRadius, 4.0), 0.0, 1.0);
+        float attenuation = min(1.0 / (lightDist * lightDist), 50000) * window * window;
         vec3 Li = u_Lights.light[i].radiance.xyz * attenuation;
 
         // Specular term